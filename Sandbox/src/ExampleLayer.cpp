@@ -12,14 +12,15 @@ import iGe.Renderer;
 // =================================================================================================
 
 ExampleLayer::ExampleLayer() : Layer{"Example"}, m_Camera{-1.6f, 1.6f, -0.9f, 0.9f}, m_CameraPosition{0.0f} {
-    CreateCommandPool();
+    m_UploadManager = iGe::CreateScope<iGe::UploadManager>();
+    m_Recorder = iGe::CreateScope<iGe::RHIParallelRecorder>(
+            iGe::RHI::Get()->GetCommandListManager(iGe::RHIQueueType::Graphics),
+            std::max(1u, std::thread::hardware_concurrency() / 2));
     CreateRenderPass();
     CreatePipelineLayout(); // Creates DescriptorSetLayout and PipelineLayout
     CreateGraphicsPipeline();
     CreateBuffers();             // Creates textures, buffers, texture views
-    CreateDescriptorResources(); // Creates sampler, pool, descriptor set (needs m_TextureView, m_UniformBuffer)
-
-    m_CommandList = iGe::RHI::Get()->AllocateCommandList(m_CommandPool.Get());
+    CreateDescriptorResources(); // Creates sampler, descriptor set cache and sets (needs m_TextureView)
 
     // Create depth texture and view
     CreateDepthResources(iGe::Application::Get().GetWindow().GetWidth(),
@@ -55,13 +56,13 @@ void ExampleLayer::OnUpdate(iGe::Timestep ts) {
     float time = std::chrono::duration<float, std::chrono::seconds::period>(currentTime - startTime).count();
     glm::mat4 model = glm::gtc::rotate(glm::mat4(1.0f), time * glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f));
 
-    // Update Uniform Buffer
-    if (void* ubPtr = m_UniformBuffer->Map()) {
-        const auto& viewProj = m_Camera.GetViewProjectionMatrix();
-        memcpy(ubPtr, &viewProj, sizeof(glm::mat4));
-        memcpy(static_cast<uint8*>(ubPtr) + sizeof(glm::mat4), &model, sizeof(glm::mat4));
-        m_UniformBuffer->Unmap();
-    }
+    // Per-frame constants, bound through the dynamic offset of the UBO binding
+    const std::array<glm::mat4, 2> constants = {m_Camera.GetViewProjectionMatrix(), model};
+    const iGe::RHIConstantAllocation constantAlloc = iGe::RHI::Get()->GetConstantAllocator()->Allocate(constants);
+
+    // Same bindings every frame, the cache hands back the set written at startup
+    m_DescriptorSetCache->EvictUnused();
+    const iGe::RHIDescriptorSet* triDescriptorSet = GetTriDescriptorSet();
 
     // Rendering
     auto queue = iGe::RHI::Get()->GetQueue(iGe::RHIQueueType::Graphics);
@@ -72,10 +73,30 @@ void ExampleLayer::OnUpdate(iGe::Timestep ts) {
     auto colorTexture = iGe::Application::Get().GetCurrentBackBufferTexture();
     auto colorTextureView = iGe::Application::Get().GetCurrentBackBufferView();
 
-    // Reset command list for new frame
-    m_CommandList->Reset();
-    m_CommandList->Begin();
-    {
+    // Every slice is recorded into its own list on the recorder's workers, the lists are submitted in slice order.
+    // The render pass transitions its attachments itself.
+    // Prepare attachment bindings
+    iGe::RHIAttachmentBinding colorBinding{};
+    colorBinding.pTextureView = colorTextureView;
+    colorBinding.ClearValue = iGe::RHIClearValue::CreateColor(0.5f, 0.5f, 0.5f, 1.0f);
+
+    iGe::RHIAttachmentBinding depthBinding{};
+    depthBinding.pTextureView = m_DepthTextureView.get();
+    depthBinding.ClearValue = iGe::RHIClearValue::CreateDepthStencil(1.0f, 0);
+
+    // Set up render pass begin info
+    iGe::RHIRenderPassBeginInfo beginInfo{};
+    beginInfo.pRenderPass = m_RenderPass.get();
+    beginInfo.ColorAttachments = {&colorBinding, 1};
+    beginInfo.pDepthStencilAttachment = &depthBinding;
+    beginInfo.RenderAreaOffset = {0, 0};
+    beginInfo.RenderAreaExtent = {width, height};
+
+    m_Recorder->BeginRenderPass(beginInfo);
+    m_Recorder->Record([this, width, height, constantAlloc, triDescriptorSet](iGe::RHIBackendCommandList& commandList) {
+        // Zones are thread-safe, the slice is timed on whichever worker records it
+        iGe::RHIGpuProfileScope sceneScope(iGe::Application::Get().GetGpuProfiler(), &commandList, "Scene");
+
         // Set viewport
         iGe::RHIViewport viewport{};
         viewport.X = 0;
@@ -84,7 +105,7 @@ void ExampleLayer::OnUpdate(iGe::Timestep ts) {
         viewport.Height = static_cast<float>(height);
         viewport.MinDepth = 0.0f;
         viewport.MaxDepth = 1.0f;
-        m_CommandList->SetViewport(viewport);
+        commandList.SetViewport(viewport);
 
         // Set scissor
         iGe::RHIScissor scissor{};
@@ -92,53 +113,37 @@ void ExampleLayer::OnUpdate(iGe::Timestep ts) {
         scissor.Y = 0;
         scissor.Width = static_cast<float>(width);
         scissor.Height = static_cast<float>(height);
-        m_CommandList->SetScissor(scissor);
-
-        // Transition color texture: Present -> ColorAttachment
-        // (Depth buffer is already in DepthStencilAttachment state since creation)
-        m_CommandList->ResourceBarrier(colorTexture, iGe::RHILayout::Present, iGe::RHILayout::ColorAttachment);
-
-        // Prepare attachment bindings
-        iGe::RHIAttachmentBinding colorBinding{};
-        colorBinding.pTextureView = colorTextureView;
-        colorBinding.ClearValue = iGe::RHIClearValue::CreateColor(0.5f, 0.5f, 0.5f, 1.0f);
-
-        iGe::RHIAttachmentBinding depthBinding{};
-        depthBinding.pTextureView = m_DepthTextureView.get();
-        depthBinding.ClearValue = iGe::RHIClearValue::CreateDepthStencil(1.0f, 0);
-
-        // Set up render pass begin info
-        iGe::RHIRenderPassBeginInfo beginInfo{};
-        beginInfo.pRenderPass = m_RenderPass.get();
-        beginInfo.ColorAttachments = {&colorBinding, 1};
-        beginInfo.pDepthStencilAttachment = &depthBinding;
-        beginInfo.RenderAreaOffset = {0, 0};
-        beginInfo.RenderAreaExtent = {width, height};
-
-        m_CommandList->BeginRenderPass(beginInfo);
+        commandList.SetScissor(scissor);
 
         // Draw Triangle using Descriptor Set (UBO only)
-        m_CommandList->BindGraphicsPipeline(m_TriGraphicsPipeline.get());
-        m_CommandList->BindVertexBuffer(m_TriVertexBuffer.get());
-        m_CommandList->BindIndexBuffer(m_TriIndexBuffer.get());
-        m_CommandList->BindDescriptorSet(m_TriPipelineLayout.get(), 0, m_TriDescriptorSet.get());
-        m_CommandList->DrawIndexed(3, 1, 0, 0, 0);
+        commandList.BindGraphicsPipeline(m_TriGraphicsPipeline.get());
+        commandList.BindVertexBuffer(m_TriVertexBuffer.get());
+        commandList.BindIndexBuffer(m_TriIndexBuffer.get());
+        commandList.BindDescriptorSet(m_TriPipelineLayout.get(), 0, triDescriptorSet, {&constantAlloc.Offset, 1});
+        commandList.DrawIndexed(3, 1, 0, 0, 0);
 
         // // Draw Quad with texture using Descriptor Set
-        // m_CommandList->BindGraphicsPipeline(m_QuadGraphicsPipeline.get());
-        // m_CommandList->BindVertexBuffer(m_QuadVertexBuffer.get());
-        // m_CommandList->BindIndexBuffer(m_QuadIndexBuffer.get());
-        // m_CommandList->BindDescriptorSet(m_PipelineLayout.get(), 0, m_DescriptorSet.get());
-        // m_CommandList->DrawIndexed(6, 1, 0, 0, 0);
-
-        m_CommandList->EndRenderPass();
-
-        // Transition color attachment to present
-        m_CommandList->ResourceBarrier(colorTexture, iGe::RHILayout::ColorAttachment, iGe::RHILayout::Present);
+        // commandList.BindGraphicsPipeline(m_QuadGraphicsPipeline.get());
+        // commandList.BindVertexBuffer(m_QuadVertexBuffer.get());
+        // commandList.BindIndexBuffer(m_QuadIndexBuffer.get());
+        // commandList.BindDescriptorSet(m_PipelineLayout.get(), 0, GetQuadDescriptorSet(),
+        //                               {&constantAlloc.Offset, 1});
+        // commandList.DrawIndexed(6, 1, 0, 0, 0);
+    });
+    m_Recorder->EndRenderPass();
+
+    // Transition color attachment to present
+    m_Recorder->Record([colorTexture](iGe::RHIBackendCommandList& commandList) {
+        commandList.TransitionTexture(colorTexture, iGe::RHILayout::Present);
+    });
+
+    // Startup uploads ran on the transfer queue, the GPU waits for them instead of the CPU
+    if (m_UploadTicket.IsValid()) {
+        m_UploadManager->WaitOnQueue(queue, m_UploadTicket);
+        m_UploadTicket = {};
     }
-    m_CommandList->End();
 
-    queue->Submit(m_CommandList.get());
+    m_Recorder->Submit();
 }
 
 void ExampleLayer::OnImGuiRender() {
@@ -167,8 +172,9 @@ bool ExampleLayer::OnPressedEvent(iGe::KeyPressedEvent& event) {
 bool ExampleLayer::OnWindowResizeEvent(iGe::WindowResizeEvent& event) {
     if (event.GetWidth() == 0 || event.GetHeight() == 0) { return false; }
 
-    // Wait for GPU to finish before resizing resources
-    iGe::RHI::Get()->GetQueue(iGe::RHIQueueType::Graphics)->WaitIdle();
+    // In-flight frames may still use the old depth buffer, it is destroyed once they completed
+    iGe::RHI::Get()->DeferDestroy(m_DepthTextureView);
+    iGe::RHI::Get()->DeferDestroy(m_DepthAttachment);
 
     // Recreate depth resources
     CreateDepthResources(event.GetWidth(), event.GetHeight());
@@ -180,13 +186,6 @@ bool ExampleLayer::OnWindowResizeEvent(iGe::WindowResizeEvent& event) {
     return false;
 }
 
-void ExampleLayer::CreateCommandPool() {
-    iGe::RHICommandPoolCreateInfo poolInfo{};
-    poolInfo.pQueue = iGe::RHI::Get()->GetQueue(iGe::RHIQueueType::Graphics);
-
-    m_CommandPool = iGe::RHI::Get()->CreateCommandPool(poolInfo);
-}
-
 void ExampleLayer::CreateRenderPass() {
     // Color attachment description
     std::vector<iGe::RHIAttachmentDescription> attachments;
@@ -272,61 +271,28 @@ void ExampleLayer::CreateGraphicsPipeline() {
 
 void ExampleLayer::CreateBuffers() {
     auto rhi = iGe::RHI::Get();
-    auto queue = rhi->GetQueue(iGe::RHIQueueType::Graphics);
 
-    // Create checkerboard Texture
+    // Load checkerboard Texture
     {
-        iGe::RHITextureCreateInfo texInfo{};
-        texInfo.Extent = {256, 256, 1};
-        texInfo.Format = iGe::RHIFormat::R8G8B8A8UNorm;
-        texInfo.MipLevels = 1;
-        texInfo.ArrayLayers = 1;
-        texInfo.MemoryUsage = iGe::RHIMemoryUsage::GpuOnly;
-        m_Texture = rhi->CreateTexture(texInfo);
-
-        // Generate checkerboard pattern
-        std::vector<uint32> textureData(256 * 256);
-        for (int y = 0; y < 256; y++) {
-            for (int x = 0; x < 256; x++) {
-                if ((x / 16 + y / 16) % 2 == 0) {
-                    textureData[y * 256 + x] = 0xFFFFFFFF; // White
-                } else {
-                    textureData[y * 256 + x] = 0xFF0000FF; // Red (ABGR format)
-                }
+        m_TextureImporter = iGe::CreateScope<iGe::TextureImporter>();
+        iGe::TextureImportDesc importDesc{};
+        importDesc.Path = "assets/textures/Checkerboard.png";
+        importDesc.Format = iGe::RHIFormat::R8G8B8A8UNorm;
+        iGe::TextureUploadJob uploadJob = m_TextureImporter->ImportAsync(importDesc).get();
+
+        // Copy straight from the importer's staging page on the transfer queue
+        if (uploadJob.IsValid()) {
+            m_Texture = rhi->CreateTexture(uploadJob.CreateInfo);
+            if (m_Texture) {
+                m_UploadManager->UploadTexture(m_Texture.get(), uploadJob.pStagingBuffer, uploadJob.CopyRegions);
             }
         }
 
-        // Create staging buffer
-        iGe::RHIBufferCreateInfo stagingInfo{};
-        stagingInfo.Size = textureData.size() * sizeof(uint32);
-        stagingInfo.Usage = iGe::RHIBufferUsageBit::TransferSrc;
-        stagingInfo.MemoryUsage = iGe::RHIMemoryUsage::CpuToGpu;
-        auto stagingBuffer = rhi->CreateBuffer(stagingInfo);
-
-        if (void* ptr = stagingBuffer->Map()) {
-            memcpy(ptr, textureData.data(), textureData.size() * sizeof(uint32));
-            stagingBuffer->Unmap();
-        }
-
-        // Upload texture via command list
-        auto cmdList = iGe::RHI::Get()->AllocateCommandList(m_CommandPool.Get());
-        cmdList->Reset();
-        cmdList->Begin();
-        {
-            cmdList->ResourceBarrier(m_Texture.get(), iGe::RHILayout::Undefined, iGe::RHILayout::TransferDst);
-            cmdList->CopyBufferToTexture(stagingBuffer.get(), m_Texture.get());
-            cmdList->ResourceBarrier(m_Texture.get(), iGe::RHILayout::TransferDst, iGe::RHILayout::ShaderReadOnly);
-        }
-        cmdList->End();
-
-        queue->Submit(cmdList.get());
-        queue->WaitIdle();
-
         // Create texture view for shader access
         iGe::RHITextureViewCreateInfo texViewInfo{};
         texViewInfo.ViewType = iGe::RHITextureViewType::View2D;
         texViewInfo.Format = iGe::RHIFormat::R8G8B8A8UNorm;
-        m_TextureView = rhi->CreateTextureView(m_Texture.get(), texViewInfo);
+        if (m_Texture) { m_TextureView = rhi->CreateTextureView(m_Texture.get(), texViewInfo); }
     }
 
     // Create Triangle Vertex Buffer
@@ -339,26 +305,18 @@ void ExampleLayer::CreateBuffers() {
     iGe::RHIVertexBufferCreateInfo triVbInfo{};
     triVbInfo.Size = sizeof(triVertices);
     triVbInfo.Stride = 6 * sizeof(float);
-    triVbInfo.MemoryUsage = iGe::RHIMemoryUsage::CpuToGpu;
+    triVbInfo.MemoryUsage = iGe::RHIMemoryUsage::GpuOnly;
     m_TriVertexBuffer = rhi->CreateVertexBuffer(triVbInfo);
-
-    if (void* ptr = m_TriVertexBuffer->Map()) {
-        memcpy(ptr, triVertices, sizeof(triVertices));
-        m_TriVertexBuffer->Unmap();
-    }
+    m_UploadManager->UploadBuffer(m_TriVertexBuffer.get(), triVertices, sizeof(triVertices));
 
     // Create Triangle Index Buffer
     uint32 triIndices[] = {0, 1, 2};
     iGe::RHIIndexBufferCreateInfo triIbInfo{};
     triIbInfo.Size = sizeof(triIndices);
     triIbInfo.Format = iGe::RHIIndexFormat::Uint32;
-    triIbInfo.MemoryUsage = iGe::RHIMemoryUsage::CpuToGpu;
+    triIbInfo.MemoryUsage = iGe::RHIMemoryUsage::GpuOnly;
     m_TriIndexBuffer = rhi->CreateIndexBuffer(triIbInfo);
-
-    if (void* ptr = m_TriIndexBuffer->Map()) {
-        memcpy(ptr, triIndices, sizeof(triIndices));
-        m_TriIndexBuffer->Unmap();
-    }
+    m_UploadManager->UploadBuffer(m_TriIndexBuffer.get(), triIndices, sizeof(triIndices));
 
     // Create Quad Vertex Buffer
     float quadVertices[] = {
@@ -371,34 +329,20 @@ void ExampleLayer::CreateBuffers() {
     iGe::RHIVertexBufferCreateInfo quadVbInfo{};
     quadVbInfo.Size = sizeof(quadVertices);
     quadVbInfo.Stride = 5 * sizeof(float);
-    quadVbInfo.MemoryUsage = iGe::RHIMemoryUsage::CpuToGpu;
+    quadVbInfo.MemoryUsage = iGe::RHIMemoryUsage::GpuOnly;
     m_QuadVertexBuffer = rhi->CreateVertexBuffer(quadVbInfo);
-
-    if (void* ptr = m_QuadVertexBuffer->Map()) {
-        memcpy(ptr, quadVertices, sizeof(quadVertices));
-        m_QuadVertexBuffer->Unmap();
-    }
+    m_UploadManager->UploadBuffer(m_QuadVertexBuffer.get(), quadVertices, sizeof(quadVertices));
 
     // Create Quad Index Buffer
     uint32 quadIndices[] = {0, 1, 2, 2, 3, 0};
     iGe::RHIIndexBufferCreateInfo quadIbInfo{};
     quadIbInfo.Size = sizeof(quadIndices);
     quadIbInfo.Format = iGe::RHIIndexFormat::Uint32;
-    quadIbInfo.MemoryUsage = iGe::RHIMemoryUsage::CpuToGpu;
+    quadIbInfo.MemoryUsage = iGe::RHIMemoryUsage::GpuOnly;
     m_QuadIndexBuffer = rhi->CreateIndexBuffer(quadIbInfo);
+    m_UploadManager->UploadBuffer(m_QuadIndexBuffer.get(), quadIndices, sizeof(quadIndices));
 
-    if (void* ptr = m_QuadIndexBuffer->Map()) {
-        memcpy(ptr, quadIndices, sizeof(quadIndices));
-        m_QuadIndexBuffer->Unmap();
-    }
-
-    // Create Uniform Buffer
-    iGe::UniformBufferLayout layout = {{iGe::UBElementType::Float4x4, "ViewProjection"},
-                                       {iGe::UBElementType::Float4x4, "Transform"}};
-    iGe::RHIUniformBufferCreateInfo ubInfo{};
-    ubInfo.Layout = layout;
-    ubInfo.MemoryUsage = iGe::RHIMemoryUsage::CpuToGpu;
-    m_UniformBuffer = rhi->CreateUniformBuffer(ubInfo);
+    m_UploadTicket = m_UploadManager->Flush();
 }
 
 void ExampleLayer::CreatePipelineLayout() {
@@ -412,7 +356,7 @@ void ExampleLayer::CreatePipelineLayout() {
         std::vector<iGe::RHIDescriptorSetLayoutBinding> triBindings;
         iGe::RHIDescriptorSetLayoutBinding ubBinding{};
         ubBinding.Binding = 0;
-        ubBinding.DescriptorType = iGe::RHIDescriptorType::UniformBuffer;
+        ubBinding.DescriptorType = iGe::RHIDescriptorType::UniformBufferDynamic;
         ubBinding.DescriptorCount = 1;
         ubBinding.StageFlags = iGe::RHIShaderStage::Vertex;
         triBindings.push_back(ubBinding);
@@ -437,7 +381,7 @@ void ExampleLayer::CreatePipelineLayout() {
         // Binding 0: Uniform Buffer
         iGe::RHIDescriptorSetLayoutBinding ubBinding{};
         ubBinding.Binding = 0;
-        ubBinding.DescriptorType = iGe::RHIDescriptorType::UniformBuffer;
+        ubBinding.DescriptorType = iGe::RHIDescriptorType::UniformBufferDynamic;
         ubBinding.DescriptorCount = 1;
         ubBinding.StageFlags = iGe::RHIShaderStage::Vertex | iGe::RHIShaderStage::Fragment;
         bindings.push_back(ubBinding);
@@ -486,94 +430,79 @@ void ExampleLayer::CreateDescriptorResources() {
     samplerInfo.MaxLod = 1.0f;
     m_Sampler = rhi->CreateSampler(samplerInfo);
 
-    // Create descriptor pool
-    std::vector<iGe::RHIDescriptorPoolSize> poolSizes = {{iGe::RHIDescriptorType::UniformBuffer, 10},
+    // Create descriptor set cache
+    std::vector<iGe::RHIDescriptorPoolSize> poolSizes = {{iGe::RHIDescriptorType::UniformBufferDynamic, 10},
                                                          {iGe::RHIDescriptorType::SampledImage, 10},
                                                          {iGe::RHIDescriptorType::Sampler, 10}};
-    iGe::RHIDescriptorPoolCreateInfo poolInfo{};
-    poolInfo.MaxSets = 10;
-    poolInfo.PoolSizes = poolSizes;
-    m_DescriptorPool = rhi->CreateDescriptorPool(poolInfo);
+    m_DescriptorSetCache = iGe::CreateScope<iGe::DescriptorSetCache>(poolSizes, 10);
 
-    // =========================================================================
-    // Allocate and update Triangle descriptor set (UBO only)
-    // =========================================================================
-    {
-        m_TriDescriptorSet = m_DescriptorPool->AllocateDescriptorSet(m_TriDescriptorSetLayout.get());
-
-        // Update triangle descriptor set with UBO
-        iGe::RHIDescriptorBufferInfo bufferInfo{};
-        bufferInfo.pBuffer = m_UniformBuffer.get();
-        bufferInfo.Offset = 0;
-        bufferInfo.Range = ~0ULL;
-
-        iGe::RHIWriteDescriptorSet triUbWrite{};
-        triUbWrite.pDstSet = m_TriDescriptorSet.get();
-        triUbWrite.DstBinding = 0;
-        triUbWrite.DescriptorType = iGe::RHIDescriptorType::UniformBuffer;
-        triUbWrite.DescriptorCount = 1;
-        triUbWrite.pBufferInfos = &bufferInfo;
-
-        std::array<iGe::RHIWriteDescriptorSet, 1> triWrites = {triUbWrite};
-        rhi->UpdateDescriptorSets(triWrites);
-    }
+    // Write both sets up front, frames look them up again and hit the cache
+    GetTriDescriptorSet();
+    GetQuadDescriptorSet();
+}
 
-    // =========================================================================
-    // Allocate and update Quad descriptor set (UBO + Texture + Sampler)
-    // =========================================================================
-    {
-        m_DescriptorSet = m_DescriptorPool->AllocateDescriptorSet(m_DescriptorSetLayout.get());
-
-        // Prepare buffer info
-        iGe::RHIDescriptorBufferInfo bufferInfo{};
-        bufferInfo.pBuffer = m_UniformBuffer.get();
-        bufferInfo.Offset = 0;
-        bufferInfo.Range = ~0ULL;
-
-        // Prepare image infos
-        iGe::RHIDescriptorImageInfo texImageInfo{};
-        texImageInfo.pSampler = nullptr;
-        texImageInfo.pTextureView = m_TextureView.get();
-        texImageInfo.ImageLayout = iGe::RHILayout::ShaderReadOnly;
-
-        iGe::RHIDescriptorImageInfo samplerImageInfo{};
-        samplerImageInfo.pSampler = m_Sampler.get();
-        samplerImageInfo.pTextureView = nullptr;
-        samplerImageInfo.ImageLayout = iGe::RHILayout::Undefined;
-
-        // Write Uniform Buffer at binding 0
-        iGe::RHIWriteDescriptorSet ubWrite{};
-        ubWrite.pDstSet = m_DescriptorSet.get();
-        ubWrite.DstBinding = 0;
-        ubWrite.DescriptorType = iGe::RHIDescriptorType::UniformBuffer;
-        ubWrite.DescriptorCount = 1;
-        ubWrite.pBufferInfos = &bufferInfo;
-
-        // Write Texture at binding 1
-        iGe::RHIWriteDescriptorSet texWrite{};
-        texWrite.pDstSet = m_DescriptorSet.get();
-        texWrite.DstBinding = 1;
-        texWrite.DescriptorType = iGe::RHIDescriptorType::SampledImage;
-        texWrite.DescriptorCount = 1;
-        texWrite.pImageInfos = &texImageInfo;
-
-        // Write Sampler at binding 2
-        iGe::RHIWriteDescriptorSet samplerWrite{};
-        samplerWrite.pDstSet = m_DescriptorSet.get();
-        samplerWrite.DstBinding = 2;
-        samplerWrite.DescriptorType = iGe::RHIDescriptorType::Sampler;
-        samplerWrite.DescriptorCount = 1;
-        samplerWrite.pImageInfos = &samplerImageInfo;
-
-        // Batch update
-        std::array<iGe::RHIWriteDescriptorSet, 3> writes = {ubWrite, texWrite, samplerWrite};
-        rhi->UpdateDescriptorSets(writes);
-    }
+const iGe::RHIDescriptorSet* ExampleLayer::GetTriDescriptorSet() {
+    // Uniform Buffer at binding 0
+    iGe::RHIDescriptorBufferInfo bufferInfo{};
+    bufferInfo.pBuffer = iGe::RHI::Get()->GetConstantAllocator()->GetBuffer();
+    bufferInfo.Offset = 0;
+    bufferInfo.Range = 2 * sizeof(glm::mat4);
+
+    iGe::RHIWriteDescriptorSet triUbWrite{};
+    triUbWrite.DstBinding = 0;
+    triUbWrite.DescriptorType = iGe::RHIDescriptorType::UniformBufferDynamic;
+    triUbWrite.DescriptorCount = 1;
+    triUbWrite.pBufferInfos = &bufferInfo;
+
+    std::array<iGe::RHIWriteDescriptorSet, 1> triWrites = {triUbWrite};
+    return m_DescriptorSetCache->GetOrCreate(m_TriDescriptorSetLayout.get(), triWrites);
+}
+
+const iGe::RHIDescriptorSet* ExampleLayer::GetQuadDescriptorSet() {
+    // Prepare buffer info
+    iGe::RHIDescriptorBufferInfo bufferInfo{};
+    bufferInfo.pBuffer = iGe::RHI::Get()->GetConstantAllocator()->GetBuffer();
+    bufferInfo.Offset = 0;
+    bufferInfo.Range = 2 * sizeof(glm::mat4);
+
+    // Prepare image infos
+    iGe::RHIDescriptorImageInfo texImageInfo{};
+    texImageInfo.pSampler = nullptr;
+    texImageInfo.pTextureView = m_TextureView.get();
+    texImageInfo.ImageLayout = iGe::RHILayout::ShaderReadOnly;
+
+    iGe::RHIDescriptorImageInfo samplerImageInfo{};
+    samplerImageInfo.pSampler = m_Sampler.get();
+    samplerImageInfo.pTextureView = nullptr;
+    samplerImageInfo.ImageLayout = iGe::RHILayout::Undefined;
+
+    // Write Uniform Buffer at binding 0
+    iGe::RHIWriteDescriptorSet ubWrite{};
+    ubWrite.DstBinding = 0;
+    ubWrite.DescriptorType = iGe::RHIDescriptorType::UniformBufferDynamic;
+    ubWrite.DescriptorCount = 1;
+    ubWrite.pBufferInfos = &bufferInfo;
+
+    // Write Texture at binding 1
+    iGe::RHIWriteDescriptorSet texWrite{};
+    texWrite.DstBinding = 1;
+    texWrite.DescriptorType = iGe::RHIDescriptorType::SampledImage;
+    texWrite.DescriptorCount = 1;
+    texWrite.pImageInfos = &texImageInfo;
+
+    // Write Sampler at binding 2
+    iGe::RHIWriteDescriptorSet samplerWrite{};
+    samplerWrite.DstBinding = 2;
+    samplerWrite.DescriptorType = iGe::RHIDescriptorType::Sampler;
+    samplerWrite.DescriptorCount = 1;
+    samplerWrite.pImageInfos = &samplerImageInfo;
+
+    std::array<iGe::RHIWriteDescriptorSet, 3> writes = {ubWrite, texWrite, samplerWrite};
+    return m_DescriptorSetCache->GetOrCreate(m_DescriptorSetLayout.get(), writes);
 }
 
 void ExampleLayer::CreateDepthResources(uint32 width, uint32 height) {
     auto rhi = iGe::RHI::Get();
-    auto queue = rhi->GetQueue(iGe::RHIQueueType::Graphics);
 
     // Create depth texture
     iGe::RHITextureCreateInfo depthInfo{};
@@ -589,15 +518,4 @@ void ExampleLayer::CreateDepthResources(uint32 width, uint32 height) {
     depthViewInfo.ViewType = iGe::RHITextureViewType::View2D;
     depthViewInfo.Format = iGe::RHIFormat::D32SFloat;
     m_DepthTextureView = rhi->CreateTextureView(m_DepthAttachment.get(), depthViewInfo);
-
-    // Transition depth buffer to DepthStencilAttachment state immediately after creation
-    // This way we don't need to transition it every fram
-    auto cmdList = iGe::RHI::Get()->AllocateCommandList(m_CommandPool.Get());
-    cmdList->Reset();
-    cmdList->Begin();
-    cmdList->ResourceBarrier(m_DepthAttachment.get(), iGe::RHILayout::Undefined,
-                             iGe::RHILayout::DepthStencilAttachment);
-    cmdList->End();
-    queue->Submit(cmdList.get());
-    queue->WaitIdle();
 }
@@ -13,16 +13,21 @@ private:
     bool OnPressedEvent(iGe::KeyPressedEvent& event);
     bool OnWindowResizeEvent(iGe::WindowResizeEvent& event);
 
-    void CreateCommandPool();
     void CreateRenderPass();
     void CreatePipelineLayout();
     void CreateGraphicsPipeline();
     void CreateBuffers();
     void CreateDescriptorResources();
+    const iGe::RHIDescriptorSet* GetTriDescriptorSet();
+    const iGe::RHIDescriptorSet* GetQuadDescriptorSet();
     void CreateDepthResources(uint32 width, uint32 height);
 
-    iGe::Scope<iGe::RHICommandPool> m_CommandPool;
-    iGe::Scope<iGe::RHICommandList> m_CommandList;
+    // Startup uploads, the graphics queue waits on the ticket before the first frame
+    iGe::Scope<iGe::UploadManager> m_UploadManager;
+    iGe::Scope<iGe::TextureImporter> m_TextureImporter; // Owns the texture's staging memory
+    iGe::UploadTicket m_UploadTicket;
+
+    iGe::Scope<iGe::RHIParallelRecorder> m_Recorder;
 
     iGe::Scope<iGe::RHIVertexBuffer> m_TriVertexBuffer;
     iGe::Scope<iGe::RHIIndexBuffer> m_TriIndexBuffer;
@@ -32,7 +37,6 @@ private:
     iGe::Scope<iGe::RHIIndexBuffer> m_QuadIndexBuffer;
     iGe::Scope<iGe::RHIGraphicsPipeline> m_QuadGraphicsPipeline;
 
-    iGe::Scope<iGe::RHIUniformBuffer> m_UniformBuffer;
     iGe::Scope<iGe::RHIRenderPass> m_RenderPass;
 
     // Attachments
@@ -42,16 +46,14 @@ private:
     iGe::Scope<iGe::RHITexture> m_DepthAttachment;
     iGe::Scope<iGe::RHITextureView> m_DepthTextureView;
 
-    // Descriptor Set resources
-    iGe::Scope<iGe::RHIDescriptorPool> m_DescriptorPool;
+    // Descriptor Set resources, the sets themselves come from the cache
+    iGe::Scope<iGe::DescriptorSetCache> m_DescriptorSetCache;
     iGe::Scope<iGe::RHIDescriptorSetLayout> m_DescriptorSetLayout;
-    iGe::Scope<iGe::RHIDescriptorSet> m_DescriptorSet;
     iGe::Scope<iGe::RHIPipelineLayout> m_PipelineLayout;
     iGe::Scope<iGe::RHISampler> m_Sampler;
 
     // Triangle-specific descriptor resources (UBO only)
     iGe::Scope<iGe::RHIDescriptorSetLayout> m_TriDescriptorSetLayout;
-    iGe::Scope<iGe::RHIDescriptorSet> m_TriDescriptorSet;
     iGe::Scope<iGe::RHIPipelineLayout> m_TriPipelineLayout;
 
     iGe::OrthographicCamera m_Camera;
@@ -0,0 +1,374 @@
+import std;
+import iGe.Common;
+import iGe.RHI;
+
+#include "Test.h"
+
+using namespace iGe;
+
+namespace
+{
+
+// Encoding and decoding only carry handles around, the objects behind them are never touched
+template<typename T>
+T* FakeHandle(uint64 id) {
+    return FromRHICommandHandle<T>(0x10000 + id * 0x100);
+}
+
+// One call per opcode, with payloads that differ from the defaults so a dropped field shows up
+void RecordEveryCommand(RHICommandList& list) {
+    const float color[4] = {0.25f, 0.5f, 0.75f, 1.0f};
+
+    const RHIClearValue red = RHIClearValue::CreateColor(1.0f, 0.0f, 0.0f, 1.0f);
+    const RHIClearValue green = RHIClearValue::CreateColor(0.0f, 1.0f, 0.0f, 1.0f);
+    const std::array<RHIAttachmentBinding, 2> colorBindings = {
+            RHIAttachmentBinding{FakeHandle<const RHITextureView>(1), red},
+            RHIAttachmentBinding{FakeHandle<const RHITextureView>(2), green}};
+    const RHIAttachmentBinding depthBinding{FakeHandle<const RHITextureView>(3),
+                                            RHIClearValue::CreateDepthStencil(1.0f, 7)};
+    RHIRenderPassBeginInfo beginInfo{};
+    beginInfo.pRenderPass = FakeHandle<const RHIRenderPass>(4);
+    beginInfo.ColorAttachments = colorBindings;
+    beginInfo.pDepthStencilAttachment = &depthBinding;
+    beginInfo.RenderAreaOffset = {-8, 16};
+    beginInfo.RenderAreaExtent = {1920, 1080};
+    beginInfo.PassFlags = RHIRenderPassFlag::Resuming;
+    list.BeginRenderPass(beginInfo);
+    list.NextSubpass();
+
+    list.BindGraphicsPipeline(FakeHandle<const RHIGraphicsPipeline>(5));
+    list.BindComputePipeline(FakeHandle<const RHIComputePipeline>(6));
+    const std::array<uint32, 3> dynamicOffsets = {256, 512, 1024};
+    list.BindDescriptorSet(FakeHandle<const RHIPipelineLayout>(7), 2, FakeHandle<const RHIDescriptorSet>(8),
+                           dynamicOffsets);
+
+    const std::array<RHIDescriptorBufferInfo, 2> bufferInfos = {
+            RHIDescriptorBufferInfo{FakeHandle<const RHIBuffer>(9), 64, 128},
+            RHIDescriptorBufferInfo{FakeHandle<const RHIBuffer>(10), 0, 32}};
+    const RHIDescriptorImageInfo imageInfo{FakeHandle<const RHISampler>(11), FakeHandle<const RHITextureView>(12),
+                                           RHILayout::General};
+    std::array<RHIWriteDescriptorSet, 2> writes{};
+    writes[0].DstBinding = 1;
+    writes[0].DescriptorCount = 2;
+    writes[0].DescriptorType = RHIDescriptorType::UniformBuffer;
+    writes[0].pBufferInfos = bufferInfos.data();
+    writes[1].DstBinding = 3;
+    writes[1].DstArrayElement = 4;
+    writes[1].DescriptorType = RHIDescriptorType::SampledImage;
+    writes[1].pImageInfos = &imageInfo;
+    list.BindTransientDescriptors(FakeHandle<const RHIPipelineLayout>(7), 1,
+                                  FakeHandle<const RHIDescriptorSetLayout>(13), writes);
+
+    list.BindVertexBuffer(FakeHandle<const RHIVertexBuffer>(14), 1, 48);
+    list.BindIndexBuffer(FakeHandle<const RHIIndexBuffer>(15), 96);
+    const std::array<uint32, 5> constants = {1, 2, 3, 4, 5}; // 20 bytes, the packet needs padding
+    list.PushConstants(FakeHandle<const RHIPipelineLayout>(7), RHIShaderStage::Vertex | RHIShaderStage::Fragment, 16,
+                       sizeof(constants), constants.data());
+
+    list.SetViewport({1.0f, 2.0f, 640.0f, 480.0f, 0.1f, 0.9f});
+    list.SetScissor({-1, 2, 300, 400});
+    list.SetLineWidth(2.5f);
+    list.SetDepthBias(1.0f, 0.5f, 0.25f);
+    list.SetBlendConstants(color);
+    list.SetDepthBounds(0.2f, 0.8f);
+    list.SetStencilCompareMask(true, false, 0xF0);
+    list.SetStencilWriteMask(false, true, 0x0F);
+    list.SetStencilReference(true, true, 3);
+
+    list.Draw(3, 2, 1, 4);
+    list.DrawIndexed(36, 2, 6, -5, 1);
+    list.Dispatch(8, 4, 2);
+
+    list.TransitionTexture(FakeHandle<const RHITexture>(16), RHILayout::TransferDst);
+    list.TransitionTexture(FakeHandle<const RHITexture>(16), RHILayout::ShaderReadOnly, 2, 3);
+    list.TransitionBuffer(FakeHandle<const RHIBuffer>(9), RHILayout::TransferSrc);
+    list.ResourceBarrier(FakeHandle<const RHITexture>(16), RHILayout::TransferDst, RHILayout::ShaderReadOnly);
+
+    RHIMemoryBarrier memoryBarrier{};
+    memoryBarrier.SrcStageMask = RHIPipelineStageFlagBits::VertexShader;
+    memoryBarrier.DstAccessMask = RHIDependencyAccess::ColorAttachmentWrite;
+    RHIBufferMemoryBarrier bufferBarrier{};
+    bufferBarrier.pBuffer = FakeHandle<const RHIBuffer>(10);
+    bufferBarrier.Offset = 128;
+    bufferBarrier.Size = 256;
+    bufferBarrier.SrcQueueFamilyIndex = 1;
+    RHITextureMemoryBarrier textureBarrier{};
+    textureBarrier.pTexture = FakeHandle<const RHITexture>(16);
+    textureBarrier.OldLayout = RHILayout::ColorAttachment;
+    textureBarrier.NewLayout = RHILayout::Present;
+    textureBarrier.DstQueueFamilyIndex = 2;
+    RHIBarrierBatch barriers{};
+    barriers.MemoryBarriers = {&memoryBarrier, 1};
+    barriers.BufferBarriers = {&bufferBarrier, 1};
+    barriers.TextureBarriers = {&textureBarrier, 1};
+    barriers.ByRegion = true;
+    list.PipelineBarrier(&barriers);
+
+    list.CopyBufferToTexture(FakeHandle<const RHIBuffer>(9), FakeHandle<const RHITexture>(16));
+    const std::array<RHIBufferTextureCopy, 2> regions = {RHIBufferTextureCopy{0, 256, 0, 0, {64, 64, 1}},
+                                                         RHIBufferTextureCopy{16384, 128, 1, 2, {32, 32, 1}}};
+    list.CopyBufferToTexture(FakeHandle<const RHIBuffer>(9), FakeHandle<const RHITexture>(16), regions);
+    list.CopyTextureToBuffer(FakeHandle<const RHITexture>(16), FakeHandle<const RHIBuffer>(10));
+    list.CopyBuffer(FakeHandle<const RHIBuffer>(9), FakeHandle<const RHIBuffer>(10), 8, 16, 32);
+    list.BlitTexture(FakeHandle<const RHITexture>(16), FakeHandle<const RHITexture>(17), RHISamplerFilter::Nearest);
+
+    list.ClearColorAttachment(1, color, {{4, 8}, {16, 32}});
+    list.ClearDepthStencilAttachment(0.5f, 9, true, false, {{0, 0}, {64, 64}});
+    list.ClearTexture(FakeHandle<const RHITexture>(17), color);
+    list.ClearBuffer(FakeHandle<const RHIBuffer>(10), 0xDEADBEEF, 4, 12);
+
+    list.BeginDebugLabel("Shadow pass", color);
+    list.InsertDebugLabel("Cascade 2 of 4"); // No color
+    list.EndDebugLabel();
+
+    list.WriteTimestamp(FakeHandle<const RHIQueryPool>(18), 0);
+    list.BeginQuery(FakeHandle<const RHIQueryPool>(18), 1);
+    list.EndQuery(FakeHandle<const RHIQueryPool>(18), 1);
+    list.ResolveQueries(FakeHandle<const RHIQueryPool>(18), 0, 2, FakeHandle<const RHIBuffer>(10), 64);
+
+    list.EndRenderPass();
+}
+
+std::vector<std::byte> Serialize(const RHICommandStream& stream) {
+    std::vector<std::byte> data;
+    stream.Serialize(data);
+    return data;
+}
+
+// Packet header followed by the given payload fields, for streams no encoder would produce
+template<typename... Args>
+void AppendPacket(std::vector<std::byte>& data, RHICommandOpcode opcode, const Args&... args) {
+    const uint32 payloadSize = static_cast<uint32>((sizeof(Args) + ... + 0));
+    RHICommandPacketHeader header;
+    header.Opcode = opcode;
+    header.Size = static_cast<uint32>(AlignUp(sizeof(header) + payloadSize, RHICommandStream::PacketAlignment));
+
+    const uint64 offset = data.size();
+    data.resize(offset + header.Size);
+    std::memcpy(data.data() + offset, &header, sizeof(header));
+    RHICommandPayloadWriter writer(data.data() + offset + sizeof(header));
+    (writer.Write(args), ...);
+}
+
+// Decodes a hand-built stream into an encoder, which stays empty if the decoder rejected the packet up front
+bool DecodeBytes(const std::vector<std::byte>& data, RHICommandEncoder& target) {
+    RHICommandStream stream;
+    if (!stream.Deserialize(data)) { return false; }
+    return RHICommandDecoder().Decode(stream, target);
+}
+
+} // namespace
+
+// =================================================================================================
+// Command Stream
+// =================================================================================================
+
+IGE_TEST(CommandStreamNamesEveryOpcode) {
+    std::set<std::string_view> names;
+    for (uint32 i = 0; i < static_cast<uint32>(RHICommandOpcode::Count); ++i) {
+        const std::string_view name = GetRHICommandOpcodeName(static_cast<RHICommandOpcode>(i));
+        IGE_CHECK(name != "Unknown");
+        names.insert(name);
+    }
+    IGE_CHECK(names.size() == static_cast<uint32>(RHICommandOpcode::Count));
+    IGE_CHECK(GetRHICommandOpcodeName(RHICommandOpcode::Count) == "Unknown");
+}
+
+IGE_TEST(CommandStreamKeepsPacketsAlignedAcrossChunks) {
+    RHICommandStream stream(1024);
+    for (uint32 i = 0; i < 100; ++i) {
+        std::byte* payload = stream.Append(RHICommandOpcode::Draw, 1 + i % 13);
+        IGE_CHECK(reinterpret_cast<std::uintptr_t>(payload) % RHICommandStream::PacketAlignment == 0);
+        std::memset(payload, static_cast<int>(i), 1 + i % 13);
+    }
+    // Larger than a chunk, gets one of its own
+    std::memset(stream.Append(RHICommandOpcode::PushConstants, 4000), 0xAB, 4000);
+
+    uint32 index = 0;
+    uint64 size = 0;
+    stream.ForEachPacket([&](const RHICommandPacket& packet) {
+        if (index < 100) {
+            IGE_CHECK(packet.Opcode == RHICommandOpcode::Draw);
+            IGE_CHECK(packet.Payload[0] == static_cast<std::byte>(index));
+        } else {
+            IGE_CHECK(packet.Opcode == RHICommandOpcode::PushConstants && packet.Payload.size() == 4000);
+        }
+        size += sizeof(RHICommandPacketHeader) + packet.Payload.size();
+        ++index;
+    });
+    IGE_CHECK(index == 101 && stream.GetPacketCount() == 101);
+    IGE_CHECK(size == stream.GetSize());
+    IGE_CHECK(stream.GetSize() % RHICommandStream::PacketAlignment == 0);
+
+    stream.Clear();
+    IGE_CHECK(stream.IsEmpty() && stream.GetSize() == 0);
+}
+
+IGE_TEST(CommandStreamSerializeRoundTrip) {
+    RHICommandEncoder encoder(1024);
+    RecordEveryCommand(encoder);
+    RecordEveryCommand(encoder);
+    const std::vector<std::byte> data = Serialize(encoder.GetStream());
+    IGE_CHECK(data.size() == encoder.GetStream().GetSize());
+
+    RHICommandStream stream(1024);
+    IGE_CHECK(stream.Deserialize(data));
+    IGE_CHECK(stream.GetPacketCount() == encoder.GetStream().GetPacketCount());
+    IGE_CHECK(Serialize(stream) == data);
+
+    // A stream that already holds packets is replaced, not appended to
+    IGE_CHECK(stream.Deserialize(data));
+    IGE_CHECK(Serialize(stream) == data);
+
+    IGE_CHECK(stream.Deserialize({}));
+    IGE_CHECK(stream.IsEmpty());
+}
+
+// =================================================================================================
+// Command Encoder
+// =================================================================================================
+
+IGE_TEST(CommandEncoderCoversEveryOpcode) {
+    RHICommandEncoder encoder;
+    RecordEveryCommand(encoder);
+
+    std::vector<bool> seen(static_cast<uint32>(RHICommandOpcode::Count));
+    encoder.GetStream().ForEachPacket([&](const RHICommandPacket& packet) {
+        seen[static_cast<uint32>(packet.Opcode)] = true;
+    });
+    IGE_CHECK(!seen[0]);
+    for (uint32 i = 1; i < seen.size(); ++i) { IGE_CHECK(seen[i]); }
+}
+
+IGE_TEST(CommandDecoderRoundTripsEveryOpcode) {
+    RHICommandEncoder encoder;
+    RecordEveryCommand(encoder);
+    const std::vector<std::byte> data = Serialize(encoder.GetStream());
+
+    // Decoding into a second encoder must reproduce the stream byte for byte, so every field survives
+    RHICommandStream stream;
+    IGE_CHECK(stream.Deserialize(data));
+    RHICommandEncoder reencoded;
+    IGE_CHECK(RHICommandDecoder().Decode(stream, reencoded));
+    IGE_CHECK(Serialize(reencoded.GetStream()) == data);
+}
+
+IGE_TEST(CommandEncoderTakeStreamLeavesItEmpty) {
+    RHICommandEncoder encoder(2048);
+    encoder.Draw(3);
+    const RHICommandStream stream = encoder.TakeStream();
+    IGE_CHECK(stream.GetPacketCount() == 1);
+    IGE_CHECK(encoder.GetStream().IsEmpty());
+
+    encoder.Dispatch(1);
+    IGE_CHECK(encoder.GetStream().GetPacketCount() == 1);
+}
+
+// =================================================================================================
+// Malformed Input
+// =================================================================================================
+
+IGE_TEST(CommandStreamRejectsTruncatedHeader) {
+    RHICommandEncoder encoder;
+    encoder.Draw(3);
+    std::vector<std::byte> data = Serialize(encoder.GetStream());
+
+    // A whole packet followed by half a header
+    data.resize(data.size() + sizeof(RHICommandPacketHeader) / 2);
+    RHICommandStream stream;
+    IGE_CHECK(!stream.Deserialize(data));
+    IGE_CHECK(stream.IsEmpty() && stream.GetSize() == 0);
+
+    // Payload cut short, the header promises more bytes than there are
+    data = Serialize(encoder.GetStream());
+    data.resize(data.size() - RHICommandStream::PacketAlignment);
+    IGE_CHECK(!stream.Deserialize(data));
+    IGE_CHECK(stream.IsEmpty());
+}
+
+IGE_TEST(CommandStreamRejectsBadPacketHeaders) {
+    RHICommandEncoder encoder;
+    encoder.Draw(3);
+    encoder.Dispatch(1);
+    const std::vector<std::byte> valid = Serialize(encoder.GetStream());
+
+    RHICommandPacketHeader first;
+    RHICommandPacketHeader second;
+    std::memcpy(&first, valid.data(), sizeof(first));
+    std::memcpy(&second, valid.data() + first.Size, sizeof(second));
+    IGE_CHECK(first.Size + second.Size == valid.size());
+
+    auto withSecondHeader = [&](RHICommandOpcode opcode, uint32 size) {
+        std::vector<std::byte> data = valid;
+        const RHICommandPacketHeader header{opcode, 0, size};
+        std::memcpy(data.data() + first.Size, &header, sizeof(header));
+        return data;
+    };
+
+    RHICommandStream stream;
+    IGE_CHECK(stream.Deserialize(withSecondHeader(RHICommandOpcode::Dispatch, second.Size)));
+
+    // Zero, smaller than the header, unaligned, past the end of the data
+    for (uint32 size: {0u, 4u, second.Size - 4, second.Size + 8, 0xFFFFFFF8u}) {
+        IGE_CHECK(!stream.Deserialize(withSecondHeader(RHICommandOpcode::Dispatch, size)));
+        IGE_CHECK(stream.IsEmpty());
+    }
+    for (auto opcode: {RHICommandOpcode::Invalid, RHICommandOpcode::Count, static_cast<RHICommandOpcode>(0xFFFF)}) {
+        IGE_CHECK(!stream.Deserialize(withSecondHeader(opcode, second.Size)));
+        IGE_CHECK(stream.IsEmpty());
+    }
+}
+
+IGE_TEST(CommandDecoderRejectsCountsBeyondPayload) {
+    constexpr uint32 Huge = 0x40000000;
+
+    // Every count is checked against the remaining payload before anything is sized from it
+    std::vector<std::vector<std::byte>> packets(6);
+    AppendPacket(packets[0], RHICommandOpcode::BindDescriptorSet, uint64{1}, uint32{0}, uint64{2}, Huge);
+    AppendPacket(packets[1], RHICommandOpcode::BeginRenderPass, uint64{1}, Huge, uint32{1}, int32{0}, int32{0},
+                 uint32{4}, uint32{4}, uint32{0});
+    AppendPacket(packets[2], RHICommandOpcode::BindTransientDescriptors, uint64{1}, uint32{0}, uint64{2}, Huge);
+    AppendPacket(packets[3], RHICommandOpcode::PipelineBarrier, Huge, Huge, Huge, uint32{0});
+    AppendPacket(packets[4], RHICommandOpcode::CopyBufferToTextureRegions, uint64{1}, uint64{2}, Huge);
+    // One write claiming a descriptor count its infos do not match
+    AppendPacket(packets[5], RHICommandOpcode::BindTransientDescriptors, uint64{1}, uint32{0}, uint64{2}, uint32{1},
+                 uint64{3}, uint32{0}, uint32{0}, uint32{2}, RHIDescriptorType::UniformBuffer, uint32{1}, uint32{0},
+                 uint64{4}, uint64{0}, uint64{16});
+
+    for (const auto& packet: packets) {
+        RHICommandEncoder target;
+        IGE_CHECK(!DecodeBytes(packet, target));
+        IGE_CHECK(target.GetStream().IsEmpty());
+    }
+
+    // Counts that fit but whose elements run past the payload
+    std::vector<std::byte> shortOffsets;
+    AppendPacket(shortOffsets, RHICommandOpcode::BindDescriptorSet, uint64{1}, uint32{0}, uint64{2}, uint32{3},
+                 uint32{16});
+    RHICommandEncoder target;
+    IGE_CHECK(!DecodeBytes(shortOffsets, target));
+    IGE_CHECK(target.GetStream().IsEmpty());
+}
+
+IGE_TEST(CommandDecoderRejectsTruncatedPayloads) {
+    RHICommandEncoder encoder;
+    RecordEveryCommand(encoder);
+
+    // Every packet with its payload dropped, the decoder must flag it instead of reading past the end
+    uint32 rejected = 0;
+    uint32 withPayload = 0;
+    encoder.GetStream().ForEachPacket([&](const RHICommandPacket& packet) {
+        if (packet.Payload.empty()) { return; }
+        ++withPayload;
+
+        RHICommandEncoder target;
+        RHICommandDecoder decoder;
+        if (!decoder.DecodePacket({packet.Opcode, {}}, target)) { ++rejected; }
+    });
+    IGE_CHECK(withPayload > 0);
+    IGE_CHECK(rejected == withPayload);
+
+    RHICommandEncoder target;
+    IGE_CHECK(!RHICommandDecoder().DecodePacket({RHICommandOpcode::Count, {}}, target));
+    IGE_CHECK(!RHICommandDecoder().DecodePacket({RHICommandOpcode::Invalid, {}}, target));
+}
@@ -0,0 +1,154 @@
+import std;
+import iGe.Common;
+import iGe.RHI;
+
+#include "Test.h"
+
+using namespace iGe;
+
+namespace
+{
+
+// Logs its id when destroyed, and may release another resource into the queue from its destructor
+class TrackedResource final : public RHIResource {
+public:
+    TrackedResource(std::vector<uint32>& destroyed, uint32 id)
+        : RHIResource(RHIResourceType::Buffer), m_Destroyed(destroyed), m_Id(id) {}
+    ~TrackedResource() override {
+        m_Destroyed.push_back(m_Id);
+        if (m_pQueue) { m_pQueue->Enqueue(std::move(m_Dependent), m_DependentSerial); }
+    }
+
+    // Like a view releasing the texture it keeps alive
+    void ReleaseOnDestruction(RHIDeletionQueue& queue, Scope<RHIResource> dependent, uint64 frameSerial) {
+        m_pQueue = &queue;
+        m_Dependent = std::move(dependent);
+        m_DependentSerial = frameSerial;
+    }
+
+private:
+    std::vector<uint32>& m_Destroyed;
+    uint32 m_Id;
+    RHIDeletionQueue* m_pQueue = nullptr;
+    Scope<RHIResource> m_Dependent;
+    uint64 m_DependentSerial = 0;
+};
+
+} // namespace
+
+// =================================================================================================
+// Deletion Queue
+// =================================================================================================
+
+IGE_TEST(DeletionQueueWaitsForTheFrameSerial) {
+    RHIDeletionQueue queue;
+    std::vector<uint32> destroyed;
+    queue.Enqueue(CreateScope<TrackedResource>(destroyed, 0), 1);
+    queue.Enqueue(CreateScope<TrackedResource>(destroyed, 1), 2);
+    queue.Enqueue(CreateScope<TrackedResource>(destroyed, 2), 2);
+    queue.Enqueue(Scope<RHIResource>(), 2);
+    IGE_CHECK(queue.GetPendingCount() == 3);
+
+    queue.Retire(0);
+    IGE_CHECK(destroyed.empty());
+    queue.Retire(1);
+    IGE_CHECK(destroyed == std::vector<uint32>{0});
+    queue.Retire(5);
+    IGE_CHECK((destroyed == std::vector<uint32>{0, 1, 2}));
+    IGE_CHECK(queue.GetPendingCount() == 0);
+}
+
+IGE_TEST(DeletionQueueRunsCallbacksInReleaseOrder) {
+    RHIDeletionQueue queue;
+    std::vector<uint32> destroyed;
+    queue.Enqueue([&] { destroyed.push_back(10); }, 3);
+    queue.Enqueue(CreateScope<TrackedResource>(destroyed, 11), 3);
+    queue.Enqueue([&] { destroyed.push_back(12); }, 3);
+    queue.Enqueue(std::move_only_function<void()>(), 3);
+    IGE_CHECK(queue.GetPendingCount() == 3);
+
+    // A backend object released with a callback waits for its frame like any resource
+    queue.Retire(2);
+    IGE_CHECK(destroyed.empty());
+    queue.Retire(3);
+    IGE_CHECK((destroyed == std::vector<uint32>{10, 11, 12}));
+}
+
+IGE_TEST(DeletionQueueFollowsSimulatedFenceTimeline) {
+    RHIDeletionQueue queue;
+    std::mt19937 random(40);
+
+    // Every release remembers its serial, the destruction log is checked against the serial completed then
+    std::vector<uint32> destroyed;
+    std::vector<uint64> serials;
+    uint64 completed = 0;
+    uint32 checkedCount = 0;
+    auto checkDestroyed = [&] {
+        for (; checkedCount < destroyed.size(); ++checkedCount) {
+            IGE_CHECK(destroyed[checkedCount] == checkedCount);
+            IGE_CHECK(serials[destroyed[checkedCount]] <= completed);
+        }
+    };
+
+    for (uint64 frame = 1; frame <= 1000; ++frame) {
+        for (uint32 i = random() % 4; i > 0; --i) {
+            const uint32 id = static_cast<uint32>(serials.size());
+            serials.push_back(frame);
+            if (random() % 2 == 0) {
+                queue.Enqueue(CreateScope<TrackedResource>(destroyed, id), frame);
+            } else {
+                queue.Enqueue([&destroyed, id] { destroyed.push_back(id); }, frame);
+            }
+        }
+
+        // The simulated GPU completes frames in order, it stalls now and then
+        const uint64 latency = random() % 8 == 0 ? 6 : 1 + random() % 2;
+        completed = std::max(completed, frame > latency ? frame - latency : 0);
+        queue.Retire(completed);
+        checkDestroyed();
+
+        // Nothing of a completed frame is left behind
+        const uint64 pending = std::ranges::count_if(serials, [&](uint64 serial) { return serial > completed; });
+        IGE_CHECK(queue.GetPendingCount() == pending);
+    }
+
+    completed = 1000;
+    queue.Retire(completed);
+    checkDestroyed();
+    IGE_CHECK(destroyed.size() == serials.size() && queue.GetPendingCount() == 0);
+}
+
+IGE_TEST(DeletionQueueFlushDrainsReleasesQueuedByDestructors) {
+    RHIDeletionQueue queue;
+    std::vector<uint32> destroyed;
+
+    // A chain of three, each destructor releases the next one for a frame far ahead
+    auto last = CreateScope<TrackedResource>(destroyed, 2);
+    auto middle = CreateScope<TrackedResource>(destroyed, 1);
+    middle->ReleaseOnDestruction(queue, std::move(last), 100);
+    auto first = CreateScope<TrackedResource>(destroyed, 0);
+    first->ReleaseOnDestruction(queue, std::move(middle), 100);
+    queue.Enqueue(std::move(first), 1);
+
+    // Retire destroys outside the lock, the release queued meanwhile waits for its own frame
+    queue.Retire(1);
+    IGE_CHECK(destroyed == std::vector<uint32>{0});
+    IGE_CHECK(queue.GetPendingCount() == 1);
+
+    queue.Flush();
+    IGE_CHECK((destroyed == std::vector<uint32>{0, 1, 2}));
+    IGE_CHECK(queue.GetPendingCount() == 0);
+}
+
+IGE_TEST(DeletionQueueFlushesOnDestruction) {
+    std::vector<uint32> destroyed;
+    {
+        RHIDeletionQueue queue;
+        auto dependent = CreateScope<TrackedResource>(destroyed, 1);
+        auto resource = CreateScope<TrackedResource>(destroyed, 0);
+        resource->ReleaseOnDestruction(queue, std::move(dependent), 8);
+        queue.Enqueue(std::move(resource), 4);
+        queue.Enqueue([&] { destroyed.push_back(2); }, 6);
+    }
+    IGE_CHECK((destroyed == std::vector<uint32>{0, 2, 1}));
+}
@@ -0,0 +1,123 @@
+import std;
+import iGe.Common;
+import iGe.RHI;
+
+#include "Test.h"
+
+using namespace iGe;
+
+IGE_TEST(DescriptorRingRecyclesRetiredFrames) {
+    RHIDescriptorRing ring(64);
+    IGE_CHECK(ring.Allocate(40) == 0);
+    IGE_CHECK(ring.Allocate(30) == RHIDescriptorRing::InvalidOffset);
+    ring.EndFrame(1);
+
+    // Frame 1 is still in flight, only the 24 slots after it are free
+    IGE_CHECK(ring.Allocate(24) == 40);
+    IGE_CHECK(ring.Allocate(1) == RHIDescriptorRing::InvalidOffset);
+    ring.EndFrame(2);
+    IGE_CHECK(ring.GetFramesInFlight() == 2);
+
+    ring.Retire(1);
+    IGE_CHECK(ring.GetFramesInFlight() == 1);
+    IGE_CHECK(ring.GetUsedCount() == 24);
+    IGE_CHECK(ring.Allocate(40) == 0);
+}
+
+IGE_TEST(DescriptorRingNeverSplitsATable) {
+    RHIDescriptorRing ring(100);
+    IGE_CHECK(ring.Allocate(70) == 0);
+    ring.EndFrame(1);
+    ring.Retire(1);
+
+    // 30 slots are left before the end, a table of 40 skips them and starts over at zero
+    IGE_CHECK(ring.Allocate(40) == 0);
+    IGE_CHECK(ring.GetUsedCount() == 70);
+    IGE_CHECK(ring.Allocate(100) == RHIDescriptorRing::InvalidOffset);
+}
+
+IGE_TEST(DescriptorRingSkipsEmptyFrames) {
+    RHIDescriptorRing ring(16);
+    ring.EndFrame(1);
+    ring.EndFrame(2);
+    IGE_CHECK(ring.GetFramesInFlight() == 0);
+
+    IGE_CHECK(ring.Allocate(4) == 0);
+    ring.EndFrame(3);
+    ring.Retire(2);
+    IGE_CHECK(ring.GetUsedCount() == 4);
+    ring.Retire(3);
+    IGE_CHECK(ring.GetUsedCount() == 0);
+}
+
+IGE_TEST(DescriptorRingFollowsSimulatedFenceTimeline) {
+    constexpr uint32 Capacity = 4096;
+    constexpr uint64 GpuLatency = 3; // Frames the simulated GPU runs behind
+    RHIDescriptorRing ring(Capacity);
+    std::mt19937 random(32);
+
+    // Fence value of the frame that last allocated every slot, zero when never allocated
+    std::vector<uint64> slotFrames(Capacity, 0);
+    uint64 completed = 0;
+    uint32 failedCount = 0;
+    for (uint64 frame = 1; frame <= 2000; ++frame) {
+        completed = frame > GpuLatency ? frame - GpuLatency : 0;
+        ring.Retire(completed);
+
+        const uint32 tableCount = random() % 24;
+        for (uint32 i = 0; i < tableCount; ++i) {
+            const uint32 count = 1 + random() % 64;
+            const uint32 offset = ring.Allocate(count);
+            if (offset == RHIDescriptorRing::InvalidOffset) {
+                ++failedCount;
+                continue;
+            }
+
+            IGE_CHECK(offset + count <= Capacity);
+            for (uint32 slot = offset; slot < offset + count; ++slot) {
+                // A slot may only be handed out again once the GPU has finished the frame that used it, tables of
+                // the same frame never overlap
+                IGE_CHECK(slotFrames[slot] <= completed);
+                slotFrames[slot] = frame;
+            }
+        }
+        ring.EndFrame(frame);
+        IGE_CHECK(ring.GetFramesInFlight() <= GpuLatency);
+    }
+
+    // Frames average 12 tables of 32 slots, four in flight fit comfortably
+    IGE_CHECK(failedCount == 0);
+    ring.Retire(2000);
+    IGE_CHECK(ring.GetUsedCount() == 0);
+}
+
+IGE_TEST(DescriptorRingConcurrentAllocation) {
+    constexpr uint32 Capacity = 1 << 16;
+    constexpr uint32 ThreadCount = 8;
+    RHIDescriptorRing ring(Capacity);
+    std::vector<std::atomic<uint32>> owners(Capacity);
+    std::atomic<uint32> conflicts = 0;
+
+    for (uint64 frame = 1; frame <= 8; ++frame) {
+        ring.Retire(frame > 2 ? frame - 2 : 0);
+        for (auto& owner: owners) { owner.store(0, std::memory_order_relaxed); }
+
+        std::vector<std::thread> threads;
+        for (uint32 t = 0; t < ThreadCount; ++t) {
+            threads.emplace_back([&, t] {
+                std::mt19937 random(t + 1);
+                for (uint32 i = 0; i < 200; ++i) {
+                    const uint32 count = 1 + random() % 8;
+                    const uint32 offset = ring.Allocate(count);
+                    if (offset == RHIDescriptorRing::InvalidOffset) { continue; }
+                    for (uint32 slot = offset; slot < offset + count; ++slot) {
+                        if (owners[slot].exchange(t + 1) != 0) { ++conflicts; }
+                    }
+                }
+            });
+        }
+        for (auto& thread: threads) { thread.join(); }
+        ring.EndFrame(frame);
+    }
+    IGE_CHECK(conflicts.load() == 0);
+}
@@ -0,0 +1,108 @@
+import std;
+import iGe.Common;
+import iGe.RHI;
+
+#include "Test.h"
+
+using namespace iGe;
+
+// =================================================================================================
+// Query Ring
+// =================================================================================================
+
+IGE_TEST(QueryRingDropsFramesWhoseSlotIsInFlight) {
+    RHIQueryRing ring(2);
+    IGE_CHECK(ring.Acquire(1) == 1u);
+    ring.Submit(1);
+    IGE_CHECK(ring.Acquire(2) == 0u);
+    ring.Submit(0);
+
+    // Frame 3 maps onto frame 1's slot, which the GPU has not finished
+    IGE_CHECK(!ring.Acquire(3).has_value());
+    IGE_CHECK(ring.GetDroppedFrameCount() == 1);
+    IGE_CHECK(ring.GetSlotFrameSerial(1) == 1);
+
+    IGE_CHECK(ring.RetireNext(1) == 1u);
+    IGE_CHECK(!ring.RetireNext(1).has_value());
+    IGE_CHECK(ring.Acquire(5) == 1u);
+    IGE_CHECK(ring.GetSlotFrameSerial(1) == 5);
+    IGE_CHECK(ring.GetDroppedFrameCount() == 1);
+}
+
+IGE_TEST(QueryRingRetiresOldestFirst) {
+    RHIQueryRing ring(4);
+    for (uint64 frame: {6u, 3u, 5u}) {
+        const std::optional<uint32> slot = ring.Acquire(frame);
+        IGE_CHECK(slot.has_value());
+        if (slot) { ring.Submit(*slot); }
+    }
+
+    // Slot order differs from frame order, results still come back in frame order
+    IGE_CHECK(ring.RetireNext(5) == 3u);
+    IGE_CHECK(ring.RetireNext(5) == 1u);
+    IGE_CHECK(!ring.RetireNext(5).has_value());
+    IGE_CHECK(ring.RetireNext(6) == 2u);
+}
+
+IGE_TEST(QueryRingTakesOverUnsubmittedSlots) {
+    RHIQueryRing ring(2);
+    IGE_CHECK(ring.Acquire(2) == 0u);
+
+    // The frame never reached EndFrame, nothing was resolved into its slot
+    IGE_CHECK(!ring.RetireNext(2).has_value());
+    ring.Submit(1);
+    IGE_CHECK(!ring.RetireNext(2).has_value());
+
+    IGE_CHECK(ring.Acquire(4) == 0u);
+    IGE_CHECK(ring.GetDroppedFrameCount() == 0);
+    IGE_CHECK(RHIQueryRing(0).GetSlotCount() == 1);
+}
+
+IGE_TEST(QueryRingFollowsSimulatedFenceTimeline) {
+    constexpr uint32 SlotCount = 3;
+    RHIQueryRing ring(SlotCount);
+    std::mt19937 random(50);
+
+    // The simulated GPU completes frames in order but stalls now and then, which has to drop frames
+    std::deque<uint64> inFlight;
+    uint64 completed = 0;
+    uint64 lastRetired = 0;
+    uint64 timedCount = 0;
+    uint64 droppedCount = 0;
+    for (uint64 frame = 1; frame <= 2000; ++frame) {
+        const uint64 latency = random() % 8 == 0 ? 5 : 1 + random() % 2;
+        completed = std::max(completed, frame > latency ? frame - latency : 0);
+
+        // Profiler BeginFrame: publish whatever has completed, oldest first
+        while (std::optional<uint32> slot = ring.RetireNext(completed)) {
+            const uint64 serial = ring.GetSlotFrameSerial(*slot);
+            IGE_CHECK(!inFlight.empty() && serial == inFlight.front());
+            IGE_CHECK(serial <= completed && serial > lastRetired);
+            lastRetired = serial;
+            if (!inFlight.empty()) { inFlight.pop_front(); }
+        }
+        IGE_CHECK(inFlight.empty() || inFlight.front() > completed);
+
+        const std::optional<uint32> slot = ring.Acquire(frame);
+        const bool slotBusy = std::ranges::any_of(inFlight, [&](uint64 serial) {
+            return serial % SlotCount == frame % SlotCount;
+        });
+        IGE_CHECK(slot.has_value() != slotBusy);
+        if (!slot) {
+            ++droppedCount;
+            continue;
+        }
+
+        // A stall may also skip the submit, the slot is then taken over by a later frame
+        IGE_CHECK(*slot == frame % SlotCount);
+        if (random() % 50 == 0) { continue; }
+        ring.Submit(*slot);
+        inFlight.push_back(frame);
+        ++timedCount;
+    }
+
+    IGE_CHECK(ring.GetDroppedFrameCount() == droppedCount);
+    IGE_CHECK(droppedCount > 0 && timedCount > droppedCount);
+    while (ring.RetireNext(2000) && !inFlight.empty()) { inFlight.pop_front(); }
+    IGE_CHECK(inFlight.empty());
+}
@@ -0,0 +1,297 @@
+import std;
+import iGe.Common;
+import iGe.RHI;
+
+#include "Test.h"
+
+using namespace iGe;
+
+namespace
+{
+
+// Backend stand-in, blocks are plain records so the tests can tell live handles from destroyed ones
+class FakeMemoryAllocator : public RHIMemoryAllocator {
+public:
+    struct FakeBlock {
+        RHIMemoryUsage Usage;
+        RHIMemoryResourceKind Kind;
+        uint64 Size;
+    };
+
+    explicit FakeMemoryAllocator(const RHIMemoryAllocatorCreateInfo& info) : RHIMemoryAllocator(info) {}
+    ~FakeMemoryAllocator() override { ReleaseBlocks(); }
+
+    bool IsLive(const void* handle) const { return m_Blocks.contains(static_cast<const FakeBlock*>(handle)); }
+    uint32 GetLiveBlockCount() const { return static_cast<uint32>(m_Blocks.size()); }
+    uint32 GetCreatedBlockCount() const { return m_CreatedCount; }
+
+    bool FailBlockCreation = false;
+
+protected:
+    void* CreateBlock(RHIMemoryUsage usage, RHIMemoryResourceKind kind, uint64 size) override {
+        if (FailBlockCreation) { return nullptr; }
+
+        auto block = CreateScope<FakeBlock>(usage, kind, size);
+        FakeBlock* handle = block.get();
+        m_Blocks.emplace(handle, std::move(block));
+        ++m_CreatedCount;
+        return handle;
+    }
+
+    void DestroyBlock(void* handle) override { m_Blocks.erase(static_cast<FakeBlock*>(handle)); }
+
+private:
+    std::map<const FakeBlock*, Scope<FakeBlock>> m_Blocks;
+    uint32 m_CreatedCount = 0;
+};
+
+constexpr RHIMemoryAllocatorCreateInfo s_SmallBlocks = {1ull << 20, 1ull << 18};
+
+// Two full blocks of 64 KiB allocations, then half of the first and all but two of the second go away, which
+// leaves the second one to drain. pinSurvivor gives one of the second block's survivors no relocation owner.
+std::vector<RHIMemoryAllocation> AllocateSparseBlocks(FakeMemoryAllocator& allocator, std::array<int, 32>& owners,
+                                                      bool pinSurvivor = false) {
+    std::vector<RHIMemoryAllocation> allocations;
+    for (int& owner: owners) {
+        RHIMemoryRequest request{64ull << 10, 256};
+        request.pRelocationOwner = pinSurvivor && &owner == &owners[16] ? nullptr : &owner;
+        allocations.push_back(allocator.Allocate(request));
+    }
+    IGE_CHECK(allocator.GetLiveBlockCount() == 2);
+
+    for (uint32 i = 0; i < 8; ++i) { allocator.Free(allocations[i]); }
+    for (uint32 i = 18; i < 32; ++i) { allocator.Free(allocations[i]); }
+    return allocations;
+}
+
+} // namespace
+
+// =================================================================================================
+// Memory Allocator
+// =================================================================================================
+
+IGE_TEST(MemoryAllocatorRejectsInvalidRequests) {
+    FakeMemoryAllocator allocator(s_SmallBlocks);
+    IGE_CHECK(!allocator.Allocate({}).IsValid());
+    IGE_CHECK(!allocator.Allocate({64, 1, static_cast<RHIMemoryUsage>(RHIMemoryStats::UsageCount)}).IsValid());
+    IGE_CHECK(!allocator.Allocate({64, 1, RHIMemoryUsage::GpuOnly, RHIMemoryResourceKind::Count}).IsValid());
+    IGE_CHECK(allocator.GetCreatedBlockCount() == 0);
+
+    // A backend that cannot create the block fails the request instead of handing out a dangling range
+    allocator.FailBlockCreation = true;
+    IGE_CHECK(!allocator.Allocate({64}).IsValid());
+}
+
+IGE_TEST(MemoryAllocatorSeparatesPoolsAndDedicatedRequests) {
+    FakeMemoryAllocator allocator(s_SmallBlocks);
+    const RHIMemoryAllocation buffer = allocator.Allocate({256, 256, RHIMemoryUsage::GpuOnly});
+    const RHIMemoryAllocation texture =
+            allocator.Allocate({256, 256, RHIMemoryUsage::GpuOnly, RHIMemoryResourceKind::Texture});
+    const RHIMemoryAllocation upload = allocator.Allocate({256, 256, RHIMemoryUsage::CpuToGpu});
+    IGE_CHECK(allocator.GetBlockHandle(buffer) != allocator.GetBlockHandle(texture));
+    IGE_CHECK(allocator.GetBlockHandle(buffer) != allocator.GetBlockHandle(upload));
+    IGE_CHECK(allocator.GetLiveBlockCount() == 3);
+
+    // Above the threshold or asked for explicitly, nothing comes out of a block
+    const RHIMemoryAllocation large = allocator.Allocate({(1ull << 18) + 1});
+    RHIMemoryRequest dedicatedRequest{64};
+    dedicatedRequest.Dedicated = true;
+    const RHIMemoryAllocation dedicated = allocator.Allocate(dedicatedRequest);
+    IGE_CHECK(large.IsDedicated() && dedicated.IsDedicated());
+    IGE_CHECK(allocator.GetBlockHandle(large) == nullptr);
+    IGE_CHECK(allocator.GetLiveBlockCount() == 3);
+
+    RHIMemoryStats stats = allocator.GetStats();
+    IGE_CHECK(stats.DedicatedCount == 2);
+    IGE_CHECK(stats.DedicatedBytes == (1ull << 18) + 1 + 64);
+    IGE_CHECK(stats.Pooled.AllocationCount == 3);
+    IGE_CHECK(stats.Usages[static_cast<uint32>(RHIMemoryUsage::GpuOnly)].BlockCount == 2);
+    IGE_CHECK(stats.Usages[static_cast<uint32>(RHIMemoryUsage::CpuToGpu)].AllocatedBytes == 256);
+
+    for (const auto& allocation: {buffer, texture, upload, large, dedicated}) { allocator.Free(allocation); }
+    stats = allocator.GetStats();
+    IGE_CHECK(stats.DedicatedCount == 0 && stats.DedicatedBytes == 0);
+    IGE_CHECK(stats.Pooled.AllocatedBytes == 0);
+}
+
+IGE_TEST(MemoryAllocatorKeepsOneSpareBlockPerPool) {
+    FakeMemoryAllocator allocator(s_SmallBlocks);
+
+    // Two blocks worth of 128 KB allocations
+    std::vector<RHIMemoryAllocation> allocations;
+    for (uint32 i = 0; i < 16; ++i) { allocations.push_back(allocator.Allocate({128ull << 10})); }
+    IGE_CHECK(allocator.GetLiveBlockCount() == 2);
+
+    for (const auto& allocation: allocations) { allocator.Free(allocation); }
+    IGE_CHECK(allocator.GetLiveBlockCount() == 1);
+    IGE_CHECK(allocator.GetStats().Pooled.BlockCount == 1);
+
+    // The spare is reused instead of creating a new block
+    const RHIMemoryAllocation allocation = allocator.Allocate({64});
+    IGE_CHECK(allocator.GetCreatedBlockCount() == 2);
+    IGE_CHECK(allocator.IsLive(allocator.GetBlockHandle(allocation)));
+    allocator.Free(allocation);
+}
+
+IGE_TEST(MemoryAllocatorFuzz) {
+    FakeMemoryAllocator allocator(s_SmallBlocks);
+    std::mt19937 random(38);
+
+    struct Live {
+        RHIMemoryAllocation Allocation;
+        const void* Handle;
+    };
+    std::vector<Live> live;
+
+    // Byte ranges handed out of every live block, keyed by offset
+    std::map<const void*, std::map<uint64, uint64>> occupied;
+    auto overlaps = [&](const void* handle, uint64 offset, uint64 size) {
+        const auto& ranges = occupied[handle];
+        auto next = ranges.lower_bound(offset);
+        if (next != ranges.end() && next->first < offset + size) { return true; }
+        return next != ranges.begin() && std::prev(next)->second > offset;
+    };
+
+    uint64 pooledBytes = 0;
+    uint64 dedicatedBytes = 0;
+    uint32 dedicatedCount = 0;
+    for (uint32 step = 0; step < 50'000; ++step) {
+        if (live.empty() || random() % 100 < 52) {
+            RHIMemoryRequest request;
+            request.Size = 1 + random() % (random() % 4 ? 4096 : 65536);
+            if (random() % 64 == 0) { request.Size += 1ull << 18; } // Above the dedicated threshold
+            request.Alignment = 1ull << (random() % 13);
+            request.Usage = static_cast<RHIMemoryUsage>(random() % RHIMemoryStats::UsageCount);
+            request.Kind = static_cast<RHIMemoryResourceKind>(random() % 2);
+            request.Dedicated = random() % 128 == 0;
+
+            const RHIMemoryAllocation allocation = allocator.Allocate(request);
+            IGE_CHECK(allocation.IsValid());
+            if (!allocation.IsValid()) { continue; }
+            IGE_CHECK(allocation.Size == request.Size);
+
+            if (allocation.IsDedicated()) {
+                ++dedicatedCount;
+                dedicatedBytes += allocation.Size;
+                live.push_back({allocation, nullptr});
+                continue;
+            }
+
+            const void* handle = allocator.GetBlockHandle(allocation);
+            IGE_CHECK(allocator.IsLive(handle));
+            IGE_CHECK(allocation.Offset % request.Alignment == 0);
+
+            // The block belongs to the request's pool and holds the whole range
+            const auto* block = static_cast<const FakeMemoryAllocator::FakeBlock*>(handle);
+            IGE_CHECK(block->Usage == request.Usage && block->Kind == request.Kind);
+            IGE_CHECK(allocation.Offset + allocation.Size <= block->Size);
+            IGE_CHECK(!overlaps(handle, allocation.Offset, allocation.Size));
+
+            occupied[handle][allocation.Offset] = allocation.Offset + allocation.Size;
+            pooledBytes += allocation.Size;
+            live.push_back({allocation, handle});
+        } else {
+            const uint64 index = random() % live.size();
+            const Live entry = live[index];
+            live[index] = live.back();
+            live.pop_back();
+
+            allocator.Free(entry.Allocation);
+            if (entry.Allocation.IsDedicated()) {
+                --dedicatedCount;
+                dedicatedBytes -= entry.Allocation.Size;
+            } else {
+                occupied[entry.Handle].erase(entry.Allocation.Offset);
+                pooledBytes -= entry.Allocation.Size;
+            }
+        }
+
+        if (step % 1000 == 0) {
+            const RHIMemoryStats stats = allocator.GetStats();
+            IGE_CHECK(stats.Pooled.AllocatedBytes == pooledBytes);
+            IGE_CHECK(stats.Pooled.AllocationCount + dedicatedCount == live.size());
+            IGE_CHECK(stats.Pooled.BlockCount == allocator.GetLiveBlockCount());
+            IGE_CHECK(stats.DedicatedCount == dedicatedCount && stats.DedicatedBytes == dedicatedBytes);
+        }
+    }
+
+    for (const Live& entry: live) { allocator.Free(entry.Allocation); }
+
+    // Every pool is down to at most its spare block, and the spares hold nothing
+    const RHIMemoryStats stats = allocator.GetStats();
+    IGE_CHECK(stats.Pooled.AllocatedBytes == 0 && stats.Pooled.AllocationCount == 0);
+    IGE_CHECK(stats.DedicatedCount == 0 && stats.DedicatedBytes == 0);
+    for (const auto& usage: stats.Usages) { IGE_CHECK(usage.BlockCount <= 2); }
+    IGE_CHECK(allocator.GetLiveBlockCount() <= RHIMemoryStats::UsageCount * 2);
+}
+
+// =================================================================================================
+// Defragmentation
+// =================================================================================================
+
+IGE_TEST(MemoryAllocatorDefragmentationDrainsSparseBlocks) {
+    FakeMemoryAllocator allocator(s_SmallBlocks);
+    std::array<int, 32> owners{};
+    const std::vector<RHIMemoryAllocation> allocations = AllocateSparseBlocks(allocator, owners);
+
+    const std::vector<RHIMemoryMove> moves = allocator.PlanDefragmentation({});
+    IGE_CHECK(moves.size() == 2);
+    for (const RHIMemoryMove& move: moves) {
+        IGE_CHECK(move.pOwner == &owners[16] || move.pOwner == &owners[17]);
+        IGE_CHECK(move.Src.BlockIndex == allocations[16].BlockIndex);
+        IGE_CHECK(move.Dst.BlockIndex == allocations[0].BlockIndex);
+        IGE_CHECK(move.Dst.Offset % 256 == 0);
+        allocator.Free(move.Src);
+    }
+
+    // The drained block is empty now and stays as the pool's spare
+    const RHIMemoryStats stats = allocator.GetStats();
+    IGE_CHECK(stats.Pooled.AllocationCount == 10);
+    IGE_CHECK(stats.Pooled.LargestFreeRange == s_SmallBlocks.BlockSize);
+
+    for (uint32 i = 8; i < 16; ++i) { allocator.Free(allocations[i]); }
+    for (const RHIMemoryMove& move: moves) { allocator.Free(move.Dst); }
+    IGE_CHECK(allocator.GetStats().Pooled.AllocatedBytes == 0);
+    IGE_CHECK(allocator.GetLiveBlockCount() == 1);
+}
+
+IGE_TEST(MemoryAllocatorDefragmentationSkipsPinnedBlocks) {
+    FakeMemoryAllocator allocator(s_SmallBlocks);
+    std::array<int, 32> owners{};
+    const std::vector<RHIMemoryAllocation> allocations = AllocateSparseBlocks(allocator, owners, true);
+
+    // The sparse block holds an allocation without an owner, draining it could never release the block
+    IGE_CHECK(allocator.PlanDefragmentation({}).empty());
+    IGE_CHECK(allocator.GetStats().Pooled.AllocationCount == 10);
+    for (uint32 i = 8; i < 18; ++i) { allocator.Free(allocations[i]); }
+}
+
+IGE_TEST(MemoryAllocatorDefragmentationResumesCancelledMoves) {
+    FakeMemoryAllocator allocator(s_SmallBlocks);
+    std::array<int, 32> owners{};
+    const std::vector<RHIMemoryAllocation> allocations = AllocateSparseBlocks(allocator, owners);
+
+    // One move per pass, the reserved destination counts as an allocation until the move is resolved
+    const std::vector<RHIMemoryMove> first = allocator.PlanDefragmentation({1, 16ull << 20});
+    IGE_CHECK(first.size() == 1);
+    IGE_CHECK(allocator.GetStats().Pooled.AllocationCount == 11);
+
+    // A cancelled move frees its destination and the allocation stays movable where it was
+    for (const RHIMemoryMove& move: first) { allocator.CancelMove(move); }
+    IGE_CHECK(allocator.GetStats().Pooled.AllocationCount == 10);
+
+    const std::vector<RHIMemoryMove> second = allocator.PlanDefragmentation({});
+    IGE_CHECK(second.size() == 2);
+    IGE_CHECK(std::ranges::any_of(second, [&](const RHIMemoryMove& move) {
+        return !first.empty() && move.pOwner == first[0].pOwner && move.Src.Offset == first[0].Src.Offset;
+    }));
+    for (const RHIMemoryMove& move: second) {
+        IGE_CHECK(move.Src.BlockIndex == allocations[16].BlockIndex);
+        allocator.Free(move.Src);
+    }
+    IGE_CHECK(allocator.GetStats().Pooled.LargestFreeRange == s_SmallBlocks.BlockSize);
+
+    for (uint32 i = 8; i < 16; ++i) { allocator.Free(allocations[i]); }
+    for (const RHIMemoryMove& move: second) { allocator.Free(move.Dst); }
+    IGE_CHECK(allocator.GetStats().Pooled.AllocatedBytes == 0);
+}
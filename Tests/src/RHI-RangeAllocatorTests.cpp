@@ -0,0 +1,289 @@
+import std;
+import iGe.Common;
+import iGe.RHI;
+
+#include "Test.h"
+
+using namespace iGe;
+
+namespace
+{
+
+// Which allocation owns every unit, so overlaps and leaks show up as mismatches
+class OccupancyModel {
+public:
+    explicit OccupancyModel(uint32 capacity) : m_Units(capacity, Free) {}
+
+    bool Claim(uint32 offset, uint32 size, uint32 owner) {
+        if (offset > m_Units.size() || size > m_Units.size() - offset) { return false; }
+        for (uint32 i = offset; i < offset + size; ++i) {
+            if (m_Units[i] != Free) { return false; }
+            m_Units[i] = owner;
+        }
+        return true;
+    }
+
+    void Release(uint32 offset, uint32 size) {
+        for (uint32 i = offset; i < offset + size; ++i) { m_Units[i] = Free; }
+    }
+
+    uint32 GetFreeCount() const { return static_cast<uint32>(std::ranges::count(m_Units, Free)); }
+
+private:
+    static constexpr uint32 Free = std::numeric_limits<uint32>::max();
+
+    std::vector<uint32> m_Units;
+};
+
+} // namespace
+
+// =================================================================================================
+// Range Allocator
+// =================================================================================================
+
+IGE_TEST(RangeAllocatorCoalescesFreedNeighbours) {
+    RHIRangeAllocator allocator(1024);
+    std::vector<uint32> offsets;
+    for (uint32 i = 0; i < 16; ++i) { offsets.push_back(allocator.Allocate(64)); }
+    IGE_CHECK(allocator.GetFreeSize() == 0);
+    IGE_CHECK(allocator.Allocate(1) == RHIRangeAllocator::InvalidOffset);
+
+    // Every other range first, nothing coalesces yet
+    for (uint32 i = 0; i < offsets.size(); i += 2) { allocator.Free(offsets[i]); }
+    IGE_CHECK(allocator.GetFreeSize() == 512);
+    IGE_CHECK(allocator.GetLargestFreeRange() == 64);
+    IGE_CHECK(allocator.Allocate(128) == RHIRangeAllocator::InvalidOffset);
+
+    for (uint32 i = 1; i < offsets.size(); i += 2) { allocator.Free(offsets[i]); }
+    IGE_CHECK(allocator.GetAllocationCount() == 0);
+    IGE_CHECK(allocator.GetLargestFreeRange() == 1024);
+    IGE_CHECK(allocator.Allocate(1024) == 0);
+}
+
+IGE_TEST(RangeAllocatorHonoursAlignment) {
+    RHIRangeAllocator allocator(4096);
+    IGE_CHECK(allocator.Allocate(3) == 0);
+    for (uint32 alignment: {2u, 16u, 64u, 256u}) {
+        const uint32 offset = allocator.Allocate(5, alignment);
+        IGE_CHECK(offset != RHIRangeAllocator::InvalidOffset);
+        IGE_CHECK(offset % alignment == 0);
+        IGE_CHECK(allocator.GetAllocationSize(offset) == 5);
+    }
+}
+
+IGE_TEST(RangeAllocatorRejectsUnknownFrees) {
+    RHIRangeAllocator allocator(64);
+    const uint32 offset = allocator.Allocate(8);
+    allocator.Free(offset + 1);
+    allocator.Free(RHIRangeAllocator::InvalidOffset);
+    IGE_CHECK(allocator.GetAllocationCount() == 1);
+    IGE_CHECK(allocator.GetAllocationSize(offset + 1) == 0);
+    allocator.Free(offset);
+    IGE_CHECK(allocator.GetFreeSize() == 64);
+}
+
+IGE_TEST(RangeAllocatorChurnMatchesOccupancyModel) {
+    constexpr uint32 Capacity = 1 << 16;
+    RHIRangeAllocator allocator(Capacity);
+    OccupancyModel model(Capacity);
+    std::mt19937 random(31);
+
+    struct Allocation {
+        uint32 Offset;
+        uint32 Size;
+    };
+    std::vector<Allocation> live;
+    for (uint32 step = 0; step < 200'000; ++step) {
+        const bool allocate = live.empty() || random() % 100 < 55;
+        if (allocate) {
+            const uint32 size = 1 + random() % (random() % 8 == 0 ? 2048 : 32);
+            const uint32 alignment = 1u << (random() % 5);
+            const uint32 offset = allocator.Allocate(size, alignment);
+            if (offset == RHIRangeAllocator::InvalidOffset) { continue; }
+
+            IGE_CHECK(offset % alignment == 0);
+            IGE_CHECK(model.Claim(offset, size, step));
+            live.push_back({offset, size});
+        } else {
+            const uint64 index = random() % live.size();
+            allocator.Free(live[index].Offset);
+            model.Release(live[index].Offset, live[index].Size);
+            live[index] = live.back();
+            live.pop_back();
+        }
+    }
+    IGE_CHECK(allocator.GetFreeSize() == model.GetFreeCount());
+    IGE_CHECK(allocator.GetAllocationCount() == live.size());
+
+    for (const auto& allocation: live) { allocator.Free(allocation.Offset); }
+    IGE_CHECK(allocator.GetLargestFreeRange() == Capacity);
+}
+
+// =================================================================================================
+// Index Allocator
+// =================================================================================================
+
+IGE_TEST(IndexAllocatorHandsOutEverySlotOnce) {
+    RHIIndexAllocator allocator(1000);
+    std::vector<bool> seen(1000);
+    for (uint32 i = 0; i < 1000; ++i) {
+        const uint32 index = allocator.Allocate();
+        IGE_CHECK(index < 1000 && !seen[index]);
+        if (index < 1000) { seen[index] = true; }
+    }
+    IGE_CHECK(allocator.Allocate() == RHIIndexAllocator::InvalidIndex);
+    IGE_CHECK(allocator.GetFreeCount() == 0);
+
+    for (uint32 i = 0; i < 1000; ++i) { allocator.Free(i); }
+    IGE_CHECK(allocator.GetFreeCount() == 1000);
+    IGE_CHECK(allocator.GetLargestFreeRange() == 1000);
+}
+
+IGE_TEST(IndexAllocatorReturnsEmptyBatchesToRanges) {
+    RHIIndexAllocator allocator(256);
+
+    // Single slots park a batch, freeing them all must make the whole heap available to ranges again
+    std::vector<uint32> singles;
+    for (uint32 i = 0; i < 10; ++i) { singles.push_back(allocator.Allocate()); }
+    for (uint32 index: singles) { allocator.Free(index); }
+
+    const uint32 start = allocator.AllocateRange(256);
+    IGE_CHECK(start == 0);
+    allocator.FreeRange(start);
+    IGE_CHECK(allocator.GetFreeCount() == 256);
+}
+
+IGE_TEST(IndexAllocatorConcurrentChurn) {
+    constexpr uint32 Capacity = 4096;
+    constexpr uint32 ThreadCount = 8;
+    RHIIndexAllocator allocator(Capacity);
+    std::vector<std::atomic<uint32>> owners(Capacity);
+    std::atomic<uint32> conflicts = 0;
+
+    std::vector<std::thread> threads;
+    for (uint32 t = 0; t < ThreadCount; ++t) {
+        threads.emplace_back([&, t] {
+            std::mt19937 random(t + 1);
+            std::vector<uint32> singles;
+            std::vector<std::pair<uint32, uint32>> ranges;
+            for (uint32 step = 0; step < 20'000; ++step) {
+                const uint32 action = random() % 4;
+                if (action == 0 && !singles.empty()) {
+                    const uint32 index = singles.back();
+                    singles.pop_back();
+                    owners[index].store(0);
+                    allocator.Free(index);
+                } else if (action == 1 && !ranges.empty()) {
+                    const auto [start, count] = ranges.back();
+                    ranges.pop_back();
+                    for (uint32 i = start; i < start + count; ++i) { owners[i].store(0); }
+                    allocator.FreeRange(start);
+                } else if (action == 2) {
+                    const uint32 count = 1 + random() % 16;
+                    const uint32 start = allocator.AllocateRange(count);
+                    if (start == RHIIndexAllocator::InvalidIndex) { continue; }
+                    for (uint32 i = start; i < start + count; ++i) {
+                        if (owners[i].exchange(t + 1) != 0) { ++conflicts; }
+                    }
+                    ranges.emplace_back(start, count);
+                } else {
+                    const uint32 index = allocator.Allocate();
+                    if (index == RHIIndexAllocator::InvalidIndex) { continue; }
+                    if (owners[index].exchange(t + 1) != 0) { ++conflicts; }
+                    singles.push_back(index);
+                }
+            }
+
+            for (uint32 index: singles) {
+                owners[index].store(0);
+                allocator.Free(index);
+            }
+            for (const auto& [start, count]: ranges) {
+                for (uint32 i = start; i < start + count; ++i) { owners[i].store(0); }
+                allocator.FreeRange(start);
+            }
+        });
+    }
+    for (auto& thread: threads) { thread.join(); }
+
+    IGE_CHECK(conflicts.load() == 0);
+    IGE_CHECK(allocator.GetFreeCount() == Capacity);
+    IGE_CHECK(allocator.GetLargestFreeRange() == Capacity);
+}
+
+// =================================================================================================
+// Deferred Index Allocator
+// =================================================================================================
+
+IGE_TEST(DeferredIndexAllocatorHoldsFreesUntilRetired) {
+    RHIDeferredIndexAllocator allocator(4);
+    std::array<uint32, 4> indices{};
+    for (uint32& index: indices) { index = allocator.Allocate(); }
+    IGE_CHECK(allocator.Allocate() == RHIDeferredIndexAllocator::InvalidIndex);
+
+    allocator.Free(indices[0], 5);
+    allocator.Free(indices[1], 6);
+    IGE_CHECK(allocator.GetPendingCount() == 2);
+    IGE_CHECK(allocator.GetFreeCount() == 0);
+    IGE_CHECK(allocator.Allocate() == RHIDeferredIndexAllocator::InvalidIndex);
+
+    // Frame 5 has completed, frame 6 may still read its index
+    allocator.Retire(5);
+    IGE_CHECK(allocator.GetPendingCount() == 1);
+    IGE_CHECK(allocator.Allocate() == indices[0]);
+    IGE_CHECK(allocator.Allocate() == RHIDeferredIndexAllocator::InvalidIndex);
+
+    allocator.Retire(6);
+    IGE_CHECK(allocator.GetPendingCount() == 0);
+    IGE_CHECK(allocator.Allocate() == indices[1]);
+}
+
+IGE_TEST(DeferredIndexAllocatorIgnoresOutOfRangeFrees) {
+    RHIDeferredIndexAllocator allocator(8);
+    allocator.Free(8, 1);
+    allocator.Free(RHIDeferredIndexAllocator::InvalidIndex, 1);
+    IGE_CHECK(allocator.GetPendingCount() == 0);
+    IGE_CHECK(allocator.GetFreeCount() == 8);
+}
+
+IGE_TEST(DeferredIndexAllocatorResetDropsPendingFrees) {
+    RHIDeferredIndexAllocator allocator(8);
+    allocator.Free(allocator.Allocate(), 1);
+    allocator.Reset(16);
+    IGE_CHECK(allocator.GetPendingCount() == 0);
+    IGE_CHECK(allocator.GetCapacity() == 16);
+    IGE_CHECK(allocator.GetFreeCount() == 16);
+}
+
+IGE_TEST(DeferredIndexAllocatorNeverReusesInFlightIndices) {
+    constexpr uint32 Capacity = 512;
+    constexpr uint64 GpuLatency = 2;
+    RHIDeferredIndexAllocator allocator(Capacity);
+    std::mt19937 random(33);
+
+    // Frame whose free released the index, reuse is only allowed once that frame has completed
+    std::vector<uint64> freedIn(Capacity, 0);
+    std::vector<uint32> live;
+    for (uint64 frame = 1; frame <= 1000; ++frame) {
+        const uint64 completed = frame > GpuLatency ? frame - GpuLatency : 0;
+        allocator.Retire(completed);
+
+        for (uint32 i = 0; i < 16; ++i) {
+            const uint32 index = allocator.Allocate();
+            if (index == RHIDeferredIndexAllocator::InvalidIndex) { break; }
+            IGE_CHECK(freedIn[index] <= completed);
+            live.push_back(index);
+        }
+        for (uint32 i = 0; i < 16 && !live.empty(); ++i) {
+            const uint64 position = random() % live.size();
+            freedIn[live[position]] = frame;
+            allocator.Free(live[position], frame);
+            live[position] = live.back();
+            live.pop_back();
+        }
+    }
+
+    allocator.Retire(1000);
+    IGE_CHECK(allocator.GetPendingCount() == 0);
+    IGE_CHECK(allocator.GetFreeCount() + live.size() == Capacity);
+}
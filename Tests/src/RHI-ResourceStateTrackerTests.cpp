@@ -0,0 +1,223 @@
+import std;
+import iGe.Common;
+import iGe.RHI;
+
+#include "Test.h"
+
+using namespace iGe;
+
+namespace
+{
+
+// The tracker only keys on the address, no backend object is needed behind it
+class FakeResource : public RHIResource {
+public:
+    FakeResource() : RHIResource(RHIResourceType::Texture) {}
+};
+
+constexpr uint32 All = RHIResourceState::AllSubresources;
+
+bool IsTransition(const RHIResourceTransition& transition, const RHIResource* resource, uint32 subresource,
+                  RHILayout before, RHILayout after) {
+    return transition.pResource == resource && transition.Subresource == subresource &&
+           transition.Before == before && transition.After == after;
+}
+
+std::vector<RHIResourceTransition> Flush(RHIResourceStateTracker& tracker) {
+    std::vector<RHIResourceTransition> transitions;
+    tracker.FlushTransitions(transitions);
+    return transitions;
+}
+
+} // namespace
+
+// =================================================================================================
+// Resource State
+// =================================================================================================
+
+IGE_TEST(ResourceStateSplitsAndCollapses) {
+    RHIResourceState state(4, RHILayout::ShaderReadOnly);
+    state.Set(2, RHILayout::ShaderReadOnly);
+    IGE_CHECK(state.IsUniform());
+
+    state.Set(2, RHILayout::TransferDst);
+    IGE_CHECK(!state.IsUniform());
+    IGE_CHECK(state.Get(1) == RHILayout::ShaderReadOnly);
+    IGE_CHECK(state.Get(2) == RHILayout::TransferDst);
+
+    // Once every subresource agrees again the per-subresource layouts are dropped
+    for (uint32 i: {0u, 1u, 3u}) { state.Set(i, RHILayout::TransferDst); }
+    IGE_CHECK(state.IsUniform());
+    IGE_CHECK(state.Get(0) == RHILayout::TransferDst);
+
+    state.Set(0, RHILayout::General);
+    state.Set(All, RHILayout::Present);
+    IGE_CHECK(state.IsUniform());
+    IGE_CHECK(state.Get(3) == RHILayout::Present);
+
+    // A single subresource never splits
+    RHIResourceState single(1, RHILayout::Common);
+    single.Set(0, RHILayout::General);
+    IGE_CHECK(single.IsUniform() && single.Get(0) == RHILayout::General);
+}
+
+// =================================================================================================
+// Resource State Tracker
+// =================================================================================================
+
+IGE_TEST(ResourceStateTrackerDropsRepeatedTransitions) {
+    FakeResource texture;
+    RHIResourceState global(1, RHILayout::Common);
+    RHIResourceStateTracker tracker;
+
+    // The first touch is resolved at submit, asking for the current layout again is a no-op
+    tracker.Transition(&texture, &global, 1, RHILayout::TransferDst);
+    tracker.Transition(&texture, &global, 1, RHILayout::TransferDst);
+    IGE_CHECK(!tracker.HasPendingTransitions());
+
+    tracker.Transition(&texture, &global, 1, RHILayout::ShaderReadOnly);
+    tracker.Transition(&texture, &global, 1, RHILayout::ShaderReadOnly);
+    const auto transitions = Flush(tracker);
+    IGE_CHECK(transitions.size() == 1);
+    IGE_CHECK(IsTransition(transitions[0], &texture, All, RHILayout::TransferDst, RHILayout::ShaderReadOnly));
+    IGE_CHECK(!tracker.HasPendingTransitions());
+
+    tracker.Transition(&texture, &global, 1, RHILayout::ShaderReadOnly);
+    IGE_CHECK(!tracker.HasPendingTransitions());
+}
+
+IGE_TEST(ResourceStateTrackerCancelsRoundTrips) {
+    FakeResource texture;
+    FakeResource buffer;
+    RHIResourceStateTracker tracker;
+    tracker.Transition(&texture, nullptr, 1, RHILayout::ShaderReadOnly);
+    tracker.Transition(&buffer, nullptr, 1, RHILayout::General);
+
+    // A->B->A within a batch vanishes
+    tracker.Transition(&texture, nullptr, 1, RHILayout::TransferDst);
+    tracker.Transition(&texture, nullptr, 1, RHILayout::ShaderReadOnly);
+    IGE_CHECK(!tracker.HasPendingTransitions());
+
+    // A->B->C becomes a single A->C
+    tracker.Transition(&texture, nullptr, 1, RHILayout::TransferDst);
+    tracker.Transition(&texture, nullptr, 1, RHILayout::ColorAttachment);
+    tracker.Transition(&buffer, nullptr, 1, RHILayout::TransferSrc);
+    auto transitions = Flush(tracker);
+    IGE_CHECK(transitions.size() == 2);
+    IGE_CHECK(IsTransition(transitions[0], &texture, All, RHILayout::ShaderReadOnly, RHILayout::ColorAttachment));
+    IGE_CHECK(IsTransition(transitions[1], &buffer, All, RHILayout::General, RHILayout::TransferSrc));
+
+    // Flushed transitions have executed, going back is a real transition again
+    tracker.Transition(&texture, nullptr, 1, RHILayout::ShaderReadOnly);
+    transitions = Flush(tracker);
+    IGE_CHECK(transitions.size() == 1);
+    IGE_CHECK(IsTransition(transitions[0], &texture, All, RHILayout::ColorAttachment, RHILayout::ShaderReadOnly));
+}
+
+IGE_TEST(ResourceStateTrackerSplitsAndCollapsesSubresources) {
+    FakeResource texture;
+    RHIResourceState global(4, RHILayout::ShaderReadOnly);
+    RHIResourceStateTracker tracker;
+    tracker.Transition(&texture, &global, 4, RHILayout::ShaderReadOnly);
+
+    // Mip 1 alone, e.g. a mip generation step writing it
+    tracker.Transition(&texture, &global, 4, RHILayout::TransferDst, 1);
+    auto transitions = Flush(tracker);
+    IGE_CHECK(transitions.size() == 1);
+    IGE_CHECK(IsTransition(transitions[0], &texture, 1, RHILayout::ShaderReadOnly, RHILayout::TransferDst));
+
+    // The whole resource from a split state moves every subresource from its own layout
+    tracker.Transition(&texture, &global, 4, RHILayout::ColorAttachment);
+    transitions = Flush(tracker);
+    IGE_CHECK(transitions.size() == 4);
+    for (uint32 i = 0; i < 4; ++i) {
+        const RHILayout before = i == 1 ? RHILayout::TransferDst : RHILayout::ShaderReadOnly;
+        IGE_CHECK(IsTransition(transitions[i], &texture, i, before, RHILayout::ColorAttachment));
+    }
+
+    // Collapsed again, the next whole-resource transition is a single one
+    tracker.Transition(&texture, &global, 4, RHILayout::ColorAttachment);
+    IGE_CHECK(!tracker.HasPendingTransitions());
+    tracker.Transition(&texture, &global, 4, RHILayout::ShaderReadOnly);
+    transitions = Flush(tracker);
+    IGE_CHECK(transitions.size() == 1);
+    IGE_CHECK(IsTransition(transitions[0], &texture, All, RHILayout::ColorAttachment, RHILayout::ShaderReadOnly));
+}
+
+IGE_TEST(ResourceStateTrackerResolvesAgainstGlobalState) {
+    FakeResource texture;
+    FakeResource untracked;
+    RHIResourceState global(1, RHILayout::ShaderReadOnly);
+
+    // Recorded in any order, resolved in submission order: first writes the texture, second reads it
+    RHIResourceStateTracker first;
+    RHIResourceStateTracker second;
+    second.Transition(&texture, &global, 1, RHILayout::ShaderReadOnly);
+    first.Transition(&texture, &global, 1, RHILayout::TransferDst);
+    first.Transition(&untracked, nullptr, 1, RHILayout::TransferSrc);
+    first.Transition(&texture, &global, 1, RHILayout::ColorAttachment);
+
+    std::vector<RHIResourceTransition> fixups;
+    first.Resolve(fixups);
+    IGE_CHECK(fixups.size() == 2);
+    const bool textureFirst = fixups[0].pResource == &texture;
+    const auto& textureFixup = fixups[textureFirst ? 0 : 1];
+    const auto& untrackedFixup = fixups[textureFirst ? 1 : 0];
+    IGE_CHECK(IsTransition(textureFixup, &texture, All, RHILayout::ShaderReadOnly, RHILayout::TransferDst));
+    // Resources without a global state enter in Common
+    IGE_CHECK(IsTransition(untrackedFixup, &untracked, All, RHILayout::Common, RHILayout::TransferSrc));
+
+    // The first list's final layout is committed, the second list starts from it
+    IGE_CHECK(global.Get(0) == RHILayout::ColorAttachment);
+    fixups.clear();
+    second.Resolve(fixups);
+    IGE_CHECK(fixups.size() == 1);
+    IGE_CHECK(IsTransition(fixups[0], &texture, All, RHILayout::ColorAttachment, RHILayout::ShaderReadOnly));
+    IGE_CHECK(global.Get(0) == RHILayout::ShaderReadOnly);
+
+    // Entering in the layout the resource already has needs no fixup
+    RHIResourceStateTracker third;
+    third.Transition(&texture, &global, 1, RHILayout::ShaderReadOnly);
+    fixups.clear();
+    third.Resolve(fixups);
+    IGE_CHECK(fixups.empty());
+}
+
+IGE_TEST(ResourceStateTrackerResolvesSubresources) {
+    FakeResource texture;
+    RHIResourceState global(4, RHILayout::ShaderReadOnly);
+    global.Set(3, RHILayout::TransferSrc);
+
+    // The list touches mips 1 and 3 only, mips 0 and 2 keep their global layout
+    RHIResourceStateTracker tracker;
+    tracker.Transition(&texture, &global, 4, RHILayout::TransferDst, 1);
+    tracker.Transition(&texture, &global, 4, RHILayout::TransferSrc, 3);
+    tracker.Transition(&texture, &global, 4, RHILayout::ShaderReadOnly, 1);
+
+    std::vector<RHIResourceTransition> fixups;
+    tracker.Resolve(fixups);
+    IGE_CHECK(fixups.size() == 1);
+    IGE_CHECK(IsTransition(fixups[0], &texture, 1, RHILayout::ShaderReadOnly, RHILayout::TransferDst));
+
+    IGE_CHECK(!global.IsUniform());
+    IGE_CHECK(global.Get(0) == RHILayout::ShaderReadOnly);
+    IGE_CHECK(global.Get(1) == RHILayout::ShaderReadOnly);
+    IGE_CHECK(global.Get(3) == RHILayout::TransferSrc);
+
+    // A list entering the whole resource in one layout gets a fixup per subresource that differs
+    RHIResourceStateTracker next;
+    next.Transition(&texture, &global, 4, RHILayout::ShaderReadOnly);
+    fixups.clear();
+    next.Resolve(fixups);
+    IGE_CHECK(fixups.size() == 1);
+    IGE_CHECK(IsTransition(fixups[0], &texture, 3, RHILayout::TransferSrc, RHILayout::ShaderReadOnly));
+    IGE_CHECK(global.IsUniform() && global.Get(3) == RHILayout::ShaderReadOnly);
+
+    // Reset forgets the list's entries, nothing is resolved or committed
+    next.Transition(&texture, &global, 4, RHILayout::TransferDst);
+    next.Reset();
+    fixups.clear();
+    next.Resolve(fixups);
+    IGE_CHECK(fixups.empty() && !next.HasPendingTransitions());
+    IGE_CHECK(global.Get(0) == RHILayout::ShaderReadOnly);
+}
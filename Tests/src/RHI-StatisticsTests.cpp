@@ -0,0 +1,138 @@
+import std;
+import iGe.Common;
+import iGe.RHI;
+
+#include "Test.h"
+
+using namespace iGe;
+
+namespace
+{
+
+// What the totals grew by across record, tests run on one thread so nothing else counts meanwhile
+template<typename F>
+RHIFrameStatistics CountDuring(F&& record) {
+    const RHIFrameStatistics before = RHIStatistics::GetTotals();
+    record();
+    RHIFrameStatistics counted = RHIStatistics::GetTotals();
+    for (uint32 i = 0; i < counted.Values.size(); ++i) { counted.Values[i] -= before.Values[i]; }
+    return counted;
+}
+
+struct Resources {
+    Resources() : Pipeline(CreatePipelineInfo()), Texture(RHITextureCreateInfo{}), Buffer(CreateBufferInfo()) {}
+
+    static RHIGraphicsPipelineCreateInfo CreatePipelineInfo() {
+        RHIGraphicsPipelineCreateInfo info{};
+        info.InputAssemblyState.Topology = RHIPrimitiveTopology::TriangleStrip;
+        return info;
+    }
+    static RHIBufferCreateInfo CreateBufferInfo() {
+        return {256, RHIBufferUsageBit::StorageBuffer, RHIMemoryUsage::CpuToGpu};
+    }
+
+    NullGraphicsPipeline Pipeline;
+    NullTexture Texture;
+    NullBuffer Buffer;
+};
+
+void RecordFrame(RHICommandList& list, const Resources& resources) {
+    list.BindGraphicsPipeline(&resources.Pipeline);
+    list.BindDescriptorSet(nullptr, 0, nullptr);
+    list.Draw(5, 2);
+    list.DrawIndexed(12);
+    list.Dispatch(4, 4);
+
+    list.TransitionTexture(&resources.Texture, RHILayout::ShaderReadOnly);
+    list.TransitionBuffer(&resources.Buffer, RHILayout::TransferDst);
+    const std::array<RHITextureMemoryBarrier, 2> textureBarriers = {
+            RHITextureMemoryBarrier{&resources.Texture}, RHITextureMemoryBarrier{&resources.Texture}};
+    const RHIBufferMemoryBarrier bufferBarrier{&resources.Buffer};
+    RHIBarrierBatch batch;
+    batch.TextureBarriers = textureBarriers;
+    batch.BufferBarriers = {&bufferBarrier, 1};
+    list.PipelineBarrier(&batch);
+}
+
+} // namespace
+
+// =================================================================================================
+// Command Lists
+// =================================================================================================
+
+IGE_TEST(StatisticsCountedByTheFrontEnd) {
+    Resources resources;
+    NullCommandList list;
+    const RHIFrameStatistics counted = CountDuring([&] { RecordFrame(list, resources); });
+
+    // The null backend records nothing, the base entry points still count
+    IGE_CHECK(counted[RHIStatistic::PipelineBinds] == 1);
+    IGE_CHECK(counted[RHIStatistic::DescriptorBinds] == 0);
+    IGE_CHECK(counted[RHIStatistic::DrawCalls] == 2);
+    IGE_CHECK(counted[RHIStatistic::Triangles] == 3 * 2 + 10);
+    IGE_CHECK(counted[RHIStatistic::DispatchCalls] == 1);
+    IGE_CHECK(counted[RHIStatistic::Barriers] == 2 + 3);
+}
+
+IGE_TEST(StatisticsCountReplayedCommandsOnce) {
+    Resources resources;
+    RHICommandEncoder encoder;
+    const RHIFrameStatistics encoded = CountDuring([&] { RecordFrame(encoder, resources); });
+    IGE_CHECK(std::ranges::all_of(encoded.Values, [](uint64 value) { return value == 0; }));
+
+    // Commands count where they reach a backend, the encoder only carries them there
+    NullCommandList list;
+    bool decoded = false;
+    const RHIFrameStatistics replayed =
+            CountDuring([&] { decoded = RHICommandDecoder().Decode(encoder.GetStream(), list); });
+    IGE_CHECK(decoded);
+    const RHIFrameStatistics direct = CountDuring([&] { RecordFrame(list, resources); });
+    IGE_CHECK(replayed.Values == direct.Values);
+
+    // Reset forgets the bound pipeline, draws without one rasterize no triangles
+    const RHIFrameStatistics afterReset = CountDuring([&] {
+        list.Reset();
+        list.Draw(3);
+    });
+    IGE_CHECK(afterReset[RHIStatistic::DrawCalls] == 1 && afterReset[RHIStatistic::Triangles] == 0);
+}
+
+// =================================================================================================
+// Buffers
+// =================================================================================================
+
+IGE_TEST(StatisticsCountUploadBytes) {
+    Resources resources;
+    const std::array<uint8, 64> data{};
+
+    // Update counts what it wrote, clipped to the buffer
+    IGE_CHECK(CountDuring([&] { resources.Buffer.Update(32, 16, data.data()); })[RHIStatistic::UploadBytes] == 16);
+    IGE_CHECK(CountDuring([&] { resources.Buffer.Update(224, 64, data.data()); })[RHIStatistic::UploadBytes] == 32);
+    IGE_CHECK(CountDuring([&] { resources.Buffer.Update(0, 16, nullptr); })[RHIStatistic::UploadBytes] == 0);
+
+    // A new mapping counts the whole buffer once
+    IGE_CHECK(CountDuring([&] { resources.Buffer.Map(); })[RHIStatistic::UploadBytes] == 256);
+    IGE_CHECK(CountDuring([&] { resources.Buffer.Map(); })[RHIStatistic::UploadBytes] == 0);
+    resources.Buffer.Unmap();
+}
+
+// =================================================================================================
+// State Cache
+// =================================================================================================
+
+IGE_TEST(StatisticsCountFilteredBinds) {
+    RHICommandStateCache cache;
+    int pipeline = 0;
+    const RHIFrameStatistics counted = CountDuring([&] {
+        IGE_CHECK(cache.BindPipeline(&pipeline));
+        IGE_CHECK(!cache.BindPipeline(&pipeline));
+        IGE_CHECK(cache.BindPipelineLayout(RHIPipelineBindPoint::Graphics, &pipeline));
+        IGE_CHECK(!cache.BindPipelineLayout(RHIPipelineBindPoint::Graphics, &pipeline));
+        IGE_CHECK(cache.BindRootArgument(RHIPipelineBindPoint::Graphics, 0, 64));
+        IGE_CHECK(!cache.BindRootArgument(RHIPipelineBindPoint::Graphics, 0, 64));
+    });
+
+    // The list's own count and the frame statistic see the same drops
+    IGE_CHECK(counted[RHIStatistic::FilteredBinds] == 3);
+    IGE_CHECK(cache.GetFilteredCount() == 3);
+}
@@ -0,0 +1,368 @@
+import std;
+import iGe.Common;
+import iGe.RHI;
+import iGe.Renderer;
+
+#include "Test.h"
+
+using namespace iGe;
+
+namespace
+{
+
+// =================================================================================================
+// Reference Decoders
+// =================================================================================================
+
+// One 4x4 block of RGBA8 texels in row order, as the encoders take it
+using Block = std::array<uint8, 64>;
+
+uint16 ReadUint16(const uint8* data) { return static_cast<uint16>(data[0] | data[1] << 8); }
+
+std::array<int32, 3> UnpackRGB565(uint16 packed) {
+    const int32 r = (packed >> 11) & 0x1F;
+    const int32 g = (packed >> 5) & 0x3F;
+    const int32 b = packed & 0x1F;
+    return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+}
+
+// Color half of BC1/BC3, BC3 always uses the four color mode
+void DecodeBC1Color(const uint8* data, bool alwaysFourColors, Block& texels) {
+    const uint16 color0 = ReadUint16(data);
+    const uint16 color1 = ReadUint16(data + 2);
+    const std::array<int32, 3> c0 = UnpackRGB565(color0);
+    const std::array<int32, 3> c1 = UnpackRGB565(color1);
+
+    std::array<std::array<int32, 4>, 4> palette{};
+    const bool fourColors = alwaysFourColors || color0 > color1;
+    for (uint32 c = 0; c < 3; ++c) {
+        palette[0][c] = c0[c];
+        palette[1][c] = c1[c];
+        palette[2][c] = fourColors ? (2 * c0[c] + c1[c]) / 3 : (c0[c] + c1[c]) / 2;
+        palette[3][c] = fourColors ? (c0[c] + 2 * c1[c]) / 3 : 0;
+    }
+    for (uint32 i = 0; i < 4; ++i) { palette[i][3] = fourColors || i != 3 ? 255 : 0; }
+
+    for (uint32 i = 0; i < 16; ++i) {
+        const uint32 index = (data[4 + i / 4] >> ((i % 4) * 2)) & 3u;
+        for (uint32 c = 0; c < 4; ++c) { texels[i * 4 + c] = static_cast<uint8>(palette[index][c]); }
+    }
+}
+
+// Single channel BC4 block, signed values come back as int8 stored in the bytes
+void DecodeBC4Values(const uint8* data, bool signedValues, std::array<int32, 16>& values) {
+    const int32 e0 = signedValues ? std::max<int32>(static_cast<int8>(data[0]), -127) : data[0];
+    const int32 e1 = signedValues ? std::max<int32>(static_cast<int8>(data[1]), -127) : data[1];
+
+    std::array<int32, 8> palette = {e0, e1};
+    for (int32 i = 1; i < 7; ++i) {
+        if (e0 > e1) {
+            palette[i + 1] = ((7 - i) * e0 + i * e1) / 7;
+        } else if (i < 5) {
+            palette[i + 1] = ((5 - i) * e0 + i * e1) / 5;
+        }
+    }
+    if (e0 <= e1) {
+        palette[6] = signedValues ? -127 : 0;
+        palette[7] = signedValues ? 127 : 255;
+    }
+
+    uint64 bits = 0;
+    for (uint32 i = 0; i < 6; ++i) { bits |= static_cast<uint64>(data[2 + i]) << (i * 8); }
+    for (uint32 i = 0; i < 16; ++i) { values[i] = palette[(bits >> (i * 3)) & 7u]; }
+}
+
+// LSB-first bit reading matching the BC7 block layout
+struct BitReader {
+    const uint8* Data;
+    uint32 Position = 0;
+
+    uint32 Read(uint32 bitCount) {
+        uint32 value = 0;
+        for (uint32 i = 0; i < bitCount; ++i, ++Position) {
+            value |= ((Data[Position >> 3] >> (Position & 7u)) & 1u) << i;
+        }
+        return value;
+    }
+};
+
+// Only mode 6 is produced, any other mode fails the decode
+bool DecodeBC7Mode6(const uint8* data, Block& texels, uint32& anchorIndex) {
+    BitReader reader{data};
+    if (reader.Read(7) != 1u << 6) { return false; }
+
+    std::array<std::array<uint32, 4>, 2> endpoints{};
+    for (uint32 c = 0; c < 4; ++c) {
+        endpoints[0][c] = reader.Read(7);
+        endpoints[1][c] = reader.Read(7);
+    }
+    const uint32 p0 = reader.Read(1);
+    const uint32 p1 = reader.Read(1);
+    for (uint32 c = 0; c < 4; ++c) {
+        endpoints[0][c] = endpoints[0][c] << 1 | p0;
+        endpoints[1][c] = endpoints[1][c] << 1 | p1;
+    }
+
+    constexpr std::array<uint32, 16> weights = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+    for (uint32 i = 0; i < 16; ++i) {
+        const uint32 index = reader.Read(i == 0 ? 3 : 4);
+        if (i == 0) { anchorIndex = index; }
+        for (uint32 c = 0; c < 4; ++c) {
+            const uint32 value = (64 - weights[index]) * endpoints[0][c] + weights[index] * endpoints[1][c] + 32;
+            texels[i * 4 + c] = static_cast<uint8>(value >> 6);
+        }
+    }
+    return reader.Position == 128;
+}
+
+// =================================================================================================
+// Test Blocks
+// =================================================================================================
+
+// Colors along one line through RGBA space, what the endpoint fit is built for
+Block MakeGradientBlock(const std::array<uint8, 4>& from, const std::array<uint8, 4>& to) {
+    Block block{};
+    for (uint32 i = 0; i < 16; ++i) {
+        for (uint32 c = 0; c < 4; ++c) {
+            const int32 value = from[c] + (static_cast<int32>(to[c]) - from[c]) * static_cast<int32>(i) / 15;
+            block[i * 4 + c] = static_cast<uint8>(value);
+        }
+    }
+    return block;
+}
+
+Block MakeSolidBlock(const std::array<uint8, 4>& color) { return MakeGradientBlock(color, color); }
+
+int32 GetMaxError(const Block& source, const Block& decoded, uint32 firstChannel, uint32 channelCount) {
+    int32 error = 0;
+    for (uint32 i = 0; i < 16; ++i) {
+        for (uint32 c = firstChannel; c < firstChannel + channelCount; ++c) {
+            error = std::max(error, std::abs(static_cast<int32>(source[i * 4 + c]) - decoded[i * 4 + c]));
+        }
+    }
+    return error;
+}
+
+// Widest spread of any of the channels, quantization error scales with it
+int32 GetRange(const Block& source, uint32 firstChannel, uint32 channelCount) {
+    int32 range = 0;
+    for (uint32 c = firstChannel; c < firstChannel + channelCount; ++c) {
+        uint8 minValue = 255;
+        uint8 maxValue = 0;
+        for (uint32 i = 0; i < 16; ++i) {
+            minValue = std::min(minValue, source[i * 4 + c]);
+            maxValue = std::max(maxValue, source[i * 4 + c]);
+        }
+        range = std::max(range, maxValue - minValue);
+    }
+    return range;
+}
+
+// The red to blue one has anti-correlated channels, its axis is orthogonal to (1, 1, 1)
+const std::array<Block, 5> GradientBlocks = {MakeGradientBlock({0, 0, 0, 255}, {255, 255, 255, 255}),
+                                             MakeGradientBlock({255, 0, 0, 255}, {0, 0, 255, 255}),
+                                             MakeGradientBlock({200, 40, 10, 255}, {20, 90, 230, 255}),
+                                             MakeGradientBlock({16, 128, 64, 0}, {16, 160, 96, 255}),
+                                             MakeGradientBlock({90, 91, 92, 93}, {100, 101, 102, 103})};
+
+} // namespace
+
+// =================================================================================================
+// BC1 / BC3
+// =================================================================================================
+
+IGE_TEST(BC1OpaqueBlocksUseFourColorMode) {
+    for (const Block& source: GradientBlocks) {
+        Block opaque = source;
+        for (uint32 i = 0; i < 16; ++i) { opaque[i * 4 + 3] = 255; }
+
+        std::array<uint8, 8> encoded{};
+        EncodeBC1Block(opaque.data(), encoded.data());
+
+        // Four color mode is signalled by color0 > color1, unless the block collapsed to one color
+        const uint16 color0 = ReadUint16(encoded.data());
+        const uint16 color1 = ReadUint16(encoded.data() + 2);
+        IGE_CHECK(color0 >= color1);
+
+        Block decoded{};
+        DecodeBC1Color(encoded.data(), false, decoded);
+
+        // Half the spacing of four palette entries, plus what 5:6:5 endpoints lose
+        IGE_CHECK(GetMaxError(opaque, decoded, 0, 3) <= GetRange(opaque, 0, 3) / 6 + 8);
+        IGE_CHECK(GetMaxError(opaque, decoded, 3, 1) == 0);
+    }
+}
+
+IGE_TEST(BC1TransparentTexelsTakeTheLastIndex) {
+    Block source = MakeGradientBlock({255, 0, 0, 255}, {0, 0, 255, 255});
+    for (uint32 i: {0u, 5u, 15u}) { source[i * 4 + 3] = 0; }
+
+    std::array<uint8, 8> encoded{};
+    EncodeBC1Block(source.data(), encoded.data());
+    IGE_CHECK(ReadUint16(encoded.data()) <= ReadUint16(encoded.data() + 2));
+
+    Block decoded{};
+    DecodeBC1Color(encoded.data(), false, decoded);
+    const int32 tolerance = GetRange(source, 0, 3) / 4 + 8;
+    for (uint32 i = 0; i < 16; ++i) {
+        const bool transparent = source[i * 4 + 3] == 0;
+        IGE_CHECK(decoded[i * 4 + 3] == (transparent ? 0 : 255));
+        if (!transparent) {
+            for (uint32 c = 0; c < 3; ++c) { IGE_CHECK(std::abs(source[i * 4 + c] - decoded[i * 4 + c]) <= tolerance); }
+        }
+    }
+}
+
+IGE_TEST(BC1SolidBlocksRoundTripExactly) {
+    // Colors whose channels survive 5:6:5 quantization unchanged
+    for (const std::array<uint8, 4>& color: {std::array<uint8, 4>{255, 0, 255, 255}, {0, 255, 0, 255},
+                                             {132, 65, 24, 255}, {0, 0, 0, 255}}) {
+        const Block source = MakeSolidBlock(color);
+        std::array<uint8, 8> encoded{};
+        EncodeBC1Block(source.data(), encoded.data());
+
+        Block decoded{};
+        DecodeBC1Color(encoded.data(), false, decoded);
+        IGE_CHECK(decoded == source);
+    }
+}
+
+IGE_TEST(BC3KeepsAlphaApartFromColor) {
+    for (const Block& source: GradientBlocks) {
+        std::array<uint8, 16> encoded{};
+        EncodeBC3Block(source.data(), encoded.data());
+
+        // Alpha is a BC4 block ahead of the color block
+        std::array<int32, 16> alpha{};
+        DecodeBC4Values(encoded.data(), false, alpha);
+        Block decoded{};
+        DecodeBC1Color(encoded.data() + 8, true, decoded);
+        for (uint32 i = 0; i < 16; ++i) { decoded[i * 4 + 3] = static_cast<uint8>(alpha[i]); }
+
+        IGE_CHECK(GetMaxError(source, decoded, 0, 3) <= GetRange(source, 0, 3) / 6 + 8);
+        IGE_CHECK(GetMaxError(source, decoded, 3, 1) <= GetRange(source, 3, 1) / 14 + 1);
+    }
+}
+
+// =================================================================================================
+// BC4 / BC5
+// =================================================================================================
+
+IGE_TEST(BC4StoresTheRangeAsEndpoints) {
+    for (const Block& source: GradientBlocks) {
+        for (uint32 channel = 0; channel < 4; ++channel) {
+            std::array<uint8, 8> encoded{};
+            EncodeBC4Block(source.data(), channel, false, encoded.data());
+
+            // Eight value mode, endpoint 0 is the maximum and endpoint 1 the minimum
+            uint8 minValue = 255;
+            uint8 maxValue = 0;
+            for (uint32 i = 0; i < 16; ++i) {
+                minValue = std::min(minValue, source[i * 4 + channel]);
+                maxValue = std::max(maxValue, source[i * 4 + channel]);
+            }
+            IGE_CHECK(encoded[0] == maxValue && encoded[1] == minValue);
+
+            std::array<int32, 16> decoded{};
+            DecodeBC4Values(encoded.data(), false, decoded);
+            const int32 step = (maxValue - minValue) / 14 + 1;
+            for (uint32 i = 0; i < 16; ++i) { IGE_CHECK(std::abs(source[i * 4 + channel] - decoded[i]) <= step); }
+        }
+    }
+}
+
+IGE_TEST(BC4SignedMapsOntoTheSignedRange) {
+    const Block source = GradientBlocks[0];
+    std::array<uint8, 8> encoded{};
+    EncodeBC4Block(source.data(), 0, true, encoded.data());
+    IGE_CHECK(static_cast<int8>(encoded[0]) == 127 && static_cast<int8>(encoded[1]) == -127);
+
+    // Bytes [0, 255] come back as [-127, 127]
+    std::array<int32, 16> decoded{};
+    DecodeBC4Values(encoded.data(), true, decoded);
+    for (uint32 i = 0; i < 16; ++i) {
+        const float32 expected = static_cast<float32>(source[i * 4]) * (254.0f / 255.0f) - 127.0f;
+        IGE_CHECK(std::abs(expected - static_cast<float32>(decoded[i])) <= 19.0f);
+    }
+    IGE_CHECK(decoded[0] == -127 && decoded[15] == 127);
+}
+
+IGE_TEST(BC5PacksRedThenGreen) {
+    const Block source = GradientBlocks[1];
+    std::array<uint8, 16> encoded{};
+    EncodeBC5Block(source.data(), false, encoded.data());
+
+    std::array<uint8, 8> red{};
+    std::array<uint8, 8> green{};
+    EncodeBC4Block(source.data(), 0, false, red.data());
+    EncodeBC4Block(source.data(), 1, false, green.data());
+    IGE_CHECK(std::equal(red.begin(), red.end(), encoded.begin()));
+    IGE_CHECK(std::equal(green.begin(), green.end(), encoded.begin() + 8));
+}
+
+// =================================================================================================
+// BC7
+// =================================================================================================
+
+IGE_TEST(BC7Mode6RoundTrips) {
+    for (const Block& source: GradientBlocks) {
+        std::array<uint8, 16> encoded{};
+        EncodeBC7Block(source.data(), encoded.data());
+
+        // The anchor texel has no room for the top index bit, the encoder swaps endpoints to keep it clear
+        Block decoded{};
+        uint32 anchorIndex = 0;
+        IGE_CHECK(DecodeBC7Mode6(encoded.data(), decoded, anchorIndex));
+        IGE_CHECK(anchorIndex < 8);
+        IGE_CHECK(GetMaxError(source, decoded, 0, 4) <= 4);
+    }
+}
+
+IGE_TEST(BC7SolidBlocksRoundTrip) {
+    for (const std::array<uint8, 4>& color: {std::array<uint8, 4>{255, 255, 255, 255}, {0, 0, 0, 0},
+                                             {17, 200, 64, 128}, {254, 1, 127, 33}}) {
+        const Block source = MakeSolidBlock(color);
+        std::array<uint8, 16> encoded{};
+        EncodeBC7Block(source.data(), encoded.data());
+
+        Block decoded{};
+        uint32 anchorIndex = 0;
+        IGE_CHECK(DecodeBC7Mode6(encoded.data(), decoded, anchorIndex));
+        IGE_CHECK(GetMaxError(source, decoded, 0, 4) <= 1);
+    }
+}
+
+// =================================================================================================
+// Image Compression
+// =================================================================================================
+
+IGE_TEST(CompressImageClampsPartialEdgeBlocks) {
+    // 6x5 image, the second block column and row repeat the last texel column and row
+    constexpr uint32 Width = 6;
+    constexpr uint32 Height = 5;
+    std::vector<uint8> image(Width * Height * 4);
+    for (uint32 i = 0; i < image.size(); ++i) { image[i] = static_cast<uint8>(i * 7); }
+
+    constexpr uint64 DstRowPitch = 2 * 16;
+    std::vector<uint8> compressed(DstRowPitch * 2);
+    IGE_CHECK(CompressImage(RHIFormat::BC7UNorm, image.data(), Width, Height, Width * 4, compressed.data(),
+                            DstRowPitch));
+
+    for (uint32 blockY = 0; blockY < 2; ++blockY) {
+        for (uint32 blockX = 0; blockX < 2; ++blockX) {
+            Block texels{};
+            for (uint32 i = 0; i < 16; ++i) {
+                const uint32 x = std::min(blockX * 4 + i % 4, Width - 1);
+                const uint32 y = std::min(blockY * 4 + i / 4, Height - 1);
+                std::memcpy(&texels[i * 4], &image[(y * Width + x) * 4], 4);
+            }
+
+            std::array<uint8, 16> expected{};
+            EncodeBC7Block(texels.data(), expected.data());
+            IGE_CHECK(std::memcmp(expected.data(), &compressed[blockY * DstRowPitch + blockX * 16], 16) == 0);
+        }
+    }
+
+    IGE_CHECK(!CompressImage(RHIFormat::R8G8B8A8UNorm, image.data(), Width, Height, Width * 4, compressed.data(),
+                             DstRowPitch));
+}
@@ -0,0 +1,168 @@
+import std;
+import iGe.Common;
+import iGe.RHI;
+import iGe.Renderer;
+
+#include "Test.h"
+
+using namespace iGe;
+
+namespace
+{
+
+// Scratch directory of one test, removed with everything in it
+class ScratchDirectory {
+public:
+    explicit ScratchDirectory(std::string_view name)
+        : m_Path(std::filesystem::temp_directory_path() / "iGe_tests" / name) {
+        std::filesystem::remove_all(m_Path);
+        std::filesystem::create_directories(m_Path);
+    }
+    ~ScratchDirectory() {
+        std::error_code ec;
+        std::filesystem::remove_all(m_Path, ec);
+    }
+
+    std::filesystem::path operator/(std::string_view file) const { return m_Path / file; }
+
+private:
+    std::filesystem::path m_Path;
+};
+
+// Uncompressed 32-bit TGA with a top-left origin, the simplest source stb_image decodes
+void WriteTga(const std::filesystem::path& path, uint32 width, uint32 height, const std::vector<uint8>& rgba) {
+    std::array<uint8, 18> header{};
+    header[2] = 2; // Uncompressed true color
+    header[12] = static_cast<uint8>(width);
+    header[13] = static_cast<uint8>(width >> 8);
+    header[14] = static_cast<uint8>(height);
+    header[15] = static_cast<uint8>(height >> 8);
+    header[16] = 32;
+    header[17] = 0x28; // 8 alpha bits, top-left origin
+
+    std::vector<uint8> bgra = rgba;
+    for (uint64 i = 0; i < bgra.size(); i += 4) { std::swap(bgra[i], bgra[i + 2]); }
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(header.data()), header.size());
+    file.write(reinterpret_cast<const char*>(bgra.data()), static_cast<std::streamsize>(bgra.size()));
+}
+
+std::vector<uint8> MakePixels(uint32 width, uint32 height) {
+    std::vector<uint8> rgba(static_cast<uint64>(width) * height * 4);
+    for (uint64 i = 0; i < rgba.size(); ++i) { rgba[i] = static_cast<uint8>(i * 13 + i / 4); }
+    return rgba;
+}
+
+} // namespace
+
+// =================================================================================================
+// Texture Container
+// =================================================================================================
+
+IGE_TEST(TextureContainerHeaderMapsOntoCreateInfo) {
+    ScratchDirectory directory("TextureContainerHeaderMapsOntoCreateInfo");
+    TextureContainerHeader header;
+    header.Type = RHITextureType::Texture2D;
+    header.Format = RHIFormat::BC5UNorm;
+    header.Extent = {64, 32, 1};
+    header.MipLevels = 2;
+    header.ArrayLayers = 6;
+    header.ContainerFlags = TextureContainerFlagBits::CubeMap;
+
+    // One 4x4 block per subresource is enough, only the header is checked
+    std::vector<TextureContainerSubresource> subresources(header.MipLevels * header.ArrayLayers);
+    for (uint32 i = 0; i < subresources.size(); ++i) {
+        subresources[i] = {i % 2, i / 2, {4, 4, 1}, 16, 1, 0, i * 16ull, 16};
+    }
+    const std::vector<std::byte> data(subresources.size() * 16);
+    IGE_CHECK(WriteTextureContainer(directory / "cube.igtex", header, subresources, data));
+
+    MappedFile file(directory / "cube.igtex");
+    TextureContainerView view;
+    IGE_CHECK(file.IsOpen() && ParseTextureContainer(file.GetData(), view));
+    IGE_CHECK(view.Header.SubresourceCount == subresources.size() && view.Header.DataSize == data.size());
+    IGE_CHECK(view.Header.ContainerFlags.HasFlag(TextureContainerFlagBits::CubeMap));
+
+    const RHITextureCreateInfo info = ToTextureCreateInfo(view.Header);
+    IGE_CHECK(info.Type == header.Type && info.Format == header.Format);
+    IGE_CHECK(info.Extent.Width == 64 && info.Extent.Height == 32 && info.Extent.Depth == 1);
+    IGE_CHECK(info.MipLevels == 2 && info.ArrayLayers == 6);
+
+    // Containers hold immutable GPU data, uploaded once through a copy
+    IGE_CHECK(info.Usage == (RHITextureUsageFlagBits::Sampled | RHITextureUsageFlagBits::TransferDst));
+    IGE_CHECK(info.MemoryUsage == RHIMemoryUsage::GpuOnly);
+    IGE_CHECK(!info.pInitialData && info.InitialDataSize == 0);
+}
+
+// =================================================================================================
+// Texture Cooker
+// =================================================================================================
+
+IGE_TEST(TextureCookerWritesBlockCompressedMipChain) {
+    ScratchDirectory directory("TextureCookerWritesBlockCompressedMipChain");
+    WriteTga(directory / "source.tga", 10, 6, MakePixels(10, 6));
+
+    TextureCooker cooker;
+    TextureCookSettings settings;
+    settings.Format = RHIFormat::BC7Srgb;
+    IGE_CHECK(cooker.Cook(directory / "source.tga", directory / "cooked.igtex", settings));
+
+    MappedFile file(directory / "cooked.igtex");
+    TextureContainerView view;
+    IGE_CHECK(file.IsOpen() && ParseTextureContainer(file.GetData(), view));
+    const RHITextureCreateInfo info = ToTextureCreateInfo(view.Header);
+    IGE_CHECK(info.Type == RHITextureType::Texture2D && info.Format == RHIFormat::BC7Srgb);
+    IGE_CHECK(info.Extent.Width == 10 && info.Extent.Height == 6 && info.Extent.Depth == 1);
+    IGE_CHECK(info.MipLevels == GetMipLevelCount(10, 6) && info.ArrayLayers == 1);
+
+    // 10x6, 5x3, 2x1, 1x1, every level rounds up to whole blocks of 16 bytes
+    IGE_CHECK(view.Subresources.size() == info.MipLevels);
+    for (uint32 level = 0; level < view.Subresources.size(); ++level) {
+        const auto& subresource = view.Subresources[level];
+        const uint32 width = std::max(10u >> level, 1u);
+        const uint32 height = std::max(6u >> level, 1u);
+        IGE_CHECK(subresource.MipLevel == level && subresource.ArrayLayer == 0);
+        IGE_CHECK(subresource.Extent.Width == width && subresource.Extent.Height == height);
+        IGE_CHECK(subresource.RowPitch == (width + 3) / 4 * 16 && subresource.RowCount == (height + 3) / 4);
+        IGE_CHECK(subresource.Offset % 16 == 0);
+    }
+}
+
+IGE_TEST(TextureCookerKeepsUncompressedTexels) {
+    ScratchDirectory directory("TextureCookerKeepsUncompressedTexels");
+    const std::vector<uint8> pixels = MakePixels(5, 3);
+    WriteTga(directory / "source.tga", 5, 3, pixels);
+
+    TextureCooker cooker;
+    TextureCookSettings settings;
+    settings.Format = RHIFormat::R8G8B8A8UNorm;
+    settings.GenerateMips = false;
+    settings.FlipVertically = true;
+    IGE_CHECK(cooker.Cook(directory / "source.tga", directory / "cooked.igtex", settings));
+
+    MappedFile file(directory / "cooked.igtex");
+    TextureContainerView view;
+    IGE_CHECK(file.IsOpen() && ParseTextureContainer(file.GetData(), view));
+    const RHITextureCreateInfo info = ToTextureCreateInfo(view.Header);
+    IGE_CHECK(info.Format == RHIFormat::R8G8B8A8UNorm && info.MipLevels == 1);
+    IGE_CHECK(view.Subresources.size() == 1 && view.Subresources[0].RowPitch == 5 * 4);
+
+    // Rows come out bottom to top, texels untouched
+    const std::span<const std::byte> texels = view.GetSubresourceData(view.Subresources[0]);
+    IGE_CHECK(texels.size() == pixels.size());
+    for (uint32 row = 0; row < 3 && texels.size() == pixels.size(); ++row) {
+        IGE_CHECK(std::memcmp(texels.data() + row * 20, pixels.data() + (2 - row) * 20, 20) == 0);
+    }
+}
+
+IGE_TEST(TextureCookerRejectsUncookableFormats) {
+    ScratchDirectory directory("TextureCookerRejectsUncookableFormats");
+    WriteTga(directory / "source.tga", 4, 4, MakePixels(4, 4));
+
+    TextureCooker cooker;
+    TextureCookSettings settings;
+    settings.Format = RHIFormat::R32SFloat;
+    IGE_CHECK(!cooker.Cook(directory / "source.tga", directory / "cooked.igtex", settings));
+    IGE_CHECK(!std::filesystem::exists(directory / "cooked.igtex"));
+}
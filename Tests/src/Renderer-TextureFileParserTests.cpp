@@ -0,0 +1,287 @@
+import std;
+import iGe.Common;
+import iGe.Renderer;
+
+#include "Test.h"
+
+using namespace iGe;
+
+namespace
+{
+
+// =================================================================================================
+// Synthetic Files
+// =================================================================================================
+
+class FileBuilder {
+public:
+    explicit FileBuilder(uint64 size) : m_Bytes(size) {}
+
+    template<typename T>
+    void Write(uint64 offset, T value) {
+        std::memcpy(m_Bytes.data() + offset, &value, sizeof(T));
+    }
+
+    std::span<const std::byte> GetData() const { return m_Bytes; }
+
+private:
+    std::vector<std::byte> m_Bytes;
+};
+
+constexpr uint64 DdsHeaderOffset = 4; // After the magic
+constexpr uint64 DdsDataOffset = 4 + 124;
+constexpr uint64 DdsDX10DataOffset = DdsDataOffset + 20;
+
+constexpr uint32 DdsFourCC(char a, char b, char c, char d) {
+    return static_cast<uint32>(a) | static_cast<uint32>(b) << 8 | static_cast<uint32>(c) << 16 |
+           static_cast<uint32>(d) << 24;
+}
+
+// DDS with a DX10 header, dxgiFormat 28 is R8G8B8A8UNorm
+FileBuilder MakeDX10Dds(uint32 width, uint32 height, uint32 mips, uint32 arraySize, uint64 payloadSize,
+                        uint32 dxgiFormat = 28, uint32 miscFlag = 0) {
+    FileBuilder file(DdsDX10DataOffset + payloadSize);
+    file.Write<uint32>(0, 0x20534444);
+    file.Write<uint32>(DdsHeaderOffset + 0, 124);
+    file.Write<uint32>(DdsHeaderOffset + 4, 0x20000); // Mip count present
+    file.Write<uint32>(DdsHeaderOffset + 8, height);
+    file.Write<uint32>(DdsHeaderOffset + 12, width);
+    file.Write<uint32>(DdsHeaderOffset + 24, mips);
+    file.Write<uint32>(DdsHeaderOffset + 72, 32);
+    file.Write<uint32>(DdsHeaderOffset + 76, 0x4); // FourCC
+    file.Write<uint32>(DdsHeaderOffset + 80, DdsFourCC('D', 'X', '1', '0'));
+    file.Write<uint32>(DdsDataOffset + 0, dxgiFormat);
+    file.Write<uint32>(DdsDataOffset + 4, 3); // Texture2D
+    file.Write<uint32>(DdsDataOffset + 8, miscFlag);
+    file.Write<uint32>(DdsDataOffset + 12, arraySize);
+    return file;
+}
+
+constexpr uint64 Ktx2HeaderSize = 80;
+constexpr uint64 Ktx2LevelSize = 24;
+constexpr std::array<uint8, 12> Ktx2Identifier = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32,
+                                                  0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+// KTX2 with levels stored back to back after the level index, vkFormat 37 is R8G8B8A8UNorm
+FileBuilder MakeKtx2(uint32 width, uint32 height, uint32 levels, uint32 layers, uint32 faces,
+                     std::span<const uint64> levelSizes, uint32 supercompression = 0) {
+    const uint64 dataOffset = Ktx2HeaderSize + Ktx2LevelSize * levelSizes.size();
+    uint64 payloadSize = 0;
+    for (uint64 size: levelSizes) { payloadSize += size; }
+
+    FileBuilder file(dataOffset + payloadSize);
+    for (uint64 i = 0; i < Ktx2Identifier.size(); ++i) { file.Write<uint8>(i, Ktx2Identifier[i]); }
+    file.Write<uint32>(12, 37);
+    file.Write<uint32>(16, 1);
+    file.Write<uint32>(20, width);
+    file.Write<uint32>(24, height);
+    file.Write<uint32>(32, layers);
+    file.Write<uint32>(36, faces);
+    file.Write<uint32>(40, levels);
+    file.Write<uint32>(44, supercompression);
+
+    uint64 offset = dataOffset;
+    for (uint64 level = 0; level < levelSizes.size(); ++level) {
+        file.Write<uint64>(Ktx2HeaderSize + level * Ktx2LevelSize, offset);
+        file.Write<uint64>(Ktx2HeaderSize + level * Ktx2LevelSize + 8, levelSizes[level]);
+        offset += levelSizes[level];
+    }
+    return file;
+}
+
+} // namespace
+
+// =================================================================================================
+// DDS
+// =================================================================================================
+
+IGE_TEST(DdsParsesLayersWithMipChains) {
+    // Two 4x4 RGBA8 layers with three mips each: 64 + 16 + 4 bytes per layer
+    const FileBuilder file = MakeDX10Dds(4, 4, 3, 2, 2 * (64 + 16 + 4));
+    IGE_CHECK(GetTextureFileType(file.GetData()) == TextureFileType::DDS);
+
+    TextureContainerView view;
+    IGE_CHECK(ParseDDS(file.GetData(), view));
+    IGE_CHECK(view.Header.Format == RHIFormat::R8G8B8A8UNorm);
+    IGE_CHECK(view.Header.MipLevels == 3);
+    IGE_CHECK(view.Header.ArrayLayers == 2);
+    IGE_CHECK(view.Subresources.size() == 6);
+    if (view.Subresources.size() != 6) { return; }
+
+    // Layer by layer, each holding its full mip chain
+    const std::array<uint64, 6> offsets = {0, 64, 80, 84, 148, 164};
+    for (uint32 i = 0; i < 6; ++i) {
+        const auto& subresource = view.Subresources[i];
+        IGE_CHECK(subresource.ArrayLayer == i / 3);
+        IGE_CHECK(subresource.MipLevel == i % 3);
+        IGE_CHECK(subresource.Offset == DdsDX10DataOffset + offsets[i]);
+        IGE_CHECK(subresource.RowPitch == (4u >> (i % 3)) * 4);
+    }
+}
+
+IGE_TEST(DdsParsesLegacyBlockCompressedCube) {
+    // 8x8 DXT1 cube, one mip: 2x2 blocks of 8 bytes per face
+    FileBuilder file(DdsDataOffset + 6 * 32);
+    file.Write<uint32>(0, 0x20534444);
+    file.Write<uint32>(DdsHeaderOffset + 0, 124);
+    file.Write<uint32>(DdsHeaderOffset + 8, 8);
+    file.Write<uint32>(DdsHeaderOffset + 12, 8);
+    file.Write<uint32>(DdsHeaderOffset + 76, 0x4);
+    file.Write<uint32>(DdsHeaderOffset + 80, DdsFourCC('D', 'X', 'T', '1'));
+    file.Write<uint32>(DdsHeaderOffset + 108, 0x200); // Cube map
+
+    TextureContainerView view;
+    IGE_CHECK(ParseDDS(file.GetData(), view));
+    IGE_CHECK(view.Header.Format == RHIFormat::BC1RGBAUNorm);
+    IGE_CHECK(view.Header.ArrayLayers == 6);
+    IGE_CHECK(view.Header.ContainerFlags.HasFlag(TextureContainerFlagBits::CubeMap));
+    IGE_CHECK(view.Subresources.size() == 6);
+    for (const auto& subresource: view.Subresources) {
+        IGE_CHECK(subresource.RowPitch == 16);
+        IGE_CHECK(subresource.RowCount == 2);
+        IGE_CHECK(subresource.Size == 32);
+    }
+}
+
+IGE_TEST(DdsRejectsTruncatedPayload) {
+    const FileBuilder file = MakeDX10Dds(4, 4, 1, 1, 63);
+    TextureContainerView view;
+    IGE_CHECK(!ParseDDS(file.GetData(), view));
+}
+
+IGE_TEST(DdsRejectsTruncatedHeader) {
+    const FileBuilder file = MakeDX10Dds(4, 4, 1, 1, 64);
+    TextureContainerView view;
+    IGE_CHECK(!ParseDDS(file.GetData().first(DdsDataOffset + 10), view));
+    IGE_CHECK(!ParseDDS(file.GetData().first(64), view));
+}
+
+IGE_TEST(DdsRejectsHugeLayerCount) {
+    // A header of a few hundred bytes must not size anything from its layer count
+    const FileBuilder file = MakeDX10Dds(4, 4, 1, 0xFFFFFFFF, 64);
+    TextureContainerView view;
+    IGE_CHECK(!ParseDDS(file.GetData(), view));
+    IGE_CHECK(view.Subresources.capacity() < 0xFFFF);
+}
+
+IGE_TEST(DdsRejectsCubeLayerCountThatWraps) {
+    // 0x2AAAAAAB cubes are 0x100000002 faces, two once wrapped to 32 bits
+    const FileBuilder file = MakeDX10Dds(4, 4, 1, 0x2AAAAAAB, 2 * 64, 28, 0x4);
+    TextureContainerView view;
+    IGE_CHECK(!ParseDDS(file.GetData(), view));
+}
+
+IGE_TEST(DdsRejectsLayersTheFileCannotHold) {
+    // Within the layer limit, but the payload only holds one layer
+    const FileBuilder file = MakeDX10Dds(4, 4, 1, 2048, 64);
+    TextureContainerView view;
+    IGE_CHECK(!ParseDDS(file.GetData(), view));
+}
+
+IGE_TEST(DdsRejectsTooManyMips) {
+    const FileBuilder file = MakeDX10Dds(4, 4, 4, 1, 1024);
+    TextureContainerView view;
+    IGE_CHECK(!ParseDDS(file.GetData(), view));
+}
+
+// =================================================================================================
+// KTX2
+// =================================================================================================
+
+IGE_TEST(Ktx2ParsesLevelsFromTheIndex) {
+    const std::array<uint64, 2> levelSizes = {2 * 64, 2 * 16};
+    const FileBuilder file = MakeKtx2(4, 4, 2, 2, 1, levelSizes);
+    IGE_CHECK(GetTextureFileType(file.GetData()) == TextureFileType::KTX2);
+
+    TextureContainerView view;
+    IGE_CHECK(ParseKTX2(file.GetData(), view));
+    IGE_CHECK(view.Header.MipLevels == 2);
+    IGE_CHECK(view.Header.ArrayLayers == 2);
+    IGE_CHECK(view.Subresources.size() == 4);
+    if (view.Subresources.size() != 4) { return; }
+
+    // Reordered layer by layer, each level stores its layers back to back
+    const uint64 dataOffset = Ktx2HeaderSize + 2 * Ktx2LevelSize;
+    IGE_CHECK(view.Subresources[0].Offset == dataOffset);
+    IGE_CHECK(view.Subresources[1].Offset == dataOffset + 128);
+    IGE_CHECK(view.Subresources[2].Offset == dataOffset + 64);
+    IGE_CHECK(view.Subresources[3].Offset == dataOffset + 128 + 16);
+    IGE_CHECK(view.Subresources[3].ArrayLayer == 1 && view.Subresources[3].MipLevel == 1);
+}
+
+IGE_TEST(Ktx2RejectsHugeLayerCount) {
+    const std::array<uint64, 1> levelSizes = {64};
+    const FileBuilder file = MakeKtx2(4, 4, 1, 0xFFFFFFFF, 6, levelSizes);
+    TextureContainerView view;
+    IGE_CHECK(!ParseKTX2(file.GetData(), view));
+}
+
+IGE_TEST(Ktx2RejectsLayersTheFileCannotHold) {
+    const std::array<uint64, 1> levelSizes = {64};
+    const FileBuilder file = MakeKtx2(4, 4, 1, 1024, 1, levelSizes);
+    TextureContainerView view;
+    IGE_CHECK(!ParseKTX2(file.GetData(), view));
+}
+
+IGE_TEST(Ktx2RejectsShortLevel) {
+    const std::array<uint64, 1> levelSizes = {64};
+    const FileBuilder file = MakeKtx2(4, 4, 1, 2, 1, levelSizes);
+    TextureContainerView view;
+    IGE_CHECK(!ParseKTX2(file.GetData(), view));
+}
+
+IGE_TEST(Ktx2RejectsSupercompression) {
+    const std::array<uint64, 1> levelSizes = {64};
+    const FileBuilder file = MakeKtx2(4, 4, 1, 1, 1, levelSizes, 2);
+    TextureContainerView view;
+    IGE_CHECK(!ParseKTX2(file.GetData(), view));
+}
+
+IGE_TEST(TextureFileTypeNeedsTheMagic) {
+    const std::array<std::byte, 3> tooShort{};
+    IGE_CHECK(GetTextureFileType(tooShort) == TextureFileType::Unknown);
+    const std::array<std::byte, 16> zeros{};
+    IGE_CHECK(GetTextureFileType(zeros) == TextureFileType::Unknown);
+}
+
+// =================================================================================================
+// Upload Footprints
+// =================================================================================================
+
+IGE_TEST(UploadFootprintsPadRowsAndAlignSubresources) {
+    // 4x4 RGBA8 with three mips, rows of 16, 8 and 4 bytes
+    const FileBuilder file = MakeDX10Dds(4, 4, 3, 1, 64 + 16 + 4);
+    TextureContainerView view;
+    IGE_CHECK(ParseDDS(file.GetData(), view));
+
+    std::vector<RHIBufferTextureCopy> regions;
+    const uint64 size = ComputeUploadFootprints(view, 512, 256, regions);
+    IGE_CHECK(regions.size() == 3);
+    if (regions.size() != 3) { return; }
+
+    // Every row pads to 256 bytes, every subresource starts on a 512 byte boundary
+    IGE_CHECK(regions[0].BufferOffset == 0);
+    IGE_CHECK(regions[1].BufferOffset == 1024);
+    IGE_CHECK(regions[2].BufferOffset == 1536);
+    for (const auto& region: regions) { IGE_CHECK(region.BufferRowPitch == 256); }
+    IGE_CHECK(regions[2].Extent.Width == 1 && regions[2].Extent.Height == 1);
+    IGE_CHECK(size == 1536 + 256);
+}
+
+IGE_TEST(UploadRowsLandAtTheirPaddedPitch) {
+    // One 2x2 RGBA8 image with distinct bytes
+    FileBuilder file = MakeDX10Dds(2, 2, 1, 1, 16);
+    for (uint8 i = 0; i < 16; ++i) { file.Write<uint8>(DdsDX10DataOffset + i, static_cast<uint8>(i + 1)); }
+    TextureContainerView view;
+    IGE_CHECK(ParseDDS(file.GetData(), view));
+
+    std::vector<RHIBufferTextureCopy> regions;
+    const uint64 size = ComputeUploadFootprints(view, 4, 16, regions);
+    std::vector<uint8> staging(size);
+    CopyUploadRows(view, regions, staging.data());
+
+    IGE_CHECK(size == 32);
+    IGE_CHECK(staging[0] == 1 && staging[7] == 8);
+    IGE_CHECK(staging[8] == 0); // Row padding stays untouched
+    IGE_CHECK(staging[16] == 9 && staging[23] == 16);
+}
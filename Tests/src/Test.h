@@ -0,0 +1,33 @@
+#pragma once
+
+// Minimal test registry. Sources import std and the modules under test before including this header.
+
+namespace iGe::Test
+{
+
+using TestFunction = void (*)();
+
+struct TestCase {
+    const char* Name;
+    TestFunction Function;
+};
+
+std::vector<TestCase>& GetTests();
+void ReportFailure(const char* file, int line, const char* expression);
+
+struct Registrar {
+    Registrar(const char* name, TestFunction function) { GetTests().push_back({name, function}); }
+};
+
+} // namespace iGe::Test
+
+#define IGE_TEST(name)                                                                                                 \
+    static void name();                                                                                                \
+    static const iGe::Test::Registrar name##Registrar(#name, name);                                                    \
+    static void name()
+
+// Reports the failure and carries on, so one run shows every broken expectation
+#define IGE_CHECK(expression)                                                                                          \
+    do {                                                                                                               \
+        if (!(expression)) { iGe::Test::ReportFailure(__FILE__, __LINE__, #expression); }                              \
+    } while (false)
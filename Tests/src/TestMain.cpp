@@ -0,0 +1,50 @@
+import std;
+import iGe.Common;
+
+#include "Test.h"
+
+namespace iGe::Test
+{
+
+namespace
+{
+
+uint32 s_FailureCount = 0;
+
+} // namespace
+
+std::vector<TestCase>& GetTests() {
+    static std::vector<TestCase> tests;
+    return tests;
+}
+
+void ReportFailure(const char* file, int line, const char* expression) {
+    ++s_FailureCount;
+    std::println("    {0}:{1}: check failed: {2}", file, line, expression);
+}
+
+} // namespace iGe::Test
+
+int main(int argc, char** argv) {
+    iGe::Log::Init();
+
+    // An argument runs only the tests whose name contains it
+    const std::string_view filter = argc > 1 ? argv[1] : "";
+
+    uint32 runCount = 0;
+    uint32 failedCount = 0;
+    for (const auto& test: iGe::Test::GetTests()) {
+        if (!std::string_view(test.Name).contains(filter)) { continue; }
+
+        const uint32 failuresBefore = iGe::Test::s_FailureCount;
+        test.Function();
+        const bool passed = iGe::Test::s_FailureCount == failuresBefore;
+        std::println("[{0}] {1}", passed ? " OK " : "FAIL", test.Name);
+
+        ++runCount;
+        if (!passed) { ++failedCount; }
+    }
+
+    std::println("{0} of {1} tests passed", runCount - failedCount, runCount);
+    return failedCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+import std;
+import iGe.Common;
+import iGe.RHI;
+
+namespace
+{
+
+constexpr uint32 s_DefaultOperationCount = 2'000'000;
+constexpr uint32 s_Capacity = 1'000'000; // Slots of a large shader-visible descriptor heap
+constexpr uint32 s_Repetitions = 3;
+
+void PrintUsage() {
+    std::println("Usage: iGe_allocbench [operation count]");
+    std::println("  Churns RHIRangeAllocator with mixed range sizes and RHIIndexAllocator with single slots on");
+    std::println("  one and several threads, then prints the cost per allocate/free pair and the fragmentation.");
+}
+
+// Best of s_Repetitions, in milliseconds
+template<typename Function>
+double Measure(Function&& function) {
+    double best = std::numeric_limits<double>::max();
+    for (uint32 repetition = 0; repetition < s_Repetitions; ++repetition) {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+// Descriptor tables: mostly small, now and then a large bindless range
+uint32 NextRangeSize(std::mt19937& random) { return random() % 16 == 0 ? 64 + random() % 960 : 1 + random() % 8; }
+
+// Half the heap stays live, every step frees a random range and allocates a new one
+void ChurnRanges(uint32 operationCount, double& fragmentation) {
+    iGe::RHIRangeAllocator allocator(s_Capacity);
+    std::mt19937 random(31);
+
+    std::vector<uint32> live;
+    while (allocator.GetFreeSize() > s_Capacity / 2) {
+        const uint32 offset = allocator.Allocate(NextRangeSize(random));
+        if (offset == iGe::RHIRangeAllocator::InvalidOffset) { break; }
+        live.push_back(offset);
+    }
+
+    for (uint32 i = 0; i < operationCount; ++i) {
+        const uint64 index = random() % live.size();
+        allocator.Free(live[index]);
+        const uint32 offset = allocator.Allocate(NextRangeSize(random));
+        if (offset != iGe::RHIRangeAllocator::InvalidOffset) {
+            live[index] = offset;
+        } else {
+            live[index] = live.back();
+            live.pop_back();
+        }
+    }
+
+    // Share of the free slots that are not part of the largest free range
+    fragmentation = 1.0 - static_cast<double>(allocator.GetLargestFreeRange()) / allocator.GetFreeSize();
+}
+
+// Every thread keeps a window of slots alive and recycles its oldest one per step
+void ChurnIndices(iGe::RHIIndexAllocator& allocator, uint32 threadCount, uint32 operationCount) {
+    constexpr uint32 WindowSize = 1024;
+
+    std::vector<std::thread> threads;
+    for (uint32 t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&allocator, threadCount, operationCount] {
+            std::vector<uint32> window;
+            window.reserve(WindowSize);
+            for (uint32 i = 0; i < WindowSize; ++i) { window.push_back(allocator.Allocate()); }
+
+            for (uint32 i = 0; i < operationCount / threadCount; ++i) {
+                uint32& slot = window[i % WindowSize];
+                allocator.Free(slot);
+                slot = allocator.Allocate();
+            }
+            for (uint32 slot: window) { allocator.Free(slot); }
+        });
+    }
+    for (auto& thread: threads) { thread.join(); }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    iGe::Log::Init();
+
+    uint32 operationCount = s_DefaultOperationCount;
+    if (argc > 1) {
+        const std::string_view arg = argv[1];
+        if (std::from_chars(arg.data(), arg.data() + arg.size(), operationCount).ec != std::errc{} ||
+            operationCount == 0) {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    std::println("Churned {} allocate/free pairs over {} slots, best of {} runs", operationCount, s_Capacity,
+                 s_Repetitions);
+
+    double fragmentation = 0.0;
+    const double rangeMs = Measure([&] { ChurnRanges(operationCount, fragmentation); });
+    std::println("  RHIRangeAllocator ranges       {:8.2f} ms  {:6.2f} ns/pair  {:5.1f}% fragmented", rangeMs,
+                 rangeMs * 1e6 / operationCount, fragmentation * 100.0);
+
+    std::vector<uint32> threadCounts = {1, 4, std::max(1u, std::thread::hardware_concurrency())};
+    std::ranges::sort(threadCounts);
+    threadCounts.erase(std::unique(threadCounts.begin(), threadCounts.end()), threadCounts.end());
+    for (uint32 threadCount: threadCounts) {
+        iGe::RHIIndexAllocator allocator(s_Capacity);
+        const double indexMs = Measure([&] { ChurnIndices(allocator, threadCount, operationCount); });
+        std::println("  RHIIndexAllocator {:2} thread(s) {:8.2f} ms  {:6.2f} ns/pair", threadCount, indexMs,
+                     indexMs * 1e6 / operationCount);
+        if (allocator.GetFreeCount() != s_Capacity) {
+            std::println("iGe_allocbench: {} slots leaked", s_Capacity - allocator.GetFreeCount());
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+import std;
+import iGe.Common;
+import iGe.Renderer;
+
+namespace
+{
+
+constexpr uint32 s_DefaultDrawCount = 1'000'000;
+constexpr uint32 s_DrawsPerList = 10'000; // Keeps the allocator's memory bounded
+constexpr uint32 s_Repetitions = 5;
+
+void PrintUsage() {
+    std::println("Usage: iGe_rhibench [draw count]");
+    std::println("  Records draws through RHICommandList and through RHIBackendCommandList and prints both timings.");
+    std::println("  The two only differ in a build configured with -DIGE_RHI_STATIC_BACKEND=ON.");
+}
+
+// A stencil reference that changes every draw so the state cache cannot filter it, the draw itself is never
+// submitted and needs no pipeline
+template<typename CommandList>
+void RecordDraws(CommandList& commandList, uint32 count) {
+    for (uint32 i = 0; i < count; ++i) {
+        commandList.SetStencilReference(true, true, i & 1);
+        commandList.Draw(3, 1, 0, 0);
+    }
+}
+
+// Best of s_Repetitions, in milliseconds
+template<typename RecordFunction>
+double Measure(iGe::RHICommandPool& pool, iGe::RHICommandList& commandList, uint32 drawCount, RecordFunction&& record) {
+    double best = std::numeric_limits<double>::max();
+    for (uint32 repetition = 0; repetition < s_Repetitions; ++repetition) {
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32 recorded = 0; recorded < drawCount; recorded += s_DrawsPerList) {
+            pool.Reset();
+            commandList.Reset();
+            commandList.Begin();
+            record(commandList, std::min(s_DrawsPerList, drawCount - recorded));
+            commandList.End();
+        }
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    iGe::Log::Init();
+
+    uint32 drawCount = s_DefaultDrawCount;
+    if (argc > 1) {
+        const std::string_view arg = argv[1];
+        if (std::from_chars(arg.data(), arg.data() + arg.size(), drawCount).ec != std::errc{} || drawCount == 0) {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    iGe::RHI::Config config;
+    config.GraphicsAPI = iGe::GraphicsAPI::DirectX12;
+    config.EnableValidation = false; // The debug layer would dominate the timings
+    iGe::RHI* rhi = iGe::RHI::Init(config);
+    if (!rhi) {
+        std::println("iGe_rhibench: No RHI backend available on this platform");
+        return 1;
+    }
+
+    auto pool = rhi->CreateCommandPool({rhi->GetQueue(iGe::RHIQueueType::Graphics)});
+    auto commandList = pool ? rhi->AllocateCommandList(pool.get()) : nullptr;
+    if (!commandList) {
+        std::println("iGe_rhibench: Failed to create a command list");
+        return 1;
+    }
+
+    const double interfaceMs =
+            Measure(*pool, *commandList, drawCount,
+                    [](iGe::RHICommandList& list, uint32 count) { RecordDraws(list, count); });
+    const double backendMs =
+            Measure(*pool, *commandList, drawCount,
+                    [](iGe::RHICommandList& list, uint32 count) { RecordDraws(iGe::AsBackend(list), count); });
+
+    std::println("Recorded {} draws, best of {} runs ({} backend build)", drawCount, s_Repetitions,
+                 iGe::IsRHIBackendStatic ? "static" : "dynamic");
+    std::println("  RHICommandList         {:8.2f} ms  {:6.2f} ns/draw", interfaceMs, interfaceMs * 1e6 / drawCount);
+    std::println("  RHIBackendCommandList  {:8.2f} ms  {:6.2f} ns/draw", backendMs, backendMs * 1e6 / drawCount);
+    return 0;
+}
@@ -0,0 +1,89 @@
+import std;
+import iGe.Common;
+import iGe.Renderer;
+
+namespace
+{
+
+constexpr uint32 s_DefaultIterations = 10;
+
+void PrintUsage() {
+    std::println("Usage: iGe_rhireplay <capture> [null|dx12] [iterations]");
+    std::println("  Replays the frames of an RHI capture (--rhi-capture) and prints the CPU time of each frame.");
+    std::println("  The null backend executes nothing, it measures what the RHI itself costs.");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    iGe::Log::Init();
+
+    if (argc < 2) {
+        PrintUsage();
+        return 1;
+    }
+
+    iGe::RHI::Config config;
+    config.GraphicsAPI = iGe::GraphicsAPI::Null;
+    config.EnableValidation = false; // The debug layer would dominate the timings
+    if (argc > 2) {
+        const std::string_view backend = argv[2];
+        if (backend == "dx12") {
+            config.GraphicsAPI = iGe::GraphicsAPI::DirectX12;
+        } else if (backend != "null") {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    uint32 iterations = s_DefaultIterations;
+    if (argc > 3) {
+        const std::string_view arg = argv[3];
+        if (std::from_chars(arg.data(), arg.data() + arg.size(), iterations).ec != std::errc{} || iterations == 0) {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    iGe::RHI* rhi = iGe::RHI::Init(config);
+    if (!rhi) {
+        std::println("iGe_rhireplay: The backend is not available on this platform");
+        return 1;
+    }
+
+    iGe::RHICaptureReplayer replayer(rhi);
+    if (!replayer.Load(argv[1])) { return 1; }
+
+    const auto setupStart = std::chrono::steady_clock::now();
+    if (!replayer.Setup()) { return 1; }
+    const std::chrono::duration<double, std::milli> setupTime = std::chrono::steady_clock::now() - setupStart;
+
+    // Per captured frame, best and total over the iterations
+    const uint32 frameCount = replayer.GetFrameCount();
+    std::vector<double> bestMs(frameCount, std::numeric_limits<double>::max());
+    std::vector<double> totalMs(frameCount, 0.0);
+
+    for (uint32 iteration = 0; iteration < iterations; ++iteration) {
+        for (uint32 frame = 0; frame < frameCount; ++frame) {
+            const auto start = std::chrono::steady_clock::now();
+            if (!replayer.ReplayFrame(frame)) { return 1; }
+            const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+            bestMs[frame] = std::min(bestMs[frame], elapsed.count());
+            totalMs[frame] += elapsed.count();
+        }
+    }
+
+    const iGe::RHICaptureReplayStats& stats = replayer.GetStats();
+    std::println("Replayed {} frames {} times on {}, setup {:.2f} ms", frameCount, iterations,
+                 rhi->GetDeviceProperties().DeviceName, setupTime.count());
+    for (uint32 frame = 0; frame < frameCount; ++frame) {
+        std::println("  Frame {:4}  best {:8.3f} ms  mean {:8.3f} ms", frame, bestMs[frame],
+                     totalMs[frame] / iterations);
+    }
+    std::println("  {} lists, {} commands decoded", stats.SubmittedListCount, stats.DecodedCommandCount);
+    if (stats.UnresolvedHandleCount > 0) {
+        std::println("  {} handles referred to objects missing from the capture", stats.UnresolvedHandleCount);
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+import std;
+import iGe.Common;
+import iGe.Renderer;
+
+namespace
+{
+
+struct FormatOption {
+    std::string_view Name;
+    iGe::RHIFormat Linear;
+    iGe::RHIFormat Srgb;
+};
+
+constexpr std::array<FormatOption, 6> s_Formats = {{
+        {"bc1", iGe::RHIFormat::BC1RGBAUNorm, iGe::RHIFormat::BC1RGBASrgb},
+        {"bc3", iGe::RHIFormat::BC3UNorm, iGe::RHIFormat::BC3Srgb},
+        {"bc4", iGe::RHIFormat::BC4UNorm, iGe::RHIFormat::BC4UNorm},
+        {"bc5", iGe::RHIFormat::BC5UNorm, iGe::RHIFormat::BC5UNorm},
+        {"bc7", iGe::RHIFormat::BC7UNorm, iGe::RHIFormat::BC7Srgb},
+        {"rgba8", iGe::RHIFormat::R8G8B8A8UNorm, iGe::RHIFormat::R8G8B8A8Srgb},
+}};
+
+void PrintUsage() {
+    std::println("Usage: iGe_texcook <input> <output> [options]");
+    std::println("  <input> and <output> may both be directories to cook every image inside");
+    std::println("  --format <bc1|bc3|bc4|bc5|bc7|rgba8>  Target format (default bc7)");
+    std::println("  --srgb | --linear                     Colour space of the source (default srgb)");
+    std::println("  --no-mips                             Only write the top level");
+    std::println("  --max-mips <n>                        Limit the mip chain length");
+    std::println("  --filter <box|kaiser>                 Mip downsampling filter (default box)");
+    std::println("  --flip                                Flip the image vertically");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    iGe::Log::Init();
+
+    if (argc < 3) {
+        PrintUsage();
+        return 1;
+    }
+
+    const std::filesystem::path input = argv[1];
+    const std::filesystem::path output = argv[2];
+
+    std::string_view formatName = "bc7";
+    bool srgb = true;
+    iGe::TextureCookSettings settings;
+    for (int i = 3; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--format" && i + 1 < argc) {
+            formatName = argv[++i];
+        } else if (arg == "--srgb") {
+            srgb = true;
+        } else if (arg == "--linear") {
+            srgb = false;
+        } else if (arg == "--no-mips") {
+            settings.GenerateMips = false;
+        } else if (arg == "--max-mips" && i + 1 < argc) {
+            settings.MaxMipLevels = static_cast<uint32>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--filter" && i + 1 < argc) {
+            const std::string_view filter = argv[++i];
+            if (filter != "box" && filter != "kaiser") {
+                PrintUsage();
+                return 1;
+            }
+            settings.Filter = filter == "kaiser" ? iGe::MipFilter::Kaiser : iGe::MipFilter::Box;
+        } else if (arg == "--flip") {
+            settings.FlipVertically = true;
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    const auto format = std::ranges::find(s_Formats, formatName, &FormatOption::Name);
+    if (format == s_Formats.end()) {
+        iGe::LogError("Unknown format '{0}'", formatName);
+        return 1;
+    }
+    settings.Format = srgb ? format->Srgb : format->Linear;
+
+    iGe::TextureCooker cooker;
+    if (std::filesystem::is_directory(input)) {
+        const uint32 count = cooker.CookDirectory(input, output, settings);
+        iGe::LogInfo("Cooked {0} textures into '{1}'", count, output.string());
+        return count > 0 ? 0 : 1;
+    }
+
+    if (!cooker.Cook(input, output, settings)) { return 1; }
+    iGe::LogInfo("Cooked '{0}' -> '{1}'", input.string(), output.string());
+    return 0;
+}
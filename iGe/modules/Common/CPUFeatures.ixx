@@ -0,0 +1,98 @@
+module;
+#if defined(_M_X64) || defined(__x86_64__)
+    #define IGE_CPU_X64
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#elif defined(_M_ARM64) || defined(__aarch64__)
+    #define IGE_CPU_ARM64
+#endif
+
+export module iGe.CPUFeatures;
+import iGe.Types;
+
+namespace iGe
+{
+
+// =================================================================================================
+// CPU Features
+// =================================================================================================
+
+// Instruction set extensions usable at runtime, kernels with a wider path pick it through these flags
+export struct CPUFeatures {
+    bool SSE2 = false;
+    bool SSE41 = false;
+    bool AVX = false;
+    bool AVX2 = false;
+    bool FMA = false;
+    bool F16C = false;
+    bool NEON = false;
+};
+
+namespace
+{
+
+#if defined(IGE_CPU_X64)
+void QueryCPUID(uint32 leaf, uint32 subleaf, uint32 (&regs)[4]) {
+    #if defined(_MSC_VER)
+    int values[4];
+    __cpuidex(values, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (uint32 i = 0; i < 4; ++i) { regs[i] = static_cast<uint32>(values[i]); }
+    #else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+    #endif
+}
+
+uint64 QueryXCR0() {
+    #if defined(_MSC_VER)
+    return _xgetbv(0);
+    #else
+    uint32 eax = 0;
+    uint32 edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64>(edx) << 32) | eax;
+    #endif
+}
+#endif
+
+CPUFeatures DetectCPUFeatures() {
+    CPUFeatures features;
+
+#if defined(IGE_CPU_X64)
+    uint32 regs[4] = {};
+    QueryCPUID(0, 0, regs);
+    const uint32 maxLeaf = regs[0];
+
+    QueryCPUID(1, 0, regs);
+    features.SSE2 = (regs[3] >> 26) & 1;
+    features.SSE41 = (regs[2] >> 19) & 1;
+
+    // AVX state must also be enabled by the OS, otherwise the upper register halves are not preserved
+    const bool osxsave = (regs[2] >> 27) & 1;
+    const bool avxState = osxsave && (QueryXCR0() & 0x6) == 0x6;
+    features.AVX = avxState && ((regs[2] >> 28) & 1);
+    features.FMA = features.AVX && ((regs[2] >> 12) & 1);
+    features.F16C = features.AVX && ((regs[2] >> 29) & 1);
+
+    if (maxLeaf >= 7) {
+        QueryCPUID(7, 0, regs);
+        features.AVX2 = features.AVX && ((regs[1] >> 5) & 1);
+    }
+#elif defined(IGE_CPU_ARM64)
+    // Advanced SIMD is mandatory on AArch64
+    features.NEON = true;
+#endif
+
+    return features;
+}
+
+} // namespace
+
+export const CPUFeatures& GetCPUFeatures() {
+    static const CPUFeatures features = DetectCPUFeatures();
+    return features;
+}
+
+} // namespace iGe
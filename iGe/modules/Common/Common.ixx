@@ -10,3 +10,7 @@ export import iGe.Types;
 export import iGe.Diagnostics;
 export import iGe.Flags;
 export import iGe.CommonFunctions;
+export import iGe.CPUFeatures;
+export import iGe.MappedFile;
+export import iGe.ThreadPool;
+export import iGe.Profiler;
@@ -36,4 +36,56 @@ export string ReadFile(const std::filesystem::path& filepath) {
     return content;
 }
 
+// Round value up to the next multiple of alignment (alignment must be non-zero)
+export constexpr uint64 AlignUp(uint64 value, uint64 alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// IEEE 754 binary16 conversions, rounding to nearest
+export uint16 FloatToHalf(float32 value) {
+    const uint32 bits = std::bit_cast<uint32>(value);
+    const uint32 sign = (bits >> 16) & 0x8000u;
+    const int32 exponent = static_cast<int32>((bits >> 23) & 0xFFu) - 127 + 15;
+    uint32 mantissa = bits & 0x7FFFFFu;
+
+    // Inf, NaN and overflow
+    if (exponent >= 31) {
+        if (((bits >> 23) & 0xFFu) == 0xFFu && mantissa != 0) { return static_cast<uint16>(sign | 0x7E00u); }
+        return static_cast<uint16>(sign | 0x7C00u);
+    }
+
+    // Subnormal or zero
+    if (exponent <= 0) {
+        if (exponent < -10) { return static_cast<uint16>(sign); }
+        mantissa |= 0x800000u;
+        const uint32 shift = static_cast<uint32>(14 - exponent);
+        uint32 half = mantissa >> shift;
+        if ((mantissa >> (shift - 1)) & 1u) { ++half; }
+        return static_cast<uint16>(sign | half);
+    }
+
+    // Rounding may carry into the exponent, which is the correctly rounded result
+    uint32 half = sign | (static_cast<uint32>(exponent) << 10) | (mantissa >> 13);
+    if (mantissa & 0x1000u) { ++half; }
+    return static_cast<uint16>(half);
+}
+
+export float32 HalfToFloat(uint16 value) {
+    const uint32 sign = static_cast<uint32>(value & 0x8000u) << 16;
+    const uint32 exponent = (value >> 10) & 0x1Fu;
+    uint32 mantissa = value & 0x3FFu;
+
+    if (exponent == 31) { return std::bit_cast<float32>(sign | 0x7F800000u | (mantissa << 13)); }
+    if (exponent != 0) { return std::bit_cast<float32>(sign | ((exponent + 112) << 23) | (mantissa << 13)); }
+    if (mantissa == 0) { return std::bit_cast<float32>(sign); }
+
+    // Subnormal, renormalize into the float exponent range
+    int32 shift = 0;
+    while (!(mantissa & 0x400u)) {
+        mantissa <<= 1;
+        ++shift;
+    }
+    return std::bit_cast<float32>(sign | (static_cast<uint32>(113 - shift) << 23) | ((mantissa & 0x3FFu) << 13));
+}
+
 } // namespace iGe
@@ -0,0 +1,143 @@
+module;
+#include "iGeMacro.h"
+#if defined(IGE_PLATFORM_WINDOWS)
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+export module iGe.MappedFile;
+import iGe.Types;
+import iGe.Diagnostics;
+
+namespace iGe
+{
+
+// =================================================================================================
+// MappedFile
+// =================================================================================================
+
+// Read-only view of a whole file mapped into the address space, pages are faulted in on first touch
+export class IGE_API MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::filesystem::path& path) { Open(path); }
+    ~MappedFile() { Close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+        : m_Data(std::exchange(other.m_Data, nullptr)), m_Size(std::exchange(other.m_Size, 0)),
+          m_Open(std::exchange(other.m_Open, false)) {}
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            Close();
+            m_Data = std::exchange(other.m_Data, nullptr);
+            m_Size = std::exchange(other.m_Size, 0);
+            m_Open = std::exchange(other.m_Open, false);
+        }
+        return *this;
+    }
+
+    bool Open(const std::filesystem::path& path) {
+        Close();
+
+#if defined(IGE_PLATFORM_WINDOWS)
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            Internal::LogError("MappedFile: Could not open '{0}' (error {1})", path.string(), GetLastError());
+            return false;
+        }
+
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(file, &size)) {
+            Internal::LogError("MappedFile: Could not query the size of '{0}'", path.string());
+            CloseHandle(file);
+            return false;
+        }
+
+        // Empty files cannot be mapped, they open as an empty view
+        if (size.QuadPart > 0) {
+            HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+            // The view keeps the mapping alive, both handles can go right away
+            if (mapping) { CloseHandle(mapping); }
+            CloseHandle(file);
+
+            if (!view) {
+                Internal::LogError("MappedFile: Could not map '{0}' (error {1})", path.string(), GetLastError());
+                return false;
+            }
+            m_Data = static_cast<const std::byte*>(view);
+            m_Size = static_cast<uint64>(size.QuadPart);
+        } else {
+            CloseHandle(file);
+        }
+#else
+        const int descriptor = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (descriptor < 0) {
+            Internal::LogError("MappedFile: Could not open '{0}' (errno {1})", path.string(), errno);
+            return false;
+        }
+
+        struct stat status{};
+        if (fstat(descriptor, &status) != 0) {
+            Internal::LogError("MappedFile: Could not query the size of '{0}'", path.string());
+            close(descriptor);
+            return false;
+        }
+
+        if (status.st_size > 0) {
+            void* view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+            // The mapping holds its own reference to the file
+            close(descriptor);
+
+            if (view == MAP_FAILED) {
+                Internal::LogError("MappedFile: Could not map '{0}' (errno {1})", path.string(), errno);
+                return false;
+            }
+            madvise(view, static_cast<size_t>(status.st_size), MADV_SEQUENTIAL);
+            m_Data = static_cast<const std::byte*>(view);
+            m_Size = static_cast<uint64>(status.st_size);
+        } else {
+            close(descriptor);
+        }
+#endif
+
+        m_Open = true;
+        return true;
+    }
+
+    void Close() {
+        if (m_Data) {
+#if defined(IGE_PLATFORM_WINDOWS)
+            UnmapViewOfFile(m_Data);
+#else
+            munmap(const_cast<std::byte*>(m_Data), static_cast<size_t>(m_Size));
+#endif
+        }
+
+        m_Data = nullptr;
+        m_Size = 0;
+        m_Open = false;
+    }
+
+    bool IsOpen() const { return m_Open; }
+    uint64 GetSize() const { return m_Size; }
+    std::span<const std::byte> GetData() const { return {m_Data, static_cast<size_t>(m_Size)}; }
+
+private:
+    const std::byte* m_Data = nullptr;
+    uint64 m_Size = 0;
+    bool m_Open = false;
+};
+
+} // namespace iGe
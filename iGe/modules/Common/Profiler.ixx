@@ -0,0 +1,104 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.Profiler;
+import iGe.Types;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Profiler
+// =================================================================================================
+
+// A timed span on one track of the timeline. Times are steady clock nanoseconds, GPU zones are mapped onto the
+// same clock before they are added.
+export struct ProfileZone {
+    std::string Name;
+    uint32 Track = 0;
+    uint32 Depth = 0; // Nesting level within the track
+    uint64 BeginNs = 0;
+    uint64 EndNs = 0;
+};
+
+// Timeline of the most recent CPU and GPU zones. Every CPU thread records onto a track of its own, GPU timers
+// register a track per queue they time. Adding a zone takes a lock, zones are meant for passes and systems.
+export class IGE_API Profiler {
+public:
+    static constexpr uint32 MaxZoneCount = 64 * 1024; // The oldest zones are dropped beyond this
+
+    static uint64 Now() {
+        const auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+    }
+
+    static uint32 RegisterTrack(std::string name) {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        s_Tracks.push_back(std::move(name));
+        return static_cast<uint32>(s_Tracks.size() - 1);
+    }
+
+    static std::string GetTrackName(uint32 track) {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        return track < s_Tracks.size() ? s_Tracks[track] : std::string();
+    }
+
+    // The calling thread's track, registered on its first zone
+    static uint32 GetThreadTrack() {
+        thread_local const uint32 track = RegisterTrack("CPU Thread " + std::to_string(s_ThreadCount++));
+        return track;
+    }
+
+    static void AddZone(ProfileZone zone) {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        if (s_Zones.size() >= MaxZoneCount) { s_Zones.pop_front(); }
+        s_Zones.push_back(std::move(zone));
+    }
+
+    static void AddZones(std::span<ProfileZone> zones) {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        for (ProfileZone& zone: zones) {
+            if (s_Zones.size() >= MaxZoneCount) { s_Zones.pop_front(); }
+            s_Zones.push_back(std::move(zone));
+        }
+    }
+
+    // Zones overlapping [beginNs, endNs), in the order they were added. GPU zones arrive a few frames late.
+    static std::vector<ProfileZone> GetZones(uint64 beginNs, uint64 endNs) {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        std::vector<ProfileZone> zones;
+        for (const ProfileZone& zone: s_Zones) {
+            if (zone.BeginNs < endNs && zone.EndNs >= beginNs) { zones.push_back(zone); }
+        }
+        return zones;
+    }
+
+private:
+    inline static std::mutex s_Mutex;
+    inline static std::vector<std::string> s_Tracks;
+    inline static std::deque<ProfileZone> s_Zones;
+    inline static std::atomic<uint32> s_ThreadCount = 0;
+};
+
+// Times the enclosing scope on the calling thread's track
+export class ProfileScope {
+public:
+    explicit ProfileScope(std::string_view name) : m_Name(name), m_Depth(s_Depth++), m_BeginNs(Profiler::Now()) {}
+    ~ProfileScope() {
+        const uint64 endNs = Profiler::Now();
+        --s_Depth;
+        Profiler::AddZone({std::string(m_Name), Profiler::GetThreadTrack(), m_Depth, m_BeginNs, endNs});
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    inline static thread_local uint32 s_Depth = 0;
+
+    std::string_view m_Name;
+    uint32 m_Depth = 0;
+    uint64 m_BeginNs = 0;
+};
+
+} // namespace iGe
@@ -0,0 +1,134 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.ThreadPool;
+import iGe.Types;
+
+namespace iGe
+{
+
+// =================================================================================================
+// ThreadPool
+// =================================================================================================
+
+export class IGE_API ThreadPool {
+public:
+    // Zero worker count picks one worker per hardware thread, leaving one for the caller
+    explicit ThreadPool(uint32 workerCount = 0) {
+        if (workerCount == 0) {
+            uint32 hardwareThreads = std::thread::hardware_concurrency();
+            workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        }
+
+        m_Workers.reserve(workerCount);
+        for (uint32 i = 0; i < workerCount; ++i) { m_Workers.emplace_back([this]() { WorkerLoop(); }); }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Stopping = true;
+        }
+        m_Condition.notify_all();
+
+        for (auto& worker: m_Workers) {
+            if (worker.joinable()) { worker.join(); }
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    uint32 GetWorkerCount() const { return static_cast<uint32>(m_Workers.size()); }
+
+    // Queue a task and get a future for its result
+    template<typename F>
+    auto Submit(F&& task) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using Result = std::invoke_result_t<std::decay_t<F>>;
+
+        auto packagedTask = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> future = packagedTask->get_future();
+        Enqueue([packagedTask]() { (*packagedTask)(); });
+        return future;
+    }
+
+    // Run func(index) for every index in [0, count). The calling thread takes part in the work and keeps
+    // draining the queue while it waits, so nested ParallelFor calls from worker threads cannot deadlock.
+    template<typename F>
+    void ParallelFor(uint32 count, F&& func) {
+        if (count == 0) { return; }
+        if (count == 1 || m_Workers.empty()) {
+            for (uint32 i = 0; i < count; ++i) { func(i); }
+            return;
+        }
+
+        std::atomic<uint32> nextIndex = 0;
+        auto body = [&]() {
+            for (uint32 i = nextIndex.fetch_add(1, std::memory_order_relaxed); i < count;
+                 i = nextIndex.fetch_add(1, std::memory_order_relaxed)) {
+                func(i);
+            }
+        };
+
+        const uint32 helperCount = std::min(GetWorkerCount(), count - 1);
+        std::atomic<uint32> pendingHelpers = helperCount;
+        for (uint32 i = 0; i < helperCount; ++i) {
+            Enqueue([&]() {
+                body();
+                pendingHelpers.fetch_sub(1, std::memory_order_acq_rel);
+            });
+        }
+
+        body();
+        while (pendingHelpers.load(std::memory_order_acquire) != 0) {
+            if (!TryRunPendingTask()) { std::this_thread::yield(); }
+        }
+    }
+
+    // Execute one queued task on the calling thread, returns false if the queue was empty
+    bool TryRunPendingTask() {
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (m_Tasks.empty()) { return false; }
+            task = std::move(m_Tasks.front());
+            m_Tasks.pop_front();
+        }
+
+        task();
+        return true;
+    }
+
+private:
+    void Enqueue(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Tasks.push_back(std::move(task));
+        }
+        m_Condition.notify_one();
+    }
+
+    void WorkerLoop() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_Condition.wait(lock, [this]() { return m_Stopping || !m_Tasks.empty(); });
+                if (m_Stopping && m_Tasks.empty()) { return; }
+
+                task = std::move(m_Tasks.front());
+                m_Tasks.pop_front();
+            }
+
+            task();
+        }
+    }
+
+    std::vector<std::thread> m_Workers;
+    std::deque<std::function<void()>> m_Tasks;
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    bool m_Stopping = false;
+};
+
+} // namespace iGe
@@ -1,3 +1,6 @@
+module;
+#include "imgui.h"
+
 module iGe.Core;
 import :Application;
 import iGe.Renderer;
@@ -5,6 +8,67 @@ import iGe.Renderer;
 namespace iGe
 {
 
+namespace
+{
+
+// --rhi-capture <frame count> [--rhi-capture-start <frame serial>] [--rhi-capture-file <path>]
+void ParseCaptureArgs(const ApplicationCommandLineArgs& args, RHI::Config& config) {
+    for (int32 i = 1; i + 1 < args.Count; ++i) {
+        const std::string_view arg = args[i];
+        const std::string_view value = args[i + 1];
+
+        if (arg == "--rhi-capture") {
+            std::from_chars(value.data(), value.data() + value.size(), config.CaptureFrameCount);
+        } else if (arg == "--rhi-capture-start") {
+            std::from_chars(value.data(), value.data() + value.size(), config.CaptureFirstFrame);
+        } else if (arg == "--rhi-capture-file") {
+            config.CapturePath = value;
+        } else {
+            continue;
+        }
+        ++i;
+    }
+}
+
+bool HasArg(const ApplicationCommandLineArgs& args, std::string_view name) {
+    for (int32 i = 1; i < args.Count; ++i) {
+        if (args[i] == name) { return true; }
+    }
+    return false;
+}
+
+// Counters of the last ended frame next to the totals since startup
+void DrawRHIStatisticsOverlay() {
+    const RHIFrameStatistics frame = RHIStatistics::GetLastFrame();
+    const RHIFrameStatistics totals = RHIStatistics::GetTotals();
+
+    ImGui::Begin("RHI Statistics", nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing);
+    ImGui::Text("Frame %llu", static_cast<unsigned long long>(frame.FrameIndex));
+    if (ImGui::BeginTable("##Counters", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit)) {
+        ImGui::TableSetupColumn("Counter");
+        ImGui::TableSetupColumn("Frame");
+        ImGui::TableSetupColumn("Total");
+        ImGui::TableHeadersRow();
+
+        for (uint32 i = 0; i < static_cast<uint32>(RHIStatistic::Count); ++i) {
+            const auto statistic = static_cast<RHIStatistic>(i);
+            const std::string_view name = GetRHIStatisticName(statistic);
+
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(name.data(), name.data() + name.size());
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(frame[statistic]));
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(totals[statistic]));
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
+} // namespace
+
 // =================================================================================================
 // Application
 // =================================================================================================
@@ -22,8 +86,10 @@ Application::Application(const ApplicationSpecification& specification) : m_Spec
     if (!RHI::Get()) {
         RHI::Config config;
         config.GraphicsAPI = GraphicsAPI::DirectX12;
+        ParseCaptureArgs(m_Specification.CommandLineArgs, config);
         RHI::Init(config);
     }
+    m_ShowRHIStatistics = HasArg(m_Specification.CommandLineArgs, "--rhi-stats");
 
     if (!RHIImGuiContext::Get()) {
         RHIImGuiContext::Config config;
@@ -33,8 +99,11 @@ Application::Application(const ApplicationSpecification& specification) : m_Spec
     }
 
     CreateSwapChain();
-    CreateCommandPool();
     CreateInFlightResouce();
+
+    RHIGpuProfilerCreateInfo profilerInfo;
+    profilerInfo.pQueue = RHI::Get()->GetQueue(RHIQueueType::Graphics);
+    m_GpuProfiler = CreateScope<RHIGpuProfiler>(RHI::Get(), profilerInfo);
 }
 
 Application::~Application() {}
@@ -46,6 +115,8 @@ void Application::Run() {
         // Sync: Wait for previous frame with same index to finish
         m_InFlightFences[m_CurrentFrame]->Wait();
         m_InFlightFences[m_CurrentFrame]->Reset();
+        RHI::Get()->BeginFrame();
+        m_GpuProfiler->BeginFrame();
 
         static auto startTime = std::chrono::high_resolution_clock::now();
         auto currentTime = std::chrono::high_resolution_clock::now();
@@ -55,38 +126,45 @@ void Application::Run() {
         m_LastTime = time;
 
         // Layer rendering
-        for (auto layer: m_LayerStack.layers()) { layer->OnUpdate(timestep); }
+        {
+            ProfileScope updateScope("Update");
+            for (auto layer: m_LayerStack.layers()) { layer->OnUpdate(timestep); }
+        }
 
         // ImGui rendering
+        auto* commandLists = RHI::Get()->GetCommandListManager(RHIQueueType::Graphics);
         auto backBufferTexture = m_SwapChain->GetBackBufferTexture(m_CurrentFrame);
         {
+            ProfileScope imguiScope("ImGui");
+
             // Transition back buffer to Present for ImGui
-            auto cmdList = RHI::Get()->AllocateCommandList(m_CommandPool.Get());
-            cmdList->Reset();
+            auto cmdList = commandLists->Acquire();
             cmdList->Begin();
-            cmdList->ResourceBarrier(backBufferTexture, RHILayout::Undefined, RHILayout::Present);
+            cmdList->TransitionTexture(backBufferTexture, RHILayout::Present);
             cmdList->End();
-            RHI::Get()->GetQueue(RHIQueueType::Graphics)->Submit(cmdList.get());
+            RHI::Get()->GetQueue(RHIQueueType::Graphics)->Submit(cmdList);
 
             // Render ImGui
             RHIImGuiContext::Get()->Begin(m_CurrentFrame);
             RHIImGuiContext::Get()->SetRenderTarget(*backBufferTexture);
             for (auto layer: m_LayerStack.layers()) { layer->OnImGuiRender(); }
+            if (m_ShowRHIStatistics) { DrawRHIStatisticsOverlay(); }
             RHIImGuiContext::Get()->End();
         }
 
-        // Submit dummy command list to signal fence and semaphore
-        // We wait for ImageAvailable, and Signal RenderFinished
-        auto& cmdList = m_CommandLists[m_CurrentFrame];
-        cmdList->Reset();
+        // Submit dummy command list to signal fence and semaphore, it is the frame's last list and resolves the
+        // GPU zones. We wait for ImageAvailable, and Signal RenderFinished
+        auto cmdList = commandLists->Acquire();
         cmdList->Begin();
+        m_GpuProfiler->EndFrame(cmdList);
         cmdList->End();
 
         // std::array<RHISemaphore*, 1> waitSems = {m_ImageAvailableSemaphores[m_CurrentFrame].get()};
         std::array<RHISemaphore*, 1> signalSems = {m_RenderFinishedSemaphores[m_CurrentFrame].get()};
         RHI::Get()
                 ->GetQueue(RHIQueueType::Graphics)
-                ->Submit(cmdList.get(), m_InFlightFences[m_CurrentFrame].get(), {}, signalSems);
+                ->Submit(cmdList, m_InFlightFences[m_CurrentFrame].get(), {}, signalSems);
+        RHI::Get()->EndFrame(RHI::Get()->GetQueue(RHIQueueType::Graphics));
 
         std::array<RHISemaphore*, 1> presentWaitSemaphores = {m_RenderFinishedSemaphores[m_CurrentFrame].get()};
         m_SwapChain->Present(presentWaitSemaphores);
@@ -114,7 +192,8 @@ void Application::OnEvent(Event& e) {
 }
 
 bool Application::OnWindowResizeEvent(WindowResizeEvent& event) {
-    RHI::Get()->WaitIdle();
+    // DXGI resizes only once no submitted frame references the back buffers, other queues keep running
+    for (auto& fence: m_InFlightFences) { fence->Wait(); }
     m_SwapChain->Resize(event.GetWidth(), event.GetHeight());
     return false;
 }
@@ -140,22 +219,15 @@ void Application::CreateSwapChain() {
     m_SwapChain = rhi->CreateSwapChain(swapChainInfo);
 }
 
-void Application::CreateCommandPool() {
-    auto rhi = RHI::Get();
-    m_CommandPool = rhi->CreateCommandPool({rhi->GetQueue(RHIQueueType::Graphics)});
-}
-
 void Application::CreateInFlightResouce() {
     auto rhi = RHI::Get();
 
     // Initialize per-frame resources
-    m_CommandLists.resize(MAX_FRAMES_IN_FLIGHT);
     m_InFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
     m_ImageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
     m_RenderFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
 
     for (uint32 i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-        m_CommandLists[i] = RHI::Get()->AllocateCommandList(m_CommandPool.Get());
         m_InFlightFences[i] = rhi->CreateGPUFence({true, 0}); // Create signaled for first frame
         m_ImageAvailableSemaphores[i] = rhi->CreateGPUSemaphore();
         m_RenderFinishedSemaphores[i] = rhi->CreateGPUSemaphore();
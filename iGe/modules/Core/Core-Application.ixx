@@ -45,6 +45,7 @@ public:
 
     static Application& Get() { return *s_Instance; }
     Window& GetWindow() const { return *m_Window; }
+    RHIGpuProfiler& GetGpuProfiler() const { return *m_GpuProfiler; }
     const ApplicationSpecification& GetSpecification() const { return m_Specification; }
 
 private:
@@ -52,7 +53,6 @@ private:
     bool OnWindowCloseEvent(WindowCloseEvent& event);
 
     void CreateSwapChain();
-    void CreateCommandPool();
     void CreateInFlightResouce();
 
     static Application* s_Instance;
@@ -64,15 +64,17 @@ private:
     static constexpr uint32 MAX_FRAMES_IN_FLIGHT = 2;
     uint32 m_CurrentFrame = 0;
 
-    Scope<RHICommandPool> m_CommandPool;
-    std::vector<Scope<RHICommandList>> m_CommandLists;
     std::vector<Scope<RHIFence>> m_InFlightFences;
     std::vector<Scope<RHISemaphore>> m_ImageAvailableSemaphores;
     std::vector<Scope<RHISemaphore>> m_RenderFinishedSemaphores;
 
+    // Times the graphics queue, layers open zones on it while recording
+    Scope<RHIGpuProfiler> m_GpuProfiler;
+
     ApplicationSpecification m_Specification;
     Scope<Window> m_Window;
     bool m_Running = true;
+    bool m_ShowRHIStatistics = false; // --rhi-stats
     LayerStack m_LayerStack;
     float32 m_LastTime = 0.0f;
 };
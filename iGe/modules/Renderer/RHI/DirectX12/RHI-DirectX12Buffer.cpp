@@ -14,31 +14,6 @@ namespace iGe
 // Static Method
 // =================================================================================================
 
-D3D12_HEAP_PROPERTIES GetHeapProperties(RHIMemoryUsage usage) {
-    D3D12_HEAP_PROPERTIES props = {};
-    props.Type = D3D12_HEAP_TYPE_DEFAULT;
-    props.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-    props.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-    props.CreationNodeMask = 1;
-    props.VisibleNodeMask = 1;
-
-    switch (usage) {
-        case RHIMemoryUsage::GpuOnly:
-            props.Type = D3D12_HEAP_TYPE_DEFAULT;
-            break;
-        case RHIMemoryUsage::CpuToGpu:
-            props.Type = D3D12_HEAP_TYPE_UPLOAD;
-            break;
-        case RHIMemoryUsage::GpuToCpu:
-            props.Type = D3D12_HEAP_TYPE_READBACK;
-            break;
-        default:
-            props.Type = D3D12_HEAP_TYPE_DEFAULT;
-            break;
-    }
-    return props;
-}
-
 D3D12_RESOURCE_STATES GetInitialState(RHIMemoryUsage usage) {
     switch (usage) {
         case RHIMemoryUsage::GpuOnly:
@@ -56,8 +31,8 @@ D3D12_RESOURCE_STATES GetInitialState(RHIMemoryUsage usage) {
 // DirectX12Buffer
 // =================================================================================================
 
-DirectX12Buffer::DirectX12Buffer(ID3D12Device* device, const RHIBufferCreateInfo& info) : RHIBuffer(info) {
-    auto props = GetHeapProperties(info.MemoryUsage);
+DirectX12Buffer::DirectX12Buffer(DirectX12MemoryAllocator* allocator, const RHIBufferCreateInfo& info)
+    : RHIBuffer(info) {
     auto state = GetInitialState(info.MemoryUsage);
 
     D3D12_RESOURCE_DESC desc = {};
@@ -78,8 +53,8 @@ DirectX12Buffer::DirectX12Buffer(ID3D12Device* device, const RHIBufferCreateInfo
         desc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
     }
 
-    HRESULT hr = device->CreateCommittedResource(&props, D3D12_HEAP_FLAG_NONE, &desc, state, nullptr,
-                                                 IID_PPV_ARGS(&m_Resource));
+    HRESULT hr = allocator->CreateResource(desc, info.MemoryUsage, state, nullptr, m_Resource, m_Memory,
+                                           info.Relocatable ? this : nullptr);
 
     if (FAILED(hr)) {
         Internal::LogError("Failed to create Buffer");
@@ -91,7 +66,7 @@ DirectX12Buffer::~DirectX12Buffer() {
     if (m_MappedData) { Unmap(); }
 }
 
-void* DirectX12Buffer::Map() {
+void* DirectX12Buffer::MapMemory() {
     if (m_MappedData) { return m_MappedData; }
 
     if (m_MemoryUsage == RHIMemoryUsage::GpuOnly) {
@@ -123,16 +98,12 @@ void DirectX12Buffer::Unmap() {
     m_MappedData = nullptr;
 }
 
-void DirectX12Buffer::Update(uint64 offset, uint64 size, const void* data) {
-    if (!data || size == 0) return;
-
-    void* mapped = Map();
-    if (mapped) {
-        memcpy(static_cast<uint8*>(mapped) + offset, data, size);
-        // Note: For upload heaps, we don't need to unmap after every update
-        // but for safety and simplicity, we unmap here
-        Unmap();
-    }
+uint64 DirectX12Buffer::UpdateMemory(uint64 offset, uint64 size, const void* data) {
+    // Upload heaps may stay mapped while the GPU reads them, the mapping is kept until destruction
+    void* mapped = MapMemory();
+    if (!mapped) { return 0; }
+    memcpy(static_cast<uint8*>(mapped) + offset, data, size);
+    return size;
 }
 
 void DirectX12Buffer::Flush(uint64 offset, uint64 size) {
@@ -143,6 +114,12 @@ void DirectX12Buffer::Invalidate(uint64 offset, uint64 size) {
     // D3D12 readback heaps don't require explicit invalidate
 }
 
+void DirectX12Buffer::Relocate(ID3D12Device* device, Microsoft::WRL::ComPtr<ID3D12Resource>& resource,
+                               DirectX12ResourceMemory& memory) {
+    m_Resource.Swap(resource);
+    std::swap(m_Memory, memory);
+}
+
 void DirectX12Buffer::CreateResource(ID3D12Device* device, D3D12_HEAP_TYPE heapType, D3D12_RESOURCE_STATES initialState,
                                      uint64 size) {
     D3D12_HEAP_PROPERTIES props = {};
@@ -170,9 +147,8 @@ void DirectX12Buffer::CreateResource(ID3D12Device* device, D3D12_HEAP_TYPE heapT
 // DirectX12VertexBuffer
 // =================================================================================================
 
-DirectX12VertexBuffer::DirectX12VertexBuffer(ID3D12Device* device, const RHIVertexBufferCreateInfo& info)
+DirectX12VertexBuffer::DirectX12VertexBuffer(DirectX12MemoryAllocator* allocator, const RHIVertexBufferCreateInfo& info)
     : RHIVertexBuffer(info) {
-    auto props = GetHeapProperties(info.MemoryUsage);
     auto state = GetInitialState(info.MemoryUsage);
 
     D3D12_RESOURCE_DESC desc = {};
@@ -188,8 +164,8 @@ DirectX12VertexBuffer::DirectX12VertexBuffer(ID3D12Device* device, const RHIVert
     desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
     desc.Flags = D3D12_RESOURCE_FLAG_NONE;
 
-    HRESULT hr = device->CreateCommittedResource(&props, D3D12_HEAP_FLAG_NONE, &desc, state, nullptr,
-                                                 IID_PPV_ARGS(&m_Resource));
+    HRESULT hr = allocator->CreateResource(desc, info.MemoryUsage, state, nullptr, m_Resource, m_Memory,
+                                           info.Relocatable ? this : nullptr);
 
     if (FAILED(hr)) {
         Internal::LogError("Failed to create Vertex Buffer");
@@ -205,7 +181,7 @@ DirectX12VertexBuffer::~DirectX12VertexBuffer() {
     if (m_MappedData) { Unmap(); }
 }
 
-void* DirectX12VertexBuffer::Map() {
+void* DirectX12VertexBuffer::MapMemory() {
     if (m_MappedData) { return m_MappedData; }
 
     if (m_MemoryUsage == RHIMemoryUsage::GpuOnly) {
@@ -230,14 +206,11 @@ void DirectX12VertexBuffer::Unmap() {
     m_MappedData = nullptr;
 }
 
-void DirectX12VertexBuffer::Update(uint64 offset, uint64 size, const void* data) {
-    if (!data || size == 0) return;
-
-    void* mapped = Map();
-    if (mapped) {
-        memcpy(static_cast<uint8*>(mapped) + offset, data, size);
-        Unmap();
-    }
+uint64 DirectX12VertexBuffer::UpdateMemory(uint64 offset, uint64 size, const void* data) {
+    void* mapped = MapMemory();
+    if (!mapped) { return 0; }
+    memcpy(static_cast<uint8*>(mapped) + offset, data, size);
+    return size;
 }
 
 void DirectX12VertexBuffer::Flush(uint64 offset, uint64 size) {
@@ -248,13 +221,19 @@ void DirectX12VertexBuffer::Invalidate(uint64 offset, uint64 size) {
     // D3D12 readback heaps don't require explicit invalidate
 }
 
+void DirectX12VertexBuffer::Relocate(ID3D12Device* device, Microsoft::WRL::ComPtr<ID3D12Resource>& resource,
+                                     DirectX12ResourceMemory& memory) {
+    m_Resource.Swap(resource);
+    std::swap(m_Memory, memory);
+    m_View.BufferLocation = m_Resource->GetGPUVirtualAddress();
+}
+
 // =================================================================================================
 // DirectX12IndexBuffer
 // =================================================================================================
 
-DirectX12IndexBuffer::DirectX12IndexBuffer(ID3D12Device* device, const RHIIndexBufferCreateInfo& info)
+DirectX12IndexBuffer::DirectX12IndexBuffer(DirectX12MemoryAllocator* allocator, const RHIIndexBufferCreateInfo& info)
     : RHIIndexBuffer(info) {
-    auto props = GetHeapProperties(info.MemoryUsage);
     auto state = GetInitialState(info.MemoryUsage);
 
     D3D12_RESOURCE_DESC desc = {};
@@ -270,8 +249,8 @@ DirectX12IndexBuffer::DirectX12IndexBuffer(ID3D12Device* device, const RHIIndexB
     desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
     desc.Flags = D3D12_RESOURCE_FLAG_NONE;
 
-    HRESULT hr = device->CreateCommittedResource(&props, D3D12_HEAP_FLAG_NONE, &desc, state, nullptr,
-                                                 IID_PPV_ARGS(&m_Resource));
+    HRESULT hr = allocator->CreateResource(desc, info.MemoryUsage, state, nullptr, m_Resource, m_Memory,
+                                           info.Relocatable ? this : nullptr);
 
     if (FAILED(hr)) {
         Internal::LogError("Failed to create Index Buffer");
@@ -287,7 +266,7 @@ DirectX12IndexBuffer::~DirectX12IndexBuffer() {
     if (m_MappedData) { Unmap(); }
 }
 
-void* DirectX12IndexBuffer::Map() {
+void* DirectX12IndexBuffer::MapMemory() {
     if (m_MappedData) { return m_MappedData; }
 
     if (m_MemoryUsage == RHIMemoryUsage::GpuOnly) {
@@ -312,14 +291,11 @@ void DirectX12IndexBuffer::Unmap() {
     m_MappedData = nullptr;
 }
 
-void DirectX12IndexBuffer::Update(uint64 offset, uint64 size, const void* data) {
-    if (!data || size == 0) return;
-
-    void* mapped = Map();
-    if (mapped) {
-        memcpy(static_cast<uint8*>(mapped) + offset, data, size);
-        Unmap();
-    }
+uint64 DirectX12IndexBuffer::UpdateMemory(uint64 offset, uint64 size, const void* data) {
+    void* mapped = MapMemory();
+    if (!mapped) { return 0; }
+    memcpy(static_cast<uint8*>(mapped) + offset, data, size);
+    return size;
 }
 
 void DirectX12IndexBuffer::Flush(uint64 offset, uint64 size) {
@@ -330,13 +306,20 @@ void DirectX12IndexBuffer::Invalidate(uint64 offset, uint64 size) {
     // D3D12 readback heaps don't require explicit invalidate
 }
 
+void DirectX12IndexBuffer::Relocate(ID3D12Device* device, Microsoft::WRL::ComPtr<ID3D12Resource>& resource,
+                                    DirectX12ResourceMemory& memory) {
+    m_Resource.Swap(resource);
+    std::swap(m_Memory, memory);
+    m_View.BufferLocation = m_Resource->GetGPUVirtualAddress();
+}
+
 // =================================================================================================
 // DirectX12UniformBuffer
 // =================================================================================================
 
-DirectX12UniformBuffer::DirectX12UniformBuffer(ID3D12Device* device, const RHIUniformBufferCreateInfo& info)
+DirectX12UniformBuffer::DirectX12UniformBuffer(DirectX12MemoryAllocator* allocator,
+                                               const RHIUniformBufferCreateInfo& info)
     : RHIUniformBuffer(info) {
-    auto props = GetHeapProperties(info.MemoryUsage);
     auto state = GetInitialState(info.MemoryUsage);
 
     // Uniform buffer size must be 256-byte aligned
@@ -355,8 +338,7 @@ DirectX12UniformBuffer::DirectX12UniformBuffer(ID3D12Device* device, const RHIUn
     desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
     desc.Flags = D3D12_RESOURCE_FLAG_NONE;
 
-    HRESULT hr = device->CreateCommittedResource(&props, D3D12_HEAP_FLAG_NONE, &desc, state, nullptr,
-                                                 IID_PPV_ARGS(&m_Resource));
+    HRESULT hr = allocator->CreateResource(desc, info.MemoryUsage, state, nullptr, m_Resource, m_Memory);
 
     if (FAILED(hr)) {
         Internal::LogError("Failed to create Uniform Buffer");
@@ -368,7 +350,7 @@ DirectX12UniformBuffer::~DirectX12UniformBuffer() {
     if (m_MappedData) { Unmap(); }
 }
 
-void* DirectX12UniformBuffer::Map() {
+void* DirectX12UniformBuffer::MapMemory() {
     if (m_MappedData) { return m_MappedData; }
 
     if (m_MemoryUsage == RHIMemoryUsage::GpuOnly) {
@@ -393,14 +375,11 @@ void DirectX12UniformBuffer::Unmap() {
     m_MappedData = nullptr;
 }
 
-void DirectX12UniformBuffer::Update(uint64 offset, uint64 size, const void* data) {
-    if (!data || size == 0) return;
-
-    void* mapped = Map();
-    if (mapped) {
-        memcpy(static_cast<uint8*>(mapped) + offset, data, size);
-        Unmap();
-    }
+uint64 DirectX12UniformBuffer::UpdateMemory(uint64 offset, uint64 size, const void* data) {
+    void* mapped = MapMemory();
+    if (!mapped) { return 0; }
+    memcpy(static_cast<uint8*>(mapped) + offset, data, size);
+    return size;
 }
 
 void DirectX12UniformBuffer::Flush(uint64 offset, uint64 size) {
@@ -415,9 +394,9 @@ void DirectX12UniformBuffer::Invalidate(uint64 offset, uint64 size) {
 // DirectX12StorageBuffer
 // =================================================================================================
 
-DirectX12StorageBuffer::DirectX12StorageBuffer(ID3D12Device* device, const RHIStorageBufferCreateInfo& info)
+DirectX12StorageBuffer::DirectX12StorageBuffer(DirectX12MemoryAllocator* allocator,
+                                               const RHIStorageBufferCreateInfo& info)
     : RHIStorageBuffer(info) {
-    auto props = GetHeapProperties(info.MemoryUsage);
     auto state = GetInitialState(info.MemoryUsage);
 
     D3D12_RESOURCE_DESC desc = {};
@@ -433,8 +412,8 @@ DirectX12StorageBuffer::DirectX12StorageBuffer(ID3D12Device* device, const RHISt
     desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
     desc.Flags = D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
 
-    HRESULT hr = device->CreateCommittedResource(&props, D3D12_HEAP_FLAG_NONE, &desc, state, nullptr,
-                                                 IID_PPV_ARGS(&m_Resource));
+    HRESULT hr = allocator->CreateResource(desc, info.MemoryUsage, state, nullptr, m_Resource, m_Memory,
+                                           info.Relocatable ? this : nullptr);
 
     if (FAILED(hr)) {
         Internal::LogError("Failed to create Storage Buffer");
@@ -446,7 +425,7 @@ DirectX12StorageBuffer::~DirectX12StorageBuffer() {
     if (m_MappedData) { Unmap(); }
 }
 
-void* DirectX12StorageBuffer::Map() {
+void* DirectX12StorageBuffer::MapMemory() {
     if (m_MappedData) { return m_MappedData; }
 
     if (m_MemoryUsage == RHIMemoryUsage::GpuOnly) {
@@ -476,14 +455,11 @@ void DirectX12StorageBuffer::Unmap() {
     m_MappedData = nullptr;
 }
 
-void DirectX12StorageBuffer::Update(uint64 offset, uint64 size, const void* data) {
-    if (!data || size == 0) return;
-
-    void* mapped = Map();
-    if (mapped) {
-        memcpy(static_cast<uint8*>(mapped) + offset, data, size);
-        Unmap();
-    }
+uint64 DirectX12StorageBuffer::UpdateMemory(uint64 offset, uint64 size, const void* data) {
+    void* mapped = MapMemory();
+    if (!mapped) { return 0; }
+    memcpy(static_cast<uint8*>(mapped) + offset, data, size);
+    return size;
 }
 
 void DirectX12StorageBuffer::Flush(uint64 offset, uint64 size) {
@@ -494,5 +470,11 @@ void DirectX12StorageBuffer::Invalidate(uint64 offset, uint64 size) {
     // D3D12 readback heaps don't require explicit invalidate
 }
 
+void DirectX12StorageBuffer::Relocate(ID3D12Device* device, Microsoft::WRL::ComPtr<ID3D12Resource>& resource,
+                                      DirectX12ResourceMemory& memory) {
+    m_Resource.Swap(resource);
+    std::swap(m_Memory, memory);
+}
+
 } // namespace iGe
 #endif
@@ -6,85 +6,109 @@ module;
 
 export module iGe.RHI:DirectX12Buffer;
 import :RHIBuffer;
+import :DirectX12MemoryAllocator;
 import iGe.Common;
 
 namespace iGe
 {
 
-export class IGE_API DirectX12Buffer : public RHIBuffer {
+export class IGE_API DirectX12Buffer : public RHIBuffer, public DirectX12Relocatable {
 public:
-    DirectX12Buffer(ID3D12Device* device, const RHIBufferCreateInfo& info);
+    DirectX12Buffer(DirectX12MemoryAllocator* allocator, const RHIBufferCreateInfo& info);
     ~DirectX12Buffer() override;
 
     void* GetNativeHandle() const override { return m_Resource.Get(); }
 
     // RHIBuffer interface
-    void* Map() override;
     void Unmap() override;
     bool IsMapped() const override { return m_MappedData != nullptr; }
-    void Update(uint64 offset, uint64 size, const void* data) override;
     void Flush(uint64 offset = 0, uint64 size = ~0ULL) override;
     void Invalidate(uint64 offset = 0, uint64 size = ~0ULL) override;
 
+    // DirectX12Relocatable interface
+    const RHIResource* GetRelocatedResource() const override { return this; }
+    ID3D12Resource* GetRelocatableResource() const override { return m_Resource.Get(); }
+    void Relocate(ID3D12Device* device, Microsoft::WRL::ComPtr<ID3D12Resource>& resource,
+                  DirectX12ResourceMemory& memory) override;
+
     // DirectX12 specific
     ID3D12Resource* GetResource() const { return m_Resource.Get(); }
     D3D12_GPU_VIRTUAL_ADDRESS GetGpuAddress() const { return m_Resource->GetGPUVirtualAddress(); }
 
 protected:
+    void* MapMemory() override;
+    uint64 UpdateMemory(uint64 offset, uint64 size, const void* data) override;
     void CreateResource(ID3D12Device* device, D3D12_HEAP_TYPE heapType, D3D12_RESOURCE_STATES initialState,
                         uint64 size);
 
+    DirectX12ResourceMemory m_Memory; // Outlives m_Resource
     Microsoft::WRL::ComPtr<ID3D12Resource> m_Resource;
     void* m_MappedData = nullptr;
 };
 
-export class IGE_API DirectX12VertexBuffer : public RHIVertexBuffer {
+export class IGE_API DirectX12VertexBuffer : public RHIVertexBuffer, public DirectX12Relocatable {
 public:
-    DirectX12VertexBuffer(ID3D12Device* device, const RHIVertexBufferCreateInfo& info);
+    DirectX12VertexBuffer(DirectX12MemoryAllocator* allocator, const RHIVertexBufferCreateInfo& info);
     ~DirectX12VertexBuffer() override;
 
     void* GetNativeHandle() const override { return m_Resource.Get(); }
 
     // RHIBuffer interface
-    void* Map() override;
     void Unmap() override;
     bool IsMapped() const override { return m_MappedData != nullptr; }
-    void Update(uint64 offset, uint64 size, const void* data) override;
     void Flush(uint64 offset = 0, uint64 size = ~0ULL) override;
     void Invalidate(uint64 offset = 0, uint64 size = ~0ULL) override;
 
+    // DirectX12Relocatable interface
+    const RHIResource* GetRelocatedResource() const override { return this; }
+    ID3D12Resource* GetRelocatableResource() const override { return m_Resource.Get(); }
+    void Relocate(ID3D12Device* device, Microsoft::WRL::ComPtr<ID3D12Resource>& resource,
+                  DirectX12ResourceMemory& memory) override;
+
     // DirectX12 specific
     ID3D12Resource* GetResource() const { return m_Resource.Get(); }
     const D3D12_VERTEX_BUFFER_VIEW& GetView() const { return m_View; }
     D3D12_GPU_VIRTUAL_ADDRESS GetGpuAddress() const { return m_Resource->GetGPUVirtualAddress(); }
 
 private:
+    void* MapMemory() override;
+    uint64 UpdateMemory(uint64 offset, uint64 size, const void* data) override;
+
+    DirectX12ResourceMemory m_Memory; // Outlives m_Resource
     Microsoft::WRL::ComPtr<ID3D12Resource> m_Resource;
     D3D12_VERTEX_BUFFER_VIEW m_View{};
     void* m_MappedData = nullptr;
 };
 
-export class IGE_API DirectX12IndexBuffer : public RHIIndexBuffer {
+export class IGE_API DirectX12IndexBuffer : public RHIIndexBuffer, public DirectX12Relocatable {
 public:
-    DirectX12IndexBuffer(ID3D12Device* device, const RHIIndexBufferCreateInfo& info);
+    DirectX12IndexBuffer(DirectX12MemoryAllocator* allocator, const RHIIndexBufferCreateInfo& info);
     ~DirectX12IndexBuffer() override;
 
     void* GetNativeHandle() const override { return m_Resource.Get(); }
 
     // RHIBuffer interface
-    void* Map() override;
     void Unmap() override;
     bool IsMapped() const override { return m_MappedData != nullptr; }
-    void Update(uint64 offset, uint64 size, const void* data) override;
     void Flush(uint64 offset = 0, uint64 size = ~0ULL) override;
     void Invalidate(uint64 offset = 0, uint64 size = ~0ULL) override;
 
+    // DirectX12Relocatable interface
+    const RHIResource* GetRelocatedResource() const override { return this; }
+    ID3D12Resource* GetRelocatableResource() const override { return m_Resource.Get(); }
+    void Relocate(ID3D12Device* device, Microsoft::WRL::ComPtr<ID3D12Resource>& resource,
+                  DirectX12ResourceMemory& memory) override;
+
     // DirectX12 specific
     ID3D12Resource* GetResource() const { return m_Resource.Get(); }
     const D3D12_INDEX_BUFFER_VIEW& GetView() const { return m_View; }
     D3D12_GPU_VIRTUAL_ADDRESS GetGpuAddress() const { return m_Resource->GetGPUVirtualAddress(); }
 
 private:
+    void* MapMemory() override;
+    uint64 UpdateMemory(uint64 offset, uint64 size, const void* data) override;
+
+    DirectX12ResourceMemory m_Memory; // Outlives m_Resource
     Microsoft::WRL::ComPtr<ID3D12Resource> m_Resource;
     D3D12_INDEX_BUFFER_VIEW m_View{};
     void* m_MappedData = nullptr;
@@ -92,16 +116,14 @@ private:
 
 export class IGE_API DirectX12UniformBuffer : public RHIUniformBuffer {
 public:
-    DirectX12UniformBuffer(ID3D12Device* device, const RHIUniformBufferCreateInfo& info);
+    DirectX12UniformBuffer(DirectX12MemoryAllocator* allocator, const RHIUniformBufferCreateInfo& info);
     ~DirectX12UniformBuffer() override;
 
     void* GetNativeHandle() const override { return m_Resource.Get(); }
 
     // RHIBuffer interface
-    void* Map() override;
     void Unmap() override;
     bool IsMapped() const override { return m_MappedData != nullptr; }
-    void Update(uint64 offset, uint64 size, const void* data) override;
     void Flush(uint64 offset = 0, uint64 size = ~0ULL) override;
     void Invalidate(uint64 offset = 0, uint64 size = ~0ULL) override;
 
@@ -110,30 +132,42 @@ public:
     D3D12_GPU_VIRTUAL_ADDRESS GetGpuAddress() const { return m_Resource->GetGPUVirtualAddress(); }
 
 private:
+    void* MapMemory() override;
+    uint64 UpdateMemory(uint64 offset, uint64 size, const void* data) override;
+
+    DirectX12ResourceMemory m_Memory; // Outlives m_Resource
     Microsoft::WRL::ComPtr<ID3D12Resource> m_Resource;
     void* m_MappedData = nullptr;
 };
 
-export class IGE_API DirectX12StorageBuffer : public RHIStorageBuffer {
+export class IGE_API DirectX12StorageBuffer : public RHIStorageBuffer, public DirectX12Relocatable {
 public:
-    DirectX12StorageBuffer(ID3D12Device* device, const RHIStorageBufferCreateInfo& info);
+    DirectX12StorageBuffer(DirectX12MemoryAllocator* allocator, const RHIStorageBufferCreateInfo& info);
     ~DirectX12StorageBuffer() override;
 
     void* GetNativeHandle() const override { return m_Resource.Get(); }
 
     // RHIBuffer interface
-    void* Map() override;
     void Unmap() override;
     bool IsMapped() const override { return m_MappedData != nullptr; }
-    void Update(uint64 offset, uint64 size, const void* data) override;
     void Flush(uint64 offset = 0, uint64 size = ~0ULL) override;
     void Invalidate(uint64 offset = 0, uint64 size = ~0ULL) override;
 
+    // DirectX12Relocatable interface
+    const RHIResource* GetRelocatedResource() const override { return this; }
+    ID3D12Resource* GetRelocatableResource() const override { return m_Resource.Get(); }
+    void Relocate(ID3D12Device* device, Microsoft::WRL::ComPtr<ID3D12Resource>& resource,
+                  DirectX12ResourceMemory& memory) override;
+
     // DirectX12 specific
     ID3D12Resource* GetResource() const { return m_Resource.Get(); }
     D3D12_GPU_VIRTUAL_ADDRESS GetGpuAddress() const { return m_Resource->GetGPUVirtualAddress(); }
 
 private:
+    void* MapMemory() override;
+    uint64 UpdateMemory(uint64 offset, uint64 size, const void* data) override;
+
+    DirectX12ResourceMemory m_Memory; // Outlives m_Resource
     Microsoft::WRL::ComPtr<ID3D12Resource> m_Resource;
     void* m_MappedData = nullptr;
 };
@@ -11,38 +11,16 @@ import :DirectX12Texture;
 import :DirectX12TextureView;
 import :DirectX12GraphicsPipeline;
 import :DirectX12ComputePipeline;
+import :DirectX12QueryPool;
 import :DirectX12Descriptor;
+import :DirectX12DescriptorHeap;
+import :DirectX12RHI;
 import :DirectX12RenderPass;
 import :DirectX12Helper;
 
 namespace iGe
 {
 
-D3D12_RESOURCE_STATES RHILayoutToD3D12State(RHILayout layout) {
-    switch (layout) {
-        case RHILayout::Undefined:
-            return D3D12_RESOURCE_STATE_COMMON;
-        case RHILayout::General:
-            return D3D12_RESOURCE_STATE_COMMON;
-        case RHILayout::ColorAttachment:
-            return D3D12_RESOURCE_STATE_RENDER_TARGET;
-        case RHILayout::DepthStencilAttachment:
-            return D3D12_RESOURCE_STATE_DEPTH_WRITE;
-        case RHILayout::DepthStencilReadOnly:
-            return D3D12_RESOURCE_STATE_DEPTH_READ;
-        case RHILayout::ShaderReadOnly:
-            return D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
-        case RHILayout::TransferSrc:
-            return D3D12_RESOURCE_STATE_COPY_SOURCE;
-        case RHILayout::TransferDst:
-            return D3D12_RESOURCE_STATE_COPY_DEST;
-        case RHILayout::Present:
-            return D3D12_RESOURCE_STATE_PRESENT;
-        default:
-            return D3D12_RESOURCE_STATE_COMMON;
-    }
-}
-
 // =================================================================================================
 // DirectX12CommandList
 // =================================================================================================
@@ -69,12 +47,25 @@ DirectX12CommandList::DirectX12CommandList(ID3D12Device* device, RHICommandPool*
 DirectX12CommandList::~DirectX12CommandList() = default;
 
 void DirectX12CommandList::Reset() {
-    m_IsRecording = false;
+    // Taking the list over is only safe once its owner ended it, the allocator may still be in use otherwise
+    const std::thread::id thisThread = std::this_thread::get_id();
+    if (m_IsRecording.load(std::memory_order_acquire) &&
+        m_OwnerThread.load(std::memory_order_relaxed) != thisThread) {
+        Internal::LogError("DirectX12CommandList: Reset of a list another thread is recording");
+        return;
+    }
+    RHICommandList::Reset();
+    m_OwnerThread.store(thisThread, std::memory_order_relaxed);
+    m_IsRecording.store(false, std::memory_order_release);
+    m_StateTracker.Reset();
     m_PendingBarriers.clear();
     m_InRenderPass = false;
     m_CurrentRTVs.clear();
     m_HasDSV = false;
+    m_StateCache.Invalidate();
     m_IsComputePipeline = false;
+    m_BoundCBVSRVUAVHeap = nullptr;
+    m_BoundSamplerHeap = nullptr;
 
     HRESULT hr = m_CommandList->Reset(m_Pool->GetNativeAllocator(), nullptr);
     if (FAILED(hr)) {
@@ -83,24 +74,59 @@ void DirectX12CommandList::Reset() {
     }
 }
 
-void DirectX12CommandList::Begin() { m_IsRecording = true; }
+void DirectX12CommandList::Begin() {
+    // The pool behind this list belongs to the thread that reset it, see RHICommandListManager
+    if (m_OwnerThread.load(std::memory_order_relaxed) != std::this_thread::get_id()) {
+        Internal::LogError("DirectX12CommandList: Recording into a list owned by another thread");
+        return;
+    }
+    m_IsRecording.store(true, std::memory_order_release);
+}
 
 void DirectX12CommandList::End() {
+    if (!CanRecord()) { return; }
     // Flush any pending barriers
     FlushResourceBarriers();
 
     HRESULT hr = m_CommandList->Close();
     if (FAILED(hr)) { Internal::LogError("Failed to close command list"); }
-    m_IsRecording = false;
+    m_IsRecording.store(false, std::memory_order_release);
+}
+
+void DirectX12CommandList::ReportRefusedCommand() const {
+    if (!m_IsRecording.load(std::memory_order_acquire)) {
+        Internal::LogError("DirectX12CommandList: Command recorded outside Begin and End, it was dropped");
+    } else {
+        Internal::LogError("DirectX12CommandList: Command recorded from a thread that does not own the list, it was "
+                           "dropped");
+    }
 }
 
 void DirectX12CommandList::BeginRenderPass(const RHIRenderPassBeginInfo& beginInfo) {
+    if (!CanRecord()) { return; }
     m_InRenderPass = true;
     m_CurrentRTVs.clear();
     m_HasDSV = false;
 
     // Get render pass info for LoadOp/StoreOp
     const auto* renderPass = static_cast<const DirectX12RenderPass*>(beginInfo.pRenderPass);
+    // A resumed pass continues the attachments another list already loaded, only the bindings are restored
+    const bool resuming = beginInfo.PassFlags.HasFlag(RHIRenderPassFlag::Resuming);
+
+    // Attachments are transitioned by the list beginning the pass, before the clears below
+    if (!resuming) {
+        for (const auto& binding: beginInfo.ColorAttachments) {
+            if (!binding.pTextureView) { continue; }
+            auto* dxTextureView = static_cast<const DirectX12TextureView*>(binding.pTextureView);
+            TrackTexture(dxTextureView->GetTexture(), RHILayout::ColorAttachment);
+        }
+        const RHIAttachmentBinding* depthBinding = beginInfo.pDepthStencilAttachment;
+        if (depthBinding && depthBinding->pTextureView) {
+            auto* dxDepthView = static_cast<const DirectX12TextureView*>(depthBinding->pTextureView);
+            TrackTexture(dxDepthView->GetTexture(), RHILayout::DepthStencilAttachment);
+        }
+    }
+    FlushResourceBarriers();
 
     // Get render target views from color attachments
     for (size_t i = 0; i < beginInfo.ColorAttachments.size(); ++i) {
@@ -112,7 +138,7 @@ void DirectX12CommandList::BeginRenderPass(const RHIRenderPassBeginInfo& beginIn
         m_CurrentRTVs.push_back(rtv);
 
         // Clear if specified in the render pass attachment description
-        if (i < renderPass->GetAttachmentCount() &&
+        if (!resuming && i < renderPass->GetAttachmentCount() &&
             renderPass->GetAttachment(static_cast<uint32>(i)).LoadOp == RHILoadOp::Clear) {
             m_CommandList->ClearRenderTargetView(rtv, binding.ClearValue.Color, 0, nullptr);
         }
@@ -131,7 +157,7 @@ void DirectX12CommandList::BeginRenderPass(const RHIRenderPassBeginInfo& beginIn
         D3D12_CLEAR_FLAGS clearFlags = {};
         bool shouldClear = false;
 
-        if (depthAttachmentIndex < renderPass->GetAttachmentCount()) {
+        if (!resuming && depthAttachmentIndex < renderPass->GetAttachmentCount()) {
             const auto& depthDesc = renderPass->GetAttachment(depthAttachmentIndex);
             if (depthDesc.LoadOp == RHILoadOp::Clear) {
                 clearFlags |= D3D12_CLEAR_FLAG_DEPTH;
@@ -156,104 +182,209 @@ void DirectX12CommandList::BeginRenderPass(const RHIRenderPassBeginInfo& beginIn
                                       m_HasDSV ? &m_CurrentDSV : nullptr);
 
     // Set viewport and scissor from render area
-    D3D12_VIEWPORT viewport = {};
-    viewport.TopLeftX = static_cast<float>(beginInfo.RenderAreaOffset.X);
-    viewport.TopLeftY = static_cast<float>(beginInfo.RenderAreaOffset.Y);
+    RHIViewport viewport = {};
+    viewport.X = static_cast<float>(beginInfo.RenderAreaOffset.X);
+    viewport.Y = static_cast<float>(beginInfo.RenderAreaOffset.Y);
     viewport.Width = static_cast<float>(beginInfo.RenderAreaExtent.Width);
     viewport.Height = static_cast<float>(beginInfo.RenderAreaExtent.Height);
     viewport.MinDepth = 0.0f;
     viewport.MaxDepth = 1.0f;
-    m_CommandList->RSSetViewports(1, &viewport);
+    SetViewport(viewport);
 
-    D3D12_RECT scissor = {};
-    scissor.left = beginInfo.RenderAreaOffset.X;
-    scissor.top = beginInfo.RenderAreaOffset.Y;
-    scissor.right = beginInfo.RenderAreaOffset.X + static_cast<LONG>(beginInfo.RenderAreaExtent.Width);
-    scissor.bottom = beginInfo.RenderAreaOffset.Y + static_cast<LONG>(beginInfo.RenderAreaExtent.Height);
-    m_CommandList->RSSetScissorRects(1, &scissor);
+    RHIScissor scissor = {};
+    scissor.X = beginInfo.RenderAreaOffset.X;
+    scissor.Y = beginInfo.RenderAreaOffset.Y;
+    scissor.Width = beginInfo.RenderAreaExtent.Width;
+    scissor.Height = beginInfo.RenderAreaExtent.Height;
+    SetScissor(scissor);
 }
 
 void DirectX12CommandList::EndRenderPass() {
+    if (!CanRecord()) { return; }
     m_InRenderPass = false;
     m_CurrentRTVs.clear();
     m_HasDSV = false;
 }
 
 void DirectX12CommandList::NextSubpass() {
+    if (!CanRecord()) { return; }
     // D3D12 doesn't have native subpasses
 }
 
 void DirectX12CommandList::BindGraphicsPipeline(const RHIGraphicsPipeline* pipeline) {
+    if (!CanRecord()) { return; }
+    RHICommandList::BindGraphicsPipeline(pipeline);
     auto dxPipeline = static_cast<const DirectX12GraphicsPipeline*>(pipeline);
 
-    m_CommandList->SetPipelineState(dxPipeline->GetNativePSO());
-    m_CommandList->SetGraphicsRootSignature(dxPipeline->GetRootSignature());
-    m_CommandList->IASetPrimitiveTopology(dxPipeline->GetPrimitiveTopology());
+    // Pipelines sharing a root signature keep the root arguments already bound
+    ID3D12PipelineState* pso = dxPipeline->GetNativePSO();
+    if (m_StateCache.BindPipeline(pso)) { m_CommandList->SetPipelineState(pso); }
+    if (m_StateCache.BindPipelineLayout(RHIPipelineBindPoint::Graphics, dxPipeline->GetRootSignature())) {
+        m_CommandList->SetGraphicsRootSignature(dxPipeline->GetRootSignature());
+    }
+    if (m_StateCache.SetPrimitiveTopology(static_cast<uint32>(dxPipeline->GetPrimitiveTopology()))) {
+        m_CommandList->IASetPrimitiveTopology(dxPipeline->GetPrimitiveTopology());
+    }
     m_IsComputePipeline = false;
 }
 
 void DirectX12CommandList::BindComputePipeline(const RHIComputePipeline* pipeline) {
+    if (!CanRecord()) { return; }
+    RHICommandList::BindComputePipeline(pipeline);
     auto dxPipeline = static_cast<const DirectX12ComputePipeline*>(pipeline);
 
-    m_CommandList->SetPipelineState(dxPipeline->GetNativePSO());
-    m_CommandList->SetComputeRootSignature(dxPipeline->GetRootSignature());
+    ID3D12PipelineState* pso = dxPipeline->GetNativePSO();
+    if (m_StateCache.BindPipeline(pso)) { m_CommandList->SetPipelineState(pso); }
+    if (m_StateCache.BindPipelineLayout(RHIPipelineBindPoint::Compute, dxPipeline->GetRootSignature())) {
+        m_CommandList->SetComputeRootSignature(dxPipeline->GetRootSignature());
+    }
     m_IsComputePipeline = true;
 }
 
 void DirectX12CommandList::BindDescriptorSet(const RHIPipelineLayout* layout, uint32 setIndex,
-                                             const RHIDescriptorSet* descriptorSet) {
+                                             const RHIDescriptorSet* descriptorSet,
+                                             std::span<const uint32> dynamicOffsets) {
+    if (!CanRecord()) { return; }
+    RHICommandList::BindDescriptorSet(layout, setIndex, descriptorSet, dynamicOffsets);
     auto dxLayout = static_cast<const DirectX12PipelineLayout*>(layout);
     auto dxSet = static_cast<const DirectX12DescriptorSet*>(descriptorSet);
     if (!dxSet) { return; }
 
     // Set descriptor heaps
     if (dxSet->GetPool()) {
-        ID3D12DescriptorHeap* heaps[2] = {};
-        uint32 heapCount = 0;
+        SetDescriptorHeaps(dxSet->HasCBVSRVUAV() ? dxSet->GetPool()->GetCBVSRVUAVHeap() : nullptr,
+                           dxSet->HasSamplers() ? dxSet->GetPool()->GetSamplerHeap() : nullptr);
+    }
 
-        if (dxSet->HasCBVSRVUAV()) { heaps[heapCount++] = dxSet->GetPool()->GetCBVSRVUAVHeap(); }
-        if (dxSet->HasSamplers()) { heaps[heapCount++] = dxSet->GetPool()->GetSamplerHeap(); }
+    // Bind CBV/SRV/UAV table if present
+    if (dxSet->HasCBVSRVUAV()) {
+        SetRootDescriptorTable(GetRootTableIndex(dxLayout, setIndex, 0), dxSet->GetCBVSRVUAVTableGPUHandle());
+    }
 
-        if (heapCount > 0) { m_CommandList->SetDescriptorHeaps(heapCount, heaps); }
+    // Bind Sampler table if present
+    if (dxSet->HasSamplers()) {
+        SetRootDescriptorTable(GetRootTableIndex(dxLayout, setIndex, 1), dxSet->GetSamplerTableGPUHandle());
     }
 
-    // Try to get root parameter index from layout, fallback to default indices
-    int32 cbvSrvUavRootIndex = -1;
-    int32 samplerRootIndex = -1;
+    // Dynamic buffers are root descriptors, the offset only changes a root argument
+    const auto& addresses = dxSet->GetDynamicBufferAddresses();
+    if (addresses.empty() || !dxLayout) { return; }
+    if (dynamicOffsets.size() < addresses.size()) {
+        Internal::LogError("BindDescriptorSet: Set {0} needs {1} dynamic offsets, got {2}", setIndex,
+                           addresses.size(), dynamicOffsets.size());
+        return;
+    }
 
-    if (dxLayout) {
-        cbvSrvUavRootIndex = dxLayout->GetRootParameterIndex(setIndex, 0);
-        samplerRootIndex = dxLayout->GetRootParameterIndex(setIndex, 1);
+    const auto& types = dxSet->GetLayout()->GetDynamicBufferTypes();
+    for (uint32 i = 0; i < addresses.size(); ++i) {
+        SetRootBufferView(dxLayout->GetRootParameterIndex(setIndex, 2 + i), types[i], addresses[i] + dynamicOffsets[i]);
     }
+}
 
-    // Fallback: use default root signature layout
-    if (cbvSrvUavRootIndex < 0) { cbvSrvUavRootIndex = 0; }
-    if (samplerRootIndex < 0) { samplerRootIndex = 1; }
+void DirectX12CommandList::BindTransientDescriptors(const RHIPipelineLayout* layout, uint32 setIndex,
+                                                    const RHIDescriptorSetLayout* setLayout,
+                                                    std::span<const RHIWriteDescriptorSet> writes) {
+    if (!CanRecord()) { return; }
+    RHICommandList::BindTransientDescriptors(layout, setIndex, setLayout, writes);
+    auto dxLayout = static_cast<const DirectX12PipelineLayout*>(layout);
+    auto dxSetLayout = static_cast<const DirectX12DescriptorSetLayout*>(setLayout);
+    if (!dxSetLayout) { return; }
+
+    auto* rhi = DirectX12RHI::GetInstance();
+    auto& cbvSrvUavHeap = rhi->GetTransientCBVSRVUAVHeap();
+    auto& samplerHeap = rhi->GetTransientSamplerHeap();
+
+    // Carve the tables from the frame's rings, lock-free so recording threads never contend on a pool
+    const uint32 cbvSrvUavCount = dxSetLayout->GetCBVSRVUAVCount();
+    const uint32 samplerCount = dxSetLayout->GetSamplerCount();
+    const uint32 cbvSrvUavStart = cbvSrvUavCount > 0 ? cbvSrvUavHeap.AllocateTable(cbvSrvUavCount) : 0;
+    const uint32 samplerStart = samplerCount > 0 ? samplerHeap.AllocateTable(samplerCount) : 0;
+    if (cbvSrvUavStart == RHIDescriptorRing::InvalidOffset || samplerStart == RHIDescriptorRing::InvalidOffset) {
+        return;
+    }
 
-    // Bind CBV/SRV/UAV table if present
-    if (dxSet->HasCBVSRVUAV()) {
-        D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle = dxSet->GetCBVSRVUAVTableGPUHandle();
-        if (m_IsComputePipeline) {
-            m_CommandList->SetComputeRootDescriptorTable(cbvSrvUavRootIndex, gpuHandle);
+    for (const auto& write: writes) {
+        const uint32 bindingOffset = dxSetLayout->GetBindingOffset(write.DstBinding) + write.DstArrayElement;
+        if (IsDX12RootDescriptorType(write.DescriptorType)) {
+            for (uint32 i = 0; i < write.DescriptorCount && write.pBufferInfos; ++i) {
+                SetRootBufferView(dxLayout ? dxLayout->GetRootParameterIndex(setIndex, 2 + bindingOffset + i) : -1,
+                                  write.DescriptorType, GetDX12BufferAddress(write.pBufferInfos[i]));
+            }
+        } else if (write.DescriptorType == RHIDescriptorType::Sampler) {
+            rhi->WriteDescriptors(write, samplerHeap.GetCPUHandle(samplerStart + bindingOffset),
+                                  samplerHeap.GetDescriptorSize());
         } else {
-            m_CommandList->SetGraphicsRootDescriptorTable(cbvSrvUavRootIndex, gpuHandle);
+            rhi->WriteDescriptors(write, cbvSrvUavHeap.GetCPUHandle(cbvSrvUavStart + bindingOffset),
+                                  cbvSrvUavHeap.GetDescriptorSize());
         }
     }
 
-    // Bind Sampler table if present
-    if (dxSet->HasSamplers()) {
-        D3D12_GPU_DESCRIPTOR_HANDLE samplerHandle = dxSet->GetSamplerTableGPUHandle();
-        if (m_IsComputePipeline) {
-            m_CommandList->SetComputeRootDescriptorTable(samplerRootIndex, samplerHandle);
-        } else {
-            m_CommandList->SetGraphicsRootDescriptorTable(samplerRootIndex, samplerHandle);
-        }
+    SetDescriptorHeaps(cbvSrvUavCount > 0 ? cbvSrvUavHeap.GetHeap() : nullptr,
+                       samplerCount > 0 ? samplerHeap.GetHeap() : nullptr);
+
+    if (cbvSrvUavCount > 0) {
+        SetRootDescriptorTable(GetRootTableIndex(dxLayout, setIndex, 0), cbvSrvUavHeap.GetGPUHandle(cbvSrvUavStart));
+    }
+    if (samplerCount > 0) {
+        SetRootDescriptorTable(GetRootTableIndex(dxLayout, setIndex, 1), samplerHeap.GetGPUHandle(samplerStart));
+    }
+}
+
+int32 DirectX12CommandList::GetRootTableIndex(const DirectX12PipelineLayout* layout, uint32 setIndex,
+                                              uint32 tableIndex) const {
+    // Try to get root parameter index from layout, fallback to default root signature layout
+    const int32 rootIndex = layout ? layout->GetRootParameterIndex(setIndex, tableIndex) : -1;
+    return rootIndex >= 0 ? rootIndex : static_cast<int32>(tableIndex);
+}
+
+void DirectX12CommandList::SetDescriptorHeaps(ID3D12DescriptorHeap* cbvSrvUavHeap, ID3D12DescriptorHeap* samplerHeap) {
+    // Keep whatever is bound for a heap type the caller does not use, rebinding heaps can stall some GPUs
+    if (!cbvSrvUavHeap) { cbvSrvUavHeap = m_BoundCBVSRVUAVHeap; }
+    if (!samplerHeap) { samplerHeap = m_BoundSamplerHeap; }
+    if (!m_StateCache.BindDescriptorHeaps(cbvSrvUavHeap, samplerHeap)) { return; }
+
+    ID3D12DescriptorHeap* heaps[2] = {};
+    uint32 heapCount = 0;
+
+    if (cbvSrvUavHeap) { heaps[heapCount++] = cbvSrvUavHeap; }
+    if (samplerHeap) { heaps[heapCount++] = samplerHeap; }
+
+    if (heapCount > 0) { m_CommandList->SetDescriptorHeaps(heapCount, heaps); }
+    m_BoundCBVSRVUAVHeap = cbvSrvUavHeap;
+    m_BoundSamplerHeap = samplerHeap;
+}
+
+void DirectX12CommandList::SetRootDescriptorTable(int32 rootIndex, D3D12_GPU_DESCRIPTOR_HANDLE handle) {
+    if (!m_StateCache.BindRootArgument(GetBindPoint(), static_cast<uint32>(rootIndex), handle.ptr)) { return; }
+
+    if (m_IsComputePipeline) {
+        m_CommandList->SetComputeRootDescriptorTable(rootIndex, handle);
+    } else {
+        m_CommandList->SetGraphicsRootDescriptorTable(rootIndex, handle);
+    }
+}
+
+void DirectX12CommandList::SetRootBufferView(int32 rootIndex, RHIDescriptorType type,
+                                             D3D12_GPU_VIRTUAL_ADDRESS address) {
+    if (rootIndex < 0 || address == 0) { return; }
+    if (!m_StateCache.BindRootArgument(GetBindPoint(), static_cast<uint32>(rootIndex), address)) { return; }
+
+    const bool isUniform = type == RHIDescriptorType::UniformBufferDynamic;
+    if (m_IsComputePipeline) {
+        isUniform ? m_CommandList->SetComputeRootConstantBufferView(rootIndex, address)
+                  : m_CommandList->SetComputeRootUnorderedAccessView(rootIndex, address);
+    } else {
+        isUniform ? m_CommandList->SetGraphicsRootConstantBufferView(rootIndex, address)
+                  : m_CommandList->SetGraphicsRootUnorderedAccessView(rootIndex, address);
     }
 }
 
 void DirectX12CommandList::BindVertexBuffer(const RHIVertexBuffer* buffer, uint32 binding, uint64 offset) {
+    if (!CanRecord()) { return; }
     auto dxBuffer = static_cast<const DirectX12VertexBuffer*>(buffer);
     ID3D12Resource* resource = static_cast<ID3D12Resource*>(dxBuffer->GetNativeHandle());
+    // Keyed by the native resource, a defragmented buffer is bound again
+    if (!m_StateCache.BindVertexBuffer(binding, resource, offset)) { return; }
 
     D3D12_VERTEX_BUFFER_VIEW view = {};
     view.BufferLocation = resource->GetGPUVirtualAddress() + offset;
@@ -264,8 +395,10 @@ void DirectX12CommandList::BindVertexBuffer(const RHIVertexBuffer* buffer, uint3
 }
 
 void DirectX12CommandList::BindIndexBuffer(const RHIIndexBuffer* buffer, uint64 offset) {
+    if (!CanRecord()) { return; }
     auto dxBuffer = static_cast<const DirectX12IndexBuffer*>(buffer);
     ID3D12Resource* resource = static_cast<ID3D12Resource*>(dxBuffer->GetNativeHandle());
+    if (!m_StateCache.BindIndexBuffer(resource, offset)) { return; }
 
     D3D12_INDEX_BUFFER_VIEW view = {};
     view.BufferLocation = resource->GetGPUVirtualAddress() + offset;
@@ -277,6 +410,7 @@ void DirectX12CommandList::BindIndexBuffer(const RHIIndexBuffer* buffer, uint64
 
 void DirectX12CommandList::PushConstants(const RHIPipelineLayout* layout, Flags<RHIShaderStage> stageFlags,
                                          uint32 offset, uint32 size, const void* data) {
+    if (!CanRecord()) { return; }
     auto dxLayout = static_cast<const DirectX12PipelineLayout*>(layout);
 
     int32 rootParamIndex = dxLayout->GetPushConstantRootIndex();
@@ -294,6 +428,9 @@ void DirectX12CommandList::PushConstants(const RHIPipelineLayout* layout, Flags<
 }
 
 void DirectX12CommandList::SetViewport(const RHIViewport& viewport) {
+    if (!CanRecord()) { return; }
+    if (!m_StateCache.SetViewport(viewport)) { return; }
+
     D3D12_VIEWPORT vp = {};
     vp.TopLeftX = viewport.X;
     vp.TopLeftY = viewport.Y;
@@ -305,6 +442,9 @@ void DirectX12CommandList::SetViewport(const RHIViewport& viewport) {
 }
 
 void DirectX12CommandList::SetScissor(const RHIScissor& scissor) {
+    if (!CanRecord()) { return; }
+    if (!m_StateCache.SetScissor(scissor)) { return; }
+
     D3D12_RECT rect = {};
     rect.left = scissor.X;
     rect.top = scissor.Y;
@@ -314,102 +454,201 @@ void DirectX12CommandList::SetScissor(const RHIScissor& scissor) {
 }
 
 void DirectX12CommandList::SetLineWidth(float lineWidth) {
+    if (!CanRecord()) { return; }
     // D3D12 doesn't support dynamic line width
 }
 
 void DirectX12CommandList::SetDepthBias(float constantFactor, float clamp, float slopeFactor) {
+    if (!CanRecord()) { return; }
     // D3D12 depth bias is set in the pipeline state
 }
 
 void DirectX12CommandList::SetBlendConstants(const float blendConstants[4]) {
-    m_CommandList->OMSetBlendFactor(blendConstants);
+    if (!CanRecord()) { return; }
+    if (m_StateCache.SetBlendConstants(blendConstants)) { m_CommandList->OMSetBlendFactor(blendConstants); }
 }
 
 void DirectX12CommandList::SetDepthBounds(float minDepthBounds, float maxDepthBounds) {
+    if (!CanRecord()) { return; }
     Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList1> cmdList1;
     if (SUCCEEDED(m_CommandList.As(&cmdList1))) { cmdList1->OMSetDepthBounds(minDepthBounds, maxDepthBounds); }
 }
 
 void DirectX12CommandList::SetStencilCompareMask(bool front, bool back, uint32 compareMask) {
+    if (!CanRecord()) { return; }
     // D3D12 stencil masks are set in the pipeline state
 }
 
 void DirectX12CommandList::SetStencilWriteMask(bool front, bool back, uint32 writeMask) {
+    if (!CanRecord()) { return; }
     // D3D12 stencil masks are set in the pipeline state
 }
 
 void DirectX12CommandList::SetStencilReference(bool front, bool back, uint32 reference) {
-    m_CommandList->OMSetStencilRef(reference);
+    if (!CanRecord()) { return; }
+    if (m_StateCache.SetStencilReference(reference)) { m_CommandList->OMSetStencilRef(reference); }
 }
 
 void DirectX12CommandList::Draw(uint32 vertexCount, uint32 instanceCount, uint32 firstVertex, uint32 firstInstance) {
+    if (!CanRecord()) { return; }
+    RHICommandList::Draw(vertexCount, instanceCount, firstVertex, firstInstance);
+    FlushResourceBarriers();
     m_CommandList->DrawInstanced(vertexCount, instanceCount, firstVertex, firstInstance);
 }
 
 void DirectX12CommandList::DrawIndexed(uint32 indexCount, uint32 instanceCount, uint32 firstIndex, int32 vertexOffset,
                                        uint32 firstInstance) {
+    if (!CanRecord()) { return; }
+    RHICommandList::DrawIndexed(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+    FlushResourceBarriers();
     m_CommandList->DrawIndexedInstanced(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 }
 
 void DirectX12CommandList::Dispatch(uint32 groupCountX, uint32 groupCountY, uint32 groupCountZ) {
+    if (!CanRecord()) { return; }
+    RHICommandList::Dispatch(groupCountX, groupCountY, groupCountZ);
+    FlushResourceBarriers();
     m_CommandList->Dispatch(groupCountX, groupCountY, groupCountZ);
 }
 
-void DirectX12CommandList::ResourceBarrier(const RHITexture* texture, RHILayout oldLayout, RHILayout newLayout) {
-    if (oldLayout == newLayout) { return; }
+void DirectX12CommandList::TransitionTexture(const RHITexture* texture, RHILayout newLayout) {
+    if (!CanRecord()) { return; }
+    RHICommandList::TransitionTexture(texture, newLayout);
+    TrackTexture(texture, newLayout);
+}
 
-    auto resource = static_cast<ID3D12Resource*>(texture->GetNativeHandle());
-    if (!resource) { return; }
+void DirectX12CommandList::TransitionTexture(const RHITexture* texture, RHILayout newLayout, uint32 mipLevel,
+                                             uint32 arrayLayer) {
+    if (!CanRecord()) { return; }
+    RHICommandList::TransitionTexture(texture, newLayout, mipLevel, arrayLayer);
+    TrackTexture(texture, newLayout, mipLevel, arrayLayer);
+}
 
-    D3D12_RESOURCE_STATES stateBefore = RHILayoutToD3D12State(oldLayout);
-    D3D12_RESOURCE_STATES stateAfter = RHILayoutToD3D12State(newLayout);
+void DirectX12CommandList::TransitionBuffer(const RHIBuffer* buffer, RHILayout newLayout) {
+    if (!CanRecord()) { return; }
+    RHICommandList::TransitionBuffer(buffer, newLayout);
+    TrackBuffer(buffer, newLayout);
+}
 
-    // D3D12 requires before and after states to be different
-    // Note: D3D12_RESOURCE_STATE_PRESENT == D3D12_RESOURCE_STATE_COMMON (both are 0)
-    if (stateBefore == stateAfter) { return; }
+void DirectX12CommandList::TrackTexture(const RHITexture* texture, RHILayout newLayout) {
+    auto* dxTexture = static_cast<const DirectX12Texture*>(texture);
+    if (!dxTexture || !dxTexture->GetResource()) { return; }
 
-    D3D12_RESOURCE_BARRIER barrier = {};
-    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-    barrier.Transition.pResource = resource;
-    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    barrier.Transition.StateBefore = stateBefore;
-    barrier.Transition.StateAfter = stateAfter;
+    m_StateTracker.Transition(texture, dxTexture->GetTrackedState(), dxTexture->GetSubresourceCount(), newLayout);
+}
 
-    m_PendingBarriers.push_back(barrier);
-    FlushResourceBarriers();
+void DirectX12CommandList::TrackTexture(const RHITexture* texture, RHILayout newLayout, uint32 mipLevel,
+                                        uint32 arrayLayer) {
+    auto* dxTexture = static_cast<const DirectX12Texture*>(texture);
+    if (!dxTexture || !dxTexture->GetResource()) { return; }
+
+    const uint32 subresource = mipLevel + arrayLayer * texture->GetMipLevels();
+    m_StateTracker.Transition(texture, dxTexture->GetTrackedState(), dxTexture->GetSubresourceCount(), newLayout,
+                              subresource);
+}
+
+void DirectX12CommandList::TrackBuffer(const RHIBuffer* buffer, RHILayout newLayout) {
+    // Upload and readback heaps keep the state they were created in. Buffers decay to COMMON after every
+    // ExecuteCommandLists, so they carry no global state
+    if (!buffer || buffer->GetMemoryUsage() != RHIMemoryUsage::GpuOnly) { return; }
+    m_StateTracker.Transition(buffer, nullptr, 1, newLayout);
+}
+
+void DirectX12CommandList::ResourceBarrier(const RHITexture* texture, RHILayout oldLayout, RHILayout newLayout) {
+    if (!CanRecord()) { return; }
+    RHICommandList::ResourceBarrier(texture, oldLayout, newLayout);
+    TrackTexture(texture, newLayout);
 }
 
 void DirectX12CommandList::ResourceBarrier(const RHIBuffer* buffer, RHILayout oldLayout, RHILayout newLayout) {
-    auto resource = static_cast<ID3D12Resource*>(buffer->GetNativeHandle());
+    if (!CanRecord()) { return; }
+    CollectTransitions();
 
     D3D12_RESOURCE_BARRIER barrier = {};
     barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
-    barrier.UAV.pResource = resource;
-
+    barrier.UAV.pResource = buffer ? static_cast<ID3D12Resource*>(buffer->GetNativeHandle()) : nullptr;
     m_PendingBarriers.push_back(barrier);
-    FlushResourceBarriers();
 }
 
 void DirectX12CommandList::PipelineBarrier(const RHIBarrierBatch* barriers) {
-    // Process texture barriers
+    if (!CanRecord()) { return; }
+    RHICommandList::PipelineBarrier(barriers);
+    if (!barriers) { return; }
+
+    // Memory barriers only order shader writes, as a UAV barrier on every resource
+    for (const auto& memBarrier: barriers->MemoryBarriers) {
+        if (memBarrier.SrcAccessMask.HasFlag(RHIDependencyAccess::ShaderWrite)) {
+            ResourceBarrier(static_cast<const RHIBuffer*>(nullptr), RHILayout::General, RHILayout::General);
+        }
+    }
     for (const auto& texBarrier: barriers->TextureBarriers) {
-        if (texBarrier.pTexture) { ResourceBarrier(texBarrier.pTexture, texBarrier.OldLayout, texBarrier.NewLayout); }
+        if (texBarrier.pTexture) { TrackTexture(texBarrier.pTexture, texBarrier.NewLayout); }
     }
-    // Process buffer barriers
     for (const auto& bufBarrier: barriers->BufferBarriers) {
-        if (bufBarrier.pBuffer) { ResourceBarrier(bufBarrier.pBuffer, RHILayout::General, RHILayout::General); }
+        if (!bufBarrier.pBuffer) { continue; }
+
+        if (bufBarrier.SrcAccessMask.HasFlag(RHIDependencyAccess::ShaderWrite)) {
+            ResourceBarrier(bufBarrier.pBuffer, RHILayout::General, RHILayout::General);
+        }
+
+        // Copies need their explicit state, every other access is reached by implicit promotion from COMMON
+        RHILayout layout = RHILayout::Common;
+        if (bufBarrier.DstAccessMask.HasFlag(RHIDependencyAccess::TransferWrite)) {
+            layout = RHILayout::TransferDst;
+        } else if (bufBarrier.DstAccessMask.HasFlag(RHIDependencyAccess::TransferRead)) {
+            layout = RHILayout::TransferSrc;
+        }
+        TrackBuffer(bufBarrier.pBuffer, layout);
     }
 }
 
 void DirectX12CommandList::FlushResourceBarriers() {
+    if (!CanRecord()) { return; }
+    CollectTransitions();
     if (!m_PendingBarriers.empty()) {
         m_CommandList->ResourceBarrier(static_cast<UINT>(m_PendingBarriers.size()), m_PendingBarriers.data());
         m_PendingBarriers.clear();
     }
 }
 
+void DirectX12CommandList::RecordTransitions(std::span<const RHIResourceTransition> transitions) {
+    if (!CanRecord()) { return; }
+    AppendTransitions(transitions);
+    FlushResourceBarriers();
+}
+
+void DirectX12CommandList::CollectTransitions() {
+    if (!m_StateTracker.HasPendingTransitions()) { return; }
+
+    m_Transitions.clear();
+    m_StateTracker.FlushTransitions(m_Transitions);
+    AppendTransitions(m_Transitions);
+}
+
+void DirectX12CommandList::AppendTransitions(std::span<const RHIResourceTransition> transitions) {
+    for (const RHIResourceTransition& transition: transitions) {
+        // Distinct layouts may share a state, PRESENT and COMMON are both 0
+        const D3D12_RESOURCE_STATES stateBefore = GetDX12State(transition.Before);
+        const D3D12_RESOURCE_STATES stateAfter = GetDX12State(transition.After);
+        if (stateBefore == stateAfter) { continue; }
+
+        D3D12_RESOURCE_BARRIER barrier = {};
+        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+        barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+        barrier.Transition.pResource = static_cast<ID3D12Resource*>(transition.pResource->GetNativeHandle());
+        barrier.Transition.Subresource = transition.Subresource == RHIResourceState::AllSubresources
+                                                 ? D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES
+                                                 : transition.Subresource;
+        barrier.Transition.StateBefore = stateBefore;
+        barrier.Transition.StateAfter = stateAfter;
+        m_PendingBarriers.push_back(barrier);
+    }
+}
+
 void DirectX12CommandList::CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture) {
+    if (!CanRecord()) { return; }
+    FlushResourceBarriers();
+
     auto srcResource = static_cast<ID3D12Resource*>(srcBuffer->GetNativeHandle());
     auto dstResource = static_cast<ID3D12Resource*>(dstTexture->GetNativeHandle());
 
@@ -429,7 +668,57 @@ void DirectX12CommandList::CopyBufferToTexture(const RHIBuffer* srcBuffer, const
     m_CommandList->CopyTextureRegion(&dstLocation, 0, 0, 0, &srcLocation, nullptr);
 }
 
+void DirectX12CommandList::CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture,
+                                               const RHIBufferTextureCopy& region) {
+    if (!CanRecord()) { return; }
+    CopyBufferToTexture(srcBuffer, dstTexture, std::span<const RHIBufferTextureCopy>(&region, 1));
+}
+
+void DirectX12CommandList::CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture,
+                                               std::span<const RHIBufferTextureCopy> regions) {
+    if (!CanRecord()) { return; }
+    FlushResourceBarriers();
+
+    auto srcResource = static_cast<ID3D12Resource*>(srcBuffer->GetNativeHandle());
+    auto dstResource = static_cast<ID3D12Resource*>(dstTexture->GetNativeHandle());
+    const DXGI_FORMAT dxgiFormat = dstResource->GetDesc().Format;
+    const auto& formatInfo = GetFormatInfo(dstTexture->GetFormat());
+
+    D3D12_TEXTURE_COPY_LOCATION dstLocation = {};
+    dstLocation.pResource = dstResource;
+    dstLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+
+    D3D12_TEXTURE_COPY_LOCATION srcLocation = {};
+    srcLocation.pResource = srcResource;
+    srcLocation.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+    srcLocation.PlacedFootprint.Footprint.Format = dxgiFormat;
+
+    for (const auto& region: regions) {
+        // Default to the full mip extent
+        const uint32 mip = region.MipLevel;
+        uint32 width = region.Extent.Width ? region.Extent.Width : std::max(1u, dstTexture->GetWidth() >> mip);
+        uint32 height = region.Extent.Height ? region.Extent.Height : std::max(1u, dstTexture->GetHeight() >> mip);
+        uint32 depth = region.Extent.Depth ? region.Extent.Depth : std::max(1u, dstTexture->GetDepth() >> mip);
+
+        // Footprints of block-compressed formats cover whole blocks
+        width = static_cast<uint32>(AlignUp(width, formatInfo.BlockWidth));
+        height = static_cast<uint32>(AlignUp(height, formatInfo.BlockHeight));
+
+        dstLocation.SubresourceIndex = mip + region.ArrayLayer * dstTexture->GetMipLevels();
+        srcLocation.PlacedFootprint.Offset = region.BufferOffset;
+        srcLocation.PlacedFootprint.Footprint.Width = width;
+        srcLocation.PlacedFootprint.Footprint.Height = height;
+        srcLocation.PlacedFootprint.Footprint.Depth = depth;
+        srcLocation.PlacedFootprint.Footprint.RowPitch = region.BufferRowPitch;
+
+        m_CommandList->CopyTextureRegion(&dstLocation, 0, 0, 0, &srcLocation, nullptr);
+    }
+}
+
 void DirectX12CommandList::CopyTextureToBuffer(const RHITexture* srcTexture, const RHIBuffer* dstBuffer) {
+    if (!CanRecord()) { return; }
+    FlushResourceBarriers();
+
     auto srcResource = static_cast<ID3D12Resource*>(srcTexture->GetNativeHandle());
     auto dstResource = static_cast<ID3D12Resource*>(dstBuffer->GetNativeHandle());
 
@@ -451,6 +740,9 @@ void DirectX12CommandList::CopyTextureToBuffer(const RHITexture* srcTexture, con
 
 void DirectX12CommandList::CopyBuffer(const RHIBuffer* srcBuffer, const RHIBuffer* dstBuffer, uint64 srcOffset,
                                       uint64 dstOffset, uint64 size) {
+    if (!CanRecord()) { return; }
+    FlushResourceBarriers();
+
     auto srcResource = static_cast<ID3D12Resource*>(srcBuffer->GetNativeHandle());
     auto dstResource = static_cast<ID3D12Resource*>(dstBuffer->GetNativeHandle());
 
@@ -459,10 +751,14 @@ void DirectX12CommandList::CopyBuffer(const RHIBuffer* srcBuffer, const RHIBuffe
 
 void DirectX12CommandList::BlitTexture(const RHITexture* srcTexture, const RHITexture* dstTexture,
                                        RHISamplerFilter filter) {
+    if (!CanRecord()) { return; }
     Internal::LogWarn("BlitTexture not implemented - requires compute shader");
 }
 
 void DirectX12CommandList::ClearColorAttachment(uint32 attachmentIndex, const float color[4], const RHIRect2D& rect) {
+    if (!CanRecord()) { return; }
+    FlushResourceBarriers();
+
     if (attachmentIndex < m_CurrentRTVs.size()) {
         auto offset = rect.Offset;
         auto extent = rect.Extent;
@@ -474,6 +770,9 @@ void DirectX12CommandList::ClearColorAttachment(uint32 attachmentIndex, const fl
 
 void DirectX12CommandList::ClearDepthStencilAttachment(float depth, uint32 stencil, bool clearDepth, bool clearStencil,
                                                        const RHIRect2D& rect) {
+    if (!CanRecord()) { return; }
+    FlushResourceBarriers();
+
     if (!m_HasDSV) { return; }
 
     D3D12_CLEAR_FLAGS flags = {};
@@ -488,16 +787,62 @@ void DirectX12CommandList::ClearDepthStencilAttachment(float depth, uint32 stenc
 }
 
 void DirectX12CommandList::ClearTexture(const RHITexture* texture, const float color[4]) {
+    if (!CanRecord()) { return; }
+    FlushResourceBarriers();
     auto* dxTexture = static_cast<const DirectX12Texture*>(texture);
     if (dxTexture) { m_CommandList->ClearRenderTargetView(dxTexture->GetRTV(), color, 0, nullptr); }
 }
 
 void DirectX12CommandList::ClearBuffer(const RHIBuffer* buffer, uint32 value, uint64 offset, uint64 size) {
+    if (!CanRecord()) { return; }
     // Would need UAV clear
     Internal::LogWarn("ClearBuffer not implemented - requires UAV");
 }
 
+void DirectX12CommandList::WriteTimestamp(const RHIQueryPool* pool, uint32 index) {
+    if (!CanRecord()) { return; }
+    auto* dx12Pool = static_cast<const DirectX12QueryPool*>(pool);
+    if (!dx12Pool || !dx12Pool->GetQueryHeap()) { return; }
+
+    // Timestamps have no begin, EndQuery latches the clock
+    FlushResourceBarriers();
+    m_CommandList->EndQuery(dx12Pool->GetQueryHeap(), D3D12_QUERY_TYPE_TIMESTAMP, index);
+}
+
+void DirectX12CommandList::BeginQuery(const RHIQueryPool* pool, uint32 index) {
+    if (!CanRecord()) { return; }
+    auto* dx12Pool = static_cast<const DirectX12QueryPool*>(pool);
+    if (!dx12Pool || !dx12Pool->GetQueryHeap()) { return; }
+
+    FlushResourceBarriers();
+    m_CommandList->BeginQuery(dx12Pool->GetQueryHeap(), dx12Pool->GetD3D12QueryType(), index);
+}
+
+void DirectX12CommandList::EndQuery(const RHIQueryPool* pool, uint32 index) {
+    if (!CanRecord()) { return; }
+    auto* dx12Pool = static_cast<const DirectX12QueryPool*>(pool);
+    if (!dx12Pool || !dx12Pool->GetQueryHeap()) { return; }
+
+    FlushResourceBarriers();
+    m_CommandList->EndQuery(dx12Pool->GetQueryHeap(), dx12Pool->GetD3D12QueryType(), index);
+}
+
+void DirectX12CommandList::ResolveQueries(const RHIQueryPool* pool, uint32 firstIndex, uint32 count,
+                                          const RHIBuffer* dstBuffer, uint64 dstOffset) {
+    if (!CanRecord()) { return; }
+    auto* dx12Pool = static_cast<const DirectX12QueryPool*>(pool);
+    if (!dx12Pool || !dx12Pool->GetQueryHeap() || !dstBuffer || count == 0) { return; }
+
+    FlushResourceBarriers();
+
+    // Readback buffers stay in the copy destination state the resolve writes in
+    auto dstResource = static_cast<ID3D12Resource*>(dstBuffer->GetNativeHandle());
+    m_CommandList->ResolveQueryData(dx12Pool->GetQueryHeap(), dx12Pool->GetD3D12QueryType(), firstIndex, count,
+                                    dstResource, dstOffset);
+}
+
 void DirectX12CommandList::BeginDebugLabel(const std::string& label, const float color[4]) {
+    if (!CanRecord()) { return; }
     #if defined(USE_PIX)
     if (color) {
         PIXBeginEvent(m_CommandList.Get(),
@@ -511,12 +856,14 @@ void DirectX12CommandList::BeginDebugLabel(const std::string& label, const float
 }
 
 void DirectX12CommandList::EndDebugLabel() {
+    if (!CanRecord()) { return; }
     #if defined(USE_PIX)
     PIXEndEvent(m_CommandList.Get());
     #endif
 }
 
 void DirectX12CommandList::InsertDebugLabel(const std::string& label, const float color[4]) {
+    if (!CanRecord()) { return; }
     #if defined(USE_PIX)
     if (color) {
         PIXSetMarker(m_CommandList.Get(),
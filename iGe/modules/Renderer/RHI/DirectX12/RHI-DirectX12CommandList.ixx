@@ -6,7 +6,10 @@ module;
 
 export module iGe.RHI:DirectX12CommandList;
 import :RHICommandList;
+import :RHIResourceStateTracker;
+import :RHICommandStateCache;
 import :DirectX12CommandPool;
+import :DirectX12Descriptor;
 import iGe.Common;
 
 namespace iGe
@@ -16,7 +19,8 @@ namespace iGe
 // DirectX12CommandList
 // =================================================================================================
 
-export class IGE_API DirectX12CommandList : public RHICommandList {
+// Final, so calls through RHIBackendCommandList devirtualize in static backend builds
+export class IGE_API DirectX12CommandList final : public RHICommandList {
 public:
     DirectX12CommandList(ID3D12Device* device, RHICommandPool* pool);
     ~DirectX12CommandList() override;
@@ -48,8 +52,11 @@ public:
     // Descriptor Set Binding
     // ==========================================================================
 
-    void BindDescriptorSet(const RHIPipelineLayout* layout, uint32 setIndex,
-                           const RHIDescriptorSet* descriptorSet) override;
+    void BindDescriptorSet(const RHIPipelineLayout* layout, uint32 setIndex, const RHIDescriptorSet* descriptorSet,
+                           std::span<const uint32> dynamicOffsets = {}) override;
+    void BindTransientDescriptors(const RHIPipelineLayout* layout, uint32 setIndex,
+                                  const RHIDescriptorSetLayout* setLayout,
+                                  std::span<const RHIWriteDescriptorSet> writes) override;
 
     // ==========================================================================
     // Vertex/Index Buffer Binding
@@ -97,15 +104,42 @@ public:
     // Resource Barriers/Transitions
     // ==========================================================================
 
+    void TransitionTexture(const RHITexture* texture, RHILayout newLayout) override;
+    void TransitionTexture(const RHITexture* texture, RHILayout newLayout, uint32 mipLevel, uint32 arrayLayer) override;
+    void TransitionBuffer(const RHIBuffer* buffer, RHILayout newLayout) override;
     void ResourceBarrier(const RHITexture* texture, RHILayout oldLayout, RHILayout newLayout) override;
+    // UAV barrier, orders shader writes to the buffer
     void ResourceBarrier(const RHIBuffer* buffer, RHILayout oldLayout, RHILayout newLayout);
     void PipelineBarrier(const RHIBarrierBatch* barriers) override;
 
+    // Records the batched transitions, done before every command that accesses resources
+    void FlushResourceBarriers();
+
+    // Commands are only recorded between Begin and End, on the thread that reset the list. Every recording
+    // method checks, others are refused with an error rather than racing the owner on the allocator.
+    bool CanRecord() const {
+        if (m_IsRecording.load(std::memory_order_relaxed) &&
+            m_OwnerThread.load(std::memory_order_relaxed) == std::this_thread::get_id()) [[likely]] {
+            return true;
+        }
+        ReportRefusedCommand();
+        return false;
+    }
+
+    // Called by the queue at submit, in submission order
+    void ResolveResourceStates(std::vector<RHIResourceTransition>& fixups) const { m_StateTracker.Resolve(fixups); }
+    // Records transitions resolved for another list
+    void RecordTransitions(std::span<const RHIResourceTransition> transitions);
+
     // ==========================================================================
     // Copy Commands
     // ==========================================================================
 
     void CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture) override;
+    void CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture,
+                             const RHIBufferTextureCopy& region) override;
+    void CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture,
+                             std::span<const RHIBufferTextureCopy> regions) override;
     void CopyTextureToBuffer(const RHITexture* srcTexture, const RHIBuffer* dstBuffer) override;
     void CopyBuffer(const RHIBuffer* srcBuffer, const RHIBuffer* dstBuffer, uint64 srcOffset, uint64 dstOffset,
                     uint64 size) override;
@@ -122,6 +156,16 @@ public:
     void ClearTexture(const RHITexture* texture, const float color[4]) override;
     void ClearBuffer(const RHIBuffer* buffer, uint32 value, uint64 offset = 0, uint64 size = ~0ULL) override;
 
+    // ==========================================================================
+    // Query Commands
+    // ==========================================================================
+
+    void WriteTimestamp(const RHIQueryPool* pool, uint32 index) override;
+    void BeginQuery(const RHIQueryPool* pool, uint32 index) override;
+    void EndQuery(const RHIQueryPool* pool, uint32 index) override;
+    void ResolveQueries(const RHIQueryPool* pool, uint32 firstIndex, uint32 count, const RHIBuffer* dstBuffer,
+                        uint64 dstOffset = 0) override;
+
     // ==========================================================================
     // Debug Commands
     // ==========================================================================
@@ -130,6 +174,12 @@ public:
     void EndDebugLabel() override;
     void InsertDebugLabel(const std::string& label, const float color[4] = nullptr) override;
 
+    // ==========================================================================
+    // Statistics
+    // ==========================================================================
+
+    uint64 GetFilteredCommandCount() const override { return m_StateCache.GetFilteredCount(); }
+
     // ==========================================================================
     // Native Access
     // ==========================================================================
@@ -139,18 +189,40 @@ public:
     void* GetNativeHandle() const { return m_CommandList.Get(); }
 
 private:
-    void FlushResourceBarriers();
+    void ReportRefusedCommand() const;
+    // Moves the tracker's batch behind the barriers already pending, keeps the order barriers were requested in
+    void CollectTransitions();
+    void AppendTransitions(std::span<const RHIResourceTransition> transitions);
+    // Transitions the list requests on its own behalf, not counted as requested barriers
+    void TrackTexture(const RHITexture* texture, RHILayout newLayout);
+    void TrackTexture(const RHITexture* texture, RHILayout newLayout, uint32 mipLevel, uint32 arrayLayer);
+    void TrackBuffer(const RHIBuffer* buffer, RHILayout newLayout);
+    RHIPipelineBindPoint GetBindPoint() const {
+        return m_IsComputePipeline ? RHIPipelineBindPoint::Compute : RHIPipelineBindPoint::Graphics;
+    }
+    int32 GetRootTableIndex(const DirectX12PipelineLayout* layout, uint32 setIndex, uint32 tableIndex) const;
+    // Null keeps the heap already bound for that type, unchanged heaps are not rebound
+    void SetDescriptorHeaps(ID3D12DescriptorHeap* cbvSrvUavHeap, ID3D12DescriptorHeap* samplerHeap);
+    void SetRootDescriptorTable(int32 rootIndex, D3D12_GPU_DESCRIPTOR_HANDLE handle);
+    void SetRootBufferView(int32 rootIndex, RHIDescriptorType type, D3D12_GPU_VIRTUAL_ADDRESS address);
 
     Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> m_CommandList;
     Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList4> m_CommandList4; // For ray tracing
 
     ID3D12Device* m_Device;
     DirectX12CommandPool* m_Pool = nullptr;
-    bool m_IsRecording = false;
+    // Read by any thread that touches the list, to refuse commands from threads other than the owner
+    std::atomic<bool> m_IsRecording = false;
+    std::atomic<std::thread::id> m_OwnerThread; // Thread that last reset the list
 
     // Current state
+    RHIResourceStateTracker m_StateTracker;
+    std::vector<RHIResourceTransition> m_Transitions; // Scratch for CollectTransitions
     std::vector<D3D12_RESOURCE_BARRIER> m_PendingBarriers;
-    bool m_IsComputePipeline = false; // Track current pipeline type for descriptor/push constant binding
+    RHICommandStateCache m_StateCache; // Drops binds that repeat the bound state
+    bool m_IsComputePipeline = false;  // Track current pipeline type for descriptor/push constant binding
+    ID3D12DescriptorHeap* m_BoundCBVSRVUAVHeap = nullptr;
+    ID3D12DescriptorHeap* m_BoundSamplerHeap = nullptr;
 
     // Render pass state
     bool m_InRenderPass = false;
@@ -26,7 +26,9 @@ DirectX12DescriptorSetLayout::DirectX12DescriptorSetLayout(const RHIDescriptorSe
 
     // Count descriptors by type
     for (const auto& binding: m_Bindings) {
-        if (binding.DescriptorType == RHIDescriptorType::Sampler) {
+        if (IsDX12RootDescriptorType(binding.DescriptorType)) {
+            m_DynamicBufferTypes.insert(m_DynamicBufferTypes.end(), binding.DescriptorCount, binding.DescriptorType);
+        } else if (binding.DescriptorType == RHIDescriptorType::Sampler) {
             m_SamplerCount += binding.DescriptorCount;
         } else {
             m_CBVSRVUAVCount += binding.DescriptorCount;
@@ -34,6 +36,25 @@ DirectX12DescriptorSetLayout::DirectX12DescriptorSetLayout(const RHIDescriptorSe
     }
 }
 
+uint32 DirectX12DescriptorSetLayout::GetBindingOffset(uint32 binding) const {
+    uint32 cbvSrvUavOffset = 0;
+    uint32 samplerOffset = 0;
+    uint32 dynamicBufferOffset = 0;
+
+    for (const auto& layoutBinding: m_Bindings) {
+        uint32* offset = &cbvSrvUavOffset;
+        if (IsDX12RootDescriptorType(layoutBinding.DescriptorType)) {
+            offset = &dynamicBufferOffset;
+        } else if (layoutBinding.DescriptorType == RHIDescriptorType::Sampler) {
+            offset = &samplerOffset;
+        }
+
+        if (layoutBinding.Binding == binding) { return *offset; }
+        *offset += layoutBinding.DescriptorCount;
+    }
+    return 0;
+}
+
 // =================================================================================================
 // DirectX12DescriptorPool Implementation
 // =================================================================================================
@@ -161,6 +182,7 @@ DirectX12DescriptorSet::DirectX12DescriptorSet(DirectX12DescriptorPool* pool,
 
     m_CBVSRVUAVCount = layout->GetCBVSRVUAVCount();
     m_SamplerCount = layout->GetSamplerCount();
+    m_DynamicBufferAddresses.resize(layout->GetDynamicBufferCount(), 0);
 
     // Allocate descriptor ranges from pool
     bool success =
@@ -180,6 +202,10 @@ void DirectX12DescriptorSet::Release() {
     }
 }
 
+void DirectX12DescriptorSet::SetDynamicBufferAddress(uint32 index, D3D12_GPU_VIRTUAL_ADDRESS address) {
+    if (index < m_DynamicBufferAddresses.size()) { m_DynamicBufferAddresses[index] = address; }
+}
+
 D3D12_GPU_DESCRIPTOR_HANDLE DirectX12DescriptorSet::GetCBVSRVUAVTableGPUHandle() const {
     if (m_CBVSRVUAVStartIndex == std::numeric_limits<uint32>::max() || !m_Pool) { return {}; }
     return m_Pool->GetCBVSRVUAVGPUHandle(m_CBVSRVUAVStartIndex);
@@ -190,6 +216,60 @@ D3D12_GPU_DESCRIPTOR_HANDLE DirectX12DescriptorSet::GetSamplerTableGPUHandle() c
     return m_Pool->GetSamplerGPUHandle(m_SamplerStartIndex);
 }
 
+// =================================================================================================
+// DirectX12DescriptorUpdateTemplate Implementation
+// =================================================================================================
+
+DirectX12DescriptorUpdateTemplate::DirectX12DescriptorUpdateTemplate(const RHIDescriptorUpdateTemplateCreateInfo& info)
+    : RHIDescriptorUpdateTemplate(info) {
+    auto* layout = static_cast<const DirectX12DescriptorSetLayout*>(info.pSetLayout);
+    if (!layout) {
+        Internal::LogError("DirectX12DescriptorUpdateTemplate: Set layout is null");
+        return;
+    }
+
+    m_Entries.reserve(info.Entries.size());
+    for (const auto& templateEntry: info.Entries) {
+        Entry entry;
+        entry.TableOffset = layout->GetBindingOffset(templateEntry.DstBinding) + templateEntry.DstArrayElement;
+        entry.Count = templateEntry.DescriptorCount;
+        entry.DataOffset = templateEntry.Offset;
+        entry.Stride = templateEntry.Stride != 0 ? templateEntry.Stride
+                                                 : GetDescriptorUpdateTemplateElementSize(templateEntry.DescriptorType);
+
+        switch (templateEntry.DescriptorType) {
+            case RHIDescriptorType::UniformBuffer:
+                entry.Kind = EntryKind::ConstantBufferView;
+                break;
+            case RHIDescriptorType::StorageBuffer:
+                entry.Kind = EntryKind::RawBufferView;
+                break;
+            case RHIDescriptorType::UniformBufferDynamic:
+            case RHIDescriptorType::StorageBufferDynamic:
+                entry.Kind = EntryKind::DynamicBufferAddress;
+                break;
+            case RHIDescriptorType::SampledImage:
+            case RHIDescriptorType::CombinedImageSampler:
+            case RHIDescriptorType::InputAttachment:
+                entry.Kind = EntryKind::ShaderResourceViewCopy;
+                break;
+            case RHIDescriptorType::StorageImage:
+                entry.Kind = EntryKind::UnorderedAccessViewCopy;
+                break;
+            case RHIDescriptorType::Sampler:
+                entry.Kind = EntryKind::Sampler;
+                break;
+            default:
+                Internal::LogError("DirectX12DescriptorUpdateTemplate: Unsupported descriptor type {0}",
+                                   static_cast<uint32>(templateEntry.DescriptorType));
+                continue;
+        }
+        m_Entries.push_back(entry);
+    }
+
+    std::ranges::stable_sort(m_Entries, {}, &Entry::Kind);
+}
+
 // =================================================================================================
 // DirectX12PipelineLayout
 // =================================================================================================
@@ -213,15 +293,10 @@ void DirectX12PipelineLayout::BuildRootSignature(ID3D12Device* device, const RHI
 
     std::vector<D3D12_ROOT_PARAMETER1> rootParameters;
     std::vector<std::vector<D3D12_DESCRIPTOR_RANGE1>> descriptorRangeStorage; // Keep ranges alive
+    descriptorRangeStorage.reserve(info.SetLayouts.size() * 2);
 
     uint32 rootParameterIndex = 0;
 
-    // Collect all CBV/SRV/UAV ranges across all sets into a single table
-    // Collect all Sampler ranges across all sets into another table
-    // This matches the BindDescriptorSets logic: param 0 = CBV_SRV_UAV, param 1 = Sampler
-    std::vector<D3D12_DESCRIPTOR_RANGE1> allCbvSrvUavRanges;
-    std::vector<D3D12_DESCRIPTOR_RANGE1> allSamplerRanges;
-
     // Per-register-type counters for D3D12 shader register assignment
     // D3D12 uses separate register namespaces: b (CBV), t (SRV), u (UAV), s (Sampler)
     // Vulkan uses a single binding namespace, so we need to remap
@@ -230,20 +305,79 @@ void DirectX12PipelineLayout::BuildRootSignature(ID3D12Device* device, const RHI
     uint32 uavRegisterCounter = 0;
     uint32 samplerRegisterCounter = 0;
 
-    // Process each descriptor set layout
+    auto addTable = [&](std::vector<D3D12_DESCRIPTOR_RANGE1>&& ranges, uint32 setIndex, uint32 tableIndex) {
+        if (ranges.empty()) { return; }
+
+        descriptorRangeStorage.push_back(std::move(ranges));
+        auto& storedRanges = descriptorRangeStorage.back();
+
+        D3D12_ROOT_PARAMETER1 param = {};
+        param.ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+        param.DescriptorTable.NumDescriptorRanges = static_cast<UINT>(storedRanges.size());
+        param.DescriptorTable.pDescriptorRanges = storedRanges.data();
+        param.ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+        rootParameters.push_back(param);
+
+        DirectX12RootParameterMapping mapping;
+        mapping.SetIndex = setIndex;
+        mapping.BindingIndex = tableIndex;
+        mapping.RootParameterIndex = rootParameterIndex++;
+        mapping.Type = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+        m_RootParameterMappings.push_back(mapping);
+    };
+
+    // Every set gets its own CBV/SRV/UAV table and sampler table, in set order, matching the contiguous ranges a
+    // DirectX12DescriptorSet allocates: binding index 0 maps to the CBV/SRV/UAV table, 1 to the sampler table
     for (uint32 setIndex = 0; setIndex < info.SetLayouts.size(); ++setIndex) {
         const auto* dx12SetLayout = static_cast<const DirectX12DescriptorSetLayout*>(info.SetLayouts[setIndex]);
         if (!dx12SetLayout) { continue; }
 
-        const auto& bindings = dx12SetLayout->GetBindings();
+        std::vector<D3D12_DESCRIPTOR_RANGE1> cbvSrvUavRanges;
+        std::vector<D3D12_DESCRIPTOR_RANGE1> samplerRanges;
+        uint32 cbvSrvUavOffset = 0;
+        uint32 samplerOffset = 0;
+
+        uint32 dynamicBufferIndex = 0;
+
+        for (const auto& binding: dx12SetLayout->GetBindings()) {
+            // Dynamic buffers become one root CBV/UAV per element, binding index 2 + n maps to the nth of the set
+            if (IsDX12RootDescriptorType(binding.DescriptorType)) {
+                const bool isUniform = binding.DescriptorType == RHIDescriptorType::UniformBufferDynamic;
+                for (uint32 i = 0; i < binding.DescriptorCount; ++i) {
+                    D3D12_ROOT_PARAMETER1 param = {};
+                    param.ParameterType = isUniform ? D3D12_ROOT_PARAMETER_TYPE_CBV : D3D12_ROOT_PARAMETER_TYPE_UAV;
+                    param.Descriptor.ShaderRegister = isUniform ? cbvRegisterCounter++ : uavRegisterCounter++;
+                    param.Descriptor.RegisterSpace = setIndex;
+                    param.ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+                    rootParameters.push_back(param);
+
+                    DirectX12RootParameterMapping mapping;
+                    mapping.SetIndex = setIndex;
+                    mapping.BindingIndex = 2 + dynamicBufferIndex++;
+                    mapping.RootParameterIndex = rootParameterIndex++;
+                    mapping.Type = param.ParameterType;
+                    m_RootParameterMappings.push_back(mapping);
+                }
+                continue;
+            }
 
-        for (const auto& binding: bindings) {
             D3D12_DESCRIPTOR_RANGE1 range = {};
             range.RangeType = GetDescriptorRangeType(binding.DescriptorType);
             range.NumDescriptors = binding.DescriptorCount;
             range.RegisterSpace = setIndex;
-            range.Flags = D3D12_DESCRIPTOR_RANGE_FLAG_NONE;
-            range.OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+            range.Flags = GetDescriptorRangeFlags(binding.BindingFlags, range.RangeType);
+
+            // Variable-count bindings are unbounded so shaders can declare unsized arrays, which also claims every
+            // later register of the type in this space
+            if (binding.BindingFlags.HasFlag(RHIDescriptorBindingFlagBits::VariableDescriptorCount)) {
+                range.NumDescriptors = std::numeric_limits<uint32>::max();
+            }
+
+            // Explicit offsets, ranges after an unbounded one cannot be appended
+            const bool isSampler = range.RangeType == D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER;
+            uint32& tableOffset = isSampler ? samplerOffset : cbvSrvUavOffset;
+            range.OffsetInDescriptorsFromTableStart = tableOffset;
+            tableOffset += binding.DescriptorCount;
 
             // Assign BaseShaderRegister based on register type, not Vulkan binding index
             // This allows Vulkan-style unique bindings to work with D3D12's separate namespaces
@@ -266,63 +400,16 @@ void DirectX12PipelineLayout::BuildRootSignature(ID3D12Device* device, const RHI
                     break;
             }
 
-            if (range.RangeType == D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER) {
-                allSamplerRanges.push_back(range);
+            if (isSampler) {
+                samplerRanges.push_back(range);
             } else {
                 // CBV, SRV, UAV all go to the same table
-                allCbvSrvUavRanges.push_back(range);
+                cbvSrvUavRanges.push_back(range);
             }
         }
-    }
-
-    // Create CBV/SRV/UAV descriptor table as parameter 0
-    if (!allCbvSrvUavRanges.empty()) {
-        descriptorRangeStorage.push_back(std::move(allCbvSrvUavRanges));
-        auto& storedRanges = descriptorRangeStorage.back();
-
-        D3D12_ROOT_PARAMETER1 param = {};
-        param.ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
-        param.DescriptorTable.NumDescriptorRanges = static_cast<UINT>(storedRanges.size());
-        param.DescriptorTable.pDescriptorRanges = storedRanges.data();
-        param.ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
-
-        rootParameters.push_back(param);
-
-        // Store mappings for all sets - CBV/SRV/UAV bindings map to parameter 0
-        for (uint32 setIndex = 0; setIndex < info.SetLayouts.size(); ++setIndex) {
-            DirectX12RootParameterMapping mapping;
-            mapping.SetIndex = setIndex;
-            mapping.BindingIndex = 0; // CBV_SRV_UAV table
-            mapping.RootParameterIndex = rootParameterIndex;
-            mapping.Type = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
-            m_RootParameterMappings.push_back(mapping);
-        }
-        ++rootParameterIndex;
-    }
-
-    // Create Sampler descriptor table as parameter 1
-    if (!allSamplerRanges.empty()) {
-        descriptorRangeStorage.push_back(std::move(allSamplerRanges));
-        auto& storedRanges = descriptorRangeStorage.back();
-
-        D3D12_ROOT_PARAMETER1 param = {};
-        param.ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
-        param.DescriptorTable.NumDescriptorRanges = static_cast<UINT>(storedRanges.size());
-        param.DescriptorTable.pDescriptorRanges = storedRanges.data();
-        param.ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
-
-        rootParameters.push_back(param);
 
-        // Store mappings for all sets - Sampler bindings map to parameter 1
-        for (uint32 setIndex = 0; setIndex < info.SetLayouts.size(); ++setIndex) {
-            DirectX12RootParameterMapping mapping;
-            mapping.SetIndex = setIndex;
-            mapping.BindingIndex = 1; // Sampler table
-            mapping.RootParameterIndex = rootParameterIndex;
-            mapping.Type = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
-            m_RootParameterMappings.push_back(mapping);
-        }
-        ++rootParameterIndex;
+        addTable(std::move(cbvSrvUavRanges), setIndex, 0);
+        addTable(std::move(samplerRanges), setIndex, 1);
     }
 
     // Add push constants as root constants
@@ -427,6 +514,26 @@ D3D12_DESCRIPTOR_RANGE_TYPE DirectX12PipelineLayout::GetDescriptorRangeType(RHID
     }
 }
 
+D3D12_DESCRIPTOR_RANGE_FLAGS
+DirectX12PipelineLayout::GetDescriptorRangeFlags(Flags<RHIDescriptorBindingFlagBits> bindingFlags,
+                                                 D3D12_DESCRIPTOR_RANGE_TYPE rangeType) const {
+    // Root signature 1.1 defaults to static descriptors, anything that may be unset or rewritten while the
+    // table is bound has to opt out of that
+    D3D12_DESCRIPTOR_RANGE_FLAGS flags = D3D12_DESCRIPTOR_RANGE_FLAG_NONE;
+    if (bindingFlags.HasFlag(RHIDescriptorBindingFlagBits::PartiallyBound) ||
+        bindingFlags.HasFlag(RHIDescriptorBindingFlagBits::UpdateAfterBind) ||
+        bindingFlags.HasFlag(RHIDescriptorBindingFlagBits::UpdateUnusedWhilePending)) {
+        flags |= D3D12_DESCRIPTOR_RANGE_FLAG_DESCRIPTORS_VOLATILE;
+    }
+
+    // Sampler ranges have no data to version
+    if (bindingFlags.HasFlag(RHIDescriptorBindingFlagBits::UpdateAfterBind) &&
+        rangeType != D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER) {
+        flags |= D3D12_DESCRIPTOR_RANGE_FLAG_DATA_VOLATILE;
+    }
+    return flags;
+}
+
 D3D12_SHADER_VISIBILITY DirectX12PipelineLayout::GetShaderVisibility(Flags<RHIShaderStage> stages) const {
     // If multiple stages, use ALL
     uint32 stageCount = 0;
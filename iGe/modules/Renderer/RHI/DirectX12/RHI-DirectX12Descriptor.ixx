@@ -30,11 +30,20 @@ public:
     // Get the total number of sampler descriptors
     uint32 GetSamplerCount() const { return m_SamplerCount; }
 
+    // Dynamic buffer elements in binding order, each one is a root descriptor rather than a table entry
+    uint32 GetDynamicBufferCount() const { return static_cast<uint32>(m_DynamicBufferTypes.size()); }
+    const std::vector<RHIDescriptorType>& GetDynamicBufferTypes() const { return m_DynamicBufferTypes; }
+
     // Get stored bindings
     const std::vector<RHIDescriptorSetLayoutBinding>& GetBindings() const { return m_Bindings; }
 
+    // Offset of a binding within the set's CBV/SRV/UAV table, sampler table or dynamic buffer list, whichever the
+    // binding lives in
+    uint32 GetBindingOffset(uint32 binding) const;
+
 private:
     std::vector<RHIDescriptorSetLayoutBinding> m_Bindings;
+    std::vector<RHIDescriptorType> m_DynamicBufferTypes;
     uint32 m_CBVSRVUAVCount = 0;
     uint32 m_SamplerCount = 0;
 };
@@ -116,6 +125,10 @@ public:
     uint32 GetCBVSRVUAVStartIndex() const { return m_CBVSRVUAVStartIndex; }
     uint32 GetSamplerStartIndex() const { return m_SamplerStartIndex; }
 
+    // Base addresses of the dynamic buffers, the dynamic offsets of BindDescriptorSet are added at bind time
+    const std::vector<D3D12_GPU_VIRTUAL_ADDRESS>& GetDynamicBufferAddresses() const { return m_DynamicBufferAddresses; }
+    void SetDynamicBufferAddress(uint32 index, D3D12_GPU_VIRTUAL_ADDRESS address);
+
     // Free resources back to pool
     void Release();
 
@@ -129,6 +142,44 @@ private:
     uint32 m_SamplerStartIndex = std::numeric_limits<uint32>::max();
     uint32 m_CBVSRVUAVCount = 0;
     uint32 m_SamplerCount = 0;
+
+    std::vector<D3D12_GPU_VIRTUAL_ADDRESS> m_DynamicBufferAddresses;
+};
+
+// =================================================================================================
+// DirectX12 Descriptor Update Template
+// =================================================================================================
+
+export class IGE_API DirectX12DescriptorUpdateTemplate : public RHIDescriptorUpdateTemplate {
+public:
+    // What an entry turns into, resolved once from its descriptor type
+    enum class EntryKind : uint8 {
+        ConstantBufferView,
+        RawBufferView,
+        ShaderResourceViewCopy, // Copied from the texture view's staging SRV
+        UnorderedAccessViewCopy,
+        Sampler,
+        DynamicBufferAddress, // TableOffset indexes the set's dynamic buffers
+    };
+
+    struct Entry {
+        EntryKind Kind = EntryKind::ConstantBufferView;
+        uint32 TableOffset = 0; // Within the set's CBV/SRV/UAV or sampler table
+        uint32 Count = 0;
+        uint64 DataOffset = 0;
+        uint64 Stride = 0;
+    };
+
+    DirectX12DescriptorUpdateTemplate(const RHIDescriptorUpdateTemplateCreateInfo& info);
+    ~DirectX12DescriptorUpdateTemplate() override = default;
+
+    void* GetNativeHandle() const override { return nullptr; }
+
+    // Sorted by kind so an update runs each kind back to back
+    const std::vector<Entry>& GetEntries() const { return m_Entries; }
+
+private:
+    std::vector<Entry> m_Entries;
 };
 
 // =================================================================================================
@@ -166,6 +217,8 @@ private:
     void BuildRootSignature(ID3D12Device* device, const RHIPipelineLayoutCreateInfo& info);
 
     D3D12_DESCRIPTOR_RANGE_TYPE GetDescriptorRangeType(RHIDescriptorType type) const;
+    D3D12_DESCRIPTOR_RANGE_FLAGS GetDescriptorRangeFlags(Flags<RHIDescriptorBindingFlagBits> bindingFlags,
+                                                         D3D12_DESCRIPTOR_RANGE_TYPE rangeType) const;
     D3D12_SHADER_VISIBILITY GetShaderVisibility(Flags<RHIShaderStage> stages) const;
 
     Microsoft::WRL::ComPtr<ID3D12RootSignature> m_RootSignature;
@@ -1,12 +1,12 @@
 module;
 #if defined(IGE_PLATFORM_WINDOWS)
     #include <d3d12.h>
-    #include <mutex>
-    #include <queue>
     #include <wrl/client.h>
 
 module iGe.RHI;
 import :DirectX12DescriptorHeap;
+import :RHIRangeAllocator;
+import :RHIDescriptorRing;
 
 namespace iGe
 {
@@ -37,52 +37,32 @@ void DirectX12DescriptorHeapAllocator::Initialize(ID3D12Device* device, D3D12_DE
     m_CPUHeapStart = m_Heap->GetCPUDescriptorHandleForHeapStart();
     if (shaderVisible) { m_GPUHeapStart = m_Heap->GetGPUDescriptorHandleForHeapStart(); }
 
-    m_NextFreeIndex = 0;
+    m_Indices.Reset(numDescriptors);
 }
 
 uint32 DirectX12DescriptorHeapAllocator::Allocate() {
-    std::lock_guard<std::mutex> lock(m_Mutex);
-
-    if (!m_FreeIndices.empty()) {
-        uint32 index = m_FreeIndices.front();
-        m_FreeIndices.pop();
-        return index;
-    }
-
-    if (m_NextFreeIndex >= m_NumDescriptors) {
-        Internal::LogError("Descriptor heap out of space");
-        return UINT32_MAX;
-    }
-
-    return m_NextFreeIndex++;
+    const uint32 index = m_Indices.Allocate();
+    if (index == RHIIndexAllocator::InvalidIndex) { Internal::LogError("Descriptor heap out of space"); }
+    return index;
 }
 
 uint32 DirectX12DescriptorHeapAllocator::AllocateRange(uint32 count) {
-    std::lock_guard<std::mutex> lock(m_Mutex);
-
-    // For simplicity, only allocate from the end (no fragmentation handling for ranges)
-    if (m_NextFreeIndex + count > m_NumDescriptors) {
-        Internal::LogError("Descriptor heap out of space for range allocation");
-        return UINT32_MAX;
+    const uint32 startIndex = m_Indices.AllocateRange(count);
+    if (startIndex == RHIIndexAllocator::InvalidIndex) {
+        Internal::LogError("Descriptor heap out of space for a range of {0} ({1} free, largest range {2})", count,
+                           m_Indices.GetFreeCount(), m_Indices.GetLargestFreeRange());
     }
-
-    uint32 startIndex = m_NextFreeIndex;
-    m_NextFreeIndex += count;
     return startIndex;
 }
 
 void DirectX12DescriptorHeapAllocator::Free(uint32 index) {
     if (index == UINT32_MAX) return;
-
-    std::lock_guard<std::mutex> lock(m_Mutex);
-    m_FreeIndices.push(index);
+    m_Indices.Free(index);
 }
 
 void DirectX12DescriptorHeapAllocator::FreeRange(uint32 startIndex, uint32 count) {
-    if (startIndex == UINT32_MAX) return;
-
-    std::lock_guard<std::mutex> lock(m_Mutex);
-    for (uint32 i = 0; i < count; ++i) { m_FreeIndices.push(startIndex + i); }
+    if (startIndex == UINT32_MAX || count == 0) return;
+    m_Indices.FreeRange(startIndex);
 }
 
 D3D12_CPU_DESCRIPTOR_HANDLE DirectX12DescriptorHeapAllocator::GetCPUHandle(uint32 index) const {
@@ -98,11 +78,7 @@ D3D12_GPU_DESCRIPTOR_HANDLE DirectX12DescriptorHeapAllocator::GetGPUHandle(uint3
     return handle;
 }
 
-void DirectX12DescriptorHeapAllocator::Reset() {
-    std::lock_guard<std::mutex> lock(m_Mutex);
-    m_NextFreeIndex = 0;
-    while (!m_FreeIndices.empty()) { m_FreeIndices.pop(); }
-}
+void DirectX12DescriptorHeapAllocator::Reset() { m_Indices.Reset(); }
 
 // =================================================================================================
 // DirectX12StagingDescriptorHeap Implementation
@@ -127,22 +103,14 @@ void DirectX12StagingDescriptorHeap::Initialize(ID3D12Device* device, D3D12_DESC
     }
 
     m_CPUHeapStart = m_Heap->GetCPUDescriptorHandleForHeapStart();
-    m_NextFreeIndex = 0;
+    m_Indices.Reset(numDescriptors);
 }
 
 D3D12_CPU_DESCRIPTOR_HANDLE DirectX12StagingDescriptorHeap::Allocate() {
-    std::lock_guard<std::mutex> lock(m_Mutex);
-
-    uint32 index;
-    if (!m_FreeIndices.empty()) {
-        index = m_FreeIndices.front();
-        m_FreeIndices.pop();
-    } else {
-        if (m_NextFreeIndex >= m_NumDescriptors) {
-            Internal::LogError("Staging descriptor heap out of space");
-            return {};
-        }
-        index = m_NextFreeIndex++;
+    const uint32 index = m_Indices.Allocate();
+    if (index == RHIIndexAllocator::InvalidIndex) {
+        Internal::LogError("Staging descriptor heap out of space");
+        return {};
     }
 
     D3D12_CPU_DESCRIPTOR_HANDLE handle = m_CPUHeapStart;
@@ -153,15 +121,58 @@ D3D12_CPU_DESCRIPTOR_HANDLE DirectX12StagingDescriptorHeap::Allocate() {
 void DirectX12StagingDescriptorHeap::Free(D3D12_CPU_DESCRIPTOR_HANDLE handle) {
     if (handle.ptr == 0) return;
 
-    std::lock_guard<std::mutex> lock(m_Mutex);
     uint32 index = static_cast<uint32>((handle.ptr - m_CPUHeapStart.ptr) / m_DescriptorSize);
-    m_FreeIndices.push(index);
+    m_Indices.Free(index);
+}
+
+void DirectX12StagingDescriptorHeap::Reset() { m_Indices.Reset(); }
+
+// =================================================================================================
+// DirectX12TransientDescriptorHeap Implementation
+// =================================================================================================
+
+void DirectX12TransientDescriptorHeap::Initialize(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE type,
+                                                  uint32 numDescriptors) {
+    m_Type = type;
+    m_DescriptorSize = device->GetDescriptorHandleIncrementSize(type);
+
+    D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+    heapDesc.NumDescriptors = numDescriptors;
+    heapDesc.Type = type;
+    heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+    heapDesc.NodeMask = 0;
+
+    HRESULT hr = device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&m_Heap));
+    if (FAILED(hr)) {
+        Internal::LogError("Failed to create transient descriptor heap");
+        return;
+    }
+
+    m_CPUHeapStart = m_Heap->GetCPUDescriptorHandleForHeapStart();
+    m_GPUHeapStart = m_Heap->GetGPUDescriptorHandleForHeapStart();
+
+    m_Ring.Reset(numDescriptors);
 }
 
-void DirectX12StagingDescriptorHeap::Reset() {
-    std::lock_guard<std::mutex> lock(m_Mutex);
-    m_NextFreeIndex = 0;
-    while (!m_FreeIndices.empty()) { m_FreeIndices.pop(); }
+uint32 DirectX12TransientDescriptorHeap::AllocateTable(uint32 count) {
+    const uint32 index = m_Ring.Allocate(count);
+    if (index == RHIDescriptorRing::InvalidOffset) {
+        Internal::LogError("Transient descriptor heap out of space for a table of {0} ({1} of {2} in flight)", count,
+                           m_Ring.GetUsedCount(), m_Ring.GetCapacity());
+    }
+    return index;
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE DirectX12TransientDescriptorHeap::GetCPUHandle(uint32 index) const {
+    D3D12_CPU_DESCRIPTOR_HANDLE handle = m_CPUHeapStart;
+    handle.ptr += static_cast<SIZE_T>(index) * m_DescriptorSize;
+    return handle;
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE DirectX12TransientDescriptorHeap::GetGPUHandle(uint32 index) const {
+    D3D12_GPU_DESCRIPTOR_HANDLE handle = m_GPUHeapStart;
+    handle.ptr += static_cast<UINT64>(index) * m_DescriptorSize;
+    return handle;
 }
 
 } // namespace iGe
@@ -2,11 +2,11 @@ module;
 #if defined(IGE_PLATFORM_WINDOWS)
     #include "iGeMacro.h"
     #include <d3d12.h>
-    #include <mutex>
-    #include <queue>
     #include <wrl/client.h>
 
 export module iGe.RHI:DirectX12DescriptorHeap;
+import :RHIRangeAllocator;
+import :RHIDescriptorRing;
 import iGe.Common;
 
 namespace iGe
@@ -33,7 +33,7 @@ public:
     // Free a single descriptor
     void Free(uint32 index);
 
-    // Free a range of descriptors
+    // Free a range of descriptors, freed ranges coalesce and are reused by later range allocations
     void FreeRange(uint32 startIndex, uint32 count);
 
     // Get handles
@@ -63,10 +63,7 @@ private:
     D3D12_CPU_DESCRIPTOR_HANDLE m_CPUHeapStart = {};
     D3D12_GPU_DESCRIPTOR_HANDLE m_GPUHeapStart = {};
 
-    // Simple free list allocator
-    std::mutex m_Mutex;
-    std::queue<uint32> m_FreeIndices;
-    uint32 m_NextFreeIndex = 0;
+    RHIIndexAllocator m_Indices;
 };
 
 // =================================================================================================
@@ -99,9 +96,43 @@ private:
 
     D3D12_CPU_DESCRIPTOR_HANDLE m_CPUHeapStart = {};
 
-    std::mutex m_Mutex;
-    std::queue<uint32> m_FreeIndices;
-    uint32 m_NextFreeIndex = 0;
+    RHIIndexAllocator m_Indices;
+};
+
+// =================================================================================================
+// Transient Descriptor Heap
+// Shader-visible ring for descriptor tables that only live for the frame recording them
+// =================================================================================================
+
+export class IGE_API DirectX12TransientDescriptorHeap {
+public:
+    DirectX12TransientDescriptorHeap() = default;
+    ~DirectX12TransientDescriptorHeap() = default;
+
+    void Initialize(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32 numDescriptors);
+
+    // Thread-safe and lock-free, returns the first index of a contiguous table or RHIDescriptorRing::InvalidOffset
+    uint32 AllocateTable(uint32 count);
+
+    // Frame boundaries, see RHIDescriptorRing
+    void EndFrame(uint64 fenceValue) { m_Ring.EndFrame(fenceValue); }
+    void Retire(uint64 completedValue) { m_Ring.Retire(completedValue); }
+
+    D3D12_CPU_DESCRIPTOR_HANDLE GetCPUHandle(uint32 index) const;
+    D3D12_GPU_DESCRIPTOR_HANDLE GetGPUHandle(uint32 index) const;
+
+    ID3D12DescriptorHeap* GetHeap() const { return m_Heap.Get(); }
+    uint32 GetDescriptorSize() const { return m_DescriptorSize; }
+
+private:
+    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_Heap;
+    D3D12_DESCRIPTOR_HEAP_TYPE m_Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+    uint32 m_DescriptorSize = 0;
+
+    D3D12_CPU_DESCRIPTOR_HANDLE m_CPUHeapStart = {};
+    D3D12_GPU_DESCRIPTOR_HANDLE m_GPUHeapStart = {};
+
+    RHIDescriptorRing m_Ring;
 };
 
 // =================================================================================================
@@ -70,18 +70,25 @@ bool DirectX12Fence::Wait(uint64 timeout) {
     return (waitResult == WAIT_OBJECT_0);
 }
 
-void DirectX12Fence::WaitForValue(uint64 value, uint32 timeoutMs) {
-    if (!m_Fence || !m_FenceEvent) { return; }
+bool DirectX12Fence::WaitForValue(uint64 value, uint64 timeout) {
+    if (!m_Fence || !m_FenceEvent) { return false; }
 
     // Check if fence has already reached the value
-    if (m_Fence->GetCompletedValue() >= value) { return; }
+    if (m_Fence->GetCompletedValue() >= value) { return true; }
 
     // Set up event to be signaled when fence reaches value
     HRESULT hr = m_Fence->SetEventOnCompletion(value, m_FenceEvent);
-    if (FAILED(hr)) { Internal::LogError("DirectX12Fence: Failed to set event on completion"); }
+    if (FAILED(hr)) {
+        Internal::LogError("DirectX12Fence: Failed to set event on completion");
+        return false;
+    }
+
+    // Convert timeout to milliseconds (input is nanoseconds)
+    DWORD timeoutMs =
+            (timeout == std::numeric_limits<uint64>::max()) ? INFINITE : static_cast<DWORD>(timeout / 1000000);
 
     // Wait for the event
-    WaitForSingleObject(m_FenceEvent, timeoutMs);
+    return WaitForSingleObject(m_FenceEvent, timeoutMs) == WAIT_OBJECT_0;
 }
 
 void DirectX12Fence::Reset() {
@@ -30,7 +30,7 @@ public:
     void Reset() override;
 
     // Wait for the fence to reach a specific value
-    void WaitForValue(uint64 value, uint32 timeoutMs = std::numeric_limits<uint32>::max());
+    bool WaitForValue(uint64 value, uint64 timeout = std::numeric_limits<uint64>::max()) override;
 
     // Check if signaled
     bool IsSignaled() const;
@@ -39,7 +39,7 @@ public:
     void Signal(uint64 value);
 
     // Get current completed value
-    uint64 GetCompletedValue() const;
+    uint64 GetCompletedValue() const override;
 
     // Get the next expected value
     uint64 GetNextValue() { return ++m_NextValue; }
@@ -4,6 +4,7 @@ module;
     #include <dxgi1_4.h>
 
 export module iGe.RHI:DirectX12Helper;
+import :RHIBuffer;
 import :RHITexture;
 import :RHIRenderPass;
 import :RHISampler;
@@ -121,6 +122,27 @@ export inline DXGI_FORMAT RHIFormatToDXGIFormat(RHIFormat format) {
         case RHIFormat::D24UNormS8UInt:
             return DXGI_FORMAT_D24_UNORM_S8_UINT;
 
+        case RHIFormat::BC1RGBAUNorm:
+            return DXGI_FORMAT_BC1_UNORM;
+        case RHIFormat::BC1RGBASrgb:
+            return DXGI_FORMAT_BC1_UNORM_SRGB;
+        case RHIFormat::BC3UNorm:
+            return DXGI_FORMAT_BC3_UNORM;
+        case RHIFormat::BC3Srgb:
+            return DXGI_FORMAT_BC3_UNORM_SRGB;
+        case RHIFormat::BC4UNorm:
+            return DXGI_FORMAT_BC4_UNORM;
+        case RHIFormat::BC4SNorm:
+            return DXGI_FORMAT_BC4_SNORM;
+        case RHIFormat::BC5UNorm:
+            return DXGI_FORMAT_BC5_UNORM;
+        case RHIFormat::BC5SNorm:
+            return DXGI_FORMAT_BC5_SNORM;
+        case RHIFormat::BC7UNorm:
+            return DXGI_FORMAT_BC7_UNORM;
+        case RHIFormat::BC7Srgb:
+            return DXGI_FORMAT_BC7_UNORM_SRGB;
+
         default:
             return DXGI_FORMAT_UNKNOWN;
     }
@@ -152,7 +174,7 @@ export inline D3D12_RESOURCE_STATES GetDX12State(RHILayout layout) {
         case RHILayout::DepthStencilReadOnly:
             return D3D12_RESOURCE_STATE_DEPTH_READ;
         case RHILayout::ShaderReadOnly:
-            return D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+            return D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
         case RHILayout::TransferSrc:
             return D3D12_RESOURCE_STATE_COPY_SOURCE;
         case RHILayout::TransferDst:
@@ -348,6 +370,16 @@ export inline D3D12_DESCRIPTOR_RANGE_TYPE GetDX12DescriptorRangeType(RHIDescript
     }
 }
 
+// Dynamic buffers are bound as root CBVs/UAVs, so a new offset per bind is a root argument, not a descriptor write
+export inline bool IsDX12RootDescriptorType(RHIDescriptorType type) {
+    return type == RHIDescriptorType::UniformBufferDynamic || type == RHIDescriptorType::StorageBufferDynamic;
+}
+
+export inline D3D12_GPU_VIRTUAL_ADDRESS GetDX12BufferAddress(const RHIDescriptorBufferInfo& info) {
+    auto* resource = info.pBuffer ? static_cast<ID3D12Resource*>(info.pBuffer->GetNativeHandle()) : nullptr;
+    return resource ? resource->GetGPUVirtualAddress() + info.Offset : 0;
+}
+
 // =================================================================================================
 // Command List Type Conversions
 // =================================================================================================
@@ -45,7 +45,7 @@ DirectX12ImGuiContext::DirectX12ImGuiContext() {
     ImGui_ImplGlfw_InitForOther(window, true);
 
     // Initialize DX12
-    auto* dx12RHI = static_cast<DirectX12RHI*>(RHI::Get());
+    auto* dx12RHI = DirectX12RHI::GetInstance();
     auto device = dx12RHI->GetD3D12Device();
 
     // Create Command Pool
@@ -150,7 +150,7 @@ void DirectX12ImGuiContext::End() {
     commandList->Close();
 
     // Execute command list
-    auto* dx12RHI = static_cast<DirectX12RHI*>(RHI::Get());
+    auto* dx12RHI = DirectX12RHI::GetInstance();
     auto* rhiQueue = dx12RHI->GetQueue(RHIQueueType::Graphics);
     auto* commandQueue = static_cast<ID3D12CommandQueue*>(rhiQueue->GetNativeHandle());
 
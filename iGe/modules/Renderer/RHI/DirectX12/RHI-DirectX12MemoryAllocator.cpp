@@ -0,0 +1,221 @@
+module;
+#if defined(IGE_PLATFORM_WINDOWS)
+    #include <d3d12.h>
+    #include <dxgi1_4.h>
+    #include <wrl/client.h>
+
+module iGe.RHI;
+import :DirectX12MemoryAllocator;
+import :DirectX12Helper;
+import iGe.Common;
+
+namespace iGe
+{
+
+namespace
+{
+
+D3D12_HEAP_PROPERTIES GetDX12HeapProperties(RHIMemoryUsage usage) {
+    D3D12_HEAP_PROPERTIES props = {};
+    props.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    props.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+    props.CreationNodeMask = 1;
+    props.VisibleNodeMask = 1;
+
+    switch (usage) {
+        case RHIMemoryUsage::CpuToGpu:
+            props.Type = D3D12_HEAP_TYPE_UPLOAD;
+            break;
+        case RHIMemoryUsage::GpuToCpu:
+            props.Type = D3D12_HEAP_TYPE_READBACK;
+            break;
+        default:
+            props.Type = D3D12_HEAP_TYPE_DEFAULT;
+            break;
+    }
+    return props;
+}
+
+} // namespace
+
+// =================================================================================================
+// DirectX12ResourceMemory
+// =================================================================================================
+
+void DirectX12ResourceMemory::Release() {
+    if (m_pAllocator) { m_pAllocator->Free(m_Allocation); }
+    m_pAllocator = nullptr;
+    m_Allocation = {};
+}
+
+// =================================================================================================
+// DirectX12MemoryAllocator
+// =================================================================================================
+
+DirectX12MemoryAllocator::DirectX12MemoryAllocator(ID3D12Device* device, IDXGIAdapter1* adapter,
+                                                   const RHIMemoryAllocatorCreateInfo& info)
+    : RHIMemoryAllocator(info), m_Device(device) {
+    if (adapter) { adapter->QueryInterface(IID_PPV_ARGS(&m_Adapter)); }
+}
+
+DirectX12MemoryAllocator::~DirectX12MemoryAllocator() { ReleaseBlocks(); }
+
+HRESULT DirectX12MemoryAllocator::CreateResource(const D3D12_RESOURCE_DESC& desc, RHIMemoryUsage usage,
+                                                 D3D12_RESOURCE_STATES initialState,
+                                                 const D3D12_CLEAR_VALUE* pClearValue,
+                                                 Microsoft::WRL::ComPtr<ID3D12Resource>& resource,
+                                                 DirectX12ResourceMemory& memory,
+                                                 DirectX12Relocatable* pRelocatable) {
+    const bool isBuffer = desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER;
+    const bool isTarget =
+            (desc.Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL)) != 0;
+
+    // Small textures may be placed at 4KB instead of 64KB, the device tells whether this one qualifies
+    D3D12_RESOURCE_DESC placedDesc = desc;
+    D3D12_RESOURCE_ALLOCATION_INFO allocationInfo = {};
+    if (!isBuffer && !isTarget && desc.SampleDesc.Count == 1) {
+        placedDesc.Alignment = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+        allocationInfo = m_Device->GetResourceAllocationInfo(0, 1, &placedDesc);
+        if (allocationInfo.Alignment != D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT) { placedDesc.Alignment = 0; }
+    }
+    if (placedDesc.Alignment == 0) { allocationInfo = m_Device->GetResourceAllocationInfo(0, 1, &placedDesc); }
+    if (allocationInfo.SizeInBytes == UINT64_MAX) {
+        Internal::LogError("DirectX12MemoryAllocator: Invalid resource description");
+        return E_INVALIDARG;
+    }
+
+    RHIMemoryRequest request{};
+    request.Size = allocationInfo.SizeInBytes;
+    request.Alignment = allocationInfo.Alignment;
+    request.Usage = usage;
+    request.Kind = isBuffer ? RHIMemoryResourceKind::Buffer : RHIMemoryResourceKind::Texture;
+    request.Dedicated = isTarget;
+    // Mapped pointers cannot follow a move, only memory the CPU never sees is relocatable
+    if (usage == RHIMemoryUsage::GpuOnly) { request.pRelocationOwner = pRelocatable; }
+
+    const RHIMemoryAllocation allocation = Allocate(request);
+    if (!allocation.IsValid()) { return E_OUTOFMEMORY; }
+
+    HRESULT hr;
+    if (allocation.IsDedicated()) {
+        const D3D12_HEAP_PROPERTIES props = GetDX12HeapProperties(usage);
+        hr = m_Device->CreateCommittedResource(&props, D3D12_HEAP_FLAG_NONE, &desc, initialState, pClearValue,
+                                               IID_PPV_ARGS(&resource));
+    } else {
+        auto* heap = static_cast<ID3D12Heap*>(GetBlockHandle(allocation));
+        hr = m_Device->CreatePlacedResource(heap, allocation.Offset, &placedDesc, initialState, pClearValue,
+                                            IID_PPV_ARGS(&resource));
+    }
+
+    if (FAILED(hr)) {
+        Free(allocation);
+        return hr;
+    }
+
+    memory = DirectX12ResourceMemory(this, allocation);
+    return hr;
+}
+
+RHIDefragmentationResult DirectX12MemoryAllocator::Defragment(ID3D12GraphicsCommandList* commandList,
+                                                             const RHIDefragmentationLimits& limits,
+                                                             RHIDeletionQueue& deletionQueue, uint64 frameSerial) {
+    RHIDefragmentationResult result{};
+    if (!commandList) { return result; }
+
+    std::vector<D3D12_RESOURCE_BARRIER> barriers;
+    std::vector<D3D12_RESOURCE_BARRIER> sourceBarriers;
+    for (const RHIMemoryMove& move: PlanDefragmentation(limits)) {
+        auto* owner = static_cast<DirectX12Relocatable*>(move.pOwner);
+        ID3D12Resource* source = owner->GetRelocatableResource();
+        const D3D12_RESOURCE_DESC desc = source->GetDesc();
+        const bool isBuffer = desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER;
+
+        // Buffers are always created in Common and promoted to the copy destination
+        Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+        auto* heap = static_cast<ID3D12Heap*>(GetBlockHandle(move.Dst));
+        const D3D12_RESOURCE_STATES state = isBuffer ? D3D12_RESOURCE_STATE_COMMON : D3D12_RESOURCE_STATE_COPY_DEST;
+        if (FAILED(m_Device->CreatePlacedResource(heap, move.Dst.Offset, &desc, state, nullptr,
+                                                  IID_PPV_ARGS(&resource)))) {
+            Internal::LogError("DirectX12MemoryAllocator: Failed to place a relocated resource");
+            CancelMove(move);
+            continue;
+        }
+
+        // A source in Common is promoted to a copy source implicitly, textures left in another layout by earlier
+        // frames are moved explicitly. The source is destroyed afterwards, it is never moved back.
+        sourceBarriers.clear();
+        if (const RHIResourceState* pState = owner->GetRelocatableState()) {
+            const uint32 subresourceCount = pState->IsUniform() ? 1 : pState->GetSubresourceCount();
+            for (uint32 i = 0; i < subresourceCount; ++i) {
+                const D3D12_RESOURCE_STATES sourceState = GetDX12State(pState->Get(i));
+                if (sourceState == D3D12_RESOURCE_STATE_COMMON) { continue; }
+
+                D3D12_RESOURCE_BARRIER barrier = {};
+                barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+                barrier.Transition.pResource = source;
+                barrier.Transition.Subresource = pState->IsUniform() ? D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES : i;
+                barrier.Transition.StateBefore = sourceState;
+                barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_SOURCE;
+                sourceBarriers.push_back(barrier);
+            }
+        }
+        if (!sourceBarriers.empty()) {
+            commandList->ResourceBarrier(static_cast<UINT>(sourceBarriers.size()), sourceBarriers.data());
+        }
+        commandList->CopyResource(resource.Get(), source);
+        if (!isBuffer) {
+            D3D12_RESOURCE_BARRIER barrier = {};
+            barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+            barrier.Transition.pResource = resource.Get();
+            barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+            barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
+            barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COMMON;
+            barriers.push_back(barrier);
+        }
+
+        DirectX12ResourceMemory memory(this, move.Dst);
+        owner->Relocate(m_Device.Get(), resource, memory);
+        deletionQueue.Enqueue(
+                [resource = std::move(resource), memory = std::move(memory)]() mutable {
+                    resource.Reset();
+                    memory = {};
+                },
+                frameSerial);
+
+        ++result.MoveCount;
+        result.BytesMoved += move.Dst.Size;
+        result.RelocatedResources.push_back(owner->GetRelocatedResource());
+    }
+
+    // Moved textures start over in Common, Relocate resets their tracked state to match. Buffers decay on their own
+    if (!barriers.empty()) { commandList->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data()); }
+    return result;
+}
+
+void* DirectX12MemoryAllocator::CreateBlock(RHIMemoryUsage usage, RHIMemoryResourceKind kind, uint64 size) {
+    D3D12_HEAP_DESC heapDesc = {};
+    heapDesc.SizeInBytes = size;
+    heapDesc.Properties = GetDX12HeapProperties(usage);
+    heapDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+    heapDesc.Flags = kind == RHIMemoryResourceKind::Buffer ? D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS
+                                                          : D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+
+    ID3D12Heap* heap = nullptr;
+    if (FAILED(m_Device->CreateHeap(&heapDesc, IID_PPV_ARGS(&heap)))) { return nullptr; }
+    return heap;
+}
+
+void DirectX12MemoryAllocator::DestroyBlock(void* handle) { static_cast<ID3D12Heap*>(handle)->Release(); }
+
+void DirectX12MemoryAllocator::QueryBudget(uint64& budgetBytes, uint64& usageBytes) const {
+    if (!m_Adapter) { return; }
+
+    DXGI_QUERY_VIDEO_MEMORY_INFO info = {};
+    if (SUCCEEDED(m_Adapter->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &info))) {
+        budgetBytes = info.Budget;
+        usageBytes = info.CurrentUsage;
+    }
+}
+
+} // namespace iGe
+#endif
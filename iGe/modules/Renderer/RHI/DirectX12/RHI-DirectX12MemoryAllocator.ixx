@@ -0,0 +1,113 @@
+module;
+#if defined(IGE_PLATFORM_WINDOWS)
+    #include "iGeMacro.h"
+    #include <d3d12.h>
+    #include <dxgi1_4.h>
+    #include <wrl/client.h>
+
+export module iGe.RHI:DirectX12MemoryAllocator;
+import :RHIResource;
+import :RHIMemoryAllocator;
+import :RHIDeletionQueue;
+import :RHIResourceStateTracker;
+import iGe.Common;
+
+namespace iGe
+{
+
+export class DirectX12MemoryAllocator;
+
+// =================================================================================================
+// Resource Memory
+// =================================================================================================
+
+// Heap range backing one resource, handed back to the allocator on destruction. Declare it before the
+// ID3D12Resource it backs so the resource is released first and the range is never reused while it lives.
+export class IGE_API DirectX12ResourceMemory {
+public:
+    DirectX12ResourceMemory() = default;
+    DirectX12ResourceMemory(DirectX12MemoryAllocator* pAllocator, const RHIMemoryAllocation& allocation)
+        : m_pAllocator(pAllocator), m_Allocation(allocation) {}
+    ~DirectX12ResourceMemory() { Release(); }
+
+    DirectX12ResourceMemory(const DirectX12ResourceMemory&) = delete;
+    DirectX12ResourceMemory& operator=(const DirectX12ResourceMemory&) = delete;
+
+    DirectX12ResourceMemory(DirectX12ResourceMemory&& other) noexcept
+        : m_pAllocator(std::exchange(other.m_pAllocator, nullptr)), m_Allocation(other.m_Allocation) {}
+    DirectX12ResourceMemory& operator=(DirectX12ResourceMemory&& other) noexcept {
+        if (this != &other) {
+            Release();
+            m_pAllocator = std::exchange(other.m_pAllocator, nullptr);
+            m_Allocation = other.m_Allocation;
+        }
+        return *this;
+    }
+
+    const RHIMemoryAllocation& GetAllocation() const { return m_Allocation; }
+
+private:
+    void Release();
+
+    DirectX12MemoryAllocator* m_pAllocator = nullptr;
+    RHIMemoryAllocation m_Allocation;
+};
+
+// =================================================================================================
+// Relocatable
+// =================================================================================================
+
+// Implemented by the resources the defragmenter may move
+export class IGE_API DirectX12Relocatable {
+public:
+    virtual ~DirectX12Relocatable() = default;
+
+    virtual const RHIResource* GetRelocatedResource() const = 0;
+    virtual ID3D12Resource* GetRelocatableResource() const = 0;
+    // Layouts the submitted lists left the resource in, null when it always rests in Common
+    virtual const RHIResourceState* GetRelocatableState() const { return nullptr; }
+
+    // Swaps in the moved resource and its memory and repoints the views the object owns. The previous resource
+    // and memory are handed back through the same arguments.
+    virtual void Relocate(ID3D12Device* device, Microsoft::WRL::ComPtr<ID3D12Resource>& resource,
+                          DirectX12ResourceMemory& memory) = 0;
+};
+
+// =================================================================================================
+// Memory Allocator
+// =================================================================================================
+
+// Pooled blocks are ID3D12Heaps restricted to one resource kind, so it works on resource heap tier 1.
+// Render targets and depth buffers always get a committed resource, drivers can only give those their
+// own compression metadata, and they would need a clear or discard before first use when placed.
+export class IGE_API DirectX12MemoryAllocator : public RHIMemoryAllocator {
+public:
+    DirectX12MemoryAllocator(ID3D12Device* device, IDXGIAdapter1* adapter,
+                             const RHIMemoryAllocatorCreateInfo& info = {});
+    ~DirectX12MemoryAllocator() override;
+
+    // Places the resource in a pooled heap, or creates it committed when the allocation is dedicated. A pooled
+    // GpuOnly resource with a pRelocatable owner may later be moved by Defragment.
+    HRESULT CreateResource(const D3D12_RESOURCE_DESC& desc, RHIMemoryUsage usage, D3D12_RESOURCE_STATES initialState,
+                           const D3D12_CLEAR_VALUE* pClearValue, Microsoft::WRL::ComPtr<ID3D12Resource>& resource,
+                           DirectX12ResourceMemory& memory, DirectX12Relocatable* pRelocatable = nullptr);
+
+    // Records the planned moves into commandList. The moved-from resources go to deletionQueue tagged with
+    // frameSerial, their ranges are freed once it retires and emptied blocks go away.
+    RHIDefragmentationResult Defragment(ID3D12GraphicsCommandList* commandList, const RHIDefragmentationLimits& limits,
+                                        RHIDeletionQueue& deletionQueue, uint64 frameSerial);
+
+    ID3D12Device* GetDevice() const { return m_Device.Get(); }
+
+protected:
+    void* CreateBlock(RHIMemoryUsage usage, RHIMemoryResourceKind kind, uint64 size) override;
+    void DestroyBlock(void* handle) override;
+    void QueryBudget(uint64& budgetBytes, uint64& usageBytes) const override;
+
+private:
+    Microsoft::WRL::ComPtr<ID3D12Device> m_Device;
+    Microsoft::WRL::ComPtr<IDXGIAdapter3> m_Adapter; // Null before Windows 10, the budget then stays unknown
+};
+
+} // namespace iGe
+#endif
@@ -0,0 +1,46 @@
+module;
+#if defined(IGE_PLATFORM_WINDOWS)
+    #include <d3d12.h>
+    #include <wrl/client.h>
+
+module iGe.RHI;
+import :DirectX12QueryPool;
+
+namespace iGe
+{
+
+// =================================================================================================
+// DirectX12QueryPool
+// =================================================================================================
+
+DirectX12QueryPool::DirectX12QueryPool(ID3D12Device* device, const RHIQueryPoolCreateInfo& info)
+    : RHIQueryPool(info) {
+    if (!device) { Internal::LogError("DirectX12QueryPool: Device is null"); }
+
+    D3D12_QUERY_HEAP_DESC heapDesc = {};
+    switch (info.Type) {
+        case RHIQueryType::Timestamp:
+            heapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+            m_D3D12QueryType = D3D12_QUERY_TYPE_TIMESTAMP;
+            break;
+        case RHIQueryType::Occlusion:
+            heapDesc.Type = D3D12_QUERY_HEAP_TYPE_OCCLUSION;
+            m_D3D12QueryType = D3D12_QUERY_TYPE_OCCLUSION;
+            break;
+        case RHIQueryType::PipelineStatistics:
+            heapDesc.Type = D3D12_QUERY_HEAP_TYPE_PIPELINE_STATISTICS;
+            m_D3D12QueryType = D3D12_QUERY_TYPE_PIPELINE_STATISTICS;
+            break;
+        default:
+            Internal::LogError("DirectX12QueryPool: Unknown query type");
+            return;
+    }
+    heapDesc.Count = info.Count;
+    heapDesc.NodeMask = 0;
+
+    HRESULT hr = device->CreateQueryHeap(&heapDesc, IID_PPV_ARGS(&m_QueryHeap));
+    if (FAILED(hr)) { Internal::LogError("DirectX12QueryPool: Failed to create query heap"); }
+}
+
+} // namespace iGe
+#endif
@@ -0,0 +1,35 @@
+module;
+#if defined(IGE_PLATFORM_WINDOWS)
+    #include "iGeMacro.h"
+    #include <d3d12.h>
+    #include <wrl/client.h>
+
+export module iGe.RHI:DirectX12QueryPool;
+import :RHIQuery;
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// DirectX12QueryPool
+// =================================================================================================
+
+export class IGE_API DirectX12QueryPool : public RHIQueryPool {
+public:
+    DirectX12QueryPool(ID3D12Device* device, const RHIQueryPoolCreateInfo& info);
+    ~DirectX12QueryPool() override = default;
+
+    void* GetNativeHandle() const override { return m_QueryHeap.Get(); }
+
+    ID3D12QueryHeap* GetQueryHeap() const { return m_QueryHeap.Get(); }
+    // The query type Begin/End/ResolveQueryData take for this heap
+    D3D12_QUERY_TYPE GetD3D12QueryType() const { return m_D3D12QueryType; }
+
+private:
+    Microsoft::WRL::ComPtr<ID3D12QueryHeap> m_QueryHeap;
+    D3D12_QUERY_TYPE m_D3D12QueryType = D3D12_QUERY_TYPE_TIMESTAMP;
+};
+
+} // namespace iGe
+#endif
@@ -9,6 +9,7 @@ import :DirectX12CommandList;
 import :DirectX12Fence;
 import :DirectX12Semaphore;
 import :DirectX12Helper;
+import :DirectX12RHI;
 
 namespace iGe
 {
@@ -32,6 +33,7 @@ DirectX12Queue::DirectX12Queue(ID3D12Device* device, RHIQueueType type, uint32 q
 
     // Create internal fence for WaitIdle
     m_InternalFence = CreateScope<DirectX12Fence>(device);
+    m_FixupFence = CreateScope<DirectX12Fence>(device);
 }
 
 DirectX12Queue::DirectX12Queue(const RHIQueueCreateInfo& info, Microsoft::WRL::ComPtr<ID3D12CommandQueue> queue)
@@ -40,6 +42,7 @@ DirectX12Queue::DirectX12Queue(const RHIQueueCreateInfo& info, Microsoft::WRL::C
     Microsoft::WRL::ComPtr<ID3D12Device> device;
     if (SUCCEEDED(queue->GetDevice(IID_PPV_ARGS(&device)))) {
         m_InternalFence = CreateScope<DirectX12Fence>(device.Get());
+        m_FixupFence = CreateScope<DirectX12Fence>(device.Get());
     }
 }
 
@@ -50,6 +53,7 @@ DirectX12Queue::~DirectX12Queue() {
 
 void DirectX12Queue::Submit(const RHICommandList* commandList, RHIFence* fence, std::span<RHISemaphore*> waitSemaphores,
                             std::span<RHISemaphore*> signalSemaphores) {
+    RHIQueue::Submit(commandList, fence, waitSemaphores, signalSemaphores);
     if (!m_CommandQueue) { return; }
 
     // Wait on semaphores
@@ -61,8 +65,7 @@ void DirectX12Queue::Submit(const RHICommandList* commandList, RHIFence* fence,
     // Execute command list
     auto* dx12CmdList = static_cast<const DirectX12CommandList*>(commandList);
     if (dx12CmdList && dx12CmdList->GetCommandList()) {
-        ID3D12CommandList* cmdLists[] = {dx12CmdList->GetCommandList()};
-        m_CommandQueue->ExecuteCommandLists(1, cmdLists);
+        ExecuteWithStateFixups({&dx12CmdList, 1});
     }
 
     // Signal semaphores
@@ -77,19 +80,18 @@ void DirectX12Queue::Submit(const RHICommandList* commandList, RHIFence* fence,
 }
 
 void DirectX12Queue::SubmitCommandLists(std::span<const RHICommandList*> commandLists, RHIFence* signalFence) {
+    RHIQueue::SubmitCommandLists(commandLists, signalFence);
     if (commandLists.empty() || !m_CommandQueue) { return; }
 
-    std::vector<ID3D12CommandList*> d3dCommandLists;
-    d3dCommandLists.reserve(commandLists.size());
-
+    std::vector<const DirectX12CommandList*> dx12CommandLists;
+    dx12CommandLists.reserve(commandLists.size());
     for (auto* cmdList: commandLists) {
         auto* dx12CmdList = static_cast<const DirectX12CommandList*>(cmdList);
-        if (dx12CmdList && dx12CmdList->GetCommandList()) { d3dCommandLists.push_back(dx12CmdList->GetCommandList()); }
-    }
-
-    if (!d3dCommandLists.empty()) {
-        m_CommandQueue->ExecuteCommandLists(static_cast<UINT>(d3dCommandLists.size()), d3dCommandLists.data());
+        if (dx12CmdList && dx12CmdList->GetCommandList()) {
+            dx12CommandLists.push_back(dx12CmdList);
+        }
     }
+    ExecuteWithStateFixups(dx12CommandLists);
 
     // Signal fence if provided
     if (signalFence) {
@@ -98,6 +100,71 @@ void DirectX12Queue::SubmitCommandLists(std::span<const RHICommandList*> command
     }
 }
 
+void DirectX12Queue::ExecuteWithStateFixups(std::span<const DirectX12CommandList* const> commandLists) {
+    if (commandLists.empty()) { return; }
+
+    std::lock_guard<std::mutex> lock(m_FixupMutex);
+    std::vector<ID3D12CommandList*> nativeLists;
+    nativeLists.reserve(commandLists.size() * 2);
+
+    bool hasFixups = false;
+    std::vector<RHIResourceTransition> fixups;
+    for (const DirectX12CommandList* commandList: commandLists) {
+        fixups.clear();
+        commandList->ResolveResourceStates(fixups);
+
+        // Resources entered the list in another layout than they were left in, a small list moves them first
+        if (!fixups.empty()) {
+            if (DirectX12CommandList* fixupList = AcquireFixupList()) {
+                fixupList->Begin();
+                fixupList->RecordTransitions(fixups);
+                fixupList->End();
+                nativeLists.push_back(fixupList->GetCommandList());
+                hasFixups = true;
+            }
+        }
+        nativeLists.push_back(commandList->GetCommandList());
+    }
+
+    m_CommandQueue->ExecuteCommandLists(static_cast<UINT>(nativeLists.size()), nativeLists.data());
+
+    // The fixup lists acquired above were tagged with this value
+    if (hasFixups) { Signal(m_FixupFence.get(), m_FixupFence->GetNextValue()); }
+}
+
+DirectX12CommandList* DirectX12Queue::AcquireFixupList() {
+    if (!m_FixupFence) { return nullptr; }
+
+    // Lists this queue has executed, resetting their pools releases the recorded transitions
+    const uint64 completedValue = m_FixupFence->GetCompletedValue();
+    while (!m_InFlightFixupLists.empty() && m_InFlightFixupLists.front().FenceValue <= completedValue) {
+        m_InFlightFixupLists.front().Pool->Reset();
+        m_FreeFixupLists.push_back(std::move(m_InFlightFixupLists.front()));
+        m_InFlightFixupLists.pop_front();
+    }
+
+    FixupList entry;
+    if (!m_FreeFixupLists.empty()) {
+        entry = std::move(m_FreeFixupLists.back());
+        m_FreeFixupLists.pop_back();
+    } else {
+        DirectX12RHI* rhi = DirectX12RHI::GetInstance();
+        entry.Pool = rhi->CreateCommandPool({this});
+        if (entry.Pool) { entry.List = rhi->AllocateCommandList(entry.Pool.get()); }
+        if (!entry.List) {
+            Internal::LogError("DirectX12Queue: Failed to create a state fixup list");
+            return nullptr;
+        }
+    }
+
+    entry.FenceValue = m_FixupFence->PeekNextValue();
+    entry.List->Reset();
+
+    auto* list = static_cast<DirectX12CommandList*>(entry.List.get());
+    m_InFlightFixupLists.push_back(std::move(entry));
+    return list;
+}
+
 void DirectX12Queue::WaitIdle() {
     if (!m_CommandQueue || !m_InternalFence) { return; }
 
@@ -109,10 +176,11 @@ void DirectX12Queue::WaitIdle() {
     m_InternalFence->Wait(fenceValue);
 }
 
-void DirectX12Queue::Signal(DirectX12Fence* fence, uint64 value) {
-    if (!m_CommandQueue || !fence || !fence->GetFence()) { return; }
+void DirectX12Queue::Signal(RHIFence* fence, uint64 value) {
+    auto* dx12Fence = static_cast<DirectX12Fence*>(fence);
+    if (!m_CommandQueue || !dx12Fence || !dx12Fence->GetFence()) { return; }
 
-    HRESULT hr = m_CommandQueue->Signal(fence->GetFence(), value);
+    HRESULT hr = m_CommandQueue->Signal(dx12Fence->GetFence(), value);
     if (FAILED(hr)) { Internal::LogError("DirectX12Queue: Failed to signal fence from GPU"); }
 }
 
@@ -124,10 +192,11 @@ void DirectX12Queue::Signal(DirectX12Semaphore* semaphore) {
     if (FAILED(hr)) { Internal::LogError("DirectX12Queue: Failed to signal semaphore from GPU"); }
 }
 
-void DirectX12Queue::Wait(DirectX12Fence* fence, uint64 value) {
-    if (!m_CommandQueue || !fence || !fence->GetFence()) { return; }
+void DirectX12Queue::Wait(RHIFence* fence, uint64 value) {
+    auto* dx12Fence = static_cast<DirectX12Fence*>(fence);
+    if (!m_CommandQueue || !dx12Fence || !dx12Fence->GetFence()) { return; }
 
-    HRESULT hr = m_CommandQueue->Wait(fence->GetFence(), value);
+    HRESULT hr = m_CommandQueue->Wait(dx12Fence->GetFence(), value);
     if (FAILED(hr)) { Internal::LogError("DirectX12Queue: Failed to wait on fence from GPU"); }
 }
 
@@ -138,6 +207,32 @@ void DirectX12Queue::Wait(DirectX12Semaphore* semaphore, uint64 value) {
     if (FAILED(hr)) { Internal::LogError("DirectX12Queue: Failed to wait on semaphore from GPU"); }
 }
 
+RHITimestampCalibration DirectX12Queue::CalibrateTimestamps() const {
+    RHITimestampCalibration calibration;
+    if (!m_CommandQueue) { return calibration; }
+
+    UINT64 frequency = 0;
+    UINT64 gpuTimestamp = 0;
+    UINT64 cpuTimestamp = 0;
+    if (FAILED(m_CommandQueue->GetTimestampFrequency(&frequency)) ||
+        FAILED(m_CommandQueue->GetClockCalibration(&gpuTimestamp, &cpuTimestamp))) {
+        Internal::LogWarn("DirectX12Queue: Queue cannot calibrate timestamps");
+        return calibration;
+    }
+
+    // The CPU side is a QueryPerformanceCounter value, the counter steady_clock reads on Windows
+    LARGE_INTEGER qpcFrequency;
+    QueryPerformanceFrequency(&qpcFrequency);
+    const uint64 qpcTicksPerSecond = static_cast<uint64>(qpcFrequency.QuadPart);
+    constexpr uint64 NsPerSecond = 1'000'000'000;
+
+    calibration.Frequency = frequency;
+    calibration.GpuTimestamp = gpuTimestamp;
+    calibration.CpuTimeNs = cpuTimestamp / qpcTicksPerSecond * NsPerSecond +
+                            cpuTimestamp % qpcTicksPerSecond * NsPerSecond / qpcTicksPerSecond;
+    return calibration;
+}
+
 uint64 DirectX12Queue::ExecuteCommandLists(const std::vector<ID3D12CommandList*>& commandLists) {
     if (commandLists.empty() || !m_CommandQueue) { return 0; }
 
@@ -6,6 +6,7 @@ module;
 
 export module iGe.RHI:DirectX12Queue;
 import :RHIQueue;
+import :RHICommandPool;
 import :DirectX12Fence;
 import :DirectX12Semaphore;
 import :DirectX12CommandList;
@@ -27,20 +28,21 @@ public:
     void Submit(const RHICommandList* commandList, RHIFence* fence = nullptr,
                 std::span<RHISemaphore*> waitSemaphores = {}, std::span<RHISemaphore*> signalSemaphores = {}) override;
 
-    // Submit multiple command lists
-    void SubmitCommandLists(std::span<const RHICommandList*> commandLists, RHIFence* signalFence = nullptr);
+    void SubmitCommandLists(std::span<const RHICommandList*> commandLists, RHIFence* signalFence = nullptr) override;
 
     // Wait for all submitted work to complete
     void WaitIdle() override;
 
     // Signal a fence from GPU
-    void Signal(DirectX12Fence* fence, uint64 value);
+    void Signal(RHIFence* fence, uint64 value) override;
     void Signal(DirectX12Semaphore* semaphore);
 
     // Wait on GPU for a fence value
-    void Wait(DirectX12Fence* fence, uint64 value);
+    void Wait(RHIFence* fence, uint64 value) override;
     void Wait(DirectX12Semaphore* semaphore, uint64 value);
 
+    RHITimestampCalibration CalibrateTimestamps() const override;
+
     // Getters
     RHIQueueType GetQueueType() const { return m_QueueType; }
     uint32 GetQueueIndex() const { return m_QueueIndex; }
@@ -54,11 +56,29 @@ public:
     uint64 ExecuteCommandLists(const std::vector<ID3D12CommandList*>& commandLists);
 
 private:
+    // Moves resources into the layouts a submitted list expects. Fixup lists belong to the queue and are reused
+    // once the queue's own fence has passed them, the frame fence says nothing about queues other than graphics.
+    struct FixupList {
+        Scope<RHICommandPool> Pool;
+        Scope<RHICommandList> List; // Destroyed before its pool
+        uint64 FenceValue = 0;
+    };
+
+    // Resolves the lists in order, so each sees the layouts the lists before it left behind
+    void ExecuteWithStateFixups(std::span<const DirectX12CommandList* const> commandLists);
+    DirectX12CommandList* AcquireFixupList();
+
     Microsoft::WRL::ComPtr<ID3D12CommandQueue> m_CommandQueue;
     uint32 m_QueueIndex;
 
     // Internal fence for WaitIdle
     Scope<DirectX12Fence> m_InternalFence;
+
+    // Resolution and fixup recycling, in submission order
+    std::mutex m_FixupMutex;
+    Scope<DirectX12Fence> m_FixupFence;
+    std::deque<FixupList> m_InFlightFixupLists;
+    std::vector<FixupList> m_FreeFixupLists;
 };
 
 } // namespace iGe
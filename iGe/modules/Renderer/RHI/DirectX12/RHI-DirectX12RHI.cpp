@@ -17,6 +17,7 @@ import :DirectX12SwapChain;
 import :DirectX12Shader;
 import :DirectX12GraphicsPipeline;
 import :DirectX12ComputePipeline;
+import :DirectX12QueryPool;
 import :DirectX12RenderPass;
 import :DirectX12Framebuffer;
 import :DirectX12Fence;
@@ -24,6 +25,7 @@ import :DirectX12Semaphore;
 import :DirectX12Sampler;
 import :DirectX12Descriptor;
 import :DirectX12Helper;
+import :RHIStatistics;
 
 namespace iGe
 {
@@ -32,10 +34,15 @@ namespace iGe
 // DirectX12RHI
 // =================================================================================================
 
-DirectX12RHI::DirectX12RHI() { Init(); }
+DirectX12RHI::DirectX12RHI() {
+    s_Instance = this;
+    Init();
+}
 
 DirectX12RHI::~DirectX12RHI() {
+    s_Instance = nullptr;
     WaitIdle();
+    m_DeletionQueue.Flush();
 
     // Clean up queues
     m_GraphicsQueue.reset();
@@ -115,9 +122,15 @@ void DirectX12RHI::Init() {
     m_GraphicsQueue = createQueue(D3D12_COMMAND_LIST_TYPE_DIRECT, RHIQueueType::Graphics);
     m_ComputeQueue = createQueue(D3D12_COMMAND_LIST_TYPE_COMPUTE, RHIQueueType::Compute);
     m_TransferQueue = createQueue(D3D12_COMMAND_LIST_TYPE_COPY, RHIQueueType::Transfer);
+    for (uint32 i = 0; i < m_CommandListManagers.size(); ++i) {
+        m_CommandListManagers[i] = CreateScope<RHICommandListManager>(this, GetQueue(static_cast<RHIQueueType>(i)));
+    }
+
+    m_MemoryAllocator = CreateScope<DirectX12MemoryAllocator>(m_Device.Get(), m_Adapter.Get());
 
-    // Initialize staging heaps and device properties
+    // Initialize staging and transient heaps and device properties
     InitStagingHeaps();
+    InitTransientHeaps();
     InitDeviceProperties();
 
     #if defined(IGE_DEBUG)
@@ -170,6 +183,9 @@ void DirectX12RHI::InitDeviceProperties() {
     m_DeviceProperties.Limits.MaxComputeWorkGroupSize[0] = 1024;
     m_DeviceProperties.Limits.MaxComputeWorkGroupSize[1] = 1024;
     m_DeviceProperties.Limits.MaxComputeWorkGroupSize[2] = 64;
+    m_DeviceProperties.Limits.MinUniformBufferOffsetAlignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT;
+    m_DeviceProperties.Limits.OptimalBufferCopyOffsetAlignment = D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT;
+    m_DeviceProperties.Limits.OptimalBufferCopyRowPitchAlignment = D3D12_TEXTURE_DATA_PITCH_ALIGNMENT;
 
     // Memory properties (simplified for D3D12)
     m_MemoryProperties.Heaps.resize(3);
@@ -191,12 +207,58 @@ void DirectX12RHI::InitStagingHeaps() {
     m_DSVStagingHeap.Initialize(m_Device.Get(), D3D12_DESCRIPTOR_HEAP_TYPE_DSV, 64);
 }
 
+void DirectX12RHI::InitTransientHeaps() {
+    // Shader-visible sampler heaps are capped at 2048 descriptors
+    m_TransientCBVSRVUAVHeap.Initialize(m_Device.Get(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 32768);
+    m_TransientSamplerHeap.Initialize(m_Device.Get(), D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, 1024);
+    m_FrameFence = CreateScope<DirectX12Fence>(m_Device.Get());
+
+    RHIBufferCreateInfo constantInfo{};
+    constantInfo.Size = 16ull << 20;
+    constantInfo.Usage = RHIBufferUsageBit::UniformBuffer;
+    constantInfo.MemoryUsage = RHIMemoryUsage::CpuToGpu;
+    m_ConstantAllocator = CreateScope<RHIConstantAllocator>(CreateBuffer(constantInfo),
+                                                            D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+}
+
 void DirectX12RHI::WaitIdle() {
     if (m_GraphicsQueue) { m_GraphicsQueue->WaitIdle(); }
     if (m_ComputeQueue) { m_ComputeQueue->WaitIdle(); }
     if (m_TransferQueue) { m_TransferQueue->WaitIdle(); }
 }
 
+void DirectX12RHI::BeginFrame() {
+    const uint64 completedValue = m_FrameFence->GetCompletedValue();
+    m_TransientCBVSRVUAVHeap.Retire(completedValue);
+    m_TransientSamplerHeap.Retire(completedValue);
+    m_ConstantAllocator->Retire(completedValue);
+    m_DeletionQueue.Retire(completedValue);
+}
+
+void DirectX12RHI::EndFrame(RHIQueue* pQueue) {
+    auto* dx12Queue = static_cast<DirectX12Queue*>(pQueue);
+    if (!dx12Queue) { return; }
+
+    const uint64 fenceValue = m_FrameFence->GetNextValue();
+    dx12Queue->Signal(m_FrameFence.get(), fenceValue);
+    m_TransientCBVSRVUAVHeap.EndFrame(fenceValue);
+    m_TransientSamplerHeap.EndFrame(fenceValue);
+    m_ConstantAllocator->EndFrame(fenceValue);
+    RHIStatistics::EndFrame();
+}
+
+RHIDefragmentationResult DirectX12RHI::DefragmentMemory(RHICommandList* pCommandList,
+                                                        const RHIDefragmentationLimits& limits) {
+    auto* commandList = static_cast<DirectX12CommandList*>(pCommandList);
+    if (!commandList || !commandList->CanRecord()) { return {}; }
+
+    // The copies read the layouts committed by earlier submissions, nothing recorded here may be pending
+    commandList->FlushResourceBarriers();
+
+    // Moved-from resources are tagged with the frame the copies belong to
+    return m_MemoryAllocator->Defragment(commandList->GetCommandList(), limits, m_DeletionQueue, GetFrameSerial());
+}
+
 RHIFormatProperties DirectX12RHI::GetFormatProperties(RHIFormat format) const {
     RHIFormatProperties props = {};
     DXGI_FORMAT dxFormat = RHIFormatToDXGIFormat(format);
@@ -273,6 +335,11 @@ Scope<RHICommandPool> DirectX12RHI::CreateCommandPool(const RHICommandPoolCreate
     return CreateScope<DirectX12CommandPool>(m_Device.Get(), info);
 }
 
+RHICommandListManager* DirectX12RHI::GetCommandListManager(RHIQueueType type) {
+    const uint32 index = static_cast<uint32>(type);
+    return index < m_CommandListManagers.size() ? m_CommandListManagers[index].get() : nullptr;
+}
+
 Scope<RHICommandList> DirectX12RHI::AllocateCommandList(RHICommandPool* pPool) {
     if (!pPool) { return nullptr; }
     return CreateScope<DirectX12CommandList>(m_Device.Get(), pPool);
@@ -301,23 +368,23 @@ void DirectX12RHI::FreeCommandLists(RHICommandPool* pPool, std::span<RHICommandL
 // =============================================================================
 
 Scope<RHIBuffer> DirectX12RHI::CreateBuffer(const RHIBufferCreateInfo& info) {
-    return CreateScope<DirectX12Buffer>(m_Device.Get(), info);
+    return CreateScope<DirectX12Buffer>(m_MemoryAllocator.get(), info);
 }
 
 Scope<RHIVertexBuffer> DirectX12RHI::CreateVertexBuffer(const RHIVertexBufferCreateInfo& info) {
-    return CreateScope<DirectX12VertexBuffer>(m_Device.Get(), info);
+    return CreateScope<DirectX12VertexBuffer>(m_MemoryAllocator.get(), info);
 }
 
 Scope<RHIIndexBuffer> DirectX12RHI::CreateIndexBuffer(const RHIIndexBufferCreateInfo& info) {
-    return CreateScope<DirectX12IndexBuffer>(m_Device.Get(), info);
+    return CreateScope<DirectX12IndexBuffer>(m_MemoryAllocator.get(), info);
 }
 
 Scope<RHIUniformBuffer> DirectX12RHI::CreateUniformBuffer(const RHIUniformBufferCreateInfo& info) {
-    return CreateScope<DirectX12UniformBuffer>(m_Device.Get(), info);
+    return CreateScope<DirectX12UniformBuffer>(m_MemoryAllocator.get(), info);
 }
 
 Scope<RHIStorageBuffer> DirectX12RHI::CreateStorageBuffer(const RHIStorageBufferCreateInfo& info) {
-    return CreateScope<DirectX12StorageBuffer>(m_Device.Get(), info);
+    return CreateScope<DirectX12StorageBuffer>(m_MemoryAllocator.get(), info);
 }
 
 // =============================================================================
@@ -325,7 +392,7 @@ Scope<RHIStorageBuffer> DirectX12RHI::CreateStorageBuffer(const RHIStorageBuffer
 // =============================================================================
 
 Scope<RHITexture> DirectX12RHI::CreateTexture(const RHITextureCreateInfo& info) {
-    return CreateScope<DirectX12Texture>(m_Device.Get(), info);
+    return CreateScope<DirectX12Texture>(m_MemoryAllocator.get(), info);
 }
 
 Scope<RHITextureView> DirectX12RHI::CreateTextureView(const RHITexture* pTexture,
@@ -365,6 +432,7 @@ Scope<RHIDescriptorPool> DirectX12RHI::CreateDescriptorPool(const RHIDescriptorP
 }
 
 void DirectX12RHI::UpdateDescriptorSets(std::span<const RHIWriteDescriptorSet> writes) {
+    RHI::UpdateDescriptorSets(writes);
     if (writes.empty()) { return; }
 
     for (const auto& write: writes) {
@@ -375,104 +443,173 @@ void DirectX12RHI::UpdateDescriptorSets(std::span<const RHIWriteDescriptorSet> w
         auto* layout = dx12Set->GetLayout();
         if (!pool || !layout) continue;
 
-        const auto& bindings = layout->GetBindings();
-
-        // Find the binding offset
-        uint32 cbvSrvUavOffset = 0;
-        uint32 samplerOffset = 0;
-
-        for (const auto& binding: bindings) {
-            if (binding.Binding == write.DstBinding) { break; }
-            if (binding.DescriptorType == RHIDescriptorType::Sampler) {
-                samplerOffset += binding.DescriptorCount;
-            } else {
-                cbvSrvUavOffset += binding.DescriptorCount;
+        const uint32 bindingOffset = layout->GetBindingOffset(write.DstBinding) + write.DstArrayElement;
+        if (IsDX12RootDescriptorType(write.DescriptorType)) {
+            // Only the base address is kept, the range is whatever the shader declares
+            for (uint32 i = 0; i < write.DescriptorCount && write.pBufferInfos; ++i) {
+                dx12Set->SetDynamicBufferAddress(bindingOffset + i, GetDX12BufferAddress(write.pBufferInfos[i]));
             }
+        } else if (write.DescriptorType == RHIDescriptorType::Sampler) {
+            WriteDescriptors(write, pool->GetSamplerCPUHandle(dx12Set->GetSamplerStartIndex() + bindingOffset),
+                             pool->GetSamplerDescriptorSize());
+        } else {
+            WriteDescriptors(write, pool->GetCBVSRVUAVCPUHandle(dx12Set->GetCBVSRVUAVStartIndex() + bindingOffset),
+                             pool->GetCBVSRVUAVDescriptorSize());
         }
+    }
+}
 
-        // Update descriptors based on type
-        if (write.DescriptorType == RHIDescriptorType::Sampler) {
-            if (!write.pImageInfos) continue;
-            uint32 dstIndex = dx12Set->GetSamplerStartIndex() + samplerOffset + write.DstArrayElement;
-            for (uint32 i = 0; i < write.DescriptorCount; ++i) {
-                auto* dx12Sampler = static_cast<const DirectX12Sampler*>(write.pImageInfos[i].pSampler);
-                if (dx12Sampler) {
-                    D3D12_CPU_DESCRIPTOR_HANDLE dstHandle = pool->GetSamplerCPUHandle(dstIndex + i);
-                    m_Device->CreateSampler(&dx12Sampler->GetDesc(), dstHandle);
-                }
-            }
-        } else if (write.DescriptorType == RHIDescriptorType::UniformBuffer ||
-                   write.DescriptorType == RHIDescriptorType::UniformBufferDynamic) {
-            if (!write.pBufferInfos) continue;
-            uint32 dstIndex = dx12Set->GetCBVSRVUAVStartIndex() + cbvSrvUavOffset + write.DstArrayElement;
-            for (uint32 i = 0; i < write.DescriptorCount; ++i) {
-                auto* buffer = static_cast<const DirectX12Buffer*>(write.pBufferInfos[i].pBuffer);
-                if (buffer) {
-                    D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {};
-                    cbvDesc.BufferLocation =
-                            buffer->GetResource()->GetGPUVirtualAddress() + write.pBufferInfos[i].Offset;
-                    uint64 range = write.pBufferInfos[i].Range;
-                    if (range == ~0ULL) { range = buffer->GetSize() - write.pBufferInfos[i].Offset; }
-                    cbvDesc.SizeInBytes = static_cast<UINT>((range + 255) & ~255); // 256-byte aligned
-
-                    D3D12_CPU_DESCRIPTOR_HANDLE dstHandle = pool->GetCBVSRVUAVCPUHandle(dstIndex + i);
-                    m_Device->CreateConstantBufferView(&cbvDesc, dstHandle);
-                }
+void DirectX12RHI::WriteDescriptors(const RHIWriteDescriptorSet& write, D3D12_CPU_DESCRIPTOR_HANDLE dstStart,
+                                    uint32 descriptorSize) {
+    auto dstHandle = [&](uint32 i) {
+        D3D12_CPU_DESCRIPTOR_HANDLE handle = dstStart;
+        handle.ptr += static_cast<SIZE_T>(i) * descriptorSize;
+        return handle;
+    };
+
+    // Update descriptors based on type
+    if (write.DescriptorType == RHIDescriptorType::Sampler) {
+        if (!write.pImageInfos) return;
+        for (uint32 i = 0; i < write.DescriptorCount; ++i) {
+            auto* dx12Sampler = static_cast<const DirectX12Sampler*>(write.pImageInfos[i].pSampler);
+            if (dx12Sampler) { m_Device->CreateSampler(&dx12Sampler->GetDesc(), dstHandle(i)); }
+        }
+    } else if (write.DescriptorType == RHIDescriptorType::UniformBuffer ||
+               write.DescriptorType == RHIDescriptorType::UniformBufferDynamic) {
+        if (!write.pBufferInfos) return;
+        for (uint32 i = 0; i < write.DescriptorCount; ++i) {
+            CreateConstantBufferView(write.pBufferInfos[i], dstHandle(i));
+        }
+    } else if (write.DescriptorType == RHIDescriptorType::StorageBuffer ||
+               write.DescriptorType == RHIDescriptorType::StorageBufferDynamic) {
+        if (!write.pBufferInfos) return;
+        for (uint32 i = 0; i < write.DescriptorCount; ++i) {
+            CreateRawBufferView(write.pBufferInfos[i], dstHandle(i));
+        }
+    } else if (write.DescriptorType == RHIDescriptorType::SampledImage ||
+               write.DescriptorType == RHIDescriptorType::CombinedImageSampler) {
+        if (!write.pImageInfos) return;
+        for (uint32 i = 0; i < write.DescriptorCount; ++i) {
+            auto* textureView = static_cast<const DirectX12TextureView*>(write.pImageInfos[i].pTextureView);
+            if (textureView && textureView->GetSRVCpu().ptr != 0) {
+                m_Device->CopyDescriptorsSimple(1, dstHandle(i), textureView->GetSRVCpu(),
+                                                D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
             }
-        } else if (write.DescriptorType == RHIDescriptorType::StorageBuffer ||
-                   write.DescriptorType == RHIDescriptorType::StorageBufferDynamic) {
-            if (!write.pBufferInfos) continue;
-            uint32 dstIndex = dx12Set->GetCBVSRVUAVStartIndex() + cbvSrvUavOffset + write.DstArrayElement;
-            for (uint32 i = 0; i < write.DescriptorCount; ++i) {
-                auto* buffer = static_cast<const DirectX12Buffer*>(write.pBufferInfos[i].pBuffer);
-                if (buffer) {
-                    D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
-                    uavDesc.ViewDimension = D3D12_UAV_DIMENSION_BUFFER;
-                    uavDesc.Buffer.FirstElement = write.pBufferInfos[i].Offset / 4;
-                    uint64 range = write.pBufferInfos[i].Range;
-                    if (range == ~0ULL) { range = buffer->GetSize() - write.pBufferInfos[i].Offset; }
-                    uavDesc.Buffer.NumElements = static_cast<UINT>(range / 4);
-                    uavDesc.Buffer.StructureByteStride = 0;
-                    uavDesc.Format = DXGI_FORMAT_R32_TYPELESS;
-                    uavDesc.Buffer.Flags = D3D12_BUFFER_UAV_FLAG_RAW;
-
-                    D3D12_CPU_DESCRIPTOR_HANDLE dstHandle = pool->GetCBVSRVUAVCPUHandle(dstIndex + i);
-                    m_Device->CreateUnorderedAccessView(buffer->GetResource(), nullptr, &uavDesc, dstHandle);
-                }
+        }
+    } else if (write.DescriptorType == RHIDescriptorType::StorageImage) {
+        if (!write.pImageInfos) return;
+        for (uint32 i = 0; i < write.DescriptorCount; ++i) {
+            auto* textureView = static_cast<const DirectX12TextureView*>(write.pImageInfos[i].pTextureView);
+            if (textureView && textureView->GetUAVCpu().ptr != 0) {
+                m_Device->CopyDescriptorsSimple(1, dstHandle(i), textureView->GetUAVCpu(),
+                                                D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
             }
-        } else if (write.DescriptorType == RHIDescriptorType::SampledImage ||
-                   write.DescriptorType == RHIDescriptorType::CombinedImageSampler) {
-            if (!write.pImageInfos) continue;
-            uint32 dstIndex = dx12Set->GetCBVSRVUAVStartIndex() + cbvSrvUavOffset + write.DstArrayElement;
-            for (uint32 i = 0; i < write.DescriptorCount; ++i) {
-                auto* textureView = static_cast<const DirectX12TextureView*>(write.pImageInfos[i].pTextureView);
-                if (textureView) {
-                    D3D12_CPU_DESCRIPTOR_HANDLE srcHandle = textureView->GetSRVCpu();
-                    D3D12_CPU_DESCRIPTOR_HANDLE dstHandle = pool->GetCBVSRVUAVCPUHandle(dstIndex + i);
+        }
+    }
+}
 
+void DirectX12RHI::CreateConstantBufferView(const RHIDescriptorBufferInfo& info, D3D12_CPU_DESCRIPTOR_HANDLE dst) {
+    auto* buffer = static_cast<const DirectX12Buffer*>(info.pBuffer);
+    if (!buffer) { return; }
+
+    D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {};
+    cbvDesc.BufferLocation = buffer->GetResource()->GetGPUVirtualAddress() + info.Offset;
+    uint64 range = info.Range;
+    if (range == ~0ULL) { range = buffer->GetSize() - info.Offset; }
+    cbvDesc.SizeInBytes = static_cast<UINT>((range + 255) & ~255); // 256-byte aligned
+
+    m_Device->CreateConstantBufferView(&cbvDesc, dst);
+}
+
+void DirectX12RHI::CreateRawBufferView(const RHIDescriptorBufferInfo& info, D3D12_CPU_DESCRIPTOR_HANDLE dst) {
+    auto* buffer = static_cast<const DirectX12Buffer*>(info.pBuffer);
+    if (!buffer) { return; }
+
+    D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+    uavDesc.ViewDimension = D3D12_UAV_DIMENSION_BUFFER;
+    uavDesc.Buffer.FirstElement = info.Offset / 4;
+    uint64 range = info.Range;
+    if (range == ~0ULL) { range = buffer->GetSize() - info.Offset; }
+    uavDesc.Buffer.NumElements = static_cast<UINT>(range / 4);
+    uavDesc.Buffer.StructureByteStride = 0;
+    uavDesc.Format = DXGI_FORMAT_R32_TYPELESS;
+    uavDesc.Buffer.Flags = D3D12_BUFFER_UAV_FLAG_RAW;
+
+    m_Device->CreateUnorderedAccessView(buffer->GetResource(), nullptr, &uavDesc, dst);
+}
+
+Scope<RHIDescriptorUpdateTemplate>
+DirectX12RHI::CreateDescriptorUpdateTemplate(const RHIDescriptorUpdateTemplateCreateInfo& info) {
+    return CreateScope<DirectX12DescriptorUpdateTemplate>(info);
+}
+
+void DirectX12RHI::UpdateDescriptorSetWithTemplate(RHIDescriptorSet* pSet, const RHIDescriptorUpdateTemplate* pTemplate,
+                                                   const void* pData) {
+    RHI::UpdateDescriptorSetWithTemplate(pSet, pTemplate, pData);
+    auto* dx12Set = static_cast<DirectX12DescriptorSet*>(pSet);
+    auto* dx12Template = static_cast<const DirectX12DescriptorUpdateTemplate*>(pTemplate);
+    if (!dx12Set || !dx12Template || !pData || !dx12Set->GetPool()) { return; }
+
+    using EntryKind = DirectX12DescriptorUpdateTemplate::EntryKind;
+    auto* pool = dx12Set->GetPool();
+    const auto* bytes = static_cast<const uint8*>(pData);
+
+    // View copies are gathered and issued as a single CopyDescriptors call
+    thread_local std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> dstHandles;
+    thread_local std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> srcHandles;
+    dstHandles.clear();
+    srcHandles.clear();
+
+    for (const auto& entry: dx12Template->GetEntries()) {
+        const uint8* element = bytes + entry.DataOffset;
+        const bool isSampler = entry.Kind == EntryKind::Sampler;
+        const uint32 startIndex = (isSampler ? dx12Set->GetSamplerStartIndex() : dx12Set->GetCBVSRVUAVStartIndex()) +
+                                  entry.TableOffset;
+
+        for (uint32 i = 0; i < entry.Count; ++i, element += entry.Stride) {
+            switch (entry.Kind) {
+                case EntryKind::ConstantBufferView:
+                    CreateConstantBufferView(*reinterpret_cast<const RHIDescriptorBufferInfo*>(element),
+                                             pool->GetCBVSRVUAVCPUHandle(startIndex + i));
+                    break;
+                case EntryKind::RawBufferView:
+                    CreateRawBufferView(*reinterpret_cast<const RHIDescriptorBufferInfo*>(element),
+                                        pool->GetCBVSRVUAVCPUHandle(startIndex + i));
+                    break;
+                case EntryKind::ShaderResourceViewCopy:
+                case EntryKind::UnorderedAccessViewCopy: {
+                    auto* textureView = *reinterpret_cast<const DirectX12TextureView* const*>(element);
+                    if (!textureView) { break; }
+                    const D3D12_CPU_DESCRIPTOR_HANDLE srcHandle = entry.Kind == EntryKind::ShaderResourceViewCopy
+                                                                          ? textureView->GetSRVCpu()
+                                                                          : textureView->GetUAVCpu();
                     if (srcHandle.ptr != 0) {
-                        m_Device->CopyDescriptorsSimple(1, dstHandle, srcHandle,
-                                                        D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+                        dstHandles.push_back(pool->GetCBVSRVUAVCPUHandle(startIndex + i));
+                        srcHandles.push_back(srcHandle);
                     }
+                    break;
                 }
-            }
-        } else if (write.DescriptorType == RHIDescriptorType::StorageImage) {
-            if (!write.pImageInfos) continue;
-            uint32 dstIndex = dx12Set->GetCBVSRVUAVStartIndex() + cbvSrvUavOffset + write.DstArrayElement;
-            for (uint32 i = 0; i < write.DescriptorCount; ++i) {
-                auto* textureView = static_cast<const DirectX12TextureView*>(write.pImageInfos[i].pTextureView);
-                if (textureView) {
-                    D3D12_CPU_DESCRIPTOR_HANDLE srcHandle = textureView->GetUAVCpu();
-                    D3D12_CPU_DESCRIPTOR_HANDLE dstHandle = pool->GetCBVSRVUAVCPUHandle(dstIndex + i);
-
-                    if (srcHandle.ptr != 0) {
-                        m_Device->CopyDescriptorsSimple(1, dstHandle, srcHandle,
-                                                        D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+                case EntryKind::DynamicBufferAddress:
+                    dx12Set->SetDynamicBufferAddress(
+                            entry.TableOffset + i,
+                            GetDX12BufferAddress(*reinterpret_cast<const RHIDescriptorBufferInfo*>(element)));
+                    break;
+                case EntryKind::Sampler: {
+                    auto* sampler = *reinterpret_cast<const DirectX12Sampler* const*>(element);
+                    if (sampler) {
+                        m_Device->CreateSampler(&sampler->GetDesc(), pool->GetSamplerCPUHandle(startIndex + i));
                     }
+                    break;
                 }
             }
         }
     }
+
+    if (!dstHandles.empty()) {
+        const UINT count = static_cast<UINT>(dstHandles.size());
+        m_Device->CopyDescriptors(count, dstHandles.data(), nullptr, count, srcHandles.data(), nullptr,
+                                  D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    }
 }
 
 void DirectX12RHI::CopyDescriptorSets(std::span<const RHICopyDescriptorSet> copies) {
@@ -556,6 +693,14 @@ Scope<RHIComputePipeline> DirectX12RHI::CreateComputePipeline(const RHIComputePi
     return CreateScope<DirectX12ComputePipeline>(m_Device.Get(), info);
 }
 
+// =============================================================================
+// Query Operations
+// =============================================================================
+
+Scope<RHIQueryPool> DirectX12RHI::CreateQueryPool(const RHIQueryPoolCreateInfo& info) {
+    return CreateScope<DirectX12QueryPool>(m_Device.Get(), info);
+}
+
 // =============================================================================
 // Synchronization Primitives
 // =============================================================================
@@ -601,8 +746,7 @@ void DirectX12RHI::ResetFences(std::span<RHIFence* const> fences) {
 void DirectX12RHI::DestroyResource(RHIResource* pResource) {
     if (!pResource) { return; }
 
-    // The destructor of each resource type will handle cleanup
-    delete pResource;
+    m_DeletionQueue.Enqueue(Scope<RHIResource>(pResource), GetFrameSerial());
 }
 
 } // namespace iGe
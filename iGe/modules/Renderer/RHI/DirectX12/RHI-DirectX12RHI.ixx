@@ -9,7 +9,12 @@ module;
 export module iGe.RHI:DirectX12RHI;
 import :RHI;
 import :DirectX12Queue;
+import :DirectX12Fence;
 import :DirectX12DescriptorHeap;
+import :RHIConstantAllocator;
+import :DirectX12MemoryAllocator;
+import :RHIDeletionQueue;
+import :RHICommandListManager;
 import iGe.Common;
 
 namespace iGe
@@ -37,6 +42,21 @@ public:
     RHIQueue* GetQueue(RHIQueueType type, uint32 index = 0) override;
     uint32 GetQueueCount(RHIQueueType type) const override;
 
+    // =============================================================================
+    // Frame Boundaries
+    // =============================================================================
+
+    void BeginFrame() override;
+    void EndFrame(RHIQueue* pQueue) override;
+
+    // The frame fence is signaled with the frame serial
+    uint64 GetFrameSerial() const override { return m_FrameFence->PeekNextValue(); }
+    uint64 GetCompletedFrameSerial() const override { return m_FrameFence->GetCompletedValue(); }
+    RHIConstantAllocator* GetConstantAllocator() override { return m_ConstantAllocator.get(); }
+    RHIMemoryStats GetMemoryStats() const override { return m_MemoryAllocator->GetStats(); }
+    RHIDefragmentationResult DefragmentMemory(RHICommandList* pCommandList,
+                                              const RHIDefragmentationLimits& limits = {}) override;
+
     // =============================================================================
     // Surface and SwapChain
     // =============================================================================
@@ -49,6 +69,7 @@ public:
     // =============================================================================
 
     Scope<RHICommandPool> CreateCommandPool(const RHICommandPoolCreateInfo& info) override;
+    RHICommandListManager* GetCommandListManager(RHIQueueType type) override;
 
     // Allocate command list from a pool
     Scope<RHICommandList> AllocateCommandList(RHICommandPool* pPool) override;
@@ -89,6 +110,10 @@ public:
     Scope<RHIDescriptorPool> CreateDescriptorPool(const RHIDescriptorPoolCreateInfo& info) override;
     void UpdateDescriptorSets(std::span<const RHIWriteDescriptorSet> writes) override;
     void CopyDescriptorSets(std::span<const RHICopyDescriptorSet> copies) override;
+    Scope<RHIDescriptorUpdateTemplate>
+    CreateDescriptorUpdateTemplate(const RHIDescriptorUpdateTemplateCreateInfo& info) override;
+    void UpdateDescriptorSetWithTemplate(RHIDescriptorSet* pSet, const RHIDescriptorUpdateTemplate* pTemplate,
+                                         const void* pData) override;
 
     // =============================================================================
     // Pipeline Layout
@@ -116,6 +141,12 @@ public:
     Scope<RHIGraphicsPipeline> CreateGraphicsPipeline(const RHIGraphicsPipelineCreateInfo& info) override;
     Scope<RHIComputePipeline> CreateComputePipeline(const RHIComputePipelineCreateInfo& info) override;
 
+    // =============================================================================
+    // Query Operations
+    // =============================================================================
+
+    Scope<RHIQueryPool> CreateQueryPool(const RHIQueryPoolCreateInfo& info) override;
+
     // =============================================================================
     // Synchronization Primitives
     // =============================================================================
@@ -137,6 +168,9 @@ public:
     // DirectX12 Specific
     // =============================================================================
 
+    // The backend device, RHI::Get() may return a decorator wrapping it (see RHICaptureRHI)
+    static DirectX12RHI* GetInstance() { return s_Instance; }
+
     ID3D12Device* GetD3D12Device() const { return m_Device.Get(); }
     IDXGIFactory4* GetDXGIFactory() const { return m_Factory.Get(); }
 
@@ -146,10 +180,24 @@ public:
     DirectX12StagingDescriptorHeap& GetRTVStagingHeap() { return m_RTVStagingHeap; }
     DirectX12StagingDescriptorHeap& GetDSVStagingHeap() { return m_DSVStagingHeap; }
 
+    // Shader-visible rings for per-frame descriptor tables, recycled at BeginFrame
+    DirectX12TransientDescriptorHeap& GetTransientCBVSRVUAVHeap() { return m_TransientCBVSRVUAVHeap; }
+    DirectX12TransientDescriptorHeap& GetTransientSamplerHeap() { return m_TransientSamplerHeap; }
+
+    // Write one RHI descriptor write to consecutive handles starting at dstStart
+    void WriteDescriptors(const RHIWriteDescriptorSet& write, D3D12_CPU_DESCRIPTOR_HANDLE dstStart,
+                          uint32 descriptorSize);
+
 private:
     void Init();
     void InitDeviceProperties();
     void InitStagingHeaps();
+    void InitTransientHeaps();
+
+    void CreateConstantBufferView(const RHIDescriptorBufferInfo& info, D3D12_CPU_DESCRIPTOR_HANDLE dst);
+    void CreateRawBufferView(const RHIDescriptorBufferInfo& info, D3D12_CPU_DESCRIPTOR_HANDLE dst);
+
+    inline static DirectX12RHI* s_Instance = nullptr;
 
     Microsoft::WRL::ComPtr<ID3D12Device> m_Device;
     Microsoft::WRL::ComPtr<ID3D12Device5> m_Device5; // For ray tracing support
@@ -159,6 +207,13 @@ private:
     Scope<DirectX12Queue> m_GraphicsQueue = nullptr;
     Scope<DirectX12Queue> m_ComputeQueue = nullptr;
     Scope<DirectX12Queue> m_TransferQueue = nullptr;
+    std::array<Scope<RHICommandListManager>, static_cast<size_t>(RHIQueueType::Count)> m_CommandListManagers;
+
+    // Heaps for placed resources, declared before every member that owns a resource so it is destroyed last
+    Scope<DirectX12MemoryAllocator> m_MemoryAllocator = nullptr;
+
+    // Released resources waiting for their frame to complete, flushed in the destructor once the device is idle
+    RHIDeletionQueue m_DeletionQueue;
 
     // Staging descriptor heaps (non-shader visible, for CPU-side descriptor creation)
     DirectX12StagingDescriptorHeap m_CBVSRVUAVStagingHeap;
@@ -166,6 +221,12 @@ private:
     DirectX12StagingDescriptorHeap m_RTVStagingHeap;
     DirectX12StagingDescriptorHeap m_DSVStagingHeap;
 
+    // Transient descriptor rings and the fence their frames retire on
+    DirectX12TransientDescriptorHeap m_TransientCBVSRVUAVHeap;
+    DirectX12TransientDescriptorHeap m_TransientSamplerHeap;
+    Scope<DirectX12Fence> m_FrameFence = nullptr;
+    Scope<RHIConstantAllocator> m_ConstantAllocator = nullptr;
+
     // Device properties
     RHIDeviceProperties m_DeviceProperties;
     RHIMemoryProperties m_MemoryProperties;
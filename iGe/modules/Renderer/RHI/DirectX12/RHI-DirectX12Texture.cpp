@@ -5,6 +5,7 @@ module;
 
 module iGe.RHI;
 import :DirectX12Texture;
+import :DirectX12TextureView;
 import :DirectX12Helper;
 
 namespace iGe
@@ -14,7 +15,9 @@ namespace iGe
 // DirectX12Texture
 // =================================================================================================
 
-DirectX12Texture::DirectX12Texture(ID3D12Device* device, const RHITextureCreateInfo& info) : RHITexture(info) {
+DirectX12Texture::DirectX12Texture(DirectX12MemoryAllocator* allocator, const RHITextureCreateInfo& info)
+    : RHITexture(info), m_TrackedState(info.MipLevels * info.ArrayLayers, RHILayout::Common),
+      m_Relocatable(info.Relocatable) {
     D3D12_RESOURCE_DESC desc = {};
     desc.Alignment = 0;
     desc.Width = info.Extent.Width;
@@ -33,22 +36,14 @@ DirectX12Texture::DirectX12Texture(ID3D12Device* device, const RHITextureCreateI
         desc.DepthOrArraySize = static_cast<UINT16>(info.ArrayLayers);
     }
 
-    // Infer flags
+    // Infer flags, only attachments get the render target flag so sampled textures can share pooled heaps
     desc.Flags = D3D12_RESOURCE_FLAG_NONE;
     if (IsDepthFormat(info.Format)) {
         desc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
-    } else {
-        // Assume color attachment if not depth
+    } else if (info.Usage.HasFlag(RHITextureUsageFlagBits::ColorAttachment)) {
         desc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
     }
 
-    D3D12_HEAP_PROPERTIES heapProps = {};
-    heapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
-    heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-    heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-    heapProps.CreationNodeMask = 1;
-    heapProps.VisibleNodeMask = 1;
-
     D3D12_RESOURCE_STATES initialState = D3D12_RESOURCE_STATE_COMMON;
 
     D3D12_CLEAR_VALUE clearValue = {};
@@ -68,19 +63,44 @@ DirectX12Texture::DirectX12Texture(ID3D12Device* device, const RHITextureCreateI
         pClearValue = &clearValue;
     }
 
-    HRESULT hr = device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &desc, initialState, pClearValue,
-                                                 IID_PPV_ARGS(&m_Resource));
+    HRESULT hr = allocator->CreateResource(desc, info.MemoryUsage, initialState, pClearValue, m_Resource, m_Memory,
+                                           m_Relocatable ? this : nullptr);
+    if (FAILED(hr)) {
+        Internal::LogError("Failed to create texture resource");
+        return;
+    }
 
-    if (FAILED(hr)) { Internal::LogError("Failed to create texture resource"); }
+    CreateViews(allocator->GetDevice());
+}
 
+DirectX12Texture::DirectX12Texture(ID3D12Device* device, const RHITextureCreateInfo& info, ID3D12Resource* resource)
+    : RHITexture(info), m_Resource(resource), m_TrackedState(info.MipLevels * info.ArrayLayers, RHILayout::Present) {
     CreateViews(device);
 }
 
-DirectX12Texture::DirectX12Texture(ID3D12Device* device, const RHITextureCreateInfo& info, ID3D12Resource* resource)
-    : RHITexture(info), m_Resource(resource) {
+void DirectX12Texture::Relocate(ID3D12Device* device, Microsoft::WRL::ComPtr<ID3D12Resource>& resource,
+                                DirectX12ResourceMemory& memory) {
+    m_Resource.Swap(resource);
+    std::swap(m_Memory, memory);
+    // The copy left the new resource in COMMON
+    m_TrackedState.Reset(m_TrackedState.GetSubresourceCount(), RHILayout::Common);
     CreateViews(device);
+
+    std::lock_guard<std::mutex> lock(m_ViewMutex);
+    for (DirectX12TextureView* view: m_Views) { view->Relocate(device); }
+}
+
+void DirectX12Texture::AttachView(DirectX12TextureView* view) {
+    std::lock_guard<std::mutex> lock(m_ViewMutex);
+    m_Views.push_back(view);
+}
+
+void DirectX12Texture::DetachView(DirectX12TextureView* view) {
+    std::lock_guard<std::mutex> lock(m_ViewMutex);
+    std::erase(m_Views, view);
 }
 
+// Heaps are created on first use, a relocation only rewrites the descriptors
 void DirectX12Texture::CreateViews(Microsoft::WRL::ComPtr<ID3D12Device> device) {
     D3D12_RESOURCE_DESC desc = m_Resource->GetDesc();
 
@@ -90,7 +110,7 @@ void DirectX12Texture::CreateViews(Microsoft::WRL::ComPtr<ID3D12Device> device)
         rtvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
         rtvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
 
-        if (FAILED(device->CreateDescriptorHeap(&rtvHeapDesc, IID_PPV_ARGS(&m_RTVHeap)))) {
+        if (!m_RTVHeap && FAILED(device->CreateDescriptorHeap(&rtvHeapDesc, IID_PPV_ARGS(&m_RTVHeap)))) {
             Internal::LogError("Failed to create RTV heap");
         }
 
@@ -104,7 +124,7 @@ void DirectX12Texture::CreateViews(Microsoft::WRL::ComPtr<ID3D12Device> device)
         dsvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_DSV;
         dsvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
 
-        if (FAILED(device->CreateDescriptorHeap(&dsvHeapDesc, IID_PPV_ARGS(&m_DSVHeap)))) {
+        if (!m_DSVHeap && FAILED(device->CreateDescriptorHeap(&dsvHeapDesc, IID_PPV_ARGS(&m_DSVHeap)))) {
             Internal::LogError("Failed to create DSV heap");
         }
 
@@ -119,7 +139,7 @@ void DirectX12Texture::CreateViews(Microsoft::WRL::ComPtr<ID3D12Device> device)
         srvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
         srvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
 
-        if (FAILED(device->CreateDescriptorHeap(&srvHeapDesc, IID_PPV_ARGS(&m_SRVHeap)))) {
+        if (!m_SRVHeap && FAILED(device->CreateDescriptorHeap(&srvHeapDesc, IID_PPV_ARGS(&m_SRVHeap)))) {
             Internal::LogError("Failed to create SRV heap");
         }
 
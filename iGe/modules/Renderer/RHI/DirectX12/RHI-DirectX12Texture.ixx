@@ -6,15 +6,19 @@ module;
 
 export module iGe.RHI:DirectX12Texture;
 import :RHITexture;
+import :RHIResourceStateTracker;
+import :DirectX12MemoryAllocator;
 import iGe.Common;
 
 namespace iGe
 {
 
-export class IGE_API DirectX12Texture : public RHITexture {
+export class DirectX12TextureView;
+
+export class IGE_API DirectX12Texture : public RHITexture, public DirectX12Relocatable {
 public:
     // Constructor for creating a new texture
-    DirectX12Texture(ID3D12Device* device, const RHITextureCreateInfo& info);
+    DirectX12Texture(DirectX12MemoryAllocator* allocator, const RHITextureCreateInfo& info);
 
     // Constructor for wrapping an existing resource (e.g. SwapChain backbuffer)
     DirectX12Texture(ID3D12Device* device, const RHITextureCreateInfo& info, ID3D12Resource* resource);
@@ -33,14 +37,32 @@ public:
     ID3D12DescriptorHeap* GetSRVHeap() const { return m_SRVHeap.Get(); }
     D3D12_GPU_DESCRIPTOR_HANDLE GetSRVHandleGPU() const { return m_SRVHeap->GetGPUDescriptorHandleForHeapStart(); }
 
-    D3D12_RESOURCE_STATES GetState() const { return m_State; }
-    void SetState(D3D12_RESOURCE_STATES state) { m_State = state; }
+    // Layouts committed by the submitted lists, see RHIResourceStateTracker
+    RHIResourceState* GetTrackedState() const { return &m_TrackedState; }
+    uint32 GetSubresourceCount() const { return m_TrackedState.GetSubresourceCount(); }
+
+    // DirectX12Relocatable interface
+    const RHIResource* GetRelocatedResource() const override { return this; }
+    ID3D12Resource* GetRelocatableResource() const override { return m_Resource.Get(); }
+    const RHIResourceState* GetRelocatableState() const override { return &m_TrackedState; }
+    void Relocate(ID3D12Device* device, Microsoft::WRL::ComPtr<ID3D12Resource>& resource,
+                  DirectX12ResourceMemory& memory) override;
+
+    // Views of a relocatable texture register here so a move can rewrite their descriptors
+    bool IsRelocatable() const { return m_Relocatable; }
+    void AttachView(DirectX12TextureView* view);
+    void DetachView(DirectX12TextureView* view);
 
 private:
     void CreateViews(Microsoft::WRL::ComPtr<ID3D12Device> device);
 
+    DirectX12ResourceMemory m_Memory; // Outlives m_Resource, empty for wrapped resources
     Microsoft::WRL::ComPtr<ID3D12Resource> m_Resource;
-    D3D12_RESOURCE_STATES m_State = D3D12_RESOURCE_STATE_COMMON;
+    mutable RHIResourceState m_TrackedState;
+    bool m_Relocatable = false;
+
+    std::mutex m_ViewMutex;
+    std::vector<DirectX12TextureView*> m_Views;
 
     // Simple descriptor management: each texture owns its own heaps for views (Inefficient but simple)
     Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_RTVHeap;
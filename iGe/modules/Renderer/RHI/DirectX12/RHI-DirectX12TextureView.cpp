@@ -45,8 +45,9 @@ inline UINT MapComponentMapping(const RHIComponentMapping& mapping) {
 
 DirectX12TextureView::DirectX12TextureView(ID3D12Device* device, const RHITextureViewCreateInfo& info,
                                            DirectX12Texture* texture)
-    : RHITextureView(info) {
+    : RHITextureView(info), m_pTexture(texture) {
     if (!device || !texture) { Internal::LogError("DirectX12TextureView: Invalid device or texture"); }
+    if (texture->IsRelocatable()) { texture->AttachView(this); }
 
     // Determine format from info or fallback to texture format
     RHIFormat viewFormat = info.Format != RHIFormat::Unknown ? info.Format : texture->GetFormat();
@@ -161,6 +162,7 @@ DirectX12TextureView::DirectX12TextureView(ID3D12Device* device, const RHITextur
         }
 
         device->CreateShaderResourceView(texture->GetResource(), &srvDesc, m_SRVHandle);
+        m_SRVDesc = srvDesc;
     }
 
     // Create RTV/DSV based on texture usage and format
@@ -408,9 +410,18 @@ DirectX12TextureView::DirectX12TextureView(ID3D12Device* device, const RHITextur
         }
 
         device->CreateShaderResourceView(texture->GetResource(), &srvDesc, m_SRVHandle);
+        m_SRVDesc = srvDesc;
     }
 }
 
+DirectX12TextureView::~DirectX12TextureView() {
+    if (m_pTexture && m_pTexture->IsRelocatable()) { m_pTexture->DetachView(this); }
+}
+
+void DirectX12TextureView::Relocate(ID3D12Device* device) {
+    if (m_SRVHeap) { device->CreateShaderResourceView(m_pTexture->GetResource(), &m_SRVDesc, m_SRVHandle); }
+}
+
 D3D12_GPU_DESCRIPTOR_HANDLE DirectX12TextureView::GetSRVGpu() const {
     if (m_SRVHeap) { return m_SRVHeap->GetGPUDescriptorHandleForHeapStart(); }
     return D3D12_GPU_DESCRIPTOR_HANDLE{0};
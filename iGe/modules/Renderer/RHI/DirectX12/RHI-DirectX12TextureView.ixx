@@ -16,7 +16,7 @@ export class IGE_API DirectX12TextureView : public RHITextureView {
 public:
     DirectX12TextureView(ID3D12Device* device, const RHITextureViewCreateInfo& info, DirectX12Texture* texture);
 
-    ~DirectX12TextureView() override = default;
+    ~DirectX12TextureView() override;
 
     // Get various descriptor handles
     D3D12_CPU_DESCRIPTOR_HANDLE GetSRVCpu() const { return m_SRVHandle; }
@@ -26,7 +26,16 @@ public:
     D3D12_CPU_DESCRIPTOR_HANDLE GetRTVCpu() const { return m_RTVHandle; }
     D3D12_CPU_DESCRIPTOR_HANDLE GetDSVCpu() const { return m_DSVHandle; }
 
+    DirectX12Texture* GetTexture() const { return m_pTexture; }
+
+    // Rewrites the shader resource view after the texture moved. Relocatable textures are never attachments,
+    // so there are no render target or depth views to follow
+    void Relocate(ID3D12Device* device);
+
 private:
+    DirectX12Texture* m_pTexture = nullptr;
+    D3D12_SHADER_RESOURCE_VIEW_DESC m_SRVDesc = {};
+
     // Descriptor heaps for this view
     Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_SRVHeap;
     Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_UAVHeap;
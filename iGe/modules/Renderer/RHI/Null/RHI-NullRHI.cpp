@@ -0,0 +1,259 @@
+module iGe.RHI;
+import :NullRHI;
+import :RHIStatistics;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Null Objects
+// =================================================================================================
+
+std::vector<Scope<RHIDescriptorSet>>
+NullDescriptorPool::AllocateDescriptorSets(std::span<const RHIDescriptorSetLayout* const> layouts) {
+    std::vector<Scope<RHIDescriptorSet>> sets;
+    sets.reserve(layouts.size());
+    for (const RHIDescriptorSetLayout* layout: layouts) { sets.push_back(AllocateDescriptorSet(layout)); }
+    return sets;
+}
+
+void NullQueue::Submit(const RHICommandList* commandList, RHIFence* fence, std::span<RHISemaphore*> waitSemaphores,
+                       std::span<RHISemaphore*> signalSemaphores) {
+    RHIQueue::Submit(commandList, fence, waitSemaphores, signalSemaphores);
+    if (commandList) { m_SubmittedListCount.fetch_add(1, std::memory_order_relaxed); }
+    if (fence) { static_cast<NullFence*>(fence)->SignalNext(); }
+}
+
+void NullQueue::SubmitCommandLists(std::span<const RHICommandList*> commandLists, RHIFence* signalFence) {
+    RHIQueue::SubmitCommandLists(commandLists, signalFence);
+    m_SubmittedListCount.fetch_add(commandLists.size(), std::memory_order_relaxed);
+    if (signalFence) { static_cast<NullFence*>(signalFence)->SignalNext(); }
+}
+
+void NullQueue::Signal(RHIFence* fence, uint64 value) {
+    if (fence) { static_cast<NullFence*>(fence)->Signal(value); }
+}
+
+RHITimestampCalibration NullQueue::CalibrateTimestamps() const {
+    const uint64 now = Profiler::Now();
+    return {1'000'000'000, now, now};
+}
+
+void NullCommandList::WriteTimestamp(const RHIQueryPool* pool, uint32 index) {
+    if (!pool || pool->GetQueryType() != RHIQueryType::Timestamp || index >= pool->GetQueryCount()) { return; }
+
+    const uint64 now = Profiler::Now();
+    auto results = const_cast<NullQueryPool*>(static_cast<const NullQueryPool*>(pool))->GetResults();
+    std::memcpy(results.data() + static_cast<size_t>(index) * sizeof(uint64), &now, sizeof(uint64));
+}
+
+void NullCommandList::ResolveQueries(const RHIQueryPool* pool, uint32 firstIndex, uint32 count,
+                                     const RHIBuffer* dstBuffer, uint64 dstOffset) {
+    if (!pool || !dstBuffer || count == 0 || firstIndex + count > pool->GetQueryCount()) { return; }
+
+    // Commands run when they are recorded, the results land straight in the buffer
+    const uint32 resultSize = GetRHIQueryResultSize(pool->GetQueryType());
+    auto results = const_cast<NullQueryPool*>(static_cast<const NullQueryPool*>(pool))->GetResults();
+    const_cast<RHIBuffer*>(dstBuffer)->Update(dstOffset, static_cast<uint64>(count) * resultSize,
+                                              results.data() + static_cast<size_t>(firstIndex) * resultSize);
+}
+
+NullSwapChain::NullSwapChain(const RHISwapChainCreateInfo& info) : RHISwapChain(info) { CreateBackBuffers(); }
+
+uint32 NullSwapChain::AcquireNextImage(RHISemaphore* signalSemaphore, RHIFence* signalFence) {
+    m_CurrentImage = (m_CurrentImage + 1) % m_ImageCount;
+    if (signalFence) { static_cast<NullFence*>(signalFence)->SignalNext(); }
+    return m_CurrentImage;
+}
+
+void NullSwapChain::Resize(uint32 width, uint32 height) {
+    m_Extent = {width, height};
+    CreateBackBuffers();
+}
+
+void NullSwapChain::CreateBackBuffers() {
+    m_BackBuffers.clear();
+    m_BackBufferViews.clear();
+    m_CurrentImage = 0;
+
+    for (uint32 i = 0; i < m_ImageCount; ++i) {
+        RHITextureCreateInfo textureInfo = {};
+        textureInfo.Format = m_Format;
+        textureInfo.Extent = {m_Extent.Width, m_Extent.Height, 1};
+        textureInfo.Usage = RHITextureUsageFlagBits::ColorAttachment;
+        m_BackBuffers.push_back(CreateScope<NullTexture>(textureInfo));
+
+        RHITextureViewCreateInfo viewInfo = {};
+        viewInfo.Format = m_Format;
+        m_BackBufferViews.push_back(CreateScope<NullTextureView>(viewInfo));
+    }
+}
+
+// =================================================================================================
+// NullRHI
+// =================================================================================================
+
+NullRHI::NullRHI() {
+    m_DeviceProperties.DeviceName = "Null Device";
+
+    // Generous enough that nothing sized from the limits is rejected
+    m_DeviceProperties.Limits.MaxImageDimension1D = 16384;
+    m_DeviceProperties.Limits.MaxImageDimension2D = 16384;
+    m_DeviceProperties.Limits.MaxImageDimension3D = 2048;
+    m_DeviceProperties.Limits.MaxImageDimensionCube = 16384;
+    m_DeviceProperties.Limits.MaxImageArrayLayers = 2048;
+    m_DeviceProperties.Limits.MaxUniformBufferRange = 65536;
+    m_DeviceProperties.Limits.MaxStorageBufferRange = 2147483647;
+    m_DeviceProperties.Limits.MaxPushConstantsSize = 256;
+    m_DeviceProperties.Limits.MaxBoundDescriptorSets = 8;
+    m_DeviceProperties.Limits.MaxColorAttachments = 8;
+    m_DeviceProperties.Limits.MinUniformBufferOffsetAlignment = 256;
+
+    for (uint32 i = 0; i < m_Queues.size(); ++i) {
+        m_Queues[i] = CreateScope<NullQueue>(RHIQueueCreateInfo{static_cast<RHIQueueType>(i), 0});
+        m_CommandListManagers[i] = CreateScope<RHICommandListManager>(this, m_Queues[i].get());
+    }
+
+    RHIBufferCreateInfo constantInfo{};
+    constantInfo.Size = 16ull << 20;
+    constantInfo.Usage = RHIBufferUsageBit::UniformBuffer;
+    constantInfo.MemoryUsage = RHIMemoryUsage::CpuToGpu;
+    m_ConstantAllocator = CreateScope<RHIConstantAllocator>(CreateBuffer(constantInfo), 256);
+}
+
+NullRHI::~NullRHI() = default;
+
+RHIFormatProperties NullRHI::GetFormatProperties(RHIFormat format) const {
+    RHIFormatProperties props = {};
+    props.OptimalTilingSampledImage = true;
+    props.OptimalTilingStorageImage = true;
+    props.OptimalTilingColorAttachment = true;
+    props.OptimalTilingDepthStencilAttachment = true;
+    props.OptimalTilingBlitSrc = true;
+    props.OptimalTilingBlitDst = true;
+    props.BufferVertexBuffer = true;
+    props.BufferUniformTexelBuffer = true;
+    props.BufferStorageTexelBuffer = true;
+    return props;
+}
+
+RHIQueue* NullRHI::GetQueue(RHIQueueType type, uint32 index) {
+    const uint32 queueIndex = static_cast<uint32>(type);
+    return queueIndex < m_Queues.size() && index == 0 ? m_Queues[queueIndex].get() : nullptr;
+}
+
+void NullRHI::BeginFrame() { m_ConstantAllocator->Retire(GetCompletedFrameSerial()); }
+
+void NullRHI::EndFrame(RHIQueue* pQueue) {
+    m_ConstantAllocator->EndFrame(m_FrameSerial);
+    ++m_FrameSerial;
+    RHIStatistics::EndFrame();
+}
+
+Scope<RHISurface> NullRHI::CreateSurface(const RHISurfaceCreateInfo& info) { return CreateScope<NullSurface>(info); }
+
+Scope<RHISwapChain> NullRHI::CreateSwapChain(const RHISwapChainCreateInfo& info) {
+    return CreateScope<NullSwapChain>(info);
+}
+
+Scope<RHICommandPool> NullRHI::CreateCommandPool(const RHICommandPoolCreateInfo& info) {
+    return CreateScope<NullCommandPool>(info);
+}
+
+RHICommandListManager* NullRHI::GetCommandListManager(RHIQueueType type) {
+    const uint32 index = static_cast<uint32>(type);
+    return index < m_CommandListManagers.size() ? m_CommandListManagers[index].get() : nullptr;
+}
+
+Scope<RHICommandList> NullRHI::AllocateCommandList(RHICommandPool* pPool) {
+    if (!pPool) { return nullptr; }
+    return CreateScope<NullCommandList>();
+}
+
+std::vector<Scope<RHICommandList>> NullRHI::AllocateCommandLists(RHICommandPool* pPool, uint32 count) {
+    std::vector<Scope<RHICommandList>> lists;
+    lists.reserve(count);
+    for (uint32 i = 0; i < count; ++i) { lists.push_back(AllocateCommandList(pPool)); }
+    return lists;
+}
+
+Scope<RHIBuffer> NullRHI::CreateBuffer(const RHIBufferCreateInfo& info) { return CreateScope<NullBuffer>(info); }
+
+Scope<RHIVertexBuffer> NullRHI::CreateVertexBuffer(const RHIVertexBufferCreateInfo& info) {
+    return CreateScope<NullVertexBuffer>(info);
+}
+
+Scope<RHIIndexBuffer> NullRHI::CreateIndexBuffer(const RHIIndexBufferCreateInfo& info) {
+    return CreateScope<NullIndexBuffer>(info);
+}
+
+Scope<RHIUniformBuffer> NullRHI::CreateUniformBuffer(const RHIUniformBufferCreateInfo& info) {
+    return CreateScope<NullUniformBuffer>(info);
+}
+
+Scope<RHIStorageBuffer> NullRHI::CreateStorageBuffer(const RHIStorageBufferCreateInfo& info) {
+    return CreateScope<NullStorageBuffer>(info);
+}
+
+Scope<RHITexture> NullRHI::CreateTexture(const RHITextureCreateInfo& info) { return CreateScope<NullTexture>(info); }
+
+Scope<RHITextureView> NullRHI::CreateTextureView(const RHITexture* pTexture, const RHITextureViewCreateInfo& info) {
+    if (!pTexture) { return nullptr; }
+
+    RHITextureViewCreateInfo viewInfo = info;
+    if (viewInfo.Format == RHIFormat::Unknown) { viewInfo.Format = pTexture->GetFormat(); }
+    return CreateScope<NullTextureView>(viewInfo);
+}
+
+Scope<RHISampler> NullRHI::CreateSampler(const RHISamplerCreateInfo& info) { return CreateScope<NullSampler>(info); }
+
+Scope<RHIDescriptorSetLayout> NullRHI::CreateDescriptorSetLayout(const RHIDescriptorSetLayoutCreateInfo& info) {
+    return CreateScope<NullDescriptorSetLayout>(info);
+}
+
+Scope<RHIDescriptorPool> NullRHI::CreateDescriptorPool(const RHIDescriptorPoolCreateInfo& info) {
+    return CreateScope<NullDescriptorPool>(info);
+}
+
+Scope<RHIDescriptorUpdateTemplate>
+NullRHI::CreateDescriptorUpdateTemplate(const RHIDescriptorUpdateTemplateCreateInfo& info) {
+    return CreateScope<NullDescriptorUpdateTemplate>(info);
+}
+
+Scope<RHIPipelineLayout> NullRHI::CreatePipelineLayout(const RHIPipelineLayoutCreateInfo& info) {
+    return CreateScope<NullPipelineLayout>(info);
+}
+
+Scope<RHIRenderPass> NullRHI::CreateRenderPass(const RHIRenderPassCreateInfo& info) {
+    return CreateScope<NullRenderPass>(info);
+}
+
+Scope<RHIFramebuffer> NullRHI::CreateFramebuffer(const RHIFramebufferCreateInfo& info) {
+    return CreateScope<NullFramebuffer>(info);
+}
+
+Scope<RHIShader> NullRHI::CreateShader(const RHIShaderCreateInfo& info) { return CreateScope<NullShader>(info); }
+
+Scope<RHIGraphicsPipeline> NullRHI::CreateGraphicsPipeline(const RHIGraphicsPipelineCreateInfo& info) {
+    return CreateScope<NullGraphicsPipeline>(info);
+}
+
+Scope<RHIComputePipeline> NullRHI::CreateComputePipeline(const RHIComputePipelineCreateInfo& info) {
+    return CreateScope<NullComputePipeline>(info);
+}
+
+Scope<RHIQueryPool> NullRHI::CreateQueryPool(const RHIQueryPoolCreateInfo& info) {
+    return CreateScope<NullQueryPool>(info);
+}
+
+Scope<RHIFence> NullRHI::CreateGPUFence(const RHIFenceCreateInfo& info) { return CreateScope<NullFence>(info); }
+
+Scope<RHISemaphore> NullRHI::CreateGPUSemaphore() { return CreateScope<NullSemaphore>(); }
+
+void NullRHI::ResetFences(std::span<RHIFence* const> fences) {
+    for (RHIFence* fence: fences) {
+        if (fence) { fence->Reset(); }
+    }
+}
+
+} // namespace iGe
@@ -0,0 +1,399 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.RHI:NullRHI;
+import :RHI;
+import :RHIBuffer;
+import :RHITexture;
+import :RHITextureView;
+import :RHISampler;
+import :RHIDescriptor;
+import :RHIRenderPass;
+import :RHIFramebuffer;
+import :RHIShader;
+import :RHIGraphicsPipeline;
+import :RHIComputePipeline;
+import :RHIQuery;
+import :RHIFence;
+import :RHISemaphore;
+import :RHIQueue;
+import :RHICommandPool;
+import :RHICommandList;
+import :RHICommandListManager;
+import :RHIConstantAllocator;
+import :RHISurface;
+import :RHISwapChain;
+import iGe.Common;
+
+namespace iGe
+{
+
+// A headless backend without a device. Objects carry their create info and nothing else, work submitted to a
+// queue completes on the spot. It runs wherever the engine compiles, for replaying captures and for tools that
+// measure the CPU side of the RHI.
+
+// =================================================================================================
+// Null Resources
+// =================================================================================================
+
+// Any buffer type, backed by host memory so mapping and updates behave
+export template<typename Base>
+class NullBufferImpl final : public Base {
+public:
+    template<typename CreateInfo>
+    explicit NullBufferImpl(const CreateInfo& info) : Base(info), m_Data(this->m_Size) {}
+
+    void Unmap() override { m_Mapped = false; }
+    bool IsMapped() const override { return m_Mapped; }
+
+    void Flush(uint64 offset = 0, uint64 size = ~0ULL) override {}
+    void Invalidate(uint64 offset = 0, uint64 size = ~0ULL) override {}
+
+private:
+    void* MapMemory() override {
+        m_Mapped = true;
+        return m_Data.data();
+    }
+
+    uint64 UpdateMemory(uint64 offset, uint64 size, const void* data) override {
+        if (offset >= m_Data.size()) { return 0; }
+        const uint64 written = std::min(size, m_Data.size() - offset);
+        std::memcpy(m_Data.data() + offset, data, written);
+        return written;
+    }
+
+    std::vector<std::byte> m_Data;
+    bool m_Mapped = false;
+};
+
+export using NullBuffer = NullBufferImpl<RHIBuffer>;
+export using NullVertexBuffer = NullBufferImpl<RHIVertexBuffer>;
+export using NullIndexBuffer = NullBufferImpl<RHIIndexBuffer>;
+export using NullUniformBuffer = NullBufferImpl<RHIUniformBuffer>;
+export using NullStorageBuffer = NullBufferImpl<RHIStorageBuffer>;
+
+export class NullTexture final : public RHITexture {
+public:
+    explicit NullTexture(const RHITextureCreateInfo& info) : RHITexture(info) {}
+};
+
+export class NullTextureView final : public RHITextureView {
+public:
+    explicit NullTextureView(const RHITextureViewCreateInfo& info) : RHITextureView(info) {}
+};
+
+export class NullSampler final : public RHISampler {
+public:
+    explicit NullSampler(const RHISamplerCreateInfo& info) : RHISampler(info) {}
+};
+
+export class NullDescriptorSetLayout final : public RHIDescriptorSetLayout {
+public:
+    explicit NullDescriptorSetLayout(const RHIDescriptorSetLayoutCreateInfo& info) : RHIDescriptorSetLayout(info) {}
+};
+
+export class NullPipelineLayout final : public RHIPipelineLayout {
+public:
+    explicit NullPipelineLayout(const RHIPipelineLayoutCreateInfo& info) : RHIPipelineLayout(info) {}
+};
+
+export class NullDescriptorSet final : public RHIDescriptorSet {};
+
+export class NullDescriptorPool final : public RHIDescriptorPool {
+public:
+    explicit NullDescriptorPool(const RHIDescriptorPoolCreateInfo& info)
+        : RHIDescriptorPool(info), m_AllowFree(info.AllowFreeDescriptorSet) {}
+
+    void Reset() override {}
+    Scope<RHIDescriptorSet> AllocateDescriptorSet(const RHIDescriptorSetLayout* pLayout) override {
+        return CreateScope<NullDescriptorSet>();
+    }
+    std::vector<Scope<RHIDescriptorSet>>
+    AllocateDescriptorSets(std::span<const RHIDescriptorSetLayout* const> layouts) override;
+    // Takes the set over like the DirectX12 pool does
+    void FreeDescriptorSet(RHIDescriptorSet* pSet) override {
+        if (m_AllowFree) { delete pSet; }
+    }
+    void FreeDescriptorSets(std::span<RHIDescriptorSet*> sets) override {
+        for (RHIDescriptorSet* set: sets) { FreeDescriptorSet(set); }
+    }
+
+private:
+    bool m_AllowFree = false;
+};
+
+export class NullDescriptorUpdateTemplate final : public RHIDescriptorUpdateTemplate {
+public:
+    explicit NullDescriptorUpdateTemplate(const RHIDescriptorUpdateTemplateCreateInfo& info)
+        : RHIDescriptorUpdateTemplate(info) {}
+};
+
+export class NullRenderPass final : public RHIRenderPass {
+public:
+    explicit NullRenderPass(const RHIRenderPassCreateInfo& info) : RHIRenderPass(info) {}
+};
+
+export class NullFramebuffer final : public RHIFramebuffer {
+public:
+    explicit NullFramebuffer(const RHIFramebufferCreateInfo& info) : RHIFramebuffer(info) {}
+};
+
+export class NullShader final : public RHIShader {
+public:
+    explicit NullShader(const RHIShaderCreateInfo& info) : RHIShader(info) {}
+};
+
+export class NullGraphicsPipeline final : public RHIGraphicsPipeline {
+public:
+    explicit NullGraphicsPipeline(const RHIGraphicsPipelineCreateInfo& info) : RHIGraphicsPipeline(info) {}
+};
+
+export class NullComputePipeline final : public RHIComputePipeline {
+public:
+    explicit NullComputePipeline(const RHIComputePipelineCreateInfo& info) : RHIComputePipeline(info) {}
+};
+
+// Timestamps read the CPU clock when they are recorded, every other query reads zero
+export class NullQueryPool final : public RHIQueryPool {
+public:
+    explicit NullQueryPool(const RHIQueryPoolCreateInfo& info)
+        : RHIQueryPool(info), m_Results(static_cast<size_t>(info.Count) * GetRHIQueryResultSize(info.Type)) {}
+
+    std::span<std::byte> GetResults() { return m_Results; }
+
+private:
+    std::vector<std::byte> m_Results;
+};
+
+// =================================================================================================
+// Null Synchronization
+// =================================================================================================
+
+// Every signal has happened by the time anyone looks, so waits return at once
+export class NullFence final : public RHIFence {
+public:
+    explicit NullFence(const RHIFenceCreateInfo& info)
+        : RHIFence(info), m_Value(info.Signaled ? std::max<uint64>(info.InitialValue, 1) : info.InitialValue) {}
+
+    bool Wait(uint64 timeout = std::numeric_limits<uint64>::max()) override { return true; }
+    void Reset() override { m_Value = 0; }
+
+    uint64 GetCompletedValue() const override { return m_Value; }
+    bool WaitForValue(uint64 value, uint64 timeout = std::numeric_limits<uint64>::max()) override {
+        return m_Value >= value;
+    }
+
+    void Signal(uint64 value) { m_Value = std::max(m_Value, value); }
+    void SignalNext() { ++m_Value; }
+
+private:
+    uint64 m_Value = 0;
+};
+
+export class NullSemaphore final : public RHISemaphore {};
+
+// =================================================================================================
+// Null Commands
+// =================================================================================================
+
+export class NullQueue final : public RHIQueue {
+public:
+    explicit NullQueue(const RHIQueueCreateInfo& info) : RHIQueue(info) {}
+
+    void WaitIdle() override {}
+
+    void Submit(const RHICommandList* commandList, RHIFence* fence = nullptr,
+                std::span<RHISemaphore*> waitSemaphores = {}, std::span<RHISemaphore*> signalSemaphores = {}) override;
+    void SubmitCommandLists(std::span<const RHICommandList*> commandLists, RHIFence* signalFence = nullptr) override;
+
+    void Signal(RHIFence* fence, uint64 value) override;
+    void Wait(RHIFence* fence, uint64 value) override {}
+
+    // The null GPU clock is the CPU clock in nanoseconds
+    RHITimestampCalibration CalibrateTimestamps() const override;
+
+    uint64 GetSubmittedListCount() const { return m_SubmittedListCount; }
+
+private:
+    std::atomic<uint64> m_SubmittedListCount = 0;
+};
+
+export class NullCommandPool final : public RHICommandPool {
+public:
+    explicit NullCommandPool(const RHICommandPoolCreateInfo& info) : RHICommandPool(info) {}
+
+    void Reset() override {}
+};
+
+// Discards every command but queries, replaying into it measures what the caller spends on the way there. The
+// counted commands keep their RHICommandList bodies, statistics match those of a real backend.
+export class NullCommandList final : public RHICommandList {
+public:
+    void Begin() override {}
+    void End() override {}
+
+    void BeginRenderPass(const RHIRenderPassBeginInfo& info) override {}
+    void EndRenderPass() override {}
+    void NextSubpass() override {}
+
+    void BindVertexBuffer(const RHIVertexBuffer* buffer, uint32 binding = 0, uint64 offset = 0) override {}
+    void BindIndexBuffer(const RHIIndexBuffer* buffer, uint64 offset = 0) override {}
+    void PushConstants(const RHIPipelineLayout* layout, Flags<RHIShaderStage> stageFlags, uint32 offset, uint32 size,
+                       const void* data) override {}
+
+    void SetViewport(const RHIViewport& viewport) override {}
+    void SetScissor(const RHIScissor& scissor) override {}
+    void SetLineWidth(float lineWidth) override {}
+    void SetDepthBias(float constantFactor, float clamp, float slopeFactor) override {}
+    void SetBlendConstants(const float blendConstants[4]) override {}
+    void SetDepthBounds(float minDepthBounds, float maxDepthBounds) override {}
+    void SetStencilCompareMask(bool front, bool back, uint32 compareMask) override {}
+    void SetStencilWriteMask(bool front, bool back, uint32 writeMask) override {}
+    void SetStencilReference(bool front, bool back, uint32 reference) override {}
+
+    void CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture) override {}
+    void CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture,
+                             const RHIBufferTextureCopy& region) override {}
+    void CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture,
+                             std::span<const RHIBufferTextureCopy> regions) override {}
+    void CopyTextureToBuffer(const RHITexture* srcTexture, const RHIBuffer* dstBuffer) override {}
+    void CopyBuffer(const RHIBuffer* srcBuffer, const RHIBuffer* dstBuffer, uint64 srcOffset, uint64 dstOffset,
+                    uint64 size) override {}
+    void BlitTexture(const RHITexture* srcTexture, const RHITexture* dstTexture,
+                     RHISamplerFilter filter = RHISamplerFilter::Linear) override {}
+
+    void ClearColorAttachment(uint32 attachmentIndex, const float color[4], const RHIRect2D& rect) override {}
+    void ClearDepthStencilAttachment(float depth, uint32 stencil, bool clearDepth, bool clearStencil,
+                                     const RHIRect2D& rect) override {}
+    void ClearTexture(const RHITexture* texture, const float color[4]) override {}
+    void ClearBuffer(const RHIBuffer* buffer, uint32 value, uint64 offset = 0, uint64 size = ~0ULL) override {}
+
+    void WriteTimestamp(const RHIQueryPool* pool, uint32 index) override;
+    void BeginQuery(const RHIQueryPool* pool, uint32 index) override {}
+    void EndQuery(const RHIQueryPool* pool, uint32 index) override {}
+    void ResolveQueries(const RHIQueryPool* pool, uint32 firstIndex, uint32 count, const RHIBuffer* dstBuffer,
+                        uint64 dstOffset = 0) override;
+
+    void BeginDebugLabel(const std::string& label, const float color[4] = nullptr) override {}
+    void EndDebugLabel() override {}
+    void InsertDebugLabel(const std::string& label, const float color[4] = nullptr) override {}
+
+    uint64 GetFilteredCommandCount() const override { return 0; }
+};
+
+// =================================================================================================
+// Null Presentation
+// =================================================================================================
+
+export class NullSurface final : public RHISurface {
+public:
+    explicit NullSurface(const RHISurfaceCreateInfo& info) : RHISurface(info) {}
+};
+
+export class NullSwapChain final : public RHISwapChain {
+public:
+    explicit NullSwapChain(const RHISwapChainCreateInfo& info);
+
+    uint32 AcquireNextImage(RHISemaphore* signalSemaphore = nullptr, RHIFence* signalFence = nullptr) override;
+    void Present(std::span<RHISemaphore* const> waitSemaphores = {}) override {}
+    void Resize(uint32 width, uint32 height) override;
+
+    RHITexture* GetBackBufferTexture(uint32 index) const override { return m_BackBuffers[index].get(); }
+    RHITextureView* GetBackBufferView(uint32 index) const override { return m_BackBufferViews[index].get(); }
+
+private:
+    void CreateBackBuffers();
+
+    std::vector<Scope<NullTexture>> m_BackBuffers;
+    std::vector<Scope<NullTextureView>> m_BackBufferViews;
+    uint32 m_CurrentImage = 0;
+};
+
+// =================================================================================================
+// NullRHI
+// =================================================================================================
+
+export class IGE_API NullRHI final : public RHI {
+public:
+    NullRHI();
+    ~NullRHI() override;
+
+    void WaitIdle() override {}
+
+    const RHIDeviceProperties& GetDeviceProperties() const override { return m_DeviceProperties; }
+    const RHIMemoryProperties& GetMemoryProperties() const override { return m_MemoryProperties; }
+    RHIFormatProperties GetFormatProperties(RHIFormat format) const override;
+
+    RHIQueue* GetQueue(RHIQueueType type, uint32 index = 0) override;
+    uint32 GetQueueCount(RHIQueueType type) const override { return 1; }
+
+    // Frames complete as soon as they end
+    void BeginFrame() override;
+    void EndFrame(RHIQueue* pQueue) override;
+    uint64 GetFrameSerial() const override { return m_FrameSerial; }
+    uint64 GetCompletedFrameSerial() const override { return m_FrameSerial - 1; }
+    RHIConstantAllocator* GetConstantAllocator() override { return m_ConstantAllocator.get(); }
+    RHIMemoryStats GetMemoryStats() const override { return {}; }
+    RHIDefragmentationResult DefragmentMemory(RHICommandList* pCommandList,
+                                              const RHIDefragmentationLimits& limits = {}) override {
+        return {};
+    }
+
+    Scope<RHISurface> CreateSurface(const RHISurfaceCreateInfo& info) override;
+    Scope<RHISwapChain> CreateSwapChain(const RHISwapChainCreateInfo& info) override;
+
+    Scope<RHICommandPool> CreateCommandPool(const RHICommandPoolCreateInfo& info) override;
+    RHICommandListManager* GetCommandListManager(RHIQueueType type) override;
+    Scope<RHICommandList> AllocateCommandList(RHICommandPool* pPool) override;
+    std::vector<Scope<RHICommandList>> AllocateCommandLists(RHICommandPool* pPool, uint32 count) override;
+    void FreeCommandList(RHICommandPool* pPool, RHICommandList* pCommandList) override {}
+    void FreeCommandLists(RHICommandPool* pPool, std::span<RHICommandList*> commandLists) override {}
+
+    Scope<RHIBuffer> CreateBuffer(const RHIBufferCreateInfo& info) override;
+    Scope<RHIVertexBuffer> CreateVertexBuffer(const RHIVertexBufferCreateInfo& info) override;
+    Scope<RHIIndexBuffer> CreateIndexBuffer(const RHIIndexBufferCreateInfo& info) override;
+    Scope<RHIUniformBuffer> CreateUniformBuffer(const RHIUniformBufferCreateInfo& info) override;
+    Scope<RHIStorageBuffer> CreateStorageBuffer(const RHIStorageBufferCreateInfo& info) override;
+
+    Scope<RHITexture> CreateTexture(const RHITextureCreateInfo& info) override;
+    Scope<RHITextureView> CreateTextureView(const RHITexture* pTexture, const RHITextureViewCreateInfo& info) override;
+    Scope<RHISampler> CreateSampler(const RHISamplerCreateInfo& info) override;
+
+    Scope<RHIDescriptorSetLayout> CreateDescriptorSetLayout(const RHIDescriptorSetLayoutCreateInfo& info) override;
+    Scope<RHIDescriptorPool> CreateDescriptorPool(const RHIDescriptorPoolCreateInfo& info) override;
+    void CopyDescriptorSets(std::span<const RHICopyDescriptorSet> copies) override {}
+    Scope<RHIDescriptorUpdateTemplate>
+    CreateDescriptorUpdateTemplate(const RHIDescriptorUpdateTemplateCreateInfo& info) override;
+
+    Scope<RHIPipelineLayout> CreatePipelineLayout(const RHIPipelineLayoutCreateInfo& info) override;
+    Scope<RHIRenderPass> CreateRenderPass(const RHIRenderPassCreateInfo& info) override;
+    Scope<RHIFramebuffer> CreateFramebuffer(const RHIFramebufferCreateInfo& info) override;
+    Scope<RHIShader> CreateShader(const RHIShaderCreateInfo& info) override;
+    Scope<RHIGraphicsPipeline> CreateGraphicsPipeline(const RHIGraphicsPipelineCreateInfo& info) override;
+    Scope<RHIComputePipeline> CreateComputePipeline(const RHIComputePipelineCreateInfo& info) override;
+
+    Scope<RHIQueryPool> CreateQueryPool(const RHIQueryPoolCreateInfo& info) override;
+
+    Scope<RHIFence> CreateGPUFence(const RHIFenceCreateInfo& info) override;
+    Scope<RHISemaphore> CreateGPUSemaphore() override;
+    bool WaitForFences(std::span<RHIFence* const> fences, bool waitAll = true,
+                       uint64 timeout = std::numeric_limits<uint64>::max()) override {
+        return true;
+    }
+    void ResetFences(std::span<RHIFence* const> fences) override;
+
+    // Nothing is in flight, resources go at once
+    void DestroyResource(RHIResource* pResource) override { delete pResource; }
+
+private:
+    RHIDeviceProperties m_DeviceProperties;
+    RHIMemoryProperties m_MemoryProperties;
+
+    std::array<Scope<NullQueue>, static_cast<size_t>(RHIQueueType::Count)> m_Queues;
+    std::array<Scope<RHICommandListManager>, static_cast<size_t>(RHIQueueType::Count)> m_CommandListManagers;
+    Scope<RHIConstantAllocator> m_ConstantAllocator;
+
+    uint64 m_FrameSerial = 1;
+};
+
+} // namespace iGe
@@ -0,0 +1,34 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.RHI:RHIBackend;
+import :RHICommandList;
+#if defined(IGE_RHI_STATIC_BACKEND)
+import :DirectX12CommandList;
+#endif
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Backend Selection
+// =================================================================================================
+
+// Command list type hot recording code should be written against. Builds with IGE_RHI_STATIC_BACKEND know the
+// only backend at compile time, the alias then names its final command list and every call on it is a direct,
+// inlinable call instead of a virtual one. Multi-backend builds keep dispatching through RHICommandList.
+#if defined(IGE_RHI_STATIC_BACKEND)
+export using RHIBackendCommandList = DirectX12CommandList;
+#else
+export using RHIBackendCommandList = RHICommandList;
+#endif
+
+export constexpr bool IsRHIBackendStatic = !std::is_same_v<RHIBackendCommandList, RHICommandList>;
+
+// Every command list the RHI hands out is of the backend type, the cast is free in both modes
+export inline RHIBackendCommandList& AsBackend(RHICommandList& commandList) {
+    return static_cast<RHIBackendCommandList&>(commandList);
+}
+
+} // namespace iGe
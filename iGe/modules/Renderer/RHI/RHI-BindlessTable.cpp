@@ -0,0 +1,114 @@
+module iGe.RHI;
+import :RHI;
+import :RHIBindlessTable;
+
+namespace iGe
+{
+
+RHIBindlessTable::RHIBindlessTable(const RHIBindlessTableCreateInfo& info)
+    : m_TextureIndices(info.MaxTextures), m_BufferIndices(info.MaxBuffers), m_SamplerIndices(info.MaxSamplers) {
+    auto* rhi = RHI::Get();
+
+    // Every slot may stay empty, the shader only touches the indices it is handed
+    const auto bindlessFlags = RHIDescriptorBindingFlagBits::PartiallyBound |
+                               RHIDescriptorBindingFlagBits::VariableDescriptorCount |
+                               RHIDescriptorBindingFlagBits::UpdateAfterBind;
+
+    const std::array<RHIDescriptorSetLayoutBinding, 3> bindings = {{
+            {TextureBinding, RHIDescriptorType::SampledImage, info.MaxTextures, RHIShaderStage::Vertex, bindlessFlags},
+            {BufferBinding, RHIDescriptorType::StorageBuffer, info.MaxBuffers, RHIShaderStage::Vertex, bindlessFlags},
+            {SamplerBinding, RHIDescriptorType::Sampler, info.MaxSamplers, RHIShaderStage::Vertex, bindlessFlags},
+    }};
+
+    RHIDescriptorSetLayoutCreateInfo layoutInfo;
+    layoutInfo.Bindings = bindings;
+    layoutInfo.UpdateAfterBindPool = true;
+    m_Layout = rhi->CreateDescriptorSetLayout(layoutInfo);
+
+    const std::array<RHIDescriptorPoolSize, 3> poolSizes = {{
+            {RHIDescriptorType::SampledImage, info.MaxTextures},
+            {RHIDescriptorType::StorageBuffer, info.MaxBuffers},
+            {RHIDescriptorType::Sampler, info.MaxSamplers},
+    }};
+
+    RHIDescriptorPoolCreateInfo poolInfo;
+    poolInfo.MaxSets = 1;
+    poolInfo.PoolSizes = poolSizes;
+    poolInfo.UpdateAfterBind = true;
+    m_Pool = rhi->CreateDescriptorPool(poolInfo);
+
+    m_Set = m_Pool->AllocateDescriptorSet(m_Layout.get());
+}
+
+RHIBindlessTable::~RHIBindlessTable() = default;
+
+uint32 RHIBindlessTable::RegisterTexture(const RHITextureView* pTextureView) {
+    const uint32 index = AllocateIndex(m_TextureIndices, "texture");
+    if (index == InvalidIndex) { return InvalidIndex; }
+
+    RHIDescriptorImageInfo imageInfo;
+    imageInfo.pTextureView = pTextureView;
+    Write(TextureBinding, index, RHIDescriptorType::SampledImage, nullptr, &imageInfo);
+    return index;
+}
+
+uint32 RHIBindlessTable::RegisterBuffer(const RHIBuffer* pBuffer, uint64 offset, uint64 range) {
+    const uint32 index = AllocateIndex(m_BufferIndices, "buffer");
+    if (index == InvalidIndex) { return InvalidIndex; }
+
+    RHIDescriptorBufferInfo bufferInfo;
+    bufferInfo.pBuffer = pBuffer;
+    bufferInfo.Offset = offset;
+    bufferInfo.Range = range;
+    Write(BufferBinding, index, RHIDescriptorType::StorageBuffer, &bufferInfo, nullptr);
+    return index;
+}
+
+uint32 RHIBindlessTable::RegisterSampler(const RHISampler* pSampler) {
+    const uint32 index = AllocateIndex(m_SamplerIndices, "sampler");
+    if (index == InvalidIndex) { return InvalidIndex; }
+
+    RHIDescriptorImageInfo imageInfo;
+    imageInfo.pSampler = pSampler;
+    Write(SamplerBinding, index, RHIDescriptorType::Sampler, nullptr, &imageInfo);
+    return index;
+}
+
+void RHIBindlessTable::UnregisterTexture(uint32 index) { m_TextureIndices.Free(index, RHI::Get()->GetFrameSerial()); }
+
+void RHIBindlessTable::UnregisterBuffer(uint32 index) { m_BufferIndices.Free(index, RHI::Get()->GetFrameSerial()); }
+
+void RHIBindlessTable::UnregisterSampler(uint32 index) { m_SamplerIndices.Free(index, RHI::Get()->GetFrameSerial()); }
+
+void RHIBindlessTable::Bind(RHICommandList* pCommandList, const RHIPipelineLayout* pPipelineLayout,
+                            uint32 setIndex) const {
+    pCommandList->BindDescriptorSet(pPipelineLayout, setIndex, m_Set.get());
+}
+
+uint32 RHIBindlessTable::AllocateIndex(RHIDeferredIndexAllocator& indices, const char* kind) {
+    // Registration is rare next to draws, so retiring here keeps the table free of a per-frame hook
+    indices.Retire(RHI::Get()->GetCompletedFrameSerial());
+
+    const uint32 index = indices.Allocate();
+    if (index == InvalidIndex) {
+        Internal::LogError("RHIBindlessTable: No free {0} slot ({1} waiting for their frame to retire)", kind,
+                           indices.GetPendingCount());
+    }
+    return index;
+}
+
+void RHIBindlessTable::Write(uint32 binding, uint32 index, RHIDescriptorType type,
+                             const RHIDescriptorBufferInfo* pBufferInfo, const RHIDescriptorImageInfo* pImageInfo) {
+    RHIWriteDescriptorSet write;
+    write.pDstSet = m_Set.get();
+    write.DstBinding = binding;
+    write.DstArrayElement = index;
+    write.DescriptorCount = 1;
+    write.DescriptorType = type;
+    write.pBufferInfos = pBufferInfo;
+    write.pImageInfos = pImageInfo;
+
+    RHI::Get()->UpdateDescriptorSets({&write, 1});
+}
+
+} // namespace iGe
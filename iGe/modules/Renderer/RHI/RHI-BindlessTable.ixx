@@ -0,0 +1,85 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.RHI:RHIBindlessTable;
+import :RHIDescriptor;
+import :RHIRangeAllocator;
+import :RHICommandList;
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Bindless Table
+// =================================================================================================
+//
+// One global descriptor set holding every registered texture, buffer and sampler. Resources are registered
+// once and handed out as 32-bit indices; a pipeline layout includes GetLayout() as one of its sets, the set
+// is bound once per command list and each draw passes its indices through push constants.
+//
+// Shader side (set N maps to register space N on D3D12):
+//     Texture2D           g_Textures[] : register(t0, spaceN);
+//     RWByteAddressBuffer g_Buffers[]  : register(u0, spaceN);
+//     SamplerState        g_Samplers[] : register(s0, spaceN);
+//
+// The table lives in its own descriptor heap on D3D12, so other descriptor sets bound in the same draw must
+// come from that heap as well; in practice everything else goes through push constants.
+//
+
+export struct RHIBindlessTableCreateInfo {
+    uint32 MaxTextures = 16384;
+    uint32 MaxBuffers = 16384;
+    uint32 MaxSamplers = 256; // Shader-visible sampler heaps hold at most 2048 on D3D12
+};
+
+export class IGE_API RHIBindlessTable {
+public:
+    static constexpr uint32 InvalidIndex = RHIDeferredIndexAllocator::InvalidIndex;
+
+    // Binding numbers within GetLayout()
+    static constexpr uint32 TextureBinding = 0;
+    static constexpr uint32 BufferBinding = 1;
+    static constexpr uint32 SamplerBinding = 2;
+
+    explicit RHIBindlessTable(const RHIBindlessTableCreateInfo& info = {});
+    ~RHIBindlessTable();
+
+    RHIBindlessTable(const RHIBindlessTable&) = delete;
+    RHIBindlessTable& operator=(const RHIBindlessTable&) = delete;
+
+    // Thread-safe, return InvalidIndex when the table is full
+    uint32 RegisterTexture(const RHITextureView* pTextureView);
+    uint32 RegisterBuffer(const RHIBuffer* pBuffer, uint64 offset = 0, uint64 range = ~0ULL);
+    uint32 RegisterSampler(const RHISampler* pSampler);
+
+    // Indices are reused only after every frame recorded up to now has completed on the GPU
+    void UnregisterTexture(uint32 index);
+    void UnregisterBuffer(uint32 index);
+    void UnregisterSampler(uint32 index);
+
+    // Binds the table to setIndex of a pipeline layout that was created with GetLayout() at that index
+    void Bind(RHICommandList* pCommandList, const RHIPipelineLayout* pPipelineLayout, uint32 setIndex) const;
+
+    const RHIDescriptorSetLayout* GetLayout() const { return m_Layout.get(); }
+    const RHIDescriptorSet* GetDescriptorSet() const { return m_Set.get(); }
+
+    uint32 GetFreeTextureCount() const { return m_TextureIndices.GetFreeCount(); }
+    uint32 GetFreeBufferCount() const { return m_BufferIndices.GetFreeCount(); }
+    uint32 GetFreeSamplerCount() const { return m_SamplerIndices.GetFreeCount(); }
+
+private:
+    uint32 AllocateIndex(RHIDeferredIndexAllocator& indices, const char* kind);
+    void Write(uint32 binding, uint32 index, RHIDescriptorType type, const RHIDescriptorBufferInfo* pBufferInfo,
+               const RHIDescriptorImageInfo* pImageInfo);
+
+    Scope<RHIDescriptorSetLayout> m_Layout;
+    Scope<RHIDescriptorPool> m_Pool;
+    Scope<RHIDescriptorSet> m_Set;
+
+    RHIDeferredIndexAllocator m_TextureIndices;
+    RHIDeferredIndexAllocator m_BufferIndices;
+    RHIDeferredIndexAllocator m_SamplerIndices;
+};
+
+} // namespace iGe
@@ -1,5 +1,7 @@
 module iGe.RHI;
 import :RHIBuffer;
+import :RHILint;
+import :RHIStatistics;
 
 namespace iGe
 {
@@ -36,6 +38,27 @@ uint32 UBElementTypeSize(UBElementType type) {
     return 0;
 }
 
+// =================================================================================================
+// RHIBuffer
+// =================================================================================================
+
+void* RHIBuffer::Map() {
+    RHILintHostWrite(this);
+    const bool wasMapped = IsMapped();
+    void* mapped = MapMemory();
+    // Writes through the mapping are invisible, a new mapping counts the whole buffer
+    if (mapped && !wasMapped && m_MemoryUsage != RHIMemoryUsage::GpuToCpu) {
+        RHIStatistics::Add(RHIStatistic::UploadBytes, m_Size);
+    }
+    return mapped;
+}
+
+void RHIBuffer::Update(uint64 offset, uint64 size, const void* data) {
+    if (!data || size == 0) { return; }
+    RHILintHostWrite(this);
+    RHIStatistics::Add(RHIStatistic::UploadBytes, UpdateMemory(offset, size, data));
+}
+
 // =================================================================================================
 // UBElement
 // =================================================================================================
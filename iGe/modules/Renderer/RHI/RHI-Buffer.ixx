@@ -23,9 +23,12 @@ export struct RHIBufferCreateInfo {
     uint64 Size;
     Flags<RHIBufferUsageBit> Usage;
     RHIMemoryUsage MemoryUsage;
+    // GpuOnly memory may be moved by RHI::DefragmentMemory. Descriptors written from a moved resource must be
+    // written again, views and vertex/index bindings follow it on their own
+    bool Relocatable = false;
 };
 
-export class RHIBuffer : public RHIResource {
+export class IGE_API RHIBuffer : public RHIResource {
 public:
     ~RHIBuffer() override = default;
 
@@ -34,12 +37,12 @@ public:
     Flags<RHIBufferUsageBit> GetUsage() const { return m_Usage; }
 
     // ==========================================================================
-    // Buffer Operations (implemented by derived classes)
+    // Buffer Operations
     // ==========================================================================
 
     // Map buffer memory for CPU access
     // Returns nullptr if mapping fails or buffer is not host-visible
-    virtual void* Map() = 0;
+    void* Map();
 
     // Unmap previously mapped buffer memory
     virtual void Unmap() = 0;
@@ -49,7 +52,7 @@ public:
 
     // Update buffer data (handles mapping internally if needed)
     // For non-host-visible buffers, this may use staging buffers
-    virtual void Update(uint64 offset, uint64 size, const void* data) = 0;
+    void Update(uint64 offset, uint64 size, const void* data);
 
     // Convenience template for updating entire buffer
     template<typename T>
@@ -74,6 +77,11 @@ protected:
         : RHIResource(RHIResourceType::Buffer), m_Size(info.Size), m_Usage(info.Usage),
           m_MemoryUsage(info.MemoryUsage) {}
 
+    // Backend half of Map and Update, which lint and count the upload for every backend. UpdateMemory returns
+    // the bytes it wrote
+    virtual void* MapMemory() = 0;
+    virtual uint64 UpdateMemory(uint64 offset, uint64 size, const void* data) = 0;
+
     uint64 m_Size;
     Flags<RHIBufferUsageBit> m_Usage;
     RHIMemoryUsage m_MemoryUsage;
@@ -87,6 +95,7 @@ export struct RHIVertexBufferCreateInfo {
     uint64 Size;
     uint64 Stride;
     RHIMemoryUsage MemoryUsage = RHIMemoryUsage::CpuToGpu;
+    bool Relocatable = false; // See RHIBufferCreateInfo
 };
 
 export class IGE_API RHIVertexBuffer : public RHIBuffer {
@@ -114,6 +123,7 @@ export struct RHIIndexBufferCreateInfo {
     uint64 Size;
     RHIIndexFormat Format = RHIIndexFormat::Uint32;
     RHIMemoryUsage MemoryUsage = RHIMemoryUsage::CpuToGpu;
+    bool Relocatable = false; // See RHIBufferCreateInfo
 };
 
 export class IGE_API RHIIndexBuffer : public RHIBuffer {
@@ -210,6 +220,7 @@ export struct RHIStorageBufferCreateInfo {
     RHIMemoryUsage MemoryUsage = RHIMemoryUsage::GpuOnly;
     bool AllowRead = true;
     bool AllowWrite = true;
+    bool Relocatable = false; // See RHIBufferCreateInfo
 };
 
 export class IGE_API RHIStorageBuffer : public RHIBuffer {
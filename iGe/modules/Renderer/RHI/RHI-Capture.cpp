@@ -0,0 +1,921 @@
+module iGe.RHI;
+import :RHICapture;
+
+namespace iGe
+{
+
+static_assert(sizeof(RHICaptureRecordHeader) == RHICommandStream::PacketAlignment);
+
+std::string_view GetRHICaptureOpcodeName(RHICaptureOpcode opcode) {
+    static constexpr std::array<std::string_view, static_cast<size_t>(RHICaptureOpcode::Count)> s_Names = {
+            "Invalid",
+            "CreateBuffer",
+            "CreateVertexBuffer",
+            "CreateIndexBuffer",
+            "CreateUniformBuffer",
+            "CreateStorageBuffer",
+            "CreateTexture",
+            "CreateTextureView",
+            "CreateSampler",
+            "CreateDescriptorSetLayout",
+            "CreateDescriptorPool",
+            "CreateDescriptorUpdateTemplate",
+            "CreatePipelineLayout",
+            "CreateRenderPass",
+            "CreateFramebuffer",
+            "CreateShader",
+            "CreateGraphicsPipeline",
+            "CreateComputePipeline",
+            "RegisterConstantBuffer",
+            "DestroyResource",
+            "AllocateDescriptorSet",
+            "FreeDescriptorSet",
+            "ResetDescriptorPool",
+            "UpdateDescriptorSets",
+            "CopyDescriptorSets",
+            "UpdateDescriptorSetWithTemplate",
+            "BeginFrame",
+            "EndFrame",
+            "Submit",
+            "CreateQueryPool",
+    };
+
+    const auto index = static_cast<size_t>(opcode);
+    return index < s_Names.size() ? s_Names[index] : "Unknown";
+}
+
+namespace
+{
+
+enum class DescriptorInfoKind : uint8 { None = 0, Buffer, Image, Count };
+
+// Smallest encodings, they bound the element counts a payload can claim
+constexpr uint64 MinWriteSize = sizeof(RHICommandHandle) + 4 * sizeof(uint32) + sizeof(DescriptorInfoKind);
+constexpr uint64 MinBufferInfoSize = sizeof(RHICommandHandle) + 2 * sizeof(uint64);
+constexpr uint64 MinImageInfoSize = 2 * sizeof(RHICommandHandle) + sizeof(RHILayout);
+constexpr uint64 MinCopySize = 2 * sizeof(RHICommandHandle) + 5 * sizeof(uint32);
+constexpr uint64 MinSubpassSize = 5 * sizeof(uint32);
+
+} // namespace
+
+// =================================================================================================
+// RHICaptureRecordWriter
+// =================================================================================================
+
+RHICaptureRecordWriter::RHICaptureRecordWriter(std::vector<std::byte>& data, RHICaptureOpcode opcode)
+    : m_Data(data), m_Start(data.size()) {
+    RHICaptureRecordHeader header;
+    header.Opcode = opcode;
+    Write(header);
+}
+
+RHICaptureRecordWriter::~RHICaptureRecordWriter() {
+    // Padding is zeroed so captures are deterministic
+    m_Data.resize(AlignUp(m_Data.size(), RHICommandStream::PacketAlignment), std::byte{0});
+
+    RHICaptureRecordHeader header;
+    std::memcpy(&header, m_Data.data() + m_Start, sizeof(header));
+    header.Size = static_cast<uint32>(m_Data.size() - m_Start);
+    std::memcpy(m_Data.data() + m_Start, &header, sizeof(header));
+}
+
+void RHICaptureRecordWriter::WriteBytes(const void* data, uint64 size) {
+    if (size == 0) { return; }
+    const auto* bytes = static_cast<const std::byte*>(data);
+    m_Data.insert(m_Data.end(), bytes, bytes + size);
+}
+
+void RHICaptureRecordWriter::WriteString(std::string_view string) {
+    Write(static_cast<uint32>(string.size()));
+    WriteBytes(string.data(), string.size());
+}
+
+void RHICaptureRecordWriter::WriteStream(const RHICommandStream& stream) {
+    Write(stream.GetSize());
+    stream.Serialize(m_Data);
+}
+
+void RHICaptureRecordWriter::WriteInfo(const RHITextureCreateInfo& info) {
+    // Field by field, the padding after Relocatable is never initialized. The initial data follows the info
+    // instead of being pointed to
+    Write(info.Type);
+    Write(info.Format);
+    Write(info.Extent);
+    Write(info.MipLevels);
+    Write(info.ArrayLayers);
+    Write(info.Samples);
+    Write(info.Usage);
+    Write(info.MemoryUsage);
+    Write(info.Relocatable);
+
+    const uint64 dataSize = info.pInitialData ? info.InitialDataSize : 0;
+    Write(dataSize);
+    WriteBytes(info.pInitialData, dataSize);
+}
+
+void RHICaptureRecordWriter::WriteInfo(const RHIDescriptorSetLayoutCreateInfo& info) {
+    WriteArray(info.Bindings);
+    Write(info.UpdateAfterBindPool);
+}
+
+void RHICaptureRecordWriter::WriteInfo(const RHIDescriptorPoolCreateInfo& info) {
+    Write(info.MaxSets);
+    WriteArray(info.PoolSizes);
+    Write(info.AllowFreeDescriptorSet);
+    Write(info.UpdateAfterBind);
+}
+
+void RHICaptureRecordWriter::WriteInfo(const RHIDescriptorUpdateTemplateCreateInfo& info) {
+    WriteHandle(info.pSetLayout);
+    WriteArray(info.Entries);
+}
+
+void RHICaptureRecordWriter::WriteInfo(const RHIPipelineLayoutCreateInfo& info) {
+    WriteHandles(info.SetLayouts);
+    WriteArray(info.PushConstantRanges);
+}
+
+void RHICaptureRecordWriter::WriteInfo(const RHIRenderPassCreateInfo& info) {
+    WriteArray(info.Attachments);
+
+    Write(static_cast<uint32>(info.Subpasses.size()));
+    for (const RHISubpassDescription& subpass: info.Subpasses) {
+        WriteArray(subpass.InputAttachments);
+        WriteArray(subpass.ColorAttachments);
+        WriteArray(subpass.ResolveAttachments);
+        Write(subpass.DepthStencilAttachment);
+        WriteArray(subpass.PreserveAttachments);
+    }
+
+    WriteArray(info.Dependencies);
+}
+
+void RHICaptureRecordWriter::WriteInfo(const RHIFramebufferCreateInfo& info) {
+    WriteHandle(info.pRenderPass);
+    WriteHandles(info.Attachments);
+    Write(info.Width);
+    Write(info.Height);
+    Write(info.Layers);
+}
+
+void RHICaptureRecordWriter::WriteInfo(const RHIShaderCreateInfo& info) {
+    Write(info.Stage);
+    WriteString(info.EntryPoint);
+    WriteString(info.SourceCode);
+}
+
+void RHICaptureRecordWriter::WriteInfo(const RHIGraphicsPipelineCreateInfo& info) {
+    WriteHandle(info.pVertexShader);
+    WriteHandle(info.pFragmentShader);
+    WriteHandle(info.pGeometryShader);
+    WriteHandle(info.pTessControlShader);
+    WriteHandle(info.pTessEvaluationShader);
+
+    WriteArray(info.VertexInputState.VertexBindingDescriptions);
+    WriteArray(info.VertexInputState.VertexAttributeDescriptions);
+    Write(info.InputAssemblyState);
+    Write(info.TessellationState);
+    WriteArray(info.ViewportState.Viewports);
+    WriteArray(info.ViewportState.Scissors);
+    Write(info.ViewportState.ViewportCount);
+    Write(info.ViewportState.ScissorCount);
+    Write(info.RasterizationState);
+    Write(info.MultisampleState);
+    Write(info.DepthStencilState);
+    Write(info.ColorBlendState.LogicOpEnable);
+    Write(info.ColorBlendState.LogicOp);
+    WriteArray(info.ColorBlendState.Attachments);
+    for (float constant: info.ColorBlendState.BlendConstants) { Write(constant); }
+    WriteArray(info.DynamicState.DynamicStates);
+
+    WriteHandle(info.pLayout);
+    WriteHandle(info.pRenderPass);
+    Write(info.SubpassIndex);
+    WriteHandle(info.pBasePipeline);
+    Write(info.BasePipelineIndex);
+}
+
+void RHICaptureRecordWriter::WriteInfo(const RHIComputePipelineCreateInfo& info) {
+    WriteHandle(info.pComputeShader);
+    WriteHandle(info.pLayout);
+    WriteSpecialization(info.SpecializationInfo);
+    WriteHandle(info.pBasePipeline);
+    Write(info.BasePipelineIndex);
+}
+
+void RHICaptureRecordWriter::WriteWrites(std::span<const RHIWriteDescriptorSet> writes) {
+    Write(static_cast<uint32>(writes.size()));
+    for (const RHIWriteDescriptorSet& write: writes) {
+        WriteHandle(write.pDstSet);
+        Write(write.DstBinding);
+        Write(write.DstArrayElement);
+        Write(write.DescriptorCount);
+        Write(write.DescriptorType);
+
+        if (write.pBufferInfos) {
+            Write(DescriptorInfoKind::Buffer);
+            for (uint32 i = 0; i < write.DescriptorCount; ++i) {
+                WriteHandle(write.pBufferInfos[i].pBuffer);
+                Write(write.pBufferInfos[i].Offset);
+                Write(write.pBufferInfos[i].Range);
+            }
+        } else if (write.pImageInfos) {
+            Write(DescriptorInfoKind::Image);
+            for (uint32 i = 0; i < write.DescriptorCount; ++i) {
+                WriteHandle(write.pImageInfos[i].pSampler);
+                WriteHandle(write.pImageInfos[i].pTextureView);
+                Write(write.pImageInfos[i].ImageLayout);
+            }
+        } else {
+            Write(DescriptorInfoKind::None);
+        }
+    }
+}
+
+void RHICaptureRecordWriter::WriteCopies(std::span<const RHICopyDescriptorSet> copies) {
+    Write(static_cast<uint32>(copies.size()));
+    for (const RHICopyDescriptorSet& copy: copies) {
+        WriteHandle(copy.pSrcSet);
+        Write(copy.SrcBinding);
+        Write(copy.SrcArrayElement);
+        WriteHandle(copy.pDstSet);
+        Write(copy.DstBinding);
+        Write(copy.DstArrayElement);
+        Write(copy.DescriptorCount);
+    }
+}
+
+void RHICaptureRecordWriter::WriteSpecialization(const RHISpecializationInfo& info) {
+    WriteArray(info.MapEntries);
+    WriteArray(info.Data);
+}
+
+// =================================================================================================
+// RHICaptureReader
+// =================================================================================================
+
+std::string RHICaptureReader::ReadString() {
+    const uint32 length = Read<uint32>();
+    const std::span<const std::byte> chars = ReadBytes(length);
+    return std::string(reinterpret_cast<const char*>(chars.data()), chars.size());
+}
+
+bool RHICaptureReader::ReadStream(RHICommandStream& stream) {
+    const uint64 size = Read<uint64>();
+    const std::span<const std::byte> bytes = ReadBytes(size);
+    return !IsOverrun() && stream.Deserialize(bytes);
+}
+
+bool RHICaptureReader::ReadInfo(RHITextureCreateInfo& info) {
+    info.Type = Read<RHITextureType>();
+    info.Format = Read<RHIFormat>();
+    info.Extent = Read<RHIExtent3D>();
+    info.MipLevels = Read<uint32>();
+    info.ArrayLayers = Read<uint32>();
+    info.Samples = Read<RHISampleCountFlagBits>();
+    info.Usage = Read<Flags<RHITextureUsageFlagBits>>();
+    info.MemoryUsage = Read<RHIMemoryUsage>();
+    info.Relocatable = Read<bool>();
+
+    // Points into the payload, which outlives the reader
+    const uint64 dataSize = Read<uint64>();
+    const std::span<const std::byte> data = ReadBytes(dataSize);
+    info.pInitialData = dataSize > 0 ? data.data() : nullptr;
+    info.InitialDataSize = data.size();
+    return !IsOverrun();
+}
+
+bool RHICaptureReader::ReadInfo(RHIDescriptorSetLayoutCreateInfo& info) {
+    info.Bindings = ReadArray<RHIDescriptorSetLayoutBinding>();
+    info.UpdateAfterBindPool = Read<bool>();
+    return !IsOverrun();
+}
+
+bool RHICaptureReader::ReadInfo(RHIDescriptorPoolCreateInfo& info) {
+    info.MaxSets = Read<uint32>();
+    info.PoolSizes = ReadArray<RHIDescriptorPoolSize>();
+    info.AllowFreeDescriptorSet = Read<bool>();
+    info.UpdateAfterBind = Read<bool>();
+    return !IsOverrun();
+}
+
+bool RHICaptureReader::ReadInfo(RHIDescriptorUpdateTemplateCreateInfo& info) {
+    info.pSetLayout = ReadObject<const RHIDescriptorSetLayout>();
+    info.Entries = ReadArray<RHIDescriptorUpdateTemplateEntry>();
+    return !IsOverrun();
+}
+
+bool RHICaptureReader::ReadInfo(RHIPipelineLayoutCreateInfo& info) {
+    info.SetLayouts = ReadObjects<RHIDescriptorSetLayout>();
+    info.PushConstantRanges = ReadArray<RHIPushConstantRange>();
+    return !IsOverrun();
+}
+
+bool RHICaptureReader::ReadInfo(RHIRenderPassCreateInfo& info) {
+    info.Attachments = ReadArray<RHIAttachmentDescription>();
+
+    const uint32 subpassCount = Read<uint32>();
+    if (subpassCount > GetRemainingSize() / MinSubpassSize) { return false; }
+
+    auto& subpasses = Store<RHISubpassDescription>(subpassCount);
+    for (RHISubpassDescription& subpass: subpasses) {
+        subpass.InputAttachments = ReadArray<uint32>();
+        subpass.ColorAttachments = ReadArray<uint32>();
+        subpass.ResolveAttachments = ReadArray<uint32>();
+        subpass.DepthStencilAttachment = Read<uint32>();
+        subpass.PreserveAttachments = ReadArray<uint32>();
+    }
+    info.Subpasses = subpasses;
+
+    info.Dependencies = ReadArray<RHISubpassDependency>();
+    return !IsOverrun();
+}
+
+bool RHICaptureReader::ReadInfo(RHIFramebufferCreateInfo& info) {
+    info.pRenderPass = ReadObject<const RHIRenderPass>();
+    info.Attachments = ReadObjects<RHITextureView>();
+    info.Width = Read<uint32>();
+    info.Height = Read<uint32>();
+    info.Layers = Read<uint32>();
+    return !IsOverrun();
+}
+
+bool RHICaptureReader::ReadInfo(RHIShaderCreateInfo& info) {
+    info.Stage = Read<RHIShaderStage>();
+    info.EntryPoint = ReadString();
+    info.SourceCode = ReadString();
+    return !IsOverrun() && info.Stage < RHIShaderStage::Count;
+}
+
+bool RHICaptureReader::ReadInfo(RHIGraphicsPipelineCreateInfo& info) {
+    info.pVertexShader = ReadObject<const RHIShader>();
+    info.pFragmentShader = ReadObject<const RHIShader>();
+    info.pGeometryShader = ReadObject<const RHIShader>();
+    info.pTessControlShader = ReadObject<const RHIShader>();
+    info.pTessEvaluationShader = ReadObject<const RHIShader>();
+
+    info.VertexInputState.VertexBindingDescriptions = ReadArray<RHIVertexInputBindingDescription>();
+    info.VertexInputState.VertexAttributeDescriptions = ReadArray<RHIVertexInputAttributeDescription>();
+    info.InputAssemblyState = Read<RHIPipelineInputAssemblyState>();
+    info.TessellationState = Read<RHIPipelineTessellationState>();
+    info.ViewportState.Viewports = ReadArray<RHIViewport>();
+    info.ViewportState.Scissors = ReadArray<RHIRect2D>();
+    info.ViewportState.ViewportCount = Read<uint32>();
+    info.ViewportState.ScissorCount = Read<uint32>();
+    info.RasterizationState = Read<RHIPipelineRasterizationState>();
+    info.MultisampleState = Read<RHIPipelineMultisampleState>();
+    info.DepthStencilState = Read<RHIPipelineDepthStencilState>();
+    info.ColorBlendState.LogicOpEnable = Read<bool>();
+    info.ColorBlendState.LogicOp = Read<RHILogicOp>();
+    info.ColorBlendState.Attachments = ReadArray<RHIPipelineColorBlendAttachmentState>();
+    for (float& constant: info.ColorBlendState.BlendConstants) { constant = Read<float>(); }
+    info.DynamicState.DynamicStates = ReadArray<RHIDynamicState>();
+
+    info.pLayout = ReadObject<const RHIPipelineLayout>();
+    info.pRenderPass = ReadObject<const RHIRenderPass>();
+    info.SubpassIndex = Read<uint32>();
+    info.pBasePipeline = ReadObject<const RHIGraphicsPipeline>();
+    info.BasePipelineIndex = Read<int32>();
+    return !IsOverrun();
+}
+
+bool RHICaptureReader::ReadInfo(RHIComputePipelineCreateInfo& info) {
+    info.pComputeShader = ReadObject<const RHIShader>();
+    info.pLayout = ReadObject<const RHIPipelineLayout>();
+    info.SpecializationInfo = ReadSpecialization();
+    info.pBasePipeline = ReadObject<const RHIComputePipeline>();
+    info.BasePipelineIndex = Read<int32>();
+    return !IsOverrun();
+}
+
+std::span<const RHIWriteDescriptorSet> RHICaptureReader::ReadWrites() {
+    const uint32 writeCount = Read<uint32>();
+    if (writeCount > GetRemainingSize() / MinWriteSize) {
+        MarkOverrun();
+        return {};
+    }
+
+    auto& writes = Store<RHIWriteDescriptorSet>(writeCount);
+    for (RHIWriteDescriptorSet& write: writes) {
+        write.pDstSet = ReadObject<RHIDescriptorSet>();
+        write.DstBinding = Read<uint32>();
+        write.DstArrayElement = Read<uint32>();
+        write.DescriptorCount = Read<uint32>();
+        write.DescriptorType = Read<RHIDescriptorType>();
+
+        const auto kind = Read<DescriptorInfoKind>();
+        const uint64 infoSize = kind == DescriptorInfoKind::Buffer ? MinBufferInfoSize : MinImageInfoSize;
+        if (kind >= DescriptorInfoKind::Count ||
+            (kind != DescriptorInfoKind::None && write.DescriptorCount > GetRemainingSize() / infoSize)) {
+            MarkOverrun();
+            return {};
+        }
+
+        if (kind == DescriptorInfoKind::Buffer) {
+            auto& infos = Store<RHIDescriptorBufferInfo>(write.DescriptorCount);
+            for (RHIDescriptorBufferInfo& info: infos) {
+                info.pBuffer = ReadObject<const RHIBuffer>();
+                info.Offset = Read<uint64>();
+                info.Range = Read<uint64>();
+            }
+            write.pBufferInfos = infos.data();
+        } else if (kind == DescriptorInfoKind::Image) {
+            auto& infos = Store<RHIDescriptorImageInfo>(write.DescriptorCount);
+            for (RHIDescriptorImageInfo& info: infos) {
+                info.pSampler = ReadObject<const RHISampler>();
+                info.pTextureView = ReadObject<const RHITextureView>();
+                info.ImageLayout = Read<RHILayout>();
+            }
+            write.pImageInfos = infos.data();
+        }
+    }
+    return writes;
+}
+
+std::span<const RHICopyDescriptorSet> RHICaptureReader::ReadCopies() {
+    const uint32 copyCount = Read<uint32>();
+    if (copyCount > GetRemainingSize() / MinCopySize) {
+        MarkOverrun();
+        return {};
+    }
+
+    auto& copies = Store<RHICopyDescriptorSet>(copyCount);
+    for (RHICopyDescriptorSet& copy: copies) {
+        copy.pSrcSet = ReadObject<const RHIDescriptorSet>();
+        copy.SrcBinding = Read<uint32>();
+        copy.SrcArrayElement = Read<uint32>();
+        copy.pDstSet = ReadObject<RHIDescriptorSet>();
+        copy.DstBinding = Read<uint32>();
+        copy.DstArrayElement = Read<uint32>();
+        copy.DescriptorCount = Read<uint32>();
+    }
+    return copies;
+}
+
+RHISpecializationInfo RHICaptureReader::ReadSpecialization() {
+    RHISpecializationInfo info;
+    info.MapEntries = ReadArray<RHISpecializationMapEntry>();
+    info.Data = ReadArray<std::byte>();
+    return info;
+}
+
+// =================================================================================================
+// Capture Objects
+// =================================================================================================
+
+void RHICaptureCommandList::Reset() {
+    m_Inner->Reset();
+    m_Encoder.Reset();
+    m_Capturing = false;
+}
+
+void RHICaptureCommandList::Begin() {
+    // A list joins the capture when its recording starts inside the window
+    m_Encoder.Reset();
+    m_Capturing = m_pDevice->IsCapturing();
+    m_Inner->Begin();
+}
+
+void RHICaptureCommandList::TransitionTexture(const RHITexture* texture, RHILayout newLayout) {
+    m_Inner->TransitionTexture(texture, newLayout);
+    if (m_Capturing) { m_Encoder.TransitionTexture(texture, newLayout); }
+}
+
+void RHICaptureCommandList::TransitionTexture(const RHITexture* texture, RHILayout newLayout, uint32 mipLevel,
+                                              uint32 arrayLayer) {
+    m_Inner->TransitionTexture(texture, newLayout, mipLevel, arrayLayer);
+    if (m_Capturing) { m_Encoder.TransitionTexture(texture, newLayout, mipLevel, arrayLayer); }
+}
+
+void RHICaptureCommandList::CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture) {
+    m_Inner->CopyBufferToTexture(srcBuffer, dstTexture);
+    if (m_Capturing) { m_Encoder.CopyBufferToTexture(srcBuffer, dstTexture); }
+}
+
+void RHICaptureCommandList::CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture,
+                                                const RHIBufferTextureCopy& region) {
+    m_Inner->CopyBufferToTexture(srcBuffer, dstTexture, region);
+    if (m_Capturing) { m_Encoder.CopyBufferToTexture(srcBuffer, dstTexture, region); }
+}
+
+void RHICaptureCommandList::CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture,
+                                                std::span<const RHIBufferTextureCopy> regions) {
+    m_Inner->CopyBufferToTexture(srcBuffer, dstTexture, regions);
+    if (m_Capturing) { m_Encoder.CopyBufferToTexture(srcBuffer, dstTexture, regions); }
+}
+
+void RHICaptureQueue::Submit(const RHICommandList* commandList, RHIFence* fence,
+                             std::span<RHISemaphore*> waitSemaphores, std::span<RHISemaphore*> signalSemaphores) {
+    m_pInner->Submit(commandList ? static_cast<const RHICaptureCommandList*>(commandList)->GetInner() : nullptr,
+                     fence, waitSemaphores, signalSemaphores);
+    if (commandList) { m_pDevice->RecordSubmit(m_QueueType, {&commandList, 1}); }
+}
+
+void RHICaptureQueue::SubmitCommandLists(std::span<const RHICommandList*> commandLists, RHIFence* signalFence) {
+    std::vector<const RHICommandList*> innerLists;
+    innerLists.reserve(commandLists.size());
+    for (const RHICommandList* commandList: commandLists) {
+        innerLists.push_back(static_cast<const RHICaptureCommandList*>(commandList)->GetInner());
+    }
+
+    m_pInner->SubmitCommandLists(innerLists, signalFence);
+    m_pDevice->RecordSubmit(m_QueueType, commandLists);
+}
+
+void RHICaptureDescriptorPool::Reset() {
+    m_Inner->Reset();
+    m_pDevice->Record(RHICaptureOpcode::ResetDescriptorPool,
+                      [this](RHICaptureRecordWriter& writer) { writer.WriteHandle(this); });
+}
+
+Scope<RHIDescriptorSet> RHICaptureDescriptorPool::AllocateDescriptorSet(const RHIDescriptorSetLayout* pLayout) {
+    Scope<RHIDescriptorSet> set = m_Inner->AllocateDescriptorSet(pLayout);
+    if (set) {
+        m_pDevice->Record(RHICaptureOpcode::AllocateDescriptorSet, [&](RHICaptureRecordWriter& writer) {
+            writer.WriteHandle(set.get());
+            writer.WriteHandle(this);
+            writer.WriteHandle(pLayout);
+        });
+    }
+    return set;
+}
+
+std::vector<Scope<RHIDescriptorSet>>
+RHICaptureDescriptorPool::AllocateDescriptorSets(std::span<const RHIDescriptorSetLayout* const> layouts) {
+    std::vector<Scope<RHIDescriptorSet>> sets = m_Inner->AllocateDescriptorSets(layouts);
+    for (size_t i = 0; i < sets.size() && i < layouts.size(); ++i) {
+        if (!sets[i]) { continue; }
+        m_pDevice->Record(RHICaptureOpcode::AllocateDescriptorSet, [&](RHICaptureRecordWriter& writer) {
+            writer.WriteHandle(sets[i].get());
+            writer.WriteHandle(this);
+            writer.WriteHandle(layouts[i]);
+        });
+    }
+    return sets;
+}
+
+void RHICaptureDescriptorPool::FreeDescriptorSet(RHIDescriptorSet* pSet) {
+    m_Inner->FreeDescriptorSet(pSet);
+    m_pDevice->Record(RHICaptureOpcode::FreeDescriptorSet, [&](RHICaptureRecordWriter& writer) {
+        writer.WriteHandle(pSet);
+        writer.WriteHandle(this);
+    });
+}
+
+void RHICaptureDescriptorPool::FreeDescriptorSets(std::span<RHIDescriptorSet*> sets) {
+    m_Inner->FreeDescriptorSets(sets);
+    for (RHIDescriptorSet* set: sets) {
+        m_pDevice->Record(RHICaptureOpcode::FreeDescriptorSet, [&](RHICaptureRecordWriter& writer) {
+            writer.WriteHandle(set);
+            writer.WriteHandle(this);
+        });
+    }
+}
+
+void RHICaptureSwapChain::Resize(uint32 width, uint32 height) {
+    m_Inner->Resize(width, height);
+    m_Extent = {m_Inner->GetWidth(), m_Inner->GetHeight()};
+    m_pDevice->RecordBackBuffers(*this);
+}
+
+// =================================================================================================
+// RHICaptureRHI
+// =================================================================================================
+
+RHICaptureRHI::RHICaptureRHI(Scope<RHI> inner, const Config& config)
+    : m_Inner(std::move(inner)), m_FirstFrame(std::max<uint64>(config.CaptureFirstFrame, 1)),
+      m_FrameCount(config.CaptureFrameCount), m_Path(config.CapturePath) {
+    for (uint32 i = 0; i < m_Queues.size(); ++i) {
+        RHIQueue* queue = m_Inner->GetQueue(static_cast<RHIQueueType>(i));
+        if (!queue) { continue; }
+        m_Queues[i] = CreateScope<RHICaptureQueue>(this, queue);
+        m_CommandListManagers[i] = CreateScope<RHICommandListManager>(this, m_Queues[i].get());
+    }
+
+    // The backend created the constant allocator's buffer itself, replays bind their own allocator's buffer
+    if (RHIConstantAllocator* constants = m_Inner->GetConstantAllocator()) {
+        Record(RHICaptureOpcode::RegisterConstantBuffer,
+               [&](RHICaptureRecordWriter& writer) { writer.WriteHandle(constants->GetBuffer()); });
+    }
+
+    Internal::LogInfo("RHICapture: Capturing {0} frames from frame {1} into '{2}'", m_FrameCount, m_FirstFrame, m_Path);
+}
+
+RHICaptureRHI::~RHICaptureRHI() {
+    // Closing before the window ends still writes the frames captured so far
+    if (!m_Finished && m_CapturedFrameCount > 0) { FinishCapture(); }
+
+    // Recycled lists go before the backend that owns their pools
+    m_Inner->WaitIdle();
+    for (auto& manager: m_CommandListManagers) { manager.reset(); }
+}
+
+RHIQueue* RHICaptureRHI::GetQueue(RHIQueueType type, uint32 index) {
+    const uint32 queueIndex = static_cast<uint32>(type);
+    return queueIndex < m_Queues.size() && index == 0 ? m_Queues[queueIndex].get() : nullptr;
+}
+
+uint32 RHICaptureRHI::GetQueueCount(RHIQueueType type) const {
+    const uint32 queueIndex = static_cast<uint32>(type);
+    return queueIndex < m_Queues.size() && m_Queues[queueIndex] ? 1 : 0;
+}
+
+void RHICaptureRHI::BeginFrame() {
+    m_Inner->BeginFrame();
+
+    const uint64 frameSerial = m_Inner->GetFrameSerial();
+    if (!m_Finished && !IsCapturing() && frameSerial >= m_FirstFrame) {
+        m_Capturing.store(true, std::memory_order_relaxed);
+    }
+    if (IsCapturing()) {
+        Record(RHICaptureOpcode::BeginFrame, [&](RHICaptureRecordWriter& writer) { writer.Write(frameSerial); });
+    }
+}
+
+void RHICaptureRHI::EndFrame(RHIQueue* pQueue) {
+    m_Inner->EndFrame(Unwrap(pQueue));
+    if (!IsCapturing()) { return; }
+
+    Record(RHICaptureOpcode::EndFrame, [](RHICaptureRecordWriter&) {});
+    if (++m_CapturedFrameCount >= m_FrameCount) { FinishCapture(); }
+}
+
+RHIDefragmentationResult RHICaptureRHI::DefragmentMemory(RHICommandList* pCommandList,
+                                                         const RHIDefragmentationLimits& limits) {
+    // Moves keep the handles of the moved resources, nothing to record
+    return m_Inner->DefragmentMemory(Unwrap(pCommandList), limits);
+}
+
+Scope<RHISwapChain> RHICaptureRHI::CreateSwapChain(const RHISwapChainCreateInfo& info) {
+    RHISwapChainCreateInfo innerInfo = info;
+    innerInfo.PresentQueue = Unwrap(info.PresentQueue);
+
+    Scope<RHISwapChain> inner = m_Inner->CreateSwapChain(innerInfo);
+    if (!inner) { return nullptr; }
+
+    innerInfo.ImageCount = inner->GetImageCount();
+    innerInfo.Extent = {inner->GetWidth(), inner->GetHeight()};
+    innerInfo.Format = inner->GetFormat();
+    auto swapChain = CreateScope<RHICaptureSwapChain>(this, innerInfo, std::move(inner));
+    RecordBackBuffers(*swapChain);
+    return swapChain;
+}
+
+Scope<RHICommandPool> RHICaptureRHI::CreateCommandPool(const RHICommandPoolCreateInfo& info) {
+    RHICommandPoolCreateInfo innerInfo = info;
+    innerInfo.pQueue = Unwrap(info.pQueue);
+    return m_Inner->CreateCommandPool(innerInfo);
+}
+
+RHICommandListManager* RHICaptureRHI::GetCommandListManager(RHIQueueType type) {
+    const uint32 index = static_cast<uint32>(type);
+    return index < m_CommandListManagers.size() ? m_CommandListManagers[index].get() : nullptr;
+}
+
+Scope<RHICommandList> RHICaptureRHI::AllocateCommandList(RHICommandPool* pPool) {
+    Scope<RHICommandList> inner = m_Inner->AllocateCommandList(pPool);
+    if (!inner) { return nullptr; }
+    return CreateScope<RHICaptureCommandList>(this, std::move(inner));
+}
+
+std::vector<Scope<RHICommandList>> RHICaptureRHI::AllocateCommandLists(RHICommandPool* pPool, uint32 count) {
+    std::vector<Scope<RHICommandList>> commandLists;
+    commandLists.reserve(count);
+    for (uint32 i = 0; i < count; ++i) { commandLists.push_back(AllocateCommandList(pPool)); }
+    return commandLists;
+}
+
+void RHICaptureRHI::FreeCommandList(RHICommandPool* pPool, RHICommandList* pCommandList) {
+    m_Inner->FreeCommandList(pPool, Unwrap(pCommandList));
+}
+
+void RHICaptureRHI::FreeCommandLists(RHICommandPool* pPool, std::span<RHICommandList*> commandLists) {
+    std::vector<RHICommandList*> innerLists;
+    innerLists.reserve(commandLists.size());
+    for (RHICommandList* commandList: commandLists) { innerLists.push_back(Unwrap(commandList)); }
+    m_Inner->FreeCommandLists(pPool, innerLists);
+}
+
+Scope<RHIBuffer> RHICaptureRHI::CreateBuffer(const RHIBufferCreateInfo& info) {
+    return RecordCreate(RHICaptureOpcode::CreateBuffer, m_Inner->CreateBuffer(info), info);
+}
+
+Scope<RHIVertexBuffer> RHICaptureRHI::CreateVertexBuffer(const RHIVertexBufferCreateInfo& info) {
+    return RecordCreate(RHICaptureOpcode::CreateVertexBuffer, m_Inner->CreateVertexBuffer(info), info);
+}
+
+Scope<RHIIndexBuffer> RHICaptureRHI::CreateIndexBuffer(const RHIIndexBufferCreateInfo& info) {
+    return RecordCreate(RHICaptureOpcode::CreateIndexBuffer, m_Inner->CreateIndexBuffer(info), info);
+}
+
+Scope<RHIUniformBuffer> RHICaptureRHI::CreateUniformBuffer(const RHIUniformBufferCreateInfo& info) {
+    // The layout only decides the size, a buffer of that size replays the same
+    Scope<RHIUniformBuffer> buffer = m_Inner->CreateUniformBuffer(info);
+    if (buffer) {
+        Record(RHICaptureOpcode::CreateUniformBuffer, [&](RHICaptureRecordWriter& writer) {
+            writer.WriteHandle(buffer.get());
+            writer.Write(buffer->GetSize());
+            writer.Write(info.MemoryUsage);
+        });
+    }
+    return buffer;
+}
+
+Scope<RHIStorageBuffer> RHICaptureRHI::CreateStorageBuffer(const RHIStorageBufferCreateInfo& info) {
+    return RecordCreate(RHICaptureOpcode::CreateStorageBuffer, m_Inner->CreateStorageBuffer(info), info);
+}
+
+Scope<RHITexture> RHICaptureRHI::CreateTexture(const RHITextureCreateInfo& info) {
+    return RecordCreate(RHICaptureOpcode::CreateTexture, m_Inner->CreateTexture(info), info);
+}
+
+Scope<RHITextureView> RHICaptureRHI::CreateTextureView(const RHITexture* pTexture,
+                                                       const RHITextureViewCreateInfo& info) {
+    Scope<RHITextureView> view = m_Inner->CreateTextureView(pTexture, info);
+    if (view) {
+        Record(RHICaptureOpcode::CreateTextureView, [&](RHICaptureRecordWriter& writer) {
+            writer.WriteHandle(view.get());
+            writer.WriteHandle(pTexture);
+            writer.Write(info);
+        });
+    }
+    return view;
+}
+
+Scope<RHISampler> RHICaptureRHI::CreateSampler(const RHISamplerCreateInfo& info) {
+    return RecordCreate(RHICaptureOpcode::CreateSampler, m_Inner->CreateSampler(info), info);
+}
+
+Scope<RHIDescriptorSetLayout> RHICaptureRHI::CreateDescriptorSetLayout(const RHIDescriptorSetLayoutCreateInfo& info) {
+    return RecordCreate(RHICaptureOpcode::CreateDescriptorSetLayout, m_Inner->CreateDescriptorSetLayout(info), info);
+}
+
+Scope<RHIDescriptorPool> RHICaptureRHI::CreateDescriptorPool(const RHIDescriptorPoolCreateInfo& info) {
+    Scope<RHIDescriptorPool> inner = m_Inner->CreateDescriptorPool(info);
+    if (!inner) { return nullptr; }
+    return RecordCreate(RHICaptureOpcode::CreateDescriptorPool,
+                        CreateScope<RHICaptureDescriptorPool>(this, info, std::move(inner)), info);
+}
+
+void RHICaptureRHI::UpdateDescriptorSets(std::span<const RHIWriteDescriptorSet> writes) {
+    m_Inner->UpdateDescriptorSets(writes);
+    Record(RHICaptureOpcode::UpdateDescriptorSets, [&](RHICaptureRecordWriter& writer) { writer.WriteWrites(writes); });
+}
+
+void RHICaptureRHI::CopyDescriptorSets(std::span<const RHICopyDescriptorSet> copies) {
+    m_Inner->CopyDescriptorSets(copies);
+    Record(RHICaptureOpcode::CopyDescriptorSets, [&](RHICaptureRecordWriter& writer) { writer.WriteCopies(copies); });
+}
+
+Scope<RHIDescriptorUpdateTemplate>
+RHICaptureRHI::CreateDescriptorUpdateTemplate(const RHIDescriptorUpdateTemplateCreateInfo& info) {
+    Scope<RHIDescriptorUpdateTemplate> updateTemplate = m_Inner->CreateDescriptorUpdateTemplate(info);
+    if (updateTemplate) {
+        Record(RHICaptureOpcode::CreateDescriptorUpdateTemplate, [&](RHICaptureRecordWriter& writer) {
+            writer.WriteHandle(updateTemplate.get());
+            writer.WriteInfo(info);
+            m_TemplateEntries[ToRHICommandHandle(updateTemplate.get())].assign(info.Entries.begin(),
+                                                                               info.Entries.end());
+        });
+    }
+    return updateTemplate;
+}
+
+void RHICaptureRHI::UpdateDescriptorSetWithTemplate(RHIDescriptorSet* pSet,
+                                                    const RHIDescriptorUpdateTemplate* pTemplate, const void* pData) {
+    m_Inner->UpdateDescriptorSetWithTemplate(pSet, pTemplate, pData);
+    if (!pData) { return; }
+
+    Record(RHICaptureOpcode::UpdateDescriptorSetWithTemplate, [&](RHICaptureRecordWriter& writer) {
+        const auto entries = m_TemplateEntries.find(ToRHICommandHandle(pTemplate));
+        const uint64 dataSize =
+                entries != m_TemplateEntries.end() ? GetDescriptorUpdateTemplateDataSize(entries->second) : 0;
+
+        writer.WriteHandle(pSet);
+        writer.WriteHandle(pTemplate);
+        writer.Write(dataSize);
+        writer.WriteBytes(pData, dataSize);
+    });
+}
+
+Scope<RHIPipelineLayout> RHICaptureRHI::CreatePipelineLayout(const RHIPipelineLayoutCreateInfo& info) {
+    return RecordCreate(RHICaptureOpcode::CreatePipelineLayout, m_Inner->CreatePipelineLayout(info), info);
+}
+
+Scope<RHIRenderPass> RHICaptureRHI::CreateRenderPass(const RHIRenderPassCreateInfo& info) {
+    return RecordCreate(RHICaptureOpcode::CreateRenderPass, m_Inner->CreateRenderPass(info), info);
+}
+
+Scope<RHIFramebuffer> RHICaptureRHI::CreateFramebuffer(const RHIFramebufferCreateInfo& info) {
+    return RecordCreate(RHICaptureOpcode::CreateFramebuffer, m_Inner->CreateFramebuffer(info), info);
+}
+
+Scope<RHIShader> RHICaptureRHI::CreateShader(const RHIShaderCreateInfo& info) {
+    return RecordCreate(RHICaptureOpcode::CreateShader, m_Inner->CreateShader(info), info);
+}
+
+Scope<RHIGraphicsPipeline> RHICaptureRHI::CreateGraphicsPipeline(const RHIGraphicsPipelineCreateInfo& info) {
+    return RecordCreate(RHICaptureOpcode::CreateGraphicsPipeline, m_Inner->CreateGraphicsPipeline(info), info);
+}
+
+Scope<RHIComputePipeline> RHICaptureRHI::CreateComputePipeline(const RHIComputePipelineCreateInfo& info) {
+    return RecordCreate(RHICaptureOpcode::CreateComputePipeline, m_Inner->CreateComputePipeline(info), info);
+}
+
+Scope<RHIQueryPool> RHICaptureRHI::CreateQueryPool(const RHIQueryPoolCreateInfo& info) {
+    return RecordCreate(RHICaptureOpcode::CreateQueryPool, m_Inner->CreateQueryPool(info), info);
+}
+
+void RHICaptureRHI::DestroyResource(RHIResource* pResource) {
+    if (!pResource) { return; }
+
+    Record(RHICaptureOpcode::DestroyResource,
+           [&](RHICaptureRecordWriter& writer) { writer.WriteHandle(pResource); });
+    m_Inner->DestroyResource(pResource);
+}
+
+void RHICaptureRHI::RecordSubmit(RHIQueueType type, std::span<const RHICommandList* const> commandLists) {
+    if (!IsCapturing()) { return; }
+
+    // Lists that began recording before the window have no stream
+    uint32 capturedCount = 0;
+    for (const RHICommandList* commandList: commandLists) {
+        if (static_cast<const RHICaptureCommandList*>(commandList)->IsCapturing()) { ++capturedCount; }
+    }
+    if (capturedCount == 0) { return; }
+
+    Record(RHICaptureOpcode::Submit, [&](RHICaptureRecordWriter& writer) {
+        writer.Write(type);
+        writer.Write(capturedCount);
+        for (const RHICommandList* commandList: commandLists) {
+            const auto* captureList = static_cast<const RHICaptureCommandList*>(commandList);
+            if (captureList->IsCapturing()) { writer.WriteStream(captureList->GetStream()); }
+        }
+    });
+}
+
+void RHICaptureRHI::RecordBackBuffers(const RHISwapChain& swapChain) {
+    for (uint32 i = 0; i < swapChain.GetImageCount(); ++i) {
+        const RHITexture* texture = swapChain.GetBackBufferTexture(i);
+        const RHITextureView* view = swapChain.GetBackBufferView(i);
+        if (!texture || !view) { continue; }
+
+        RHITextureCreateInfo textureInfo = {};
+        textureInfo.Type = texture->GetType();
+        textureInfo.Format = texture->GetFormat();
+        textureInfo.Extent = texture->GetExtent();
+        textureInfo.MipLevels = texture->GetMipLevels();
+        textureInfo.ArrayLayers = texture->GetArrayLayers();
+        textureInfo.Samples = texture->GetSamples();
+        textureInfo.Usage = texture->GetUsage();
+
+        RHITextureViewCreateInfo viewInfo = {};
+        viewInfo.Format = texture->GetFormat();
+
+        Record(RHICaptureOpcode::CreateTexture, [&](RHICaptureRecordWriter& writer) {
+            writer.WriteHandle(texture);
+            writer.WriteInfo(textureInfo);
+        });
+        Record(RHICaptureOpcode::CreateTextureView, [&](RHICaptureRecordWriter& writer) {
+            writer.WriteHandle(view);
+            writer.WriteHandle(texture);
+            writer.Write(viewInfo);
+        });
+    }
+}
+
+RHIQueue* RHICaptureRHI::Unwrap(const RHIQueue* pQueue) const {
+    for (const auto& queue: m_Queues) {
+        if (queue && queue.get() == pQueue) { return queue->GetInner(); }
+    }
+    return const_cast<RHIQueue*>(pQueue);
+}
+
+RHICommandList* RHICaptureRHI::Unwrap(const RHICommandList* pCommandList) {
+    return pCommandList ? static_cast<const RHICaptureCommandList*>(pCommandList)->GetInner() : nullptr;
+}
+
+void RHICaptureRHI::FinishCapture() {
+    m_Capturing.store(false, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(m_RecordMutex);
+    m_Finished = true;
+
+    RHICaptureFileHeader header;
+    header.FrameCount = m_CapturedFrameCount;
+
+    std::ofstream file(m_Path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(m_Records.data()), static_cast<std::streamsize>(m_Records.size()));
+    if (!file) {
+        Internal::LogError("RHICapture: Failed to write '{0}'", m_Path);
+    } else {
+        Internal::LogInfo("RHICapture: Wrote {0} frames ({1} bytes) to '{2}'", m_CapturedFrameCount,
+                          sizeof(header) + m_Records.size(), m_Path);
+    }
+
+    m_Records = {};
+    m_TemplateEntries.clear();
+}
+
+} // namespace iGe
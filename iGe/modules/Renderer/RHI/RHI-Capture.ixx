@@ -0,0 +1,601 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.RHI:RHICapture;
+import :RHI;
+import :RHIResource;
+import :RHIBuffer;
+import :RHITexture;
+import :RHITextureView;
+import :RHIDescriptor;
+import :RHIRenderPass;
+import :RHIFramebuffer;
+import :RHIShader;
+import :RHIGraphicsPipeline;
+import :RHIComputePipeline;
+import :RHIQuery;
+import :RHIQueue;
+import :RHISwapChain;
+import :RHICommandList;
+import :RHICommandListManager;
+import :RHICommandStream;
+import :RHICommandEncoder;
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Capture File Format
+// =================================================================================================
+
+// Values are part of the file format, append new opcodes before Count
+export enum class RHICaptureOpcode : uint16 {
+    Invalid = 0,
+
+    CreateBuffer,
+    CreateVertexBuffer,
+    CreateIndexBuffer,
+    CreateUniformBuffer,
+    CreateStorageBuffer,
+    CreateTexture,
+    CreateTextureView,
+    CreateSampler,
+    CreateDescriptorSetLayout,
+    CreateDescriptorPool,
+    CreateDescriptorUpdateTemplate,
+    CreatePipelineLayout,
+    CreateRenderPass,
+    CreateFramebuffer,
+    CreateShader,
+    CreateGraphicsPipeline,
+    CreateComputePipeline,
+    RegisterConstantBuffer,
+    DestroyResource,
+
+    AllocateDescriptorSet,
+    FreeDescriptorSet,
+    ResetDescriptorPool,
+    UpdateDescriptorSets,
+    CopyDescriptorSets,
+    UpdateDescriptorSetWithTemplate,
+
+    BeginFrame,
+    EndFrame,
+    Submit,
+
+    CreateQueryPool,
+
+    Count
+};
+
+export IGE_API std::string_view GetRHICaptureOpcodeName(RHICaptureOpcode opcode);
+
+export constexpr uint32 RHICaptureMagic = 0x50414349; // "ICAP"
+export constexpr uint32 RHICaptureVersion = 2;
+
+// A capture is this header followed by records in call order. Objects are referred to by the address they had
+// in the capturing process (see RHICommandHandle), the replayer maps them to the objects it creates. Records
+// before the first BeginFrame set the scene up, the rest are the captured frames.
+export struct RHICaptureFileHeader {
+    uint32 Magic = RHICaptureMagic;
+    uint32 Version = RHICaptureVersion;
+    uint32 PointerSize = sizeof(void*); // Descriptor template data holds raw pointers
+    uint32 FrameCount = 0;
+};
+
+// Framed like a command packet, Size covers header and payload and is a multiple of 8
+export struct RHICaptureRecordHeader {
+    RHICaptureOpcode Opcode = RHICaptureOpcode::Invalid;
+    uint16 Reserved = 0;
+    uint32 Size = 0;
+};
+
+// Appends one record, its size is filled in once the writer goes out of scope
+export class IGE_API RHICaptureRecordWriter {
+public:
+    RHICaptureRecordWriter(std::vector<std::byte>& data, RHICaptureOpcode opcode);
+    ~RHICaptureRecordWriter();
+
+    RHICaptureRecordWriter(const RHICaptureRecordWriter&) = delete;
+    RHICaptureRecordWriter& operator=(const RHICaptureRecordWriter&) = delete;
+
+    template<typename T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        WriteBytes(&value, sizeof(T));
+    }
+
+    void WriteBytes(const void* data, uint64 size);
+    void WriteHandle(const void* object) { Write(ToRHICommandHandle(object)); }
+    void WriteString(std::string_view string);
+
+    template<typename T>
+    void WriteArray(std::span<const T> values) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        Write(static_cast<uint32>(values.size()));
+        WriteBytes(values.data(), values.size_bytes());
+    }
+
+    template<typename T>
+    void WriteHandles(std::span<const T* const> objects) {
+        Write(static_cast<uint32>(objects.size()));
+        for (const T* object: objects) { WriteHandle(object); }
+    }
+
+    // Serialized streams are length-prefixed
+    void WriteStream(const RHICommandStream& stream);
+
+    // Plain create infos are copied as they are, those holding spans, strings or objects field by field
+    template<typename T>
+    void WriteInfo(const T& info) {
+        Write(info);
+    }
+    void WriteInfo(const RHITextureCreateInfo& info);
+    void WriteInfo(const RHIDescriptorSetLayoutCreateInfo& info);
+    void WriteInfo(const RHIDescriptorPoolCreateInfo& info);
+    void WriteInfo(const RHIDescriptorUpdateTemplateCreateInfo& info);
+    void WriteInfo(const RHIPipelineLayoutCreateInfo& info);
+    void WriteInfo(const RHIRenderPassCreateInfo& info);
+    void WriteInfo(const RHIFramebufferCreateInfo& info);
+    void WriteInfo(const RHIShaderCreateInfo& info);
+    void WriteInfo(const RHIGraphicsPipelineCreateInfo& info);
+    void WriteInfo(const RHIComputePipelineCreateInfo& info);
+    void WriteWrites(std::span<const RHIWriteDescriptorSet> writes);
+    void WriteCopies(std::span<const RHICopyDescriptorSet> copies);
+
+private:
+    void WriteSpecialization(const RHISpecializationInfo& info);
+
+    std::vector<std::byte>& m_Data;
+    size_t m_Start = 0;
+};
+
+// Reads what RHICaptureRecordWriter wrote. Arrays are copied into storage owned by the reader, so the spans of
+// a read create info stay valid as long as the reader, and handles are mapped through the resolver.
+export class IGE_API RHICaptureReader : public RHICommandPayloadReader {
+public:
+    RHICaptureReader(std::span<const std::byte> payload, RHICommandDecoder::HandleResolver resolver)
+        : RHICommandPayloadReader(payload), m_Resolver(std::move(resolver)) {}
+
+    std::string ReadString();
+    bool ReadStream(RHICommandStream& stream);
+
+    template<typename T>
+    std::span<const T> ReadArray() {
+        const uint32 count = Read<uint32>();
+        const std::span<const std::byte> bytes = ReadBytes(static_cast<uint64>(count) * sizeof(T));
+        if (bytes.empty()) { return {}; }
+
+        auto& values = Store<T>(count);
+        std::memcpy(values.data(), bytes.data(), bytes.size());
+        return values;
+    }
+
+    template<typename T>
+    T* ReadObject() {
+        const RHICommandHandle handle = Read<RHICommandHandle>();
+        return handle != 0 ? static_cast<T*>(m_Resolver(handle)) : nullptr;
+    }
+
+    template<typename T>
+    std::span<const T* const> ReadObjects() {
+        const uint32 count = Read<uint32>();
+        if (count > GetRemainingSize() / sizeof(RHICommandHandle)) {
+            MarkOverrun();
+            return {};
+        }
+
+        auto& objects = Store<const T*>(count);
+        for (const T*& object: objects) { object = ReadObject<const T>(); }
+        return objects;
+    }
+
+    // Return false on content no writer produces
+    template<typename T>
+    bool ReadInfo(T& info) {
+        info = Read<T>();
+        return !IsOverrun();
+    }
+    bool ReadInfo(RHITextureCreateInfo& info);
+    bool ReadInfo(RHIDescriptorSetLayoutCreateInfo& info);
+    bool ReadInfo(RHIDescriptorPoolCreateInfo& info);
+    bool ReadInfo(RHIDescriptorUpdateTemplateCreateInfo& info);
+    bool ReadInfo(RHIPipelineLayoutCreateInfo& info);
+    bool ReadInfo(RHIRenderPassCreateInfo& info);
+    bool ReadInfo(RHIFramebufferCreateInfo& info);
+    bool ReadInfo(RHIShaderCreateInfo& info);
+    bool ReadInfo(RHIGraphicsPipelineCreateInfo& info);
+    bool ReadInfo(RHIComputePipelineCreateInfo& info);
+    std::span<const RHIWriteDescriptorSet> ReadWrites();
+    std::span<const RHICopyDescriptorSet> ReadCopies();
+
+private:
+    template<typename T>
+    std::vector<T>& Store(uint32 count) {
+        auto values = CreateRef<std::vector<T>>(count);
+        m_Storage.push_back(values);
+        return *values;
+    }
+
+    RHISpecializationInfo ReadSpecialization();
+
+    RHICommandDecoder::HandleResolver m_Resolver;
+    std::vector<Ref<void>> m_Storage;
+};
+
+// =================================================================================================
+// Capture Device
+// =================================================================================================
+
+class RHICaptureRHI;
+
+// Tees every command into an encoder while its recording started inside the capture window
+class RHICaptureCommandList final : public RHICommandList {
+public:
+    RHICaptureCommandList(RHICaptureRHI* pDevice, Scope<RHICommandList> inner)
+        : m_pDevice(pDevice), m_Inner(std::move(inner)) {}
+
+    RHICommandList* GetInner() const { return m_Inner.get(); }
+    bool IsCapturing() const { return m_Capturing; }
+    const RHICommandStream& GetStream() const { return m_Encoder.GetStream(); }
+
+    void Reset() override;
+    void Begin() override;
+    void End() override { m_Inner->End(); }
+
+    void BeginRenderPass(const RHIRenderPassBeginInfo& info) override {
+        Forward(&RHICommandList::BeginRenderPass, info);
+    }
+    void EndRenderPass() override { Forward(&RHICommandList::EndRenderPass); }
+    void NextSubpass() override { Forward(&RHICommandList::NextSubpass); }
+
+    void BindGraphicsPipeline(const RHIGraphicsPipeline* pipeline) override {
+        Forward(&RHICommandList::BindGraphicsPipeline, pipeline);
+    }
+    void BindComputePipeline(const RHIComputePipeline* pipeline) override {
+        Forward(&RHICommandList::BindComputePipeline, pipeline);
+    }
+    void BindDescriptorSet(const RHIPipelineLayout* layout, uint32 setIndex, const RHIDescriptorSet* descriptorSet,
+                           std::span<const uint32> dynamicOffsets = {}) override {
+        Forward(&RHICommandList::BindDescriptorSet, layout, setIndex, descriptorSet, dynamicOffsets);
+    }
+    void BindTransientDescriptors(const RHIPipelineLayout* layout, uint32 setIndex,
+                                  const RHIDescriptorSetLayout* setLayout,
+                                  std::span<const RHIWriteDescriptorSet> writes) override {
+        Forward(&RHICommandList::BindTransientDescriptors, layout, setIndex, setLayout, writes);
+    }
+    void BindVertexBuffer(const RHIVertexBuffer* buffer, uint32 binding = 0, uint64 offset = 0) override {
+        Forward(&RHICommandList::BindVertexBuffer, buffer, binding, offset);
+    }
+    void BindIndexBuffer(const RHIIndexBuffer* buffer, uint64 offset = 0) override {
+        Forward(&RHICommandList::BindIndexBuffer, buffer, offset);
+    }
+    // Spelled out like the overloads below, the base class adds a template PushConstants
+    void PushConstants(const RHIPipelineLayout* layout, Flags<RHIShaderStage> stageFlags, uint32 offset, uint32 size,
+                       const void* data) override {
+        m_Inner->PushConstants(layout, stageFlags, offset, size, data);
+        if (m_Capturing) { m_Encoder.PushConstants(layout, stageFlags, offset, size, data); }
+    }
+
+    void SetViewport(const RHIViewport& viewport) override { Forward(&RHICommandList::SetViewport, viewport); }
+    void SetScissor(const RHIScissor& scissor) override { Forward(&RHICommandList::SetScissor, scissor); }
+    void SetLineWidth(float lineWidth) override { Forward(&RHICommandList::SetLineWidth, lineWidth); }
+    void SetDepthBias(float constantFactor, float clamp, float slopeFactor) override {
+        Forward(&RHICommandList::SetDepthBias, constantFactor, clamp, slopeFactor);
+    }
+    void SetBlendConstants(const float blendConstants[4]) override {
+        Forward(&RHICommandList::SetBlendConstants, blendConstants);
+    }
+    void SetDepthBounds(float minDepthBounds, float maxDepthBounds) override {
+        Forward(&RHICommandList::SetDepthBounds, minDepthBounds, maxDepthBounds);
+    }
+    void SetStencilCompareMask(bool front, bool back, uint32 compareMask) override {
+        Forward(&RHICommandList::SetStencilCompareMask, front, back, compareMask);
+    }
+    void SetStencilWriteMask(bool front, bool back, uint32 writeMask) override {
+        Forward(&RHICommandList::SetStencilWriteMask, front, back, writeMask);
+    }
+    void SetStencilReference(bool front, bool back, uint32 reference) override {
+        Forward(&RHICommandList::SetStencilReference, front, back, reference);
+    }
+
+    void Draw(uint32 vertexCount, uint32 instanceCount = 1, uint32 firstVertex = 0, uint32 firstInstance = 0) override {
+        Forward(&RHICommandList::Draw, vertexCount, instanceCount, firstVertex, firstInstance);
+    }
+    void DrawIndexed(uint32 indexCount, uint32 instanceCount = 1, uint32 firstIndex = 0, int32 vertexOffset = 0,
+                     uint32 firstInstance = 0) override {
+        Forward(&RHICommandList::DrawIndexed, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+    }
+    void Dispatch(uint32 groupCountX, uint32 groupCountY = 1, uint32 groupCountZ = 1) override {
+        Forward(&RHICommandList::Dispatch, groupCountX, groupCountY, groupCountZ);
+    }
+
+    // Overloads are spelled out, a member pointer to an overload set cannot be deduced
+    void TransitionTexture(const RHITexture* texture, RHILayout newLayout) override;
+    void TransitionTexture(const RHITexture* texture, RHILayout newLayout, uint32 mipLevel, uint32 arrayLayer) override;
+    void TransitionBuffer(const RHIBuffer* buffer, RHILayout newLayout) override {
+        Forward(&RHICommandList::TransitionBuffer, buffer, newLayout);
+    }
+    void ResourceBarrier(const RHITexture* texture, RHILayout oldLayout, RHILayout newLayout) override {
+        Forward(&RHICommandList::ResourceBarrier, texture, oldLayout, newLayout);
+    }
+    void PipelineBarrier(const RHIBarrierBatch* barriers) override {
+        Forward(&RHICommandList::PipelineBarrier, barriers);
+    }
+
+    void CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture) override;
+    void CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture,
+                             const RHIBufferTextureCopy& region) override;
+    void CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture,
+                             std::span<const RHIBufferTextureCopy> regions) override;
+    void CopyTextureToBuffer(const RHITexture* srcTexture, const RHIBuffer* dstBuffer) override {
+        Forward(&RHICommandList::CopyTextureToBuffer, srcTexture, dstBuffer);
+    }
+    void CopyBuffer(const RHIBuffer* srcBuffer, const RHIBuffer* dstBuffer, uint64 srcOffset, uint64 dstOffset,
+                    uint64 size) override {
+        Forward(&RHICommandList::CopyBuffer, srcBuffer, dstBuffer, srcOffset, dstOffset, size);
+    }
+    void BlitTexture(const RHITexture* srcTexture, const RHITexture* dstTexture,
+                     RHISamplerFilter filter = RHISamplerFilter::Linear) override {
+        Forward(&RHICommandList::BlitTexture, srcTexture, dstTexture, filter);
+    }
+
+    void ClearColorAttachment(uint32 attachmentIndex, const float color[4], const RHIRect2D& rect) override {
+        Forward(&RHICommandList::ClearColorAttachment, attachmentIndex, color, rect);
+    }
+    void ClearDepthStencilAttachment(float depth, uint32 stencil, bool clearDepth, bool clearStencil,
+                                     const RHIRect2D& rect) override {
+        Forward(&RHICommandList::ClearDepthStencilAttachment, depth, stencil, clearDepth, clearStencil, rect);
+    }
+    void ClearTexture(const RHITexture* texture, const float color[4]) override {
+        Forward(&RHICommandList::ClearTexture, texture, color);
+    }
+    void ClearBuffer(const RHIBuffer* buffer, uint32 value, uint64 offset = 0, uint64 size = ~0ULL) override {
+        Forward(&RHICommandList::ClearBuffer, buffer, value, offset, size);
+    }
+
+    void WriteTimestamp(const RHIQueryPool* pool, uint32 index) override {
+        Forward(&RHICommandList::WriteTimestamp, pool, index);
+    }
+    void BeginQuery(const RHIQueryPool* pool, uint32 index) override {
+        Forward(&RHICommandList::BeginQuery, pool, index);
+    }
+    void EndQuery(const RHIQueryPool* pool, uint32 index) override { Forward(&RHICommandList::EndQuery, pool, index); }
+    void ResolveQueries(const RHIQueryPool* pool, uint32 firstIndex, uint32 count, const RHIBuffer* dstBuffer,
+                        uint64 dstOffset = 0) override {
+        Forward(&RHICommandList::ResolveQueries, pool, firstIndex, count, dstBuffer, dstOffset);
+    }
+
+    void BeginDebugLabel(const std::string& label, const float color[4] = nullptr) override {
+        Forward(&RHICommandList::BeginDebugLabel, label, color);
+    }
+    void EndDebugLabel() override { Forward(&RHICommandList::EndDebugLabel); }
+    void InsertDebugLabel(const std::string& label, const float color[4] = nullptr) override {
+        Forward(&RHICommandList::InsertDebugLabel, label, color);
+    }
+
+    uint64 GetFilteredCommandCount() const override { return m_Inner->GetFilteredCommandCount(); }
+
+private:
+    template<typename... Params, typename... Args>
+    void Forward(void (RHICommandList::*command)(Params...), const Args&... args) {
+        (m_Inner.get()->*command)(args...);
+        if (m_Capturing) { (m_Encoder.*command)(args...); }
+    }
+
+    RHICaptureRHI* m_pDevice = nullptr;
+    Scope<RHICommandList> m_Inner;
+    RHICommandEncoder m_Encoder;
+    bool m_Capturing = false;
+};
+
+class RHICaptureQueue final : public RHIQueue {
+public:
+    RHICaptureQueue(RHICaptureRHI* pDevice, RHIQueue* pInner)
+        : RHIQueue({pInner->GetQueueType(), 0}), m_pDevice(pDevice), m_pInner(pInner) {}
+
+    RHIQueue* GetInner() const { return m_pInner; }
+    void* GetNativeHandle() const override { return m_pInner->GetNativeHandle(); }
+
+    void WaitIdle() override { m_pInner->WaitIdle(); }
+
+    void Submit(const RHICommandList* commandList, RHIFence* fence = nullptr,
+                std::span<RHISemaphore*> waitSemaphores = {}, std::span<RHISemaphore*> signalSemaphores = {}) override;
+    void SubmitCommandLists(std::span<const RHICommandList*> commandLists, RHIFence* signalFence = nullptr) override;
+
+    void Signal(RHIFence* fence, uint64 value) override { m_pInner->Signal(fence, value); }
+    void Wait(RHIFence* fence, uint64 value) override { m_pInner->Wait(fence, value); }
+
+    RHITimestampCalibration CalibrateTimestamps() const override { return m_pInner->CalibrateTimestamps(); }
+
+private:
+    RHICaptureRHI* m_pDevice = nullptr;
+    RHIQueue* m_pInner = nullptr;
+};
+
+// Set allocation is recorded so replayed descriptor updates find their sets
+class RHICaptureDescriptorPool final : public RHIDescriptorPool {
+public:
+    RHICaptureDescriptorPool(RHICaptureRHI* pDevice, const RHIDescriptorPoolCreateInfo& info,
+                             Scope<RHIDescriptorPool> inner)
+        : RHIDescriptorPool(info), m_pDevice(pDevice), m_Inner(std::move(inner)) {}
+
+    void* GetNativeHandle() const override { return m_Inner->GetNativeHandle(); }
+
+    void Reset() override;
+    Scope<RHIDescriptorSet> AllocateDescriptorSet(const RHIDescriptorSetLayout* pLayout) override;
+    std::vector<Scope<RHIDescriptorSet>>
+    AllocateDescriptorSets(std::span<const RHIDescriptorSetLayout* const> layouts) override;
+    void FreeDescriptorSet(RHIDescriptorSet* pSet) override;
+    void FreeDescriptorSets(std::span<RHIDescriptorSet*> sets) override;
+
+private:
+    RHICaptureRHI* m_pDevice = nullptr;
+    Scope<RHIDescriptorPool> m_Inner;
+};
+
+// Back buffers are recorded as plain textures, again after every resize
+class RHICaptureSwapChain final : public RHISwapChain {
+public:
+    RHICaptureSwapChain(RHICaptureRHI* pDevice, const RHISwapChainCreateInfo& info, Scope<RHISwapChain> inner)
+        : RHISwapChain(info), m_pDevice(pDevice), m_Inner(std::move(inner)) {}
+
+    void* GetNativeHandle() const override { return m_Inner->GetNativeHandle(); }
+
+    uint32 AcquireNextImage(RHISemaphore* signalSemaphore = nullptr, RHIFence* signalFence = nullptr) override {
+        return m_Inner->AcquireNextImage(signalSemaphore, signalFence);
+    }
+    void Present(std::span<RHISemaphore* const> waitSemaphores = {}) override { m_Inner->Present(waitSemaphores); }
+    void Resize(uint32 width, uint32 height) override;
+
+    RHITexture* GetBackBufferTexture(uint32 index) const override { return m_Inner->GetBackBufferTexture(index); }
+    RHITextureView* GetBackBufferView(uint32 index) const override { return m_Inner->GetBackBufferView(index); }
+
+private:
+    RHICaptureRHI* m_pDevice = nullptr;
+    Scope<RHISwapChain> m_Inner;
+};
+
+// Decorator installed by RHI::Init when RHI::Config::CaptureFrameCount is set. Object creation, descriptor
+// updates and destruction are recorded from the start so the captured frames can be set up again, command lists
+// and submissions only inside the capture window. Buffer contents written through Map or Update are not part of
+// the capture, neither is work recorded straight into the backend (ImGui).
+export class IGE_API RHICaptureRHI final : public RHI {
+public:
+    RHICaptureRHI(Scope<RHI> inner, const Config& config);
+    ~RHICaptureRHI() override;
+
+    RHI* GetInner() const { return m_Inner.get(); }
+    bool IsCapturing() const { return m_Capturing.load(std::memory_order_relaxed); }
+
+    // =============================================================================
+    // Device Operations
+    // =============================================================================
+
+    void WaitIdle() override { m_Inner->WaitIdle(); }
+
+    const RHIDeviceProperties& GetDeviceProperties() const override { return m_Inner->GetDeviceProperties(); }
+    const RHIMemoryProperties& GetMemoryProperties() const override { return m_Inner->GetMemoryProperties(); }
+    RHIFormatProperties GetFormatProperties(RHIFormat format) const override {
+        return m_Inner->GetFormatProperties(format);
+    }
+
+    RHIQueue* GetQueue(RHIQueueType type, uint32 index = 0) override;
+    uint32 GetQueueCount(RHIQueueType type) const override;
+
+    void BeginFrame() override;
+    void EndFrame(RHIQueue* pQueue) override;
+    uint64 GetFrameSerial() const override { return m_Inner->GetFrameSerial(); }
+    uint64 GetCompletedFrameSerial() const override { return m_Inner->GetCompletedFrameSerial(); }
+    RHIConstantAllocator* GetConstantAllocator() override { return m_Inner->GetConstantAllocator(); }
+    RHIMemoryStats GetMemoryStats() const override { return m_Inner->GetMemoryStats(); }
+    RHIDefragmentationResult DefragmentMemory(RHICommandList* pCommandList,
+                                              const RHIDefragmentationLimits& limits = {}) override;
+
+    // =============================================================================
+    // Object Creation
+    // =============================================================================
+
+    Scope<RHISurface> CreateSurface(const RHISurfaceCreateInfo& info) override { return m_Inner->CreateSurface(info); }
+    Scope<RHISwapChain> CreateSwapChain(const RHISwapChainCreateInfo& info) override;
+
+    Scope<RHICommandPool> CreateCommandPool(const RHICommandPoolCreateInfo& info) override;
+    RHICommandListManager* GetCommandListManager(RHIQueueType type) override;
+    Scope<RHICommandList> AllocateCommandList(RHICommandPool* pPool) override;
+    std::vector<Scope<RHICommandList>> AllocateCommandLists(RHICommandPool* pPool, uint32 count) override;
+    void FreeCommandList(RHICommandPool* pPool, RHICommandList* pCommandList) override;
+    void FreeCommandLists(RHICommandPool* pPool, std::span<RHICommandList*> commandLists) override;
+
+    Scope<RHIBuffer> CreateBuffer(const RHIBufferCreateInfo& info) override;
+    Scope<RHIVertexBuffer> CreateVertexBuffer(const RHIVertexBufferCreateInfo& info) override;
+    Scope<RHIIndexBuffer> CreateIndexBuffer(const RHIIndexBufferCreateInfo& info) override;
+    Scope<RHIUniformBuffer> CreateUniformBuffer(const RHIUniformBufferCreateInfo& info) override;
+    Scope<RHIStorageBuffer> CreateStorageBuffer(const RHIStorageBufferCreateInfo& info) override;
+
+    Scope<RHITexture> CreateTexture(const RHITextureCreateInfo& info) override;
+    Scope<RHITextureView> CreateTextureView(const RHITexture* pTexture, const RHITextureViewCreateInfo& info) override;
+    Scope<RHISampler> CreateSampler(const RHISamplerCreateInfo& info) override;
+
+    Scope<RHIDescriptorSetLayout> CreateDescriptorSetLayout(const RHIDescriptorSetLayoutCreateInfo& info) override;
+    Scope<RHIDescriptorPool> CreateDescriptorPool(const RHIDescriptorPoolCreateInfo& info) override;
+    void UpdateDescriptorSets(std::span<const RHIWriteDescriptorSet> writes) override;
+    void CopyDescriptorSets(std::span<const RHICopyDescriptorSet> copies) override;
+    Scope<RHIDescriptorUpdateTemplate>
+    CreateDescriptorUpdateTemplate(const RHIDescriptorUpdateTemplateCreateInfo& info) override;
+    void UpdateDescriptorSetWithTemplate(RHIDescriptorSet* pSet, const RHIDescriptorUpdateTemplate* pTemplate,
+                                         const void* pData) override;
+
+    Scope<RHIPipelineLayout> CreatePipelineLayout(const RHIPipelineLayoutCreateInfo& info) override;
+    Scope<RHIRenderPass> CreateRenderPass(const RHIRenderPassCreateInfo& info) override;
+    Scope<RHIFramebuffer> CreateFramebuffer(const RHIFramebufferCreateInfo& info) override;
+    Scope<RHIShader> CreateShader(const RHIShaderCreateInfo& info) override;
+    Scope<RHIGraphicsPipeline> CreateGraphicsPipeline(const RHIGraphicsPipelineCreateInfo& info) override;
+    Scope<RHIComputePipeline> CreateComputePipeline(const RHIComputePipelineCreateInfo& info) override;
+    Scope<RHIQueryPool> CreateQueryPool(const RHIQueryPoolCreateInfo& info) override;
+
+    // Fences and semaphores are not recorded, the replayer paces frames on its own fence
+    Scope<RHIFence> CreateGPUFence(const RHIFenceCreateInfo& info) override { return m_Inner->CreateGPUFence(info); }
+    Scope<RHISemaphore> CreateGPUSemaphore() override { return m_Inner->CreateGPUSemaphore(); }
+    bool WaitForFences(std::span<RHIFence* const> fences, bool waitAll = true,
+                       uint64 timeout = std::numeric_limits<uint64>::max()) override {
+        return m_Inner->WaitForFences(fences, waitAll, timeout);
+    }
+    void ResetFences(std::span<RHIFence* const> fences) override { m_Inner->ResetFences(fences); }
+
+    void DestroyResource(RHIResource* pResource) override;
+
+    // =============================================================================
+    // Recording (called by the wrapped objects)
+    // =============================================================================
+
+    // Records nothing once the capture has been written
+    template<typename Function>
+    void Record(RHICaptureOpcode opcode, Function&& function) {
+        std::lock_guard<std::mutex> lock(m_RecordMutex);
+        if (m_Finished) { return; }
+
+        RHICaptureRecordWriter writer(m_Records, opcode);
+        function(writer);
+    }
+
+    void RecordSubmit(RHIQueueType type, std::span<const RHICommandList* const> commandLists);
+    void RecordBackBuffers(const RHISwapChain& swapChain);
+
+private:
+    template<typename T, typename Info>
+    Scope<T> RecordCreate(RHICaptureOpcode opcode, Scope<T> object, const Info& info) {
+        if (object) {
+            Record(opcode, [&](RHICaptureRecordWriter& writer) {
+                writer.WriteHandle(object.get());
+                writer.WriteInfo(info);
+            });
+        }
+        return object;
+    }
+
+    RHIQueue* Unwrap(const RHIQueue* pQueue) const;
+    static RHICommandList* Unwrap(const RHICommandList* pCommandList);
+
+    void FinishCapture();
+
+    Scope<RHI> m_Inner;
+
+    std::array<Scope<RHICaptureQueue>, static_cast<size_t>(RHIQueueType::Count)> m_Queues;
+    std::array<Scope<RHICommandListManager>, static_cast<size_t>(RHIQueueType::Count)> m_CommandListManagers;
+
+    // Capture window, opened by the BeginFrame of frame m_FirstFrame
+    uint64 m_FirstFrame = 1;
+    uint32 m_FrameCount = 0;
+    uint32 m_CapturedFrameCount = 0;
+    std::string m_Path;
+    std::atomic<bool> m_Capturing = false;
+
+    std::mutex m_RecordMutex;
+    std::vector<std::byte> m_Records;
+    bool m_Finished = false;
+    // Entries of every template, they size the data an update reads
+    std::unordered_map<RHICommandHandle, std::vector<RHIDescriptorUpdateTemplateEntry>> m_TemplateEntries;
+};
+
+} // namespace iGe
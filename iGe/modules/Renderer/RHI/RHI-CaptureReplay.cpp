@@ -0,0 +1,401 @@
+module iGe.RHI;
+import :RHICaptureReplay;
+
+namespace iGe
+{
+
+RHICaptureReplayer::RHICaptureReplayer(RHI* pTarget) : m_pTarget(pTarget) {
+    m_Decoder.SetHandleResolver([this](RHICommandHandle handle) { return Resolve(handle); });
+}
+
+RHICaptureReplayer::~RHICaptureReplayer() { Teardown(); }
+
+bool RHICaptureReplayer::Load(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        Internal::LogError("RHICaptureReplayer: Failed to open '{0}'", path.string());
+        return false;
+    }
+
+    m_Data.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(m_Data.data()), static_cast<std::streamsize>(m_Data.size()));
+
+    RHICaptureFileHeader header;
+    if (!file || m_Data.size() < sizeof(header)) {
+        Internal::LogError("RHICaptureReplayer: '{0}' is truncated", path.string());
+        return false;
+    }
+    std::memcpy(&header, m_Data.data(), sizeof(header));
+    if (header.Magic != RHICaptureMagic || header.Version != RHICaptureVersion) {
+        Internal::LogError("RHICaptureReplayer: '{0}' is not a version {1} capture", path.string(), RHICaptureVersion);
+        return false;
+    }
+    if (header.PointerSize != sizeof(void*)) {
+        Internal::LogError("RHICaptureReplayer: '{0}' was captured by a {1}-bit process", path.string(),
+                           header.PointerSize * 8);
+        return false;
+    }
+
+    // Records up to the first BeginFrame set the frames up, each frame runs up to its EndFrame
+    m_SetupRecords.clear();
+    m_Frames.clear();
+    std::vector<Record> frame;
+    bool inFrames = false;
+
+    for (size_t offset = sizeof(header); offset < m_Data.size();) {
+        RHICaptureRecordHeader recordHeader;
+        if (m_Data.size() - offset < sizeof(recordHeader)) { break; }
+        std::memcpy(&recordHeader, m_Data.data() + offset, sizeof(recordHeader));
+
+        if (recordHeader.Size < sizeof(recordHeader) || recordHeader.Size % RHICommandStream::PacketAlignment != 0 ||
+            recordHeader.Size > m_Data.size() - offset || recordHeader.Opcode >= RHICaptureOpcode::Count) {
+            Internal::LogError("RHICaptureReplayer: Malformed record at byte {0} of '{1}'", offset, path.string());
+            return false;
+        }
+
+        Record record;
+        record.Opcode = recordHeader.Opcode;
+        record.Payload = std::span<const std::byte>(m_Data).subspan(offset + sizeof(recordHeader),
+                                                                    recordHeader.Size - sizeof(recordHeader));
+        offset += recordHeader.Size;
+
+        inFrames = inFrames || record.Opcode == RHICaptureOpcode::BeginFrame;
+        if (!inFrames) {
+            m_SetupRecords.push_back(record);
+            continue;
+        }
+
+        frame.push_back(record);
+        if (record.Opcode == RHICaptureOpcode::EndFrame) { m_Frames.push_back(std::move(frame)); }
+    }
+
+    if (!frame.empty()) { Internal::LogWarn("RHICaptureReplayer: Dropping the unfinished last frame"); }
+    if (m_Frames.size() != header.FrameCount) {
+        Internal::LogWarn("RHICaptureReplayer: '{0}' holds {1} of {2} frames", path.string(), m_Frames.size(),
+                          header.FrameCount);
+    }
+    return true;
+}
+
+bool RHICaptureReplayer::Setup() {
+    if (!m_FrameFence) { m_FrameFence = m_pTarget->CreateGPUFence({}); }
+
+    for (const Record& record: m_SetupRecords) {
+        if (!Execute(record, false)) {
+            Internal::LogError("RHICaptureReplayer: Malformed {0} record", GetRHICaptureOpcodeName(record.Opcode));
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RHICaptureReplayer::ReplayFrame(uint32 frameIndex) {
+    if (frameIndex >= m_Frames.size()) { return false; }
+
+    for (const Record& record: m_Frames[frameIndex]) {
+        if (Execute(record, true)) { continue; }
+
+        Internal::LogError("RHICaptureReplayer: Malformed {0} record in frame {1}",
+                           GetRHICaptureOpcodeName(record.Opcode), frameIndex);
+        // Keeps the target's frame serials in step
+        if (record.Opcode != RHICaptureOpcode::EndFrame) { Execute({RHICaptureOpcode::EndFrame, {}}, true); }
+        return false;
+    }
+    return true;
+}
+
+void RHICaptureReplayer::Teardown() {
+    if (m_Objects.empty()) { return; }
+    m_pTarget->WaitIdle();
+
+    std::vector<Object*> objects;
+    objects.reserve(m_Objects.size());
+    for (auto& [handle, object]: m_Objects) { objects.push_back(&object); }
+    std::ranges::sort(objects, std::greater{}, &Object::Sequence);
+    for (Object* object: objects) { object->Owned.reset(); }
+
+    m_Objects.clear();
+    m_TemplateEntries.clear();
+}
+
+bool RHICaptureReplayer::Execute(const Record& record, bool inFrame) {
+    RHICaptureReader reader(record.Payload, [this](RHICommandHandle handle) { return Resolve(handle); });
+
+    switch (record.Opcode) {
+        case RHICaptureOpcode::CreateBuffer:
+            return Create<RHIBufferCreateInfo>(reader, inFrame,
+                                               [this](const auto& info) { return m_pTarget->CreateBuffer(info); });
+        case RHICaptureOpcode::CreateVertexBuffer:
+            return Create<RHIVertexBufferCreateInfo>(
+                    reader, inFrame, [this](const auto& info) { return m_pTarget->CreateVertexBuffer(info); });
+        case RHICaptureOpcode::CreateIndexBuffer:
+            return Create<RHIIndexBufferCreateInfo>(
+                    reader, inFrame, [this](const auto& info) { return m_pTarget->CreateIndexBuffer(info); });
+        case RHICaptureOpcode::CreateUniformBuffer: {
+            // Only the size was recorded, see RHICaptureRHI::CreateUniformBuffer
+            const auto [handle, size, memoryUsage] = reader.ReadAll<RHICommandHandle, uint64, RHIMemoryUsage>();
+            if (reader.IsOverrun()) { return false; }
+
+            const Flags<RHIBufferUsageBit> usage = RHIBufferUsageBit::UniformBuffer | RHIBufferUsageBit::TransferDst;
+            Bind(handle, m_pTarget->CreateBuffer({size, usage, memoryUsage}), inFrame);
+            return true;
+        }
+        case RHICaptureOpcode::CreateStorageBuffer:
+            return Create<RHIStorageBufferCreateInfo>(
+                    reader, inFrame, [this](const auto& info) { return m_pTarget->CreateStorageBuffer(info); });
+        case RHICaptureOpcode::CreateTexture:
+            return Create<RHITextureCreateInfo>(reader, inFrame,
+                                                [this](const auto& info) { return m_pTarget->CreateTexture(info); });
+        case RHICaptureOpcode::CreateTextureView: {
+            const RHICommandHandle handle = reader.Read<RHICommandHandle>();
+            const auto* texture = reader.ReadObject<const RHITexture>();
+            const auto info = reader.Read<RHITextureViewCreateInfo>();
+            if (reader.IsOverrun()) { return false; }
+
+            if (texture) { Bind(handle, m_pTarget->CreateTextureView(texture, info), inFrame); }
+            return true;
+        }
+        case RHICaptureOpcode::CreateSampler:
+            return Create<RHISamplerCreateInfo>(reader, inFrame,
+                                                [this](const auto& info) { return m_pTarget->CreateSampler(info); });
+        case RHICaptureOpcode::CreateDescriptorSetLayout:
+            return Create<RHIDescriptorSetLayoutCreateInfo>(
+                    reader, inFrame, [this](const auto& info) { return m_pTarget->CreateDescriptorSetLayout(info); });
+        case RHICaptureOpcode::CreateDescriptorPool:
+            return Create<RHIDescriptorPoolCreateInfo>(
+                    reader, inFrame, [this](const auto& info) { return m_pTarget->CreateDescriptorPool(info); });
+        case RHICaptureOpcode::CreateDescriptorUpdateTemplate: {
+            const RHICommandHandle handle = reader.Read<RHICommandHandle>();
+            RHIDescriptorUpdateTemplateCreateInfo info;
+            if (!reader.ReadInfo(info)) { return false; }
+
+            m_TemplateEntries[handle].assign(info.Entries.begin(), info.Entries.end());
+            Bind(handle, m_pTarget->CreateDescriptorUpdateTemplate(info), inFrame);
+            return true;
+        }
+        case RHICaptureOpcode::CreatePipelineLayout:
+            return Create<RHIPipelineLayoutCreateInfo>(
+                    reader, inFrame, [this](const auto& info) { return m_pTarget->CreatePipelineLayout(info); });
+        case RHICaptureOpcode::CreateRenderPass:
+            return Create<RHIRenderPassCreateInfo>(
+                    reader, inFrame, [this](const auto& info) { return m_pTarget->CreateRenderPass(info); });
+        case RHICaptureOpcode::CreateFramebuffer:
+            return Create<RHIFramebufferCreateInfo>(
+                    reader, inFrame, [this](const auto& info) { return m_pTarget->CreateFramebuffer(info); });
+        case RHICaptureOpcode::CreateShader:
+            return Create<RHIShaderCreateInfo>(reader, inFrame,
+                                               [this](const auto& info) { return m_pTarget->CreateShader(info); });
+        case RHICaptureOpcode::CreateGraphicsPipeline:
+            return Create<RHIGraphicsPipelineCreateInfo>(
+                    reader, inFrame, [this](const auto& info) { return m_pTarget->CreateGraphicsPipeline(info); });
+        case RHICaptureOpcode::CreateComputePipeline:
+            return Create<RHIComputePipelineCreateInfo>(
+                    reader, inFrame, [this](const auto& info) { return m_pTarget->CreateComputePipeline(info); });
+        case RHICaptureOpcode::CreateQueryPool:
+            return Create<RHIQueryPoolCreateInfo>(
+                    reader, inFrame, [this](const auto& info) { return m_pTarget->CreateQueryPool(info); });
+
+        case RHICaptureOpcode::RegisterConstantBuffer: {
+            const RHICommandHandle handle = reader.Read<RHICommandHandle>();
+            if (reader.IsOverrun()) { return false; }
+
+            RHIConstantAllocator* constants = m_pTarget->GetConstantAllocator();
+            if (!constants) { return true; }
+
+            Object& object = m_Objects[handle];
+            Retire(object);
+            object.pObject = const_cast<RHIBuffer*>(constants->GetBuffer());
+            object.Sequence = m_NextSequence++;
+            return true;
+        }
+        case RHICaptureOpcode::DestroyResource: {
+            const RHICommandHandle handle = reader.Read<RHICommandHandle>();
+            if (reader.IsOverrun()) { return false; }
+
+            // Objects of the setup are needed again by the next replay of the frames
+            const auto it = m_Objects.find(handle);
+            if (it != m_Objects.end() && (!inFrame || it->second.FrameLocal)) {
+                Retire(it->second);
+                m_Objects.erase(it);
+            }
+            return true;
+        }
+
+        case RHICaptureOpcode::AllocateDescriptorSet: {
+            const RHICommandHandle handle = reader.Read<RHICommandHandle>();
+            auto* pool = reader.ReadObject<RHIDescriptorPool>();
+            const auto* layout = reader.ReadObject<const RHIDescriptorSetLayout>();
+            if (reader.IsOverrun()) { return false; }
+
+            if (pool) { Bind(handle, pool->AllocateDescriptorSet(layout), inFrame); }
+            return true;
+        }
+        case RHICaptureOpcode::FreeDescriptorSet: {
+            const RHICommandHandle handle = reader.Read<RHICommandHandle>();
+            auto* pool = reader.ReadObject<RHIDescriptorPool>();
+            if (reader.IsOverrun()) { return false; }
+
+            // The pool takes the set over, as it did in the capturing process
+            const auto it = m_Objects.find(handle);
+            if (pool && it != m_Objects.end() && it->second.Owned && (!inFrame || it->second.FrameLocal)) {
+                pool->FreeDescriptorSet(static_cast<RHIDescriptorSet*>(it->second.Owned.release()));
+                m_Objects.erase(it);
+            }
+            return true;
+        }
+        case RHICaptureOpcode::ResetDescriptorPool: {
+            auto* pool = reader.ReadObject<RHIDescriptorPool>();
+            if (reader.IsOverrun()) { return false; }
+
+            if (pool) { pool->Reset(); }
+            return true;
+        }
+        case RHICaptureOpcode::UpdateDescriptorSets: {
+            const std::span<const RHIWriteDescriptorSet> writes = reader.ReadWrites();
+            if (reader.IsOverrun()) { return false; }
+
+            m_pTarget->UpdateDescriptorSets(writes);
+            return true;
+        }
+        case RHICaptureOpcode::CopyDescriptorSets: {
+            const std::span<const RHICopyDescriptorSet> copies = reader.ReadCopies();
+            if (reader.IsOverrun()) { return false; }
+
+            m_pTarget->CopyDescriptorSets(copies);
+            return true;
+        }
+        case RHICaptureOpcode::UpdateDescriptorSetWithTemplate:
+            return ExecuteTemplateUpdate(reader);
+
+        case RHICaptureOpcode::BeginFrame:
+            m_pTarget->BeginFrame();
+            return true;
+        case RHICaptureOpcode::EndFrame: {
+            RHIQueue* queue = m_pTarget->GetQueue(RHIQueueType::Graphics);
+            m_pTarget->EndFrame(queue);
+
+            // Paced on a fence of its own, the captured application's fences are not part of the capture
+            if (queue && m_FrameFence) {
+                queue->Signal(m_FrameFence.get(), ++m_FrameFenceValue);
+                if (m_FrameFenceValue > MaxFramesInFlight) {
+                    m_FrameFence->WaitForValue(m_FrameFenceValue - MaxFramesInFlight);
+                }
+            }
+            return true;
+        }
+        case RHICaptureOpcode::Submit:
+            return ExecuteSubmit(reader);
+
+        default:
+            return false;
+    }
+}
+
+bool RHICaptureReplayer::ExecuteSubmit(RHICaptureReader& reader) {
+    const auto [type, listCount] = reader.ReadAll<RHIQueueType, uint32>();
+    if (reader.IsOverrun() || type >= RHIQueueType::Count || listCount > reader.GetRemainingSize() / sizeof(uint64)) {
+        return false;
+    }
+
+    // Targets without the captured queue run the lists on the graphics queue
+    RHIQueue* queue = m_pTarget->GetQueue(type);
+    RHICommandListManager* manager = m_pTarget->GetCommandListManager(type);
+    if (!queue || !manager) {
+        queue = m_pTarget->GetQueue(RHIQueueType::Graphics);
+        manager = m_pTarget->GetCommandListManager(RHIQueueType::Graphics);
+    }
+    if (!queue || !manager) { return false; }
+
+    std::vector<const RHICommandList*> commandLists;
+    commandLists.reserve(listCount);
+    bool valid = true;
+
+    for (uint32 i = 0; i < listCount && valid; ++i) {
+        valid = reader.ReadStream(m_Stream);
+        if (!valid) { break; }
+
+        RHICommandList* commandList = manager->Acquire();
+        if (!commandList) { return false; }
+
+        commandList->Begin();
+        valid = m_Decoder.Decode(m_Stream, *commandList);
+        commandList->End();
+        commandLists.push_back(commandList);
+
+        m_Stats.DecodedCommandCount += m_Stream.GetPacketCount();
+    }
+
+    // Acquired lists are submitted even after a failure, the manager expects them back through the queue
+    queue->SubmitCommandLists(commandLists);
+    m_Stats.SubmittedListCount += commandLists.size();
+    return valid;
+}
+
+bool RHICaptureReplayer::ExecuteTemplateUpdate(RHICaptureReader& reader) {
+    auto* set = reader.ReadObject<RHIDescriptorSet>();
+    const RHICommandHandle templateHandle = reader.Read<RHICommandHandle>();
+    const uint64 dataSize = reader.Read<uint64>();
+    const std::span<const std::byte> data = reader.ReadBytes(dataSize);
+    if (reader.IsOverrun()) { return false; }
+
+    const auto entries = m_TemplateEntries.find(templateHandle);
+    auto* updateTemplate = static_cast<const RHIDescriptorUpdateTemplate*>(Resolve(templateHandle));
+    if (!set || !updateTemplate || entries == m_TemplateEntries.end()) { return true; }
+
+    // The data holds the captured objects' addresses, they are swapped for the replayed ones in place
+    m_TemplateData.assign(data.begin(), data.end());
+    for (const RHIDescriptorUpdateTemplateEntry& entry: entries->second) {
+        const uint64 elementSize = GetDescriptorUpdateTemplateElementSize(entry.DescriptorType);
+        const uint64 stride = entry.Stride != 0 ? entry.Stride : elementSize;
+
+        for (uint32 i = 0; i < entry.DescriptorCount; ++i) {
+            const uint64 offset = entry.Offset + i * stride;
+            if (offset + elementSize > m_TemplateData.size()) { return false; }
+            std::byte* element = m_TemplateData.data() + offset;
+
+            // Buffer infos start with the buffer, every other element is a single pointer
+            const void* object = nullptr;
+            std::memcpy(&object, element, sizeof(object));
+            object = Resolve(ToRHICommandHandle(object));
+            std::memcpy(element, &object, sizeof(object));
+        }
+    }
+
+    m_pTarget->UpdateDescriptorSetWithTemplate(set, updateTemplate, m_TemplateData.data());
+    return true;
+}
+
+RHIResource* RHICaptureReplayer::Resolve(RHICommandHandle handle) {
+    if (handle == 0) { return nullptr; }
+
+    const auto it = m_Objects.find(handle);
+    if (it == m_Objects.end()) {
+        ++m_Stats.UnresolvedHandleCount;
+        return nullptr;
+    }
+    return it->second.pObject;
+}
+
+void RHICaptureReplayer::Bind(RHICommandHandle handle, Scope<RHIResource> object, bool frameLocal) {
+    if (!object) {
+        Internal::LogWarn("RHICaptureReplayer: The target failed to create object {0:#x}", handle);
+        return;
+    }
+
+    // The capturing process reused the address of an object it dropped without DestroyResource
+    Object& entry = m_Objects[handle];
+    Retire(entry);
+
+    entry.pObject = object.get();
+    entry.Owned = std::move(object);
+    entry.Sequence = m_NextSequence++;
+    entry.FrameLocal = frameLocal;
+}
+
+void RHICaptureReplayer::Retire(Object& object) {
+    if (object.Owned) { m_pTarget->DestroyResource(object.Owned.release()); }
+    object.pObject = nullptr;
+}
+
+} // namespace iGe
@@ -0,0 +1,102 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.RHI:RHICaptureReplay;
+import :RHI;
+import :RHIResource;
+import :RHIFence;
+import :RHIDescriptor;
+import :RHICommandStream;
+import :RHICommandEncoder;
+import :RHICapture;
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Capture Replayer
+// =================================================================================================
+
+export struct RHICaptureReplayStats {
+    uint64 SubmittedListCount = 0;
+    uint64 DecodedCommandCount = 0;
+    uint64 UnresolvedHandleCount = 0; // Handles of objects the capture never created, replayed as nullptr
+};
+
+// Replays a capture written by RHICaptureRHI on any device. Setup creates the objects recorded before the
+// first captured frame, the frames can then be replayed as often as wanted. Objects created inside the frames
+// are created again on every replay, objects from the setup live until Teardown.
+export class IGE_API RHICaptureReplayer {
+public:
+    explicit RHICaptureReplayer(RHI* pTarget);
+    ~RHICaptureReplayer();
+
+    RHICaptureReplayer(const RHICaptureReplayer&) = delete;
+    RHICaptureReplayer& operator=(const RHICaptureReplayer&) = delete;
+
+    bool Load(const std::filesystem::path& path);
+    bool Setup();
+    // Returns false on the first malformed record, the frame is ended regardless
+    bool ReplayFrame(uint32 frameIndex);
+    // Waits for the device and destroys every replayed object
+    void Teardown();
+
+    uint32 GetFrameCount() const { return static_cast<uint32>(m_Frames.size()); }
+    const RHICaptureReplayStats& GetStats() const { return m_Stats; }
+
+    // Frames the replay runs ahead of the GPU
+    static constexpr uint32 MaxFramesInFlight = 2;
+
+private:
+    struct Record {
+        RHICaptureOpcode Opcode = RHICaptureOpcode::Invalid;
+        std::span<const std::byte> Payload;
+    };
+
+    struct Object {
+        Scope<RHIResource> Owned; // Empty for objects of the target, such as its constant buffer
+        RHIResource* pObject = nullptr;
+        uint64 Sequence = 0;     // Creation order, teardown runs backwards
+        bool FrameLocal = false; // Created inside a frame
+    };
+
+    bool Execute(const Record& record, bool inFrame);
+    bool ExecuteSubmit(RHICaptureReader& reader);
+    bool ExecuteTemplateUpdate(RHICaptureReader& reader);
+
+    template<typename Info, typename Function>
+    bool Create(RHICaptureReader& reader, bool inFrame, Function&& create) {
+        const RHICommandHandle handle = reader.Read<RHICommandHandle>();
+        Info info{};
+        if (!reader.ReadInfo(info)) { return false; }
+
+        Bind(handle, create(info), inFrame);
+        return true;
+    }
+
+    RHIResource* Resolve(RHICommandHandle handle);
+    void Bind(RHICommandHandle handle, Scope<RHIResource> object, bool frameLocal);
+    void Retire(Object& object);
+
+    RHI* m_pTarget = nullptr;
+
+    std::vector<std::byte> m_Data; // Records point into it
+    std::vector<Record> m_SetupRecords;
+    std::vector<std::vector<Record>> m_Frames;
+
+    std::unordered_map<RHICommandHandle, Object> m_Objects;
+    std::unordered_map<RHICommandHandle, std::vector<RHIDescriptorUpdateTemplateEntry>> m_TemplateEntries;
+    uint64 m_NextSequence = 0;
+
+    RHICommandDecoder m_Decoder;
+    RHICommandStream m_Stream;
+    std::vector<std::byte> m_TemplateData;
+
+    Scope<RHIFence> m_FrameFence;
+    uint64 m_FrameFenceValue = 0;
+
+    RHICaptureReplayStats m_Stats;
+};
+
+} // namespace iGe
@@ -0,0 +1,737 @@
+module iGe.RHI;
+import :RHICommandEncoder;
+
+namespace iGe
+{
+
+namespace
+{
+static_assert(sizeof(RHIClearValue) == 16);
+
+constexpr uint32 AttachmentSize = sizeof(RHICommandHandle) + sizeof(RHIClearValue);
+constexpr uint32 WriteSize = sizeof(RHICommandHandle) + 6 * sizeof(uint32);
+constexpr uint32 BufferInfoSize = sizeof(RHICommandHandle) + 2 * sizeof(uint64);
+constexpr uint32 ImageInfoSize = 2 * sizeof(RHICommandHandle) + sizeof(uint32);
+constexpr uint32 MemoryBarrierSize = 4 * sizeof(uint32);
+constexpr uint32 BufferBarrierSize = sizeof(RHICommandHandle) + 2 * sizeof(uint64) + 6 * sizeof(uint32);
+constexpr uint32 TextureBarrierSize = sizeof(RHICommandHandle) + 8 * sizeof(uint32);
+constexpr uint32 RegionSize = sizeof(uint64) + 6 * sizeof(uint32);
+
+// Rejects counts a corrupted packet could not hold before anything is resized by them
+bool FitsPayload(const RHICommandPayloadReader& reader, uint64 count, uint64 elementSize) {
+    return count * elementSize <= reader.GetRemainingSize();
+}
+
+template<typename T>
+T ReadFlags(RHICommandPayloadReader& reader) {
+    return T(reader.Read<typename T::Underlying>());
+}
+} // namespace
+
+// =================================================================================================
+// RHICommandEncoder
+// =================================================================================================
+
+RHICommandStream RHICommandEncoder::TakeStream() {
+    RHICommandStream stream = std::move(m_Stream);
+    m_Stream = RHICommandStream(m_ChunkSize);
+    return stream;
+}
+
+void RHICommandEncoder::BeginRenderPass(const RHIRenderPassBeginInfo& info) {
+    const uint32 colorCount = static_cast<uint32>(info.ColorAttachments.size());
+    const uint32 hasDepth = info.pDepthStencilAttachment ? 1 : 0;
+
+    auto writer = BeginPacket(RHICommandOpcode::BeginRenderPass, (colorCount + hasDepth) * AttachmentSize,
+                              ToRHICommandHandle(info.pRenderPass), colorCount, hasDepth, info.RenderAreaOffset.X,
+                              info.RenderAreaOffset.Y, info.RenderAreaExtent.Width, info.RenderAreaExtent.Height,
+                              info.PassFlags.GetValue());
+    for (const RHIAttachmentBinding& binding: info.ColorAttachments) {
+        writer.Write(ToRHICommandHandle(binding.pTextureView));
+        writer.Write(binding.ClearValue);
+    }
+    if (hasDepth) {
+        writer.Write(ToRHICommandHandle(info.pDepthStencilAttachment->pTextureView));
+        writer.Write(info.pDepthStencilAttachment->ClearValue);
+    }
+}
+
+void RHICommandEncoder::BindGraphicsPipeline(const RHIGraphicsPipeline* pipeline) {
+    Emit(RHICommandOpcode::BindGraphicsPipeline, ToRHICommandHandle(pipeline));
+}
+
+void RHICommandEncoder::BindComputePipeline(const RHIComputePipeline* pipeline) {
+    Emit(RHICommandOpcode::BindComputePipeline, ToRHICommandHandle(pipeline));
+}
+
+void RHICommandEncoder::BindDescriptorSet(const RHIPipelineLayout* layout, uint32 setIndex,
+                                          const RHIDescriptorSet* descriptorSet,
+                                          std::span<const uint32> dynamicOffsets) {
+    const uint32 offsetCount = static_cast<uint32>(dynamicOffsets.size());
+    auto writer = BeginPacket(RHICommandOpcode::BindDescriptorSet, offsetCount * sizeof(uint32),
+                              ToRHICommandHandle(layout), setIndex, ToRHICommandHandle(descriptorSet), offsetCount);
+    writer.WriteBytes(dynamicOffsets.data(), offsetCount * sizeof(uint32));
+}
+
+void RHICommandEncoder::BindTransientDescriptors(const RHIPipelineLayout* layout, uint32 setIndex,
+                                                 const RHIDescriptorSetLayout* setLayout,
+                                                 std::span<const RHIWriteDescriptorSet> writes) {
+    // Every write is followed by its buffer or image infos
+    uint32 trailingSize = 0;
+    for (const RHIWriteDescriptorSet& write: writes) {
+        trailingSize += WriteSize;
+        if (write.pBufferInfos) { trailingSize += write.DescriptorCount * BufferInfoSize; }
+        if (write.pImageInfos) { trailingSize += write.DescriptorCount * ImageInfoSize; }
+    }
+
+    auto writer = BeginPacket(RHICommandOpcode::BindTransientDescriptors, trailingSize, ToRHICommandHandle(layout),
+                              setIndex, ToRHICommandHandle(setLayout), static_cast<uint32>(writes.size()));
+    for (const RHIWriteDescriptorSet& write: writes) {
+        const uint32 bufferInfoCount = write.pBufferInfos ? write.DescriptorCount : 0;
+        const uint32 imageInfoCount = write.pImageInfos ? write.DescriptorCount : 0;
+        writer.Write(ToRHICommandHandle(write.pDstSet));
+        writer.Write(write.DstBinding);
+        writer.Write(write.DstArrayElement);
+        writer.Write(write.DescriptorCount);
+        writer.Write(write.DescriptorType);
+        writer.Write(bufferInfoCount);
+        writer.Write(imageInfoCount);
+
+        for (uint32 i = 0; i < bufferInfoCount; ++i) {
+            writer.Write(ToRHICommandHandle(write.pBufferInfos[i].pBuffer));
+            writer.Write(write.pBufferInfos[i].Offset);
+            writer.Write(write.pBufferInfos[i].Range);
+        }
+        for (uint32 i = 0; i < imageInfoCount; ++i) {
+            writer.Write(ToRHICommandHandle(write.pImageInfos[i].pSampler));
+            writer.Write(ToRHICommandHandle(write.pImageInfos[i].pTextureView));
+            writer.Write(write.pImageInfos[i].ImageLayout);
+        }
+    }
+}
+
+void RHICommandEncoder::BindVertexBuffer(const RHIVertexBuffer* buffer, uint32 binding, uint64 offset) {
+    Emit(RHICommandOpcode::BindVertexBuffer, ToRHICommandHandle(buffer), binding, offset);
+}
+
+void RHICommandEncoder::BindIndexBuffer(const RHIIndexBuffer* buffer, uint64 offset) {
+    Emit(RHICommandOpcode::BindIndexBuffer, ToRHICommandHandle(buffer), offset);
+}
+
+void RHICommandEncoder::PushConstants(const RHIPipelineLayout* layout, Flags<RHIShaderStage> stageFlags,
+                                      uint32 offset, uint32 size, const void* data) {
+    const uint32 dataSize = data ? size : 0;
+    auto writer = BeginPacket(RHICommandOpcode::PushConstants, dataSize, ToRHICommandHandle(layout),
+                              stageFlags.GetValue(), offset, dataSize);
+    writer.WriteBytes(data, dataSize);
+}
+
+void RHICommandEncoder::SetViewport(const RHIViewport& viewport) {
+    Emit(RHICommandOpcode::SetViewport, viewport.X, viewport.Y, viewport.Width, viewport.Height, viewport.MinDepth,
+         viewport.MaxDepth);
+}
+
+void RHICommandEncoder::SetScissor(const RHIScissor& scissor) {
+    Emit(RHICommandOpcode::SetScissor, scissor.X, scissor.Y, scissor.Width, scissor.Height);
+}
+
+void RHICommandEncoder::SetLineWidth(float lineWidth) { Emit(RHICommandOpcode::SetLineWidth, lineWidth); }
+
+void RHICommandEncoder::SetDepthBias(float constantFactor, float clamp, float slopeFactor) {
+    Emit(RHICommandOpcode::SetDepthBias, constantFactor, clamp, slopeFactor);
+}
+
+void RHICommandEncoder::SetBlendConstants(const float blendConstants[4]) {
+    Emit(RHICommandOpcode::SetBlendConstants, blendConstants[0], blendConstants[1], blendConstants[2],
+         blendConstants[3]);
+}
+
+void RHICommandEncoder::SetDepthBounds(float minDepthBounds, float maxDepthBounds) {
+    Emit(RHICommandOpcode::SetDepthBounds, minDepthBounds, maxDepthBounds);
+}
+
+void RHICommandEncoder::SetStencilCompareMask(bool front, bool back, uint32 compareMask) {
+    Emit(RHICommandOpcode::SetStencilCompareMask, static_cast<uint32>(front), static_cast<uint32>(back), compareMask);
+}
+
+void RHICommandEncoder::SetStencilWriteMask(bool front, bool back, uint32 writeMask) {
+    Emit(RHICommandOpcode::SetStencilWriteMask, static_cast<uint32>(front), static_cast<uint32>(back), writeMask);
+}
+
+void RHICommandEncoder::SetStencilReference(bool front, bool back, uint32 reference) {
+    Emit(RHICommandOpcode::SetStencilReference, static_cast<uint32>(front), static_cast<uint32>(back), reference);
+}
+
+void RHICommandEncoder::Draw(uint32 vertexCount, uint32 instanceCount, uint32 firstVertex, uint32 firstInstance) {
+    Emit(RHICommandOpcode::Draw, vertexCount, instanceCount, firstVertex, firstInstance);
+}
+
+void RHICommandEncoder::DrawIndexed(uint32 indexCount, uint32 instanceCount, uint32 firstIndex, int32 vertexOffset,
+                                    uint32 firstInstance) {
+    Emit(RHICommandOpcode::DrawIndexed, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+}
+
+void RHICommandEncoder::Dispatch(uint32 groupCountX, uint32 groupCountY, uint32 groupCountZ) {
+    Emit(RHICommandOpcode::Dispatch, groupCountX, groupCountY, groupCountZ);
+}
+
+void RHICommandEncoder::TransitionTexture(const RHITexture* texture, RHILayout newLayout) {
+    Emit(RHICommandOpcode::TransitionTexture, ToRHICommandHandle(texture), newLayout);
+}
+
+void RHICommandEncoder::TransitionTexture(const RHITexture* texture, RHILayout newLayout, uint32 mipLevel,
+                                          uint32 arrayLayer) {
+    Emit(RHICommandOpcode::TransitionTextureSubresource, ToRHICommandHandle(texture), newLayout, mipLevel,
+         arrayLayer);
+}
+
+void RHICommandEncoder::TransitionBuffer(const RHIBuffer* buffer, RHILayout newLayout) {
+    Emit(RHICommandOpcode::TransitionBuffer, ToRHICommandHandle(buffer), newLayout);
+}
+
+void RHICommandEncoder::ResourceBarrier(const RHITexture* texture, RHILayout oldLayout, RHILayout newLayout) {
+    Emit(RHICommandOpcode::ResourceBarrier, ToRHICommandHandle(texture), oldLayout, newLayout);
+}
+
+void RHICommandEncoder::PipelineBarrier(const RHIBarrierBatch* barriers) {
+    if (!barriers) { return; }
+
+    const uint32 memoryCount = static_cast<uint32>(barriers->MemoryBarriers.size());
+    const uint32 bufferCount = static_cast<uint32>(barriers->BufferBarriers.size());
+    const uint32 textureCount = static_cast<uint32>(barriers->TextureBarriers.size());
+    const uint32 trailingSize =
+            memoryCount * MemoryBarrierSize + bufferCount * BufferBarrierSize + textureCount * TextureBarrierSize;
+
+    auto writer = BeginPacket(RHICommandOpcode::PipelineBarrier, trailingSize, memoryCount, bufferCount,
+                              textureCount, static_cast<uint32>(barriers->ByRegion));
+    for (const RHIMemoryBarrier& barrier: barriers->MemoryBarriers) {
+        writer.Write(barrier.SrcStageMask.GetValue());
+        writer.Write(barrier.DstStageMask.GetValue());
+        writer.Write(barrier.SrcAccessMask.GetValue());
+        writer.Write(barrier.DstAccessMask.GetValue());
+    }
+    for (const RHIBufferMemoryBarrier& barrier: barriers->BufferBarriers) {
+        writer.Write(ToRHICommandHandle(barrier.pBuffer));
+        writer.Write(barrier.Offset);
+        writer.Write(barrier.Size);
+        writer.Write(barrier.SrcStageMask.GetValue());
+        writer.Write(barrier.DstStageMask.GetValue());
+        writer.Write(barrier.SrcAccessMask.GetValue());
+        writer.Write(barrier.DstAccessMask.GetValue());
+        writer.Write(barrier.SrcQueueFamilyIndex);
+        writer.Write(barrier.DstQueueFamilyIndex);
+    }
+    for (const RHITextureMemoryBarrier& barrier: barriers->TextureBarriers) {
+        writer.Write(ToRHICommandHandle(barrier.pTexture));
+        writer.Write(barrier.OldLayout);
+        writer.Write(barrier.NewLayout);
+        writer.Write(barrier.SrcStageMask.GetValue());
+        writer.Write(barrier.DstStageMask.GetValue());
+        writer.Write(barrier.SrcAccessMask.GetValue());
+        writer.Write(barrier.DstAccessMask.GetValue());
+        writer.Write(barrier.SrcQueueFamilyIndex);
+        writer.Write(barrier.DstQueueFamilyIndex);
+    }
+}
+
+void RHICommandEncoder::CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture) {
+    Emit(RHICommandOpcode::CopyBufferToTexture, ToRHICommandHandle(srcBuffer), ToRHICommandHandle(dstTexture));
+}
+
+void RHICommandEncoder::CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture,
+                                            const RHIBufferTextureCopy& region) {
+    CopyBufferToTexture(srcBuffer, dstTexture, {&region, 1});
+}
+
+void RHICommandEncoder::CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture,
+                                            std::span<const RHIBufferTextureCopy> regions) {
+    const uint32 regionCount = static_cast<uint32>(regions.size());
+    auto writer = BeginPacket(RHICommandOpcode::CopyBufferToTextureRegions, regionCount * RegionSize,
+                              ToRHICommandHandle(srcBuffer), ToRHICommandHandle(dstTexture), regionCount);
+    for (const RHIBufferTextureCopy& region: regions) {
+        writer.Write(region.BufferOffset);
+        writer.Write(region.BufferRowPitch);
+        writer.Write(region.MipLevel);
+        writer.Write(region.ArrayLayer);
+        writer.Write(region.Extent.Width);
+        writer.Write(region.Extent.Height);
+        writer.Write(region.Extent.Depth);
+    }
+}
+
+void RHICommandEncoder::CopyTextureToBuffer(const RHITexture* srcTexture, const RHIBuffer* dstBuffer) {
+    Emit(RHICommandOpcode::CopyTextureToBuffer, ToRHICommandHandle(srcTexture), ToRHICommandHandle(dstBuffer));
+}
+
+void RHICommandEncoder::CopyBuffer(const RHIBuffer* srcBuffer, const RHIBuffer* dstBuffer, uint64 srcOffset,
+                                   uint64 dstOffset, uint64 size) {
+    Emit(RHICommandOpcode::CopyBuffer, ToRHICommandHandle(srcBuffer), ToRHICommandHandle(dstBuffer), srcOffset,
+         dstOffset, size);
+}
+
+void RHICommandEncoder::BlitTexture(const RHITexture* srcTexture, const RHITexture* dstTexture,
+                                    RHISamplerFilter filter) {
+    Emit(RHICommandOpcode::BlitTexture, ToRHICommandHandle(srcTexture), ToRHICommandHandle(dstTexture), filter);
+}
+
+void RHICommandEncoder::ClearColorAttachment(uint32 attachmentIndex, const float color[4], const RHIRect2D& rect) {
+    Emit(RHICommandOpcode::ClearColorAttachment, attachmentIndex, color[0], color[1], color[2], color[3],
+         rect.Offset.X, rect.Offset.Y, rect.Extent.Width, rect.Extent.Height);
+}
+
+void RHICommandEncoder::ClearDepthStencilAttachment(float depth, uint32 stencil, bool clearDepth, bool clearStencil,
+                                                    const RHIRect2D& rect) {
+    Emit(RHICommandOpcode::ClearDepthStencilAttachment, depth, stencil, static_cast<uint32>(clearDepth),
+         static_cast<uint32>(clearStencil), rect.Offset.X, rect.Offset.Y, rect.Extent.Width, rect.Extent.Height);
+}
+
+void RHICommandEncoder::ClearTexture(const RHITexture* texture, const float color[4]) {
+    Emit(RHICommandOpcode::ClearTexture, ToRHICommandHandle(texture), color[0], color[1], color[2], color[3]);
+}
+
+void RHICommandEncoder::ClearBuffer(const RHIBuffer* buffer, uint32 value, uint64 offset, uint64 size) {
+    Emit(RHICommandOpcode::ClearBuffer, ToRHICommandHandle(buffer), value, offset, size);
+}
+
+void RHICommandEncoder::WriteTimestamp(const RHIQueryPool* pool, uint32 index) {
+    Emit(RHICommandOpcode::WriteTimestamp, ToRHICommandHandle(pool), index);
+}
+
+void RHICommandEncoder::BeginQuery(const RHIQueryPool* pool, uint32 index) {
+    Emit(RHICommandOpcode::BeginQuery, ToRHICommandHandle(pool), index);
+}
+
+void RHICommandEncoder::EndQuery(const RHIQueryPool* pool, uint32 index) {
+    Emit(RHICommandOpcode::EndQuery, ToRHICommandHandle(pool), index);
+}
+
+void RHICommandEncoder::ResolveQueries(const RHIQueryPool* pool, uint32 firstIndex, uint32 count,
+                                       const RHIBuffer* dstBuffer, uint64 dstOffset) {
+    Emit(RHICommandOpcode::ResolveQueries, ToRHICommandHandle(pool), firstIndex, count, ToRHICommandHandle(dstBuffer),
+         dstOffset);
+}
+
+void RHICommandEncoder::BeginDebugLabel(const std::string& label, const float color[4]) {
+    EmitDebugLabel(RHICommandOpcode::BeginDebugLabel, label, color);
+}
+
+void RHICommandEncoder::InsertDebugLabel(const std::string& label, const float color[4]) {
+    EmitDebugLabel(RHICommandOpcode::InsertDebugLabel, label, color);
+}
+
+void RHICommandEncoder::EmitDebugLabel(RHICommandOpcode opcode, const std::string& label, const float color[4]) {
+    static constexpr float s_NoColor[4] = {};
+    const float* labelColor = color ? color : s_NoColor;
+    const uint32 length = static_cast<uint32>(label.size());
+
+    auto writer = BeginPacket(opcode, length, static_cast<uint32>(color != nullptr), labelColor[0], labelColor[1],
+                              labelColor[2], labelColor[3], length);
+    writer.WriteBytes(label.data(), length);
+}
+
+// =================================================================================================
+// RHICommandDecoder
+// =================================================================================================
+
+bool RHICommandDecoder::Decode(const RHICommandStream& stream, RHICommandList& target) {
+    bool valid = true;
+    stream.ForEachPacket([&](const RHICommandPacket& packet) {
+        if (valid) { valid = DecodePacket(packet, target); }
+    });
+    return valid;
+}
+
+bool RHICommandDecoder::DecodePacket(const RHICommandPacket& packet, RHICommandList& target) {
+    RHICommandPayloadReader reader(packet.Payload);
+    bool valid = true;
+
+    switch (packet.Opcode) {
+        case RHICommandOpcode::BeginRenderPass:
+            valid = DecodeBeginRenderPass(reader, target);
+            break;
+        case RHICommandOpcode::EndRenderPass:
+            target.EndRenderPass();
+            break;
+        case RHICommandOpcode::NextSubpass:
+            target.NextSubpass();
+            break;
+
+        case RHICommandOpcode::BindGraphicsPipeline:
+            target.BindGraphicsPipeline(Resolve<const RHIGraphicsPipeline>(reader.Read<uint64>()));
+            break;
+        case RHICommandOpcode::BindComputePipeline:
+            target.BindComputePipeline(Resolve<const RHIComputePipeline>(reader.Read<uint64>()));
+            break;
+        case RHICommandOpcode::BindDescriptorSet: {
+            auto [layout, setIndex, descriptorSet, offsetCount] = reader.ReadAll<uint64, uint32, uint64, uint32>();
+            if (!FitsPayload(reader, offsetCount, sizeof(uint32))) {
+                valid = false;
+                break;
+            }
+            m_DynamicOffsets.resize(offsetCount);
+            for (uint32& offset: m_DynamicOffsets) { offset = reader.Read<uint32>(); }
+            if (reader.IsOverrun()) { break; }
+            target.BindDescriptorSet(Resolve<const RHIPipelineLayout>(layout), setIndex,
+                                     Resolve<const RHIDescriptorSet>(descriptorSet), m_DynamicOffsets);
+            break;
+        }
+        case RHICommandOpcode::BindTransientDescriptors:
+            valid = DecodeBindTransientDescriptors(reader, target);
+            break;
+        case RHICommandOpcode::BindVertexBuffer: {
+            auto [buffer, binding, offset] = reader.ReadAll<uint64, uint32, uint64>();
+            target.BindVertexBuffer(Resolve<const RHIVertexBuffer>(buffer), binding, offset);
+            break;
+        }
+        case RHICommandOpcode::BindIndexBuffer: {
+            auto [buffer, offset] = reader.ReadAll<uint64, uint64>();
+            target.BindIndexBuffer(Resolve<const RHIIndexBuffer>(buffer), offset);
+            break;
+        }
+        case RHICommandOpcode::PushConstants: {
+            auto [layout, stageFlags, offset, size] = reader.ReadAll<uint64, uint32, uint32, uint32>();
+            const std::span<const std::byte> data = reader.ReadBytes(size);
+            if (reader.IsOverrun()) { break; }
+            target.PushConstants(Resolve<const RHIPipelineLayout>(layout), Flags<RHIShaderStage>(stageFlags), offset,
+                                 size, data.data());
+            break;
+        }
+
+        case RHICommandOpcode::SetViewport: {
+            RHIViewport viewport{};
+            std::tie(viewport.X, viewport.Y, viewport.Width, viewport.Height, viewport.MinDepth, viewport.MaxDepth) =
+                    reader.ReadAll<float, float, float, float, float, float>();
+            target.SetViewport(viewport);
+            break;
+        }
+        case RHICommandOpcode::SetScissor: {
+            RHIScissor scissor{};
+            std::tie(scissor.X, scissor.Y, scissor.Width, scissor.Height) =
+                    reader.ReadAll<int32, int32, uint32, uint32>();
+            target.SetScissor(scissor);
+            break;
+        }
+        case RHICommandOpcode::SetLineWidth:
+            target.SetLineWidth(reader.Read<float>());
+            break;
+        case RHICommandOpcode::SetDepthBias: {
+            auto [constantFactor, clamp, slopeFactor] = reader.ReadAll<float, float, float>();
+            target.SetDepthBias(constantFactor, clamp, slopeFactor);
+            break;
+        }
+        case RHICommandOpcode::SetBlendConstants: {
+            const auto [r, g, b, a] = reader.ReadAll<float, float, float, float>();
+            const float blendConstants[4] = {r, g, b, a};
+            target.SetBlendConstants(blendConstants);
+            break;
+        }
+        case RHICommandOpcode::SetDepthBounds: {
+            auto [minDepthBounds, maxDepthBounds] = reader.ReadAll<float, float>();
+            target.SetDepthBounds(minDepthBounds, maxDepthBounds);
+            break;
+        }
+        case RHICommandOpcode::SetStencilCompareMask: {
+            auto [front, back, compareMask] = reader.ReadAll<uint32, uint32, uint32>();
+            target.SetStencilCompareMask(front != 0, back != 0, compareMask);
+            break;
+        }
+        case RHICommandOpcode::SetStencilWriteMask: {
+            auto [front, back, writeMask] = reader.ReadAll<uint32, uint32, uint32>();
+            target.SetStencilWriteMask(front != 0, back != 0, writeMask);
+            break;
+        }
+        case RHICommandOpcode::SetStencilReference: {
+            auto [front, back, reference] = reader.ReadAll<uint32, uint32, uint32>();
+            target.SetStencilReference(front != 0, back != 0, reference);
+            break;
+        }
+
+        case RHICommandOpcode::Draw: {
+            auto [vertexCount, instanceCount, firstVertex, firstInstance] =
+                    reader.ReadAll<uint32, uint32, uint32, uint32>();
+            target.Draw(vertexCount, instanceCount, firstVertex, firstInstance);
+            break;
+        }
+        case RHICommandOpcode::DrawIndexed: {
+            auto [indexCount, instanceCount, firstIndex, vertexOffset, firstInstance] =
+                    reader.ReadAll<uint32, uint32, uint32, int32, uint32>();
+            target.DrawIndexed(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+            break;
+        }
+        case RHICommandOpcode::Dispatch: {
+            auto [groupCountX, groupCountY, groupCountZ] = reader.ReadAll<uint32, uint32, uint32>();
+            target.Dispatch(groupCountX, groupCountY, groupCountZ);
+            break;
+        }
+
+        case RHICommandOpcode::TransitionTexture: {
+            auto [texture, newLayout] = reader.ReadAll<uint64, RHILayout>();
+            target.TransitionTexture(Resolve<const RHITexture>(texture), newLayout);
+            break;
+        }
+        case RHICommandOpcode::TransitionTextureSubresource: {
+            auto [texture, newLayout, mipLevel, arrayLayer] = reader.ReadAll<uint64, RHILayout, uint32, uint32>();
+            target.TransitionTexture(Resolve<const RHITexture>(texture), newLayout, mipLevel, arrayLayer);
+            break;
+        }
+        case RHICommandOpcode::TransitionBuffer: {
+            auto [buffer, newLayout] = reader.ReadAll<uint64, RHILayout>();
+            target.TransitionBuffer(Resolve<const RHIBuffer>(buffer), newLayout);
+            break;
+        }
+        case RHICommandOpcode::ResourceBarrier: {
+            auto [texture, oldLayout, newLayout] = reader.ReadAll<uint64, RHILayout, RHILayout>();
+            target.ResourceBarrier(Resolve<const RHITexture>(texture), oldLayout, newLayout);
+            break;
+        }
+        case RHICommandOpcode::PipelineBarrier:
+            valid = DecodePipelineBarrier(reader, target);
+            break;
+
+        case RHICommandOpcode::CopyBufferToTexture: {
+            auto [srcBuffer, dstTexture] = reader.ReadAll<uint64, uint64>();
+            target.CopyBufferToTexture(Resolve<const RHIBuffer>(srcBuffer), Resolve<const RHITexture>(dstTexture));
+            break;
+        }
+        case RHICommandOpcode::CopyBufferToTextureRegions: {
+            auto [srcBuffer, dstTexture, regionCount] = reader.ReadAll<uint64, uint64, uint32>();
+            if (!FitsPayload(reader, regionCount, RegionSize)) {
+                valid = false;
+                break;
+            }
+            m_Regions.resize(regionCount);
+            for (RHIBufferTextureCopy& region: m_Regions) {
+                std::tie(region.BufferOffset, region.BufferRowPitch, region.MipLevel, region.ArrayLayer,
+                         region.Extent.Width, region.Extent.Height, region.Extent.Depth) =
+                        reader.ReadAll<uint64, uint32, uint32, uint32, uint32, uint32, uint32>();
+            }
+            if (reader.IsOverrun()) { break; }
+            target.CopyBufferToTexture(Resolve<const RHIBuffer>(srcBuffer), Resolve<const RHITexture>(dstTexture),
+                                       m_Regions);
+            break;
+        }
+        case RHICommandOpcode::CopyTextureToBuffer: {
+            auto [srcTexture, dstBuffer] = reader.ReadAll<uint64, uint64>();
+            target.CopyTextureToBuffer(Resolve<const RHITexture>(srcTexture), Resolve<const RHIBuffer>(dstBuffer));
+            break;
+        }
+        case RHICommandOpcode::CopyBuffer: {
+            auto [srcBuffer, dstBuffer, srcOffset, dstOffset, size] =
+                    reader.ReadAll<uint64, uint64, uint64, uint64, uint64>();
+            target.CopyBuffer(Resolve<const RHIBuffer>(srcBuffer), Resolve<const RHIBuffer>(dstBuffer), srcOffset,
+                              dstOffset, size);
+            break;
+        }
+        case RHICommandOpcode::BlitTexture: {
+            auto [srcTexture, dstTexture, filter] = reader.ReadAll<uint64, uint64, RHISamplerFilter>();
+            target.BlitTexture(Resolve<const RHITexture>(srcTexture), Resolve<const RHITexture>(dstTexture), filter);
+            break;
+        }
+
+        case RHICommandOpcode::ClearColorAttachment: {
+            auto [attachmentIndex, r, g, b, a] = reader.ReadAll<uint32, float, float, float, float>();
+            RHIRect2D rect{};
+            std::tie(rect.Offset.X, rect.Offset.Y, rect.Extent.Width, rect.Extent.Height) =
+                    reader.ReadAll<int32, int32, uint32, uint32>();
+            const float color[4] = {r, g, b, a};
+            target.ClearColorAttachment(attachmentIndex, color, rect);
+            break;
+        }
+        case RHICommandOpcode::ClearDepthStencilAttachment: {
+            auto [depth, stencil, clearDepth, clearStencil] = reader.ReadAll<float, uint32, uint32, uint32>();
+            RHIRect2D rect{};
+            std::tie(rect.Offset.X, rect.Offset.Y, rect.Extent.Width, rect.Extent.Height) =
+                    reader.ReadAll<int32, int32, uint32, uint32>();
+            target.ClearDepthStencilAttachment(depth, stencil, clearDepth != 0, clearStencil != 0, rect);
+            break;
+        }
+        case RHICommandOpcode::ClearTexture: {
+            auto [texture, r, g, b, a] = reader.ReadAll<uint64, float, float, float, float>();
+            const float color[4] = {r, g, b, a};
+            target.ClearTexture(Resolve<const RHITexture>(texture), color);
+            break;
+        }
+        case RHICommandOpcode::ClearBuffer: {
+            auto [buffer, value, offset, size] = reader.ReadAll<uint64, uint32, uint64, uint64>();
+            target.ClearBuffer(Resolve<const RHIBuffer>(buffer), value, offset, size);
+            break;
+        }
+
+        case RHICommandOpcode::WriteTimestamp:
+        case RHICommandOpcode::BeginQuery:
+        case RHICommandOpcode::EndQuery: {
+            auto [pool, index] = reader.ReadAll<uint64, uint32>();
+            const RHIQueryPool* queryPool = Resolve<const RHIQueryPool>(pool);
+            if (packet.Opcode == RHICommandOpcode::WriteTimestamp) {
+                target.WriteTimestamp(queryPool, index);
+            } else if (packet.Opcode == RHICommandOpcode::BeginQuery) {
+                target.BeginQuery(queryPool, index);
+            } else {
+                target.EndQuery(queryPool, index);
+            }
+            break;
+        }
+        case RHICommandOpcode::ResolveQueries: {
+            auto [pool, firstIndex, count, dstBuffer, dstOffset] =
+                    reader.ReadAll<uint64, uint32, uint32, uint64, uint64>();
+            target.ResolveQueries(Resolve<const RHIQueryPool>(pool), firstIndex, count,
+                                  Resolve<const RHIBuffer>(dstBuffer), dstOffset);
+            break;
+        }
+
+        case RHICommandOpcode::BeginDebugLabel:
+        case RHICommandOpcode::InsertDebugLabel: {
+            auto [hasColor, r, g, b, a, length] = reader.ReadAll<uint32, float, float, float, float, uint32>();
+            const std::span<const std::byte> chars = reader.ReadBytes(length);
+            if (reader.IsOverrun()) { break; }
+
+            const std::string label(reinterpret_cast<const char*>(chars.data()), chars.size());
+            const float color[4] = {r, g, b, a};
+            if (packet.Opcode == RHICommandOpcode::BeginDebugLabel) {
+                target.BeginDebugLabel(label, hasColor ? color : nullptr);
+            } else {
+                target.InsertDebugLabel(label, hasColor ? color : nullptr);
+            }
+            break;
+        }
+        case RHICommandOpcode::EndDebugLabel:
+            target.EndDebugLabel();
+            break;
+
+        default:
+            Internal::LogError("RHICommandDecoder: Unknown opcode {0}", static_cast<uint32>(packet.Opcode));
+            return false;
+    }
+
+    if (!valid || reader.IsOverrun()) {
+        Internal::LogError("RHICommandDecoder: Malformed {0} packet", GetRHICommandOpcodeName(packet.Opcode));
+        return false;
+    }
+    return true;
+}
+
+bool RHICommandDecoder::DecodeBeginRenderPass(RHICommandPayloadReader& reader, RHICommandList& target) {
+    RHIRenderPassBeginInfo info{};
+    auto [renderPass, colorCount, hasDepth, offsetX, offsetY, width, height, passFlags] =
+            reader.ReadAll<uint64, uint32, uint32, int32, int32, uint32, uint32, uint32>();
+    const uint64 attachmentCount = static_cast<uint64>(colorCount) + (hasDepth ? 1 : 0);
+    if (!FitsPayload(reader, attachmentCount, AttachmentSize)) { return false; }
+
+    m_Attachments.resize(attachmentCount);
+    for (RHIAttachmentBinding& binding: m_Attachments) {
+        binding.pTextureView = Resolve<const RHITextureView>(reader.Read<uint64>());
+        binding.ClearValue = reader.Read<RHIClearValue>();
+    }
+    if (reader.IsOverrun()) { return false; }
+
+    info.pRenderPass = Resolve<const RHIRenderPass>(renderPass);
+    info.ColorAttachments = std::span<const RHIAttachmentBinding>(m_Attachments).first(colorCount);
+    info.pDepthStencilAttachment = hasDepth ? &m_Attachments.back() : nullptr;
+    info.RenderAreaOffset = {offsetX, offsetY};
+    info.RenderAreaExtent = {width, height};
+    info.PassFlags = Flags<RHIRenderPassFlag>(passFlags);
+    target.BeginRenderPass(info);
+    return true;
+}
+
+bool RHICommandDecoder::DecodeBindTransientDescriptors(RHICommandPayloadReader& reader, RHICommandList& target) {
+    auto [layout, setIndex, setLayout, writeCount] = reader.ReadAll<uint64, uint32, uint64, uint32>();
+    if (!FitsPayload(reader, writeCount, WriteSize)) { return false; }
+
+    // Infos are gathered first and pointed at once all of them are read, the vectors may still grow
+    struct InfoRange {
+        uint32 FirstBufferInfo = 0;
+        uint32 FirstImageInfo = 0;
+        bool HasBufferInfos = false;
+        bool HasImageInfos = false;
+    };
+    std::vector<InfoRange> ranges(writeCount);
+    m_Writes.resize(writeCount);
+    m_BufferInfos.clear();
+    m_ImageInfos.clear();
+
+    for (uint32 i = 0; i < writeCount && !reader.IsOverrun(); ++i) {
+        RHIWriteDescriptorSet& write = m_Writes[i];
+        auto [dstSet, dstBinding, dstArrayElement, descriptorCount, descriptorType, bufferInfoCount, imageInfoCount] =
+                reader.ReadAll<uint64, uint32, uint32, uint32, RHIDescriptorType, uint32, uint32>();
+        // The target indexes the infos by DescriptorCount
+        if ((bufferInfoCount != 0 && bufferInfoCount != descriptorCount) ||
+            (imageInfoCount != 0 && imageInfoCount != descriptorCount)) {
+            return false;
+        }
+        write = {};
+        write.pDstSet = Resolve<RHIDescriptorSet>(dstSet);
+        write.DstBinding = dstBinding;
+        write.DstArrayElement = dstArrayElement;
+        write.DescriptorCount = descriptorCount;
+        write.DescriptorType = descriptorType;
+
+        ranges[i] = {static_cast<uint32>(m_BufferInfos.size()), static_cast<uint32>(m_ImageInfos.size()),
+                     bufferInfoCount > 0, imageInfoCount > 0};
+        for (uint32 j = 0; j < bufferInfoCount && !reader.IsOverrun(); ++j) {
+            auto [buffer, offset, range] = reader.ReadAll<uint64, uint64, uint64>();
+            m_BufferInfos.push_back({Resolve<const RHIBuffer>(buffer), offset, range});
+        }
+        for (uint32 j = 0; j < imageInfoCount && !reader.IsOverrun(); ++j) {
+            auto [sampler, textureView, imageLayout] = reader.ReadAll<uint64, uint64, RHILayout>();
+            m_ImageInfos.push_back({Resolve<const RHISampler>(sampler), Resolve<const RHITextureView>(textureView),
+                                    imageLayout});
+        }
+    }
+    if (reader.IsOverrun()) { return false; }
+
+    for (uint32 i = 0; i < writeCount; ++i) {
+        if (ranges[i].HasBufferInfos) { m_Writes[i].pBufferInfos = &m_BufferInfos[ranges[i].FirstBufferInfo]; }
+        if (ranges[i].HasImageInfos) { m_Writes[i].pImageInfos = &m_ImageInfos[ranges[i].FirstImageInfo]; }
+    }
+    target.BindTransientDescriptors(Resolve<const RHIPipelineLayout>(layout), setIndex,
+                                    Resolve<const RHIDescriptorSetLayout>(setLayout), m_Writes);
+    return true;
+}
+
+bool RHICommandDecoder::DecodePipelineBarrier(RHICommandPayloadReader& reader, RHICommandList& target) {
+    auto [memoryCount, bufferCount, textureCount, byRegion] = reader.ReadAll<uint32, uint32, uint32, uint32>();
+    const uint64 barrierSize = static_cast<uint64>(memoryCount) * MemoryBarrierSize +
+                               static_cast<uint64>(bufferCount) * BufferBarrierSize +
+                               static_cast<uint64>(textureCount) * TextureBarrierSize;
+    if (!FitsPayload(reader, 1, barrierSize)) { return false; }
+
+    m_MemoryBarriers.resize(memoryCount);
+    for (RHIMemoryBarrier& barrier: m_MemoryBarriers) {
+        barrier.SrcStageMask = ReadFlags<Flags<RHIPipelineStageFlagBits>>(reader);
+        barrier.DstStageMask = ReadFlags<Flags<RHIPipelineStageFlagBits>>(reader);
+        barrier.SrcAccessMask = ReadFlags<Flags<RHIDependencyAccess>>(reader);
+        barrier.DstAccessMask = ReadFlags<Flags<RHIDependencyAccess>>(reader);
+    }
+    m_BufferBarriers.resize(bufferCount);
+    for (RHIBufferMemoryBarrier& barrier: m_BufferBarriers) {
+        barrier.pBuffer = Resolve<const RHIBuffer>(reader.Read<uint64>());
+        std::tie(barrier.Offset, barrier.Size) = reader.ReadAll<uint64, uint64>();
+        barrier.SrcStageMask = ReadFlags<Flags<RHIPipelineStageFlagBits>>(reader);
+        barrier.DstStageMask = ReadFlags<Flags<RHIPipelineStageFlagBits>>(reader);
+        barrier.SrcAccessMask = ReadFlags<Flags<RHIDependencyAccess>>(reader);
+        barrier.DstAccessMask = ReadFlags<Flags<RHIDependencyAccess>>(reader);
+        std::tie(barrier.SrcQueueFamilyIndex, barrier.DstQueueFamilyIndex) = reader.ReadAll<uint32, uint32>();
+    }
+    m_TextureBarriers.resize(textureCount);
+    for (RHITextureMemoryBarrier& barrier: m_TextureBarriers) {
+        barrier.pTexture = Resolve<const RHITexture>(reader.Read<uint64>());
+        std::tie(barrier.OldLayout, barrier.NewLayout) = reader.ReadAll<RHILayout, RHILayout>();
+        barrier.SrcStageMask = ReadFlags<Flags<RHIPipelineStageFlagBits>>(reader);
+        barrier.DstStageMask = ReadFlags<Flags<RHIPipelineStageFlagBits>>(reader);
+        barrier.SrcAccessMask = ReadFlags<Flags<RHIDependencyAccess>>(reader);
+        barrier.DstAccessMask = ReadFlags<Flags<RHIDependencyAccess>>(reader);
+        std::tie(barrier.SrcQueueFamilyIndex, barrier.DstQueueFamilyIndex) = reader.ReadAll<uint32, uint32>();
+    }
+    if (reader.IsOverrun()) { return false; }
+
+    RHIBarrierBatch batch{};
+    batch.MemoryBarriers = m_MemoryBarriers;
+    batch.BufferBarriers = m_BufferBarriers;
+    batch.TextureBarriers = m_TextureBarriers;
+    batch.ByRegion = byRegion != 0;
+    target.PipelineBarrier(&batch);
+    return true;
+}
+
+} // namespace iGe
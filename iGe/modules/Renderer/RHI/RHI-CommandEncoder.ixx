@@ -0,0 +1,241 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.RHI:RHICommandEncoder;
+import :RHIResource;
+import :RHICommandList;
+import :RHICommandStream;
+import iGe.Common;
+
+namespace iGe
+{
+
+// Recorded objects are referenced by address, they must outlive the translation of the stream
+export using RHICommandHandle = uint64;
+
+export inline RHICommandHandle ToRHICommandHandle(const void* object) {
+    return static_cast<RHICommandHandle>(reinterpret_cast<std::uintptr_t>(object));
+}
+
+export template<typename T>
+T* FromRHICommandHandle(RHICommandHandle handle) {
+    return reinterpret_cast<T*>(static_cast<std::uintptr_t>(handle));
+}
+
+// =================================================================================================
+// Command Encoder
+// =================================================================================================
+
+// Front end that records into an RHICommandStream instead of a native list. Encoding is a few stores into
+// arena memory without any driver call or lock, so any number of threads can each record into their own
+// encoder. RHICommandDecoder later translates the stream into a backend list, possibly on another thread.
+export class IGE_API RHICommandEncoder final : public RHICommandList {
+public:
+    explicit RHICommandEncoder(uint32 chunkSize = RHICommandStream::DefaultChunkSize)
+        : m_Stream(chunkSize), m_ChunkSize(chunkSize) {}
+
+    const RHICommandStream& GetStream() const { return m_Stream; }
+    // Hands the recording over, the encoder continues with an empty stream
+    RHICommandStream TakeStream();
+
+    // ==========================================================================
+    // Command Buffer Lifecycle
+    // ==========================================================================
+
+    // Reset empties the stream, Begin and End leave it alone, the stream holds no lifecycle commands
+    void Reset() override { m_Stream.Clear(); }
+    void Begin() override {}
+    void End() override {}
+
+    // ==========================================================================
+    // Render Pass Commands
+    // ==========================================================================
+
+    void BeginRenderPass(const RHIRenderPassBeginInfo& info) override;
+    void EndRenderPass() override { Emit(RHICommandOpcode::EndRenderPass); }
+    void NextSubpass() override { Emit(RHICommandOpcode::NextSubpass); }
+
+    // ==========================================================================
+    // Pipeline Binding
+    // ==========================================================================
+
+    void BindGraphicsPipeline(const RHIGraphicsPipeline* pipeline) override;
+    void BindComputePipeline(const RHIComputePipeline* pipeline) override;
+
+    // ==========================================================================
+    // Descriptor Set Binding
+    // ==========================================================================
+
+    void BindDescriptorSet(const RHIPipelineLayout* layout, uint32 setIndex, const RHIDescriptorSet* descriptorSet,
+                           std::span<const uint32> dynamicOffsets = {}) override;
+    void BindTransientDescriptors(const RHIPipelineLayout* layout, uint32 setIndex,
+                                  const RHIDescriptorSetLayout* setLayout,
+                                  std::span<const RHIWriteDescriptorSet> writes) override;
+
+    // ==========================================================================
+    // Vertex/Index Buffer Binding
+    // ==========================================================================
+
+    void BindVertexBuffer(const RHIVertexBuffer* buffer, uint32 binding = 0, uint64 offset = 0) override;
+    void BindIndexBuffer(const RHIIndexBuffer* buffer, uint64 offset = 0) override;
+
+    // ==========================================================================
+    // Push Constants
+    // ==========================================================================
+
+    void PushConstants(const RHIPipelineLayout* layout, Flags<RHIShaderStage> stageFlags, uint32 offset, uint32 size,
+                       const void* data) override;
+
+    // ==========================================================================
+    // Dynamic State
+    // ==========================================================================
+
+    void SetViewport(const RHIViewport& viewport) override;
+    void SetScissor(const RHIScissor& scissor) override;
+    void SetLineWidth(float lineWidth) override;
+    void SetDepthBias(float constantFactor, float clamp, float slopeFactor) override;
+    void SetBlendConstants(const float blendConstants[4]) override;
+    void SetDepthBounds(float minDepthBounds, float maxDepthBounds) override;
+    void SetStencilCompareMask(bool front, bool back, uint32 compareMask) override;
+    void SetStencilWriteMask(bool front, bool back, uint32 writeMask) override;
+    void SetStencilReference(bool front, bool back, uint32 reference) override;
+
+    // ==========================================================================
+    // Draw Commands
+    // ==========================================================================
+
+    void Draw(uint32 vertexCount, uint32 instanceCount = 1, uint32 firstVertex = 0, uint32 firstInstance = 0) override;
+    void DrawIndexed(uint32 indexCount, uint32 instanceCount = 1, uint32 firstIndex = 0, int32 vertexOffset = 0,
+                     uint32 firstInstance = 0) override;
+
+    // ==========================================================================
+    // Compute Commands
+    // ==========================================================================
+
+    void Dispatch(uint32 groupCountX, uint32 groupCountY = 1, uint32 groupCountZ = 1) override;
+
+    // ==========================================================================
+    // Resource Barriers/Transitions
+    // ==========================================================================
+
+    void TransitionTexture(const RHITexture* texture, RHILayout newLayout) override;
+    void TransitionTexture(const RHITexture* texture, RHILayout newLayout, uint32 mipLevel, uint32 arrayLayer) override;
+    void TransitionBuffer(const RHIBuffer* buffer, RHILayout newLayout) override;
+    void ResourceBarrier(const RHITexture* texture, RHILayout oldLayout, RHILayout newLayout) override;
+    void PipelineBarrier(const RHIBarrierBatch* barriers) override;
+
+    // ==========================================================================
+    // Copy Commands
+    // ==========================================================================
+
+    void CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture) override;
+    void CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture,
+                             const RHIBufferTextureCopy& region) override;
+    void CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture,
+                             std::span<const RHIBufferTextureCopy> regions) override;
+    void CopyTextureToBuffer(const RHITexture* srcTexture, const RHIBuffer* dstBuffer) override;
+    void CopyBuffer(const RHIBuffer* srcBuffer, const RHIBuffer* dstBuffer, uint64 srcOffset, uint64 dstOffset,
+                    uint64 size) override;
+    void BlitTexture(const RHITexture* srcTexture, const RHITexture* dstTexture,
+                     RHISamplerFilter filter = RHISamplerFilter::Linear) override;
+
+    // ==========================================================================
+    // Clear Commands
+    // ==========================================================================
+
+    void ClearColorAttachment(uint32 attachmentIndex, const float color[4], const RHIRect2D& rect) override;
+    void ClearDepthStencilAttachment(float depth, uint32 stencil, bool clearDepth, bool clearStencil,
+                                     const RHIRect2D& rect) override;
+    void ClearTexture(const RHITexture* texture, const float color[4]) override;
+    void ClearBuffer(const RHIBuffer* buffer, uint32 value, uint64 offset = 0, uint64 size = ~0ULL) override;
+
+    // ==========================================================================
+    // Query Commands
+    // ==========================================================================
+
+    void WriteTimestamp(const RHIQueryPool* pool, uint32 index) override;
+    void BeginQuery(const RHIQueryPool* pool, uint32 index) override;
+    void EndQuery(const RHIQueryPool* pool, uint32 index) override;
+    void ResolveQueries(const RHIQueryPool* pool, uint32 firstIndex, uint32 count, const RHIBuffer* dstBuffer,
+                        uint64 dstOffset = 0) override;
+
+    // ==========================================================================
+    // Debug Commands
+    // ==========================================================================
+
+    void BeginDebugLabel(const std::string& label, const float color[4] = nullptr) override;
+    void EndDebugLabel() override { Emit(RHICommandOpcode::EndDebugLabel); }
+    void InsertDebugLabel(const std::string& label, const float color[4] = nullptr) override;
+
+    // ==========================================================================
+    // Statistics
+    // ==========================================================================
+
+    // Nothing is filtered while encoding, the translated list filters
+    uint64 GetFilteredCommandCount() const override { return 0; }
+
+private:
+    // Appends a packet holding args followed by trailingSize bytes the caller writes
+    template<typename... Args>
+    RHICommandPayloadWriter BeginPacket(RHICommandOpcode opcode, uint32 trailingSize, const Args&... args) {
+        const uint32 payloadSize = static_cast<uint32>((sizeof(Args) + ... + 0)) + trailingSize;
+        RHICommandPayloadWriter writer(m_Stream.Append(opcode, payloadSize));
+        (writer.Write(args), ...);
+        return writer;
+    }
+
+    template<typename... Args>
+    void Emit(RHICommandOpcode opcode, const Args&... args) {
+        BeginPacket(opcode, 0, args...);
+    }
+
+    void EmitDebugLabel(RHICommandOpcode opcode, const std::string& label, const float color[4]);
+
+    RHICommandStream m_Stream;
+    uint32 m_ChunkSize;
+};
+
+// =================================================================================================
+// Command Decoder
+// =================================================================================================
+
+// The backend translator. Replays a stream through the RHICommandList interface, so it translates into a list
+// of whatever backend target belongs to. The target must be recording, the stream is left untouched.
+export class IGE_API RHICommandDecoder {
+public:
+    // Maps a recorded handle to the object to use instead, for streams recorded against objects of another device
+    // (see RHICaptureReplayer). Without a resolver handles are the addresses of the recorded objects.
+    using HandleResolver = std::function<RHIResource*(RHICommandHandle)>;
+    void SetHandleResolver(HandleResolver resolver) { m_HandleResolver = std::move(resolver); }
+
+    // Stops at the first malformed packet
+    bool Decode(const RHICommandStream& stream, RHICommandList& target);
+    bool DecodePacket(const RHICommandPacket& packet, RHICommandList& target);
+
+private:
+    template<typename T>
+    T* Resolve(RHICommandHandle handle) const {
+        if (!m_HandleResolver || handle == 0) { return FromRHICommandHandle<T>(handle); }
+        return static_cast<T*>(m_HandleResolver(handle));
+    }
+
+    // Return false on content no encoder produces
+    bool DecodeBeginRenderPass(RHICommandPayloadReader& reader, RHICommandList& target);
+    bool DecodeBindTransientDescriptors(RHICommandPayloadReader& reader, RHICommandList& target);
+    bool DecodePipelineBarrier(RHICommandPayloadReader& reader, RHICommandList& target);
+
+    HandleResolver m_HandleResolver;
+
+    // Scratch reused across packets
+    std::vector<RHIAttachmentBinding> m_Attachments;
+    std::vector<uint32> m_DynamicOffsets;
+    std::vector<RHIWriteDescriptorSet> m_Writes;
+    std::vector<RHIDescriptorBufferInfo> m_BufferInfos;
+    std::vector<RHIDescriptorImageInfo> m_ImageInfos;
+    std::vector<RHIMemoryBarrier> m_MemoryBarriers;
+    std::vector<RHIBufferMemoryBarrier> m_BufferBarriers;
+    std::vector<RHITextureMemoryBarrier> m_TextureBarriers;
+    std::vector<RHIBufferTextureCopy> m_Regions;
+};
+
+} // namespace iGe
@@ -10,15 +10,49 @@ import :RHIGraphicsPipeline;
 import :RHIBuffer;
 import :RHISampler;
 import :RHIBarrier;
+import :RHIQuery;
+import :RHIStatistics;
 import iGe.Common;
 
 namespace iGe
 {
 
+// =================================================================================================
+// Buffer <-> Texture Copy Region
+// =================================================================================================
+
+export struct RHIBufferTextureCopy {
+    // Offset of the first texel in the buffer, must honor RHIDeviceLimits::OptimalBufferCopyOffsetAlignment
+    uint64 BufferOffset = 0;
+    // Bytes between two rows in the buffer, must honor RHIDeviceLimits::OptimalBufferCopyRowPitchAlignment
+    uint32 BufferRowPitch = 0;
+
+    uint32 MipLevel = 0;
+    uint32 ArrayLayer = 0;
+
+    // Zero extent copies the whole mip level
+    RHIExtent3D Extent = {0, 0, 0};
+};
+
+// Triangles a draw of vertexCount vertices or indices rasterizes, zero for points, lines and patches
+constexpr uint64 GetTriangleCount(RHIPrimitiveTopology topology, uint32 vertexCount, uint32 instanceCount) {
+    uint64 triangles = 0;
+    if (topology == RHIPrimitiveTopology::TriangleList) {
+        triangles = vertexCount / 3;
+    } else if ((topology == RHIPrimitiveTopology::TriangleStrip || topology == RHIPrimitiveTopology::TriangleFan) &&
+               vertexCount > 2) {
+        triangles = vertexCount - 2;
+    }
+    return triangles * instanceCount;
+}
+
 // =================================================================================================
 // Command List
 // =================================================================================================
 
+// The counted commands (binds, draws, dispatches and barriers) have a base body bumping RHIStatistics, so every
+// backend reports the same numbers. Recording backends call it before their own work, lists forwarding to an
+// inner list or recording for later replay override it without the call, the list they reach counts instead.
 export class IGE_API RHICommandList {
 public:
     virtual ~RHICommandList() = default;
@@ -27,7 +61,7 @@ public:
     // Command Buffer Lifecycle
     // ==========================================================================
 
-    virtual void Reset() = 0;
+    virtual void Reset() { m_PrimitiveTopology = RHIPrimitiveTopology::PointList; }
     virtual void Begin() = 0;
     virtual void End() = 0;
 
@@ -43,8 +77,14 @@ public:
     // Pipeline Binding
     // ==========================================================================
 
-    virtual void BindGraphicsPipeline(const RHIGraphicsPipeline* pipeline) = 0;
-    virtual void BindComputePipeline(const RHIComputePipeline* pipeline) = 0;
+    virtual void BindGraphicsPipeline(const RHIGraphicsPipeline* pipeline) {
+        if (!pipeline) { return; }
+        m_PrimitiveTopology = pipeline->GetTopology();
+        RHIStatistics::Add(RHIStatistic::PipelineBinds);
+    }
+    virtual void BindComputePipeline(const RHIComputePipeline* pipeline) {
+        if (pipeline) { RHIStatistics::Add(RHIStatistic::PipelineBinds); }
+    }
 
     // ==========================================================================
     // Descriptor Set Binding
@@ -55,8 +95,26 @@ public:
     //                                 const std::vector<uint32>& dynamicOffsets = {}) = 0;
 
     // Convenience overloads
+    // One dynamic offset per UniformBufferDynamic/StorageBufferDynamic element of the set, in binding order,
+    // added to the offset the descriptor was written with
     virtual void BindDescriptorSet(const RHIPipelineLayout* layout, uint32 setIndex,
-                                   const RHIDescriptorSet* descriptorSet) = 0;
+                                   const RHIDescriptorSet* descriptorSet,
+                                   std::span<const uint32> dynamicOffsets = {}) {
+        if (descriptorSet) { RHIStatistics::Add(RHIStatistic::DescriptorBinds); }
+    }
+
+    // Writes one set's descriptors into a table carved from the frame's transient descriptor ring and binds it,
+    // no descriptor set, pool or lock involved. Writes address bindings of setLayout, their pDstSet is ignored.
+    // The table lives until the frame retires, see RHI::EndFrame.
+    virtual void BindTransientDescriptors(const RHIPipelineLayout* layout, uint32 setIndex,
+                                          const RHIDescriptorSetLayout* setLayout,
+                                          std::span<const RHIWriteDescriptorSet> writes) {
+        if (!setLayout) { return; }
+        RHIStatistics::Add(RHIStatistic::DescriptorBinds);
+        uint64 descriptorCount = 0;
+        for (const auto& write: writes) { descriptorCount += write.DescriptorCount; }
+        RHIStatistics::Add(RHIStatistic::DescriptorWrites, descriptorCount);
+    }
 
     // ==========================================================================
     // Vertex/Index Buffer Binding
@@ -99,23 +157,53 @@ public:
     // Draw Commands
     // ==========================================================================
 
-    virtual void Draw(uint32 vertexCount, uint32 instanceCount = 1, uint32 firstVertex = 0,
-                      uint32 firstInstance = 0) = 0;
+    virtual void Draw(uint32 vertexCount, uint32 instanceCount = 1, uint32 firstVertex = 0, uint32 firstInstance = 0) {
+        RHIStatistics::Add(RHIStatistic::DrawCalls);
+        RHIStatistics::Add(RHIStatistic::Triangles, GetTriangleCount(m_PrimitiveTopology, vertexCount, instanceCount));
+    }
     virtual void DrawIndexed(uint32 indexCount, uint32 instanceCount = 1, uint32 firstIndex = 0, int32 vertexOffset = 0,
-                             uint32 firstInstance = 0) = 0;
+                             uint32 firstInstance = 0) {
+        RHIStatistics::Add(RHIStatistic::DrawCalls);
+        RHIStatistics::Add(RHIStatistic::Triangles, GetTriangleCount(m_PrimitiveTopology, indexCount, instanceCount));
+    }
 
     // ==========================================================================
     // Compute Commands
     // ==========================================================================
 
-    virtual void Dispatch(uint32 groupCountX, uint32 groupCountY = 1, uint32 groupCountZ = 1) = 0;
+    virtual void Dispatch(uint32 groupCountX, uint32 groupCountY = 1, uint32 groupCountZ = 1) {
+        RHIStatistics::Add(RHIStatistic::DispatchCalls);
+    }
 
     // ==========================================================================
     // Resource Barriers/Transitions
     // ==========================================================================
 
-    virtual void ResourceBarrier(const RHITexture* texture, RHILayout oldLayout, RHILayout newLayout) = 0;
-    virtual void PipelineBarrier(const RHIBarrierBatch* barriers) = 0;
+    // The list tracks the layout of every subresource it touched, callers only name the layout they need next.
+    // Transitions are batched until the next draw, dispatch, copy, clear or render pass, redundant ones are
+    // dropped. The layout a resource enters the list in is resolved against its global state at submit.
+    virtual void TransitionTexture(const RHITexture* texture, RHILayout newLayout) {
+        if (texture) { RHIStatistics::Add(RHIStatistic::Barriers); }
+    }
+    virtual void TransitionTexture(const RHITexture* texture, RHILayout newLayout, uint32 mipLevel,
+                                   uint32 arrayLayer) {
+        if (texture) { RHIStatistics::Add(RHIStatistic::Barriers); }
+    }
+    virtual void TransitionBuffer(const RHIBuffer* buffer, RHILayout newLayout) {
+        if (buffer) { RHIStatistics::Add(RHIStatistic::Barriers); }
+    }
+
+    // oldLayout is ignored, the tracked layout is used instead
+    virtual void ResourceBarrier(const RHITexture* texture, RHILayout oldLayout, RHILayout newLayout) {
+        if (texture) { RHIStatistics::Add(RHIStatistic::Barriers); }
+    }
+    // Texture barriers transition to NewLayout, buffer barriers are derived from their access masks
+    virtual void PipelineBarrier(const RHIBarrierBatch* barriers) {
+        if (!barriers) { return; }
+        RHIStatistics::Add(RHIStatistic::Barriers, barriers->MemoryBarriers.size() +
+                                                           barriers->TextureBarriers.size() +
+                                                           barriers->BufferBarriers.size());
+    }
 
     // // Convenience methods for texture layout transitions
     // virtual void TransitionTextureLayout(const RHITexture& texture, RHILayout oldLayout, RHILayout newLayout,
@@ -126,6 +214,11 @@ public:
     // ==========================================================================
 
     virtual void CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture) = 0;
+    virtual void CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture,
+                                     const RHIBufferTextureCopy& region) = 0;
+    // Every subresource of one upload in a single call, regions may target any mip and layer
+    virtual void CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture,
+                                     std::span<const RHIBufferTextureCopy> regions) = 0;
     virtual void CopyTextureToBuffer(const RHITexture* srcTexture, const RHIBuffer* dstBuffer) = 0;
     virtual void CopyBuffer(const RHIBuffer* srcBuffer, const RHIBuffer* dstBuffer, uint64 srcOffset, uint64 dstOffset,
                             uint64 size) = 0;
@@ -145,6 +238,20 @@ public:
     virtual void ClearTexture(const RHITexture* texture, const float color[4]) = 0;
     virtual void ClearBuffer(const RHIBuffer* buffer, uint32 value, uint64 offset = 0, uint64 size = ~0ULL) = 0;
 
+    // ==========================================================================
+    // Query Commands
+    // ==========================================================================
+
+    // Writes the queue's clock once the work recorded before has finished. Graphics and compute queues only.
+    virtual void WriteTimestamp(const RHIQueryPool* pool, uint32 index) = 0;
+    // Occlusion and pipeline statistics queries cover the commands between the two calls
+    virtual void BeginQuery(const RHIQueryPool* pool, uint32 index) = 0;
+    virtual void EndQuery(const RHIQueryPool* pool, uint32 index) = 0;
+    // Writes count results from firstIndex on into dstBuffer, GetRHIQueryResultSize bytes each. They are readable
+    // once the list has completed, through a GpuToCpu buffer without any further copy.
+    virtual void ResolveQueries(const RHIQueryPool* pool, uint32 firstIndex, uint32 count, const RHIBuffer* dstBuffer,
+                                uint64 dstOffset = 0) = 0;
+
     // ==========================================================================
     // Debug Commands
     // ==========================================================================
@@ -153,8 +260,18 @@ public:
     virtual void EndDebugLabel() = 0;
     virtual void InsertDebugLabel(const std::string& label, const float color[4] = nullptr) = 0;
 
+    // ==========================================================================
+    // Statistics
+    // ==========================================================================
+
+    // Binds dropped because they repeated the state already bound, monotonic across resets
+    virtual uint64 GetFilteredCommandCount() const = 0;
+
 protected:
     RHICommandList() {}
+
+    // Topology of the bound graphics pipeline, for the triangle statistic
+    RHIPrimitiveTopology m_PrimitiveTopology = RHIPrimitiveTopology::PointList;
 };
 
 // // =================================================================================================
@@ -0,0 +1,53 @@
+module iGe.RHI;
+import :RHICommandListManager;
+
+namespace iGe
+{
+
+RHICommandListManager::RHICommandListManager(RHI* pRHI, RHIQueue* pQueue) : m_pRHI(pRHI), m_pQueue(pQueue) {}
+
+RHICommandListManager::~RHICommandListManager() = default;
+
+RHICommandList* RHICommandListManager::Acquire() {
+    RHI* rhi = m_pRHI;
+    ThreadPools& pools = GetThreadPools();
+
+    // The lists of a completed frame have executed, resetting their pools releases the recorded commands
+    const uint64 completedSerial = rhi->GetCompletedFrameSerial();
+    while (!pools.InFlight.empty() && pools.InFlight.front().FrameSerial <= completedSerial) {
+        pools.InFlight.front().Pool->Reset();
+        pools.Free.push_back(std::move(pools.InFlight.front()));
+        pools.InFlight.pop_front();
+    }
+
+    Entry entry;
+    if (!pools.Free.empty()) {
+        entry = std::move(pools.Free.back());
+        pools.Free.pop_back();
+    } else {
+        entry.Pool = rhi->CreateCommandPool({m_pQueue});
+        if (entry.Pool) { entry.List = rhi->AllocateCommandList(entry.Pool.get()); }
+        if (!entry.List) {
+            Internal::LogError("RHICommandListManager: Failed to create a command list");
+            return nullptr;
+        }
+        m_CreatedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    entry.FrameSerial = rhi->GetFrameSerial();
+    entry.List->Reset();
+
+    RHICommandList* list = entry.List.get();
+    pools.InFlight.push_back(std::move(entry));
+    return list;
+}
+
+RHICommandListManager::ThreadPools& RHICommandListManager::GetThreadPools() {
+    std::lock_guard<std::mutex> lock(m_ThreadMutex);
+
+    auto& pools = m_Threads[std::this_thread::get_id()];
+    if (!pools) { pools = CreateScope<ThreadPools>(); }
+    return *pools;
+}
+
+} // namespace iGe
@@ -0,0 +1,65 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.RHI:RHICommandListManager;
+import :RHIQueue;
+import :RHICommandList;
+import :RHICommandPool;
+import iGe.Common;
+
+namespace iGe
+{
+
+export class RHI;
+
+// =================================================================================================
+// Command List Manager
+// =================================================================================================
+
+// Recycles command lists of one queue across frames, creating them through the device that owns the manager.
+// Every list comes with its own pool, so lists recorded side by side never share an allocator. Each thread
+// draws from its own set of pools. A pool is tagged with the frame serial it was handed out in (see
+// RHI::GetFrameSerial) and reset once that frame has completed, new pools are only created while every
+// existing one is still in flight.
+//
+// Lists must be submitted before the EndFrame of the frame they were acquired in, to a queue the frame queue
+// has waited for.
+export class IGE_API RHICommandListManager {
+public:
+    RHICommandListManager(RHI* pRHI, RHIQueue* pQueue);
+    ~RHICommandListManager();
+
+    RHICommandListManager(const RHICommandListManager&) = delete;
+    RHICommandListManager& operator=(const RHICommandListManager&) = delete;
+
+    // Thread-safe. The list is reset and owned by the manager, nullptr if a native list could not be created
+    RHICommandList* Acquire();
+
+    RHIQueue* GetQueue() const { return m_pQueue; }
+    // Lists created over the lifetime, stays flat once the frame pipeline is warm
+    uint32 GetCreatedCount() const { return m_CreatedCount.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry {
+        Scope<RHICommandPool> Pool;
+        Scope<RHICommandList> List; // Destroyed before its pool
+        uint64 FrameSerial = 0;
+    };
+
+    // Only touched by its own thread once created
+    struct ThreadPools {
+        std::deque<Entry> InFlight; // Frame order
+        std::vector<Entry> Free;
+    };
+
+    ThreadPools& GetThreadPools();
+
+    RHI* m_pRHI = nullptr;
+    RHIQueue* m_pQueue = nullptr;
+    std::atomic<uint32> m_CreatedCount = 0;
+
+    std::mutex m_ThreadMutex;
+    std::unordered_map<std::thread::id, Scope<ThreadPools>> m_Threads;
+};
+
+} // namespace iGe
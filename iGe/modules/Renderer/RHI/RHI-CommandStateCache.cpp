@@ -0,0 +1,78 @@
+module iGe.RHI;
+import :RHICommandStateCache;
+
+namespace iGe
+{
+
+void RHICommandStateCache::Invalidate() {
+    m_Pipeline.reset();
+    m_PrimitiveTopology.reset();
+    for (BindPointState& bindPoint: m_BindPoints) { bindPoint.pLayout = nullptr; }
+    InvalidateRootArguments();
+    m_DescriptorHeaps.reset();
+    m_VertexBuffers.fill(std::nullopt);
+    m_IndexBuffer.reset();
+    m_Viewport.reset();
+    m_Scissor.reset();
+    m_BlendConstants.reset();
+    m_StencilReference.reset();
+}
+
+bool RHICommandStateCache::BindPipelineLayout(RHIPipelineBindPoint bindPoint, const void* layout) {
+    BindPointState& state = m_BindPoints[static_cast<size_t>(bindPoint)];
+    if (layout && state.pLayout == layout) {
+        CountFiltered();
+        return false;
+    }
+    state.pLayout = layout;
+    state.ValidRootArguments.reset();
+    return true;
+}
+
+bool RHICommandStateCache::BindRootArgument(RHIPipelineBindPoint bindPoint, uint32 index, uint64 value) {
+    if (index >= MaxRootArguments) { return true; }
+
+    BindPointState& state = m_BindPoints[static_cast<size_t>(bindPoint)];
+    if (state.ValidRootArguments.test(index) && state.RootArguments[index] == value) {
+        CountFiltered();
+        return false;
+    }
+    state.RootArguments[index] = value;
+    state.ValidRootArguments.set(index);
+    return true;
+}
+
+bool RHICommandStateCache::BindDescriptorHeaps(const void* resourceHeap, const void* samplerHeap) {
+    if (!Update(m_DescriptorHeaps, std::pair{resourceHeap, samplerHeap})) { return false; }
+    InvalidateRootArguments();
+    return true;
+}
+
+bool RHICommandStateCache::BindVertexBuffer(uint32 binding, const void* buffer, uint64 offset) {
+    if (binding >= MaxVertexBindings) { return true; }
+    return Update(m_VertexBuffers[binding], BufferBinding{buffer, offset});
+}
+
+bool RHICommandStateCache::BindIndexBuffer(const void* buffer, uint64 offset) {
+    return Update(m_IndexBuffer, BufferBinding{buffer, offset});
+}
+
+bool RHICommandStateCache::SetViewport(const RHIViewport& viewport) {
+    return Update(m_Viewport, std::array<float, 6>{viewport.X, viewport.Y, viewport.Width, viewport.Height,
+                                                   viewport.MinDepth, viewport.MaxDepth});
+}
+
+bool RHICommandStateCache::SetScissor(const RHIScissor& scissor) {
+    return Update(m_Scissor, std::array<int64, 4>{scissor.X, scissor.Y, scissor.Width, scissor.Height});
+}
+
+bool RHICommandStateCache::SetBlendConstants(const float blendConstants[4]) {
+    return Update(m_BlendConstants,
+                  std::array<float, 4>{blendConstants[0], blendConstants[1], blendConstants[2], blendConstants[3]});
+}
+
+void RHICommandStateCache::InvalidateRootArguments() {
+    for (BindPointState& bindPoint: m_BindPoints) { bindPoint.ValidRootArguments.reset(); }
+}
+
+} // namespace iGe
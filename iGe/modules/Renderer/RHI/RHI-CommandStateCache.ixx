@@ -0,0 +1,101 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.RHI:RHICommandStateCache;
+import :RHIGraphicsPipeline; // For RHIViewport, RHIScissor
+import :RHIStatistics;
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Command State Cache
+// =================================================================================================
+
+export enum class RHIPipelineBindPoint : uint8 { Graphics = 0, Compute, Count };
+
+// Shadow copy of the state a command list has bound, so backends can drop binds that repeat it. Every Bind/Set
+// returns true when the caller has to record the command and false when it was filtered, filtered calls are
+// counted. State is keyed by object identity, a backend passes whatever it binds natively.
+//
+// Native state the cache does not see (a list reset, a bundle, a third party recording into the list) must be
+// followed by Invalidate.
+export class IGE_API RHICommandStateCache {
+public:
+    static constexpr uint32 MaxVertexBindings = 16;
+    static constexpr uint32 MaxRootArguments = 64;
+
+    RHICommandStateCache() { Invalidate(); }
+
+    void Invalidate();
+
+    // Pipeline state objects share one slot, layouts and root arguments are kept per bind point
+    bool BindPipeline(const void* pipeline) { return Update(m_Pipeline, pipeline); }
+    // A new layout drops every root argument of its bind point
+    bool BindPipelineLayout(RHIPipelineBindPoint bindPoint, const void* layout);
+    bool SetPrimitiveTopology(uint32 topology) { return Update(m_PrimitiveTopology, topology); }
+
+    // Descriptor tables and root buffer views, value is the GPU handle or address. Indices past
+    // MaxRootArguments are never filtered.
+    bool BindRootArgument(RHIPipelineBindPoint bindPoint, uint32 index, uint64 value);
+    // Changing heaps drops the root arguments of both bind points, tables are only valid with the heaps they
+    // were set with
+    bool BindDescriptorHeaps(const void* resourceHeap, const void* samplerHeap);
+
+    bool BindVertexBuffer(uint32 binding, const void* buffer, uint64 offset);
+    bool BindIndexBuffer(const void* buffer, uint64 offset);
+
+    bool SetViewport(const RHIViewport& viewport);
+    bool SetScissor(const RHIScissor& scissor);
+    bool SetBlendConstants(const float blendConstants[4]);
+    bool SetStencilReference(uint32 reference) { return Update(m_StencilReference, reference); }
+
+    // Filtered calls since the cache was created, monotonic so callers can diff it per frame
+    uint64 GetFilteredCount() const { return m_FilteredCount; }
+
+private:
+    struct BufferBinding {
+        const void* pBuffer = nullptr;
+        uint64 Offset = 0;
+        bool operator==(const BufferBinding&) const = default;
+    };
+
+    struct BindPointState {
+        const void* pLayout = nullptr;
+        std::array<uint64, MaxRootArguments> RootArguments{};
+        std::bitset<MaxRootArguments> ValidRootArguments;
+    };
+
+    template<typename T>
+    bool Update(std::optional<T>& slot, const T& value) {
+        if (slot == value) {
+            CountFiltered();
+            return false;
+        }
+        slot = value;
+        return true;
+    }
+
+    void InvalidateRootArguments();
+    void CountFiltered() {
+        ++m_FilteredCount;
+        RHIStatistics::Add(RHIStatistic::FilteredBinds);
+    }
+
+    // Empty optionals are unknown, the first bind after Invalidate always records
+    std::optional<const void*> m_Pipeline;
+    std::optional<uint32> m_PrimitiveTopology;
+    std::array<BindPointState, static_cast<size_t>(RHIPipelineBindPoint::Count)> m_BindPoints;
+    std::optional<std::pair<const void*, const void*>> m_DescriptorHeaps;
+    std::array<std::optional<BufferBinding>, MaxVertexBindings> m_VertexBuffers;
+    std::optional<BufferBinding> m_IndexBuffer;
+    std::optional<std::array<float, 6>> m_Viewport;
+    std::optional<std::array<int64, 4>> m_Scissor;
+    std::optional<std::array<float, 4>> m_BlendConstants;
+    std::optional<uint32> m_StencilReference;
+
+    uint64 m_FilteredCount = 0;
+};
+
+} // namespace iGe
@@ -0,0 +1,141 @@
+module iGe.RHI;
+import :RHICommandStream;
+
+namespace iGe
+{
+
+// Payloads are memcpy'd fields, the format is little-endian by being written on little-endian machines only
+static_assert(std::endian::native == std::endian::little);
+static_assert(sizeof(RHICommandPacketHeader) == RHICommandStream::PacketAlignment);
+
+std::string_view GetRHICommandOpcodeName(RHICommandOpcode opcode) {
+    static constexpr std::array<std::string_view, static_cast<size_t>(RHICommandOpcode::Count)> s_Names = {
+            "Invalid",
+            "BeginRenderPass",
+            "EndRenderPass",
+            "NextSubpass",
+            "BindGraphicsPipeline",
+            "BindComputePipeline",
+            "BindDescriptorSet",
+            "BindTransientDescriptors",
+            "BindVertexBuffer",
+            "BindIndexBuffer",
+            "PushConstants",
+            "SetViewport",
+            "SetScissor",
+            "SetLineWidth",
+            "SetDepthBias",
+            "SetBlendConstants",
+            "SetDepthBounds",
+            "SetStencilCompareMask",
+            "SetStencilWriteMask",
+            "SetStencilReference",
+            "Draw",
+            "DrawIndexed",
+            "Dispatch",
+            "TransitionTexture",
+            "TransitionTextureSubresource",
+            "TransitionBuffer",
+            "ResourceBarrier",
+            "PipelineBarrier",
+            "CopyBufferToTexture",
+            "CopyBufferToTextureRegions",
+            "CopyTextureToBuffer",
+            "CopyBuffer",
+            "BlitTexture",
+            "ClearColorAttachment",
+            "ClearDepthStencilAttachment",
+            "ClearTexture",
+            "ClearBuffer",
+            "BeginDebugLabel",
+            "EndDebugLabel",
+            "InsertDebugLabel",
+            "WriteTimestamp",
+            "BeginQuery",
+            "EndQuery",
+            "ResolveQueries",
+    };
+
+    const auto index = static_cast<size_t>(opcode);
+    return index < s_Names.size() ? s_Names[index] : "Unknown";
+}
+
+// =================================================================================================
+// RHICommandStream
+// =================================================================================================
+
+RHICommandStream::RHICommandStream(uint32 chunkSize)
+    : m_ChunkSize(static_cast<uint32>(AlignUp(std::max(chunkSize, 1024u), PacketAlignment))) {}
+
+std::byte* RHICommandStream::Append(RHICommandOpcode opcode, uint32 payloadSize) {
+    const uint32 packetSize =
+            static_cast<uint32>(AlignUp(sizeof(RHICommandPacketHeader) + payloadSize, PacketAlignment));
+
+    // Move on to the next chunk, or insert one large enough for an oversized packet
+    if (m_Chunks.empty() || m_Chunks[m_ActiveChunk].Used + packetSize > m_Chunks[m_ActiveChunk].Capacity) {
+        if (!m_Chunks.empty() && m_Chunks[m_ActiveChunk].Used > 0) { ++m_ActiveChunk; }
+        if (m_ActiveChunk == m_Chunks.size() || m_Chunks[m_ActiveChunk].Capacity < packetSize) {
+            Chunk chunk;
+            chunk.Capacity = std::max(m_ChunkSize, packetSize);
+            chunk.Data = std::make_unique<std::byte[]>(chunk.Capacity);
+            m_Chunks.insert(m_Chunks.begin() + m_ActiveChunk, std::move(chunk));
+        }
+    }
+
+    Chunk& chunk = m_Chunks[m_ActiveChunk];
+    std::byte* packet = chunk.Data.get() + chunk.Used;
+    chunk.Used += packetSize;
+    ++m_PacketCount;
+    m_Size += packetSize;
+
+    RHICommandPacketHeader header;
+    header.Opcode = opcode;
+    header.Size = packetSize;
+    std::memcpy(packet, &header, sizeof(header));
+
+    // Padding is zeroed so serialized streams are deterministic
+    std::byte* payload = packet + sizeof(header);
+    std::memset(payload + payloadSize, 0, packetSize - sizeof(header) - payloadSize);
+    return payload;
+}
+
+void RHICommandStream::Clear() {
+    for (Chunk& chunk: m_Chunks) { chunk.Used = 0; }
+    m_ActiveChunk = 0;
+    m_PacketCount = 0;
+    m_Size = 0;
+}
+
+void RHICommandStream::Serialize(std::vector<std::byte>& data) const {
+    data.reserve(data.size() + m_Size);
+    for (const Chunk& chunk: m_Chunks) { data.insert(data.end(), chunk.Data.get(), chunk.Data.get() + chunk.Used); }
+}
+
+bool RHICommandStream::Deserialize(std::span<const std::byte> data) {
+    Clear();
+
+    for (uint64 offset = 0; offset < data.size();) {
+        RHICommandPacketHeader header;
+        if (offset + sizeof(header) > data.size()) {
+            Internal::LogError("RHICommandStream: Truncated packet header at offset {0}", offset);
+            Clear();
+            return false;
+        }
+        std::memcpy(&header, data.data() + offset, sizeof(header));
+
+        const bool validOpcode = header.Opcode > RHICommandOpcode::Invalid && header.Opcode < RHICommandOpcode::Count;
+        if (!validOpcode || header.Size < sizeof(header) || header.Size % PacketAlignment != 0 ||
+            offset + header.Size > data.size()) {
+            Internal::LogError("RHICommandStream: Malformed packet at offset {0}", offset);
+            Clear();
+            return false;
+        }
+
+        const uint32 payloadSize = header.Size - static_cast<uint32>(sizeof(header));
+        std::memcpy(Append(header.Opcode, payloadSize), data.data() + offset + sizeof(header), payloadSize);
+        offset += header.Size;
+    }
+    return true;
+}
+
+} // namespace iGe
@@ -0,0 +1,217 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.RHI:RHICommandStream;
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Command Stream Format
+// =================================================================================================
+
+// Values are part of the serialized format, append new opcodes before Count
+export enum class RHICommandOpcode : uint16 {
+    Invalid = 0,
+
+    BeginRenderPass,
+    EndRenderPass,
+    NextSubpass,
+
+    BindGraphicsPipeline,
+    BindComputePipeline,
+    BindDescriptorSet,
+    BindTransientDescriptors,
+    BindVertexBuffer,
+    BindIndexBuffer,
+    PushConstants,
+
+    SetViewport,
+    SetScissor,
+    SetLineWidth,
+    SetDepthBias,
+    SetBlendConstants,
+    SetDepthBounds,
+    SetStencilCompareMask,
+    SetStencilWriteMask,
+    SetStencilReference,
+
+    Draw,
+    DrawIndexed,
+    Dispatch,
+
+    TransitionTexture,
+    TransitionTextureSubresource,
+    TransitionBuffer,
+    ResourceBarrier,
+    PipelineBarrier,
+
+    CopyBufferToTexture,
+    CopyBufferToTextureRegions,
+    CopyTextureToBuffer,
+    CopyBuffer,
+    BlitTexture,
+
+    ClearColorAttachment,
+    ClearDepthStencilAttachment,
+    ClearTexture,
+    ClearBuffer,
+
+    BeginDebugLabel,
+    EndDebugLabel,
+    InsertDebugLabel,
+
+    WriteTimestamp,
+    BeginQuery,
+    EndQuery,
+    ResolveQueries,
+
+    Count
+};
+
+export IGE_API std::string_view GetRHICommandOpcodeName(RHICommandOpcode opcode);
+
+// Every packet starts with this header, its payload follows directly. Payload fields are fixed-width and
+// little-endian without padding, so a stream reads the same on every platform.
+export struct RHICommandPacketHeader {
+    RHICommandOpcode Opcode = RHICommandOpcode::Invalid;
+    uint16 Reserved = 0;
+    uint32 Size = 0; // Header and payload, a multiple of RHICommandStream::PacketAlignment
+};
+
+export struct RHICommandPacket {
+    RHICommandOpcode Opcode = RHICommandOpcode::Invalid;
+    std::span<const std::byte> Payload;
+};
+
+// =================================================================================================
+// Command Stream
+// =================================================================================================
+
+// Packets in chunked arena memory. Appending never moves a packet, a packet never straddles two chunks and
+// Clear keeps the chunks for the next recording.
+export class IGE_API RHICommandStream {
+public:
+    static constexpr uint32 PacketAlignment = 8;
+    static constexpr uint32 DefaultChunkSize = 64 * 1024;
+
+    explicit RHICommandStream(uint32 chunkSize = DefaultChunkSize);
+
+    RHICommandStream(RHICommandStream&&) noexcept = default;
+    RHICommandStream& operator=(RHICommandStream&&) noexcept = default;
+    RHICommandStream(const RHICommandStream&) = delete;
+    RHICommandStream& operator=(const RHICommandStream&) = delete;
+
+    // Returns payloadSize bytes for the caller to fill
+    std::byte* Append(RHICommandOpcode opcode, uint32 payloadSize);
+    void Clear();
+
+    bool IsEmpty() const { return m_PacketCount == 0; }
+    uint32 GetPacketCount() const { return m_PacketCount; }
+    // Bytes of all packets, the size of the serialized stream
+    uint64 GetSize() const { return m_Size; }
+
+    template<typename Function>
+    void ForEachPacket(Function&& function) const {
+        for (const Chunk& chunk: m_Chunks) {
+            for (uint32 offset = 0; offset < chunk.Used;) {
+                RHICommandPacketHeader header;
+                std::memcpy(&header, chunk.Data.get() + offset, sizeof(header));
+                function(RHICommandPacket{header.Opcode, {chunk.Data.get() + offset + sizeof(header),
+                                                          header.Size - sizeof(header)}});
+                offset += header.Size;
+            }
+        }
+    }
+
+    // The serialized stream is the packets back to back
+    void Serialize(std::vector<std::byte>& data) const;
+    // Validates every header, the stream is left empty on failure
+    bool Deserialize(std::span<const std::byte> data);
+
+private:
+    struct Chunk {
+        std::unique_ptr<std::byte[]> Data;
+        uint32 Capacity = 0;
+        uint32 Used = 0;
+    };
+
+    std::vector<Chunk> m_Chunks; // Chunks past m_ActiveChunk are empty
+    uint32 m_ActiveChunk = 0;
+    uint32 m_ChunkSize = DefaultChunkSize;
+    uint32 m_PacketCount = 0;
+    uint64 m_Size = 0;
+};
+
+// =================================================================================================
+// Payload Access
+// =================================================================================================
+
+export class RHICommandPayloadWriter {
+public:
+    explicit RHICommandPayloadWriter(std::byte* pPayload) : m_pCursor(pPayload) {}
+
+    template<typename T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        std::memcpy(m_pCursor, &value, sizeof(T));
+        m_pCursor += sizeof(T);
+    }
+
+    void WriteBytes(const void* data, uint32 size) {
+        if (size > 0) { std::memcpy(m_pCursor, data, size); }
+        m_pCursor += size;
+    }
+
+private:
+    std::byte* m_pCursor = nullptr;
+};
+
+// Reads past the payload yield zeroes and mark the reader as overrun
+export class RHICommandPayloadReader {
+public:
+    explicit RHICommandPayloadReader(std::span<const std::byte> payload) : m_Payload(payload) {}
+
+    template<typename T>
+    T Read() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value{};
+        if (m_Offset + sizeof(T) > m_Payload.size()) {
+            m_Overrun = true;
+            return value;
+        }
+        std::memcpy(&value, m_Payload.data() + m_Offset, sizeof(T));
+        m_Offset += sizeof(T);
+        return value;
+    }
+
+    // Braced initialization reads the fields in order
+    template<typename... T>
+    std::tuple<T...> ReadAll() {
+        return std::tuple<T...>{Read<T>()...};
+    }
+
+    std::span<const std::byte> ReadBytes(uint64 size) {
+        if (size > m_Payload.size() - m_Offset) {
+            m_Overrun = true;
+            return {};
+        }
+        auto bytes = m_Payload.subspan(m_Offset, size);
+        m_Offset += size;
+        return bytes;
+    }
+
+    uint64 GetRemainingSize() const { return m_Payload.size() - m_Offset; }
+    bool IsOverrun() const { return m_Overrun; }
+
+protected:
+    void MarkOverrun() { m_Overrun = true; }
+
+private:
+    std::span<const std::byte> m_Payload;
+    uint64 m_Offset = 0;
+    bool m_Overrun = false;
+};
+
+} // namespace iGe
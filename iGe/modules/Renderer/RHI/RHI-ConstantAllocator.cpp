@@ -0,0 +1,42 @@
+module iGe.RHI;
+import :RHIConstantAllocator;
+import :RHIStatistics;
+
+namespace iGe
+{
+
+RHIConstantAllocator::RHIConstantAllocator(Scope<RHIBuffer> buffer, uint32 alignment)
+    : m_Buffer(std::move(buffer)), m_Alignment(std::max(1u, alignment)) {
+    // Mapped once, upload memory stays mapped while the GPU reads it
+    m_pMappedData = m_Buffer ? static_cast<uint8*>(m_Buffer->Map()) : nullptr;
+    if (!m_pMappedData) {
+        Internal::LogError("RHIConstantAllocator: The constant buffer is missing or not host-visible");
+        return;
+    }
+
+    m_Ring.Reset(static_cast<uint32>(m_Buffer->GetSize() / m_Alignment));
+}
+
+RHIConstantAllocator::~RHIConstantAllocator() {
+    if (m_pMappedData) { m_Buffer->Unmap(); }
+}
+
+RHIConstantAllocation RHIConstantAllocator::Allocate(uint64 size) {
+    if (!m_pMappedData || size == 0) { return {}; }
+
+    const uint32 blockCount = static_cast<uint32>((size + m_Alignment - 1) / m_Alignment);
+    const uint32 block = m_Ring.Allocate(blockCount);
+    if (block == RHIDescriptorRing::InvalidOffset) {
+        Internal::LogError("RHIConstantAllocator: Out of constant memory ({0} of {1} bytes in flight)",
+                           GetUsedSize(), GetCapacity());
+        return {};
+    }
+
+    // The block is written through the persistent mapping, which Map counted only once
+    RHIStatistics::Add(RHIStatistic::UploadBytes, size);
+
+    const uint32 offset = block * m_Alignment;
+    return {m_Buffer.get(), offset, m_pMappedData + offset};
+}
+
+} // namespace iGe
@@ -0,0 +1,65 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.RHI:RHIConstantAllocator;
+import :RHIBuffer;
+import :RHIDescriptorRing;
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Constant Allocator
+// =================================================================================================
+
+export struct RHIConstantAllocation {
+    const RHIBuffer* pBuffer = nullptr;
+    uint32 Offset = 0; // Pass as the dynamic offset of a UniformBufferDynamic binding
+    void* pData = nullptr;
+
+    bool IsValid() const { return pData != nullptr; }
+};
+
+// Per-frame linear allocator for shader constants over one persistently mapped upload buffer. An allocation
+// is a lock-free bump rounded up to the uniform buffer offset alignment, so per-draw constants cost a bump and
+// a memcpy: write a UniformBufferDynamic descriptor for GetBuffer() once, then pass each allocation's Offset
+// at bind time. The memory is reused once the frame it was allocated in has completed on the GPU.
+export class IGE_API RHIConstantAllocator {
+public:
+    // The buffer must be host-visible, its size is rounded down to a whole number of alignments
+    RHIConstantAllocator(Scope<RHIBuffer> buffer, uint32 alignment);
+    ~RHIConstantAllocator();
+
+    RHIConstantAllocator(const RHIConstantAllocator&) = delete;
+    RHIConstantAllocator& operator=(const RHIConstantAllocator&) = delete;
+
+    // Thread-safe, the memory is valid for writing until the end of the frame
+    RHIConstantAllocation Allocate(uint64 size);
+
+    template<typename T>
+    RHIConstantAllocation Allocate(const T& value) {
+        RHIConstantAllocation allocation = Allocate(sizeof(T));
+        if (allocation.IsValid()) { std::memcpy(allocation.pData, &value, sizeof(T)); }
+        return allocation;
+    }
+
+    // Frame owner only, same contract as RHIDescriptorRing
+    void EndFrame(uint64 fenceValue) { m_Ring.EndFrame(fenceValue); }
+    void Retire(uint64 completedValue) { m_Ring.Retire(completedValue); }
+
+    const RHIBuffer* GetBuffer() const { return m_Buffer.get(); }
+    uint32 GetAlignment() const { return m_Alignment; }
+    uint64 GetCapacity() const { return static_cast<uint64>(m_Ring.GetCapacity()) * m_Alignment; }
+    uint64 GetUsedSize() const { return static_cast<uint64>(m_Ring.GetUsedCount()) * m_Alignment; }
+
+private:
+    Scope<RHIBuffer> m_Buffer;
+    uint8* m_pMappedData = nullptr;
+    uint32 m_Alignment = 1;
+
+    // One slot per alignment-sized block
+    RHIDescriptorRing m_Ring;
+};
+
+} // namespace iGe
@@ -0,0 +1,62 @@
+module iGe.RHI;
+import :RHIDeletionQueue;
+
+namespace iGe
+{
+
+void RHIDeletionQueue::Enqueue(Scope<RHIResource> resource, uint64 frameSerial) {
+    if (!resource) { return; }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Pending.push_back({frameSerial, std::move(resource), {}});
+}
+
+void RHIDeletionQueue::Enqueue(std::move_only_function<void()> release, uint64 frameSerial) {
+    if (!release) { return; }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Pending.push_back({frameSerial, nullptr, std::move(release)});
+}
+
+void RHIDeletionQueue::Retire(uint64 completedFrameSerial) {
+    std::vector<PendingRelease> releases;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        // Serials arrive in frame order, a release racing in from an older frame only waits a little longer
+        while (!m_Pending.empty() && m_Pending.front().FrameSerial <= completedFrameSerial) {
+            releases.push_back(std::move(m_Pending.front()));
+            m_Pending.pop_front();
+        }
+    }
+    Destroy(releases);
+}
+
+void RHIDeletionQueue::Flush() {
+    // Destructors may queue more releases, drain until nothing is left
+    for (;;) {
+        std::vector<PendingRelease> releases;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (m_Pending.empty()) { return; }
+
+            releases.assign(std::make_move_iterator(m_Pending.begin()), std::make_move_iterator(m_Pending.end()));
+            m_Pending.clear();
+        }
+        Destroy(releases);
+    }
+}
+
+uint32 RHIDeletionQueue::GetPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return static_cast<uint32>(m_Pending.size());
+}
+
+void RHIDeletionQueue::Destroy(std::vector<PendingRelease>& releases) {
+    for (PendingRelease& release: releases) {
+        release.Resource.reset();
+        if (release.Release) { release.Release(); }
+    }
+}
+
+} // namespace iGe
@@ -0,0 +1,54 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.RHI:RHIDeletionQueue;
+import :RHIResource;
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Deletion Queue
+// =================================================================================================
+
+// Keeps released GPU objects alive until the GPU is done with them. A release is tagged with the frame serial
+// it happened in (see RHI::GetFrameSerial) and Retire destroys every release whose frame has completed, so a
+// resource can be replaced while in-flight frames still read it, without waiting for the device to go idle.
+//
+// Knows nothing about the backend: any monotonic serial drives it, the RHI feeds it its frame fence.
+// Releases are destroyed in the order they were queued, release views before the texture they view.
+export class IGE_API RHIDeletionQueue {
+public:
+    RHIDeletionQueue() = default;
+    ~RHIDeletionQueue() { Flush(); }
+
+    RHIDeletionQueue(const RHIDeletionQueue&) = delete;
+    RHIDeletionQueue& operator=(const RHIDeletionQueue&) = delete;
+
+    // Thread-safe
+    void Enqueue(Scope<RHIResource> resource, uint64 frameSerial);
+    // For backend objects that are no RHIResource, the callback runs when the frame has completed
+    void Enqueue(std::move_only_function<void()> release, uint64 frameSerial);
+
+    // Destruction happens outside the lock, a destructor may release further objects
+    void Retire(uint64 completedFrameSerial);
+    // Destroys everything regardless of the serial, only once the device is idle
+    void Flush();
+
+    uint32 GetPendingCount() const;
+
+private:
+    struct PendingRelease {
+        uint64 FrameSerial = 0;
+        Scope<RHIResource> Resource;
+        std::move_only_function<void()> Release;
+    };
+
+    void Destroy(std::vector<PendingRelease>& releases);
+
+    mutable std::mutex m_Mutex;
+    std::deque<PendingRelease> m_Pending;
+};
+
+} // namespace iGe
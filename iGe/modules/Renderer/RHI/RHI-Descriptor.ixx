@@ -196,4 +196,71 @@ protected:
     RHIDescriptorSet() : RHIResource(RHIResourceType::DescriptorSet) {}
 };
 
+// =================================================================================================
+// Descriptor Update Template
+// =================================================================================================
+
+// One template entry covers DescriptorCount consecutive array elements of a binding. Element i is read from
+// pData + Offset + i * Stride of the data passed to RHI::UpdateDescriptorSetWithTemplate, as:
+//     UniformBuffer, StorageBuffer (and Dynamic)   RHIDescriptorBufferInfo
+//     SampledImage, StorageImage, InputAttachment  const RHITextureView*
+//     Sampler                                      const RHISampler*
+export struct RHIDescriptorUpdateTemplateEntry {
+    uint32 DstBinding = 0;
+    uint32 DstArrayElement = 0;
+    uint32 DescriptorCount = 1;
+    RHIDescriptorType DescriptorType = RHIDescriptorType::UniformBuffer;
+    uint64 Offset = 0;
+    uint64 Stride = 0; // Zero means tightly packed
+};
+
+export struct RHIDescriptorUpdateTemplateCreateInfo {
+    const RHIDescriptorSetLayout* pSetLayout = nullptr;
+    std::span<const RHIDescriptorUpdateTemplateEntry> Entries = {};
+};
+
+export class IGE_API RHIDescriptorUpdateTemplate : public RHIResource {
+public:
+    ~RHIDescriptorUpdateTemplate() override = default;
+
+    // Descriptors one update writes, over all entries
+    uint32 GetDescriptorCount() const { return m_DescriptorCount; }
+
+protected:
+    RHIDescriptorUpdateTemplate(const RHIDescriptorUpdateTemplateCreateInfo& info)
+        : RHIResource(RHIResourceType::DescriptorUpdateTemplate) {
+        for (const auto& entry: info.Entries) { m_DescriptorCount += entry.DescriptorCount; }
+    }
+
+    uint32 m_DescriptorCount = 0;
+};
+
+// Element size a tightly packed template entry of this type steps by
+export constexpr uint64 GetDescriptorUpdateTemplateElementSize(RHIDescriptorType type) {
+    switch (type) {
+        case RHIDescriptorType::UniformBuffer:
+        case RHIDescriptorType::StorageBuffer:
+        case RHIDescriptorType::UniformBufferDynamic:
+        case RHIDescriptorType::StorageBufferDynamic:
+            return sizeof(RHIDescriptorBufferInfo);
+        case RHIDescriptorType::Sampler:
+            return sizeof(const RHISampler*);
+        default:
+            return sizeof(const RHITextureView*);
+    }
+}
+
+// Bytes of template data the entries read
+export constexpr uint64 GetDescriptorUpdateTemplateDataSize(std::span<const RHIDescriptorUpdateTemplateEntry> entries) {
+    uint64 size = 0;
+    for (const RHIDescriptorUpdateTemplateEntry& entry: entries) {
+        if (entry.DescriptorCount == 0) { continue; }
+
+        const uint64 elementSize = GetDescriptorUpdateTemplateElementSize(entry.DescriptorType);
+        const uint64 stride = entry.Stride != 0 ? entry.Stride : elementSize;
+        size = std::max(size, entry.Offset + (entry.DescriptorCount - 1) * stride + elementSize);
+    }
+    return size;
+}
+
 } // namespace iGe
@@ -0,0 +1,60 @@
+module iGe.RHI;
+import :RHIDescriptorRing;
+
+namespace iGe
+{
+
+RHIDescriptorRing::RHIDescriptorRing(uint32 capacity) { Reset(capacity); }
+
+void RHIDescriptorRing::Reset(uint32 capacity) {
+    m_Capacity = capacity;
+    m_Head.store(0, std::memory_order_relaxed);
+    m_Tail.store(0, std::memory_order_relaxed);
+    m_Frames.clear();
+}
+
+uint32 RHIDescriptorRing::Allocate(uint32 count) {
+    if (count == 0 || count > m_Capacity) { return InvalidOffset; }
+
+    uint64 head = m_Head.load(std::memory_order_relaxed);
+    while (true) {
+        // Tables stay contiguous, a table that does not fit before the end of the ring starts over at slot zero
+        uint64 start = head;
+        const uint64 slot = head % m_Capacity;
+        if (slot + count > m_Capacity) { start += m_Capacity - slot; }
+        const uint64 end = start + count;
+
+        // The tail only moves forward, a stale read can fail an allocation but never overlap a live frame
+        if (end - m_Tail.load(std::memory_order_acquire) > m_Capacity) { return InvalidOffset; }
+
+        if (m_Head.compare_exchange_weak(head, end, std::memory_order_relaxed)) {
+            return static_cast<uint32>(start % m_Capacity);
+        }
+    }
+}
+
+void RHIDescriptorRing::EndFrame(uint64 fenceValue) {
+    const uint64 head = m_Head.load(std::memory_order_relaxed);
+
+    // A frame that allocated nothing has nothing to retire
+    const uint64 frameStart = m_Frames.empty() ? m_Tail.load(std::memory_order_relaxed) : m_Frames.back().End;
+    if (head == frameStart) { return; }
+
+    m_Frames.push_back({head, fenceValue});
+}
+
+void RHIDescriptorRing::Retire(uint64 completedValue) {
+    uint64 tail = m_Tail.load(std::memory_order_relaxed);
+    while (!m_Frames.empty() && m_Frames.front().FenceValue <= completedValue) {
+        tail = m_Frames.front().End;
+        m_Frames.pop_front();
+    }
+    m_Tail.store(tail, std::memory_order_release);
+}
+
+uint32 RHIDescriptorRing::GetUsedCount() const {
+    const uint64 tail = m_Tail.load(std::memory_order_acquire);
+    return static_cast<uint32>(m_Head.load(std::memory_order_relaxed) - tail);
+}
+
+} // namespace iGe
@@ -0,0 +1,57 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.RHI:RHIDescriptorRing;
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Descriptor Ring
+// =================================================================================================
+
+// Ring of [0, capacity) slots for descriptors that live for one frame. Allocations bump a shared head
+// lock-free, so any recording thread can carve a contiguous table; a table never wraps, the unused tail
+// slots are skipped instead. EndFrame tags everything allocated since the previous EndFrame with a fence
+// value and Retire hands those slots back once the GPU has completed that value.
+export class IGE_API RHIDescriptorRing {
+public:
+    static constexpr uint32 InvalidOffset = std::numeric_limits<uint32>::max();
+
+    explicit RHIDescriptorRing(uint32 capacity = 0);
+
+    RHIDescriptorRing(const RHIDescriptorRing&) = delete;
+    RHIDescriptorRing& operator=(const RHIDescriptorRing&) = delete;
+
+    // Drops every frame, only safe once the GPU is idle
+    void Reset(uint32 capacity);
+
+    // Thread-safe, returns InvalidOffset when the frames still in flight leave no room
+    uint32 Allocate(uint32 count);
+
+    // Frame owner only, no Allocate may race with EndFrame. Fence values must not decrease
+    void EndFrame(uint64 fenceValue);
+    void Retire(uint64 completedValue);
+
+    uint32 GetCapacity() const { return m_Capacity; }
+    // Slots held by open and in-flight frames, including the skipped ones
+    uint32 GetUsedCount() const;
+    uint32 GetFramesInFlight() const { return static_cast<uint32>(m_Frames.size()); }
+
+private:
+    struct Frame {
+        uint64 End = 0; // Head position when the frame ended
+        uint64 FenceValue = 0;
+    };
+
+    uint32 m_Capacity = 0;
+
+    // Monotonic positions, the slot is position % capacity
+    std::atomic<uint64> m_Head = 0;
+    std::atomic<uint64> m_Tail = 0;
+
+    std::deque<Frame> m_Frames;
+};
+
+} // namespace iGe
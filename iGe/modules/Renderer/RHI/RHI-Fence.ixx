@@ -20,6 +20,10 @@ public:
     virtual bool Wait(uint64 timeout = std::numeric_limits<uint64>::max()) = 0;
     virtual void Reset() = 0;
 
+    // Timeline use: values are signaled from a queue with RHIQueue::Signal, timeouts are in nanoseconds
+    virtual uint64 GetCompletedValue() const = 0;
+    virtual bool WaitForValue(uint64 value, uint64 timeout = std::numeric_limits<uint64>::max()) = 0;
+
 protected:
     RHIFence(const RHIFenceCreateInfo& info) : RHIResource(RHIResourceType::Fence) {}
 };
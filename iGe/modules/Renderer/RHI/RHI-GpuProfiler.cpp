@@ -0,0 +1,162 @@
+module iGe.RHI;
+import :RHIGpuProfiler;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Query Ring
+// =================================================================================================
+
+RHIQueryRing::RHIQueryRing(uint32 slotCount) : m_Slots(std::max(slotCount, 1u)) {}
+
+std::optional<uint32> RHIQueryRing::Acquire(uint64 frameSerial) {
+    const uint32 slot = static_cast<uint32>(frameSerial % m_Slots.size());
+    if (m_Slots[slot].State == SlotState::InFlight) {
+        ++m_DroppedFrameCount;
+        return std::nullopt;
+    }
+
+    // A frame that never submitted leaves its slot recording, it is taken over
+    m_Slots[slot] = {SlotState::Recording, frameSerial};
+    return slot;
+}
+
+void RHIQueryRing::Submit(uint32 slot) {
+    if (slot < m_Slots.size() && m_Slots[slot].State == SlotState::Recording) {
+        m_Slots[slot].State = SlotState::InFlight;
+    }
+}
+
+std::optional<uint32> RHIQueryRing::RetireNext(uint64 completedSerial) {
+    std::optional<uint32> oldest;
+    for (uint32 i = 0; i < m_Slots.size(); ++i) {
+        const Slot& slot = m_Slots[i];
+        if (slot.State != SlotState::InFlight || slot.FrameSerial > completedSerial) { continue; }
+        if (!oldest || slot.FrameSerial < m_Slots[*oldest].FrameSerial) { oldest = i; }
+    }
+
+    if (oldest) { m_Slots[*oldest].State = SlotState::Free; }
+    return oldest;
+}
+
+// =================================================================================================
+// GPU Profiler
+// =================================================================================================
+
+RHIGpuProfiler::RHIGpuProfiler(RHI* pRHI, const RHIGpuProfilerCreateInfo& info)
+    : m_RHI(pRHI), m_Queue(info.pQueue), m_MaxZoneCount(std::max(info.MaxZoneCount, 1u)),
+      m_Track(Profiler::RegisterTrack(info.TrackName)), m_Ring(info.FrameLatency) {
+    if (!m_RHI || !m_Queue) {
+        Internal::LogError("RHIGpuProfiler: RHI and queue are required");
+        return;
+    }
+
+    const uint32 slotCount = m_Ring.GetSlotCount();
+    m_QueryPool = m_RHI->CreateQueryPool({RHIQueryType::Timestamp, slotCount * m_MaxZoneCount * 2});
+
+    m_Slots.resize(slotCount);
+    const uint64 readbackSize = static_cast<uint64>(m_MaxZoneCount) * 2 * sizeof(uint64);
+    for (Slot& slot: m_Slots) {
+        slot.Readback = m_RHI->CreateBuffer({readbackSize, RHIBufferUsageBit::TransferDst, RHIMemoryUsage::GpuToCpu});
+        slot.Names.resize(m_MaxZoneCount);
+        slot.Ended.resize(m_MaxZoneCount);
+    }
+}
+
+RHIGpuProfiler::~RHIGpuProfiler() {
+    if (!m_RHI) { return; }
+
+    // Frames still in flight may resolve into them
+    for (Slot& slot: m_Slots) {
+        if (slot.Readback) { m_RHI->DeferDestroy(slot.Readback); }
+    }
+    if (m_QueryPool) { m_RHI->DeferDestroy(m_QueryPool); }
+}
+
+void RHIGpuProfiler::BeginFrame() {
+    if (!m_QueryPool) { return; }
+
+    const uint64 completedSerial = m_RHI->GetCompletedFrameSerial();
+    while (std::optional<uint32> slot = m_Ring.RetireNext(completedSerial)) { Publish(*slot); }
+
+    m_CurrentSlot = m_Ring.Acquire(m_RHI->GetFrameSerial());
+    m_NextZone.store(0, std::memory_order_relaxed);
+    if (m_CurrentSlot) { std::fill(m_Slots[*m_CurrentSlot].Ended.begin(), m_Slots[*m_CurrentSlot].Ended.end(), 0); }
+}
+
+void RHIGpuProfiler::EndFrame(RHICommandList* pCommandList) {
+    if (!m_CurrentSlot || !pCommandList) { return; }
+
+    const uint32 slotIndex = *m_CurrentSlot;
+    Slot& slot = m_Slots[slotIndex];
+    slot.ZoneCount = std::min(m_NextZone.load(std::memory_order_relaxed), m_MaxZoneCount);
+
+    // Every query in the resolved range must have been written
+    const uint32 base = GetQueryBase(slotIndex);
+    for (uint32 zone = 0; zone < slot.ZoneCount; ++zone) {
+        if (!slot.Ended[zone]) { pCommandList->WriteTimestamp(m_QueryPool.get(), base + zone * 2 + 1); }
+    }
+    if (slot.ZoneCount > 0) {
+        pCommandList->ResolveQueries(m_QueryPool.get(), base, slot.ZoneCount * 2, slot.Readback.get());
+    }
+
+    m_Ring.Submit(slotIndex);
+    m_CurrentSlot.reset();
+}
+
+uint32 RHIGpuProfiler::BeginZone(RHICommandList* pCommandList, std::string_view name) {
+    if (!m_CurrentSlot || !pCommandList) { return InvalidZone; }
+
+    const uint32 zone = m_NextZone.fetch_add(1, std::memory_order_relaxed);
+    if (zone >= m_MaxZoneCount) { return InvalidZone; }
+
+    const uint32 slotIndex = *m_CurrentSlot;
+    m_Slots[slotIndex].Names[zone] = name;
+    pCommandList->WriteTimestamp(m_QueryPool.get(), GetQueryBase(slotIndex) + zone * 2);
+    return zone;
+}
+
+void RHIGpuProfiler::EndZone(RHICommandList* pCommandList, uint32 zone) {
+    if (zone == InvalidZone || !m_CurrentSlot || !pCommandList) { return; }
+
+    const uint32 slotIndex = *m_CurrentSlot;
+    pCommandList->WriteTimestamp(m_QueryPool.get(), GetQueryBase(slotIndex) + zone * 2 + 1);
+    m_Slots[slotIndex].Ended[zone] = 1;
+}
+
+void RHIGpuProfiler::Publish(uint32 slotIndex) {
+    Slot& slot = m_Slots[slotIndex];
+    if (slot.ZoneCount == 0) { return; }
+
+    const RHITimestampCalibration calibration = m_Queue->CalibrateTimestamps();
+    const auto* timestamps = static_cast<const uint64*>(slot.Readback->Map());
+    if (!timestamps || calibration.Frequency == 0) {
+        if (timestamps) { slot.Readback->Unmap(); }
+        return;
+    }
+
+    std::vector<ProfileZone> zones;
+    zones.reserve(slot.ZoneCount);
+    for (uint32 zone = 0; zone < slot.ZoneCount; ++zone) {
+        const uint64 begin = calibration.ToCpuTimeNs(timestamps[zone * 2]);
+        const uint64 end = calibration.ToCpuTimeNs(timestamps[zone * 2 + 1]);
+        zones.push_back({std::move(slot.Names[zone]), m_Track, 0, begin, std::max(begin, end)});
+    }
+    slot.Readback->Unmap();
+
+    // Zones from several command lists interleave, the depth follows from which intervals enclose which
+    std::sort(zones.begin(), zones.end(), [](const ProfileZone& a, const ProfileZone& b) {
+        return a.BeginNs != b.BeginNs ? a.BeginNs < b.BeginNs : a.EndNs > b.EndNs;
+    });
+    std::vector<uint64> openEnds;
+    for (ProfileZone& zone: zones) {
+        while (!openEnds.empty() && openEnds.back() <= zone.BeginNs) { openEnds.pop_back(); }
+        zone.Depth = static_cast<uint32>(openEnds.size());
+        openEnds.push_back(zone.EndNs);
+    }
+
+    Profiler::AddZones(zones);
+}
+
+} // namespace iGe
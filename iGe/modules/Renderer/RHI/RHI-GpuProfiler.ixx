@@ -0,0 +1,125 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.RHI:RHIGpuProfiler;
+import :RHI;
+import :RHIQueue;
+import :RHIBuffer;
+import :RHICommandList;
+import :RHIQuery;
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Query Ring
+// =================================================================================================
+
+// Which readback slot holds the results of which frame. Frame N records into slot N % slotCount and its results
+// are read once frame N has completed on the GPU. A frame whose slot still waits on an older frame goes untimed,
+// the CPU never waits for a readback. Knows nothing of the device, any frame serials drive it.
+export class IGE_API RHIQueryRing {
+public:
+    explicit RHIQueryRing(uint32 slotCount);
+
+    // Slot for the frame being recorded, empty when the frame is dropped
+    std::optional<uint32> Acquire(uint64 frameSerial);
+    // The acquired slot's queries are resolved, its frame is in flight
+    void Submit(uint32 slot);
+    // Frees and returns the oldest in-flight slot whose frame has completed, its results may be read until the
+    // next Acquire
+    std::optional<uint32> RetireNext(uint64 completedSerial);
+
+    uint32 GetSlotCount() const { return static_cast<uint32>(m_Slots.size()); }
+    uint64 GetSlotFrameSerial(uint32 slot) const { return m_Slots[slot].FrameSerial; }
+    uint64 GetDroppedFrameCount() const { return m_DroppedFrameCount; }
+
+private:
+    enum class SlotState : uint8 { Free, Recording, InFlight };
+
+    struct Slot {
+        SlotState State = SlotState::Free;
+        uint64 FrameSerial = 0;
+    };
+
+    std::vector<Slot> m_Slots;
+    uint64 m_DroppedFrameCount = 0;
+};
+
+// =================================================================================================
+// GPU Profiler
+// =================================================================================================
+
+export struct RHIGpuProfilerCreateInfo {
+    RHIQueue* pQueue = nullptr; // Queue the timed command lists are submitted to
+    uint32 FrameLatency = 3;    // Frames the readback may lag behind before frames are dropped
+    uint32 MaxZoneCount = 256;  // Per frame, later zones are not timed
+    std::string TrackName = "GPU";
+};
+
+// Times command list spans with timestamp queries and adds them to the Profiler timeline on a track of their own,
+// FrameLatency frames after they were recorded
+export class IGE_API RHIGpuProfiler {
+public:
+    static constexpr uint32 InvalidZone = std::numeric_limits<uint32>::max();
+
+    RHIGpuProfiler(RHI* pRHI, const RHIGpuProfilerCreateInfo& info);
+    ~RHIGpuProfiler();
+
+    RHIGpuProfiler(const RHIGpuProfiler&) = delete;
+    RHIGpuProfiler& operator=(const RHIGpuProfiler&) = delete;
+
+    // After RHI::BeginFrame. Publishes the frames that have completed and starts timing the new one.
+    void BeginFrame();
+    // Records the resolve, on the frame's last command list for the queue. Zones left open end here.
+    void EndFrame(RHICommandList* pCommandList);
+
+    // Thread-safe for distinct zones, returns InvalidZone when the frame is not timed
+    uint32 BeginZone(RHICommandList* pCommandList, std::string_view name);
+    void EndZone(RHICommandList* pCommandList, uint32 zone);
+
+    uint32 GetTrack() const { return m_Track; }
+    uint64 GetDroppedFrameCount() const { return m_Ring.GetDroppedFrameCount(); }
+
+private:
+    struct Slot {
+        Scope<RHIBuffer> Readback;
+        std::vector<std::string> Names;
+        std::vector<uint8> Ended;
+        uint32 ZoneCount = 0;
+    };
+
+    uint32 GetQueryBase(uint32 slot) const { return slot * m_MaxZoneCount * 2; }
+    void Publish(uint32 slot);
+
+    RHI* m_RHI = nullptr;
+    RHIQueue* m_Queue = nullptr;
+    uint32 m_MaxZoneCount = 0;
+    uint32 m_Track = 0;
+
+    Scope<RHIQueryPool> m_QueryPool;
+    std::vector<Slot> m_Slots;
+    RHIQueryRing m_Ring;
+
+    std::optional<uint32> m_CurrentSlot;
+    std::atomic<uint32> m_NextZone = 0;
+};
+
+// Times the enclosing scope of a command list
+export class RHIGpuProfileScope {
+public:
+    RHIGpuProfileScope(RHIGpuProfiler& profiler, RHICommandList* pCommandList, std::string_view name)
+        : m_Profiler(profiler), m_CommandList(pCommandList), m_Zone(profiler.BeginZone(pCommandList, name)) {}
+    ~RHIGpuProfileScope() { m_Profiler.EndZone(m_CommandList, m_Zone); }
+
+    RHIGpuProfileScope(const RHIGpuProfileScope&) = delete;
+    RHIGpuProfileScope& operator=(const RHIGpuProfileScope&) = delete;
+
+private:
+    RHIGpuProfiler& m_Profiler;
+    RHICommandList* m_CommandList;
+    uint32 m_Zone;
+};
+
+} // namespace iGe
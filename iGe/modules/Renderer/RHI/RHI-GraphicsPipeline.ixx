@@ -306,8 +306,13 @@ export class IGE_API RHIGraphicsPipeline : public RHIResource {
 public:
     ~RHIGraphicsPipeline() override = default;
 
+    RHIPrimitiveTopology GetTopology() const { return m_Topology; }
+
 protected:
-    RHIGraphicsPipeline(const RHIGraphicsPipelineCreateInfo& info) : RHIResource(RHIResourceType::GraphicsPipeline) {}
+    RHIGraphicsPipeline(const RHIGraphicsPipelineCreateInfo& info)
+        : RHIResource(RHIResourceType::GraphicsPipeline), m_Topology(info.InputAssemblyState.Topology) {}
+
+    RHIPrimitiveTopology m_Topology;
 };
 
 } // namespace iGe
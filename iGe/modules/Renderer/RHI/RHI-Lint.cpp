@@ -0,0 +1,565 @@
+module iGe.RHI;
+import :RHILint;
+
+namespace iGe
+{
+
+std::string_view GetRHILintCheckName(RHILintCheck check) {
+    switch (check) {
+        case RHILintCheck::WaitIdleInFrame:
+            return "WaitIdleInFrame";
+        case RHILintCheck::HostAccessGpuOnly:
+            return "HostAccessGpuOnly";
+        case RHILintCheck::RedundantBind:
+            return "RedundantBind";
+        case RHILintCheck::RedundantBarrier:
+            return "RedundantBarrier";
+        case RHILintCheck::InFlightUniformWrite:
+            return "InFlightUniformWrite";
+        case RHILintCheck::ResourceCreatedInFrame:
+            return "ResourceCreatedInFrame";
+        case RHILintCheck::DescriptorPoolExhausted:
+            return "DescriptorPoolExhausted";
+        default:
+            return "Unknown";
+    }
+}
+
+#if defined(IGE_RHI_LINT)
+
+namespace
+{
+
+// The decorator RHI::Init installed, buffers report their host writes to it
+std::atomic<RHILintRHI*> s_pLintRHI = nullptr;
+
+// Dynamic uniform buffers are rings written per frame at other offsets, only plain ones are tracked
+bool IsTrackedUniformWrite(RHIDescriptorType type) { return type == RHIDescriptorType::UniformBuffer; }
+
+uint32 GetDescriptorSlot(uint32 binding, uint32 arrayElement) { return (binding << 16) | arrayElement; }
+
+} // namespace
+
+void RHILintHostWrite(const RHIBuffer* pBuffer) {
+    if (RHILintRHI* lint = s_pLintRHI.load(std::memory_order_acquire); lint && pBuffer) { lint->OnHostWrite(pBuffer); }
+}
+
+// =================================================================================================
+// Lint Objects
+// =================================================================================================
+
+void RHILintCommandList::Reset() {
+    m_Inner->Reset();
+    ClearTracking();
+}
+
+void RHILintCommandList::Begin() {
+    ClearTracking();
+    m_Inner->Begin();
+}
+
+void RHILintCommandList::BindGraphicsPipeline(const RHIGraphicsPipeline* pipeline) {
+    if (pipeline && pipeline == m_pPipeline) {
+        m_pDevice->Report(RHILintCheck::RedundantBind, "Graphics pipeline bound again");
+    } else {
+        // The new pipeline may have another layout, sets bound before are not compared against
+        m_DescriptorSets.clear();
+    }
+    m_pPipeline = pipeline;
+    m_Inner->BindGraphicsPipeline(pipeline);
+}
+
+void RHILintCommandList::BindComputePipeline(const RHIComputePipeline* pipeline) {
+    if (pipeline && pipeline == m_pPipeline) {
+        m_pDevice->Report(RHILintCheck::RedundantBind, "Compute pipeline bound again");
+    } else {
+        m_DescriptorSets.clear();
+    }
+    m_pPipeline = pipeline;
+    m_Inner->BindComputePipeline(pipeline);
+}
+
+void RHILintCommandList::BindDescriptorSet(const RHIPipelineLayout* layout, uint32 setIndex,
+                                           const RHIDescriptorSet* descriptorSet,
+                                           std::span<const uint32> dynamicOffsets) {
+    // New dynamic offsets make a bind of the same set meaningful
+    if (descriptorSet && dynamicOffsets.empty()) {
+        auto [it, inserted] = m_DescriptorSets.try_emplace(setIndex, descriptorSet);
+        if (!inserted && it->second == descriptorSet) {
+            m_pDevice->Report(RHILintCheck::RedundantBind, "Descriptor set {0} bound again", setIndex);
+        }
+        it->second = descriptorSet;
+    } else {
+        m_DescriptorSets.erase(setIndex);
+    }
+
+    m_pDevice->CollectUniformBuffers(descriptorSet, m_UniformBuffers);
+    m_Inner->BindDescriptorSet(layout, setIndex, descriptorSet, dynamicOffsets);
+}
+
+void RHILintCommandList::BindTransientDescriptors(const RHIPipelineLayout* layout, uint32 setIndex,
+                                                  const RHIDescriptorSetLayout* setLayout,
+                                                  std::span<const RHIWriteDescriptorSet> writes) {
+    m_DescriptorSets.erase(setIndex);
+    for (const RHIWriteDescriptorSet& write: writes) {
+        if (!IsTrackedUniformWrite(write.DescriptorType) || !write.pBufferInfos) { continue; }
+        for (uint32 i = 0; i < write.DescriptorCount; ++i) {
+            if (write.pBufferInfos[i].pBuffer) { m_UniformBuffers.push_back(write.pBufferInfos[i].pBuffer); }
+        }
+    }
+    m_Inner->BindTransientDescriptors(layout, setIndex, setLayout, writes);
+}
+
+void RHILintCommandList::BindVertexBuffer(const RHIVertexBuffer* buffer, uint32 binding, uint64 offset) {
+    auto [it, inserted] = m_VertexBuffers.try_emplace(binding, VertexBinding{buffer, offset});
+    if (!inserted && buffer && it->second.pBuffer == buffer && it->second.Offset == offset) {
+        m_pDevice->Report(RHILintCheck::RedundantBind, "Vertex buffer bound again to binding {0}", binding);
+    }
+    it->second = {buffer, offset};
+    m_Inner->BindVertexBuffer(buffer, binding, offset);
+}
+
+void RHILintCommandList::BindIndexBuffer(const RHIIndexBuffer* buffer, uint64 offset) {
+    if (buffer && buffer == m_pIndexBuffer && offset == m_IndexBufferOffset) {
+        m_pDevice->Report(RHILintCheck::RedundantBind, "Index buffer bound again");
+    }
+    m_pIndexBuffer = buffer;
+    m_IndexBufferOffset = offset;
+    m_Inner->BindIndexBuffer(buffer, offset);
+}
+
+void RHILintCommandList::TransitionTexture(const RHITexture* texture, RHILayout newLayout) {
+    TrackLayout(texture, newLayout);
+    m_Inner->TransitionTexture(texture, newLayout);
+}
+
+void RHILintCommandList::TransitionTexture(const RHITexture* texture, RHILayout newLayout, uint32 mipLevel,
+                                           uint32 arrayLayer) {
+    // Subresources may now differ, later whole transitions are not compared
+    m_Layouts.erase(texture);
+    m_Inner->TransitionTexture(texture, newLayout, mipLevel, arrayLayer);
+}
+
+void RHILintCommandList::TransitionBuffer(const RHIBuffer* buffer, RHILayout newLayout) {
+    TrackLayout(buffer, newLayout);
+    m_Inner->TransitionBuffer(buffer, newLayout);
+}
+
+void RHILintCommandList::ResourceBarrier(const RHITexture* texture, RHILayout oldLayout, RHILayout newLayout) {
+    TrackLayout(texture, newLayout);
+    m_Inner->ResourceBarrier(texture, oldLayout, newLayout);
+}
+
+void RHILintCommandList::PipelineBarrier(const RHIBarrierBatch* barriers) {
+    // Explicit barriers order memory as well, they are never redundant but move the tracked layouts
+    if (barriers) {
+        for (const auto& texBarrier: barriers->TextureBarriers) {
+            if (texBarrier.pTexture) { m_Layouts[texBarrier.pTexture] = texBarrier.NewLayout; }
+        }
+        for (const auto& bufBarrier: barriers->BufferBarriers) { m_Layouts.erase(bufBarrier.pBuffer); }
+    }
+    m_Inner->PipelineBarrier(barriers);
+}
+
+void RHILintCommandList::ClearTracking() {
+    m_pPipeline = nullptr;
+    m_DescriptorSets.clear();
+    m_VertexBuffers.clear();
+    m_pIndexBuffer = nullptr;
+    m_IndexBufferOffset = 0;
+    m_Layouts.clear();
+    m_UniformBuffers.clear();
+}
+
+void RHILintCommandList::TrackLayout(const void* pResource, RHILayout newLayout) {
+    if (!pResource) { return; }
+
+    auto [it, inserted] = m_Layouts.try_emplace(pResource, newLayout);
+    if (!inserted && it->second == newLayout) {
+        m_pDevice->Report(RHILintCheck::RedundantBarrier, "Transition to layout {0}, which the list already requested",
+                          static_cast<uint32>(newLayout));
+    }
+    it->second = newLayout;
+}
+
+void RHILintQueue::WaitIdle() {
+    if (m_pDevice->IsInFrame()) { m_pDevice->Report(RHILintCheck::WaitIdleInFrame, "Queue drained inside a frame"); }
+    m_pInner->WaitIdle();
+}
+
+void RHILintQueue::Submit(const RHICommandList* commandList, RHIFence* fence, std::span<RHISemaphore*> waitSemaphores,
+                          std::span<RHISemaphore*> signalSemaphores) {
+    m_pInner->Submit(commandList ? static_cast<const RHILintCommandList*>(commandList)->GetInner() : nullptr, fence,
+                     waitSemaphores, signalSemaphores);
+    if (commandList) { m_pDevice->OnSubmit({&commandList, 1}); }
+}
+
+void RHILintQueue::SubmitCommandLists(std::span<const RHICommandList*> commandLists, RHIFence* signalFence) {
+    std::vector<const RHICommandList*> innerLists;
+    innerLists.reserve(commandLists.size());
+    for (const RHICommandList* commandList: commandLists) {
+        innerLists.push_back(static_cast<const RHILintCommandList*>(commandList)->GetInner());
+    }
+
+    m_pInner->SubmitCommandLists(innerLists, signalFence);
+    m_pDevice->OnSubmit(commandLists);
+}
+
+Scope<RHIDescriptorSet> RHILintDescriptorPool::AllocateDescriptorSet(const RHIDescriptorSetLayout* pLayout) {
+    Scope<RHIDescriptorSet> set = m_Inner->AllocateDescriptorSet(pLayout);
+    if (set) {
+        m_pDevice->ForgetDescriptorSet(set.get());
+    } else {
+        m_pDevice->Report(RHILintCheck::DescriptorPoolExhausted, "Descriptor pool could not allocate a set");
+    }
+    return set;
+}
+
+std::vector<Scope<RHIDescriptorSet>>
+RHILintDescriptorPool::AllocateDescriptorSets(std::span<const RHIDescriptorSetLayout* const> layouts) {
+    std::vector<Scope<RHIDescriptorSet>> sets = m_Inner->AllocateDescriptorSets(layouts);
+
+    uint32 failedCount = 0;
+    for (const auto& set: sets) {
+        if (set) {
+            m_pDevice->ForgetDescriptorSet(set.get());
+        } else {
+            ++failedCount;
+        }
+    }
+    if (failedCount > 0) {
+        m_pDevice->Report(RHILintCheck::DescriptorPoolExhausted, "Descriptor pool could not allocate {0} of {1} sets",
+                          failedCount, layouts.size());
+    }
+    return sets;
+}
+
+// =================================================================================================
+// RHILintRHI
+// =================================================================================================
+
+RHILintRHI::RHILintRHI(Scope<RHI> inner) : m_Inner(std::move(inner)) {
+    for (uint32 i = 0; i < m_Queues.size(); ++i) {
+        RHIQueue* queue = m_Inner->GetQueue(static_cast<RHIQueueType>(i));
+        if (!queue) { continue; }
+        m_Queues[i] = CreateScope<RHILintQueue>(this, queue);
+        m_CommandListManagers[i] = CreateScope<RHICommandListManager>(this, m_Queues[i].get());
+    }
+
+    s_pLintRHI.store(this, std::memory_order_release);
+    Internal::LogInfo("RHILint: Enabled, warnings are logged at the end of each frame");
+}
+
+RHILintRHI::~RHILintRHI() {
+    s_pLintRHI.store(nullptr, std::memory_order_release);
+
+    // Recycled lists go before the backend that owns their pools
+    m_Inner->WaitIdle();
+    for (auto& manager: m_CommandListManagers) { manager.reset(); }
+}
+
+uint32 RHILintRHI::GetLastFrameWarningCount(RHILintCheck check) const {
+    std::lock_guard<std::mutex> lock(m_WarningMutex);
+    return m_LastFrameCounts[static_cast<uint32>(check)];
+}
+
+void RHILintRHI::WaitIdle() {
+    if (IsInFrame()) {
+        Report(RHILintCheck::WaitIdleInFrame, "Device drained inside frame {0}",
+               m_FrameIndex.load(std::memory_order_relaxed));
+    }
+    m_Inner->WaitIdle();
+}
+
+RHIQueue* RHILintRHI::GetQueue(RHIQueueType type, uint32 index) {
+    const uint32 queueIndex = static_cast<uint32>(type);
+    return queueIndex < m_Queues.size() && index == 0 ? m_Queues[queueIndex].get() : nullptr;
+}
+
+uint32 RHILintRHI::GetQueueCount(RHIQueueType type) const {
+    const uint32 queueIndex = static_cast<uint32>(type);
+    return queueIndex < m_Queues.size() && m_Queues[queueIndex] ? 1 : 0;
+}
+
+void RHILintRHI::BeginFrame() {
+    m_Inner->BeginFrame();
+    m_FrameIndex.fetch_add(1, std::memory_order_relaxed);
+    m_InFrame.store(true, std::memory_order_relaxed);
+}
+
+void RHILintRHI::EndFrame(RHIQueue* pQueue) {
+    m_Inner->EndFrame(Unwrap(pQueue));
+    m_InFrame.store(false, std::memory_order_relaxed);
+    FlushWarnings();
+}
+
+Scope<RHISwapChain> RHILintRHI::CreateSwapChain(const RHISwapChainCreateInfo& info) {
+    RHISwapChainCreateInfo innerInfo = info;
+    innerInfo.PresentQueue = Unwrap(info.PresentQueue);
+    return m_Inner->CreateSwapChain(innerInfo);
+}
+
+Scope<RHICommandPool> RHILintRHI::CreateCommandPool(const RHICommandPoolCreateInfo& info) {
+    RHICommandPoolCreateInfo innerInfo = info;
+    innerInfo.pQueue = Unwrap(info.pQueue);
+    return CheckCreate(m_Inner->CreateCommandPool(innerInfo), "Command pool");
+}
+
+RHICommandListManager* RHILintRHI::GetCommandListManager(RHIQueueType type) {
+    const uint32 index = static_cast<uint32>(type);
+    return index < m_CommandListManagers.size() ? m_CommandListManagers[index].get() : nullptr;
+}
+
+Scope<RHICommandList> RHILintRHI::AllocateCommandList(RHICommandPool* pPool) {
+    Scope<RHICommandList> inner = m_Inner->AllocateCommandList(pPool);
+    if (!inner) { return nullptr; }
+    return CreateScope<RHILintCommandList>(this, std::move(inner));
+}
+
+std::vector<Scope<RHICommandList>> RHILintRHI::AllocateCommandLists(RHICommandPool* pPool, uint32 count) {
+    std::vector<Scope<RHICommandList>> commandLists;
+    commandLists.reserve(count);
+    for (uint32 i = 0; i < count; ++i) { commandLists.push_back(AllocateCommandList(pPool)); }
+    return commandLists;
+}
+
+void RHILintRHI::FreeCommandList(RHICommandPool* pPool, RHICommandList* pCommandList) {
+    m_Inner->FreeCommandList(pPool, Unwrap(pCommandList));
+}
+
+void RHILintRHI::FreeCommandLists(RHICommandPool* pPool, std::span<RHICommandList*> commandLists) {
+    std::vector<RHICommandList*> innerLists;
+    innerLists.reserve(commandLists.size());
+    for (RHICommandList* commandList: commandLists) { innerLists.push_back(Unwrap(commandList)); }
+    m_Inner->FreeCommandLists(pPool, innerLists);
+}
+
+Scope<RHIBuffer> RHILintRHI::CreateBuffer(const RHIBufferCreateInfo& info) {
+    return CheckCreate(m_Inner->CreateBuffer(info), "Buffer");
+}
+
+Scope<RHIVertexBuffer> RHILintRHI::CreateVertexBuffer(const RHIVertexBufferCreateInfo& info) {
+    return CheckCreate(m_Inner->CreateVertexBuffer(info), "Vertex buffer");
+}
+
+Scope<RHIIndexBuffer> RHILintRHI::CreateIndexBuffer(const RHIIndexBufferCreateInfo& info) {
+    return CheckCreate(m_Inner->CreateIndexBuffer(info), "Index buffer");
+}
+
+Scope<RHIUniformBuffer> RHILintRHI::CreateUniformBuffer(const RHIUniformBufferCreateInfo& info) {
+    return CheckCreate(m_Inner->CreateUniformBuffer(info), "Uniform buffer");
+}
+
+Scope<RHIStorageBuffer> RHILintRHI::CreateStorageBuffer(const RHIStorageBufferCreateInfo& info) {
+    return CheckCreate(m_Inner->CreateStorageBuffer(info), "Storage buffer");
+}
+
+Scope<RHITexture> RHILintRHI::CreateTexture(const RHITextureCreateInfo& info) {
+    return CheckCreate(m_Inner->CreateTexture(info), "Texture");
+}
+
+Scope<RHITextureView> RHILintRHI::CreateTextureView(const RHITexture* pTexture, const RHITextureViewCreateInfo& info) {
+    return CheckCreate(m_Inner->CreateTextureView(pTexture, info), "Texture view");
+}
+
+Scope<RHISampler> RHILintRHI::CreateSampler(const RHISamplerCreateInfo& info) {
+    return CheckCreate(m_Inner->CreateSampler(info), "Sampler");
+}
+
+Scope<RHIDescriptorSetLayout> RHILintRHI::CreateDescriptorSetLayout(const RHIDescriptorSetLayoutCreateInfo& info) {
+    return CheckCreate(m_Inner->CreateDescriptorSetLayout(info), "Descriptor set layout");
+}
+
+Scope<RHIDescriptorPool> RHILintRHI::CreateDescriptorPool(const RHIDescriptorPoolCreateInfo& info) {
+    Scope<RHIDescriptorPool> inner = m_Inner->CreateDescriptorPool(info);
+    if (!inner) { return nullptr; }
+    return CheckCreate<RHIDescriptorPool>(CreateScope<RHILintDescriptorPool>(this, info, std::move(inner)),
+                                          "Descriptor pool");
+}
+
+void RHILintRHI::UpdateDescriptorSets(std::span<const RHIWriteDescriptorSet> writes) {
+    for (const RHIWriteDescriptorSet& write: writes) { TrackWrite(write); }
+    m_Inner->UpdateDescriptorSets(writes);
+}
+
+Scope<RHIDescriptorUpdateTemplate>
+RHILintRHI::CreateDescriptorUpdateTemplate(const RHIDescriptorUpdateTemplateCreateInfo& info) {
+    Scope<RHIDescriptorUpdateTemplate> updateTemplate = m_Inner->CreateDescriptorUpdateTemplate(info);
+    if (updateTemplate) {
+        std::vector<RHIDescriptorUpdateTemplateEntry> entries;
+        for (const RHIDescriptorUpdateTemplateEntry& entry: info.Entries) {
+            if (IsTrackedUniformWrite(entry.DescriptorType)) { entries.push_back(entry); }
+        }
+
+        std::lock_guard<std::mutex> lock(m_TrackingMutex);
+        m_TemplateEntries[updateTemplate.get()] = std::move(entries);
+    }
+    return CheckCreate(std::move(updateTemplate), "Descriptor update template");
+}
+
+void RHILintRHI::UpdateDescriptorSetWithTemplate(RHIDescriptorSet* pSet, const RHIDescriptorUpdateTemplate* pTemplate,
+                                                 const void* pData) {
+    if (pSet && pData) {
+        std::lock_guard<std::mutex> lock(m_TrackingMutex);
+        auto entries = m_TemplateEntries.find(pTemplate);
+        if (entries != m_TemplateEntries.end()) {
+            auto& slots = m_SetUniformBuffers[pSet];
+            const auto* bytes = static_cast<const std::byte*>(pData);
+            for (const RHIDescriptorUpdateTemplateEntry& entry: entries->second) {
+                const uint64 stride = entry.Stride != 0 ? entry.Stride : sizeof(RHIDescriptorBufferInfo);
+                for (uint32 i = 0; i < entry.DescriptorCount; ++i) {
+                    const auto* info =
+                            reinterpret_cast<const RHIDescriptorBufferInfo*>(bytes + entry.Offset + i * stride);
+                    slots[GetDescriptorSlot(entry.DstBinding, entry.DstArrayElement + i)] = info->pBuffer;
+                }
+            }
+        }
+    }
+    m_Inner->UpdateDescriptorSetWithTemplate(pSet, pTemplate, pData);
+}
+
+Scope<RHIPipelineLayout> RHILintRHI::CreatePipelineLayout(const RHIPipelineLayoutCreateInfo& info) {
+    return CheckCreate(m_Inner->CreatePipelineLayout(info), "Pipeline layout");
+}
+
+Scope<RHIRenderPass> RHILintRHI::CreateRenderPass(const RHIRenderPassCreateInfo& info) {
+    return CheckCreate(m_Inner->CreateRenderPass(info), "Render pass");
+}
+
+Scope<RHIFramebuffer> RHILintRHI::CreateFramebuffer(const RHIFramebufferCreateInfo& info) {
+    return CheckCreate(m_Inner->CreateFramebuffer(info), "Framebuffer");
+}
+
+Scope<RHIShader> RHILintRHI::CreateShader(const RHIShaderCreateInfo& info) {
+    return CheckCreate(m_Inner->CreateShader(info), "Shader");
+}
+
+Scope<RHIGraphicsPipeline> RHILintRHI::CreateGraphicsPipeline(const RHIGraphicsPipelineCreateInfo& info) {
+    return CheckCreate(m_Inner->CreateGraphicsPipeline(info), "Graphics pipeline");
+}
+
+Scope<RHIComputePipeline> RHILintRHI::CreateComputePipeline(const RHIComputePipelineCreateInfo& info) {
+    return CheckCreate(m_Inner->CreateComputePipeline(info), "Compute pipeline");
+}
+
+Scope<RHIQueryPool> RHILintRHI::CreateQueryPool(const RHIQueryPoolCreateInfo& info) {
+    return CheckCreate(m_Inner->CreateQueryPool(info), "Query pool");
+}
+
+void RHILintRHI::OnHostWrite(const RHIBuffer* pBuffer) {
+    if (pBuffer->GetMemoryUsage() == RHIMemoryUsage::GpuOnly) {
+        Report(RHILintCheck::HostAccessGpuOnly, "Host access to a GPU only buffer of {0} bytes", pBuffer->GetSize());
+        return;
+    }
+
+    uint64 lastUse = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_TrackingMutex);
+        auto use = m_UniformBufferUse.find(pBuffer);
+        if (use == m_UniformBufferUse.end()) { return; }
+        lastUse = use->second;
+    }
+
+    const uint64 completed = m_Inner->GetCompletedFrameSerial();
+    if (lastUse > completed) {
+        Report(RHILintCheck::InFlightUniformWrite,
+               "Uniform buffer written while frame {0} may still read it, the GPU completed frame {1}", lastUse,
+               completed);
+    }
+}
+
+void RHILintRHI::OnSubmit(std::span<const RHICommandList* const> commandLists) {
+    const uint64 frameSerial = m_Inner->GetFrameSerial();
+
+    std::lock_guard<std::mutex> lock(m_TrackingMutex);
+    for (const RHICommandList* commandList: commandLists) {
+        for (const RHIBuffer* buffer: static_cast<const RHILintCommandList*>(commandList)->GetUniformBuffers()) {
+            m_UniformBufferUse[buffer] = frameSerial;
+        }
+    }
+}
+
+void RHILintRHI::CollectUniformBuffers(const RHIDescriptorSet* pSet, std::vector<const RHIBuffer*>& buffers) const {
+    std::lock_guard<std::mutex> lock(m_TrackingMutex);
+    auto slots = m_SetUniformBuffers.find(pSet);
+    if (slots == m_SetUniformBuffers.end()) { return; }
+    for (const auto& [slot, buffer]: slots->second) {
+        if (buffer) { buffers.push_back(buffer); }
+    }
+}
+
+void RHILintRHI::ForgetDescriptorSet(const RHIDescriptorSet* pSet) {
+    std::lock_guard<std::mutex> lock(m_TrackingMutex);
+    m_SetUniformBuffers.erase(pSet);
+}
+
+void RHILintRHI::ForgetBuffer(const RHIBuffer* pBuffer) {
+    std::lock_guard<std::mutex> lock(m_TrackingMutex);
+    m_UniformBufferUse.erase(pBuffer);
+}
+
+bool RHILintRHI::CountWarning(const CallSite& site) {
+    std::lock_guard<std::mutex> lock(m_WarningMutex);
+    ++m_FrameCounts[static_cast<uint32>(site.Check)];
+    return ++m_FrameWarnings[site].Count == 1;
+}
+
+void RHILintRHI::SetMessage(const CallSite& site, std::string message) {
+    std::lock_guard<std::mutex> lock(m_WarningMutex);
+    auto warning = m_FrameWarnings.find(site);
+    if (warning != m_FrameWarnings.end()) { warning->second.Message = std::move(message); }
+}
+
+void RHILintRHI::FlushWarnings() {
+    std::lock_guard<std::mutex> lock(m_WarningMutex);
+    m_LastFrameCounts = m_FrameCounts;
+    m_FrameCounts = {};
+    if (m_FrameWarnings.empty()) { return; }
+
+    std::string summary;
+    for (uint32 i = 0; i < m_LastFrameCounts.size(); ++i) {
+        if (m_LastFrameCounts[i] == 0) { continue; }
+        if (!summary.empty()) { summary += ", "; }
+        summary += std::format("{0} {1}", GetRHILintCheckName(static_cast<RHILintCheck>(i)), m_LastFrameCounts[i]);
+    }
+    Internal::LogWarn("RHILint: Frame {0}: {1}", m_FrameIndex.load(std::memory_order_relaxed), summary);
+
+    // Call stacks are resolved once, a warning that repeats every frame only shows up in the counts
+    for (const auto& [site, warning]: m_FrameWarnings) {
+        if (!m_ReportedSites.insert(site).second) { continue; }
+
+        Internal::LogWarn("RHILint: {0} ({1}x): {2}", GetRHILintCheckName(site.Check), warning.Count, warning.Message);
+        for (const std::stacktrace_entry& entry: site.Stack) { Internal::LogWarn("    at {0}", std::to_string(entry)); }
+    }
+    m_FrameWarnings.clear();
+}
+
+void RHILintRHI::TrackWrite(const RHIWriteDescriptorSet& write) {
+    if (!write.pDstSet) { return; }
+
+    std::lock_guard<std::mutex> lock(m_TrackingMutex);
+    auto& slots = m_SetUniformBuffers[write.pDstSet];
+    for (uint32 i = 0; i < write.DescriptorCount; ++i) {
+        const uint32 slot = GetDescriptorSlot(write.DstBinding, write.DstArrayElement + i);
+        if (IsTrackedUniformWrite(write.DescriptorType) && write.pBufferInfos) {
+            slots[slot] = write.pBufferInfos[i].pBuffer;
+        } else {
+            slots.erase(slot);
+        }
+    }
+}
+
+RHIQueue* RHILintRHI::Unwrap(const RHIQueue* pQueue) const {
+    for (const auto& queue: m_Queues) {
+        if (queue && queue.get() == pQueue) { return queue->GetInner(); }
+    }
+    return const_cast<RHIQueue*>(pQueue);
+}
+
+RHICommandList* RHILintRHI::Unwrap(const RHICommandList* pCommandList) {
+    return pCommandList ? static_cast<const RHILintCommandList*>(pCommandList)->GetInner() : nullptr;
+}
+
+#endif
+
+} // namespace iGe
@@ -0,0 +1,434 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.RHI:RHILint;
+import :RHI;
+import :RHIResource;
+import :RHIBuffer;
+import :RHITexture;
+import :RHITextureView;
+import :RHIDescriptor;
+import :RHIBarrier;
+import :RHIRenderPass;
+import :RHIFramebuffer;
+import :RHIShader;
+import :RHIGraphicsPipeline;
+import :RHIComputePipeline;
+import :RHIQuery;
+import :RHIQueue;
+import :RHISwapChain;
+import :RHICommandList;
+import :RHICommandListManager;
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Lint Checks
+// =================================================================================================
+
+export enum class RHILintCheck : uint32 {
+    WaitIdleInFrame = 0,    // Device or queue drained between BeginFrame and EndFrame
+    HostAccessGpuOnly,      // Map or Update of a GpuOnly buffer
+    RedundantBind,          // Pipeline, descriptor set or vertex/index buffer that is already bound
+    RedundantBarrier,       // Transition to the layout the list already moved the resource to
+    InFlightUniformWrite,   // Host write to a uniform buffer a frame on the GPU still reads
+    ResourceCreatedInFrame, // Object creation inside a frame, after the first frames
+    DescriptorPoolExhausted,
+
+    Count
+};
+
+export IGE_API std::string_view GetRHILintCheckName(RHILintCheck check);
+
+// Buffers are not wrapped, backends report host writes here. Empty unless built with IGE_RHI_LINT.
+#if defined(IGE_RHI_LINT)
+export IGE_API void RHILintHostWrite(const RHIBuffer* pBuffer);
+#else
+export inline void RHILintHostWrite(const RHIBuffer* pBuffer) {}
+#endif
+
+#if defined(IGE_RHI_LINT)
+
+// =================================================================================================
+// Lint Device
+// =================================================================================================
+
+class RHILintRHI;
+
+// Tracks what this list bound and transitioned since Begin, redundant requests are reported with their call site
+class RHILintCommandList final : public RHICommandList {
+public:
+    RHILintCommandList(RHILintRHI* pDevice, Scope<RHICommandList> inner)
+        : m_pDevice(pDevice), m_Inner(std::move(inner)) {}
+
+    RHICommandList* GetInner() const { return m_Inner.get(); }
+    // Uniform buffers behind the descriptors bound since Begin
+    std::span<const RHIBuffer* const> GetUniformBuffers() const { return m_UniformBuffers; }
+
+    void Reset() override;
+    void Begin() override;
+    void End() override { m_Inner->End(); }
+
+    void BeginRenderPass(const RHIRenderPassBeginInfo& info) override { m_Inner->BeginRenderPass(info); }
+    void EndRenderPass() override { m_Inner->EndRenderPass(); }
+    void NextSubpass() override { m_Inner->NextSubpass(); }
+
+    void BindGraphicsPipeline(const RHIGraphicsPipeline* pipeline) override;
+    void BindComputePipeline(const RHIComputePipeline* pipeline) override;
+    void BindDescriptorSet(const RHIPipelineLayout* layout, uint32 setIndex, const RHIDescriptorSet* descriptorSet,
+                           std::span<const uint32> dynamicOffsets = {}) override;
+    void BindTransientDescriptors(const RHIPipelineLayout* layout, uint32 setIndex,
+                                  const RHIDescriptorSetLayout* setLayout,
+                                  std::span<const RHIWriteDescriptorSet> writes) override;
+    void BindVertexBuffer(const RHIVertexBuffer* buffer, uint32 binding = 0, uint64 offset = 0) override;
+    void BindIndexBuffer(const RHIIndexBuffer* buffer, uint64 offset = 0) override;
+    // Spelled out, the base class adds a template PushConstants
+    void PushConstants(const RHIPipelineLayout* layout, Flags<RHIShaderStage> stageFlags, uint32 offset, uint32 size,
+                       const void* data) override {
+        m_Inner->PushConstants(layout, stageFlags, offset, size, data);
+    }
+
+    void SetViewport(const RHIViewport& viewport) override { m_Inner->SetViewport(viewport); }
+    void SetScissor(const RHIScissor& scissor) override { m_Inner->SetScissor(scissor); }
+    void SetLineWidth(float lineWidth) override { m_Inner->SetLineWidth(lineWidth); }
+    void SetDepthBias(float constantFactor, float clamp, float slopeFactor) override {
+        m_Inner->SetDepthBias(constantFactor, clamp, slopeFactor);
+    }
+    void SetBlendConstants(const float blendConstants[4]) override { m_Inner->SetBlendConstants(blendConstants); }
+    void SetDepthBounds(float minDepthBounds, float maxDepthBounds) override {
+        m_Inner->SetDepthBounds(minDepthBounds, maxDepthBounds);
+    }
+    void SetStencilCompareMask(bool front, bool back, uint32 compareMask) override {
+        m_Inner->SetStencilCompareMask(front, back, compareMask);
+    }
+    void SetStencilWriteMask(bool front, bool back, uint32 writeMask) override {
+        m_Inner->SetStencilWriteMask(front, back, writeMask);
+    }
+    void SetStencilReference(bool front, bool back, uint32 reference) override {
+        m_Inner->SetStencilReference(front, back, reference);
+    }
+
+    void Draw(uint32 vertexCount, uint32 instanceCount = 1, uint32 firstVertex = 0, uint32 firstInstance = 0) override {
+        m_Inner->Draw(vertexCount, instanceCount, firstVertex, firstInstance);
+    }
+    void DrawIndexed(uint32 indexCount, uint32 instanceCount = 1, uint32 firstIndex = 0, int32 vertexOffset = 0,
+                     uint32 firstInstance = 0) override {
+        m_Inner->DrawIndexed(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+    }
+    void Dispatch(uint32 groupCountX, uint32 groupCountY = 1, uint32 groupCountZ = 1) override {
+        m_Inner->Dispatch(groupCountX, groupCountY, groupCountZ);
+    }
+
+    void TransitionTexture(const RHITexture* texture, RHILayout newLayout) override;
+    void TransitionTexture(const RHITexture* texture, RHILayout newLayout, uint32 mipLevel, uint32 arrayLayer) override;
+    void TransitionBuffer(const RHIBuffer* buffer, RHILayout newLayout) override;
+    void ResourceBarrier(const RHITexture* texture, RHILayout oldLayout, RHILayout newLayout) override;
+    void PipelineBarrier(const RHIBarrierBatch* barriers) override;
+
+    void CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture) override {
+        m_Inner->CopyBufferToTexture(srcBuffer, dstTexture);
+    }
+    void CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture,
+                             const RHIBufferTextureCopy& region) override {
+        m_Inner->CopyBufferToTexture(srcBuffer, dstTexture, region);
+    }
+    void CopyBufferToTexture(const RHIBuffer* srcBuffer, const RHITexture* dstTexture,
+                             std::span<const RHIBufferTextureCopy> regions) override {
+        m_Inner->CopyBufferToTexture(srcBuffer, dstTexture, regions);
+    }
+    void CopyTextureToBuffer(const RHITexture* srcTexture, const RHIBuffer* dstBuffer) override {
+        m_Inner->CopyTextureToBuffer(srcTexture, dstBuffer);
+    }
+    void CopyBuffer(const RHIBuffer* srcBuffer, const RHIBuffer* dstBuffer, uint64 srcOffset, uint64 dstOffset,
+                    uint64 size) override {
+        m_Inner->CopyBuffer(srcBuffer, dstBuffer, srcOffset, dstOffset, size);
+    }
+    void BlitTexture(const RHITexture* srcTexture, const RHITexture* dstTexture,
+                     RHISamplerFilter filter = RHISamplerFilter::Linear) override {
+        m_Inner->BlitTexture(srcTexture, dstTexture, filter);
+    }
+
+    void ClearColorAttachment(uint32 attachmentIndex, const float color[4], const RHIRect2D& rect) override {
+        m_Inner->ClearColorAttachment(attachmentIndex, color, rect);
+    }
+    void ClearDepthStencilAttachment(float depth, uint32 stencil, bool clearDepth, bool clearStencil,
+                                     const RHIRect2D& rect) override {
+        m_Inner->ClearDepthStencilAttachment(depth, stencil, clearDepth, clearStencil, rect);
+    }
+    void ClearTexture(const RHITexture* texture, const float color[4]) override {
+        m_Inner->ClearTexture(texture, color);
+    }
+    void ClearBuffer(const RHIBuffer* buffer, uint32 value, uint64 offset = 0, uint64 size = ~0ULL) override {
+        m_Inner->ClearBuffer(buffer, value, offset, size);
+    }
+
+    void WriteTimestamp(const RHIQueryPool* pool, uint32 index) override { m_Inner->WriteTimestamp(pool, index); }
+    void BeginQuery(const RHIQueryPool* pool, uint32 index) override { m_Inner->BeginQuery(pool, index); }
+    void EndQuery(const RHIQueryPool* pool, uint32 index) override { m_Inner->EndQuery(pool, index); }
+    void ResolveQueries(const RHIQueryPool* pool, uint32 firstIndex, uint32 count, const RHIBuffer* dstBuffer,
+                        uint64 dstOffset = 0) override {
+        m_Inner->ResolveQueries(pool, firstIndex, count, dstBuffer, dstOffset);
+    }
+
+    void BeginDebugLabel(const std::string& label, const float color[4] = nullptr) override {
+        m_Inner->BeginDebugLabel(label, color);
+    }
+    void EndDebugLabel() override { m_Inner->EndDebugLabel(); }
+    void InsertDebugLabel(const std::string& label, const float color[4] = nullptr) override {
+        m_Inner->InsertDebugLabel(label, color);
+    }
+
+    uint64 GetFilteredCommandCount() const override { return m_Inner->GetFilteredCommandCount(); }
+
+private:
+    struct VertexBinding {
+        const RHIVertexBuffer* pBuffer = nullptr;
+        uint64 Offset = 0;
+    };
+
+    void ClearTracking();
+    void TrackLayout(const void* pResource, RHILayout newLayout);
+
+    RHILintRHI* m_pDevice = nullptr;
+    Scope<RHICommandList> m_Inner;
+
+    // State requested since Begin
+    const void* m_pPipeline = nullptr;
+    std::unordered_map<uint32, const RHIDescriptorSet*> m_DescriptorSets; // By set index, for the bound pipeline
+    std::unordered_map<uint32, VertexBinding> m_VertexBuffers;
+    const RHIIndexBuffer* m_pIndexBuffer = nullptr;
+    uint64 m_IndexBufferOffset = 0;
+    std::unordered_map<const void*, RHILayout> m_Layouts; // Whole resource transitions
+    std::vector<const RHIBuffer*> m_UniformBuffers;
+};
+
+class RHILintQueue final : public RHIQueue {
+public:
+    RHILintQueue(RHILintRHI* pDevice, RHIQueue* pInner)
+        : RHIQueue({pInner->GetQueueType(), 0}), m_pDevice(pDevice), m_pInner(pInner) {}
+
+    RHIQueue* GetInner() const { return m_pInner; }
+    void* GetNativeHandle() const override { return m_pInner->GetNativeHandle(); }
+
+    void WaitIdle() override;
+
+    void Submit(const RHICommandList* commandList, RHIFence* fence = nullptr,
+                std::span<RHISemaphore*> waitSemaphores = {}, std::span<RHISemaphore*> signalSemaphores = {}) override;
+    void SubmitCommandLists(std::span<const RHICommandList*> commandLists, RHIFence* signalFence = nullptr) override;
+
+    void Signal(RHIFence* fence, uint64 value) override { m_pInner->Signal(fence, value); }
+    void Wait(RHIFence* fence, uint64 value) override { m_pInner->Wait(fence, value); }
+
+    RHITimestampCalibration CalibrateTimestamps() const override { return m_pInner->CalibrateTimestamps(); }
+
+private:
+    RHILintRHI* m_pDevice = nullptr;
+    RHIQueue* m_pInner = nullptr;
+};
+
+// Reports allocations the pool could not serve
+class RHILintDescriptorPool final : public RHIDescriptorPool {
+public:
+    RHILintDescriptorPool(RHILintRHI* pDevice, const RHIDescriptorPoolCreateInfo& info, Scope<RHIDescriptorPool> inner)
+        : RHIDescriptorPool(info), m_pDevice(pDevice), m_Inner(std::move(inner)) {}
+
+    void* GetNativeHandle() const override { return m_Inner->GetNativeHandle(); }
+
+    void Reset() override { m_Inner->Reset(); }
+    Scope<RHIDescriptorSet> AllocateDescriptorSet(const RHIDescriptorSetLayout* pLayout) override;
+    std::vector<Scope<RHIDescriptorSet>>
+    AllocateDescriptorSets(std::span<const RHIDescriptorSetLayout* const> layouts) override;
+    void FreeDescriptorSet(RHIDescriptorSet* pSet) override { m_Inner->FreeDescriptorSet(pSet); }
+    void FreeDescriptorSets(std::span<RHIDescriptorSet*> sets) override { m_Inner->FreeDescriptorSets(sets); }
+
+private:
+    RHILintRHI* m_pDevice = nullptr;
+    Scope<RHIDescriptorPool> m_Inner;
+};
+
+// Decorator installed by RHI::Init in builds with IGE_RHI_LINT when RHI::Config::EnableLint is set. Flags RHI
+// usage that costs performance without being an error. Warnings are grouped by check and call stack, EndFrame
+// logs the call stacks not seen before and one line with the frame's counts per check.
+export class IGE_API RHILintRHI final : public RHI {
+public:
+    RHILintRHI(Scope<RHI> inner);
+    ~RHILintRHI() override;
+
+    RHI* GetInner() const { return m_Inner.get(); }
+    bool IsInFrame() const { return m_InFrame.load(std::memory_order_relaxed); }
+
+    // Warnings of the last ended frame
+    uint32 GetLastFrameWarningCount(RHILintCheck check) const;
+
+    // Frames after startup whose object creation is not reported, loading often finishes lazily
+    static constexpr uint64 WarmupFrameCount = 3;
+    // Frames of each call stack kept, the lint layer's own frame included
+    static constexpr uint32 CallStackDepth = 6;
+
+    // =============================================================================
+    // Device Operations
+    // =============================================================================
+
+    void WaitIdle() override;
+
+    const RHIDeviceProperties& GetDeviceProperties() const override { return m_Inner->GetDeviceProperties(); }
+    const RHIMemoryProperties& GetMemoryProperties() const override { return m_Inner->GetMemoryProperties(); }
+    RHIFormatProperties GetFormatProperties(RHIFormat format) const override {
+        return m_Inner->GetFormatProperties(format);
+    }
+
+    RHIQueue* GetQueue(RHIQueueType type, uint32 index = 0) override;
+    uint32 GetQueueCount(RHIQueueType type) const override;
+
+    void BeginFrame() override;
+    void EndFrame(RHIQueue* pQueue) override;
+    uint64 GetFrameSerial() const override { return m_Inner->GetFrameSerial(); }
+    uint64 GetCompletedFrameSerial() const override { return m_Inner->GetCompletedFrameSerial(); }
+    RHIConstantAllocator* GetConstantAllocator() override { return m_Inner->GetConstantAllocator(); }
+    RHIMemoryStats GetMemoryStats() const override { return m_Inner->GetMemoryStats(); }
+    RHIDefragmentationResult DefragmentMemory(RHICommandList* pCommandList,
+                                              const RHIDefragmentationLimits& limits = {}) override {
+        return m_Inner->DefragmentMemory(Unwrap(pCommandList), limits);
+    }
+
+    // =============================================================================
+    // Object Creation
+    // =============================================================================
+
+    Scope<RHISurface> CreateSurface(const RHISurfaceCreateInfo& info) override { return m_Inner->CreateSurface(info); }
+    Scope<RHISwapChain> CreateSwapChain(const RHISwapChainCreateInfo& info) override;
+
+    Scope<RHICommandPool> CreateCommandPool(const RHICommandPoolCreateInfo& info) override;
+    RHICommandListManager* GetCommandListManager(RHIQueueType type) override;
+    Scope<RHICommandList> AllocateCommandList(RHICommandPool* pPool) override;
+    std::vector<Scope<RHICommandList>> AllocateCommandLists(RHICommandPool* pPool, uint32 count) override;
+    void FreeCommandList(RHICommandPool* pPool, RHICommandList* pCommandList) override;
+    void FreeCommandLists(RHICommandPool* pPool, std::span<RHICommandList*> commandLists) override;
+
+    Scope<RHIBuffer> CreateBuffer(const RHIBufferCreateInfo& info) override;
+    Scope<RHIVertexBuffer> CreateVertexBuffer(const RHIVertexBufferCreateInfo& info) override;
+    Scope<RHIIndexBuffer> CreateIndexBuffer(const RHIIndexBufferCreateInfo& info) override;
+    Scope<RHIUniformBuffer> CreateUniformBuffer(const RHIUniformBufferCreateInfo& info) override;
+    Scope<RHIStorageBuffer> CreateStorageBuffer(const RHIStorageBufferCreateInfo& info) override;
+
+    Scope<RHITexture> CreateTexture(const RHITextureCreateInfo& info) override;
+    Scope<RHITextureView> CreateTextureView(const RHITexture* pTexture, const RHITextureViewCreateInfo& info) override;
+    Scope<RHISampler> CreateSampler(const RHISamplerCreateInfo& info) override;
+
+    Scope<RHIDescriptorSetLayout> CreateDescriptorSetLayout(const RHIDescriptorSetLayoutCreateInfo& info) override;
+    Scope<RHIDescriptorPool> CreateDescriptorPool(const RHIDescriptorPoolCreateInfo& info) override;
+    void UpdateDescriptorSets(std::span<const RHIWriteDescriptorSet> writes) override;
+    void CopyDescriptorSets(std::span<const RHICopyDescriptorSet> copies) override {
+        m_Inner->CopyDescriptorSets(copies);
+    }
+    Scope<RHIDescriptorUpdateTemplate>
+    CreateDescriptorUpdateTemplate(const RHIDescriptorUpdateTemplateCreateInfo& info) override;
+    void UpdateDescriptorSetWithTemplate(RHIDescriptorSet* pSet, const RHIDescriptorUpdateTemplate* pTemplate,
+                                         const void* pData) override;
+
+    Scope<RHIPipelineLayout> CreatePipelineLayout(const RHIPipelineLayoutCreateInfo& info) override;
+    Scope<RHIRenderPass> CreateRenderPass(const RHIRenderPassCreateInfo& info) override;
+    Scope<RHIFramebuffer> CreateFramebuffer(const RHIFramebufferCreateInfo& info) override;
+    Scope<RHIShader> CreateShader(const RHIShaderCreateInfo& info) override;
+    Scope<RHIGraphicsPipeline> CreateGraphicsPipeline(const RHIGraphicsPipelineCreateInfo& info) override;
+    Scope<RHIComputePipeline> CreateComputePipeline(const RHIComputePipelineCreateInfo& info) override;
+    Scope<RHIQueryPool> CreateQueryPool(const RHIQueryPoolCreateInfo& info) override;
+
+    Scope<RHIFence> CreateGPUFence(const RHIFenceCreateInfo& info) override { return m_Inner->CreateGPUFence(info); }
+    Scope<RHISemaphore> CreateGPUSemaphore() override { return m_Inner->CreateGPUSemaphore(); }
+    bool WaitForFences(std::span<RHIFence* const> fences, bool waitAll = true,
+                       uint64 timeout = std::numeric_limits<uint64>::max()) override {
+        return m_Inner->WaitForFences(fences, waitAll, timeout);
+    }
+    void ResetFences(std::span<RHIFence* const> fences) override { m_Inner->ResetFences(fences); }
+
+    void DestroyResource(RHIResource* pResource) override { m_Inner->DestroyResource(pResource); }
+
+    // =============================================================================
+    // Reporting (called by the wrapped objects)
+    // =============================================================================
+
+    // The message is only formatted for the first warning of a call stack in a frame
+    template<typename... Args>
+    void Report(RHILintCheck check, std::format_string<Args...> format, Args&&... args) {
+        // Skips this frame, the caller is the lint layer's own entry point
+        CallSite site{check, std::stacktrace::current(1, CallStackDepth)};
+        if (CountWarning(site)) { SetMessage(site, std::format(format, std::forward<Args>(args)...)); }
+    }
+
+    void OnHostWrite(const RHIBuffer* pBuffer);
+    // Uniform buffers of submitted lists stay in flight until the current frame completes
+    void OnSubmit(std::span<const RHICommandList* const> commandLists);
+    void CollectUniformBuffers(const RHIDescriptorSet* pSet, std::vector<const RHIBuffer*>& buffers) const;
+    // A new object may reuse the address of a destroyed one
+    void ForgetDescriptorSet(const RHIDescriptorSet* pSet);
+    void ForgetBuffer(const RHIBuffer* pBuffer);
+
+private:
+    struct CallSite {
+        RHILintCheck Check = RHILintCheck::Count;
+        std::stacktrace Stack;
+
+        bool operator==(const CallSite&) const = default;
+    };
+
+    struct CallSiteHash {
+        size_t operator()(const CallSite& site) const {
+            return std::hash<std::stacktrace>{}(site.Stack) ^ static_cast<size_t>(site.Check);
+        }
+    };
+
+    struct Warning {
+        uint32 Count = 0;
+        std::string Message;
+    };
+
+    // Returns true for the first warning of the call site in this frame
+    bool CountWarning(const CallSite& site);
+    void SetMessage(const CallSite& site, std::string message);
+    void FlushWarnings();
+
+    template<typename T>
+    Scope<T> CheckCreate(Scope<T> object, std::string_view type) {
+        const uint64 frameIndex = m_FrameIndex.load(std::memory_order_relaxed);
+        if (object && IsInFrame() && frameIndex > WarmupFrameCount) {
+            Report(RHILintCheck::ResourceCreatedInFrame, "{0} created in frame {1}", type, frameIndex);
+        }
+        if constexpr (std::is_base_of_v<RHIBuffer, T>) {
+            if (object) { ForgetBuffer(object.get()); }
+        }
+        return object;
+    }
+
+    void TrackWrite(const RHIWriteDescriptorSet& write);
+    RHIQueue* Unwrap(const RHIQueue* pQueue) const;
+    static RHICommandList* Unwrap(const RHICommandList* pCommandList);
+
+    Scope<RHI> m_Inner;
+
+    std::array<Scope<RHILintQueue>, static_cast<size_t>(RHIQueueType::Count)> m_Queues;
+    std::array<Scope<RHICommandListManager>, static_cast<size_t>(RHIQueueType::Count)> m_CommandListManagers;
+
+    std::atomic<bool> m_InFrame = false;
+    std::atomic<uint64> m_FrameIndex = 0; // BeginFrame calls so far
+
+    // Uniform buffers behind each descriptor set and template, and the frame serial that last read each buffer
+    mutable std::mutex m_TrackingMutex;
+    // Per set, keyed by binding << 16 | array element
+    std::unordered_map<const RHIDescriptorSet*, std::unordered_map<uint32, const RHIBuffer*>> m_SetUniformBuffers;
+    std::unordered_map<const RHIDescriptorUpdateTemplate*, std::vector<RHIDescriptorUpdateTemplateEntry>>
+            m_TemplateEntries;
+    std::unordered_map<const RHIBuffer*, uint64> m_UniformBufferUse;
+
+    mutable std::mutex m_WarningMutex;
+    std::unordered_map<CallSite, Warning, CallSiteHash> m_FrameWarnings;
+    std::unordered_set<CallSite, CallSiteHash> m_ReportedSites;
+    std::array<uint32, static_cast<size_t>(RHILintCheck::Count)> m_FrameCounts{};
+    std::array<uint32, static_cast<size_t>(RHILintCheck::Count)> m_LastFrameCounts{};
+};
+
+#endif
+
+} // namespace iGe
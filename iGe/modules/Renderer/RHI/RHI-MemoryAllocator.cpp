@@ -0,0 +1,247 @@
+module iGe.RHI;
+import :RHIMemoryAllocator;
+
+namespace iGe
+{
+
+RHIMemoryAllocator::RHIMemoryAllocator(const RHIMemoryAllocatorCreateInfo& info) {
+    // Block ranges are tracked in 32-bit units
+    constexpr uint64 maxBlockSize = 1ull << 31;
+    m_BlockSize = std::clamp<uint64>(info.BlockSize, 1ull << 16, maxBlockSize);
+    m_DedicatedThreshold = std::min(info.DedicatedThreshold, maxBlockSize / 2);
+
+    for (uint32 i = 0; i < PoolCount; ++i) {
+        m_Pools[i].Usage = static_cast<RHIMemoryUsage>(i / KindCount);
+        m_Pools[i].Kind = static_cast<RHIMemoryResourceKind>(i % KindCount);
+    }
+}
+
+RHIMemoryAllocation RHIMemoryAllocator::Allocate(const RHIMemoryRequest& request) {
+    const uint32 usage = static_cast<uint32>(request.Usage);
+    const uint32 kind = static_cast<uint32>(request.Kind);
+    if (request.Size == 0 || usage >= RHIMemoryStats::UsageCount || kind >= KindCount) { return {}; }
+
+    const uint32 poolIndex = usage * KindCount + kind;
+    const uint64 alignment = std::max<uint64>(1, request.Alignment);
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if (request.Dedicated || request.Size > m_DedicatedThreshold) {
+        ++m_DedicatedCount;
+        m_DedicatedBytes += request.Size;
+        return {poolIndex, RHIMemoryAllocation::DedicatedBlock, 0, request.Size};
+    }
+
+    // First fit over the existing blocks, the TLSF lookup inside each block is O(1)
+    Pool& pool = m_Pools[poolIndex];
+    const uint32 size = static_cast<uint32>(request.Size);
+    for (uint32 i = 0; i < pool.Blocks.size(); ++i) {
+        if (!pool.Blocks[i]) { continue; }
+
+        const uint32 offset = pool.Blocks[i]->Ranges.Allocate(size, static_cast<uint32>(alignment));
+        if (offset != RHIRangeAllocator::InvalidOffset) {
+            if (request.pRelocationOwner) {
+                pool.Blocks[i]->Movable[offset] = {request.pRelocationOwner, size, static_cast<uint32>(alignment)};
+            }
+            return {poolIndex, i, offset, size};
+        }
+    }
+
+    const uint64 blockSize = std::max(m_BlockSize, AlignUp(request.Size + alignment, 1ull << 16));
+    const uint32 blockIndex = CreatePoolBlock(pool, blockSize);
+    if (blockIndex == RHIMemoryAllocation::InvalidBlock) { return {}; }
+
+    const uint32 offset = pool.Blocks[blockIndex]->Ranges.Allocate(size, static_cast<uint32>(alignment));
+    if (offset == RHIRangeAllocator::InvalidOffset) { return {}; }
+    if (request.pRelocationOwner) {
+        pool.Blocks[blockIndex]->Movable[offset] = {request.pRelocationOwner, size, static_cast<uint32>(alignment)};
+    }
+    return {poolIndex, blockIndex, offset, size};
+}
+
+void RHIMemoryAllocator::Free(const RHIMemoryAllocation& allocation) {
+    if (!allocation.IsValid() || allocation.PoolIndex >= PoolCount) { return; }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if (allocation.IsDedicated()) {
+        --m_DedicatedCount;
+        m_DedicatedBytes -= allocation.Size;
+        return;
+    }
+
+    Pool& pool = m_Pools[allocation.PoolIndex];
+    if (allocation.BlockIndex >= pool.Blocks.size() || !pool.Blocks[allocation.BlockIndex]) {
+        Internal::LogError("RHIMemoryAllocator: Freeing an allocation of unknown block {0}", allocation.BlockIndex);
+        return;
+    }
+
+    auto& block = pool.Blocks[allocation.BlockIndex];
+    block->Ranges.Free(static_cast<uint32>(allocation.Offset));
+    block->Movable.erase(static_cast<uint32>(allocation.Offset));
+
+    // Keep a single empty block per pool as a spare
+    if (block->Ranges.GetAllocationCount() == 0 && HasOtherEmptyBlock(pool, allocation.BlockIndex)) {
+        DestroyBlock(block->Handle);
+        block.reset();
+    }
+}
+
+void* RHIMemoryAllocator::GetBlockHandle(const RHIMemoryAllocation& allocation) const {
+    if (!allocation.IsValid() || allocation.IsDedicated() || allocation.PoolIndex >= PoolCount) { return nullptr; }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    const Pool& pool = m_Pools[allocation.PoolIndex];
+    if (allocation.BlockIndex >= pool.Blocks.size() || !pool.Blocks[allocation.BlockIndex]) { return nullptr; }
+    return pool.Blocks[allocation.BlockIndex]->Handle;
+}
+
+RHIMemoryStats RHIMemoryAllocator::GetStats() const {
+    RHIMemoryStats stats{};
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (const Pool& pool: m_Pools) {
+        auto& usageStats = stats.Usages[static_cast<uint32>(pool.Usage)];
+        for (const auto& block: pool.Blocks) {
+            if (!block) { continue; }
+
+            const auto& ranges = block->Ranges;
+            for (RHIMemoryPoolStats* target: {&usageStats, &stats.Pooled}) {
+                ++target->BlockCount;
+                target->AllocationCount += ranges.GetAllocationCount();
+                target->BlockBytes += ranges.GetCapacity();
+                target->AllocatedBytes += ranges.GetCapacity() - ranges.GetFreeSize();
+                target->LargestFreeRange = std::max<uint64>(target->LargestFreeRange, ranges.GetLargestFreeRange());
+            }
+        }
+    }
+
+    stats.DedicatedCount = m_DedicatedCount;
+    stats.DedicatedBytes = m_DedicatedBytes;
+    QueryBudget(stats.BudgetBytes, stats.UsageBytes);
+    return stats;
+}
+
+std::vector<RHIMemoryMove> RHIMemoryAllocator::PlanDefragmentation(const RHIDefragmentationLimits& limits) {
+    std::vector<RHIMemoryMove> moves;
+    uint64 bytes = 0;
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (uint32 i = 0; i < PoolCount && moves.size() < limits.MaxMoves && bytes < limits.MaxBytes; ++i) {
+        PlanPoolDefragmentation(i, limits, bytes, moves);
+    }
+    return moves;
+}
+
+void RHIMemoryAllocator::CancelMove(const RHIMemoryMove& move) {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        Pool& pool = m_Pools[move.Src.PoolIndex];
+        if (move.Src.BlockIndex < pool.Blocks.size() && pool.Blocks[move.Src.BlockIndex]) {
+            auto& dstBlock = pool.Blocks[move.Dst.BlockIndex];
+            const Relocation relocation = dstBlock->Movable[static_cast<uint32>(move.Dst.Offset)];
+            pool.Blocks[move.Src.BlockIndex]->Movable[static_cast<uint32>(move.Src.Offset)] = relocation;
+        }
+    }
+    Free(move.Dst);
+}
+
+void RHIMemoryAllocator::PlanPoolDefragmentation(uint32 poolIndex, const RHIDefragmentationLimits& limits,
+                                                 uint64& bytes, std::vector<RHIMemoryMove>& moves) {
+    Pool& pool = m_Pools[poolIndex];
+
+    // Blocks with allocations, least occupied first
+    std::vector<uint32> order;
+    for (uint32 i = 0; i < pool.Blocks.size(); ++i) {
+        if (pool.Blocks[i] && pool.Blocks[i]->Ranges.GetAllocationCount() > 0) { order.push_back(i); }
+    }
+    if (order.size() < 2) { return; }
+
+    auto usedBytes = [&](uint32 index) {
+        const auto& ranges = pool.Blocks[index]->Ranges;
+        return ranges.GetCapacity() - ranges.GetFreeSize();
+    };
+    std::sort(order.begin(), order.end(), [&](uint32 a, uint32 b) { return usedBytes(a) < usedBytes(b); });
+
+    // Drain the emptiest fully movable block into the fuller ones. One source per pass, a block that received
+    // moves must not become a source before those copies executed
+    for (size_t source = 0; source + 1 < order.size(); ++source) {
+        Block& srcBlock = *pool.Blocks[order[source]];
+        if (srcBlock.Movable.size() != srcBlock.Ranges.GetAllocationCount()) { continue; }
+
+        uint64 freeElsewhere = 0;
+        for (size_t i = source + 1; i < order.size(); ++i) {
+            freeElsewhere += pool.Blocks[order[i]]->Ranges.GetFreeSize();
+        }
+        if (freeElsewhere < usedBytes(order[source])) { return; }
+
+        for (auto it = srcBlock.Movable.begin(); it != srcBlock.Movable.end();) {
+            if (moves.size() >= limits.MaxMoves || bytes >= limits.MaxBytes) { return; }
+
+            // Fullest destination first, it is the least likely to be drained itself later
+            const Relocation relocation = it->second;
+            RHIMemoryMove move{relocation.pOwner, {poolIndex, order[source], it->first, relocation.Size}, {}};
+            for (size_t i = order.size() - 1; i > source && !move.Dst.IsValid(); --i) {
+                Block& dstBlock = *pool.Blocks[order[i]];
+                const uint32 offset = dstBlock.Ranges.Allocate(relocation.Size, relocation.Alignment);
+                if (offset == RHIRangeAllocator::InvalidOffset) { continue; }
+
+                dstBlock.Movable[offset] = relocation;
+                move.Dst = {poolIndex, order[i], offset, relocation.Size};
+            }
+            if (!move.Dst.IsValid()) { return; }
+
+            it = srcBlock.Movable.erase(it);
+            bytes += relocation.Size;
+            moves.push_back(move);
+        }
+        return;
+    }
+}
+
+void RHIMemoryAllocator::ReleaseBlocks() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (Pool& pool: m_Pools) {
+        for (auto& block: pool.Blocks) {
+            if (!block) { continue; }
+
+            if (block->Ranges.GetAllocationCount() > 0) {
+                Internal::LogError("RHIMemoryAllocator: Releasing a block with {0} live allocations",
+                                   block->Ranges.GetAllocationCount());
+            }
+            DestroyBlock(block->Handle);
+        }
+        pool.Blocks.clear();
+    }
+}
+
+uint32 RHIMemoryAllocator::CreatePoolBlock(Pool& pool, uint64 size) {
+    void* handle = CreateBlock(pool.Usage, pool.Kind, size);
+    if (!handle) {
+        Internal::LogError("RHIMemoryAllocator: Failed to create a {0} byte memory block", size);
+        return RHIMemoryAllocation::InvalidBlock;
+    }
+
+    auto block = CreateScope<Block>();
+    block->Handle = handle;
+    block->Ranges.Reset(static_cast<uint32>(size));
+
+    // Reuse the slot of a destroyed block first
+    for (uint32 i = 0; i < pool.Blocks.size(); ++i) {
+        if (!pool.Blocks[i]) {
+            pool.Blocks[i] = std::move(block);
+            return i;
+        }
+    }
+    pool.Blocks.push_back(std::move(block));
+    return static_cast<uint32>(pool.Blocks.size() - 1);
+}
+
+bool RHIMemoryAllocator::HasOtherEmptyBlock(const Pool& pool, uint32 blockIndex) const {
+    for (uint32 i = 0; i < pool.Blocks.size(); ++i) {
+        if (i != blockIndex && pool.Blocks[i] && pool.Blocks[i]->Ranges.GetAllocationCount() == 0) { return true; }
+    }
+    return false;
+}
+
+} // namespace iGe
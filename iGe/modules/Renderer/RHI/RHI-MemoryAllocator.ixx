@@ -0,0 +1,182 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.RHI:RHIMemoryAllocator;
+import :RHIResource;
+import :RHIRangeAllocator;
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Memory Allocator Types
+// =================================================================================================
+
+// Resource classes that may not share a heap on every device (D3D12 resource heap tier 1)
+export enum class RHIMemoryResourceKind : uint32 {
+    Buffer = 0,
+    Texture,
+    Count
+};
+
+export struct RHIMemoryRequest {
+    uint64 Size = 0;
+    uint64 Alignment = 1; // Power of two
+    RHIMemoryUsage Usage = RHIMemoryUsage::GpuOnly;
+    RHIMemoryResourceKind Kind = RHIMemoryResourceKind::Buffer;
+    bool Dedicated = false; // Skip the pools, e.g. render targets that benefit from their own allocation
+    void* pRelocationOwner = nullptr; // Non-null marks a pooled allocation movable by PlanDefragmentation
+};
+
+// Range of a pooled block, or the bookkeeping of a dedicated allocation the backend creates on its own
+export struct RHIMemoryAllocation {
+    static constexpr uint32 InvalidBlock = std::numeric_limits<uint32>::max();
+    static constexpr uint32 DedicatedBlock = InvalidBlock - 1;
+
+    uint32 PoolIndex = 0;
+    uint32 BlockIndex = InvalidBlock;
+    uint64 Offset = 0;
+    uint64 Size = 0;
+
+    bool IsValid() const { return BlockIndex != InvalidBlock; }
+    bool IsDedicated() const { return BlockIndex == DedicatedBlock; }
+};
+
+export struct RHIMemoryPoolStats {
+    uint32 BlockCount = 0;
+    uint32 AllocationCount = 0;
+    uint64 BlockBytes = 0;     // Reserved from the device for pooled blocks
+    uint64 AllocatedBytes = 0; // Handed out of those blocks
+    uint64 LargestFreeRange = 0;
+
+    // 0 when all free space is one range, towards 1 the more it is split into small holes
+    float32 GetFragmentation() const {
+        const uint64 freeBytes = BlockBytes - AllocatedBytes;
+        return freeBytes > 0 ? 1.0f - static_cast<float32>(LargestFreeRange) / static_cast<float32>(freeBytes) : 0.0f;
+    }
+};
+
+export struct RHIMemoryStats {
+    static constexpr uint32 UsageCount = static_cast<uint32>(RHIMemoryUsage::GpuLazilyAllocated) + 1;
+
+    RHIMemoryPoolStats Pooled;                        // All pools together
+    std::array<RHIMemoryPoolStats, UsageCount> Usages; // Indexed by RHIMemoryUsage
+
+    uint32 DedicatedCount = 0;
+    uint64 DedicatedBytes = 0;
+
+    // What the OS grants the process and what it currently uses, zero if the backend cannot tell
+    uint64 BudgetBytes = 0;
+    uint64 UsageBytes = 0;
+};
+
+// Bounds of one incremental defragmentation pass, keep them small enough to spread the copies over frames
+export struct RHIDefragmentationLimits {
+    uint32 MaxMoves = 64;
+    uint64 MaxBytes = 16ull << 20;
+};
+
+export struct RHIDefragmentationResult {
+    uint32 MoveCount = 0;
+    uint64 BytesMoved = 0;
+    // Views and vertex/index bindings are repointed by the backend. Persistent descriptors written from these
+    // resources still name the old copy: write fresh ones, older frames may still read the stale ones
+    std::vector<const RHIResource*> RelocatedResources;
+};
+
+// A planned move. Dst is already reserved and owns the relocation record, Src stays allocated until freed
+export struct RHIMemoryMove {
+    void* pOwner = nullptr;
+    RHIMemoryAllocation Src;
+    RHIMemoryAllocation Dst;
+};
+
+export struct RHIMemoryAllocatorCreateInfo {
+    uint64 BlockSize = 64ull << 20;
+    // Requests above this go to a dedicated allocation instead of a pooled block
+    uint64 DedicatedThreshold = 32ull << 20;
+};
+
+// =================================================================================================
+// Memory Allocator
+// =================================================================================================
+
+// Places resources into large device memory blocks instead of giving every resource its own allocation. There
+// is one pool per (RHIMemoryUsage, RHIMemoryResourceKind), each a list of blocks suballocated with the TLSF
+// RHIRangeAllocator. Large and explicitly dedicated requests bypass the pools and are only tracked for the
+// statistics. Backends create and destroy the blocks, the suballocation logic itself is API agnostic.
+//
+// Thread-safe. One empty block per pool is kept around so that create/destroy churn does not hit the device.
+export class IGE_API RHIMemoryAllocator {
+public:
+    explicit RHIMemoryAllocator(const RHIMemoryAllocatorCreateInfo& info = {});
+    virtual ~RHIMemoryAllocator() = default;
+
+    RHIMemoryAllocator(const RHIMemoryAllocator&) = delete;
+    RHIMemoryAllocator& operator=(const RHIMemoryAllocator&) = delete;
+
+    // Returns an invalid allocation when the backend failed to create a block, the error has been logged
+    RHIMemoryAllocation Allocate(const RHIMemoryRequest& request);
+    void Free(const RHIMemoryAllocation& allocation);
+
+    // Backend handle of the block an allocation lives in, nullptr for dedicated allocations
+    void* GetBlockHandle(const RHIMemoryAllocation& allocation) const;
+
+    RHIMemoryStats GetStats() const;
+
+    // Plans moves that drain the least occupied blocks of each pool into free ranges of fuller ones, so whole
+    // blocks empty out and are released once the moved-from ranges are freed. Only blocks whose allocations
+    // are all movable are drained. The caller copies each move, frees Src once the GPU is done with it, or
+    // hands a move it could not perform back through CancelMove.
+    std::vector<RHIMemoryMove> PlanDefragmentation(const RHIDefragmentationLimits& limits);
+    void CancelMove(const RHIMemoryMove& move);
+
+    uint64 GetBlockSize() const { return m_BlockSize; }
+
+protected:
+    // Backend hooks, called with the allocator lock held
+    virtual void* CreateBlock(RHIMemoryUsage usage, RHIMemoryResourceKind kind, uint64 size) = 0;
+    virtual void DestroyBlock(void* handle) = 0;
+    virtual void QueryBudget(uint64& budgetBytes, uint64& usageBytes) const {}
+
+    // Backends must call this from their destructor, blocks cannot be destroyed from the base destructor
+    void ReleaseBlocks();
+
+private:
+    static constexpr uint32 KindCount = static_cast<uint32>(RHIMemoryResourceKind::Count);
+    static constexpr uint32 PoolCount = RHIMemoryStats::UsageCount * KindCount;
+
+    struct Relocation {
+        void* pOwner = nullptr;
+        uint32 Size = 0;
+        uint32 Alignment = 1;
+    };
+
+    struct Block {
+        void* Handle = nullptr;
+        RHIRangeAllocator Ranges;
+        std::map<uint32, Relocation> Movable; // Offset -> owner of every movable allocation in the block
+    };
+
+    struct Pool {
+        RHIMemoryUsage Usage = RHIMemoryUsage::Unknown;
+        RHIMemoryResourceKind Kind = RHIMemoryResourceKind::Buffer;
+        std::vector<Scope<Block>> Blocks; // Destroyed blocks leave a null slot so live BlockIndex values stay put
+    };
+
+    uint32 CreatePoolBlock(Pool& pool, uint64 size);
+    bool HasOtherEmptyBlock(const Pool& pool, uint32 blockIndex) const;
+    void PlanPoolDefragmentation(uint32 poolIndex, const RHIDefragmentationLimits& limits, uint64& bytes,
+                                 std::vector<RHIMemoryMove>& moves);
+
+    uint64 m_BlockSize = 0;
+    uint64 m_DedicatedThreshold = 0;
+
+    mutable std::mutex m_Mutex;
+    std::array<Pool, PoolCount> m_Pools;
+    uint32 m_DedicatedCount = 0;
+    uint64 m_DedicatedBytes = 0;
+};
+
+} // namespace iGe
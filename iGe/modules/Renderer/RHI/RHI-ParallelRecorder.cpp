@@ -0,0 +1,155 @@
+module iGe.RHI;
+import :RHIParallelRecorder;
+import :RHIQueue;
+
+namespace iGe
+{
+
+RHIParallelRecorder::RHIParallelRecorder(RHICommandListManager* pManager, uint32 workerCount) : m_pManager(pManager) {
+    m_Workers.reserve(workerCount);
+    for (uint32 i = 0; i < workerCount; ++i) {
+        m_Workers.emplace_back([this](std::stop_token stopToken) { WorkerLoop(stopToken); });
+    }
+}
+
+RHIParallelRecorder::~RHIParallelRecorder() {
+    // Requests stop and joins, waiting workers are woken through their stop token
+    m_Workers.clear();
+}
+
+void RHIParallelRecorder::BeginRenderPass(const RHIRenderPassBeginInfo& info) {
+    if (m_OpenPass != InvalidPass) {
+        Internal::LogError("RHIParallelRecorder: BeginRenderPass while another pass is open");
+        EndRenderPass();
+    }
+
+    Pass& pass = m_Passes.emplace_back();
+    pass.Info = info;
+    pass.ColorAttachments.assign(info.ColorAttachments.begin(), info.ColorAttachments.end());
+    if (info.pDepthStencilAttachment) {
+        pass.DepthStencilAttachment = *info.pDepthStencilAttachment;
+        pass.HasDepthStencil = true;
+    }
+    pass.FirstSlice = static_cast<uint32>(m_Slices.size());
+    m_OpenPass = static_cast<uint32>(m_Passes.size() - 1);
+}
+
+void RHIParallelRecorder::EndRenderPass() {
+    if (m_OpenPass == InvalidPass) { return; }
+
+    // A pass without slices still has to run its load ops
+    const uint32 firstSlice = m_Passes[m_OpenPass].FirstSlice;
+    if (firstSlice == m_Slices.size()) { Record({}); }
+
+    // Every list but the first resumes the pass, every list but the last suspends it
+    const uint32 lastSlice = static_cast<uint32>(m_Slices.size() - 1);
+    for (uint32 i = firstSlice; i <= lastSlice; ++i) {
+        if (i != firstSlice) { m_Slices[i].PassFlags |= RHIRenderPassFlag::Resuming; }
+        if (i != lastSlice) { m_Slices[i].PassFlags |= RHIRenderPassFlag::Suspending; }
+    }
+    m_OpenPass = InvalidPass;
+}
+
+void RHIParallelRecorder::Record(RecordFunction record) {
+    Slice& slice = m_Slices.emplace_back();
+    slice.Record = std::move(record);
+    slice.PassIndex = m_OpenPass;
+}
+
+void RHIParallelRecorder::Submit(RHIFence* signalFence) {
+    if (m_OpenPass != InvalidPass) {
+        Internal::LogError("RHIParallelRecorder: Submit with an open render pass");
+        EndRenderPass();
+    }
+
+    if (!m_Slices.empty()) {
+        m_NextSlice.store(0, std::memory_order_relaxed);
+        m_RemainingSlices.store(static_cast<uint32>(m_Slices.size()), std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            ++m_Dispatch;
+            m_Dispatching = true;
+        }
+        m_WorkCondition.notify_all();
+
+        // The submitting thread records alongside the workers
+        RecordSlices();
+
+        // Late workers may still be looking at the slice list, it is only cleared once all of them left
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_DoneCondition.wait(lock, [this] {
+            return m_ActiveWorkers == 0 && m_RemainingSlices.load(std::memory_order_acquire) == 0;
+        });
+        m_Dispatching = false;
+    }
+
+    std::vector<const RHICommandList*> lists;
+    lists.reserve(m_Slices.size());
+    for (const Slice& slice: m_Slices) {
+        if (slice.pList) { lists.push_back(slice.pList); }
+    }
+    if (!lists.empty() || signalFence) { m_pManager->GetQueue()->SubmitCommandLists(lists, signalFence); }
+
+    m_Slices.clear();
+    m_Passes.clear();
+}
+
+void RHIParallelRecorder::WorkerLoop(std::stop_token stopToken) {
+    uint64 seenDispatch = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            if (!m_WorkCondition.wait(lock, stopToken, [&] { return m_Dispatching && m_Dispatch != seenDispatch; })) {
+                return;
+            }
+            seenDispatch = m_Dispatch;
+            ++m_ActiveWorkers;
+        }
+
+        RecordSlices();
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            --m_ActiveWorkers;
+        }
+        m_DoneCondition.notify_all();
+    }
+}
+
+void RHIParallelRecorder::RecordSlices() {
+    const uint32 sliceCount = static_cast<uint32>(m_Slices.size());
+    for (uint32 i = m_NextSlice.fetch_add(1, std::memory_order_relaxed); i < sliceCount;
+         i = m_NextSlice.fetch_add(1, std::memory_order_relaxed)) {
+        RecordSlice(m_Slices[i]);
+
+        if (m_RemainingSlices.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            // Taking the lock orders the notification after the submitting thread started waiting
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_DoneCondition.notify_all();
+        }
+    }
+}
+
+void RHIParallelRecorder::RecordSlice(Slice& slice) {
+    // Acquired on this thread, the list comes from this thread's pools
+    RHICommandList* list = m_pManager->Acquire();
+    if (!list) { return; }
+
+    list->Begin();
+    if (slice.PassIndex != InvalidPass) {
+        const Pass& pass = m_Passes[slice.PassIndex];
+        RHIRenderPassBeginInfo info = pass.Info;
+        info.ColorAttachments = pass.ColorAttachments;
+        info.pDepthStencilAttachment = pass.HasDepthStencil ? &pass.DepthStencilAttachment : nullptr;
+        info.PassFlags = slice.PassFlags;
+        list->BeginRenderPass(info);
+    }
+
+    if (slice.Record) { slice.Record(AsBackend(*list)); }
+
+    if (slice.PassIndex != InvalidPass) { list->EndRenderPass(); }
+    list->End();
+    slice.pList = list;
+}
+
+} // namespace iGe
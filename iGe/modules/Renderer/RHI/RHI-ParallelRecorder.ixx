@@ -0,0 +1,91 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.RHI:RHIParallelRecorder;
+import :RHIFence;
+import :RHICommandList;
+import :RHIBackend;
+import :RHICommandListManager;
+import :RHIRenderPass;
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Parallel Recorder
+// =================================================================================================
+
+// Records one frame's commands for a queue on several threads. The frame is described on the calling thread as
+// an ordered list of slices, Submit records every slice into its own list on a pool of worker threads and
+// submits the lists in slice order with a single RHIQueue::SubmitCommandLists.
+//
+// A slice only ever sees its list inside the record function, on the thread that acquired it, so no list can be
+// recorded by a thread that does not own its pool. Lists start without any bound state, each slice binds its
+// pipeline and descriptors itself and must not call Begin, End or the render pass commands.
+export class IGE_API RHIParallelRecorder {
+public:
+    using RecordFunction = std::move_only_function<void(RHIBackendCommandList&)>;
+
+    // Zero workers records every slice on the thread calling Submit
+    RHIParallelRecorder(RHICommandListManager* pManager, uint32 workerCount);
+    ~RHIParallelRecorder();
+
+    RHIParallelRecorder(const RHIParallelRecorder&) = delete;
+    RHIParallelRecorder& operator=(const RHIParallelRecorder&) = delete;
+
+    // Slices added until EndRenderPass run inside the pass, it is suspended and resumed between their lists.
+    // Attachment bindings are copied, the views must stay alive until the frame has completed
+    void BeginRenderPass(const RHIRenderPassBeginInfo& info);
+    void EndRenderPass();
+
+    void Record(RecordFunction record);
+
+    // Blocks until every slice is recorded, the recorder is empty again afterwards
+    void Submit(RHIFence* signalFence = nullptr);
+
+    uint32 GetWorkerCount() const { return static_cast<uint32>(m_Workers.size()); }
+
+private:
+    struct Pass {
+        RHIRenderPassBeginInfo Info;
+        std::vector<RHIAttachmentBinding> ColorAttachments;
+        RHIAttachmentBinding DepthStencilAttachment{};
+        bool HasDepthStencil = false;
+        uint32 FirstSlice = 0;
+    };
+
+    struct Slice {
+        RecordFunction Record;
+        uint32 PassIndex = InvalidPass;
+        Flags<RHIRenderPassFlag> PassFlags = RHIRenderPassFlag::None;
+        RHICommandList* pList = nullptr;
+    };
+
+    static constexpr uint32 InvalidPass = ~0u;
+
+    void WorkerLoop(std::stop_token stopToken);
+    void RecordSlices();
+    void RecordSlice(Slice& slice);
+
+    RHICommandListManager* m_pManager = nullptr;
+
+    // Only touched by the thread describing the frame, read only while Submit dispatches
+    std::vector<Pass> m_Passes;
+    std::vector<Slice> m_Slices;
+    uint32 m_OpenPass = InvalidPass;
+
+    std::atomic<uint32> m_NextSlice = 0;
+    std::atomic<uint32> m_RemainingSlices = 0;
+
+    std::mutex m_Mutex;
+    std::condition_variable_any m_WorkCondition;
+    std::condition_variable m_DoneCondition;
+    uint64 m_Dispatch = 0; // Bumped by every Submit
+    bool m_Dispatching = false;
+    uint32 m_ActiveWorkers = 0;
+
+    std::vector<std::jthread> m_Workers; // Last, joined before the state above is destroyed
+};
+
+} // namespace iGe
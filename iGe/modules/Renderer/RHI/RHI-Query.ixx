@@ -0,0 +1,89 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.RHI:RHIQuery;
+import :RHIResource;
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Query Pool
+// =================================================================================================
+
+export enum class RHIQueryType : uint32 {
+    Timestamp = 0,      // GPU clock ticks, see RHIQueue::CalibrateTimestamps
+    Occlusion,          // Samples that passed the depth and stencil tests
+    PipelineStatistics, // RHIPipelineStatistics
+
+    Count
+};
+
+// Field order matches D3D12_QUERY_DATA_PIPELINE_STATISTICS, resolves copy it as it is
+export struct RHIPipelineStatistics {
+    uint64 InputAssemblyVertices = 0;
+    uint64 InputAssemblyPrimitives = 0;
+    uint64 VertexShaderInvocations = 0;
+    uint64 GeometryShaderInvocations = 0;
+    uint64 GeometryShaderPrimitives = 0;
+    uint64 ClippingInvocations = 0;
+    uint64 ClippingPrimitives = 0;
+    uint64 FragmentShaderInvocations = 0;
+    uint64 HullShaderInvocations = 0;
+    uint64 DomainShaderInvocations = 0;
+    uint64 ComputeShaderInvocations = 0;
+};
+
+// Bytes RHICommandList::ResolveQueries writes per query
+export constexpr uint32 GetRHIQueryResultSize(RHIQueryType type) {
+    return type == RHIQueryType::PipelineStatistics ? sizeof(RHIPipelineStatistics) : sizeof(uint64);
+}
+
+export struct RHIQueryPoolCreateInfo {
+    RHIQueryType Type = RHIQueryType::Timestamp;
+    uint32 Count = 0;
+};
+
+export class IGE_API RHIQueryPool : public RHIResource {
+public:
+    ~RHIQueryPool() override = default;
+
+    RHIQueryType GetQueryType() const { return m_QueryType; }
+    uint32 GetQueryCount() const { return m_QueryCount; }
+
+protected:
+    RHIQueryPool(const RHIQueryPoolCreateInfo& info)
+        : RHIResource(RHIResourceType::QueryPool), m_QueryType(info.Type), m_QueryCount(info.Count) {}
+
+    RHIQueryType m_QueryType;
+    uint32 m_QueryCount;
+};
+
+// =================================================================================================
+// Timestamp Calibration
+// =================================================================================================
+
+// A queue's GPU clock and the CPU clock sampled at the same moment. Maps timestamps onto the steady clock
+// nanoseconds the profiler timeline uses.
+export struct RHITimestampCalibration {
+    uint64 Frequency = 0; // GPU ticks per second, zero if the queue cannot write timestamps
+    uint64 GpuTimestamp = 0;
+    uint64 CpuTimeNs = 0;
+
+    uint64 ToCpuTimeNs(uint64 timestamp) const {
+        if (Frequency == 0) { return CpuTimeNs; }
+
+        // Seconds and remainder apart, ticks times 1e9 overflows after a few hours of uptime
+        constexpr uint64 NsPerSecond = 1'000'000'000;
+        if (timestamp >= GpuTimestamp) {
+            const uint64 ticks = timestamp - GpuTimestamp;
+            return CpuTimeNs + ticks / Frequency * NsPerSecond + ticks % Frequency * NsPerSecond / Frequency;
+        }
+        const uint64 ticks = GpuTimestamp - timestamp;
+        const uint64 ns = ticks / Frequency * NsPerSecond + ticks % Frequency * NsPerSecond / Frequency;
+        return ns < CpuTimeNs ? CpuTimeNs - ns : 0;
+    }
+};
+
+} // namespace iGe
@@ -5,6 +5,8 @@ export module iGe.RHI:RHIQueue;
 import :RHIResource;
 import :RHISemaphore;
 import :RHIFence;
+import :RHIQuery;
+import :RHIStatistics;
 import iGe.Common;
 
 namespace iGe
@@ -33,9 +35,25 @@ public:
 
     virtual void WaitIdle() = 0;
 
+    // Both submits count the lists in their base body, backends call it first, decorators forward instead
     virtual void Submit(const RHICommandList* commandList, RHIFence* fence = nullptr,
-                        std::span<RHISemaphore*> waitSemaphores = {},
-                        std::span<RHISemaphore*> signalSemaphores = {}) = 0;
+                        std::span<RHISemaphore*> waitSemaphores = {}, std::span<RHISemaphore*> signalSemaphores = {}) {
+        if (commandList) { RHIStatistics::Add(RHIStatistic::CommandListsSubmitted); }
+    }
+    // One submission, the lists execute in span order. A render pass may be suspended in one list and resumed in
+    // the next, see RHIRenderPassFlag
+    virtual void SubmitCommandLists(std::span<const RHICommandList*> commandLists, RHIFence* signalFence = nullptr) {
+        RHIStatistics::Add(RHIStatistic::CommandListsSubmitted,
+                           std::ranges::count_if(commandLists, [](const RHICommandList* list) { return list; }));
+    }
+
+    // Queue-side timeline operations, neither blocks the CPU. Wait stalls the queue until the fence reaches value
+    virtual void Signal(RHIFence* fence, uint64 value) = 0;
+    virtual void Wait(RHIFence* fence, uint64 value) = 0;
+
+    // Samples the queue's timestamp clock together with the CPU clock. Clocks drift apart, calibrate again for
+    // every batch of timestamps read back.
+    virtual RHITimestampCalibration CalibrateTimestamps() const = 0;
 
 protected:
     RHIQueue(const RHIQueueCreateInfo& info) : RHIResource(RHIResourceType::Queue), m_QueueType(info.Type) {}
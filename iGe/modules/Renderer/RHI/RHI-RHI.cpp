@@ -1,5 +1,9 @@
 module iGe.RHI;
 import :RHI;
+import :NullRHI;
+import :RHICapture;
+import :RHILint;
+import :RHIStatistics;
 
 #if defined(IGE_PLATFORM_WINDOWS)
 import :DirectX12RHI;
@@ -13,6 +17,13 @@ namespace iGe
 // =================================================================================================
 
 RHI* RHI::Init(const Config& config) {
+#if defined(IGE_RHI_STATIC_BACKEND)
+    // Recording code was compiled against the DirectX12 command list, no other backend can run
+    if (config.GraphicsAPI != GraphicsAPI::DirectX12) {
+        Internal::LogError("RHI: This build only contains the DirectX12 backend");
+        return nullptr;
+    }
+#endif
     s_Config = config;
 
     switch (s_Config.GraphicsAPI) {
@@ -29,12 +40,51 @@ RHI* RHI::Init(const Config& config) {
         case GraphicsAPI::Metal:
             // TODO: Implement MetalRHI
             break;
+
+        case GraphicsAPI::Null:
+            s_RHI = CreateScope<NullRHI>();
+            break;
+
         default:
             Internal::LogError("Unknown GraphicsAPI");
             break;
     }
 
+    if (s_RHI && s_Config.CaptureFrameCount > 0) {
+#if defined(IGE_RHI_STATIC_BACKEND)
+        // The capture decorator's command lists are not the backend's, which static recording casts to
+        Internal::LogError("RHI: Capture is not available when the backend is compiled in statically");
+#else
+        s_RHI = CreateScope<RHICaptureRHI>(std::move(s_RHI), s_Config);
+#endif
+    }
+
+#if defined(IGE_RHI_LINT)
+    // Outermost, so the call stacks of warnings start in the calling code
+    if (s_RHI && s_Config.EnableLint) {
+#if defined(IGE_RHI_STATIC_BACKEND)
+        Internal::LogError("RHI: Lint is not available when the backend is compiled in statically");
+#else
+        s_RHI = CreateScope<RHILintRHI>(std::move(s_RHI));
+#endif
+    }
+#endif
+
     return s_RHI.get();
 }
 
+void RHI::UpdateDescriptorSets(std::span<const RHIWriteDescriptorSet> writes) {
+    uint64 descriptorCount = 0;
+    for (const auto& write: writes) {
+        if (write.pDstSet) { descriptorCount += write.DescriptorCount; }
+    }
+    RHIStatistics::Add(RHIStatistic::DescriptorWrites, descriptorCount);
+}
+
+void RHI::UpdateDescriptorSetWithTemplate(RHIDescriptorSet* pSet, const RHIDescriptorUpdateTemplate* pTemplate,
+                                          const void* pData) {
+    if (!pSet || !pTemplate || !pData) { return; }
+    RHIStatistics::Add(RHIStatistic::DescriptorWrites, pTemplate->GetDescriptorCount());
+}
+
 } // namespace iGe
@@ -6,6 +6,7 @@ import :RHIQueue;
 import :RHISurface;
 import :RHISwapChain;
 import :RHICommandPool;
+import :RHICommandListManager;
 import :RHIDescriptor;
 import :RHITextureView;
 import :RHIFence;
@@ -13,13 +14,17 @@ import :RHISemaphore;
 import :RHIFramebuffer;
 import :RHIGraphicsPipeline;
 import :RHIComputePipeline;
+import :RHIQuery;
 import :RHIDeviceCapabilities;
+import :RHIConstantAllocator;
+import :RHIMemoryAllocator;
 import iGe.Common;
 
 namespace iGe
 {
 
-export enum class GraphicsAPI : uint32 { Vulkan = 0, DirectX12, Metal, Count };
+// Null executes nothing, for replaying and measuring the CPU side of the RHI (see RHICaptureReplayer)
+export enum class GraphicsAPI : uint32 { Vulkan = 0, DirectX12, Metal, Null, Count };
 
 export class IGE_API RHI {
 public:
@@ -27,6 +32,15 @@ public:
         GraphicsAPI GraphicsAPI = GraphicsAPI::Vulkan;
         bool EnableValidation = true;
         bool EnableDebugMarkers = true;
+
+        // Records CaptureFrameCount frames starting at frame serial CaptureFirstFrame into CapturePath, for
+        // RHICaptureReplayer. Zero disables capture.
+        uint32 CaptureFrameCount = 0;
+        uint64 CaptureFirstFrame = 1;
+        std::string CapturePath = "RHICapture.igecap";
+
+        // Wraps the device in RHILintRHI, only in builds with IGE_RHI_LINT
+        bool EnableLint = true;
     };
 
     static RHI* Init(const Config& config);
@@ -54,6 +68,34 @@ public:
     virtual RHIQueue* GetQueue(RHIQueueType type, uint32 index = 0) = 0;
     virtual uint32 GetQueueCount(RHIQueueType type) const = 0;
 
+    // =============================================================================
+    // Frame Boundaries
+    // =============================================================================
+
+    // Transient per-frame resources, such as the descriptor tables of BindTransientDescriptors, are tagged by
+    // EndFrame once the frame's last submission is on pQueue and recycled by a later BeginFrame when the GPU has
+    // passed them. No command list may be recording transient descriptors during EndFrame.
+    virtual void BeginFrame() = 0;
+    virtual void EndFrame(RHIQueue* pQueue) = 0;
+
+    // Frame serials start at one and grow by one per EndFrame. Every frame up to the completed serial has finished
+    // on the GPU, so anything released while recording frame N can be reused once N completes.
+    virtual uint64 GetFrameSerial() const = 0;
+    virtual uint64 GetCompletedFrameSerial() const = 0;
+
+    // Frame-lifetime shader constants, retired together with the transient descriptors
+    virtual RHIConstantAllocator* GetConstantAllocator() = 0;
+
+    // Pooled and dedicated resource memory, fragmentation and the OS budget
+    virtual RHIMemoryStats GetMemoryStats() const = 0;
+
+    // Records copies moving a bounded number of relocatable resources out of sparsely used heap blocks into
+    // pCommandList, the emptied blocks are released once the current frame completes. Call once per frame on the
+    // frame's graphics command list before anything else uses the resources, and only after uploads into them
+    // have been waited on.
+    virtual RHIDefragmentationResult DefragmentMemory(RHICommandList* pCommandList,
+                                                      const RHIDefragmentationLimits& limits = {}) = 0;
+
     // =============================================================================
     // Surface and SwapChain
     // =============================================================================
@@ -67,6 +109,9 @@ public:
 
     virtual Scope<RHICommandPool> CreateCommandPool(const RHICommandPoolCreateInfo& info) = 0;
 
+    // Recycled per-frame command lists of a queue, prefer these over allocating lists every frame
+    virtual RHICommandListManager* GetCommandListManager(RHIQueueType type) = 0;
+
     // Allocate command list from a pool (convenience wrapper)
     virtual Scope<RHICommandList> AllocateCommandList(RHICommandPool* pPool) = 0;
     virtual std::vector<Scope<RHICommandList>> AllocateCommandLists(RHICommandPool* pPool, uint32 count) = 0;
@@ -107,12 +152,19 @@ public:
     virtual Scope<RHIDescriptorSetLayout> CreateDescriptorSetLayout(const RHIDescriptorSetLayoutCreateInfo& info) = 0;
     virtual Scope<RHIDescriptorPool> CreateDescriptorPool(const RHIDescriptorPoolCreateInfo& info) = 0;
 
-    // Update descriptor sets with writes
-    virtual void UpdateDescriptorSets(std::span<const RHIWriteDescriptorSet> writes) = 0;
+    // Update descriptor sets with writes. Both updates count the descriptors written in their base body, backends
+    // call it first, decorators forward to the RHI they wrap instead
+    virtual void UpdateDescriptorSets(std::span<const RHIWriteDescriptorSet> writes);
 
     // Copy descriptors between sets
     virtual void CopyDescriptorSets(std::span<const RHICopyDescriptorSet> copies) = 0;
 
+    // Precompile the writes of a set layout once, then update sets from a packed struct in a single call
+    virtual Scope<RHIDescriptorUpdateTemplate>
+    CreateDescriptorUpdateTemplate(const RHIDescriptorUpdateTemplateCreateInfo& info) = 0;
+    virtual void UpdateDescriptorSetWithTemplate(RHIDescriptorSet* pSet, const RHIDescriptorUpdateTemplate* pTemplate,
+                                                 const void* pData);
+
     // =============================================================================
     // Pipeline Layout
     // =============================================================================
@@ -139,6 +191,12 @@ public:
     virtual Scope<RHIGraphicsPipeline> CreateGraphicsPipeline(const RHIGraphicsPipelineCreateInfo& info) = 0;
     virtual Scope<RHIComputePipeline> CreateComputePipeline(const RHIComputePipelineCreateInfo& info) = 0;
 
+    // =============================================================================
+    // Query Operations
+    // =============================================================================
+
+    virtual Scope<RHIQueryPool> CreateQueryPool(const RHIQueryPoolCreateInfo& info) = 0;
+
     // =============================================================================
     // Synchronization Primitives
     // =============================================================================
@@ -155,9 +213,16 @@ public:
     // Resource Destruction
     // =============================================================================
 
-    // Generic destroy function - will determine type at runtime
+    // Takes ownership of the resource and destroys it once the GPU has finished the frame being recorded, so a
+    // resource still referenced by in-flight command lists can be released without waiting for the device
     virtual void DestroyResource(RHIResource* pResource) = 0;
 
+    // Same for an owned resource, the scope is left empty
+    template<typename T>
+    void DeferDestroy(Scope<T>& resource) {
+        DestroyResource(resource.release());
+    }
+
     // Type-safe destroy functions (optional, can just use DestroyResource)
     virtual void DestroySurface(RHISurface* pSurface) { DestroyResource(pSurface); }
     virtual void DestroySwapChain(RHISwapChain* pSwapChain) { DestroyResource(pSwapChain); }
@@ -168,12 +233,14 @@ public:
     virtual void DestroySampler(RHISampler* pSampler) { DestroyResource(pSampler); }
     virtual void DestroyDescriptorSetLayout(RHIDescriptorSetLayout* pLayout) { DestroyResource(pLayout); }
     virtual void DestroyDescriptorPool(RHIDescriptorPool* pPool) { DestroyResource(pPool); }
+    virtual void DestroyDescriptorUpdateTemplate(RHIDescriptorUpdateTemplate* pTemplate) { DestroyResource(pTemplate); }
     virtual void DestroyPipelineLayout(RHIPipelineLayout* pLayout) { DestroyResource(pLayout); }
     virtual void DestroyRenderPass(RHIRenderPass* pRenderPass) { DestroyResource(pRenderPass); }
     virtual void DestroyFramebuffer(RHIFramebuffer* pFramebuffer) { DestroyResource(pFramebuffer); }
     virtual void DestroyShader(RHIShader* pShader) { DestroyResource(pShader); }
     virtual void DestroyGraphicsPipeline(RHIGraphicsPipeline* pPipeline) { DestroyResource(pPipeline); }
     virtual void DestroyComputePipeline(RHIComputePipeline* pPipeline) { DestroyResource(pPipeline); }
+    virtual void DestroyQueryPool(RHIQueryPool* pPool) { DestroyResource(pPool); }
     virtual void DestroyFence(RHIFence* pFence) { DestroyResource(pFence); }
     virtual void DestroySemaphore(RHISemaphore* pSemaphore) { DestroyResource(pSemaphore); }
 
@@ -0,0 +1,374 @@
+module iGe.RHI;
+import :RHIRangeAllocator;
+
+namespace iGe
+{
+
+namespace
+{
+
+// Bins are tiny floats: sizes below 8 map to themselves, larger sizes keep the top three bits below the leading
+// one as mantissa. Rounding down files a free range, rounding up finds a bin whose every range fits the request.
+constexpr uint32 MantissaBits = 3;
+constexpr uint32 MantissaMask = (1u << MantissaBits) - 1;
+
+uint32 SizeToBinRoundDown(uint32 size) {
+    if (size <= MantissaMask) { return size; }
+    const uint32 highestBit = static_cast<uint32>(std::bit_width(size)) - 1;
+    const uint32 shift = highestBit - MantissaBits;
+    return ((shift + 1) << MantissaBits) | ((size >> shift) & MantissaMask);
+}
+
+uint32 SizeToBinRoundUp(uint32 size) {
+    if (size <= MantissaMask) { return size; }
+    const uint32 highestBit = static_cast<uint32>(std::bit_width(size)) - 1;
+    const uint32 shift = highestBit - MantissaBits;
+    const uint32 bin = ((shift + 1) << MantissaBits) | ((size >> shift) & MantissaMask);
+
+    // A carry out of the mantissa moves to the next exponent, which is the next bin as well
+    return (size & ((1u << shift) - 1)) ? bin + 1 : bin;
+}
+
+} // namespace
+
+// =================================================================================================
+// RHIRangeAllocator
+// =================================================================================================
+
+RHIRangeAllocator::RHIRangeAllocator(uint32 capacity) { Reset(capacity); }
+
+void RHIRangeAllocator::Reset(uint32 capacity) {
+    m_Capacity = capacity;
+    m_FreeSize = 0;
+    m_TopMask = 0;
+    m_LeafMasks.fill(0);
+    m_BinHeads.fill(InvalidNode);
+    m_Nodes.clear();
+    m_SpareNodes.clear();
+    m_UsedNodes.clear();
+
+    if (capacity > 0) {
+        InsertFreeNode(CreateNode(0, capacity));
+        m_FreeSize = capacity;
+    }
+}
+
+uint32 RHIRangeAllocator::Allocate(uint32 size, uint32 alignment) {
+    if (size == 0 || size > m_FreeSize || alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        return InvalidOffset;
+    }
+
+    // Reserve room for the worst-case padding so any range in the found bin fits after alignment
+    const uint64 request = static_cast<uint64>(size) + alignment - 1;
+    if (request > m_Capacity) { return InvalidOffset; }
+
+    uint32 nodeIndex = InvalidNode;
+    const uint32 bin = FindFreeBin(SizeToBinRoundUp(static_cast<uint32>(request)));
+    if (bin != InvalidNode) {
+        nodeIndex = m_BinHeads[bin];
+    } else {
+        // The bin below may still hold a range that fits, e.g. when asking for the whole capacity
+        for (uint32 node = m_BinHeads[SizeToBinRoundDown(static_cast<uint32>(request))]; node != InvalidNode;
+             node = m_Nodes[node].BinNext) {
+            const uint64 padding = AlignUp(m_Nodes[node].Offset, alignment) - m_Nodes[node].Offset;
+            if (m_Nodes[node].Size >= padding + size) {
+                nodeIndex = node;
+                break;
+            }
+        }
+        if (nodeIndex == InvalidNode) { return InvalidOffset; }
+    }
+    RemoveFreeNode(nodeIndex);
+
+    // Leading padding becomes a free range of its own
+    const uint32 alignedOffset = static_cast<uint32>(AlignUp(m_Nodes[nodeIndex].Offset, alignment));
+    const uint32 padding = alignedOffset - m_Nodes[nodeIndex].Offset;
+    if (padding > 0) {
+        const uint32 front = CreateNode(m_Nodes[nodeIndex].Offset, padding);
+        auto& node = m_Nodes[nodeIndex];
+        m_Nodes[front].AddressPrev = node.AddressPrev;
+        m_Nodes[front].AddressNext = nodeIndex;
+        if (node.AddressPrev != InvalidNode) { m_Nodes[node.AddressPrev].AddressNext = front; }
+        node.AddressPrev = front;
+        node.Offset = alignedOffset;
+        node.Size -= padding;
+        InsertFreeNode(front);
+    }
+
+    // Trailing remainder goes back to the bins
+    if (m_Nodes[nodeIndex].Size > size) {
+        const uint32 back = CreateNode(alignedOffset + size, m_Nodes[nodeIndex].Size - size);
+        auto& node = m_Nodes[nodeIndex];
+        m_Nodes[back].AddressPrev = nodeIndex;
+        m_Nodes[back].AddressNext = node.AddressNext;
+        if (node.AddressNext != InvalidNode) { m_Nodes[node.AddressNext].AddressPrev = back; }
+        node.AddressNext = back;
+        node.Size = size;
+        InsertFreeNode(back);
+    }
+
+    m_Nodes[nodeIndex].Used = true;
+    m_UsedNodes.emplace(alignedOffset, nodeIndex);
+    m_FreeSize -= size;
+    return alignedOffset;
+}
+
+void RHIRangeAllocator::Free(uint32 offset) {
+    const auto it = m_UsedNodes.find(offset);
+    if (it == m_UsedNodes.end()) {
+        Internal::LogError("RHIRangeAllocator: Freeing unknown offset {0}", offset);
+        return;
+    }
+
+    const uint32 nodeIndex = it->second;
+    m_UsedNodes.erase(it);
+    m_Nodes[nodeIndex].Used = false;
+    m_FreeSize += m_Nodes[nodeIndex].Size;
+
+    // Coalesce with free neighbours on both sides
+    const uint32 prev = m_Nodes[nodeIndex].AddressPrev;
+    if (prev != InvalidNode && !m_Nodes[prev].Used) {
+        RemoveFreeNode(prev);
+        auto& node = m_Nodes[nodeIndex];
+        node.Offset = m_Nodes[prev].Offset;
+        node.Size += m_Nodes[prev].Size;
+        node.AddressPrev = m_Nodes[prev].AddressPrev;
+        if (node.AddressPrev != InvalidNode) { m_Nodes[node.AddressPrev].AddressNext = nodeIndex; }
+        ReleaseNode(prev);
+    }
+
+    const uint32 next = m_Nodes[nodeIndex].AddressNext;
+    if (next != InvalidNode && !m_Nodes[next].Used) {
+        RemoveFreeNode(next);
+        auto& node = m_Nodes[nodeIndex];
+        node.Size += m_Nodes[next].Size;
+        node.AddressNext = m_Nodes[next].AddressNext;
+        if (node.AddressNext != InvalidNode) { m_Nodes[node.AddressNext].AddressPrev = nodeIndex; }
+        ReleaseNode(next);
+    }
+
+    InsertFreeNode(nodeIndex);
+}
+
+uint32 RHIRangeAllocator::GetAllocationSize(uint32 offset) const {
+    const auto it = m_UsedNodes.find(offset);
+    return it != m_UsedNodes.end() ? m_Nodes[it->second].Size : 0;
+}
+
+uint32 RHIRangeAllocator::GetLargestFreeRange() const {
+    if (m_TopMask == 0) { return 0; }
+
+    // Only the highest non-empty bin can hold the largest range, its ranges differ below the mantissa
+    const uint32 top = static_cast<uint32>(std::bit_width(m_TopMask)) - 1;
+    const uint32 bin = top * LeafBinCount + static_cast<uint32>(std::bit_width(m_LeafMasks[top])) - 1;
+    uint32 largest = 0;
+    for (uint32 node = m_BinHeads[bin]; node != InvalidNode; node = m_Nodes[node].BinNext) {
+        largest = std::max(largest, m_Nodes[node].Size);
+    }
+    return largest;
+}
+
+uint32 RHIRangeAllocator::CreateNode(uint32 offset, uint32 size) {
+    uint32 index;
+    if (!m_SpareNodes.empty()) {
+        index = m_SpareNodes.back();
+        m_SpareNodes.pop_back();
+    } else {
+        index = static_cast<uint32>(m_Nodes.size());
+        m_Nodes.emplace_back();
+    }
+
+    m_Nodes[index] = {};
+    m_Nodes[index].Offset = offset;
+    m_Nodes[index].Size = size;
+    return index;
+}
+
+void RHIRangeAllocator::ReleaseNode(uint32 node) { m_SpareNodes.push_back(node); }
+
+void RHIRangeAllocator::InsertFreeNode(uint32 nodeIndex) {
+    const uint32 bin = SizeToBinRoundDown(m_Nodes[nodeIndex].Size);
+    auto& node = m_Nodes[nodeIndex];
+    node.BinPrev = InvalidNode;
+    node.BinNext = m_BinHeads[bin];
+    if (node.BinNext != InvalidNode) { m_Nodes[node.BinNext].BinPrev = nodeIndex; }
+    m_BinHeads[bin] = nodeIndex;
+
+    m_TopMask |= 1u << (bin / LeafBinCount);
+    m_LeafMasks[bin / LeafBinCount] |= static_cast<uint8>(1u << (bin % LeafBinCount));
+}
+
+void RHIRangeAllocator::RemoveFreeNode(uint32 nodeIndex) {
+    const auto& node = m_Nodes[nodeIndex];
+    if (node.BinPrev != InvalidNode) {
+        m_Nodes[node.BinPrev].BinNext = node.BinNext;
+    } else {
+        // Head of its bin, the bin may become empty
+        const uint32 bin = SizeToBinRoundDown(node.Size);
+        m_BinHeads[bin] = node.BinNext;
+        if (node.BinNext == InvalidNode) {
+            const uint32 top = bin / LeafBinCount;
+            m_LeafMasks[top] &= static_cast<uint8>(~(1u << (bin % LeafBinCount)));
+            if (m_LeafMasks[top] == 0) { m_TopMask &= ~(1u << top); }
+        }
+    }
+    if (node.BinNext != InvalidNode) { m_Nodes[node.BinNext].BinPrev = node.BinPrev; }
+}
+
+uint32 RHIRangeAllocator::FindFreeBin(uint32 minimumBin) const {
+    if (minimumBin >= BinCount) { return InvalidNode; }
+
+    // Same top bin first, then the lowest non-empty leaf of the next populated top bin
+    uint32 top = minimumBin / LeafBinCount;
+    const uint32 leafMask = m_LeafMasks[top] & (0xFFu << (minimumBin % LeafBinCount));
+    if (leafMask != 0) { return top * LeafBinCount + static_cast<uint32>(std::countr_zero(leafMask)); }
+
+    const uint32 topMask = top + 1 < TopBinCount ? m_TopMask & (~0u << (top + 1)) : 0;
+    if (topMask == 0) { return InvalidNode; }
+    top = static_cast<uint32>(std::countr_zero(topMask));
+    return top * LeafBinCount + static_cast<uint32>(std::countr_zero(static_cast<uint32>(m_LeafMasks[top])));
+}
+
+// =================================================================================================
+// RHIIndexAllocator
+// =================================================================================================
+
+RHIIndexAllocator::RHIIndexAllocator(uint32 capacity) { Reset(capacity); }
+
+RHIIndexAllocator::~RHIIndexAllocator() = default;
+
+void RHIIndexAllocator::Reset(uint32 capacity) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    m_Capacity = capacity;
+    m_Ranges.Reset(capacity);
+
+    // Batches are aligned to their size, only whole words inside the capacity can ever hold one
+    m_BatchCount = capacity / BatchSize;
+    m_BatchFreeMasks = std::make_unique<std::atomic<uint64>[]>(m_BatchCount);
+    m_BatchOwned = std::make_unique<std::atomic<bool>[]>(m_BatchCount);
+    m_BatchHint.store(0, std::memory_order_relaxed);
+    m_ParkedCount.store(0, std::memory_order_relaxed);
+}
+
+uint32 RHIIndexAllocator::Allocate() {
+    // Lock-free path: claim the lowest free bit of any batch, starting at the last batch that had one
+    const uint32 hint = m_BatchHint.load(std::memory_order_relaxed);
+    for (uint32 i = 0; i < m_BatchCount; ++i) {
+        const uint32 word = (hint + i) % m_BatchCount;
+        auto& mask = m_BatchFreeMasks[word];
+        uint64 bits = mask.load(std::memory_order_relaxed);
+        while (bits != 0) {
+            const uint64 bit = bits & (~bits + 1);
+            if (mask.compare_exchange_weak(bits, bits & ~bit, std::memory_order_acquire,
+                                           std::memory_order_relaxed)) {
+                if (word != hint) { m_BatchHint.store(word, std::memory_order_relaxed); }
+                m_ParkedCount.fetch_sub(1, std::memory_order_relaxed);
+                return word * BatchSize + static_cast<uint32>(std::countr_zero(bit));
+            }
+        }
+    }
+
+    return AllocateSlow();
+}
+
+uint32 RHIIndexAllocator::AllocateSlow() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    // Carve a fresh batch and keep its first slot
+    const uint32 start = m_Ranges.Allocate(BatchSize, BatchSize);
+    if (start != RHIRangeAllocator::InvalidOffset) {
+        const uint32 word = start / BatchSize;
+        m_BatchOwned[word].store(true, std::memory_order_release);
+        m_ParkedCount.fetch_add(BatchSize - 1, std::memory_order_relaxed);
+        m_BatchFreeMasks[word].store(BatchFull & ~1ull, std::memory_order_release);
+        m_BatchHint.store(word, std::memory_order_relaxed);
+        return start;
+    }
+
+    // No aligned batch left, fall back to a lone slot
+    return m_Ranges.Allocate(1);
+}
+
+void RHIIndexAllocator::Free(uint32 index) {
+    if (index >= m_Capacity) { return; }
+
+    const uint32 word = index / BatchSize;
+    if (word < m_BatchCount && m_BatchOwned[word].load(std::memory_order_acquire)) {
+        const uint64 bit = 1ull << (index % BatchSize);
+        m_ParkedCount.fetch_add(1, std::memory_order_relaxed);
+        const uint64 previous = m_BatchFreeMasks[word].fetch_or(bit, std::memory_order_acq_rel);
+
+        // The free that completes a batch returns it, whoever wins the exchange owns the hand-back
+        uint64 expected = BatchFull;
+        if ((previous | bit) == BatchFull &&
+            m_BatchFreeMasks[word].compare_exchange_strong(expected, 0, std::memory_order_acq_rel)) {
+            m_ParkedCount.fetch_sub(BatchSize, std::memory_order_relaxed);
+            m_BatchOwned[word].store(false, std::memory_order_release);
+
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Ranges.Free(word * BatchSize);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Ranges.Free(index);
+}
+
+uint32 RHIIndexAllocator::AllocateRange(uint32 count) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Ranges.Allocate(count);
+}
+
+void RHIIndexAllocator::FreeRange(uint32 startIndex) {
+    if (startIndex >= m_Capacity) { return; }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Ranges.Free(startIndex);
+}
+
+uint32 RHIIndexAllocator::GetFreeCount() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Ranges.GetFreeSize() + m_ParkedCount.load(std::memory_order_relaxed);
+}
+
+uint32 RHIIndexAllocator::GetLargestFreeRange() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Ranges.GetLargestFreeRange();
+}
+
+// =================================================================================================
+// Deferred Index Allocator
+// =================================================================================================
+
+RHIDeferredIndexAllocator::RHIDeferredIndexAllocator(uint32 capacity) : m_Indices(capacity) {}
+
+void RHIDeferredIndexAllocator::Reset(uint32 capacity) {
+    m_Indices.Reset(capacity);
+    m_Pending.clear();
+}
+
+void RHIDeferredIndexAllocator::Free(uint32 index, uint64 frameSerial) {
+    if (index >= m_Indices.GetCapacity()) { return; }
+
+    std::lock_guard<std::mutex> lock(m_PendingMutex);
+    m_Pending.push_back({frameSerial, index});
+}
+
+void RHIDeferredIndexAllocator::Retire(uint64 completedFrameSerial) {
+    std::lock_guard<std::mutex> lock(m_PendingMutex);
+
+    // Serials arrive in frame order, a free racing in from an older frame only waits a little longer
+    while (!m_Pending.empty() && m_Pending.front().FrameSerial <= completedFrameSerial) {
+        m_Indices.Free(m_Pending.front().Index);
+        m_Pending.pop_front();
+    }
+}
+
+uint32 RHIDeferredIndexAllocator::GetPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_PendingMutex);
+    return static_cast<uint32>(m_Pending.size());
+}
+
+} // namespace iGe
@@ -0,0 +1,160 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.RHI:RHIRangeAllocator;
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Range Allocator
+// =================================================================================================
+
+// Two-level segregated fit (TLSF) allocator over an abstract [0, capacity) range of units, e.g. descriptor
+// slots. Free ranges are binned by size with a 3-bit mantissa, so allocation and free are O(1) and
+// neighbouring free ranges coalesce on free. Not thread-safe, wrap it (see RHIIndexAllocator) for shared use.
+export class IGE_API RHIRangeAllocator {
+public:
+    static constexpr uint32 InvalidOffset = std::numeric_limits<uint32>::max();
+
+    explicit RHIRangeAllocator(uint32 capacity = 0);
+
+    // Drop every allocation and start over with a single free range
+    void Reset(uint32 capacity);
+
+    // Returns InvalidOffset when no free range is large enough, alignment must be a power of two
+    uint32 Allocate(uint32 size, uint32 alignment = 1);
+    void Free(uint32 offset);
+
+    // Size of a live allocation, zero for unknown offsets
+    uint32 GetAllocationSize(uint32 offset) const;
+
+    uint32 GetCapacity() const { return m_Capacity; }
+    uint32 GetFreeSize() const { return m_FreeSize; }
+    uint32 GetAllocationCount() const { return static_cast<uint32>(m_UsedNodes.size()); }
+    uint32 GetLargestFreeRange() const;
+
+private:
+    static constexpr uint32 InvalidNode = std::numeric_limits<uint32>::max();
+    static constexpr uint32 LeafBinCount = 8;
+    static constexpr uint32 TopBinCount = 32;
+    static constexpr uint32 BinCount = TopBinCount * LeafBinCount;
+
+    struct Node {
+        uint32 Offset = 0;
+        uint32 Size = 0;
+        uint32 BinPrev = InvalidNode; // Free ranges of the same bin
+        uint32 BinNext = InvalidNode;
+        uint32 AddressPrev = InvalidNode; // Neighbouring ranges in address order, used or free
+        uint32 AddressNext = InvalidNode;
+        bool Used = false;
+    };
+
+    uint32 CreateNode(uint32 offset, uint32 size);
+    void ReleaseNode(uint32 node);
+    void InsertFreeNode(uint32 node);
+    void RemoveFreeNode(uint32 node);
+    uint32 FindFreeBin(uint32 minimumBin) const;
+
+    uint32 m_Capacity = 0;
+    uint32 m_FreeSize = 0;
+
+    uint32 m_TopMask = 0;
+    std::array<uint8, TopBinCount> m_LeafMasks = {};
+    std::array<uint32, BinCount> m_BinHeads = {};
+
+    std::vector<Node> m_Nodes;
+    std::vector<uint32> m_SpareNodes;
+    std::unordered_map<uint32, uint32> m_UsedNodes; // Offset -> node
+};
+
+// =================================================================================================
+// Index Allocator
+// =================================================================================================
+
+// Thread-safe slot allocator on top of RHIRangeAllocator. Ranges take a mutex, single slots are served
+// lock-free from 64-slot batches tracked in atomic bitmasks; a batch whose slots are all free again is
+// handed back to the range allocator so single-slot churn cannot starve range allocations.
+export class IGE_API RHIIndexAllocator {
+public:
+    static constexpr uint32 InvalidIndex = RHIRangeAllocator::InvalidOffset;
+
+    explicit RHIIndexAllocator(uint32 capacity = 0);
+    ~RHIIndexAllocator();
+
+    RHIIndexAllocator(const RHIIndexAllocator&) = delete;
+    RHIIndexAllocator& operator=(const RHIIndexAllocator&) = delete;
+
+    // Not safe against concurrent allocation or free
+    void Reset(uint32 capacity);
+    void Reset() { Reset(m_Capacity); }
+
+    uint32 Allocate();
+    void Free(uint32 index);
+
+    uint32 AllocateRange(uint32 count);
+    void FreeRange(uint32 startIndex);
+
+    uint32 GetCapacity() const { return m_Capacity; }
+    // Slots not handed out, including those parked in single-slot batches
+    uint32 GetFreeCount() const;
+    uint32 GetLargestFreeRange() const;
+
+private:
+    static constexpr uint32 BatchSize = 64;
+    static constexpr uint64 BatchFull = ~0ull;
+
+    uint32 AllocateSlow();
+
+    uint32 m_Capacity = 0;
+    uint32 m_BatchCount = 0;
+
+    // Bit set = slot parked in the batch and free, owned flags mark words that currently are batches
+    std::unique_ptr<std::atomic<uint64>[]> m_BatchFreeMasks;
+    std::unique_ptr<std::atomic<bool>[]> m_BatchOwned;
+    std::atomic<uint32> m_BatchHint = 0;
+    std::atomic<uint32> m_ParkedCount = 0;
+
+    mutable std::mutex m_Mutex;
+    RHIRangeAllocator m_Ranges;
+};
+
+// =================================================================================================
+// Deferred Index Allocator
+// =================================================================================================
+
+// RHIIndexAllocator whose frees only return to circulation once the GPU can no longer see them. A free is
+// tagged with the frame serial it happened in (see RHI::GetFrameSerial) and Retire releases every free whose
+// frame has completed, so an index handed to shaders is never reused while an in-flight frame may read it.
+export class IGE_API RHIDeferredIndexAllocator {
+public:
+    static constexpr uint32 InvalidIndex = RHIIndexAllocator::InvalidIndex;
+
+    explicit RHIDeferredIndexAllocator(uint32 capacity = 0);
+
+    // Not safe against concurrent use, pending frees are dropped
+    void Reset(uint32 capacity);
+
+    // Thread-safe
+    uint32 Allocate() { return m_Indices.Allocate(); }
+    void Free(uint32 index, uint64 frameSerial);
+    void Retire(uint64 completedFrameSerial);
+
+    uint32 GetCapacity() const { return m_Indices.GetCapacity(); }
+    uint32 GetFreeCount() const { return m_Indices.GetFreeCount(); }
+    uint32 GetPendingCount() const;
+
+private:
+    struct PendingFree {
+        uint64 FrameSerial = 0;
+        uint32 Index = 0;
+    };
+
+    RHIIndexAllocator m_Indices;
+
+    mutable std::mutex m_PendingMutex;
+    std::deque<PendingFree> m_Pending;
+};
+
+} // namespace iGe
@@ -57,6 +57,14 @@ export enum class RHILoadOp : uint32 { Load = 0, Clear, DontCare, Count };
 
 export enum class RHIStoreOp : uint32 { Store = 0, DontCare, Count };
 
+// Splits one render pass over several command lists submitted back to back. A suspending list ends the pass
+// without storing, the resuming list that follows binds the same attachments again without loading or clearing.
+export enum class RHIRenderPassFlag : uint32 {
+    None = 0,
+    Suspending = 1 << 0,
+    Resuming = 1 << 1,
+};
+
 // =================================================================================================
 // Clear Value
 // =================================================================================================
@@ -170,6 +178,8 @@ export struct RHIRenderPassBeginInfo {
     // Render area
     RHIOffset2D RenderAreaOffset = {0, 0};
     RHIExtent2D RenderAreaExtent = {0, 0};
+
+    Flags<RHIRenderPassFlag> PassFlags = RHIRenderPassFlag::None;
 };
 
 } // namespace iGe
@@ -2,6 +2,7 @@ module;
 #include "iGeMacro.h"
 
 export module iGe.RHI:RHIResource;
+import :RHIStatistics;
 import iGe.Common;
 
 namespace iGe
@@ -35,6 +36,7 @@ export enum class RHIResourceType : uint32 {
     DescriptorSetLayout,
     DescriptorPool,
     DescriptorSet,
+    DescriptorUpdateTemplate,
 
     // Render Pass and Framebuffer
     RenderPass,
@@ -49,6 +51,9 @@ export enum class RHIResourceType : uint32 {
     CommandPool,
     CommandList,
 
+    // Queries
+    QueryPool,
+
     // Synchronization
     Fence,
     Semaphore,
@@ -63,7 +68,7 @@ export enum class RHIResourceType : uint32 {
 export class IGE_API RHIResource {
 public:
     RHIResource() = delete;
-    virtual ~RHIResource() = default;
+    virtual ~RHIResource() { RHIStatistics::Add(RHIStatistic::ResourcesDestroyed); }
 
     // Type identification
     inline RHIResourceType GetResourceType() const { return m_Type; }
@@ -72,7 +77,9 @@ public:
     virtual void* GetNativeHandle() const { return nullptr; }
 
 protected:
-    RHIResource(RHIResourceType type) : m_Type(type) {}
+    RHIResource(RHIResourceType type) : m_Type(type) { RHIStatistics::Add(RHIStatistic::ResourcesCreated); }
+    RHIResource(const RHIResource& other) : m_Type(other.m_Type) { RHIStatistics::Add(RHIStatistic::ResourcesCreated); }
+    RHIResource& operator=(const RHIResource&) = default;
 
     RHIResourceType m_Type;
 };
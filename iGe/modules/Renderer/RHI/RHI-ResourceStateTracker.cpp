@@ -0,0 +1,143 @@
+module iGe.RHI;
+import :RHIResourceStateTracker;
+
+namespace iGe
+{
+
+namespace
+{
+// Global states are shared by every list of every queue
+std::mutex s_ResolveMutex;
+} // namespace
+
+// =================================================================================================
+// RHIResourceState
+// =================================================================================================
+
+void RHIResourceState::Reset(uint32 subresourceCount, RHILayout layout) {
+    m_SubresourceCount = std::max(1u, subresourceCount);
+    m_Uniform = layout;
+    m_Layouts.clear();
+}
+
+void RHIResourceState::Set(uint32 subresource, RHILayout layout) {
+    if (subresource == AllSubresources || m_SubresourceCount == 1) {
+        m_Uniform = layout;
+        m_Layouts.clear();
+        return;
+    }
+
+    if (m_Layouts.empty()) {
+        if (m_Uniform == layout) { return; }
+        m_Layouts.assign(m_SubresourceCount, m_Uniform);
+    }
+    m_Layouts[subresource] = layout;
+
+    if (std::all_of(m_Layouts.begin(), m_Layouts.end(), [&](RHILayout other) { return other == layout; })) {
+        m_Uniform = layout;
+        m_Layouts.clear();
+    }
+}
+
+// =================================================================================================
+// RHIResourceStateTracker
+// =================================================================================================
+
+void RHIResourceStateTracker::Transition(const RHIResource* resource, RHIResourceState* pGlobal,
+                                         uint32 subresourceCount, RHILayout layout, uint32 subresource) {
+    if (!resource) { return; }
+
+    auto [it, inserted] = m_Entries.try_emplace(resource);
+    Entry& entry = it->second;
+    if (inserted) {
+        entry.pGlobal = pGlobal;
+        entry.Entered.Reset(subresourceCount, Unknown);
+        entry.Current.Reset(subresourceCount, Unknown);
+    }
+
+    if (subresource != RHIResourceState::AllSubresources || entry.Current.IsUniform()) {
+        TransitionSubresource(resource, entry, subresource, layout);
+        return;
+    }
+
+    // Split state, every subresource moves on its own and the state collapses again afterwards
+    for (uint32 i = 0; i < entry.Current.GetSubresourceCount(); ++i) {
+        TransitionSubresource(resource, entry, i, layout);
+    }
+    entry.Current.Set(RHIResourceState::AllSubresources, layout);
+}
+
+void RHIResourceStateTracker::TransitionSubresource(const RHIResource* resource, Entry& entry, uint32 subresource,
+                                                    RHILayout layout) {
+    const uint32 lookup = subresource == RHIResourceState::AllSubresources ? 0 : subresource;
+    const RHILayout current = entry.Current.Get(lookup);
+    if (current == layout) { return; }
+
+    // First touch, the transition into it is resolved at submit
+    if (current == Unknown) {
+        entry.Entered.Set(subresource, layout);
+    } else {
+        AddTransition(resource, subresource, current, layout);
+    }
+    entry.Current.Set(subresource, layout);
+}
+
+void RHIResourceStateTracker::AddTransition(const RHIResource* resource, uint32 subresource, RHILayout before,
+                                            RHILayout after) {
+    // A transition of the same subresource still in the batch is extended instead, A->B->A vanishes
+    for (auto it = m_Pending.rbegin(); it != m_Pending.rend(); ++it) {
+        if (it->pResource != resource) { continue; }
+        if (it->Subresource != subresource) { break; }
+
+        it->After = after;
+        if (it->Before == it->After) { m_Pending.erase(std::next(it).base()); }
+        return;
+    }
+    m_Pending.push_back({resource, subresource, before, after});
+}
+
+void RHIResourceStateTracker::FlushTransitions(std::vector<RHIResourceTransition>& transitions) {
+    transitions.insert(transitions.end(), m_Pending.begin(), m_Pending.end());
+    m_Pending.clear();
+}
+
+void RHIResourceStateTracker::Resolve(std::vector<RHIResourceTransition>& fixups) const {
+    std::lock_guard<std::mutex> lock(s_ResolveMutex);
+
+    for (const auto& [resource, entry]: m_Entries) {
+        const RHIResourceState defaultState(entry.Entered.GetSubresourceCount(), RHILayout::Common);
+        const RHIResourceState& global = entry.pGlobal ? *entry.pGlobal : defaultState;
+
+        if (entry.Entered.IsUniform() && global.IsUniform()) {
+            const RHILayout entered = entry.Entered.Get(0);
+            if (entered != Unknown && entered != global.Get(0)) {
+                fixups.push_back({resource, RHIResourceState::AllSubresources, global.Get(0), entered});
+            }
+        } else {
+            for (uint32 i = 0; i < entry.Entered.GetSubresourceCount(); ++i) {
+                const RHILayout entered = entry.Entered.Get(i);
+                if (entered != Unknown && entered != global.Get(i)) {
+                    fixups.push_back({resource, i, global.Get(i), entered});
+                }
+            }
+        }
+
+        // Commit the layouts the list leaves behind, untouched subresources keep theirs
+        if (!entry.pGlobal) { continue; }
+        if (entry.Current.IsUniform()) {
+            const RHILayout current = entry.Current.Get(0);
+            if (current != Unknown) { entry.pGlobal->Set(RHIResourceState::AllSubresources, current); }
+            continue;
+        }
+        for (uint32 i = 0; i < entry.Current.GetSubresourceCount(); ++i) {
+            if (entry.Current.Get(i) != Unknown) { entry.pGlobal->Set(i, entry.Current.Get(i)); }
+        }
+    }
+}
+
+void RHIResourceStateTracker::Reset() {
+    m_Entries.clear();
+    m_Pending.clear();
+}
+
+} // namespace iGe
@@ -0,0 +1,90 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.RHI:RHIResourceStateTracker;
+import :RHIResource;
+import :RHIRenderPass; // For RHILayout
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Resource State
+// =================================================================================================
+
+// Layout of every subresource of one resource, stored once while all of them agree. Subresource i is
+// mip + layer * mipCount.
+export class IGE_API RHIResourceState {
+public:
+    static constexpr uint32 AllSubresources = ~0u;
+
+    RHIResourceState() = default;
+    RHIResourceState(uint32 subresourceCount, RHILayout layout) { Reset(subresourceCount, layout); }
+
+    void Reset(uint32 subresourceCount, RHILayout layout);
+
+    uint32 GetSubresourceCount() const { return m_SubresourceCount; }
+    bool IsUniform() const { return m_Layouts.empty(); }
+    RHILayout Get(uint32 subresource) const { return m_Layouts.empty() ? m_Uniform : m_Layouts[subresource]; }
+    // AllSubresources collapses the state back to a single layout
+    void Set(uint32 subresource, RHILayout layout);
+
+private:
+    uint32 m_SubresourceCount = 1;
+    RHILayout m_Uniform = RHILayout::Common;
+    std::vector<RHILayout> m_Layouts; // Empty while uniform
+};
+
+export struct RHIResourceTransition {
+    const RHIResource* pResource = nullptr;
+    uint32 Subresource = RHIResourceState::AllSubresources;
+    RHILayout Before = RHILayout::Common;
+    RHILayout After = RHILayout::Common;
+};
+
+// =================================================================================================
+// Resource State Tracker
+// =================================================================================================
+
+// Tracks the layouts one command list moves its resources through. Callers only name the layout they need,
+// the tracker knows the current one and batches the transition until the backend flushes it, transitions
+// cancelling out within a batch are dropped.
+//
+// The layout a resource enters the list in is unknown while recording, lists may be recorded in any order.
+// Resolve, called at submit in submission order, compares those entry layouts against the resource's global
+// state, returns the transitions that have to execute in front of the list and commits the list's final
+// layouts. Resources without a global state enter every submission in Common.
+export class IGE_API RHIResourceStateTracker {
+public:
+    // pGlobal is the resource's state between submissions, owned by the resource
+    void Transition(const RHIResource* resource, RHIResourceState* pGlobal, uint32 subresourceCount,
+                    RHILayout layout, uint32 subresource = RHIResourceState::AllSubresources);
+
+    bool HasPendingTransitions() const { return !m_Pending.empty(); }
+    // Hands the batch to the backend in request order
+    void FlushTransitions(std::vector<RHIResourceTransition>& transitions);
+
+    // Thread-safe against other lists resolving, appends to fixups
+    void Resolve(std::vector<RHIResourceTransition>& fixups) const;
+
+    void Reset();
+
+private:
+    // Layout of a subresource this list has not touched yet
+    static constexpr RHILayout Unknown = RHILayout::Count;
+
+    struct Entry {
+        RHIResourceState* pGlobal = nullptr;
+        RHIResourceState Entered; // First layout requested per subresource, Unknown if untouched
+        RHIResourceState Current;
+    };
+
+    void TransitionSubresource(const RHIResource* resource, Entry& entry, uint32 subresource, RHILayout layout);
+    void AddTransition(const RHIResource* resource, uint32 subresource, RHILayout before, RHILayout after);
+
+    std::unordered_map<const RHIResource*, Entry> m_Entries;
+    std::vector<RHIResourceTransition> m_Pending;
+};
+
+} // namespace iGe
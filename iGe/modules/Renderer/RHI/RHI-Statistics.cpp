@@ -0,0 +1,120 @@
+module iGe.RHI;
+import :RHIStatistics;
+
+namespace iGe
+{
+
+namespace
+{
+
+constexpr uint32 StatisticCount = static_cast<uint32>(RHIStatistic::Count);
+
+using CounterArray = std::array<uint64, StatisticCount>;
+
+// Only the owning thread writes its counters, they are atomic so EndFrame can read them meanwhile. Aligned so
+// two threads never write the same cache line
+struct alignas(64) ThreadCounters {
+    std::array<std::atomic<uint64>, StatisticCount> Values{};
+};
+
+// Blocks are never freed: a thread that exits keeps its counts in the totals, and resources destroyed during
+// static destruction still find their thread's block
+struct Registry {
+    std::mutex Mutex;
+    std::vector<Scope<ThreadCounters>> Threads;
+    CounterArray LastTotals{};
+    RHIFrameStatistics LastFrame;
+};
+
+Registry& GetRegistry() {
+    static Registry* registry = new Registry();
+    return *registry;
+}
+
+ThreadCounters& GetThreadCounters() {
+    thread_local ThreadCounters* counters = nullptr;
+    if (!counters) {
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.Mutex);
+        counters = registry.Threads.emplace_back(CreateScope<ThreadCounters>()).get();
+    }
+    return *counters;
+}
+
+// Caller holds the registry lock
+CounterArray SumCounters(const Registry& registry) {
+    CounterArray totals{};
+    for (const auto& counters: registry.Threads) {
+        for (uint32 i = 0; i < StatisticCount; ++i) {
+            totals[i] += counters->Values[i].load(std::memory_order_relaxed);
+        }
+    }
+    return totals;
+}
+
+} // namespace
+
+std::string_view GetRHIStatisticName(RHIStatistic statistic) {
+    switch (statistic) {
+        case RHIStatistic::DrawCalls:
+            return "Draw calls";
+        case RHIStatistic::DispatchCalls:
+            return "Dispatches";
+        case RHIStatistic::Triangles:
+            return "Triangles";
+        case RHIStatistic::PipelineBinds:
+            return "Pipeline binds";
+        case RHIStatistic::DescriptorBinds:
+            return "Descriptor binds";
+        case RHIStatistic::FilteredBinds:
+            return "Filtered binds";
+        case RHIStatistic::Barriers:
+            return "Barriers";
+        case RHIStatistic::DescriptorWrites:
+            return "Descriptor writes";
+        case RHIStatistic::UploadBytes:
+            return "Upload bytes";
+        case RHIStatistic::CommandListsSubmitted:
+            return "Lists submitted";
+        case RHIStatistic::ResourcesCreated:
+            return "Resources created";
+        case RHIStatistic::ResourcesDestroyed:
+            return "Resources destroyed";
+        default:
+            return "Unknown";
+    }
+}
+
+void RHIStatistics::Add(RHIStatistic statistic, uint64 value) {
+    // A plain load and store, the owning thread is the only writer
+    std::atomic<uint64>& counter = GetThreadCounters().Values[static_cast<uint32>(statistic)];
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+void RHIStatistics::EndFrame() {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+
+    const CounterArray totals = SumCounters(registry);
+    for (uint32 i = 0; i < StatisticCount; ++i) { registry.LastFrame.Values[i] = totals[i] - registry.LastTotals[i]; }
+    ++registry.LastFrame.FrameIndex;
+    registry.LastTotals = totals;
+}
+
+RHIFrameStatistics RHIStatistics::GetLastFrame() {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+    return registry.LastFrame;
+}
+
+RHIFrameStatistics RHIStatistics::GetTotals() {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+
+    RHIFrameStatistics totals;
+    totals.FrameIndex = registry.LastFrame.FrameIndex;
+    totals.Values = SumCounters(registry);
+    return totals;
+}
+
+} // namespace iGe
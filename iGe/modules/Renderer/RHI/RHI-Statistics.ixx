@@ -0,0 +1,57 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.RHI:RHIStatistics;
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Statistics
+// =================================================================================================
+
+export enum class RHIStatistic : uint32 {
+    DrawCalls = 0,
+    DispatchCalls,
+    Triangles, // Of triangle list, strip and fan draws, instances included
+    PipelineBinds,
+    DescriptorBinds, // Descriptor sets and transient tables
+    FilteredBinds,   // Binds and dynamic state dropped by the backend for repeating what was already bound
+    Barriers,        // Barriers requested, before the backend merges them and drops redundant ones
+    DescriptorWrites,
+    UploadBytes, // Update counts the bytes written, Map the whole buffer since writes through it are invisible
+    CommandListsSubmitted,
+    ResourcesCreated,
+    ResourcesDestroyed,
+
+    Count
+};
+
+export IGE_API std::string_view GetRHIStatisticName(RHIStatistic statistic);
+
+export struct RHIFrameStatistics {
+    uint64 FrameIndex = 0; // Frames ended since startup, the first frame is 1
+    std::array<uint64, static_cast<uint32>(RHIStatistic::Count)> Values{};
+
+    uint64 operator[](RHIStatistic statistic) const { return Values[static_cast<uint32>(statistic)]; }
+};
+
+// Counters the RHI front end bumps as commands are recorded and submitted, so every backend reports the same
+// numbers. Each thread counts into its own block so recording threads never share a cache line, EndFrame sums
+// the blocks and keeps the difference to the previous frame.
+export class IGE_API RHIStatistics {
+public:
+    // Cheap enough for every draw: no lock, no read-modify-write shared with other threads
+    static void Add(RHIStatistic statistic, uint64 value = 1);
+
+    // Called by the backend at its frame boundary
+    static void EndFrame();
+
+    // The last ended frame, all zero before the first one
+    static RHIFrameStatistics GetLastFrame();
+    // Everything counted since startup, including the frame still being recorded
+    static RHIFrameStatistics GetTotals();
+};
+
+} // namespace iGe
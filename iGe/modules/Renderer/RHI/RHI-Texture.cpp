@@ -0,0 +1,166 @@
+module iGe.RHI;
+import :RHITexture;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Format Info
+// =================================================================================================
+
+namespace
+{
+
+constexpr RHIFormatInfo Uncompressed(uint32 bytesPerTexel, uint32 channelCount, bool srgb = false) {
+    return {1, 1, bytesPerTexel, channelCount, false, srgb, false};
+}
+
+constexpr RHIFormatInfo BlockCompressed(uint32 bytesPerBlock, uint32 channelCount, bool srgb = false) {
+    return {4, 4, bytesPerBlock, channelCount, true, srgb, false};
+}
+
+constexpr RHIFormatInfo DepthStencil(uint32 bytesPerTexel, uint32 channelCount) {
+    return {1, 1, bytesPerTexel, channelCount, false, false, true};
+}
+
+constexpr RHIFormatInfo BuildFormatInfo(RHIFormat format) {
+    switch (format) {
+        case RHIFormat::R8Srgb:
+            return Uncompressed(1, 1, true);
+        case RHIFormat::R8G8Srgb:
+            return Uncompressed(2, 2, true);
+        case RHIFormat::R8G8B8Srgb:
+            return Uncompressed(3, 3, true);
+        case RHIFormat::R8G8B8A8Srgb:
+        case RHIFormat::B8G8R8A8Srgb:
+            return Uncompressed(4, 4, true);
+
+        case RHIFormat::R16SFloat:
+            return Uncompressed(2, 1);
+        case RHIFormat::R16G16SFloat:
+            return Uncompressed(4, 2);
+        case RHIFormat::R16G16B16SFloat:
+            return Uncompressed(6, 3);
+        case RHIFormat::R16G16B16A16SFloat:
+            return Uncompressed(8, 4);
+        case RHIFormat::R32SFloat:
+            return Uncompressed(4, 1);
+        case RHIFormat::R32G32SFloat:
+            return Uncompressed(8, 2);
+        case RHIFormat::R32G32B32SFloat:
+            return Uncompressed(12, 3);
+        case RHIFormat::R32G32B32A32SFloat:
+            return Uncompressed(16, 4);
+
+        case RHIFormat::R8UNorm:
+        case RHIFormat::R8SNorm:
+        case RHIFormat::R8UInt:
+        case RHIFormat::R8SInt:
+            return Uncompressed(1, 1);
+        case RHIFormat::R8G8UNorm:
+        case RHIFormat::R8G8SNorm:
+        case RHIFormat::R8G8UInt:
+        case RHIFormat::R8G8SInt:
+            return Uncompressed(2, 2);
+        case RHIFormat::R8G8B8UNorm:
+        case RHIFormat::R8G8B8SNorm:
+        case RHIFormat::R8G8B8UInt:
+        case RHIFormat::R8G8B8SInt:
+            return Uncompressed(3, 3);
+        case RHIFormat::R8G8B8A8UNorm:
+        case RHIFormat::R8G8B8A8SNorm:
+        case RHIFormat::R8G8B8A8UInt:
+        case RHIFormat::R8G8B8A8SInt:
+            return Uncompressed(4, 4);
+
+        case RHIFormat::R16UNorm:
+        case RHIFormat::R16SNorm:
+        case RHIFormat::R16UInt:
+        case RHIFormat::R16SInt:
+            return Uncompressed(2, 1);
+        case RHIFormat::R16G16UNorm:
+        case RHIFormat::R16G16SNorm:
+        case RHIFormat::R16G16UInt:
+        case RHIFormat::R16G16SInt:
+            return Uncompressed(4, 2);
+        case RHIFormat::R16G16B16UNorm:
+        case RHIFormat::R16G16B16SNorm:
+        case RHIFormat::R16G16B16UInt:
+        case RHIFormat::R16G16B16SInt:
+            return Uncompressed(6, 3);
+        case RHIFormat::R16G16B16A16UNorm:
+        case RHIFormat::R16G16B16A16SNorm:
+        case RHIFormat::R16G16B16A16UInt:
+        case RHIFormat::R16G16B16A16SInt:
+            return Uncompressed(8, 4);
+
+        case RHIFormat::R32UInt:
+        case RHIFormat::R32SInt:
+            return Uncompressed(4, 1);
+        case RHIFormat::R32G32UInt:
+        case RHIFormat::R32G32SInt:
+            return Uncompressed(8, 2);
+        case RHIFormat::R32G32B32UInt:
+        case RHIFormat::R32G32B32SInt:
+            return Uncompressed(12, 3);
+        case RHIFormat::R32G32B32A32UInt:
+        case RHIFormat::R32G32B32A32SInt:
+            return Uncompressed(16, 4);
+
+        case RHIFormat::D32SFloat:
+            return DepthStencil(4, 1);
+        case RHIFormat::D32SFloatS8UInt:
+            return DepthStencil(8, 2);
+        case RHIFormat::D24UNormS8UInt:
+            return DepthStencil(4, 2);
+
+        case RHIFormat::BC1RGBAUNorm:
+            return BlockCompressed(8, 4);
+        case RHIFormat::BC1RGBASrgb:
+            return BlockCompressed(8, 4, true);
+        case RHIFormat::BC3UNorm:
+            return BlockCompressed(16, 4);
+        case RHIFormat::BC3Srgb:
+            return BlockCompressed(16, 4, true);
+        case RHIFormat::BC4UNorm:
+        case RHIFormat::BC4SNorm:
+            return BlockCompressed(8, 1);
+        case RHIFormat::BC5UNorm:
+        case RHIFormat::BC5SNorm:
+            return BlockCompressed(16, 2);
+        case RHIFormat::BC7UNorm:
+            return BlockCompressed(16, 4);
+        case RHIFormat::BC7Srgb:
+            return BlockCompressed(16, 4, true);
+
+        default:
+            return {};
+    }
+}
+
+constexpr auto BuildFormatInfoTable() {
+    std::array<RHIFormatInfo, static_cast<size_t>(RHIFormat::Count) + 1> table{};
+    for (size_t i = 0; i < table.size(); ++i) { table[i] = BuildFormatInfo(static_cast<RHIFormat>(i)); }
+    return table;
+}
+
+constexpr auto s_FormatInfoTable = BuildFormatInfoTable();
+
+} // namespace
+
+const RHIFormatInfo& GetFormatInfo(RHIFormat format) {
+    const auto index = static_cast<size_t>(format);
+    return s_FormatInfoTable[index < s_FormatInfoTable.size() ? index : 0];
+}
+
+uint64 GetFormatRowBytes(RHIFormat format, uint32 width) {
+    const auto& info = GetFormatInfo(format);
+    return static_cast<uint64>((width + info.BlockWidth - 1) / info.BlockWidth) * info.BytesPerBlock;
+}
+
+uint32 GetFormatRowCount(RHIFormat format, uint32 height) {
+    const auto& info = GetFormatInfo(format);
+    return (height + info.BlockHeight - 1) / info.BlockHeight;
+}
+
+} // namespace iGe
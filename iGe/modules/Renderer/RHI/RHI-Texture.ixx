@@ -90,9 +90,41 @@ export enum class RHIFormat : uint32 {
     D32SFloatS8UInt,
     D24UNormS8UInt,
 
+    BC1RGBAUNorm,
+    BC1RGBASrgb,
+    BC3UNorm,
+    BC3Srgb,
+    BC4UNorm,
+    BC4SNorm,
+    BC5UNorm,
+    BC5SNorm,
+    BC7UNorm,
+    BC7Srgb,
+
     Count
 };
 
+// =================================================================================================
+// Format Info
+// =================================================================================================
+
+export struct RHIFormatInfo {
+    uint32 BlockWidth = 1; // Texels covered by one block, 1x1 for uncompressed formats
+    uint32 BlockHeight = 1;
+    uint32 BytesPerBlock = 0;
+    uint32 ChannelCount = 0;
+    bool Compressed = false;
+    bool Srgb = false;
+    bool Depth = false;
+};
+
+export IGE_API const RHIFormatInfo& GetFormatInfo(RHIFormat format);
+
+// Bytes of one tightly packed row of blocks
+export IGE_API uint64 GetFormatRowBytes(RHIFormat format, uint32 width);
+// Number of block rows covering height texels
+export IGE_API uint32 GetFormatRowCount(RHIFormat format, uint32 height);
+
 // =================================================================================================
 // Texture Type
 // =================================================================================================
@@ -154,6 +186,7 @@ export struct RHITextureCreateInfo {
 
     Flags<RHITextureUsageFlagBits> Usage = RHITextureUsageFlagBits::Sampled;
     RHIMemoryUsage MemoryUsage = RHIMemoryUsage::GpuOnly;
+    bool Relocatable = false; // Sampled and storage textures only, attachments never move (see RHIBufferCreateInfo)
 
     // Initial data (optional, for immutable textures)
     const void* pInitialData = nullptr;
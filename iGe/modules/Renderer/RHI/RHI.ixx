@@ -4,6 +4,7 @@ export module iGe.RHI;
 export import :RHI;
 export import :RHIResource;
 export import :RHIDeviceCapabilities;
+export import :RHIStatistics;
 
 // Synchronization
 export import :RHIFence;
@@ -12,10 +13,20 @@ export import :RHISemaphore;
 // Queue and Commands
 export import :RHIQueue;
 export import :RHICommandList;
+export import :RHIBackend;
 export import :RHICommandPool;
+export import :RHICommandListManager;
+export import :RHIParallelRecorder;
+export import :RHICommandStateCache;
+export import :RHICommandStream;
+export import :RHICommandEncoder;
 
 // Memory Management
 export import :RHIBuffer;
+export import :RHIRangeAllocator;
+export import :RHIConstantAllocator;
+export import :RHIMemoryAllocator;
+export import :RHIDeletionQueue;
 
 // Textures and Views
 export import :RHITexture;
@@ -24,6 +35,8 @@ export import :RHISampler;
 
 // Descriptors
 export import :RHIDescriptor;
+export import :RHIDescriptorRing;
+export import :RHIBindlessTable;
 
 // Surface and Swapchain
 export import :RHISurface;
@@ -44,6 +57,18 @@ export import :RHIComputePipeline;
 
 // Barriers
 export import :RHIBarrier;
+export import :RHIResourceStateTracker;
+
+// Queries and Profiling
+export import :RHIQuery;
+export import :RHIGpuProfiler;
 
 // ImGui Integration
 export import :RHIImGuiContext;
+
+// Capture and Replay
+export import :RHICapture;
+export import :RHICaptureReplay;
+
+// Diagnostics
+export import :RHILint;
@@ -0,0 +1,481 @@
+module;
+#if defined(_M_X64) || defined(__SSE2__)
+    #include <emmintrin.h>
+    #define IGE_SIMD_SSE2
+#elif defined(_M_ARM64) || defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define IGE_SIMD_NEON
+#endif
+
+module iGe.Renderer;
+import :BlockCompression;
+
+namespace iGe
+{
+
+namespace
+{
+
+// =================================================================================================
+// Block helpers
+// =================================================================================================
+
+// Texels of one block in structure-of-arrays layout so four texels fit one SIMD register
+struct BlockTexels {
+    alignas(16) float32 Channel[4][16];
+};
+
+void LoadBlock(const uint8* rgba, BlockTexels& block) {
+    for (uint32 i = 0; i < 16; ++i) {
+        for (uint32 c = 0; c < 4; ++c) { block.Channel[c][i] = static_cast<float32>(rgba[i * 4 + c]); }
+    }
+}
+
+// Endpoints spanning the block along its principal axis
+void ComputeEndpoints(const BlockTexels& block, uint32 channels, float32* e0, float32* e1) {
+    float32 mean[4] = {};
+    for (uint32 c = 0; c < channels; ++c) {
+        for (uint32 i = 0; i < 16; ++i) { mean[c] += block.Channel[c][i]; }
+        mean[c] /= 16.0f;
+    }
+
+    float32 covariance[4][4] = {};
+    for (uint32 i = 0; i < 16; ++i) {
+        for (uint32 a = 0; a < channels; ++a) {
+            for (uint32 b = a; b < channels; ++b) {
+                covariance[a][b] += (block.Channel[a][i] - mean[a]) * (block.Channel[b][i] - mean[b]);
+            }
+        }
+    }
+    for (uint32 a = 0; a < channels; ++a) {
+        for (uint32 b = 0; b < a; ++b) { covariance[a][b] = covariance[b][a]; }
+    }
+
+    // Start from the column of the widest channel, a fixed start like (1, 1, 1, 1) is orthogonal to the axis of
+    // anti-correlated channels (a red to blue gradient) and would collapse the block to its mean
+    uint32 widest = 0;
+    for (uint32 c = 1; c < channels; ++c) {
+        if (covariance[c][c] > covariance[widest][widest]) { widest = c; }
+    }
+    float32 axis[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    if (covariance[widest][widest] > 1e-6f) {
+        for (uint32 c = 0; c < channels; ++c) { axis[c] = covariance[c][widest]; }
+    }
+
+    // A few power iterations are plenty to find the dominant eigenvector of a 4x4 matrix
+    for (uint32 iteration = 0; iteration < 8; ++iteration) {
+        float32 next[4] = {};
+        float32 length = 0.0f;
+        for (uint32 a = 0; a < channels; ++a) {
+            for (uint32 b = 0; b < channels; ++b) { next[a] += covariance[a][b] * axis[b]; }
+            length = std::max(length, std::abs(next[a]));
+        }
+
+        if (length < 1e-6f) { break; }
+        for (uint32 a = 0; a < channels; ++a) { axis[a] = next[a] / length; }
+    }
+
+    float32 axisLengthSq = 0.0f;
+    for (uint32 c = 0; c < channels; ++c) { axisLengthSq += axis[c] * axis[c]; }
+
+    float32 minT = 0.0f;
+    float32 maxT = 0.0f;
+    for (uint32 i = 0; i < 16; ++i) {
+        float32 t = 0.0f;
+        for (uint32 c = 0; c < channels; ++c) { t += (block.Channel[c][i] - mean[c]) * axis[c]; }
+        minT = std::min(minT, t);
+        maxT = std::max(maxT, t);
+    }
+
+    const float32 scale = axisLengthSq > 1e-6f ? 1.0f / axisLengthSq : 0.0f;
+    for (uint32 c = 0; c < channels; ++c) {
+        e0[c] = std::clamp(mean[c] + minT * axis[c] * scale, 0.0f, 255.0f);
+        e1[c] = std::clamp(mean[c] + maxT * axis[c] * scale, 0.0f, 255.0f);
+    }
+}
+
+// Snap every texel to one of `levels` evenly spaced points on the segment e0 -> e1
+void ProjectIndices(const BlockTexels& block, uint32 channels, const float32* e0, const float32* e1, uint32 levels,
+                    uint8* indices) {
+    float32 direction[4] = {};
+    float32 lengthSq = 0.0f;
+    for (uint32 c = 0; c < channels; ++c) {
+        direction[c] = e1[c] - e0[c];
+        lengthSq += direction[c] * direction[c];
+    }
+
+    if (lengthSq < 1e-6f) {
+        std::memset(indices, 0, 16);
+        return;
+    }
+
+    const float32 scale = static_cast<float32>(levels - 1) / lengthSq;
+    const float32 maxLevel = static_cast<float32>(levels - 1);
+
+#if defined(IGE_SIMD_SSE2)
+    for (uint32 i = 0; i < 16; i += 4) {
+        __m128 dot = _mm_setzero_ps();
+        for (uint32 c = 0; c < channels; ++c) {
+            const __m128 texel = _mm_sub_ps(_mm_load_ps(&block.Channel[c][i]), _mm_set1_ps(e0[c]));
+            dot = _mm_add_ps(dot, _mm_mul_ps(texel, _mm_set1_ps(direction[c])));
+        }
+
+        __m128 t = _mm_mul_ps(dot, _mm_set1_ps(scale));
+        t = _mm_min_ps(_mm_max_ps(t, _mm_setzero_ps()), _mm_set1_ps(maxLevel));
+
+        alignas(16) int32 lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_cvtps_epi32(t));
+        for (uint32 k = 0; k < 4; ++k) { indices[i + k] = static_cast<uint8>(lanes[k]); }
+    }
+#elif defined(IGE_SIMD_NEON)
+    for (uint32 i = 0; i < 16; i += 4) {
+        float32x4_t dot = vdupq_n_f32(0.0f);
+        for (uint32 c = 0; c < channels; ++c) {
+            const float32x4_t texel = vsubq_f32(vld1q_f32(&block.Channel[c][i]), vdupq_n_f32(e0[c]));
+            dot = vmlaq_f32(dot, texel, vdupq_n_f32(direction[c]));
+        }
+
+        float32x4_t t = vmulq_f32(dot, vdupq_n_f32(scale));
+        t = vminq_f32(vmaxq_f32(t, vdupq_n_f32(0.0f)), vdupq_n_f32(maxLevel));
+
+        int32 lanes[4];
+        vst1q_s32(lanes, vcvtnq_s32_f32(t));
+        for (uint32 k = 0; k < 4; ++k) { indices[i + k] = static_cast<uint8>(lanes[k]); }
+    }
+#else
+    for (uint32 i = 0; i < 16; ++i) {
+        float32 dot = 0.0f;
+        for (uint32 c = 0; c < channels; ++c) { dot += (block.Channel[c][i] - e0[c]) * direction[c]; }
+        indices[i] = static_cast<uint8>(std::clamp(dot * scale, 0.0f, maxLevel) + 0.5f);
+    }
+#endif
+}
+
+// Least squares endpoints for a fixed index assignment
+void RefineEndpoints(const BlockTexels& block, uint32 channels, const uint8* indices, uint32 levels, float32* e0,
+                     float32* e1) {
+    float32 a = 0.0f;
+    float32 b = 0.0f;
+    float32 c = 0.0f;
+    float32 x[4] = {};
+    float32 y[4] = {};
+
+    for (uint32 i = 0; i < 16; ++i) {
+        const float32 w = static_cast<float32>(indices[i]) / static_cast<float32>(levels - 1);
+        const float32 iw = 1.0f - w;
+        a += iw * iw;
+        b += iw * w;
+        c += w * w;
+        for (uint32 ch = 0; ch < channels; ++ch) {
+            x[ch] += iw * block.Channel[ch][i];
+            y[ch] += w * block.Channel[ch][i];
+        }
+    }
+
+    const float32 determinant = a * c - b * b;
+    if (std::abs(determinant) < 1e-6f) { return; }
+
+    const float32 inverse = 1.0f / determinant;
+    for (uint32 ch = 0; ch < channels; ++ch) {
+        e0[ch] = std::clamp((c * x[ch] - b * y[ch]) * inverse, 0.0f, 255.0f);
+        e1[ch] = std::clamp((a * y[ch] - b * x[ch]) * inverse, 0.0f, 255.0f);
+    }
+}
+
+// LSB-first bit packing used by the BC7 block layout
+struct BitWriter {
+    uint8* Data;
+    uint32 Position = 0;
+
+    void Write(uint32 value, uint32 bitCount) {
+        for (uint32 i = 0; i < bitCount; ++i, ++Position) {
+            if ((value >> i) & 1u) { Data[Position >> 3] |= static_cast<uint8>(1u << (Position & 7u)); }
+        }
+    }
+};
+
+// =================================================================================================
+// BC1
+// =================================================================================================
+
+uint16 PackRGB565(const float32* color) {
+    const uint32 r = static_cast<uint32>(std::clamp(color[0], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+    const uint32 g = static_cast<uint32>(std::clamp(color[1], 0.0f, 255.0f) * 63.0f / 255.0f + 0.5f);
+    const uint32 b = static_cast<uint32>(std::clamp(color[2], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+    return static_cast<uint16>((r << 11) | (g << 5) | b);
+}
+
+void UnpackRGB565(uint16 packed, float32* color) {
+    const uint32 r = (packed >> 11) & 0x1Fu;
+    const uint32 g = (packed >> 5) & 0x3Fu;
+    const uint32 b = packed & 0x1Fu;
+    color[0] = static_cast<float32>((r << 3) | (r >> 2));
+    color[1] = static_cast<float32>((g << 2) | (g >> 4));
+    color[2] = static_cast<float32>((b << 3) | (b >> 2));
+}
+
+void EncodeBC1Color(const BlockTexels& block, bool allowTransparency, uint8* output) {
+    bool transparent[16] = {};
+    bool anyTransparent = false;
+    if (allowTransparency) {
+        for (uint32 i = 0; i < 16; ++i) {
+            transparent[i] = block.Channel[3][i] < 128.0f;
+            anyTransparent |= transparent[i];
+        }
+    }
+
+    // Four color mode interpolates 1/3 and 2/3, three color mode spends one index on transparency
+    const uint32 levels = anyTransparent ? 3 : 4;
+
+    float32 e0[4];
+    float32 e1[4];
+    uint8 fit[16];
+    ComputeEndpoints(block, 3, e0, e1);
+    ProjectIndices(block, 3, e0, e1, levels, fit);
+    RefineEndpoints(block, 3, fit, levels, e0, e1);
+
+    uint16 color0 = PackRGB565(e0);
+    uint16 color1 = PackRGB565(e1);
+
+    // Four color mode requires color0 > color1, three color mode color0 <= color1
+    if (anyTransparent ? color0 > color1 : color0 < color1) { std::swap(color0, color1); }
+
+    float32 q0[4];
+    float32 q1[4];
+    UnpackRGB565(color0, q0);
+    UnpackRGB565(color1, q1);
+    ProjectIndices(block, 3, q0, q1, levels, fit);
+
+    constexpr uint8 fourColorIndex[4] = {0, 2, 3, 1};
+    constexpr uint8 threeColorIndex[3] = {0, 2, 1};
+
+    uint32 indices = 0;
+    for (uint32 i = 0; i < 16; ++i) {
+        uint32 index = 0;
+        if (anyTransparent) {
+            index = transparent[i] ? 3u : threeColorIndex[fit[i]];
+        } else {
+            index = color0 == color1 ? 0u : fourColorIndex[fit[i]];
+        }
+        indices |= index << (i * 2);
+    }
+
+    output[0] = static_cast<uint8>(color0 & 0xFF);
+    output[1] = static_cast<uint8>(color0 >> 8);
+    output[2] = static_cast<uint8>(color1 & 0xFF);
+    output[3] = static_cast<uint8>(color1 >> 8);
+    for (uint32 i = 0; i < 4; ++i) { output[4 + i] = static_cast<uint8>(indices >> (i * 8)); }
+}
+
+// =================================================================================================
+// BC4
+// =================================================================================================
+
+void EncodeBC4Values(const float32* values, bool signedValues, uint8* output) {
+    float32 minValue = values[0];
+    float32 maxValue = values[0];
+    for (uint32 i = 1; i < 16; ++i) {
+        minValue = std::min(minValue, values[i]);
+        maxValue = std::max(maxValue, values[i]);
+    }
+
+    // Endpoints are stored as bytes, signed formats reinterpret them as int8
+    const int32 endpoint0 = static_cast<int32>(std::round(maxValue));
+    const int32 endpoint1 = static_cast<int32>(std::round(minValue));
+    output[0] = static_cast<uint8>(signedValues ? static_cast<int8>(endpoint0) : endpoint0);
+    output[1] = static_cast<uint8>(signedValues ? static_cast<int8>(endpoint1) : endpoint1);
+
+    // Eight value mode, index 0 is the maximum, 1 the minimum and 2..7 step from max towards min
+    uint64 bits = 0;
+    if (endpoint0 != endpoint1) {
+        const float32 scale = 7.0f / static_cast<float32>(endpoint0 - endpoint1);
+        for (uint32 i = 0; i < 16; ++i) {
+            const float32 t = std::clamp((static_cast<float32>(endpoint0) - values[i]) * scale, 0.0f, 7.0f);
+            const uint32 level = static_cast<uint32>(t + 0.5f);
+            const uint64 index = level == 0 ? 0u : (level == 7 ? 1u : level + 1);
+            bits |= index << (i * 3);
+        }
+    }
+
+    for (uint32 i = 0; i < 6; ++i) { output[2 + i] = static_cast<uint8>(bits >> (i * 8)); }
+}
+
+// =================================================================================================
+// BC7 (mode 6: one subset, RGBA 7.7.7.7 endpoints with unique p-bits, 4-bit indices)
+// =================================================================================================
+
+void QuantizeBC7Endpoint(const float32* endpoint, uint32* quantized, uint32& pBit) {
+    float32 bestError = std::numeric_limits<float32>::max();
+    for (uint32 p = 0; p < 2; ++p) {
+        uint32 candidate[4];
+        float32 error = 0.0f;
+        for (uint32 c = 0; c < 4; ++c) {
+            const float32 q = std::round((endpoint[c] - static_cast<float32>(p)) * 0.5f);
+            candidate[c] = static_cast<uint32>(std::clamp(q, 0.0f, 127.0f));
+            const float32 reconstructed = static_cast<float32>((candidate[c] << 1) | p);
+            error += (reconstructed - endpoint[c]) * (reconstructed - endpoint[c]);
+        }
+
+        if (error < bestError) {
+            bestError = error;
+            pBit = p;
+            std::copy_n(candidate, 4, quantized);
+        }
+    }
+}
+
+void EncodeBC7Mode6(const BlockTexels& block, uint8* output) {
+    float32 e0[4];
+    float32 e1[4];
+    uint8 indices[16];
+    ComputeEndpoints(block, 4, e0, e1);
+    ProjectIndices(block, 4, e0, e1, 16, indices);
+    RefineEndpoints(block, 4, indices, 16, e0, e1);
+
+    uint32 q0[4];
+    uint32 q1[4];
+    uint32 p0 = 0;
+    uint32 p1 = 0;
+    QuantizeBC7Endpoint(e0, q0, p0);
+    QuantizeBC7Endpoint(e1, q1, p1);
+
+    float32 r0[4];
+    float32 r1[4];
+    for (uint32 c = 0; c < 4; ++c) {
+        r0[c] = static_cast<float32>((q0[c] << 1) | p0);
+        r1[c] = static_cast<float32>((q1[c] << 1) | p1);
+    }
+    ProjectIndices(block, 4, r0, r1, 16, indices);
+
+    // The anchor texel stores only three index bits, so its most significant bit must be zero
+    if (indices[0] >= 8) {
+        std::swap(q0, q1);
+        std::swap(p0, p1);
+        for (uint32 i = 0; i < 16; ++i) { indices[i] = static_cast<uint8>(15 - indices[i]); }
+    }
+
+    std::memset(output, 0, 16);
+    BitWriter writer{output};
+    writer.Write(1u << 6, 7);
+    for (uint32 c = 0; c < 4; ++c) {
+        writer.Write(q0[c], 7);
+        writer.Write(q1[c], 7);
+    }
+    writer.Write(p0, 1);
+    writer.Write(p1, 1);
+    for (uint32 i = 0; i < 16; ++i) { writer.Write(indices[i], i == 0 ? 3 : 4); }
+}
+
+// =================================================================================================
+// Per-format dispatch
+// =================================================================================================
+
+using BlockEncoder = void (*)(const uint8*, uint8*);
+
+BlockEncoder GetBlockEncoder(RHIFormat format) {
+    switch (format) {
+        case RHIFormat::BC1RGBAUNorm:
+        case RHIFormat::BC1RGBASrgb:
+            return &EncodeBC1Block;
+        case RHIFormat::BC3UNorm:
+        case RHIFormat::BC3Srgb:
+            return &EncodeBC3Block;
+        case RHIFormat::BC4UNorm:
+            return [](const uint8* rgba, uint8* output) { EncodeBC4Block(rgba, 0, false, output); };
+        case RHIFormat::BC4SNorm:
+            return [](const uint8* rgba, uint8* output) { EncodeBC4Block(rgba, 0, true, output); };
+        case RHIFormat::BC5UNorm:
+            return [](const uint8* rgba, uint8* output) { EncodeBC5Block(rgba, false, output); };
+        case RHIFormat::BC5SNorm:
+            return [](const uint8* rgba, uint8* output) { EncodeBC5Block(rgba, true, output); };
+        case RHIFormat::BC7UNorm:
+        case RHIFormat::BC7Srgb:
+            return &EncodeBC7Block;
+        default:
+            return nullptr;
+    }
+}
+
+} // namespace
+
+// =================================================================================================
+// Block Encoders
+// =================================================================================================
+
+void EncodeBC1Block(const uint8* rgba, uint8* output) {
+    BlockTexels block;
+    LoadBlock(rgba, block);
+    EncodeBC1Color(block, true, output);
+}
+
+void EncodeBC3Block(const uint8* rgba, uint8* output) {
+    BlockTexels block;
+    LoadBlock(rgba, block);
+    EncodeBC4Values(block.Channel[3], false, output);
+    EncodeBC1Color(block, false, output + 8);
+}
+
+void EncodeBC4Block(const uint8* rgba, uint32 channel, bool signedValues, uint8* output) {
+    float32 values[16];
+    for (uint32 i = 0; i < 16; ++i) {
+        const float32 value = static_cast<float32>(rgba[i * 4 + channel]);
+        // Signed formats map [0, 255] onto [-127, 127]
+        values[i] = signedValues ? value * (254.0f / 255.0f) - 127.0f : value;
+    }
+    EncodeBC4Values(values, signedValues, output);
+}
+
+void EncodeBC5Block(const uint8* rgba, bool signedValues, uint8* output) {
+    EncodeBC4Block(rgba, 0, signedValues, output);
+    EncodeBC4Block(rgba, 1, signedValues, output + 8);
+}
+
+void EncodeBC7Block(const uint8* rgba, uint8* output) {
+    BlockTexels block;
+    LoadBlock(rgba, block);
+    EncodeBC7Mode6(block, output);
+}
+
+// =================================================================================================
+// Image Compression
+// =================================================================================================
+
+bool CompressImage(RHIFormat format, const uint8* rgba, uint32 width, uint32 height, uint64 srcRowPitch,
+                   uint8* output, uint64 dstRowPitch, ThreadPool* pThreadPool) {
+    const BlockEncoder encoder = GetBlockEncoder(format);
+    if (!encoder || !rgba || !output || width == 0 || height == 0) {
+        Internal::LogError("CompressImage: Unsupported format {0} or empty image", static_cast<uint32>(format));
+        return false;
+    }
+
+    const auto& info = GetFormatInfo(format);
+    const uint32 blocksX = (width + 3) / 4;
+    const uint32 blocksY = (height + 3) / 4;
+
+    auto encodeBlockRow = [&](uint32 blockY) {
+        alignas(16) uint8 texels[64];
+        uint8* dstRow = output + blockY * dstRowPitch;
+
+        for (uint32 blockX = 0; blockX < blocksX; ++blockX) {
+            for (uint32 y = 0; y < 4; ++y) {
+                const uint32 srcY = std::min(blockY * 4 + y, height - 1);
+                const uint8* srcRow = rgba + srcY * srcRowPitch;
+                for (uint32 x = 0; x < 4; ++x) {
+                    const uint32 srcX = std::min(blockX * 4 + x, width - 1);
+                    std::memcpy(&texels[(y * 4 + x) * 4], srcRow + srcX * 4, 4);
+                }
+            }
+            encoder(texels, dstRow + blockX * info.BytesPerBlock);
+        }
+    };
+
+    if (pThreadPool) {
+        pThreadPool->ParallelFor(blocksY, encodeBlockRow);
+    } else {
+        for (uint32 blockY = 0; blockY < blocksY; ++blockY) { encodeBlockRow(blockY); }
+    }
+
+    return true;
+}
+
+} // namespace iGe
@@ -0,0 +1,31 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.Renderer:BlockCompression;
+import iGe.RHI;
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Block Encoders
+// =================================================================================================
+
+// Every encoder takes one 4x4 block of RGBA8 texels in row order (64 bytes)
+export IGE_API void EncodeBC1Block(const uint8* rgba, uint8* output); // 8 bytes, 1-bit alpha when needed
+export IGE_API void EncodeBC3Block(const uint8* rgba, uint8* output); // 16 bytes
+export IGE_API void EncodeBC4Block(const uint8* rgba, uint32 channel, bool signedValues, uint8* output); // 8 bytes
+export IGE_API void EncodeBC5Block(const uint8* rgba, bool signedValues, uint8* output);                 // 16 bytes
+export IGE_API void EncodeBC7Block(const uint8* rgba, uint8* output); // 16 bytes, mode 6
+
+// =================================================================================================
+// Image Compression
+// =================================================================================================
+
+// Compress an RGBA8 image into a block-compressed RHIFormat. Partial edge blocks clamp to the image border.
+// Block rows are spread over the thread pool when one is given.
+export IGE_API bool CompressImage(RHIFormat format, const uint8* rgba, uint32 width, uint32 height, uint64 srcRowPitch,
+                                  uint8* output, uint64 dstRowPitch, ThreadPool* pThreadPool = nullptr);
+
+} // namespace iGe
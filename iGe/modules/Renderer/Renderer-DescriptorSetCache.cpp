@@ -0,0 +1,124 @@
+module iGe.Renderer;
+import :DescriptorSetCache;
+
+namespace iGe
+{
+
+DescriptorSetCache::DescriptorSetCache(std::span<const RHIDescriptorPoolSize> poolSizes, uint32 maxSets,
+                                       uint32 maxUnusedFrames)
+    : m_MaxUnusedFrames(maxUnusedFrames) {
+    RHIDescriptorPoolCreateInfo poolInfo;
+    poolInfo.MaxSets = maxSets;
+    poolInfo.PoolSizes = poolSizes;
+    poolInfo.AllowFreeDescriptorSet = true;
+    m_Pool = RHI::Get()->CreateDescriptorPool(poolInfo);
+}
+
+// In-flight frames may still bind the sets, they and then the pool are destroyed once the GPU has finished them.
+// The deletion queue runs in order, so every set goes back to the pool before the pool is destroyed.
+DescriptorSetCache::~DescriptorSetCache() {
+    for (auto& [key, entry]: m_Entries) { RHI::Get()->DeferDestroy(entry.Set); }
+    m_Entries.clear();
+    if (m_Pool) { RHI::Get()->DeferDestroy(m_Pool); }
+}
+
+const RHIDescriptorSet* DescriptorSetCache::GetOrCreate(const RHIDescriptorSetLayout* pLayout,
+                                                        std::span<const RHIWriteDescriptorSet> writes) {
+    if (!pLayout || !m_Pool) { return nullptr; }
+
+    const uint64 frameSerial = RHI::Get()->GetFrameSerial();
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    BuildKey(pLayout, writes);
+
+    if (auto it = m_Entries.find(m_ScratchKey); it != m_Entries.end()) {
+        ++m_Stats.Hits;
+        it->second.LastUsedFrame = frameSerial;
+        return it->second.Set.get();
+    }
+
+    Scope<RHIDescriptorSet> set = m_Pool->AllocateDescriptorSet(pLayout);
+    if (!set) {
+        Internal::LogError("DescriptorSetCache: Failed to allocate a descriptor set ({0} cached)", m_Entries.size());
+        return nullptr;
+    }
+
+    m_ScratchWrites.assign(writes.begin(), writes.end());
+    for (auto& write: m_ScratchWrites) { write.pDstSet = set.get(); }
+    RHI::Get()->UpdateDescriptorSets(m_ScratchWrites);
+
+    ++m_Stats.Misses;
+    const RHIDescriptorSet* result = set.get();
+    m_Entries.emplace(m_ScratchKey, Entry{std::move(set), frameSerial});
+    return result;
+}
+
+void DescriptorSetCache::EvictUnused() {
+    const uint64 frameSerial = RHI::Get()->GetFrameSerial();
+    const uint64 completedSerial = RHI::Get()->GetCompletedFrameSerial();
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stats.Evictions += std::erase_if(m_Entries, [&](const auto& item) {
+        const uint64 lastUsed = item.second.LastUsedFrame;
+        return frameSerial - lastUsed >= m_MaxUnusedFrames && lastUsed <= completedSerial;
+    });
+}
+
+void DescriptorSetCache::Clear() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stats.Evictions += m_Entries.size();
+    m_Entries.clear();
+}
+
+DescriptorSetCacheStats DescriptorSetCache::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    DescriptorSetCacheStats stats = m_Stats;
+    stats.LiveSets = static_cast<uint32>(m_Entries.size());
+    return stats;
+}
+
+void DescriptorSetCache::ResetStats() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stats = {};
+}
+
+size_t DescriptorSetCache::KeyHash::operator()(const std::vector<uint64>& key) const {
+    // splitmix64 finalizer folded over the words
+    uint64 hash = 0x9E3779B97F4A7C15ull ^ key.size();
+    for (uint64 word: key) {
+        hash ^= word + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+        hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+        hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+        hash ^= hash >> 31;
+    }
+    return static_cast<size_t>(hash);
+}
+
+void DescriptorSetCache::BuildKey(const RHIDescriptorSetLayout* pLayout,
+                                  std::span<const RHIWriteDescriptorSet> writes) {
+    auto address = [](const void* pointer) { return static_cast<uint64>(reinterpret_cast<uintptr_t>(pointer)); };
+
+    m_ScratchKey.clear();
+    m_ScratchKey.push_back(address(pLayout));
+
+    for (const auto& write: writes) {
+        m_ScratchKey.push_back(static_cast<uint64>(write.DstBinding) |
+                               static_cast<uint64>(write.DstArrayElement) << 32);
+        m_ScratchKey.push_back(static_cast<uint64>(write.DescriptorCount) |
+                               static_cast<uint64>(write.DescriptorType) << 32);
+
+        for (uint32 i = 0; i < write.DescriptorCount; ++i) {
+            if (write.pBufferInfos) {
+                const auto& info = write.pBufferInfos[i];
+                m_ScratchKey.insert(m_ScratchKey.end(), {address(info.pBuffer), info.Offset, info.Range});
+            }
+            if (write.pImageInfos) {
+                const auto& info = write.pImageInfos[i];
+                m_ScratchKey.insert(m_ScratchKey.end(), {address(info.pSampler), address(info.pTextureView),
+                                                         static_cast<uint64>(info.ImageLayout)});
+            }
+        }
+    }
+}
+
+} // namespace iGe
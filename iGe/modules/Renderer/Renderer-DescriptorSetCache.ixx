@@ -0,0 +1,71 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.Renderer:DescriptorSetCache;
+import iGe.RHI;
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Descriptor Set Cache
+// =================================================================================================
+
+export struct DescriptorSetCacheStats {
+    uint64 Hits = 0;
+    uint64 Misses = 0; // Sets allocated and written
+    uint64 Evictions = 0;
+    uint32 LiveSets = 0;
+};
+
+// Hands out one descriptor set per distinct (layout, writes) content, so materials or passes that rebuild
+// identical bindings every frame reuse the set instead of writing a new one. Keys hold resource addresses: a
+// resource destroyed while a set still names it must not be replaced by one at the same address before the
+// entry ages out, call Clear when in doubt.
+export class IGE_API DescriptorSetCache {
+public:
+    // Sets unused for maxUnusedFrames frames are destroyed by EvictUnused once the GPU has finished with them
+    explicit DescriptorSetCache(std::span<const RHIDescriptorPoolSize> poolSizes, uint32 maxSets = 1024,
+                                uint32 maxUnusedFrames = 8);
+    ~DescriptorSetCache();
+
+    DescriptorSetCache(const DescriptorSetCache&) = delete;
+    DescriptorSetCache& operator=(const DescriptorSetCache&) = delete;
+
+    // Thread-safe. The writes describe the binding contents, their pDstSet is ignored
+    const RHIDescriptorSet* GetOrCreate(const RHIDescriptorSetLayout* pLayout,
+                                        std::span<const RHIWriteDescriptorSet> writes);
+
+    // Call once per frame, uses the RHI frame serials to decide what is unused and retired
+    void EvictUnused();
+
+    // Drops every set, only valid while the GPU is idle
+    void Clear();
+
+    DescriptorSetCacheStats GetStats() const;
+    void ResetStats();
+
+private:
+    struct KeyHash {
+        size_t operator()(const std::vector<uint64>& key) const;
+    };
+
+    struct Entry {
+        Scope<RHIDescriptorSet> Set;
+        uint64 LastUsedFrame = 0;
+    };
+
+    void BuildKey(const RHIDescriptorSetLayout* pLayout, std::span<const RHIWriteDescriptorSet> writes);
+
+    Scope<RHIDescriptorPool> m_Pool;
+    uint32 m_MaxUnusedFrames = 0;
+
+    mutable std::mutex m_Mutex;
+    std::unordered_map<std::vector<uint64>, Entry, KeyHash> m_Entries;
+    std::vector<uint64> m_ScratchKey;
+    std::vector<RHIWriteDescriptorSet> m_ScratchWrites;
+    DescriptorSetCacheStats m_Stats;
+};
+
+} // namespace iGe
@@ -0,0 +1,485 @@
+module;
+#include "iGeSimd.h"
+
+module iGe.Renderer;
+import :MipGenerator;
+import :PixelConvert;
+
+namespace iGe
+{
+
+namespace
+{
+
+// =================================================================================================
+// Formats and weights
+// =================================================================================================
+
+// Texels are decoded to and encoded from float through the pixel conversion kernels
+struct MipFormat {
+    RHIFormat Format = RHIFormat::Unknown;
+    uint32 Channels = 0;
+    uint32 BytesPerTexel = 0;
+    bool Float = false; // Already float, filtered without a decode or encode step
+};
+
+bool GetMipFormat(RHIFormat format, MipFormat& mipFormat) {
+    switch (format) {
+        case RHIFormat::R8G8B8A8UNorm:
+        case RHIFormat::R8G8B8A8Srgb:
+        case RHIFormat::B8G8R8A8Srgb:
+            mipFormat = {format, 4, 4, false};
+            return true;
+        case RHIFormat::R16G16B16A16SFloat:
+            mipFormat = {format, 4, 8, false};
+            return true;
+        case RHIFormat::R32SFloat:
+            mipFormat = {format, 1, 4, true};
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Kaiser windowed sinc for a 2x reduction, taps sit at source texels 2x-2 .. 2x+3
+constexpr uint32 KaiserTapCount = 6;
+
+const std::array<float32, KaiserTapCount>& GetKaiserWeights() {
+    static const std::array<float32, KaiserTapCount> weights = [] {
+        constexpr float64 pi = std::numbers::pi;
+        constexpr float64 radius = 3.0;
+        constexpr float64 beta = 4.0;
+
+        const auto besselI0 = [](float64 x) {
+            float64 sum = 1.0;
+            float64 term = 1.0;
+            for (uint32 k = 1; k < 32; ++k) {
+                term *= (x / (2.0 * k)) * (x / (2.0 * k));
+                sum += term;
+            }
+            return sum;
+        };
+
+        std::array<float64, KaiserTapCount> raw{};
+        float64 total = 0.0;
+        for (uint32 k = 0; k < KaiserTapCount; ++k) {
+            // Distance from the destination texel centre in source texels, the sinc runs in destination texels
+            const float64 d = std::abs(static_cast<float64>(k) - 2.5);
+            const float64 sinc = std::sin(pi * d * 0.5) / (pi * d * 0.5);
+            const float64 window = besselI0(beta * std::sqrt(1.0 - (d / radius) * (d / radius))) / besselI0(beta);
+            raw[k] = sinc * window;
+            total += raw[k];
+        }
+
+        std::array<float32, KaiserTapCount> normalized{};
+        for (uint32 k = 0; k < KaiserTapCount; ++k) { normalized[k] = static_cast<float32>(raw[k] / total); }
+        return normalized;
+    }();
+    return weights;
+}
+
+// =================================================================================================
+// Scalar kernels
+// =================================================================================================
+
+void BoxRowScalar(const float32* row0, const float32* row1, uint32 srcWidth, float32* dst, uint32 dstWidth,
+                  uint32 channels, uint32 begin = 0) {
+    for (uint32 x = begin; x < dstWidth; ++x) {
+        const uint32 x0 = std::min(x * 2, srcWidth - 1) * channels;
+        const uint32 x1 = std::min(x * 2 + 1, srcWidth - 1) * channels;
+        for (uint32 c = 0; c < channels; ++c) {
+            dst[x * channels + c] = 0.25f * (row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c]);
+        }
+    }
+}
+
+void KaiserRowScalar(const float32* src, uint32 srcWidth, float32* dst, uint32 channels, const float32* weights,
+                     uint32 begin, uint32 end) {
+    for (uint32 x = begin; x < end; ++x) {
+        for (uint32 c = 0; c < channels; ++c) {
+            float32 sum = 0.0f;
+            for (uint32 k = 0; k < KaiserTapCount; ++k) {
+                const int64 sx = std::clamp<int64>(static_cast<int64>(x) * 2 - 2 + k, 0, srcWidth - 1);
+                sum += weights[k] * src[sx * channels + c];
+            }
+            dst[x * channels + c] = sum;
+        }
+    }
+}
+
+// Interior texels only, the caller covers the borders with the clamped scalar path
+uint32 KaiserRowInteriorScalar(const float32*, uint32, float32*, uint32, uint32, const float32*) { return 1; }
+
+void WeightedSumScalar(const float32* const* rows, const float32* weights, uint32 rowCount, float32* dst,
+                       uint32 count, uint32 begin = 0) {
+    for (uint32 i = begin; i < count; ++i) {
+        float32 sum = 0.0f;
+        for (uint32 r = 0; r < rowCount; ++r) { sum += weights[r] * rows[r][i]; }
+        dst[i] = sum;
+    }
+}
+
+void BoxRowDefault(const float32* row0, const float32* row1, uint32 srcWidth, float32* dst, uint32 dstWidth,
+                   uint32 channels) {
+    BoxRowScalar(row0, row1, srcWidth, dst, dstWidth, channels);
+}
+
+void WeightedSumDefault(const float32* const* rows, const float32* weights, uint32 rowCount, float32* dst,
+                        uint32 count) {
+    WeightedSumScalar(rows, weights, rowCount, dst, count);
+}
+
+// =================================================================================================
+// AVX2 kernels
+// =================================================================================================
+
+#if defined(IGE_SIMD_AVX2)
+
+// Gather the even floats of 16 consecutive values in order
+IGE_TARGET_AVX2 __m256 LoadEven8(const float32* src) {
+    const __m256 evens = _mm256_shuffle_ps(_mm256_loadu_ps(src), _mm256_loadu_ps(src + 8), 0x88);
+    return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(evens), 0xD8));
+}
+
+IGE_TARGET_AVX2 void BoxRowAVX2(const float32* row0, const float32* row1, uint32 srcWidth, float32* dst,
+                                uint32 dstWidth, uint32 channels) {
+    const __m256 quarter = _mm256_set1_ps(0.25f);
+
+    uint32 x = 0;
+    if (channels == 4) {
+        // Two destination texels from four source texels per row
+        for (; x + 2 <= dstWidth; x += 2) {
+            const float32* p0 = row0 + x * 8;
+            const float32* p1 = row1 + x * 8;
+            const __m256 s0 = _mm256_add_ps(_mm256_loadu_ps(p0), _mm256_loadu_ps(p1));
+            const __m256 s1 = _mm256_add_ps(_mm256_loadu_ps(p0 + 8), _mm256_loadu_ps(p1 + 8));
+            const __m256 left = _mm256_permute2f128_ps(s0, s1, 0x20);
+            const __m256 right = _mm256_permute2f128_ps(s0, s1, 0x31);
+            const __m256 sum = _mm256_add_ps(left, right);
+            _mm256_storeu_ps(dst + x * 4, _mm256_mul_ps(sum, quarter));
+        }
+    } else if (channels == 1) {
+        for (; x + 8 <= dstWidth; x += 8) {
+            const __m256 s0 = _mm256_add_ps(_mm256_loadu_ps(row0 + x * 2), _mm256_loadu_ps(row1 + x * 2));
+            const __m256 s1 = _mm256_add_ps(_mm256_loadu_ps(row0 + x * 2 + 8), _mm256_loadu_ps(row1 + x * 2 + 8));
+            const __m256 pairs = _mm256_hadd_ps(s0, s1);
+            const __m256 ordered = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(pairs), 0xD8));
+            _mm256_storeu_ps(dst + x, _mm256_mul_ps(ordered, quarter));
+        }
+    }
+    BoxRowScalar(row0, row1, srcWidth, dst, dstWidth, channels, x);
+}
+
+IGE_TARGET_AVX2 uint32 KaiserRowInteriorAVX2(const float32* src, uint32 srcWidth, float32* dst, uint32 dstWidth,
+                                             uint32 channels, const float32* weights) {
+    uint32 x = 1;
+    if (channels == 4) {
+        // Two texels per step, the last tap of the second one reads source texel 2x+5
+        const int64 lastStart = (static_cast<int64>(srcWidth) - 6) / 2;
+        for (; static_cast<int64>(x) <= lastStart && x + 2 <= dstWidth; x += 2) {
+            __m256 sum = _mm256_setzero_ps();
+            for (uint32 k = 0; k < KaiserTapCount; ++k) {
+                const float32* p = src + (x * 2 - 2 + k) * 4;
+                const __m256 first = _mm256_castps128_ps256(_mm_loadu_ps(p));
+                const __m256 texels = _mm256_insertf128_ps(first, _mm_loadu_ps(p + 8), 1);
+                sum = _mm256_fmadd_ps(_mm256_set1_ps(weights[k]), texels, sum);
+            }
+            _mm256_storeu_ps(dst + x * 4, sum);
+        }
+    } else if (channels == 1) {
+        // Eight texels per step through 16-wide even loads, reading up to source texel 2x+18
+        const int64 lastStart = (static_cast<int64>(srcWidth) - 19) / 2;
+        for (; static_cast<int64>(x) <= lastStart && x + 8 <= dstWidth; x += 8) {
+            __m256 sum = _mm256_setzero_ps();
+            for (uint32 k = 0; k < KaiserTapCount; ++k) {
+                sum = _mm256_fmadd_ps(_mm256_set1_ps(weights[k]), LoadEven8(src + x * 2 - 2 + k), sum);
+            }
+            _mm256_storeu_ps(dst + x, sum);
+        }
+    }
+    return x;
+}
+
+IGE_TARGET_AVX2 void WeightedSumAVX2(const float32* const* rows, const float32* weights, uint32 rowCount,
+                                     float32* dst, uint32 count) {
+    uint32 i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 sum = _mm256_mul_ps(_mm256_set1_ps(weights[0]), _mm256_loadu_ps(rows[0] + i));
+        for (uint32 r = 1; r < rowCount; ++r) {
+            sum = _mm256_fmadd_ps(_mm256_set1_ps(weights[r]), _mm256_loadu_ps(rows[r] + i), sum);
+        }
+        _mm256_storeu_ps(dst + i, sum);
+    }
+    WeightedSumScalar(rows, weights, rowCount, dst, count, i);
+}
+
+#endif
+
+// =================================================================================================
+// NEON kernels
+// =================================================================================================
+
+#if defined(IGE_SIMD_NEON)
+
+void BoxRowNEON(const float32* row0, const float32* row1, uint32 srcWidth, float32* dst, uint32 dstWidth,
+                uint32 channels) {
+    const float32x4_t quarter = vdupq_n_f32(0.25f);
+
+    uint32 x = 0;
+    if (channels == 4 && srcWidth >= 2) {
+        for (; x < dstWidth; ++x) {
+            const float32x4_t top = vaddq_f32(vld1q_f32(row0 + x * 8), vld1q_f32(row0 + x * 8 + 4));
+            const float32x4_t bottom = vaddq_f32(vld1q_f32(row1 + x * 8), vld1q_f32(row1 + x * 8 + 4));
+            vst1q_f32(dst + x * 4, vmulq_f32(vaddq_f32(top, bottom), quarter));
+        }
+    } else if (channels == 1) {
+        for (; x + 4 <= dstWidth; x += 4) {
+            const float32x4x2_t top = vld2q_f32(row0 + x * 2);
+            const float32x4x2_t bottom = vld2q_f32(row1 + x * 2);
+            const float32x4_t sum =
+                    vaddq_f32(vaddq_f32(top.val[0], top.val[1]), vaddq_f32(bottom.val[0], bottom.val[1]));
+            vst1q_f32(dst + x, vmulq_f32(sum, quarter));
+        }
+    }
+    BoxRowScalar(row0, row1, srcWidth, dst, dstWidth, channels, x);
+}
+
+uint32 KaiserRowInteriorNEON(const float32* src, uint32 srcWidth, float32* dst, uint32 dstWidth, uint32 channels,
+                             const float32* weights) {
+    uint32 x = 1;
+    if (channels == 4) {
+        const int64 lastStart = (static_cast<int64>(srcWidth) - 4) / 2;
+        for (; static_cast<int64>(x) <= lastStart && x < dstWidth; ++x) {
+            float32x4_t sum = vdupq_n_f32(0.0f);
+            for (uint32 k = 0; k < KaiserTapCount; ++k) {
+                sum = vfmaq_n_f32(sum, vld1q_f32(src + (x * 2 - 2 + k) * 4), weights[k]);
+            }
+            vst1q_f32(dst + x * 4, sum);
+        }
+    } else if (channels == 1) {
+        // Four texels per step through de-interleaving loads, reading up to source texel 2x+10
+        const int64 lastStart = (static_cast<int64>(srcWidth) - 11) / 2;
+        for (; static_cast<int64>(x) <= lastStart && x + 4 <= dstWidth; x += 4) {
+            float32x4_t sum = vdupq_n_f32(0.0f);
+            for (uint32 k = 0; k < KaiserTapCount; ++k) {
+                sum = vfmaq_n_f32(sum, vld2q_f32(src + x * 2 - 2 + k).val[0], weights[k]);
+            }
+            vst1q_f32(dst + x, sum);
+        }
+    }
+    return x;
+}
+
+void WeightedSumNEON(const float32* const* rows, const float32* weights, uint32 rowCount, float32* dst,
+                     uint32 count) {
+    uint32 i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t sum = vmulq_n_f32(vld1q_f32(rows[0] + i), weights[0]);
+        for (uint32 r = 1; r < rowCount; ++r) { sum = vfmaq_n_f32(sum, vld1q_f32(rows[r] + i), weights[r]); }
+        vst1q_f32(dst + i, sum);
+    }
+    WeightedSumScalar(rows, weights, rowCount, dst, count, i);
+}
+
+#endif
+
+// =================================================================================================
+// Kernel dispatch
+// =================================================================================================
+
+struct MipKernels {
+    void (*BoxRow)(const float32* row0, const float32* row1, uint32 srcWidth, float32* dst, uint32 dstWidth,
+                   uint32 channels);
+    uint32 (*KaiserRowInterior)(const float32* src, uint32 srcWidth, float32* dst, uint32 dstWidth, uint32 channels,
+                                const float32* weights);
+    void (*WeightedSum)(const float32* const* rows, const float32* weights, uint32 rowCount, float32* dst,
+                        uint32 count);
+};
+
+const MipKernels& GetMipKernels() {
+    static const MipKernels kernels = [] {
+        MipKernels selected = {BoxRowDefault, KaiserRowInteriorScalar, WeightedSumDefault};
+#if defined(IGE_SIMD_AVX2)
+        const auto& cpu = GetCPUFeatures();
+        if (cpu.AVX2 && cpu.FMA && cpu.F16C) {
+            selected = {BoxRowAVX2, KaiserRowInteriorAVX2, WeightedSumAVX2};
+        }
+#elif defined(IGE_SIMD_NEON)
+        selected = {BoxRowNEON, KaiserRowInteriorNEON, WeightedSumNEON};
+#endif
+        return selected;
+    }();
+    return kernels;
+}
+
+// =================================================================================================
+// Level filtering
+// =================================================================================================
+
+// Either the caller's image in its own format or a float level produced by the previous pass
+struct LevelSource {
+    const uint8* Data = nullptr;
+    uint64 RowPitch = 0;
+    uint32 Width = 0;
+    uint32 Height = 0;
+    bool Encoded = false;
+};
+
+struct LevelPass {
+    const MipFormat* Format = nullptr;
+    const MipKernels* Kernels = nullptr;
+    MipFilter Filter = MipFilter::Box;
+    LevelSource Source;
+    float32* Work = nullptr; // Float destination, also the next pass's source
+    MipLevelData* Level = nullptr;
+};
+
+const float32* FetchRow(const LevelPass& pass, uint32 y, float32* scratch) {
+    const uint8* row = pass.Source.Data + y * pass.Source.RowPitch;
+    if (!pass.Source.Encoded) { return reinterpret_cast<const float32*>(row); }
+
+    DecodeRowToFloat(pass.Format->Format, row, scratch, pass.Source.Width);
+    return scratch;
+}
+
+void KaiserRow(const LevelPass& pass, const float32* src, float32* dst, uint32 dstWidth) {
+    const uint32 channels = pass.Format->Channels;
+    const float32* weights = GetKaiserWeights().data();
+    const uint32 srcWidth = pass.Source.Width;
+
+    KaiserRowScalar(src, srcWidth, dst, channels, weights, 0, std::min(1u, dstWidth));
+    const uint32 end = pass.Kernels->KaiserRowInterior(src, srcWidth, dst, dstWidth, channels, weights);
+    KaiserRowScalar(src, srcWidth, dst, channels, weights, std::min(end, dstWidth), dstWidth);
+}
+
+void FilterTile(const LevelPass& pass, uint32 y0, uint32 y1) {
+    const auto& source = pass.Source;
+    const uint32 channels = pass.Format->Channels;
+    const uint32 dstWidth = pass.Level->Width;
+    const uint64 srcValues = static_cast<uint64>(source.Width) * channels;
+    const uint64 dstValues = static_cast<uint64>(dstWidth) * channels;
+
+    if (pass.Filter == MipFilter::Box) {
+        std::vector<float32> scratch(source.Encoded ? srcValues * 2 : 0);
+        for (uint32 y = y0; y < y1; ++y) {
+            const uint32 sy0 = std::min(y * 2, source.Height - 1);
+            const uint32 sy1 = std::min(y * 2 + 1, source.Height - 1);
+            const float32* row0 = FetchRow(pass, sy0, scratch.data());
+            const float32* row1 = sy1 == sy0 ? row0 : FetchRow(pass, sy1, scratch.data() + srcValues);
+            pass.Kernels->BoxRow(row0, row1, source.Width, pass.Work + y * dstValues, dstWidth, channels);
+        }
+        return;
+    }
+
+    // Horizontal pass over every source row the tile touches, then the vertical taps read those rows
+    const uint32 rowCount = (y1 - y0) * 2 + KaiserTapCount - 2;
+    std::vector<float32> horizontal(rowCount * dstValues);
+    std::vector<float32> scratch(source.Encoded ? srcValues : 0);
+    for (uint32 j = 0; j < rowCount; ++j) {
+        const int64 sy = std::clamp<int64>(static_cast<int64>(y0) * 2 - 2 + j, 0, source.Height - 1);
+        KaiserRow(pass, FetchRow(pass, static_cast<uint32>(sy), scratch.data()), horizontal.data() + j * dstValues,
+                  dstWidth);
+    }
+
+    const float32* weights = GetKaiserWeights().data();
+    for (uint32 y = y0; y < y1; ++y) {
+        std::array<const float32*, KaiserTapCount> rows;
+        for (uint32 k = 0; k < KaiserTapCount; ++k) { rows[k] = horizontal.data() + ((y - y0) * 2 + k) * dstValues; }
+        pass.Kernels->WeightedSum(rows.data(), weights, KaiserTapCount, pass.Work + y * dstValues,
+                                  static_cast<uint32>(dstValues));
+    }
+}
+
+void EncodeTile(const LevelPass& pass, uint32 y0, uint32 y1) {
+    auto& level = *pass.Level;
+    const uint64 values = static_cast<uint64>(level.Width) * pass.Format->Channels;
+    for (uint32 y = y0; y < y1; ++y) {
+        EncodeRowFromFloat(pass.Format->Format, pass.Work + y * values, level.Data.data() + y * level.RowPitch,
+                           level.Width);
+    }
+}
+
+} // namespace
+
+// =================================================================================================
+// MipGenerator
+// =================================================================================================
+
+uint32 GetMipLevelCount(uint32 width, uint32 height) {
+    return static_cast<uint32>(std::bit_width(std::max({width, height, 1u})));
+}
+
+MipGenerator::MipGenerator(ThreadPool* pThreadPool) : m_ThreadPool(pThreadPool) {
+    if (!m_ThreadPool) {
+        m_OwnedThreadPool = CreateScope<ThreadPool>();
+        m_ThreadPool = m_OwnedThreadPool.get();
+    }
+}
+
+MipGenerator::~MipGenerator() = default;
+
+bool MipGenerator::IsSupportedFormat(RHIFormat format) {
+    MipFormat mipFormat;
+    return GetMipFormat(format, mipFormat);
+}
+
+std::vector<MipLevelData> MipGenerator::Generate(RHIFormat format, const uint8* source, uint32 width, uint32 height,
+                                                 uint64 sourceRowPitch, const MipGenerationSettings& settings) const {
+    MipFormat mipFormat;
+    if (!GetMipFormat(format, mipFormat)) {
+        Internal::LogError("MipGenerator: Unsupported format {0}", static_cast<uint32>(format));
+        return {};
+    }
+    if (!source || width == 0 || height == 0) { return {}; }
+
+    uint32 levelCount = GetMipLevelCount(width, height);
+    if (settings.MaxMipLevels != 0) { levelCount = std::min(levelCount, settings.MaxMipLevels); }
+    if (levelCount <= 1) { return {}; }
+
+    // Float sources are filtered in place, the other formats are decoded row by row inside the tiles
+    LevelPass pass;
+    pass.Format = &mipFormat;
+    pass.Kernels = &GetMipKernels();
+    pass.Filter = settings.Filter;
+    pass.Source = {source, sourceRowPitch, width, height, !mipFormat.Float};
+
+    std::vector<MipLevelData> levels(levelCount - 1);
+    std::vector<float32> previous;
+    std::vector<float32> current;
+    for (auto& level: levels) {
+        level.Width = std::max(1u, pass.Source.Width / 2);
+        level.Height = std::max(1u, pass.Source.Height / 2);
+        level.RowPitch = static_cast<uint64>(level.Width) * mipFormat.BytesPerTexel;
+        level.Data.resize(level.RowPitch * level.Height);
+
+        const uint64 workValues = static_cast<uint64>(level.Width) * level.Height * mipFormat.Channels;
+        if (mipFormat.Float) {
+            pass.Work = reinterpret_cast<float32*>(level.Data.data());
+        } else {
+            current.resize(workValues);
+            pass.Work = current.data();
+        }
+        pass.Level = &level;
+
+        // Row tiles big enough to amortize the task overhead, small enough to balance across the workers
+        const uint32 targetTiles = std::max(1u, m_ThreadPool->GetWorkerCount() * 4);
+        const uint32 minRows = std::max(1u, (16384 + level.Width - 1) / level.Width);
+        const uint32 tileRows = std::max({(level.Height + targetTiles - 1) / targetTiles, minRows, 8u});
+        const uint32 tileCount = (level.Height + tileRows - 1) / tileRows;
+
+        m_ThreadPool->ParallelFor(tileCount, [&](uint32 tile) {
+            const uint32 y0 = tile * tileRows;
+            const uint32 y1 = std::min(y0 + tileRows, level.Height);
+            FilterTile(pass, y0, y1);
+            if (!mipFormat.Float) { EncodeTile(pass, y0, y1); }
+        });
+
+        pass.Source = {reinterpret_cast<const uint8*>(pass.Work), level.Width * mipFormat.Channels * sizeof(float32),
+                       level.Width, level.Height, false};
+        std::swap(previous, current);
+    }
+
+    return levels;
+}
+
+} // namespace iGe
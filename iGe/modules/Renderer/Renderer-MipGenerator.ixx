@@ -0,0 +1,58 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.Renderer:MipGenerator;
+import iGe.RHI;
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Mip Generation Settings
+// =================================================================================================
+
+export enum class MipFilter : uint8 {
+    Box,    // 2x2 average, cheapest
+    Kaiser, // 6-tap Kaiser windowed sinc, sharper minification without ringing halos
+};
+
+export struct MipGenerationSettings {
+    MipFilter Filter = MipFilter::Box;
+    uint32 MaxMipLevels = 0; // Counts level 0, zero keeps the full chain
+};
+
+export struct MipLevelData {
+    uint32 Width = 0;
+    uint32 Height = 0;
+    uint64 RowPitch = 0; // Tightly packed
+    std::vector<uint8> Data;
+};
+
+// Full chain length down to 1x1
+export IGE_API uint32 GetMipLevelCount(uint32 width, uint32 height);
+
+// =================================================================================================
+// MipGenerator
+// =================================================================================================
+
+// CPU mip chain generation for R8G8B8A8, B8G8R8A8Srgb, R16G16B16A16SFloat and R32SFloat.
+// Levels are filtered in float and sRGB formats are filtered in linear space. Each level is split into row tiles
+// that are filtered and encoded on the thread pool, using AVX2/F16C or NEON kernels when the CPU has them.
+export class IGE_API MipGenerator {
+public:
+    explicit MipGenerator(ThreadPool* pThreadPool = nullptr);
+    ~MipGenerator();
+
+    static bool IsSupportedFormat(RHIFormat format);
+
+    // Returns levels 1..N-1, level 0 is the source image itself
+    std::vector<MipLevelData> Generate(RHIFormat format, const uint8* source, uint32 width, uint32 height,
+                                       uint64 sourceRowPitch, const MipGenerationSettings& settings = {}) const;
+
+private:
+    ThreadPool* m_ThreadPool = nullptr;
+    Scope<ThreadPool> m_OwnedThreadPool;
+};
+
+} // namespace iGe
@@ -0,0 +1,856 @@
+module;
+#include "iGeSimd.h"
+
+module iGe.Renderer;
+import :PixelConvert;
+
+namespace iGe
+{
+
+namespace
+{
+
+// =================================================================================================
+// Pixel layouts
+// =================================================================================================
+
+enum class ChannelType : uint8 {
+    None,
+    UNorm8,
+    SNorm8,
+    UInt8,
+    SInt8,
+    UNorm16,
+    SNorm16,
+    UInt16,
+    SInt16,
+    Float16,
+    Float32,
+    UInt32,
+    SInt32,
+};
+
+struct PixelLayout {
+    ChannelType Type = ChannelType::None;
+    uint32 Channels = 0;
+    bool Srgb = false;   // Colour channels are sRGB encoded, alpha never is
+    bool SwapRB = false; // Stored as BGRA
+};
+
+constexpr PixelLayout BuildPixelLayout(RHIFormat format) {
+    switch (format) {
+        case RHIFormat::R8Srgb:
+            return {ChannelType::UNorm8, 1, true};
+        case RHIFormat::R8G8Srgb:
+            return {ChannelType::UNorm8, 2, true};
+        case RHIFormat::R8G8B8Srgb:
+            return {ChannelType::UNorm8, 3, true};
+        case RHIFormat::R8G8B8A8Srgb:
+            return {ChannelType::UNorm8, 4, true};
+        case RHIFormat::B8G8R8A8Srgb:
+            return {ChannelType::UNorm8, 4, true, true};
+
+        case RHIFormat::R16SFloat:
+            return {ChannelType::Float16, 1};
+        case RHIFormat::R16G16SFloat:
+            return {ChannelType::Float16, 2};
+        case RHIFormat::R16G16B16SFloat:
+            return {ChannelType::Float16, 3};
+        case RHIFormat::R16G16B16A16SFloat:
+            return {ChannelType::Float16, 4};
+        case RHIFormat::R32SFloat:
+            return {ChannelType::Float32, 1};
+        case RHIFormat::R32G32SFloat:
+            return {ChannelType::Float32, 2};
+        case RHIFormat::R32G32B32SFloat:
+            return {ChannelType::Float32, 3};
+        case RHIFormat::R32G32B32A32SFloat:
+            return {ChannelType::Float32, 4};
+
+        case RHIFormat::R8UNorm:
+            return {ChannelType::UNorm8, 1};
+        case RHIFormat::R8G8UNorm:
+            return {ChannelType::UNorm8, 2};
+        case RHIFormat::R8G8B8UNorm:
+            return {ChannelType::UNorm8, 3};
+        case RHIFormat::R8G8B8A8UNorm:
+            return {ChannelType::UNorm8, 4};
+        case RHIFormat::R16UNorm:
+            return {ChannelType::UNorm16, 1};
+        case RHIFormat::R16G16UNorm:
+            return {ChannelType::UNorm16, 2};
+        case RHIFormat::R16G16B16UNorm:
+            return {ChannelType::UNorm16, 3};
+        case RHIFormat::R16G16B16A16UNorm:
+            return {ChannelType::UNorm16, 4};
+
+        case RHIFormat::R8SNorm:
+            return {ChannelType::SNorm8, 1};
+        case RHIFormat::R8G8SNorm:
+            return {ChannelType::SNorm8, 2};
+        case RHIFormat::R8G8B8SNorm:
+            return {ChannelType::SNorm8, 3};
+        case RHIFormat::R8G8B8A8SNorm:
+            return {ChannelType::SNorm8, 4};
+        case RHIFormat::R16SNorm:
+            return {ChannelType::SNorm16, 1};
+        case RHIFormat::R16G16SNorm:
+            return {ChannelType::SNorm16, 2};
+        case RHIFormat::R16G16B16SNorm:
+            return {ChannelType::SNorm16, 3};
+        case RHIFormat::R16G16B16A16SNorm:
+            return {ChannelType::SNorm16, 4};
+
+        case RHIFormat::R8UInt:
+            return {ChannelType::UInt8, 1};
+        case RHIFormat::R8G8UInt:
+            return {ChannelType::UInt8, 2};
+        case RHIFormat::R8G8B8UInt:
+            return {ChannelType::UInt8, 3};
+        case RHIFormat::R8G8B8A8UInt:
+            return {ChannelType::UInt8, 4};
+        case RHIFormat::R16UInt:
+            return {ChannelType::UInt16, 1};
+        case RHIFormat::R16G16UInt:
+            return {ChannelType::UInt16, 2};
+        case RHIFormat::R16G16B16UInt:
+            return {ChannelType::UInt16, 3};
+        case RHIFormat::R16G16B16A16UInt:
+            return {ChannelType::UInt16, 4};
+        case RHIFormat::R32UInt:
+            return {ChannelType::UInt32, 1};
+        case RHIFormat::R32G32UInt:
+            return {ChannelType::UInt32, 2};
+        case RHIFormat::R32G32B32UInt:
+            return {ChannelType::UInt32, 3};
+        case RHIFormat::R32G32B32A32UInt:
+            return {ChannelType::UInt32, 4};
+
+        case RHIFormat::R8SInt:
+            return {ChannelType::SInt8, 1};
+        case RHIFormat::R8G8SInt:
+            return {ChannelType::SInt8, 2};
+        case RHIFormat::R8G8B8SInt:
+            return {ChannelType::SInt8, 3};
+        case RHIFormat::R8G8B8A8SInt:
+            return {ChannelType::SInt8, 4};
+        case RHIFormat::R16SInt:
+            return {ChannelType::SInt16, 1};
+        case RHIFormat::R16G16SInt:
+            return {ChannelType::SInt16, 2};
+        case RHIFormat::R16G16B16SInt:
+            return {ChannelType::SInt16, 3};
+        case RHIFormat::R16G16B16A16SInt:
+            return {ChannelType::SInt16, 4};
+        case RHIFormat::R32SInt:
+            return {ChannelType::SInt32, 1};
+        case RHIFormat::R32G32SInt:
+            return {ChannelType::SInt32, 2};
+        case RHIFormat::R32G32B32SInt:
+            return {ChannelType::SInt32, 3};
+        case RHIFormat::R32G32B32A32SInt:
+            return {ChannelType::SInt32, 4};
+
+        default:
+            return {};
+    }
+}
+
+constexpr auto s_PixelLayouts = [] {
+    std::array<PixelLayout, static_cast<uint32>(RHIFormat::Count)> layouts{};
+    for (uint32 i = 0; i < layouts.size(); ++i) { layouts[i] = BuildPixelLayout(static_cast<RHIFormat>(i)); }
+    return layouts;
+}();
+
+const PixelLayout& GetPixelLayout(RHIFormat format) {
+    static constexpr PixelLayout unknown{};
+    const auto index = static_cast<uint32>(format);
+    return index < s_PixelLayouts.size() ? s_PixelLayouts[index] : unknown;
+}
+
+bool IsIntegerType(ChannelType type) {
+    switch (type) {
+        case ChannelType::UInt8:
+        case ChannelType::SInt8:
+        case ChannelType::UInt16:
+        case ChannelType::SInt16:
+        case ChannelType::UInt32:
+        case ChannelType::SInt32:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// 32-bit integers do not survive the float stage
+bool HasFloatPath(const PixelLayout& layout) {
+    return layout.Type != ChannelType::None && layout.Type != ChannelType::UInt32 &&
+           layout.Type != ChannelType::SInt32;
+}
+
+// =================================================================================================
+// sRGB tables
+// =================================================================================================
+
+// 14-bit linear input keeps the table lookup within half a step of the exact sRGB encode
+constexpr uint32 LinearToSrgbTableSize = 1u << 14;
+
+struct SrgbTables {
+    alignas(32) std::array<float32, 256> ToLinear;
+    // Padded so a 32-bit gather at the last entry stays inside the table
+    alignas(32) std::array<uint8, LinearToSrgbTableSize + 4> ToSrgb;
+};
+
+const SrgbTables& GetSrgbTables() {
+    static const SrgbTables tables = [] {
+        SrgbTables values{};
+        for (uint32 i = 0; i < 256; ++i) {
+            const float64 c = i / 255.0;
+            values.ToLinear[i] = static_cast<float32>(c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4));
+        }
+        for (uint32 i = 0; i < LinearToSrgbTableSize; ++i) {
+            const float64 l = static_cast<float64>(i) / (LinearToSrgbTableSize - 1);
+            const float64 c = l <= 0.0031308 ? l * 12.92 : 1.055 * std::pow(l, 1.0 / 2.4) - 0.055;
+            values.ToSrgb[i] = static_cast<uint8>(c * 255.0 + 0.5);
+        }
+        return values;
+    }();
+    return tables;
+}
+
+// =================================================================================================
+// Scalar kernels
+// =================================================================================================
+
+// Only four-channel data has an alpha channel that stays linear
+bool IsSrgbValue(uint32 index, uint32 channels) { return channels != 4 || (index & 3) != 3; }
+
+uint32 SwizzleIndex(uint32 index, bool swapRB) {
+    if (!swapRB || (index & 1)) { return index; }
+    return index ^ 2;
+}
+
+void DecodeUNorm8Scalar(const uint8* src, float32* dst, uint32 valueCount, uint32 channels, bool srgb,
+                        bool swapRB) {
+    const auto& toLinear = GetSrgbTables().ToLinear;
+    for (uint32 i = 0; i < valueCount; ++i) {
+        const uint8 value = src[SwizzleIndex(i, swapRB)];
+        dst[i] = srgb && IsSrgbValue(i, channels) ? toLinear[value] : value * (1.0f / 255.0f);
+    }
+}
+
+void EncodeUNorm8Scalar(const float32* src, uint8* dst, uint32 valueCount, uint32 channels, bool srgb,
+                        bool swapRB) {
+    const auto& toSrgb = GetSrgbTables().ToSrgb;
+    for (uint32 i = 0; i < valueCount; ++i) {
+        const float32 value = std::clamp(src[i], 0.0f, 1.0f);
+        dst[SwizzleIndex(i, swapRB)] = srgb && IsSrgbValue(i, channels)
+                                               ? toSrgb[static_cast<uint32>(value * (LinearToSrgbTableSize - 1) + 0.5f)]
+                                               : static_cast<uint8>(value * 255.0f + 0.5f);
+    }
+}
+
+void DecodeHalfScalar(const uint16* src, float32* dst, uint32 valueCount) {
+    for (uint32 i = 0; i < valueCount; ++i) { dst[i] = HalfToFloat(src[i]); }
+}
+
+void EncodeHalfScalar(const float32* src, uint16* dst, uint32 valueCount) {
+    for (uint32 i = 0; i < valueCount; ++i) { dst[i] = FloatToHalf(src[i]); }
+}
+
+void SwapRB8Scalar(const uint8* src, uint8* dst, uint32 texelCount) {
+    for (uint32 i = 0; i < texelCount; ++i) {
+        const uint8 r = src[i * 4 + 0];
+        dst[i * 4 + 0] = src[i * 4 + 2];
+        dst[i * 4 + 1] = src[i * 4 + 1];
+        dst[i * 4 + 2] = r;
+        dst[i * 4 + 3] = src[i * 4 + 3];
+    }
+}
+
+void PadRGB8Scalar(const uint8* src, uint8* dst, uint32 texelCount, uint8 alpha) {
+    for (uint32 i = 0; i < texelCount; ++i) {
+        dst[i * 4 + 0] = src[i * 3 + 0];
+        dst[i * 4 + 1] = src[i * 3 + 1];
+        dst[i * 4 + 2] = src[i * 3 + 2];
+        dst[i * 4 + 3] = alpha;
+    }
+}
+
+void DropAlpha8Scalar(const uint8* src, uint8* dst, uint32 texelCount) {
+    for (uint32 i = 0; i < texelCount; ++i) {
+        dst[i * 3 + 0] = src[i * 4 + 0];
+        dst[i * 3 + 1] = src[i * 4 + 1];
+        dst[i * 3 + 2] = src[i * 4 + 2];
+    }
+}
+
+// =================================================================================================
+// AVX2 kernels
+// =================================================================================================
+
+#if defined(IGE_SIMD_AVX2)
+
+IGE_TARGET_AVX2 void DecodeUNorm8AVX2(const uint8* src, float32* dst, uint32 valueCount, uint32 channels,
+                                      bool srgb, bool swapRB) {
+    const __m256 scale = _mm256_set1_ps(1.0f / 255.0f);
+    const __m128i swizzle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const float32* table = GetSrgbTables().ToLinear.data();
+
+    uint32 i = 0;
+    for (; i + 8 <= valueCount; i += 8) {
+        __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+        if (swapRB) { bytes = _mm_shuffle_epi8(bytes, swizzle); }
+
+        const __m256i values = _mm256_cvtepu8_epi32(bytes);
+        __m256 result = _mm256_mul_ps(_mm256_cvtepi32_ps(values), scale);
+        if (srgb) {
+            const __m256 linear = _mm256_i32gather_ps(table, values, 4);
+            result = channels == 4 ? _mm256_blend_ps(linear, result, 0x88) : linear;
+        }
+        _mm256_storeu_ps(dst + i, result);
+    }
+    DecodeUNorm8Scalar(src + i, dst + i, valueCount - i, channels, srgb, swapRB);
+}
+
+IGE_TARGET_AVX2 __m256i EncodeUNorm8x8(__m256 value, uint32 channels, bool srgb, const int32* table) {
+    // max before min so NaN lands on zero
+    value = _mm256_min_ps(_mm256_max_ps(value, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+    const __m256 half = _mm256_set1_ps(0.5f);
+    __m256i result = _mm256_cvttps_epi32(_mm256_fmadd_ps(value, _mm256_set1_ps(255.0f), half));
+    if (srgb) {
+        const __m256 tableScale = _mm256_set1_ps(static_cast<float32>(LinearToSrgbTableSize - 1));
+        const __m256i index = _mm256_cvttps_epi32(_mm256_fmadd_ps(value, tableScale, half));
+        const __m256i encoded = _mm256_and_si256(_mm256_i32gather_epi32(table, index, 1), _mm256_set1_epi32(0xFF));
+        result = channels == 4 ? _mm256_blend_epi32(encoded, result, 0x88) : encoded;
+    }
+    return result;
+}
+
+IGE_TARGET_AVX2 void EncodeUNorm8AVX2(const float32* src, uint8* dst, uint32 valueCount, uint32 channels,
+                                      bool srgb, bool swapRB) {
+    const auto* table = reinterpret_cast<const int32*>(GetSrgbTables().ToSrgb.data());
+    const __m128i swizzle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+    uint32 i = 0;
+    for (; i + 16 <= valueCount; i += 16) {
+        const __m256i a = EncodeUNorm8x8(_mm256_loadu_ps(src + i), channels, srgb, table);
+        const __m256i b = EncodeUNorm8x8(_mm256_loadu_ps(src + i + 8), channels, srgb, table);
+        const __m256i words = _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b), 0xD8);
+        __m128i bytes = _mm_packus_epi16(_mm256_castsi256_si128(words), _mm256_extracti128_si256(words, 1));
+        if (swapRB) { bytes = _mm_shuffle_epi8(bytes, swizzle); }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), bytes);
+    }
+    EncodeUNorm8Scalar(src + i, dst + i, valueCount - i, channels, srgb, swapRB);
+}
+
+IGE_TARGET_AVX2 void DecodeHalfAVX2(const uint16* src, float32* dst, uint32 valueCount) {
+    uint32 i = 0;
+    for (; i + 8 <= valueCount; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+    }
+    DecodeHalfScalar(src + i, dst + i, valueCount - i);
+}
+
+IGE_TARGET_AVX2 void EncodeHalfAVX2(const float32* src, uint16* dst, uint32 valueCount) {
+    uint32 i = 0;
+    for (; i + 8 <= valueCount; i += 8) {
+        const __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), half);
+    }
+    EncodeHalfScalar(src + i, dst + i, valueCount - i);
+}
+
+IGE_TARGET_AVX2 void SwapRB8AVX2(const uint8* src, uint8* dst, uint32 texelCount) {
+    const __m256i swizzle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, //
+                                             2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    uint32 i = 0;
+    for (; i + 8 <= texelCount; i += 8) {
+        const __m256i texels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_shuffle_epi8(texels, swizzle));
+    }
+    SwapRB8Scalar(src + i * 4, dst + i * 4, texelCount - i);
+}
+
+// Four texels per step, the 16-byte load reads ahead so the loop stops six texels before the end
+IGE_TARGET_AVX2 void PadRGB8AVX2(const uint8* src, uint8* dst, uint32 texelCount, uint8 alpha) {
+    const __m128i spread = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i alphaBits = _mm_set1_epi32(static_cast<int32>(static_cast<uint32>(alpha) << 24));
+
+    uint32 i = 0;
+    for (; i + 6 <= texelCount; i += 4) {
+        const __m128i texels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3));
+        const __m128i padded = _mm_or_si128(_mm_shuffle_epi8(texels, spread), alphaBits);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), padded);
+    }
+    PadRGB8Scalar(src + i * 3, dst + i * 4, texelCount - i, alpha);
+}
+
+// Four texels per step, the 16-byte store runs ahead so the loop stops six texels before the end
+IGE_TARGET_AVX2 void DropAlpha8AVX2(const uint8* src, uint8* dst, uint32 texelCount) {
+    const __m128i pack = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+
+    uint32 i = 0;
+    for (; i + 6 <= texelCount; i += 4) {
+        const __m128i texels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 3), _mm_shuffle_epi8(texels, pack));
+    }
+    DropAlpha8Scalar(src + i * 4, dst + i * 3, texelCount - i);
+}
+
+#endif
+
+// =================================================================================================
+// NEON kernels
+// =================================================================================================
+
+#if defined(IGE_SIMD_NEON)
+
+// NEON has no gather, sRGB and swizzled data go through the scalar table lookups
+void DecodeUNorm8NEON(const uint8* src, float32* dst, uint32 valueCount, uint32 channels, bool srgb, bool swapRB) {
+    if (srgb || swapRB) {
+        DecodeUNorm8Scalar(src, dst, valueCount, channels, srgb, swapRB);
+        return;
+    }
+
+    const float32x4_t scale = vdupq_n_f32(1.0f / 255.0f);
+    uint32 i = 0;
+    for (; i + 8 <= valueCount; i += 8) {
+        const uint16x8_t values = vmovl_u8(vld1_u8(src + i));
+        vst1q_f32(dst + i, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(values))), scale));
+        vst1q_f32(dst + i + 4, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(values))), scale));
+    }
+    DecodeUNorm8Scalar(src + i, dst + i, valueCount - i, channels, srgb, swapRB);
+}
+
+void EncodeUNorm8NEON(const float32* src, uint8* dst, uint32 valueCount, uint32 channels, bool srgb, bool swapRB) {
+    if (srgb || swapRB) {
+        EncodeUNorm8Scalar(src, dst, valueCount, channels, srgb, swapRB);
+        return;
+    }
+
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t scale = vdupq_n_f32(255.0f);
+    const float32x4_t half = vdupq_n_f32(0.5f);
+
+    uint32 i = 0;
+    for (; i + 8 <= valueCount; i += 8) {
+        const float32x4_t lo = vminq_f32(vmaxq_f32(vld1q_f32(src + i), zero), one);
+        const float32x4_t hi = vminq_f32(vmaxq_f32(vld1q_f32(src + i + 4), zero), one);
+        const uint32x4_t loInt = vcvtq_u32_f32(vmlaq_f32(half, lo, scale));
+        const uint32x4_t hiInt = vcvtq_u32_f32(vmlaq_f32(half, hi, scale));
+        vst1_u8(dst + i, vmovn_u16(vcombine_u16(vmovn_u32(loInt), vmovn_u32(hiInt))));
+    }
+    EncodeUNorm8Scalar(src + i, dst + i, valueCount - i, channels, srgb, swapRB);
+}
+
+void DecodeHalfNEON(const uint16* src, float32* dst, uint32 valueCount) {
+    uint32 i = 0;
+    for (; i + 4 <= valueCount; i += 4) { vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i)))); }
+    DecodeHalfScalar(src + i, dst + i, valueCount - i);
+}
+
+void EncodeHalfNEON(const float32* src, uint16* dst, uint32 valueCount) {
+    uint32 i = 0;
+    for (; i + 4 <= valueCount; i += 4) { vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i)))); }
+    EncodeHalfScalar(src + i, dst + i, valueCount - i);
+}
+
+void SwapRB8NEON(const uint8* src, uint8* dst, uint32 texelCount) {
+    uint32 i = 0;
+    for (; i + 16 <= texelCount; i += 16) {
+        uint8x16x4_t texels = vld4q_u8(src + i * 4);
+        std::swap(texels.val[0], texels.val[2]);
+        vst4q_u8(dst + i * 4, texels);
+    }
+    SwapRB8Scalar(src + i * 4, dst + i * 4, texelCount - i);
+}
+
+void PadRGB8NEON(const uint8* src, uint8* dst, uint32 texelCount, uint8 alpha) {
+    uint32 i = 0;
+    for (; i + 16 <= texelCount; i += 16) {
+        const uint8x16x3_t rgb = vld3q_u8(src + i * 3);
+        const uint8x16x4_t rgba = {{rgb.val[0], rgb.val[1], rgb.val[2], vdupq_n_u8(alpha)}};
+        vst4q_u8(dst + i * 4, rgba);
+    }
+    PadRGB8Scalar(src + i * 3, dst + i * 4, texelCount - i, alpha);
+}
+
+void DropAlpha8NEON(const uint8* src, uint8* dst, uint32 texelCount) {
+    uint32 i = 0;
+    for (; i + 16 <= texelCount; i += 16) {
+        const uint8x16x4_t rgba = vld4q_u8(src + i * 4);
+        const uint8x16x3_t rgb = {{rgba.val[0], rgba.val[1], rgba.val[2]}};
+        vst3q_u8(dst + i * 3, rgb);
+    }
+    DropAlpha8Scalar(src + i * 4, dst + i * 3, texelCount - i);
+}
+
+#endif
+
+// =================================================================================================
+// Kernel dispatch
+// =================================================================================================
+
+struct ConvertKernels {
+    void (*DecodeUNorm8)(const uint8* src, float32* dst, uint32 valueCount, uint32 channels, bool srgb, bool swapRB);
+    void (*EncodeUNorm8)(const float32* src, uint8* dst, uint32 valueCount, uint32 channels, bool srgb, bool swapRB);
+    void (*DecodeHalf)(const uint16* src, float32* dst, uint32 valueCount);
+    void (*EncodeHalf)(const float32* src, uint16* dst, uint32 valueCount);
+    void (*SwapRB8)(const uint8* src, uint8* dst, uint32 texelCount);
+    void (*PadRGB8)(const uint8* src, uint8* dst, uint32 texelCount, uint8 alpha);
+    void (*DropAlpha8)(const uint8* src, uint8* dst, uint32 texelCount);
+};
+
+const ConvertKernels& GetConvertKernels() {
+    static const ConvertKernels kernels = [] {
+        ConvertKernels selected = {DecodeUNorm8Scalar, EncodeUNorm8Scalar, DecodeHalfScalar, EncodeHalfScalar,
+                                   SwapRB8Scalar,      PadRGB8Scalar,      DropAlpha8Scalar};
+#if defined(IGE_SIMD_AVX2)
+        const auto& cpu = GetCPUFeatures();
+        if (cpu.AVX2 && cpu.FMA && cpu.F16C) {
+            selected = {DecodeUNorm8AVX2, EncodeUNorm8AVX2, DecodeHalfAVX2, EncodeHalfAVX2,
+                        SwapRB8AVX2,      PadRGB8AVX2,      DropAlpha8AVX2};
+        }
+#elif defined(IGE_SIMD_NEON)
+        selected = {DecodeUNorm8NEON, EncodeUNorm8NEON, DecodeHalfNEON, EncodeHalfNEON,
+                    SwapRB8NEON,      PadRGB8NEON,      DropAlpha8NEON};
+#endif
+        return selected;
+    }();
+    return kernels;
+}
+
+// =================================================================================================
+// Float stage
+// =================================================================================================
+
+template<typename T>
+void DecodeIntegers(const void* src, float32* dst, uint32 valueCount, float32 scale, float32 minimum) {
+    const auto* values = static_cast<const T*>(src);
+    for (uint32 i = 0; i < valueCount; ++i) { dst[i] = std::max(static_cast<float32>(values[i]) * scale, minimum); }
+}
+
+template<typename T>
+void EncodeIntegers(const float32* src, void* dst, uint32 valueCount, float32 scale) {
+    constexpr float32 low = static_cast<float32>(std::numeric_limits<T>::min());
+    constexpr float32 high = static_cast<float32>(std::numeric_limits<T>::max());
+    auto* values = static_cast<T*>(dst);
+    for (uint32 i = 0; i < valueCount; ++i) {
+        values[i] = static_cast<T>(std::nearbyint(std::clamp(src[i] * scale, low, high)));
+    }
+}
+
+void DecodeValues(const PixelLayout& layout, const void* src, float32* dst, uint32 texelCount) {
+    const auto& kernels = GetConvertKernels();
+    const uint32 valueCount = texelCount * layout.Channels;
+    constexpr float32 noMinimum = -std::numeric_limits<float32>::max();
+
+    switch (layout.Type) {
+        case ChannelType::UNorm8:
+            kernels.DecodeUNorm8(static_cast<const uint8*>(src), dst, valueCount, layout.Channels, layout.Srgb,
+                                 layout.SwapRB);
+            break;
+        case ChannelType::Float16:
+            kernels.DecodeHalf(static_cast<const uint16*>(src), dst, valueCount);
+            break;
+        case ChannelType::Float32:
+            std::memcpy(dst, src, valueCount * sizeof(float32));
+            break;
+        case ChannelType::SNorm8:
+            DecodeIntegers<int8>(src, dst, valueCount, 1.0f / 127.0f, -1.0f);
+            break;
+        case ChannelType::UNorm16:
+            DecodeIntegers<uint16>(src, dst, valueCount, 1.0f / 65535.0f, 0.0f);
+            break;
+        case ChannelType::SNorm16:
+            DecodeIntegers<int16>(src, dst, valueCount, 1.0f / 32767.0f, -1.0f);
+            break;
+        case ChannelType::UInt8:
+            DecodeIntegers<uint8>(src, dst, valueCount, 1.0f, noMinimum);
+            break;
+        case ChannelType::SInt8:
+            DecodeIntegers<int8>(src, dst, valueCount, 1.0f, noMinimum);
+            break;
+        case ChannelType::UInt16:
+            DecodeIntegers<uint16>(src, dst, valueCount, 1.0f, noMinimum);
+            break;
+        case ChannelType::SInt16:
+            DecodeIntegers<int16>(src, dst, valueCount, 1.0f, noMinimum);
+            break;
+        default:
+            break;
+    }
+}
+
+void EncodeValues(const PixelLayout& layout, const float32* src, void* dst, uint32 texelCount) {
+    const auto& kernels = GetConvertKernels();
+    const uint32 valueCount = texelCount * layout.Channels;
+
+    switch (layout.Type) {
+        case ChannelType::UNorm8:
+            kernels.EncodeUNorm8(src, static_cast<uint8*>(dst), valueCount, layout.Channels, layout.Srgb,
+                                 layout.SwapRB);
+            break;
+        case ChannelType::Float16:
+            kernels.EncodeHalf(src, static_cast<uint16*>(dst), valueCount);
+            break;
+        case ChannelType::Float32:
+            std::memcpy(dst, src, valueCount * sizeof(float32));
+            break;
+        case ChannelType::SNorm8:
+            EncodeIntegers<int8>(src, dst, valueCount, 127.0f);
+            break;
+        case ChannelType::UNorm16:
+            EncodeIntegers<uint16>(src, dst, valueCount, 65535.0f);
+            break;
+        case ChannelType::SNorm16:
+            EncodeIntegers<int16>(src, dst, valueCount, 32767.0f);
+            break;
+        case ChannelType::UInt8:
+            EncodeIntegers<uint8>(src, dst, valueCount, 1.0f);
+            break;
+        case ChannelType::SInt8:
+            EncodeIntegers<int8>(src, dst, valueCount, 1.0f);
+            break;
+        case ChannelType::UInt16:
+            EncodeIntegers<uint16>(src, dst, valueCount, 1.0f);
+            break;
+        case ChannelType::SInt16:
+            EncodeIntegers<int16>(src, dst, valueCount, 1.0f);
+            break;
+        default:
+            break;
+    }
+}
+
+// Missing colour channels become zero and a missing alpha becomes one
+void RemapChannels(const float32* src, uint32 srcChannels, float32* dst, uint32 dstChannels, uint32 texelCount) {
+    const uint32 shared = std::min(srcChannels, dstChannels);
+    for (uint32 i = 0; i < texelCount; ++i) {
+        const float32* in = src + i * srcChannels;
+        float32* out = dst + i * dstChannels;
+        for (uint32 c = 0; c < shared; ++c) { out[c] = in[c]; }
+        for (uint32 c = shared; c < dstChannels; ++c) { out[c] = c == 3 ? 1.0f : 0.0f; }
+    }
+}
+
+// =================================================================================================
+// Direct conversions
+// =================================================================================================
+
+void SwapRB8(const void* src, void* dst, uint32 texelCount) {
+    GetConvertKernels().SwapRB8(static_cast<const uint8*>(src), static_cast<uint8*>(dst), texelCount);
+}
+
+void PadRGB8Opaque(const void* src, void* dst, uint32 texelCount) {
+    GetConvertKernels().PadRGB8(static_cast<const uint8*>(src), static_cast<uint8*>(dst), texelCount, 0xFF);
+}
+
+void PadRGB8SNorm(const void* src, void* dst, uint32 texelCount) {
+    GetConvertKernels().PadRGB8(static_cast<const uint8*>(src), static_cast<uint8*>(dst), texelCount, 0x7F);
+}
+
+void PadRGB8Integer(const void* src, void* dst, uint32 texelCount) {
+    GetConvertKernels().PadRGB8(static_cast<const uint8*>(src), static_cast<uint8*>(dst), texelCount, 1);
+}
+
+void DropAlpha8(const void* src, void* dst, uint32 texelCount) {
+    GetConvertKernels().DropAlpha8(static_cast<const uint8*>(src), static_cast<uint8*>(dst), texelCount);
+}
+
+template<typename T, T Alpha>
+void PadRGB(const void* src, void* dst, uint32 texelCount) {
+    const auto* in = static_cast<const T*>(src);
+    auto* out = static_cast<T*>(dst);
+    for (uint32 i = 0; i < texelCount; ++i) {
+        std::memcpy(out + i * 4, in + i * 3, sizeof(T) * 3);
+        out[i * 4 + 3] = Alpha;
+    }
+}
+
+void PadRGB32F(const void* src, void* dst, uint32 texelCount) {
+    const auto* in = static_cast<const float32*>(src);
+    auto* out = static_cast<float32*>(dst);
+    for (uint32 i = 0; i < texelCount; ++i) {
+        std::memcpy(out + i * 4, in + i * 3, sizeof(float32) * 3);
+        out[i * 4 + 3] = 1.0f;
+    }
+}
+
+struct DirectConversion {
+    RHIFormat Src;
+    RHIFormat Dst;
+    void (*Function)(const void* src, void* dst, uint32 texelCount);
+};
+
+// Pairs whose bytes only move, no value changes, so the float stage can be skipped
+constexpr std::array s_DirectConversions = {
+        DirectConversion{RHIFormat::R8G8B8A8Srgb, RHIFormat::B8G8R8A8Srgb, SwapRB8},
+        DirectConversion{RHIFormat::B8G8R8A8Srgb, RHIFormat::R8G8B8A8Srgb, SwapRB8},
+
+        DirectConversion{RHIFormat::R8G8B8UNorm, RHIFormat::R8G8B8A8UNorm, PadRGB8Opaque},
+        DirectConversion{RHIFormat::R8G8B8Srgb, RHIFormat::R8G8B8A8Srgb, PadRGB8Opaque},
+        DirectConversion{RHIFormat::R8G8B8SNorm, RHIFormat::R8G8B8A8SNorm, PadRGB8SNorm},
+        DirectConversion{RHIFormat::R8G8B8UInt, RHIFormat::R8G8B8A8UInt, PadRGB8Integer},
+        DirectConversion{RHIFormat::R8G8B8SInt, RHIFormat::R8G8B8A8SInt, PadRGB8Integer},
+
+        DirectConversion{RHIFormat::R8G8B8A8UNorm, RHIFormat::R8G8B8UNorm, DropAlpha8},
+        DirectConversion{RHIFormat::R8G8B8A8Srgb, RHIFormat::R8G8B8Srgb, DropAlpha8},
+
+        DirectConversion{RHIFormat::R16G16B16UNorm, RHIFormat::R16G16B16A16UNorm, PadRGB<uint16, 0xFFFF>},
+        DirectConversion{RHIFormat::R16G16B16SFloat, RHIFormat::R16G16B16A16SFloat, PadRGB<uint16, 0x3C00>},
+        DirectConversion{RHIFormat::R32G32B32SFloat, RHIFormat::R32G32B32A32SFloat, PadRGB32F},
+};
+
+// Texels per float tile, four channels of it stay well inside L1
+constexpr uint32 TileTexelCount = 256;
+
+} // namespace
+
+// =================================================================================================
+// Pixel Conversion
+// =================================================================================================
+
+RHIFormat GetPaddedFormat(RHIFormat format) {
+    switch (format) {
+        case RHIFormat::R8G8B8Srgb:
+            return RHIFormat::R8G8B8A8Srgb;
+        case RHIFormat::R8G8B8UNorm:
+            return RHIFormat::R8G8B8A8UNorm;
+        case RHIFormat::R8G8B8SNorm:
+            return RHIFormat::R8G8B8A8SNorm;
+        case RHIFormat::R8G8B8UInt:
+            return RHIFormat::R8G8B8A8UInt;
+        case RHIFormat::R8G8B8SInt:
+            return RHIFormat::R8G8B8A8SInt;
+        case RHIFormat::R16G16B16SFloat:
+            return RHIFormat::R16G16B16A16SFloat;
+        case RHIFormat::R16G16B16UNorm:
+            return RHIFormat::R16G16B16A16UNorm;
+        case RHIFormat::R16G16B16SNorm:
+            return RHIFormat::R16G16B16A16SNorm;
+        case RHIFormat::R16G16B16UInt:
+            return RHIFormat::R16G16B16A16UInt;
+        case RHIFormat::R16G16B16SInt:
+            return RHIFormat::R16G16B16A16SInt;
+        default:
+            return format;
+    }
+}
+
+bool CanConvertFormat(RHIFormat srcFormat, RHIFormat dstFormat) {
+    if (srcFormat == dstFormat) { return !GetFormatInfo(srcFormat).Compressed && srcFormat != RHIFormat::Unknown; }
+    if (std::ranges::any_of(s_DirectConversions,
+                            [&](const auto& entry) { return entry.Src == srcFormat && entry.Dst == dstFormat; })) {
+        return true;
+    }
+
+    const auto& src = GetPixelLayout(srcFormat);
+    const auto& dst = GetPixelLayout(dstFormat);
+    return HasFloatPath(src) && HasFloatPath(dst) && IsIntegerType(src.Type) == IsIntegerType(dst.Type);
+}
+
+bool DecodeRowToFloat(RHIFormat format, const void* src, float32* dst, uint32 texelCount) {
+    const auto& layout = GetPixelLayout(format);
+    if (!HasFloatPath(layout)) { return false; }
+
+    DecodeValues(layout, src, dst, texelCount);
+    return true;
+}
+
+bool EncodeRowFromFloat(RHIFormat format, const float32* src, void* dst, uint32 texelCount) {
+    const auto& layout = GetPixelLayout(format);
+    if (!HasFloatPath(layout)) { return false; }
+
+    EncodeValues(layout, src, dst, texelCount);
+    return true;
+}
+
+// =================================================================================================
+// PixelConverter
+// =================================================================================================
+
+PixelConverter::PixelConverter(RHIFormat srcFormat, RHIFormat dstFormat)
+    : m_SrcFormat(srcFormat), m_DstFormat(dstFormat) {
+    m_Valid = CanConvertFormat(srcFormat, dstFormat);
+    for (const auto& entry: s_DirectConversions) {
+        if (entry.Src == srcFormat && entry.Dst == dstFormat) { m_Direct = entry.Function; }
+    }
+}
+
+void PixelConverter::ConvertTexels(const void* src, void* dst, uint32 texelCount) const {
+    if (!m_Valid || texelCount == 0) { return; }
+
+    if (m_SrcFormat == m_DstFormat) {
+        std::memcpy(dst, src, static_cast<uint64>(texelCount) * GetFormatInfo(m_SrcFormat).BytesPerBlock);
+        return;
+    }
+    if (m_Direct) {
+        m_Direct(src, dst, texelCount);
+        return;
+    }
+
+    const auto& srcLayout = GetPixelLayout(m_SrcFormat);
+    const auto& dstLayout = GetPixelLayout(m_DstFormat);
+    const uint32 srcTexelBytes = GetFormatInfo(m_SrcFormat).BytesPerBlock;
+    const uint32 dstTexelBytes = GetFormatInfo(m_DstFormat).BytesPerBlock;
+
+    alignas(32) std::array<float32, TileTexelCount * 4> decoded;
+    alignas(32) std::array<float32, TileTexelCount * 4> remapped;
+    for (uint32 offset = 0; offset < texelCount; offset += TileTexelCount) {
+        const uint32 count = std::min(TileTexelCount, texelCount - offset);
+        const auto* in = static_cast<const uint8*>(src) + static_cast<uint64>(offset) * srcTexelBytes;
+        auto* out = static_cast<uint8*>(dst) + static_cast<uint64>(offset) * dstTexelBytes;
+
+        DecodeValues(srcLayout, in, decoded.data(), count);
+        const float32* values = decoded.data();
+        if (srcLayout.Channels != dstLayout.Channels) {
+            RemapChannels(decoded.data(), srcLayout.Channels, remapped.data(), dstLayout.Channels, count);
+            values = remapped.data();
+        }
+        EncodeValues(dstLayout, values, out, count);
+    }
+}
+
+void PixelConverter::ConvertImage(const void* src, uint64 srcRowPitch, void* dst, uint64 dstRowPitch, uint32 width,
+                                  uint32 height, ThreadPool* pThreadPool) const {
+    if (!m_Valid) { return; }
+
+    const auto convertRows = [&](uint32 y0, uint32 y1) {
+        for (uint32 y = y0; y < y1; ++y) {
+            ConvertTexels(static_cast<const uint8*>(src) + y * srcRowPitch, static_cast<uint8*>(dst) + y * dstRowPitch,
+                          width);
+        }
+    };
+
+    if (!pThreadPool || height < 2) {
+        convertRows(0, height);
+        return;
+    }
+
+    // Bands of at least 64K texels so small images do not pay for the hand-off
+    const uint32 targetBands = std::max(1u, pThreadPool->GetWorkerCount() * 4);
+    const uint32 minRows = std::max(1u, (65536 + width - 1) / std::max(1u, width));
+    const uint32 bandRows = std::max((height + targetBands - 1) / targetBands, minRows);
+    const uint32 bandCount = (height + bandRows - 1) / bandRows;
+    pThreadPool->ParallelFor(bandCount, [&](uint32 band) {
+        convertRows(band * bandRows, std::min((band + 1) * bandRows, height));
+    });
+}
+
+bool ConvertPixels(RHIFormat srcFormat, const void* src, uint64 srcRowPitch, RHIFormat dstFormat, void* dst,
+                   uint64 dstRowPitch, uint32 width, uint32 height, ThreadPool* pThreadPool) {
+    PixelConverter converter(srcFormat, dstFormat);
+    if (!converter.IsValid()) {
+        Internal::LogError("ConvertPixels: No conversion from format {0} to {1}", static_cast<uint32>(srcFormat),
+                           static_cast<uint32>(dstFormat));
+        return false;
+    }
+
+    converter.ConvertImage(src, srcRowPitch, dst, dstRowPitch, width, height, pThreadPool);
+    return true;
+}
+
+} // namespace iGe
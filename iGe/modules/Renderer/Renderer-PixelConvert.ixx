@@ -0,0 +1,61 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.Renderer:PixelConvert;
+import iGe.RHI;
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Pixel Conversion
+// =================================================================================================
+
+// Three-channel 8 and 16-bit formats have no DXGI equivalent, textures use the four-channel format instead
+export IGE_API RHIFormat GetPaddedFormat(RHIFormat format);
+
+// Normalized and float formats convert freely, integer formats only to integer formats of 8 or 16 bits.
+// 32-bit integer and depth formats only convert to themselves, block-compressed formats not at all.
+export IGE_API bool CanConvertFormat(RHIFormat srcFormat, RHIFormat dstFormat);
+
+// Texels as float in the format's own channel count, sRGB channels linearized and BGRA reordered to RGBA
+export IGE_API bool DecodeRowToFloat(RHIFormat format, const void* src, float32* dst, uint32 texelCount);
+export IGE_API bool EncodeRowFromFloat(RHIFormat format, const float32* src, void* dst, uint32 texelCount);
+
+// =================================================================================================
+// PixelConverter
+// =================================================================================================
+
+// Conversion between one pair of formats, resolved once from the conversion table. Pairs with a byte-level
+// kernel (padding, swizzles) skip the float stage, everything else streams through a small float tile.
+export class IGE_API PixelConverter {
+public:
+    PixelConverter(RHIFormat srcFormat, RHIFormat dstFormat);
+
+    bool IsValid() const { return m_Valid; }
+    RHIFormat GetSrcFormat() const { return m_SrcFormat; }
+    RHIFormat GetDstFormat() const { return m_DstFormat; }
+
+    // Convert a run of consecutive texels, rows may be fed in any number of pieces
+    void ConvertTexels(const void* src, void* dst, uint32 texelCount) const;
+
+    // Row bands are spread over the thread pool when one is given
+    void ConvertImage(const void* src, uint64 srcRowPitch, void* dst, uint64 dstRowPitch, uint32 width,
+                      uint32 height, ThreadPool* pThreadPool = nullptr) const;
+
+private:
+    using DirectFunction = void (*)(const void* src, void* dst, uint32 texelCount);
+
+    RHIFormat m_SrcFormat = RHIFormat::Unknown;
+    RHIFormat m_DstFormat = RHIFormat::Unknown;
+    DirectFunction m_Direct = nullptr;
+    bool m_Valid = false;
+};
+
+// One-shot helper over PixelConverter, returns false for unsupported pairs
+export IGE_API bool ConvertPixels(RHIFormat srcFormat, const void* src, uint64 srcRowPitch, RHIFormat dstFormat,
+                                  void* dst, uint64 dstRowPitch, uint32 width, uint32 height,
+                                  ThreadPool* pThreadPool = nullptr);
+
+} // namespace iGe
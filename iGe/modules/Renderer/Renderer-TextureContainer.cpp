@@ -0,0 +1,132 @@
+module iGe.Renderer;
+import :TextureContainer;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Texture Container
+// =================================================================================================
+
+RHITextureCreateInfo ToTextureCreateInfo(const TextureContainerHeader& header) {
+    RHITextureCreateInfo info{};
+    info.Type = header.Type;
+    info.Format = header.Format;
+    info.Extent = header.Extent;
+    info.MipLevels = header.MipLevels;
+    info.ArrayLayers = header.ArrayLayers;
+    info.Usage = RHITextureUsageFlagBits::Sampled | RHITextureUsageFlagBits::TransferDst;
+    info.MemoryUsage = RHIMemoryUsage::GpuOnly;
+    return info;
+}
+
+bool ParseTextureContainer(std::span<const std::byte> file, TextureContainerView& view) {
+    if (file.size() < sizeof(TextureContainerHeader)) {
+        Internal::LogError("ParseTextureContainer: File is smaller than the header");
+        return false;
+    }
+
+    std::memcpy(&view.Header, file.data(), sizeof(TextureContainerHeader));
+    const auto& header = view.Header;
+    if (header.Magic != TextureContainerMagic || header.Version != TextureContainerVersion) {
+        Internal::LogError("ParseTextureContainer: Bad magic or unsupported version {0}", header.Version);
+        return false;
+    }
+
+    const uint64 tableSize = static_cast<uint64>(header.SubresourceCount) * sizeof(TextureContainerSubresource);
+    if (sizeof(TextureContainerHeader) + tableSize > file.size() || header.DataOffset > file.size() ||
+        header.DataSize > file.size() - header.DataOffset) {
+        Internal::LogError("ParseTextureContainer: Truncated file");
+        return false;
+    }
+
+    view.Subresources.resize(header.SubresourceCount);
+    std::memcpy(view.Subresources.data(), file.data() + sizeof(TextureContainerHeader), tableSize);
+    view.Data = file.subspan(header.DataOffset, header.DataSize);
+
+    for (const auto& subresource: view.Subresources) {
+        const uint64 rowsSize =
+                static_cast<uint64>(subresource.RowPitch) * subresource.RowCount * subresource.Extent.Depth;
+        if (subresource.Offset > view.Data.size() || subresource.Size > view.Data.size() - subresource.Offset ||
+            rowsSize > subresource.Size) {
+            Internal::LogError("ParseTextureContainer: Subresource (mip {0}, layer {1}) is out of bounds",
+                               subresource.MipLevel, subresource.ArrayLayer);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+uint64 ComputeUploadFootprints(const TextureContainerView& view, uint64 offsetAlignment, uint32 rowPitchAlignment,
+                               std::vector<RHIBufferTextureCopy>& regions) {
+    regions.resize(view.Subresources.size());
+    uint64 size = 0;
+    for (uint64 i = 0; i < regions.size(); ++i) {
+        const auto& subresource = view.Subresources[i];
+        auto& region = regions[i];
+        size = AlignUp(size, offsetAlignment);
+        region.BufferOffset = size;
+        region.BufferRowPitch = static_cast<uint32>(AlignUp(subresource.RowPitch, rowPitchAlignment));
+        region.MipLevel = subresource.MipLevel;
+        region.ArrayLayer = subresource.ArrayLayer;
+        region.Extent = subresource.Extent;
+        size += static_cast<uint64>(region.BufferRowPitch) * subresource.RowCount * subresource.Extent.Depth;
+    }
+    return size;
+}
+
+void CopyUploadRows(const TextureContainerView& view, std::span<const RHIBufferTextureCopy> regions,
+                    uint8* pStaging) {
+    for (uint64 i = 0; i < regions.size(); ++i) {
+        const auto& subresource = view.Subresources[i];
+        const auto* source = view.GetSubresourceData(subresource).data();
+        uint8* destination = pStaging + regions[i].BufferOffset;
+        const uint32 rows = subresource.RowCount * subresource.Extent.Depth;
+
+        // Matching pitches collapse into one copy
+        if (regions[i].BufferRowPitch == subresource.RowPitch) {
+            std::memcpy(destination, source, static_cast<uint64>(subresource.RowPitch) * rows);
+            continue;
+        }
+        for (uint32 row = 0; row < rows; ++row) {
+            std::memcpy(destination + static_cast<uint64>(row) * regions[i].BufferRowPitch,
+                        source + static_cast<uint64>(row) * subresource.RowPitch, subresource.RowPitch);
+        }
+    }
+}
+
+bool WriteTextureContainer(const std::filesystem::path& path, const TextureContainerHeader& header,
+                           std::span<const TextureContainerSubresource> subresources,
+                           std::span<const std::byte> data) {
+    TextureContainerHeader fileHeader = header;
+    fileHeader.Magic = TextureContainerMagic;
+    fileHeader.Version = TextureContainerVersion;
+    fileHeader.SubresourceCount = static_cast<uint32>(subresources.size());
+    fileHeader.DataOffset = AlignUp(sizeof(TextureContainerHeader) + subresources.size_bytes(), 16);
+    fileHeader.DataSize = data.size();
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        Internal::LogError("WriteTextureContainer: Could not open '{0}' for writing", path.string());
+        return false;
+    }
+
+    const std::array<char, 16> padding = {};
+    const uint64 paddingSize = fileHeader.DataOffset - sizeof(TextureContainerHeader) - subresources.size_bytes();
+
+    file.write(reinterpret_cast<const char*>(&fileHeader), sizeof(fileHeader));
+    file.write(reinterpret_cast<const char*>(subresources.data()),
+               static_cast<std::streamsize>(subresources.size_bytes()));
+    file.write(padding.data(), static_cast<std::streamsize>(paddingSize));
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+    if (!file) {
+        Internal::LogError("WriteTextureContainer: Failed to write '{0}'", path.string());
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace iGe
@@ -0,0 +1,97 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.Renderer:TextureContainer;
+import iGe.RHI;
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Texture Container (.igtex)
+// =================================================================================================
+//
+// Layout (little endian):
+//   TextureContainerHeader
+//   TextureContainerSubresource[SubresourceCount], ordered layer by layer, mip 0 first
+//   Payload, every subresource stored with tightly packed block rows
+//
+
+export constexpr uint32 TextureContainerMagic = 0x58544749; // "IGTX"
+export constexpr uint32 TextureContainerVersion = 1;
+
+export enum class TextureContainerFlagBits : uint32 {
+    None = 0,
+    CubeMap = 1 << 0, // ArrayLayers holds six faces per cube
+};
+
+export struct TextureContainerHeader {
+    uint32 Magic = TextureContainerMagic;
+    uint32 Version = TextureContainerVersion;
+
+    // Mirrors RHITextureCreateInfo
+    RHITextureType Type = RHITextureType::Texture2D;
+    RHIFormat Format = RHIFormat::Unknown;
+    RHIExtent3D Extent = {1, 1, 1};
+    uint32 MipLevels = 1;
+    uint32 ArrayLayers = 1;
+
+    Flags<TextureContainerFlagBits> ContainerFlags;
+    uint32 SubresourceCount = 0;
+    uint32 Reserved = 0;
+
+    // Payload location, relative to the start of the file
+    uint64 DataOffset = 0;
+    uint64 DataSize = 0;
+};
+
+export struct TextureContainerSubresource {
+    uint32 MipLevel = 0;
+    uint32 ArrayLayer = 0;
+    RHIExtent3D Extent = {1, 1, 1};
+
+    uint32 RowPitch = 0; // Bytes of one tightly packed block row
+    uint32 RowCount = 0; // Block rows in one depth slice
+    uint32 Reserved = 0;
+
+    uint64 Offset = 0; // Relative to TextureContainerHeader::DataOffset
+    uint64 Size = 0;
+};
+
+static_assert(sizeof(TextureContainerHeader) == 64);
+static_assert(sizeof(TextureContainerSubresource) == 48);
+
+export IGE_API RHITextureCreateInfo ToTextureCreateInfo(const TextureContainerHeader& header);
+
+// =================================================================================================
+// Texture Container View
+// =================================================================================================
+
+// Parsed metadata of a container that lives in memory, the payload is referenced, never copied
+export struct TextureContainerView {
+    TextureContainerHeader Header;
+    std::vector<TextureContainerSubresource> Subresources;
+    std::span<const std::byte> Data;
+
+    std::span<const std::byte> GetSubresourceData(const TextureContainerSubresource& subresource) const {
+        return Data.subspan(subresource.Offset, subresource.Size);
+    }
+};
+
+export IGE_API bool ParseTextureContainer(std::span<const std::byte> file, TextureContainerView& view);
+
+// Staging layout for uploading every subresource of a view in one batch: rows padded to rowPitchAlignment,
+// subresources aligned to offsetAlignment. Offsets start at zero, returns the total staging size.
+export IGE_API uint64 ComputeUploadFootprints(const TextureContainerView& view, uint64 offsetAlignment,
+                                              uint32 rowPitchAlignment, std::vector<RHIBufferTextureCopy>& regions);
+
+// Copy every subresource row from the view into staging memory laid out by ComputeUploadFootprints
+export IGE_API void CopyUploadRows(const TextureContainerView& view, std::span<const RHIBufferTextureCopy> regions,
+                                   uint8* pStaging);
+
+export IGE_API bool WriteTextureContainer(const std::filesystem::path& path, const TextureContainerHeader& header,
+                                          std::span<const TextureContainerSubresource> subresources,
+                                          std::span<const std::byte> data);
+
+} // namespace iGe
@@ -0,0 +1,146 @@
+module;
+#include <stb_image/stb_image.h>
+
+module iGe.Renderer;
+import :TextureCooker;
+import :TextureContainer;
+import :TextureImporter;
+import :BlockCompression;
+import :MipGenerator;
+
+namespace iGe
+{
+
+namespace
+{
+
+bool IsCookableFormat(RHIFormat format) {
+    return GetFormatInfo(format).Compressed || format == RHIFormat::R8G8B8A8UNorm ||
+           format == RHIFormat::R8G8B8A8Srgb;
+}
+
+} // namespace
+
+// =================================================================================================
+// TextureCooker
+// =================================================================================================
+
+TextureCooker::TextureCooker(ThreadPool* pThreadPool) : m_ThreadPool(pThreadPool) {
+    if (!m_ThreadPool) {
+        m_OwnedThreadPool = CreateScope<ThreadPool>();
+        m_ThreadPool = m_OwnedThreadPool.get();
+    }
+    m_MipGenerator = CreateScope<MipGenerator>(m_ThreadPool);
+}
+
+TextureCooker::~TextureCooker() = default;
+
+bool TextureCooker::Cook(const std::filesystem::path& source, const std::filesystem::path& destination,
+                         const TextureCookSettings& settings) {
+    if (!IsCookableFormat(settings.Format)) {
+        Internal::LogError("TextureCooker: Unsupported target format {0} for '{1}'",
+                           static_cast<uint32>(settings.Format), source.string());
+        return false;
+    }
+
+    const std::string path = source.string();
+    int32 width = 0;
+    int32 height = 0;
+    int32 sourceChannels = 0;
+    stbi_set_flip_vertically_on_load_thread(settings.FlipVertically ? 1 : 0);
+    uint8* pixels = stbi_load(path.c_str(), &width, &height, &sourceChannels, 4);
+    if (!pixels) {
+        Internal::LogError("TextureCooker: Failed to decode '{0}' ({1})", path, stbi_failure_reason());
+        return false;
+    }
+
+    // Level 0 stays in stb's buffer, the generator filters the rest in linear space for sRGB targets
+    MipGenerationSettings mipSettings;
+    mipSettings.Filter = settings.Filter;
+    mipSettings.MaxMipLevels = settings.GenerateMips ? settings.MaxMipLevels : 1;
+    const RHIFormat mipFormat =
+            GetFormatInfo(settings.Format).Srgb ? RHIFormat::R8G8B8A8Srgb : RHIFormat::R8G8B8A8UNorm;
+    const auto generated = m_MipGenerator->Generate(mipFormat, pixels, static_cast<uint32>(width),
+                                                    static_cast<uint32>(height), static_cast<uint64>(width) * 4,
+                                                    mipSettings);
+
+    struct LevelView {
+        uint32 Width;
+        uint32 Height;
+        const uint8* Texels;
+    };
+    std::vector<LevelView> mips = {{static_cast<uint32>(width), static_cast<uint32>(height), pixels}};
+    for (const auto& level: generated) { mips.push_back({level.Width, level.Height, level.Data.data()}); }
+    const uint32 mipLevels = static_cast<uint32>(mips.size());
+
+    // Lay out every level with tight block rows, mip 0 first
+    std::vector<TextureContainerSubresource> subresources(mipLevels);
+    uint64 dataSize = 0;
+    for (uint32 level = 0; level < mipLevels; ++level) {
+        auto& subresource = subresources[level];
+        subresource.MipLevel = level;
+        subresource.Extent = {mips[level].Width, mips[level].Height, 1};
+        subresource.RowPitch = static_cast<uint32>(GetFormatRowBytes(settings.Format, mips[level].Width));
+        subresource.RowCount = GetFormatRowCount(settings.Format, mips[level].Height);
+        subresource.Offset = dataSize;
+        subresource.Size = static_cast<uint64>(subresource.RowPitch) * subresource.RowCount;
+        dataSize = AlignUp(dataSize + subresource.Size, 16);
+    }
+
+    std::vector<std::byte> data(dataSize);
+    for (uint32 level = 0; level < mipLevels; ++level) {
+        const auto& mip = mips[level];
+        const auto& subresource = subresources[level];
+        auto* output = reinterpret_cast<uint8*>(data.data() + subresource.Offset);
+
+        if (!GetFormatInfo(settings.Format).Compressed) {
+            std::memcpy(output, mip.Texels, subresource.Size);
+            continue;
+        }
+
+        if (!CompressImage(settings.Format, mip.Texels, mip.Width, mip.Height, static_cast<uint64>(mip.Width) * 4,
+                           output, subresource.RowPitch, m_ThreadPool)) {
+            Internal::LogError("TextureCooker: Failed to compress mip {0} of '{1}'", level, path);
+            stbi_image_free(pixels);
+            return false;
+        }
+    }
+    stbi_image_free(pixels);
+
+    TextureContainerHeader header{};
+    header.Type = RHITextureType::Texture2D;
+    header.Format = settings.Format;
+    header.Extent = subresources[0].Extent;
+    header.MipLevels = mipLevels;
+    header.ArrayLayers = 1;
+
+    return WriteTextureContainer(destination, header, subresources, data);
+}
+
+uint32 TextureCooker::CookDirectory(const std::filesystem::path& sourceDirectory,
+                                    const std::filesystem::path& destinationDirectory,
+                                    const TextureCookSettings& settings) {
+    std::error_code ec;
+    std::vector<std::filesystem::path> sources;
+    for (const auto& entry: std::filesystem::directory_iterator(sourceDirectory, ec)) {
+        if (entry.is_regular_file() && IsImportableImage(entry.path())) { sources.push_back(entry.path()); }
+    }
+
+    if (ec || !std::filesystem::create_directories(destinationDirectory, ec) && ec) {
+        Internal::LogError("TextureCooker: Failed to prepare '{0}' -> '{1}' ({2})", sourceDirectory.string(),
+                           destinationDirectory.string(), ec.message());
+        return 0;
+    }
+
+    // Files run in parallel, each file's block rows join the same pool while it waits
+    std::atomic<uint32> cooked = 0;
+    m_ThreadPool->ParallelFor(static_cast<uint32>(sources.size()), [&](uint32 index) {
+        auto destination = destinationDirectory / sources[index].filename();
+        destination.replace_extension(".igtex");
+        if (Cook(sources[index], destination, settings)) { cooked.fetch_add(1, std::memory_order_relaxed); }
+    });
+
+    return cooked.load();
+}
+
+} // namespace iGe
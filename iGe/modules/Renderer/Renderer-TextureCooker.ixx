@@ -0,0 +1,48 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.Renderer:TextureCooker;
+import iGe.RHI;
+import iGe.Common;
+import :MipGenerator;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Texture Cook Settings
+// =================================================================================================
+
+export struct TextureCookSettings {
+    // BC1/BC3/BC4/BC5/BC7 or plain R8G8B8A8, the sRGB variants also filter mips in linear space
+    RHIFormat Format = RHIFormat::BC7Srgb;
+    bool GenerateMips = true;
+    uint32 MaxMipLevels = 0; // Zero keeps the full chain
+    MipFilter Filter = MipFilter::Box;
+    bool FlipVertically = false;
+};
+
+// =================================================================================================
+// TextureCooker
+// =================================================================================================
+
+// Offline conversion of source images into GPU-ready .igtex containers
+export class IGE_API TextureCooker {
+public:
+    explicit TextureCooker(ThreadPool* pThreadPool = nullptr);
+    ~TextureCooker();
+
+    bool Cook(const std::filesystem::path& source, const std::filesystem::path& destination,
+              const TextureCookSettings& settings);
+
+    // Cook every image of a directory, returns the number of textures written
+    uint32 CookDirectory(const std::filesystem::path& sourceDirectory,
+                         const std::filesystem::path& destinationDirectory, const TextureCookSettings& settings);
+
+private:
+    ThreadPool* m_ThreadPool = nullptr;
+    Scope<ThreadPool> m_OwnedThreadPool;
+    Scope<MipGenerator> m_MipGenerator;
+};
+
+} // namespace iGe
@@ -0,0 +1,469 @@
+module iGe.Renderer;
+import :TextureFileParser;
+import :TextureContainer;
+
+namespace iGe
+{
+
+namespace
+{
+
+// =================================================================================================
+// Format Tables
+// =================================================================================================
+
+struct FormatCode {
+    uint32 Code;
+    RHIFormat Format;
+};
+
+// DXGI_FORMAT values, spelled out so parsing does not depend on the Windows headers
+constexpr auto s_DxgiFormats = std::to_array<FormatCode>({
+        {2, RHIFormat::R32G32B32A32SFloat}, {3, RHIFormat::R32G32B32A32UInt}, {4, RHIFormat::R32G32B32A32SInt},
+        {6, RHIFormat::R32G32B32SFloat}, {7, RHIFormat::R32G32B32UInt}, {8, RHIFormat::R32G32B32SInt},
+        {10, RHIFormat::R16G16B16A16SFloat}, {11, RHIFormat::R16G16B16A16UNorm}, {12, RHIFormat::R16G16B16A16UInt},
+        {13, RHIFormat::R16G16B16A16SNorm}, {14, RHIFormat::R16G16B16A16SInt}, {16, RHIFormat::R32G32SFloat},
+        {17, RHIFormat::R32G32UInt}, {18, RHIFormat::R32G32SInt}, {28, RHIFormat::R8G8B8A8UNorm},
+        {29, RHIFormat::R8G8B8A8Srgb}, {30, RHIFormat::R8G8B8A8UInt}, {31, RHIFormat::R8G8B8A8SNorm},
+        {32, RHIFormat::R8G8B8A8SInt}, {34, RHIFormat::R16G16SFloat}, {35, RHIFormat::R16G16UNorm},
+        {36, RHIFormat::R16G16UInt}, {37, RHIFormat::R16G16SNorm}, {38, RHIFormat::R16G16SInt},
+        {41, RHIFormat::R32SFloat}, {42, RHIFormat::R32UInt}, {43, RHIFormat::R32SInt},
+        {49, RHIFormat::R8G8UNorm}, {50, RHIFormat::R8G8UInt}, {51, RHIFormat::R8G8SNorm},
+        {52, RHIFormat::R8G8SInt}, {54, RHIFormat::R16SFloat}, {56, RHIFormat::R16UNorm},
+        {57, RHIFormat::R16UInt}, {58, RHIFormat::R16SNorm}, {59, RHIFormat::R16SInt},
+        {61, RHIFormat::R8UNorm}, {62, RHIFormat::R8UInt}, {63, RHIFormat::R8SNorm},
+        {64, RHIFormat::R8SInt}, {71, RHIFormat::BC1RGBAUNorm}, {72, RHIFormat::BC1RGBASrgb},
+        {77, RHIFormat::BC3UNorm}, {78, RHIFormat::BC3Srgb}, {80, RHIFormat::BC4UNorm},
+        {81, RHIFormat::BC4SNorm}, {83, RHIFormat::BC5UNorm}, {84, RHIFormat::BC5SNorm},
+        {91, RHIFormat::B8G8R8A8Srgb}, {98, RHIFormat::BC7UNorm}, {99, RHIFormat::BC7Srgb},
+});
+
+// VkFormat values, three-channel 8 and 16-bit formats are left out since DX12 cannot sample them
+constexpr auto s_VkFormats = std::to_array<FormatCode>({
+        {9, RHIFormat::R8UNorm}, {10, RHIFormat::R8SNorm}, {13, RHIFormat::R8UInt},
+        {14, RHIFormat::R8SInt}, {15, RHIFormat::R8Srgb}, {16, RHIFormat::R8G8UNorm},
+        {17, RHIFormat::R8G8SNorm}, {20, RHIFormat::R8G8UInt}, {21, RHIFormat::R8G8SInt},
+        {22, RHIFormat::R8G8Srgb}, {37, RHIFormat::R8G8B8A8UNorm}, {38, RHIFormat::R8G8B8A8SNorm},
+        {41, RHIFormat::R8G8B8A8UInt}, {42, RHIFormat::R8G8B8A8SInt}, {43, RHIFormat::R8G8B8A8Srgb},
+        {50, RHIFormat::B8G8R8A8Srgb}, {70, RHIFormat::R16UNorm}, {71, RHIFormat::R16SNorm},
+        {74, RHIFormat::R16UInt}, {75, RHIFormat::R16SInt}, {76, RHIFormat::R16SFloat},
+        {77, RHIFormat::R16G16UNorm}, {78, RHIFormat::R16G16SNorm}, {81, RHIFormat::R16G16UInt},
+        {82, RHIFormat::R16G16SInt}, {83, RHIFormat::R16G16SFloat}, {91, RHIFormat::R16G16B16A16UNorm},
+        {92, RHIFormat::R16G16B16A16SNorm}, {95, RHIFormat::R16G16B16A16UInt}, {96, RHIFormat::R16G16B16A16SInt},
+        {97, RHIFormat::R16G16B16A16SFloat}, {98, RHIFormat::R32UInt}, {99, RHIFormat::R32SInt},
+        {100, RHIFormat::R32SFloat}, {101, RHIFormat::R32G32UInt}, {102, RHIFormat::R32G32SInt},
+        {103, RHIFormat::R32G32SFloat}, {104, RHIFormat::R32G32B32UInt}, {105, RHIFormat::R32G32B32SInt},
+        {106, RHIFormat::R32G32B32SFloat}, {107, RHIFormat::R32G32B32A32UInt}, {108, RHIFormat::R32G32B32A32SInt},
+        {109, RHIFormat::R32G32B32A32SFloat}, {131, RHIFormat::BC1RGBAUNorm}, {132, RHIFormat::BC1RGBASrgb},
+        {133, RHIFormat::BC1RGBAUNorm}, {134, RHIFormat::BC1RGBASrgb}, {137, RHIFormat::BC3UNorm},
+        {138, RHIFormat::BC3Srgb}, {139, RHIFormat::BC4UNorm}, {140, RHIFormat::BC4SNorm},
+        {141, RHIFormat::BC5UNorm}, {142, RHIFormat::BC5SNorm}, {145, RHIFormat::BC7UNorm},
+        {146, RHIFormat::BC7Srgb},
+});
+
+RHIFormat FindFormat(std::span<const FormatCode> table, uint32 code) {
+    const auto it = std::ranges::find(table, code, &FormatCode::Code);
+    return it != table.end() ? it->Format : RHIFormat::Unknown;
+}
+
+// =================================================================================================
+// Helpers
+// =================================================================================================
+
+template<typename T>
+bool ReadStruct(std::span<const std::byte> file, uint64 offset, T& value) {
+    if (offset > file.size() || sizeof(T) > file.size() - offset) { return false; }
+    std::memcpy(&value, file.data() + offset, sizeof(T));
+    return true;
+}
+
+// Tight footprint of one subresource as both DDS and KTX2 store it
+TextureContainerSubresource MakeSubresource(const TextureContainerHeader& header, uint32 mip, uint32 layer,
+                                            uint64 offset) {
+    TextureContainerSubresource subresource;
+    subresource.MipLevel = mip;
+    subresource.ArrayLayer = layer;
+    subresource.Extent = {std::max(1u, header.Extent.Width >> mip), std::max(1u, header.Extent.Height >> mip),
+                          std::max(1u, header.Extent.Depth >> mip)};
+    subresource.RowPitch = static_cast<uint32>(GetFormatRowBytes(header.Format, subresource.Extent.Width));
+    subresource.RowCount = GetFormatRowCount(header.Format, subresource.Extent.Height);
+    subresource.Offset = offset;
+    subresource.Size = static_cast<uint64>(subresource.RowPitch) * subresource.RowCount * subresource.Extent.Depth;
+    return subresource;
+}
+
+// Array size every DX12 device supports, larger counts only come from corrupt headers
+constexpr uint64 MaxArrayLayers = 2048;
+
+// Layer counts are multiplied out in 64 bits and checked before anything is sized from them
+bool ValidateLayerCount(const char* parser, uint64 layerCount) {
+    if (layerCount == 0 || layerCount > MaxArrayLayers) {
+        Internal::LogError("{0}: Invalid layer count {1}", parser, layerCount);
+        return false;
+    }
+    return true;
+}
+
+bool ValidateHeader(const char* parser, const TextureContainerHeader& header) {
+    if (header.Format == RHIFormat::Unknown) {
+        Internal::LogError("{0}: Unsupported pixel format", parser);
+        return false;
+    }
+
+    const uint32 largest = std::max({header.Extent.Width, header.Extent.Height, header.Extent.Depth});
+    if (header.Extent.Width == 0 || header.ArrayLayers == 0 || header.MipLevels == 0 ||
+        header.MipLevels > static_cast<uint32>(std::bit_width(largest))) {
+        Internal::LogError("{0}: Invalid extent {1}x{2}x{3} with {4} mips and {5} layers", parser,
+                           header.Extent.Width, header.Extent.Height, header.Extent.Depth, header.MipLevels,
+                           header.ArrayLayers);
+        return false;
+    }
+    return true;
+}
+
+// Rejects headers whose subresources cannot fit into payloadSize bytes, before the subresource table is sized
+bool ValidatePayloadSize(const char* parser, const TextureContainerHeader& header, uint64 payloadSize) {
+    uint64 layerSize = 0;
+    for (uint32 mip = 0; mip < header.MipLevels; ++mip) { layerSize += MakeSubresource(header, mip, 0, 0).Size; }
+    if (layerSize == 0 || header.ArrayLayers > payloadSize / layerSize) {
+        Internal::LogError("{0}: {1} layers of {2} bytes do not fit into {3} bytes", parser, header.ArrayLayers,
+                           layerSize, payloadSize);
+        return false;
+    }
+    return true;
+}
+
+bool ValidateSubresources(const char* parser, const TextureContainerView& view) {
+    for (const auto& subresource: view.Subresources) {
+        if (subresource.Offset > view.Data.size() || subresource.Size > view.Data.size() - subresource.Offset) {
+            Internal::LogError("{0}: Subresource (mip {1}, layer {2}) is out of bounds", parser,
+                               subresource.MipLevel, subresource.ArrayLayer);
+            return false;
+        }
+    }
+    return true;
+}
+
+// =================================================================================================
+// DDS
+// =================================================================================================
+
+constexpr uint32 DdsMagic = 0x20534444; // "DDS "
+
+constexpr uint32 DdsFlagMipMapCount = 0x20000;
+constexpr uint32 DdsPixelFlagAlpha = 0x1;
+constexpr uint32 DdsPixelFlagFourCC = 0x4;
+constexpr uint32 DdsPixelFlagRGB = 0x40;
+constexpr uint32 DdsPixelFlagLuminance = 0x20000;
+constexpr uint32 DdsCaps2CubeMap = 0x200;
+constexpr uint32 DdsCaps2Volume = 0x200000;
+constexpr uint32 DdsMiscTextureCube = 0x4;
+
+constexpr uint32 DdsDimensionTexture1D = 2;
+constexpr uint32 DdsDimensionTexture3D = 4;
+
+constexpr uint32 MakeFourCC(char a, char b, char c, char d) {
+    return static_cast<uint32>(a) | static_cast<uint32>(b) << 8 | static_cast<uint32>(c) << 16 |
+           static_cast<uint32>(d) << 24;
+}
+
+struct DdsPixelFormat {
+    uint32 Size;
+    uint32 Flags;
+    uint32 FourCC;
+    uint32 RGBBitCount;
+    uint32 RBitMask;
+    uint32 GBitMask;
+    uint32 BBitMask;
+    uint32 ABitMask;
+};
+
+struct DdsHeader {
+    uint32 Size;
+    uint32 Flags;
+    uint32 Height;
+    uint32 Width;
+    uint32 PitchOrLinearSize;
+    uint32 Depth;
+    uint32 MipMapCount;
+    uint32 Reserved1[11];
+    DdsPixelFormat PixelFormat;
+    uint32 Caps;
+    uint32 Caps2;
+    uint32 Caps3;
+    uint32 Caps4;
+    uint32 Reserved2;
+};
+
+struct DdsHeaderDX10 {
+    uint32 DxgiFormat;
+    uint32 ResourceDimension;
+    uint32 MiscFlag;
+    uint32 ArraySize;
+    uint32 MiscFlags2;
+};
+
+static_assert(sizeof(DdsHeader) == 124);
+static_assert(sizeof(DdsHeaderDX10) == 20);
+
+// Pre-DX10 files describe their format through FourCC codes or channel masks
+RHIFormat GetLegacyDdsFormat(const DdsPixelFormat& pf) {
+    if (pf.Flags & DdsPixelFlagFourCC) {
+        switch (pf.FourCC) {
+            case MakeFourCC('D', 'X', 'T', '1'):
+                return RHIFormat::BC1RGBAUNorm;
+            case MakeFourCC('D', 'X', 'T', '5'):
+                return RHIFormat::BC3UNorm;
+            case MakeFourCC('A', 'T', 'I', '1'):
+            case MakeFourCC('B', 'C', '4', 'U'):
+                return RHIFormat::BC4UNorm;
+            case MakeFourCC('B', 'C', '4', 'S'):
+                return RHIFormat::BC4SNorm;
+            case MakeFourCC('A', 'T', 'I', '2'):
+            case MakeFourCC('B', 'C', '5', 'U'):
+                return RHIFormat::BC5UNorm;
+            case MakeFourCC('B', 'C', '5', 'S'):
+                return RHIFormat::BC5SNorm;
+            // D3DFMT codes stored directly in the FourCC field
+            case 36:
+                return RHIFormat::R16G16B16A16UNorm;
+            case 111:
+                return RHIFormat::R16SFloat;
+            case 112:
+                return RHIFormat::R16G16SFloat;
+            case 113:
+                return RHIFormat::R16G16B16A16SFloat;
+            case 114:
+                return RHIFormat::R32SFloat;
+            case 115:
+                return RHIFormat::R32G32SFloat;
+            case 116:
+                return RHIFormat::R32G32B32A32SFloat;
+            default:
+                return RHIFormat::Unknown;
+        }
+    }
+
+    if ((pf.Flags & DdsPixelFlagRGB) && pf.RGBBitCount == 32 && pf.RBitMask == 0x000000ff &&
+        pf.GBitMask == 0x0000ff00 && pf.BBitMask == 0x00ff0000) {
+        return RHIFormat::R8G8B8A8UNorm;
+    }
+    if ((pf.Flags & DdsPixelFlagLuminance) && !(pf.Flags & DdsPixelFlagAlpha)) {
+        if (pf.RGBBitCount == 8) { return RHIFormat::R8UNorm; }
+        if (pf.RGBBitCount == 16 && pf.RBitMask == 0xffff) { return RHIFormat::R16UNorm; }
+    }
+    return RHIFormat::Unknown;
+}
+
+// =================================================================================================
+// KTX2
+// =================================================================================================
+
+constexpr std::array<uint8, 12> Ktx2Identifier = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32,
+                                                  0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+struct Ktx2Header {
+    uint8 Identifier[12];
+    uint32 VkFormat;
+    uint32 TypeSize;
+    uint32 PixelWidth;
+    uint32 PixelHeight;
+    uint32 PixelDepth;
+    uint32 LayerCount;
+    uint32 FaceCount;
+    uint32 LevelCount;
+    uint32 SupercompressionScheme;
+
+    uint32 DfdByteOffset;
+    uint32 DfdByteLength;
+    uint32 KvdByteOffset;
+    uint32 KvdByteLength;
+    uint64 SgdByteOffset;
+    uint64 SgdByteLength;
+};
+
+struct Ktx2Level {
+    uint64 ByteOffset;
+    uint64 ByteLength;
+    uint64 UncompressedByteLength;
+};
+
+static_assert(sizeof(Ktx2Header) == 80);
+static_assert(sizeof(Ktx2Level) == 24);
+
+} // namespace
+
+// =================================================================================================
+// Texture File Parser
+// =================================================================================================
+
+TextureFileType GetTextureFileType(std::span<const std::byte> file) {
+    uint32 magic = 0;
+    if (!ReadStruct(file, 0, magic)) { return TextureFileType::Unknown; }
+    if (magic == TextureContainerMagic) { return TextureFileType::Container; }
+    if (magic == DdsMagic) { return TextureFileType::DDS; }
+
+    if (file.size() >= Ktx2Identifier.size() &&
+        std::memcmp(file.data(), Ktx2Identifier.data(), Ktx2Identifier.size()) == 0) {
+        return TextureFileType::KTX2;
+    }
+    return TextureFileType::Unknown;
+}
+
+bool ParseDDS(std::span<const std::byte> file, TextureContainerView& view) {
+    uint32 magic = 0;
+    DdsHeader dds{};
+    if (!ReadStruct(file, 0, magic) || magic != DdsMagic || !ReadStruct(file, sizeof(uint32), dds) ||
+        dds.Size != sizeof(DdsHeader)) {
+        Internal::LogError("ParseDDS: Missing or malformed header");
+        return false;
+    }
+
+    auto& header = view.Header;
+    header = {};
+    header.Type = RHITextureType::Texture2D;
+    header.Extent = {dds.Width, std::max(1u, dds.Height), 1};
+    header.MipLevels = (dds.Flags & DdsFlagMipMapCount) ? std::max(1u, dds.MipMapCount) : 1;
+
+    uint64 layerCount = 1;
+    uint64 dataOffset = sizeof(uint32) + sizeof(DdsHeader);
+    const bool hasDX10 =
+            (dds.PixelFormat.Flags & DdsPixelFlagFourCC) && dds.PixelFormat.FourCC == MakeFourCC('D', 'X', '1', '0');
+    if (hasDX10) {
+        DdsHeaderDX10 dx10{};
+        if (!ReadStruct(file, dataOffset, dx10)) {
+            Internal::LogError("ParseDDS: Truncated DX10 header");
+            return false;
+        }
+        dataOffset += sizeof(DdsHeaderDX10);
+
+        header.Format = FindFormat(s_DxgiFormats, dx10.DxgiFormat);
+        layerCount = std::max(1u, dx10.ArraySize);
+        if (dx10.ResourceDimension == DdsDimensionTexture1D) {
+            header.Type = RHITextureType::Texture1D;
+            header.Extent.Height = 1;
+        } else if (dx10.ResourceDimension == DdsDimensionTexture3D) {
+            header.Type = RHITextureType::Texture3D;
+            header.Extent.Depth = std::max(1u, dds.Depth);
+        } else if (dx10.MiscFlag & DdsMiscTextureCube) {
+            layerCount *= 6;
+            header.ContainerFlags |= TextureContainerFlagBits::CubeMap;
+        }
+    } else {
+        header.Format = GetLegacyDdsFormat(dds.PixelFormat);
+        if (dds.Caps2 & DdsCaps2Volume) {
+            header.Type = RHITextureType::Texture3D;
+            header.Extent.Depth = std::max(1u, dds.Depth);
+        } else if (dds.Caps2 & DdsCaps2CubeMap) {
+            // Partial cube maps cannot be represented, every face is expected
+            layerCount = 6;
+            header.ContainerFlags |= TextureContainerFlagBits::CubeMap;
+        }
+    }
+
+    if (!ValidateLayerCount("ParseDDS", layerCount)) { return false; }
+    header.ArrayLayers = static_cast<uint32>(layerCount);
+    if (!ValidateHeader("ParseDDS", header) || !ValidatePayloadSize("ParseDDS", header, file.size() - dataOffset)) {
+        return false;
+    }
+
+    // Layer by layer, each holding its full mip chain
+    view.Data = file;
+    view.Subresources.clear();
+    view.Subresources.reserve(static_cast<uint64>(header.ArrayLayers) * header.MipLevels);
+    uint64 offset = dataOffset;
+    for (uint32 layer = 0; layer < header.ArrayLayers; ++layer) {
+        for (uint32 mip = 0; mip < header.MipLevels; ++mip) {
+            view.Subresources.push_back(MakeSubresource(header, mip, layer, offset));
+            offset += view.Subresources.back().Size;
+        }
+    }
+
+    header.SubresourceCount = static_cast<uint32>(view.Subresources.size());
+    header.DataOffset = 0;
+    header.DataSize = file.size();
+    return ValidateSubresources("ParseDDS", view);
+}
+
+bool ParseKTX2(std::span<const std::byte> file, TextureContainerView& view) {
+    Ktx2Header ktx{};
+    if (!ReadStruct(file, 0, ktx) || std::memcmp(ktx.Identifier, Ktx2Identifier.data(), Ktx2Identifier.size())) {
+        Internal::LogError("ParseKTX2: Missing or malformed header");
+        return false;
+    }
+    if (ktx.SupercompressionScheme != 0) {
+        Internal::LogError("ParseKTX2: Supercompression scheme {0} is not supported", ktx.SupercompressionScheme);
+        return false;
+    }
+
+    auto& header = view.Header;
+    header = {};
+    header.Format = FindFormat(s_VkFormats, ktx.VkFormat);
+    header.Extent = {ktx.PixelWidth, std::max(1u, ktx.PixelHeight), std::max(1u, ktx.PixelDepth)};
+    header.Type = ktx.PixelDepth > 0    ? RHITextureType::Texture3D
+                  : ktx.PixelHeight > 0 ? RHITextureType::Texture2D
+                                        : RHITextureType::Texture1D;
+
+    // A level count of zero asks the loader to generate mips, only the base level is stored
+    header.MipLevels = std::max(1u, ktx.LevelCount);
+    const uint32 faceCount = std::max(1u, ktx.FaceCount);
+    const uint64 layerCount = static_cast<uint64>(std::max(1u, ktx.LayerCount)) * faceCount;
+    if (faceCount == 6) { header.ContainerFlags |= TextureContainerFlagBits::CubeMap; }
+
+    if (!ValidateLayerCount("ParseKTX2", layerCount)) { return false; }
+    header.ArrayLayers = static_cast<uint32>(layerCount);
+    if (!ValidateHeader("ParseKTX2", header)) { return false; }
+    if ((faceCount != 1 && faceCount != 6) || (header.Type == RHITextureType::Texture3D && header.ArrayLayers > 1)) {
+        Internal::LogError("ParseKTX2: Unsupported layout with {0} faces and {1} layers", faceCount,
+                           ktx.LayerCount);
+        return false;
+    }
+
+    // Levels may sit anywhere past the header, the whole file bounds what they can hold
+    if (!ValidatePayloadSize("ParseKTX2", header, file.size())) { return false; }
+
+    // Each level stores layer by layer, face by face, depth slices innermost
+    std::vector<TextureContainerSubresource> byLevel(static_cast<uint64>(header.MipLevels) * header.ArrayLayers);
+    for (uint32 mip = 0; mip < header.MipLevels; ++mip) {
+        Ktx2Level level{};
+        if (!ReadStruct(file, sizeof(Ktx2Header) + mip * sizeof(Ktx2Level), level)) {
+            Internal::LogError("ParseKTX2: Truncated level index");
+            return false;
+        }
+
+        for (uint32 layer = 0; layer < header.ArrayLayers; ++layer) {
+            auto& subresource = byLevel[static_cast<uint64>(layer) * header.MipLevels + mip];
+            subresource = MakeSubresource(header, mip, layer, level.ByteOffset);
+            subresource.Offset += subresource.Size * layer;
+            if (subresource.Size * (layer + 1) > level.ByteLength) {
+                Internal::LogError("ParseKTX2: Level {0} is smaller than its images", mip);
+                return false;
+            }
+        }
+    }
+
+    view.Data = file;
+    view.Subresources = std::move(byLevel);
+    header.SubresourceCount = static_cast<uint32>(view.Subresources.size());
+    header.DataOffset = 0;
+    header.DataSize = file.size();
+    return ValidateSubresources("ParseKTX2", view);
+}
+
+bool ParseTextureFile(std::span<const std::byte> file, TextureContainerView& view) {
+    switch (GetTextureFileType(file)) {
+        case TextureFileType::Container:
+            return ParseTextureContainer(file, view);
+        case TextureFileType::DDS:
+            return ParseDDS(file, view);
+        case TextureFileType::KTX2:
+            return ParseKTX2(file, view);
+        default:
+            break;
+    }
+
+    Internal::LogError("ParseTextureFile: Unrecognized texture file");
+    return false;
+}
+
+} // namespace iGe
@@ -0,0 +1,39 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.Renderer:TextureFileParser;
+import iGe.RHI;
+import iGe.Common;
+import :TextureContainer;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Texture File Parser
+// =================================================================================================
+//
+// DDS and KTX2 files parse into the same TextureContainerView as .igtex, so every container shares
+// one upload path. Views reference the file bytes, which normally come straight from a MappedFile.
+// Only payloads the GPU can take as they are load: no row conversion and no KTX2 supercompression.
+//
+
+export enum class TextureFileType : uint8 {
+    Unknown = 0,
+    Container, // .igtex
+    DDS,
+    KTX2,
+};
+
+// Identified by the leading magic bytes, the extension is not consulted
+export IGE_API TextureFileType GetTextureFileType(std::span<const std::byte> file);
+
+// Supports 1D, 2D, 3D, array and cube textures with full mip chains, both DX10 and legacy headers
+export IGE_API bool ParseDDS(std::span<const std::byte> file, TextureContainerView& view);
+// Supports 1D, 2D, 3D, array and cube textures with full mip chains
+export IGE_API bool ParseKTX2(std::span<const std::byte> file, TextureContainerView& view);
+
+// Dispatches on GetTextureFileType
+export IGE_API bool ParseTextureFile(std::span<const std::byte> file, TextureContainerView& view);
+
+} // namespace iGe
@@ -0,0 +1,244 @@
+module;
+#include <stb_image/stb_image.h>
+
+module iGe.Renderer;
+import :TextureImporter;
+import :TextureContainer;
+import :TextureFileParser;
+import :PixelConvert;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Decode sources
+// =================================================================================================
+
+namespace
+{
+
+// Format stb_image decodes into for a given texture format: float for anything wider than 8 bits, otherwise bytes
+// labelled with the target's colour space so sRGB data is never converted
+bool GetDecodeSource(RHIFormat format, RHIFormat& source) {
+    const auto& info = GetFormatInfo(format);
+    if (info.Compressed || info.Depth || info.ChannelCount == 0) { return false; }
+
+    constexpr std::array<RHIFormat, 4> floatFormats = {RHIFormat::R32SFloat, RHIFormat::R32G32SFloat,
+                                                       RHIFormat::R32G32B32SFloat, RHIFormat::R32G32B32A32SFloat};
+    constexpr std::array<RHIFormat, 4> srgbFormats = {RHIFormat::R8Srgb, RHIFormat::R8G8Srgb, RHIFormat::R8G8B8Srgb,
+                                                      RHIFormat::R8G8B8A8Srgb};
+    constexpr std::array<RHIFormat, 4> unormFormats = {RHIFormat::R8UNorm, RHIFormat::R8G8UNorm,
+                                                       RHIFormat::R8G8B8UNorm, RHIFormat::R8G8B8A8UNorm};
+
+    const uint32 index = info.ChannelCount - 1;
+    if (info.BytesPerBlock != info.ChannelCount) {
+        source = floatFormats[index];
+    } else {
+        source = info.Srgb ? srgbFormats[index] : unormFormats[index];
+    }
+    return true;
+}
+
+} // namespace
+
+// =================================================================================================
+// TextureImporter
+// =================================================================================================
+
+bool IsImportableImage(const std::filesystem::path& path) {
+    std::string extension = path.extension().string();
+    std::ranges::transform(extension, extension.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+
+    constexpr std::array<std::string_view, 8> extensions = {".png", ".jpg", ".jpeg", ".tga",
+                                                            ".bmp", ".psd", ".gif", ".hdr"};
+    return std::ranges::find(extensions, extension) != extensions.end();
+}
+
+bool IsTextureContainer(const std::filesystem::path& path) {
+    std::string extension = path.extension().string();
+    std::ranges::transform(extension, extension.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+    return extension == ".igtex" || extension == ".dds" || extension == ".ktx2";
+}
+
+TextureImporter::TextureImporter(ThreadPool* pThreadPool, uint64 stagingPageSize)
+    : m_ThreadPool(pThreadPool), m_StagingPageSize(stagingPageSize) {
+    if (!m_ThreadPool) {
+        m_OwnedThreadPool = CreateScope<ThreadPool>();
+        m_ThreadPool = m_OwnedThreadPool.get();
+    }
+
+    const auto& limits = RHI::Get()->GetDeviceProperties().Limits;
+    m_OffsetAlignment = std::max<uint64>(1, limits.OptimalBufferCopyOffsetAlignment);
+    m_RowPitchAlignment = static_cast<uint32>(std::max<uint64>(1, limits.OptimalBufferCopyRowPitchAlignment));
+}
+
+TextureImporter::~TextureImporter() = default;
+
+std::future<TextureUploadJob> TextureImporter::ImportAsync(const TextureImportDesc& desc) {
+    return m_ThreadPool->Submit([this, desc]() { return Decode(desc); });
+}
+
+std::vector<TextureUploadJob> TextureImporter::Import(std::span<const TextureImportDesc> descs) {
+    std::vector<TextureUploadJob> jobs(descs.size());
+    m_ThreadPool->ParallelFor(static_cast<uint32>(descs.size()),
+                              [&](uint32 index) { jobs[index] = Decode(descs[index]); });
+    return jobs;
+}
+
+std::vector<TextureUploadJob> TextureImporter::ImportDirectory(const std::filesystem::path& directory,
+                                                               RHIFormat format) {
+    std::error_code ec;
+    std::vector<TextureImportDesc> descs;
+    for (const auto& entry: std::filesystem::directory_iterator(directory, ec)) {
+        const auto& path = entry.path();
+        if (entry.is_regular_file() && (IsImportableImage(path) || IsTextureContainer(path))) {
+            descs.push_back({path, format});
+        }
+    }
+
+    if (ec) {
+        Internal::LogError("TextureImporter: Failed to iterate '{0}' ({1})", directory.string(), ec.message());
+        return {};
+    }
+
+    std::ranges::sort(descs, {}, &TextureImportDesc::Path);
+    return Import(descs);
+}
+
+Scope<RHITexture> TextureImporter::RecordUpload(RHICommandList* cmdList, const TextureUploadJob& job) {
+    if (!cmdList || !job.IsValid()) { return nullptr; }
+
+    auto texture = RHI::Get()->CreateTexture(job.CreateInfo);
+    if (!texture) { return nullptr; }
+
+    cmdList->TransitionTexture(texture.get(), RHILayout::TransferDst);
+    cmdList->CopyBufferToTexture(job.pStagingBuffer, texture.get(), job.CopyRegions);
+    cmdList->TransitionTexture(texture.get(), RHILayout::ShaderReadOnly);
+
+    return texture;
+}
+
+void TextureImporter::ResetStaging() {
+    std::lock_guard<std::mutex> lock(m_StagingMutex);
+    for (auto& page: m_StagingPages) { page.Offset = 0; }
+}
+
+TextureUploadJob TextureImporter::Decode(const TextureImportDesc& desc) {
+    if (IsTextureContainer(desc.Path)) { return LoadContainer(desc); }
+
+    // Three-channel formats are uploaded padded to four channels
+    const RHIFormat format = GetPaddedFormat(desc.Format);
+    RHIFormat sourceFormat = RHIFormat::Unknown;
+    if (!GetDecodeSource(desc.Format, sourceFormat) || !CanConvertFormat(sourceFormat, format)) {
+        Internal::LogError("TextureImporter: Unsupported target format {0} for '{1}'",
+                           static_cast<uint32>(desc.Format), desc.Path.string());
+        return {};
+    }
+    const auto& sourceInfo = GetFormatInfo(sourceFormat);
+    const bool decodeFloat = sourceInfo.BytesPerBlock != sourceInfo.ChannelCount;
+    const auto channels = static_cast<int32>(sourceInfo.ChannelCount);
+
+    // Decode before taking staging, a file that fails to decode must not leave a hole in the page
+    const std::string path = desc.Path.string();
+    int32 width = 0;
+    int32 height = 0;
+    int32 sourceChannels = 0;
+    stbi_set_flip_vertically_on_load_thread(desc.FlipVertically ? 1 : 0);
+    void* pixels = decodeFloat
+                           ? static_cast<void*>(stbi_loadf(path.c_str(), &width, &height, &sourceChannels, channels))
+                           : static_cast<void*>(stbi_load(path.c_str(), &width, &height, &sourceChannels, channels));
+    if (!pixels) {
+        Internal::LogError("TextureImporter: Failed to decode '{0}' ({1})", path, stbi_failure_reason());
+        return {};
+    }
+
+    const uint64 rowBytes = GetFormatRowBytes(format, static_cast<uint32>(width));
+    const uint32 rowPitch = static_cast<uint32>(AlignUp(rowBytes, m_RowPitchAlignment));
+    StagingAllocation staging = AllocateStaging(static_cast<uint64>(rowPitch) * height);
+    if (!staging.pBuffer) {
+        stbi_image_free(pixels);
+        return {};
+    }
+
+    // Convert straight into the pitched staging layout
+    PixelConverter converter(sourceFormat, format);
+    converter.ConvertImage(pixels, GetFormatRowBytes(sourceFormat, static_cast<uint32>(width)), staging.pMappedData,
+                           rowPitch, static_cast<uint32>(width), static_cast<uint32>(height), m_ThreadPool);
+    stbi_image_free(pixels);
+
+    TextureUploadJob job;
+    job.SourcePath = desc.Path;
+    job.CreateInfo.Type = RHITextureType::Texture2D;
+    job.CreateInfo.Format = format;
+    job.CreateInfo.Extent = {static_cast<uint32>(width), static_cast<uint32>(height), 1};
+    job.CreateInfo.Usage = RHITextureUsageFlagBits::Sampled | RHITextureUsageFlagBits::TransferDst;
+    job.CreateInfo.MemoryUsage = RHIMemoryUsage::GpuOnly;
+    job.pStagingBuffer = staging.pBuffer;
+    job.CopyRegions.push_back({staging.Offset, rowPitch});
+    return job;
+}
+
+TextureUploadJob TextureImporter::LoadContainer(const TextureImportDesc& desc) {
+    // Rows go from the mapped file straight into staging, the payload is never read into a heap buffer
+    MappedFile file(desc.Path);
+    TextureContainerView container;
+    if (!file.IsOpen() || !ParseTextureFile(file.GetData(), container)) {
+        Internal::LogError("TextureImporter: Failed to load container '{0}'", desc.Path.string());
+        return {};
+    }
+    if (GetPaddedFormat(container.Header.Format) != container.Header.Format) {
+        Internal::LogError("TextureImporter: '{0}' stores a format the device cannot sample", desc.Path.string());
+        return {};
+    }
+
+    std::vector<RHIBufferTextureCopy> regions;
+    const uint64 stagingSize = ComputeUploadFootprints(container, m_OffsetAlignment, m_RowPitchAlignment, regions);
+    StagingAllocation staging = AllocateStaging(stagingSize);
+    if (!staging.pBuffer) { return {}; }
+
+    CopyUploadRows(container, regions, staging.pMappedData);
+    for (auto& region: regions) { region.BufferOffset += staging.Offset; }
+
+    TextureUploadJob job;
+    job.SourcePath = desc.Path;
+    job.CreateInfo = ToTextureCreateInfo(container.Header);
+    job.pStagingBuffer = staging.pBuffer;
+    job.CopyRegions = std::move(regions);
+    return job;
+}
+
+TextureImporter::StagingAllocation TextureImporter::AllocateStaging(uint64 size) {
+    std::lock_guard<std::mutex> lock(m_StagingMutex);
+
+    // First fit over the existing pages so recycled pages are refilled before growing
+    for (auto& page: m_StagingPages) {
+        const uint64 offset = AlignUp(page.Offset, m_OffsetAlignment);
+        if (offset + size <= page.Size) {
+            page.Offset = offset + size;
+            return {page.Buffer.get(), offset, page.pMappedData + offset};
+        }
+    }
+
+    RHIBufferCreateInfo bufferInfo{};
+    bufferInfo.Size = std::max(m_StagingPageSize, size);
+    bufferInfo.Usage = RHIBufferUsageBit::TransferSrc;
+    bufferInfo.MemoryUsage = RHIMemoryUsage::CpuToGpu;
+
+    StagingPage page;
+    page.Buffer = RHI::Get()->CreateBuffer(bufferInfo);
+    page.pMappedData = page.Buffer ? static_cast<uint8*>(page.Buffer->Map()) : nullptr;
+    if (!page.pMappedData) {
+        Internal::LogError("TextureImporter: Failed to create a {0} byte staging page", bufferInfo.Size);
+        return {};
+    }
+
+    // Pages stay mapped for their whole lifetime
+    page.Size = bufferInfo.Size;
+    page.Offset = size;
+    m_StagingPages.push_back(std::move(page));
+
+    auto& newPage = m_StagingPages.back();
+    return {newPage.Buffer.get(), 0, newPage.pMappedData};
+}
+
+} // namespace iGe
@@ -0,0 +1,90 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.Renderer:TextureImporter;
+import iGe.RHI;
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Texture Import Description
+// =================================================================================================
+
+export struct TextureImportDesc {
+    std::filesystem::path Path;
+    RHIFormat Format = RHIFormat::R8G8B8A8Srgb; // Decoded texels convert to this format, containers keep their own
+    bool FlipVertically = false;
+};
+
+// =================================================================================================
+// Texture Upload Job
+// =================================================================================================
+
+// Decoded texels already laid out in staging memory, ready to be copied into a texture
+export struct TextureUploadJob {
+    std::filesystem::path SourcePath;
+    RHITextureCreateInfo CreateInfo;
+
+    const RHIBuffer* pStagingBuffer = nullptr;
+    std::vector<RHIBufferTextureCopy> CopyRegions; // One per subresource
+
+    bool IsValid() const { return pStagingBuffer != nullptr; }
+};
+
+// =================================================================================================
+// TextureImporter
+// =================================================================================================
+
+// True for the source image extensions stb_image can decode
+export IGE_API bool IsImportableImage(const std::filesystem::path& path);
+// True for cooked .igtex containers and DDS/KTX2 files, which upload as stored
+export IGE_API bool IsTextureContainer(const std::filesystem::path& path);
+
+export class IGE_API TextureImporter {
+public:
+    // Without a thread pool the importer spins up its own workers
+    explicit TextureImporter(ThreadPool* pThreadPool = nullptr, uint64 stagingPageSize = 64ull << 20);
+    ~TextureImporter();
+
+    std::future<TextureUploadJob> ImportAsync(const TextureImportDesc& desc);
+    std::vector<TextureUploadJob> Import(std::span<const TextureImportDesc> descs);
+    std::vector<TextureUploadJob> ImportDirectory(const std::filesystem::path& directory,
+                                                  RHIFormat format = RHIFormat::R8G8B8A8Srgb);
+
+    // Create the texture and record the staging copy plus the transitions around it
+    static Scope<RHITexture> RecordUpload(RHICommandList* cmdList, const TextureUploadJob& job);
+
+    // Recycle staging memory, only valid once the GPU consumed every job handed out so far
+    void ResetStaging();
+
+private:
+    struct StagingAllocation {
+        const RHIBuffer* pBuffer = nullptr;
+        uint64 Offset = 0;
+        uint8* pMappedData = nullptr;
+    };
+
+    struct StagingPage {
+        Scope<RHIBuffer> Buffer;
+        uint8* pMappedData = nullptr;
+        uint64 Size = 0;
+        uint64 Offset = 0;
+    };
+
+    TextureUploadJob Decode(const TextureImportDesc& desc);
+    TextureUploadJob LoadContainer(const TextureImportDesc& desc);
+    StagingAllocation AllocateStaging(uint64 size);
+
+    ThreadPool* m_ThreadPool = nullptr;
+    Scope<ThreadPool> m_OwnedThreadPool;
+
+    std::mutex m_StagingMutex;
+    std::vector<StagingPage> m_StagingPages;
+    uint64 m_StagingPageSize = 0;
+    uint64 m_OffsetAlignment = 1;
+    uint32 m_RowPitchAlignment = 1;
+};
+
+} // namespace iGe
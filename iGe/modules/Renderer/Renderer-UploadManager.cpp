@@ -0,0 +1,233 @@
+module iGe.Renderer;
+import :UploadManager;
+
+namespace iGe
+{
+
+UploadManager::UploadManager(const UploadManagerCreateInfo& info) {
+    auto* rhi = RHI::Get();
+
+    const RHIQueueType queueType = rhi->GetQueueCount(info.QueueType) > 0 ? info.QueueType : RHIQueueType::Graphics;
+    m_Queue = rhi->GetQueue(queueType);
+    m_Fence = rhi->CreateGPUFence({});
+
+    const auto& limits = rhi->GetDeviceProperties().Limits;
+    m_OffsetAlignment = std::max<uint64>(1, limits.OptimalBufferCopyOffsetAlignment);
+    m_RowPitchAlignment = std::max<uint64>(1, limits.OptimalBufferCopyRowPitchAlignment);
+
+    // A whole number of alignments keeps ring positions and buffer offsets equally aligned
+    m_StagingSize = AlignUp(std::max<uint64>(info.StagingSize, m_OffsetAlignment), m_OffsetAlignment);
+
+    RHIBufferCreateInfo bufferInfo{};
+    bufferInfo.Size = m_StagingSize;
+    bufferInfo.Usage = RHIBufferUsageBit::TransferSrc;
+    bufferInfo.MemoryUsage = RHIMemoryUsage::CpuToGpu;
+    m_StagingBuffer = rhi->CreateBuffer(bufferInfo);
+
+    // The ring stays mapped for its whole lifetime
+    m_pStagingData = m_StagingBuffer ? static_cast<uint8*>(m_StagingBuffer->Map()) : nullptr;
+    if (!m_pStagingData) {
+        Internal::LogError("UploadManager: Failed to create a {0} byte staging ring", m_StagingSize);
+    }
+}
+
+UploadManager::~UploadManager() {
+    Flush();
+    if (!m_InFlightBatches.empty()) { m_Fence->WaitForValue(m_InFlightBatches.back().FenceValue); }
+    if (m_StagingBuffer) { m_StagingBuffer->Unmap(); }
+}
+
+UploadTicket UploadManager::UploadBuffer(const RHIBuffer* pDst, const void* pData, uint64 size, uint64 dstOffset) {
+    if (!pDst || !pData || size == 0) { return {}; }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    const uint64 offset = AllocateStaging(size, 4);
+    if (offset == InvalidOffset) { return {}; }
+
+    std::memcpy(m_pStagingData + offset, pData, size);
+    GetOpenCommandList()->CopyBuffer(m_StagingBuffer.get(), pDst, offset, dstOffset, size);
+    return {m_NextFenceValue};
+}
+
+UploadTicket UploadManager::UploadTexture(const RHITexture* pDst, std::span<const UploadTextureRegion> regions) {
+    if (!pDst || regions.empty()) { return {}; }
+
+    const RHIFormat format = pDst->GetFormat();
+
+    // Lay every subresource out in one staging allocation with the device's copy pitch
+    std::vector<RHIBufferTextureCopy> copies(regions.size());
+    uint64 totalSize = 0;
+    for (size_t i = 0; i < regions.size(); ++i) {
+        const auto& region = regions[i];
+        const uint32 width = std::max(1u, pDst->GetWidth() >> region.MipLevel);
+        const uint32 height = std::max(1u, pDst->GetHeight() >> region.MipLevel);
+        const uint32 depth = std::max(1u, pDst->GetDepth() >> region.MipLevel);
+        const uint64 rowPitch = AlignUp(GetFormatRowBytes(format, width), m_RowPitchAlignment);
+
+        totalSize = AlignUp(totalSize, m_OffsetAlignment);
+        copies[i].BufferOffset = totalSize;
+        copies[i].BufferRowPitch = static_cast<uint32>(rowPitch);
+        copies[i].MipLevel = region.MipLevel;
+        copies[i].ArrayLayer = region.ArrayLayer;
+        totalSize += rowPitch * GetFormatRowCount(format, height) * depth;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    const uint64 offset = AllocateStaging(totalSize, m_OffsetAlignment);
+    if (offset == InvalidOffset) { return {}; }
+
+    for (size_t i = 0; i < regions.size(); ++i) {
+        const auto& region = regions[i];
+        auto& copy = copies[i];
+        copy.BufferOffset += offset;
+
+        const uint32 width = std::max(1u, pDst->GetWidth() >> region.MipLevel);
+        const uint32 height = std::max(1u, pDst->GetHeight() >> region.MipLevel);
+        const uint32 depth = std::max(1u, pDst->GetDepth() >> region.MipLevel);
+        const uint64 rowBytes = GetFormatRowBytes(format, width);
+        const uint64 srcPitch = region.RowPitch != 0 ? region.RowPitch : rowBytes;
+        const uint32 rowCount = GetFormatRowCount(format, height) * depth;
+
+        const auto* src = static_cast<const uint8*>(region.pData);
+        uint8* dst = m_pStagingData + copy.BufferOffset;
+        for (uint32 row = 0; row < rowCount; ++row) {
+            std::memcpy(dst + row * copy.BufferRowPitch, src + row * srcPitch, rowBytes);
+        }
+    }
+
+    auto* cmdList = GetOpenCommandList();
+    cmdList->TransitionTexture(pDst, RHILayout::TransferDst);
+    cmdList->CopyBufferToTexture(m_StagingBuffer.get(), pDst, copies);
+    cmdList->TransitionTexture(pDst, RHILayout::Common);
+    return {m_NextFenceValue};
+}
+
+UploadTicket UploadManager::UploadTexture(const RHITexture* pDst, const RHIBuffer* pSource,
+                                          std::span<const RHIBufferTextureCopy> regions) {
+    if (!pDst || !pSource || regions.empty()) { return {}; }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto* cmdList = GetOpenCommandList();
+    cmdList->TransitionTexture(pDst, RHILayout::TransferDst);
+    cmdList->CopyBufferToTexture(pSource, pDst, regions);
+    cmdList->TransitionTexture(pDst, RHILayout::Common);
+    return {m_NextFenceValue};
+}
+
+UploadTicket UploadManager::Flush() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (!m_HasOpenBatch) { return {}; }
+
+    const UploadTicket ticket{m_NextFenceValue};
+    SubmitOpenBatch();
+    Retire();
+    return ticket;
+}
+
+bool UploadManager::IsComplete(UploadTicket ticket) const {
+    return ticket.FenceValue <= m_Fence->GetCompletedValue();
+}
+
+void UploadManager::Wait(UploadTicket ticket) {
+    if (!ticket.IsValid()) { return; }
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        SubmitIfOpen(ticket);
+    }
+    m_Fence->WaitForValue(ticket.FenceValue);
+}
+
+void UploadManager::WaitOnQueue(RHIQueue* pQueue, UploadTicket ticket) {
+    if (!pQueue || !ticket.IsValid()) { return; }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    SubmitIfOpen(ticket);
+
+    // Submissions on the upload queue are already ordered after the batch
+    if (pQueue != m_Queue) { pQueue->Wait(m_Fence.get(), ticket.FenceValue); }
+}
+
+uint64 UploadManager::GetStagingUsage() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Head - m_Tail;
+}
+
+uint64 UploadManager::AllocateStaging(uint64 size, uint64 alignment) {
+    if (!m_pStagingData) { return InvalidOffset; }
+    if (size > m_StagingSize) {
+        Internal::LogError("UploadManager: A {0} byte upload does not fit the {1} byte staging ring", size,
+                           m_StagingSize);
+        return InvalidOffset;
+    }
+
+    while (true) {
+        Retire();
+
+        // Allocations stay contiguous, one that does not fit before the end of the ring starts the next lap
+        uint64 start = AlignUp(m_Head, alignment);
+        if (start % m_StagingSize + size > m_StagingSize) { start = AlignUp(start, m_StagingSize); }
+
+        // An empty ring can skip to any position for free
+        if (m_Head == m_Tail) { m_Tail = start; }
+
+        if (start + size - m_Tail <= m_StagingSize) {
+            m_Head = start + size;
+            return start % m_StagingSize;
+        }
+
+        // Out of space: the oldest batch in flight owns the space at the tail, the open one if none is
+        if (m_InFlightBatches.empty()) { SubmitOpenBatch(); }
+        m_Fence->WaitForValue(m_InFlightBatches.front().FenceValue);
+    }
+}
+
+RHICommandList* UploadManager::GetOpenCommandList() {
+    if (m_HasOpenBatch) { return m_OpenBatch.CommandList.get(); }
+
+    if (!m_FreeBatches.empty()) {
+        m_OpenBatch = std::move(m_FreeBatches.back());
+        m_FreeBatches.pop_back();
+        m_OpenBatch.Pool->Reset();
+    } else {
+        // Each batch owns its allocator, which may only be reset once the batch has executed
+        RHICommandPoolCreateInfo poolInfo{};
+        poolInfo.pQueue = m_Queue;
+        m_OpenBatch.Pool = RHI::Get()->CreateCommandPool(poolInfo);
+        m_OpenBatch.CommandList = RHI::Get()->AllocateCommandList(m_OpenBatch.Pool.get());
+    }
+
+    m_OpenBatch.CommandList->Reset();
+    m_OpenBatch.CommandList->Begin();
+    m_HasOpenBatch = true;
+    return m_OpenBatch.CommandList.get();
+}
+
+void UploadManager::SubmitOpenBatch() {
+    if (!m_HasOpenBatch) { return; }
+
+    m_OpenBatch.CommandList->End();
+    m_Queue->Submit(m_OpenBatch.CommandList.get());
+    m_Queue->Signal(m_Fence.get(), m_NextFenceValue);
+
+    m_OpenBatch.FenceValue = m_NextFenceValue++;
+    m_OpenBatch.StagingEnd = m_Head;
+    m_InFlightBatches.push_back(std::move(m_OpenBatch));
+    m_HasOpenBatch = false;
+}
+
+void UploadManager::Retire() {
+    const uint64 completedValue = m_Fence->GetCompletedValue();
+    while (!m_InFlightBatches.empty() && m_InFlightBatches.front().FenceValue <= completedValue) {
+        auto& batch = m_InFlightBatches.front();
+        m_Tail = std::max(m_Tail, batch.StagingEnd);
+        m_FreeBatches.push_back(std::move(batch));
+        m_InFlightBatches.pop_front();
+    }
+}
+
+void UploadManager::SubmitIfOpen(UploadTicket ticket) {
+    if (m_HasOpenBatch && ticket.FenceValue == m_NextFenceValue) { SubmitOpenBatch(); }
+}
+
+} // namespace iGe
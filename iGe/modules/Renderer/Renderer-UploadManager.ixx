@@ -0,0 +1,109 @@
+module;
+#include "iGeMacro.h"
+
+export module iGe.Renderer:UploadManager;
+import iGe.RHI;
+import iGe.Common;
+
+namespace iGe
+{
+
+// =================================================================================================
+// Upload Manager
+// =================================================================================================
+
+// Identifies the batch an upload was recorded into, compare against the manager's fence to poll it
+export struct UploadTicket {
+    uint64 FenceValue = 0;
+
+    bool IsValid() const { return FenceValue != 0; }
+};
+
+// Source data of one whole subresource. Rows are rows of blocks for compressed formats
+export struct UploadTextureRegion {
+    const void* pData = nullptr;
+    uint64 RowPitch = 0; // Zero means tightly packed rows
+    uint32 MipLevel = 0;
+    uint32 ArrayLayer = 0;
+};
+
+export struct UploadManagerCreateInfo {
+    uint64 StagingSize = 64ull << 20;
+    RHIQueueType QueueType = RHIQueueType::Transfer; // Falls back to Graphics when the device has no such queue
+};
+
+// Streams buffer and texture data to GPU-only resources without stalling the CPU. Data is copied into a
+// persistently mapped staging ring and the copies are batched into one command list, submitted on Flush (or
+// when a ticket of the open batch is waited on). Completion is tracked with a fence value per batch; ring
+// space and command lists of a batch are recycled once the GPU has reached its value.
+//
+// Buffers need no transitions. Textures go Undefined -> TransferDst -> Common on the upload queue, so the
+// consuming queue must transition from Common (D3D12 promotes Common to a shader read implicitly).
+export class IGE_API UploadManager {
+public:
+    explicit UploadManager(const UploadManagerCreateInfo& info = {});
+    ~UploadManager();
+
+    UploadManager(const UploadManager&) = delete;
+    UploadManager& operator=(const UploadManager&) = delete;
+
+    // Thread-safe. An invalid ticket means nothing was recorded, the error has been logged
+    UploadTicket UploadBuffer(const RHIBuffer* pDst, const void* pData, uint64 size, uint64 dstOffset = 0);
+    UploadTicket UploadTexture(const RHITexture* pDst, std::span<const UploadTextureRegion> regions);
+    // Data already sitting in an upload buffer (e.g. a TextureUploadJob), pSource must outlive the ticket
+    UploadTicket UploadTexture(const RHITexture* pDst, const RHIBuffer* pSource,
+                               std::span<const RHIBufferTextureCopy> regions);
+
+    // Submits the open batch, call once per frame. Returns the ticket of the submitted batch
+    UploadTicket Flush();
+
+    // Never blocks and never submits, a ticket of the open batch stays incomplete until Flush
+    bool IsComplete(UploadTicket ticket) const;
+    // Blocks the CPU until the ticket's batch has executed
+    void Wait(UploadTicket ticket);
+    // Makes pQueue wait on the GPU for the ticket's batch, work submitted to pQueue afterwards sees the data
+    void WaitOnQueue(RHIQueue* pQueue, UploadTicket ticket);
+
+    RHIQueue* GetQueue() const { return m_Queue; }
+    uint64 GetStagingSize() const { return m_StagingSize; }
+    uint64 GetStagingUsage() const;
+
+private:
+    static constexpr uint64 InvalidOffset = ~0ull;
+
+    struct Batch {
+        Scope<RHICommandPool> Pool;
+        Scope<RHICommandList> CommandList;
+        uint64 FenceValue = 0;
+        uint64 StagingEnd = 0; // Ring head once the batch was closed
+    };
+
+    // All private helpers expect m_Mutex to be held
+    uint64 AllocateStaging(uint64 size, uint64 alignment);
+    RHICommandList* GetOpenCommandList();
+    void SubmitOpenBatch();
+    void Retire();
+    void SubmitIfOpen(UploadTicket ticket);
+
+    RHIQueue* m_Queue = nullptr;
+    Scope<RHIFence> m_Fence;
+    Scope<RHIBuffer> m_StagingBuffer;
+    uint8* m_pStagingData = nullptr;
+    uint64 m_StagingSize = 0;
+    uint64 m_OffsetAlignment = 1;
+    uint64 m_RowPitchAlignment = 1;
+
+    mutable std::mutex m_Mutex;
+
+    // Monotonic byte positions, the slot is the position modulo the staging size
+    uint64 m_Head = 0;
+    uint64 m_Tail = 0;
+
+    uint64 m_NextFenceValue = 1; // Value the open batch signals
+    Batch m_OpenBatch;
+    bool m_HasOpenBatch = false;
+    std::deque<Batch> m_InFlightBatches;
+    std::vector<Batch> m_FreeBatches;
+};
+
+} // namespace iGe
@@ -3,5 +3,14 @@ export module iGe.Renderer;
 export import glm;
 export import iGe.RHI;
 
+export import :BlockCompression;
+export import :DescriptorSetCache;
+export import :MipGenerator;
 export import :OrthographicCamera;
 export import :PipelineParser;
+export import :PixelConvert;
+export import :TextureContainer;
+export import :TextureCooker;
+export import :TextureFileParser;
+export import :TextureImporter;
+export import :UploadManager;
@@ -0,0 +1,16 @@
+#pragma once
+
+// Selects the vector instruction set of the pixel kernels. AVX2 kernels are compiled with IGE_TARGET_AVX2 and
+// only called once CPUFeatures reports AVX2, FMA and F16C, NEON is part of every AArch64 target.
+#if defined(_M_X64) || defined(__x86_64__)
+    #include <immintrin.h>
+    #define IGE_SIMD_AVX2
+    #if defined(_MSC_VER)
+        #define IGE_TARGET_AVX2
+    #else
+        #define IGE_TARGET_AVX2 __attribute__((target("avx2,fma,f16c")))
+    #endif
+#elif defined(_M_ARM64) || defined(__aarch64__)
+    #include <arm_neon.h>
+    #define IGE_SIMD_NEON
+#endif